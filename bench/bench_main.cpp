@@ -0,0 +1,144 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Entry point of the benchmark program.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <optionpp/parser.hpp>
+#include "harness.hpp"
+
+using namespace optionpp;
+using namespace optionpp_bench;
+
+namespace {
+
+  // Command-line settings
+  struct settings {
+    bool show_help = false;
+    bool list = false;
+    std::string json_file;
+    std::string csv_file;
+    std::string filter;
+    double min_time_ms = 50;
+    unsigned samples = 5;
+  };
+
+  // Write results to a file, or to standard output for "-"
+  bool write_file(const std::string& filename,
+                  void (*writer)(std::ostream&, const std::vector<measurement>&),
+                  const std::vector<measurement>& results) {
+    if (filename == "-") {
+      writer(std::cout, results);
+      return true;
+    }
+
+    std::ofstream file{filename};
+    if (!file) {
+      std::cerr << "Error: cannot open '" << filename << "'\n";
+      return false;
+    }
+    writer(file, results);
+    return true;
+  }
+
+} // End anonymous namespace
+
+int main(int argc, char* argv[]) {
+  settings config;
+  parser opt_parser;
+
+  opt_parser["help"].short_name('?')
+    .description("Show help information")
+    .bind_bool(&config.show_help);
+  opt_parser["list"].short_name('l')
+    .description("List the benchmarks without running them")
+    .bind_bool(&config.list);
+  opt_parser["json"].short_name('j')
+    .description("Write results as JSON to FILE ('-' for standard output)")
+    .argument("FILE")
+    .bind_string(&config.json_file);
+  opt_parser["csv"].short_name('c')
+    .description("Write results as CSV to FILE ('-' for standard output)")
+    .argument("FILE")
+    .bind_string(&config.csv_file);
+  opt_parser["filter"].short_name('f')
+    .description("Only run benchmarks whose name contains TEXT")
+    .argument("TEXT")
+    .bind_string(&config.filter);
+  opt_parser["min-time"].short_name('t')
+    .description("Minimum duration of each sample in milliseconds")
+    .argument("MS")
+    .bind_double(&config.min_time_ms);
+  opt_parser["samples"].short_name('n')
+    .description("Number of samples for each benchmark")
+    .argument("COUNT")
+    .bind_uint(&config.samples);
+
+  try {
+    opt_parser.parse(argc, argv);
+  } catch(const optionpp::error& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  if (config.show_help) {
+    std::cout << "Usage: " << argv[0] << " [OPTION]...\n"
+              << "Run the Option++ benchmarks. Without --json or --csv, "
+              << "JSON is written to standard output.\n\n"
+              << opt_parser << std::endl;
+    return 0;
+  }
+
+  suite benchmarks;
+  add_parser_benchmarks(benchmarks);
+  add_utility_benchmarks(benchmarks);
+  add_result_benchmarks(benchmarks);
+  add_schema_benchmarks(benchmarks);
+
+  std::vector<measurement> results;
+  for (const auto& bench : benchmarks.benchmarks()) {
+    if (bench.name.find(config.filter) == std::string::npos)
+      continue;
+    if (config.list) {
+      std::cout << bench.name << ' ' << bench.params << '\n';
+      continue;
+    }
+
+    results.push_back(measure(bench, config.min_time_ms, config.samples));
+    std::fprintf(stderr, "%-28s %-18s %14.1f ns\n", bench.name.c_str(),
+                 bench.params.c_str(), results.back().median_ns);
+  }
+  if (config.list)
+    return 0;
+
+  if (config.json_file.empty() && config.csv_file.empty())
+    config.json_file = "-";
+  if (!config.json_file.empty() && !write_file(config.json_file, write_json, results))
+    return 1;
+  if (!config.csv_file.empty() && !write_file(config.csv_file, write_csv, results))
+    return 1;
+  return 0;
+}
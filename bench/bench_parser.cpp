@@ -0,0 +1,364 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Benchmarks for parsing.
+ */
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <optionpp/parser.hpp>
+#include "harness.hpp"
+
+using namespace optionpp;
+
+namespace optionpp_bench {
+
+  namespace {
+
+    // Parser with the given number of options named "option-N", the
+    // first 52 of which also have a short name
+    std::shared_ptr<parser> make_parser(std::size_t option_count) {
+      const std::string short_names = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+      auto p = std::make_shared<parser>();
+      for (std::size_t i = 0; i < option_count; ++i) {
+        auto& opt = p->add_option("option-" + std::to_string(i));
+        opt.description("Description of option number " + std::to_string(i));
+        if (i < short_names.size())
+          opt.short_name(short_names[i]);
+        if (i % 4 == 1)
+          opt.argument("VALUE");
+      }
+      return p;
+    }
+
+    // Typical command line: long options spread over the table, some
+    // with arguments, and a few non-options
+    std::vector<std::string> make_args(std::size_t option_count) {
+      std::vector<std::string> args{"prog"};
+      for (std::size_t i = 0; i < 12; ++i) {
+        std::size_t index = (i * 7919) % option_count;
+        std::string name = "--option-" + std::to_string(index);
+        if (index % 4 == 1)
+          name += "=value" + std::to_string(i);
+        args.push_back(name);
+        if (i % 3 == 0)
+          args.push_back("file" + std::to_string(i) + ".txt");
+      }
+      return args;
+    }
+
+    std::string join(const std::vector<std::string>& args) {
+      std::string result;
+      for (const auto& arg : args) {
+        if (!result.empty())
+          result.push_back(' ');
+        result += arg;
+      }
+      return result;
+    }
+
+  } // End anonymous namespace
+
+  void add_parser_benchmarks(suite& benchmarks) {
+    for (std::size_t count : {10, 100, 1000, 10000}) {
+      auto p = make_parser(count);
+      auto args = std::make_shared<std::vector<std::string>>(make_args(count));
+      const std::string params = "options=" + std::to_string(count);
+
+      benchmarks.add("parse/argv", params, args->size() - 1,
+                     [p, args](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                         consume(p->parse(args->begin(), args->end()).size());
+                     });
+
+      benchmarks.add("visit/argv", params, args->size() - 1,
+                     [p, args](std::size_t iterations) {
+                       std::size_t count = 0;
+                       auto on_option = [&](const option&, string_ref argument) {
+                         count += argument.size() + 1;
+                         return true;
+                       };
+                       auto on_non_option = [&](string_ref argument) {
+                         count += argument.size();
+                         return true;
+                       };
+                       parse_status status;
+                       for (std::size_t i = 0; i < iterations; ++i)
+                         p->visit(args->begin(), args->end(), on_option,
+                                  on_non_option, status);
+                       consume(count);
+                     });
+
+      auto cmd_line = std::make_shared<std::string>(join(*args));
+      benchmarks.add("parse/string", params, args->size(),
+                     [p, cmd_line](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                         consume(p->parse(*cmd_line).size());
+                     });
+
+      // Every long option given by a unique prefix of its name
+      auto abbrev = std::make_shared<parser>();
+      for (std::size_t i = 0; i < count; ++i)
+        abbrev->add_option(std::to_string(i) + "-option-name");
+      abbrev->set_allow_abbreviations();
+      auto abbrev_args = std::make_shared<std::vector<std::string>>();
+      for (std::size_t i = 0; i < 12; ++i)
+        abbrev_args->push_back("--" + std::to_string((i * 7919) % count) + "-opt");
+      benchmarks.add("parse/abbreviated", params, abbrev_args->size(),
+                     [abbrev, abbrev_args](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                         consume(abbrev->parse(abbrev_args->begin(),
+                                               abbrev_args->end(), false).size());
+                     });
+
+      benchmarks.add("compile", params, count,
+                     [p](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                         consume(p->compile().size());
+                     });
+
+      // Changing the custom strings forces the help to be formatted
+      // again
+      benchmarks.add("print_help/format", params, count,
+                     [p](std::size_t iterations) {
+                       std::ostringstream os;
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         p->set_custom_strings(" \t\n\r");
+                         os.str("");
+                         p->print_help(os);
+                         consume(static_cast<std::size_t>(os.tellp()));
+                       }
+                     });
+
+      benchmarks.add("print_help/cached", params, count,
+                     [p](std::size_t iterations) {
+                       std::ostringstream os;
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         os.str("");
+                         p->print_help(os);
+                         consume(static_cast<std::size_t>(os.tellp()));
+                       }
+                     });
+    }
+
+    {
+      auto p = make_parser(100);
+      auto args = std::make_shared<std::vector<std::string>>(make_args(100));
+      auto result = std::make_shared<parser_result>();
+      benchmarks.add("parse_into/argv", "options=100", args->size() - 1,
+                     [p, args, result](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         p->parse_into(*result, args->begin(), args->end());
+                         consume(result->size());
+                       }
+                     });
+
+      benchmarks.add("parse_ref/argv", "options=100", args->size() - 1,
+                     [p, args](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                         consume(p->parse_ref(args->begin(), args->end()).size());
+                     });
+
+      // Mostly invalid input, as seen by a validation service
+      auto bad = std::make_shared<std::vector<std::string>>(
+        std::vector<std::string>{"--option-3", "--bogus", "-a", "--option-5=x=y"});
+      auto status = std::make_shared<parse_status>();
+      benchmarks.add("parse_into/invalid", "options=100", 1,
+                     [p, bad, result, status](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         p->parse_into(*result, bad->begin(), bad->end(), *status, false);
+                         consume(status->token_index());
+                       }
+                     });
+    }
+
+    {
+      // Misspelled option in a large table, with the message built
+      auto p = make_parser(4000);
+      p->set_suggestions();
+      auto bad = std::make_shared<std::vector<std::string>>(
+        std::vector<std::string>{"--optoin-1234"});
+      auto result = std::make_shared<parser_result>();
+      auto status = std::make_shared<parse_status>();
+      benchmarks.add("parse_into/suggestions", "options=4000", 1,
+                     [p, bad, result, status](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         p->parse_into(*result, bad->begin(), bad->end(), *status, false);
+                         consume(status->message().size());
+                       }
+                     });
+    }
+
+    for (std::size_t count : {1000, 10000}) {
+      // Registering a generated table, then compiling it once, one
+      // option at a time and in bulk
+      auto names = std::make_shared<std::vector<std::string>>();
+      for (std::size_t i = 0; i < count; ++i)
+        names->push_back("option-" + std::to_string(i));
+      const std::string params = "options=" + std::to_string(count);
+
+      benchmarks.add("register/subscript", params, count,
+                     [names](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         parser p;
+                         for (const auto& name : *names)
+                           p[name].description("Description of " + name);
+                         consume(p.compile().size());
+                       }
+                     });
+
+      benchmarks.add("register/add_options", params, count,
+                     [names](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         std::vector<option> opts;
+                         opts.reserve(names->size());
+                         for (const auto& name : *names)
+                           opts.emplace_back(name, '\0', "Description of " + name);
+                         parser p;
+                         p.add_options(std::make_move_iterator(opts.begin()),
+                                       std::make_move_iterator(opts.end()));
+                         consume(p.compile().size());
+                       }
+                     });
+    }
+
+    {
+      // Startup cost of a large generated table with every lookup
+      // structure built
+      auto p = make_parser(10000);
+      p->set_allow_abbreviations();
+      p->set_suggestions();
+      benchmarks.add("compile/all_indexes", "options=10000", 10000,
+                     [p](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                         consume(p->compile().size());
+                     });
+    }
+
+    {
+      // xargs-style command line with many file arguments
+      auto p = make_parser(10);
+      auto files = std::make_shared<std::vector<std::string>>();
+      files->push_back("--option-0");
+      for (std::size_t i = 0; i < 100000; ++i)
+        files->push_back("dir/file" + std::to_string(i) + ".txt");
+      auto result = std::make_shared<parser_result>();
+      benchmarks.add("parse_into/many_files", "files=100000", files->size(),
+                     [p, files, result](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         p->parse_into(*result, files->begin(), files->end(), false);
+                         consume(result->size());
+                       }
+                     });
+      // Run on the calling thread, to show the cost of splitting the
+      // work into tasks
+      benchmarks.add("parse_parallel/many_files", "files=100000,threads=1", files->size(),
+                     [p, files, result](std::size_t iterations) {
+                       auto executor = [](std::function<void()> task) { task(); };
+                       parse_status status;
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         p->parse_parallel_into(*result, files->begin(), files->end(),
+                                                executor, status, 16384, false);
+                         consume(result->size());
+                       }
+                     });
+      benchmarks.add("visit/many_files", "files=100000", files->size(),
+                     [p, files](std::size_t iterations) {
+                       std::size_t count = 0;
+                       auto on_non_option = [&](string_ref) { return ++count != 0; };
+                       parse_status status;
+                       for (std::size_t i = 0; i < iterations; ++i)
+                         p->visit(files->begin(), files->end(), nullptr,
+                                  on_non_option, status, false);
+                       consume(count);
+                     });
+    }
+
+    {
+      // Wrapper command line: a few options, then a long tail after
+      // the end-of-options marker
+      auto p = make_parser(10);
+      auto args = std::make_shared<std::vector<std::string>>(
+        std::vector<std::string>{"--option-1=4G", "--option-5=8", "--", "/usr/bin/app"});
+      for (std::size_t i = 0; i < 100000; ++i)
+        args->push_back("arg" + std::to_string(i));
+      auto result = std::make_shared<parser_result>();
+      benchmarks.add("parse_leading_options/wrapper", "tail=100000", 2,
+                     [p, args, result](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         auto tail = p->parse_leading_options(*result, args->begin(),
+                                                              args->end(), false);
+                         consume(args->end() - tail);
+                       }
+                     });
+    }
+
+    {
+      // Clusters of single-letter flags
+      auto p = std::make_shared<parser>();
+      for (char c = 'a'; c <= 'z'; ++c)
+        (*p)[c];
+      auto args = std::make_shared<std::vector<std::string>>(16, "-abcdefghijklm");
+      benchmarks.add("parse/short_clusters", "tokens=16", 16 * 13,
+                     [p, args](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                         consume(p->parse(args->begin(), args->end(), false).size());
+                     });
+    }
+
+    {
+      // Numeric arguments written to bound variables
+      struct values {
+        int ints[4];
+        unsigned uints[4];
+        double doubles[4];
+      };
+      auto data = std::make_shared<values>();
+      auto p = std::make_shared<parser>();
+      for (int i = 0; i < 4; ++i) {
+        std::string n = std::to_string(i);
+        (*p)["int" + n].bind_int(&data->ints[i]);
+        (*p)["uint" + n].bind_uint(&data->uints[i]);
+        (*p)["double" + n].bind_double(&data->doubles[i]);
+      }
+      auto args = std::make_shared<std::vector<std::string>>();
+      for (int i = 0; i < 4; ++i) {
+        std::string n = std::to_string(i);
+        args->push_back("--int" + n + "=-" + std::to_string(12345 * (i + 1)));
+        args->push_back("--uint" + n + "=" + std::to_string(4000000 + i));
+        args->push_back("--double" + n);
+        args->push_back(std::to_string(i) + ".0625e-3");
+      }
+      benchmarks.add("parse/bound_numeric", "arguments=12", 12,
+                     [p, args, data](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         consume(p->parse(args->begin(), args->end(), false).size());
+                         consume(static_cast<std::size_t>(data->ints[0]));
+                       }
+                     });
+    }
+  }
+
+} // End namespace
@@ -0,0 +1,88 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Benchmarks for querying parse results.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <optionpp/parser.hpp>
+#include "harness.hpp"
+
+using namespace optionpp;
+
+namespace optionpp_bench {
+
+  void add_result_benchmarks(suite& benchmarks) {
+    // Result with many entries, half of them repeated options
+    auto p = std::make_shared<parser>();
+    for (int i = 0; i < 100; ++i)
+      p->add_option("option-" + std::to_string(i)).argument("VALUE", false);
+    std::vector<std::string> args;
+    for (int i = 0; i < 1000; ++i) {
+      args.push_back("--option-" + std::to_string(i % 100) + "=" + std::to_string(i));
+      args.push_back("file" + std::to_string(i));
+    }
+    auto result = std::make_shared<parser_result>(p->parse(args.begin(), args.end(), false));
+
+    auto names = std::make_shared<std::vector<std::string>>();
+    for (int i = 0; i < 100; i += 7)
+      names->push_back("option-" + std::to_string(i));
+    names->push_back("missing");
+    const std::string params = "entries=" + std::to_string(result->size());
+
+    benchmarks.add("result/is_option_set", params, names->size(),
+                   [result, names](std::size_t iterations) {
+                     for (std::size_t i = 0; i < iterations; ++i) {
+                       for (const auto& name : *names)
+                         consume(result->is_option_set(name));
+                     }
+                   });
+
+    benchmarks.add("result/get_argument", params, names->size(),
+                   [result, names](std::size_t iterations) {
+                     for (std::size_t i = 0; i < iterations; ++i) {
+                       for (const auto& name : *names)
+                         consume(result->get_argument(name).size());
+                     }
+                   });
+
+    benchmarks.add("result/occurrences", params, names->size(),
+                   [result, names](std::size_t iterations) {
+                     for (std::size_t i = 0; i < iterations; ++i) {
+                       for (const auto& name : *names) {
+                         for (const auto& entry : result->occurrences(name))
+                           consume(entry.argument.size());
+                       }
+                     }
+                   });
+
+    benchmarks.add("result/iterate", params, result->size(),
+                   [result](std::size_t iterations) {
+                     for (std::size_t i = 0; i < iterations; ++i) {
+                       for (const auto& entry : *result)
+                         consume(entry.is_option);
+                     }
+                   });
+  }
+
+} // End namespace
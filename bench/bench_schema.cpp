@@ -0,0 +1,147 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Benchmarks for compile-time option schemas.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <optionpp/option_schema.hpp>
+#include <optionpp/parser.hpp>
+#include "harness.hpp"
+
+using namespace optionpp;
+
+namespace optionpp_bench {
+
+#if OPTIONPP_CONSTEXPR_SCHEMA
+
+  namespace {
+
+    // Options of a typical small program
+    constexpr option_spec tool_specs[] = {
+      {"help", '?', "Show this help message."},
+      {"version", 'V', "Show version information."},
+      {"verbose", 'v', "Show more output."},
+      {"quiet", 'q', "Show less output."},
+      {"all", 'a', "Include hidden entries."},
+      {"recursive", 'r', "Descend into directories."},
+      {"output", 'o', "Write the output to FILE.", "FILE", true},
+      {"jobs", 'j', "Run up to N jobs at once.", "N", true,
+       option_spec::check<unsigned>()},
+      {"color", '\0', "Use color: WHEN may be always, never or auto.",
+       "WHEN", false},
+      {"timeout", 't', "Give up after SECONDS.", "SECONDS", true,
+       option_spec::check<double>()},
+      {"exclude", 'x', "Skip files matching PATTERN.", "PATTERN", true},
+      {"dry-run", 'n', "Only show what would be done."}
+    };
+
+    constexpr auto tool_schema = make_schema<tool_specs>();
+
+    // The same options in a parser, built as a program would at startup
+    parser make_tool_parser(unsigned& jobs, double& timeout) {
+      parser result;
+      result.add_option("help", '?', "Show this help message.");
+      result.add_option("version", 'V', "Show version information.");
+      result.add_option("verbose", 'v', "Show more output.");
+      result.add_option("quiet", 'q', "Show less output.");
+      result.add_option("all", 'a', "Include hidden entries.");
+      result.add_option("recursive", 'r', "Descend into directories.");
+      result.add_option("output", 'o', "Write the output to FILE.")
+        .argument("FILE", true);
+      result.add_option("jobs", 'j', "Run up to N jobs at once.")
+        .bind<unsigned>(&jobs).argument("N", true);
+      result.add_option("color", '\0', "Use color: WHEN may be always, "
+                        "never or auto.").argument("WHEN", false);
+      result.add_option("timeout", 't', "Give up after SECONDS.")
+        .bind<double>(&timeout).argument("SECONDS", true);
+      result.add_option("exclude", 'x', "Skip files matching PATTERN.")
+        .argument("PATTERN", true);
+      result.add_option("dry-run", 'n', "Only show what would be done.");
+      return result;
+    }
+
+  } // End namespace
+
+  void add_schema_benchmarks(suite& benchmarks) {
+    const std::string params = "options=12";
+    auto args = std::make_shared<std::vector<std::string>>(
+      std::vector<std::string>{"tool", "-vr", "--jobs=8", "-o", "out.txt",
+                               "--color", "--exclude", "*.tmp", "-t2.5",
+                               "src", "include", "--", "-file"});
+
+    // Whole run of a program: set up the options, then parse
+    benchmarks.add("schema/startup_visit", params, args->size() - 1,
+                   [args](std::size_t iterations) {
+                     std::size_t count = 0;
+                     auto on_option = [&](const option_spec&, string_ref argument) {
+                       count += argument.size() + 1;
+                       return true;
+                     };
+                     auto on_non_option = [&](string_ref argument) {
+                       count += argument.size();
+                       return true;
+                     };
+                     parse_status status;
+                     for (std::size_t i = 0; i < iterations; ++i)
+                       tool_schema.parser().visit(args->begin(), args->end(),
+                                                  on_option, on_non_option,
+                                                  status);
+                     consume(count);
+                   });
+    benchmarks.add("parser/startup_visit", params, args->size() - 1,
+                   [args](std::size_t iterations) {
+                     std::size_t count = 0;
+                     auto on_option = [&](const option&, string_ref argument) {
+                       count += argument.size() + 1;
+                       return true;
+                     };
+                     auto on_non_option = [&](string_ref argument) {
+                       count += argument.size();
+                       return true;
+                     };
+                     parse_status status;
+                     unsigned jobs = 0;
+                     double timeout = 0;
+                     for (std::size_t i = 0; i < iterations; ++i)
+                       make_tool_parser(jobs, timeout).visit(args->begin(), args->end(),
+                                                             on_option, on_non_option,
+                                                             status);
+                     consume(count + jobs);
+                   });
+
+    // Help text, which the schema formats at compile time
+    benchmarks.add("schema/help", params, 1,
+                   [](std::size_t iterations) {
+                     for (std::size_t i = 0; i < iterations; ++i)
+                       consume(tool_schema.parser().help().size());
+                   });
+  }
+
+#else
+
+  void add_schema_benchmarks(suite&) {}
+
+#endif
+
+} // End namespace
@@ -0,0 +1,98 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Benchmarks for the utility functions and help output.
+ */
+
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <optionpp/parser.hpp>
+#include <optionpp/utility.hpp>
+#include "harness.hpp"
+
+using namespace optionpp;
+
+namespace optionpp_bench {
+
+  void add_utility_benchmarks(suite& benchmarks) {
+    {
+      // Command line with quoted and escaped arguments
+      auto text = std::make_shared<std::string>();
+      for (int i = 0; i < 200; ++i)
+        *text += "--option-" + std::to_string(i) + " \"quoted arg\" plain\\ escaped  ";
+      auto tokens = std::make_shared<std::vector<std::string>>();
+      benchmarks.add("utility/split", "bytes=" + std::to_string(text->size()),
+                     text->size(), [text, tokens](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         tokens->clear();
+                         utility::split(*text, std::back_inserter(*tokens));
+                         consume(tokens->size());
+                       }
+                     });
+    }
+
+    {
+      auto text = std::make_shared<std::string>();
+      for (int i = 0; i < 40; ++i)
+        *text += "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+          "eiusmod tempor incididunt ut labore et dolore magna aliqua. ";
+      benchmarks.add("utility/wrap_text", "bytes=" + std::to_string(text->size()),
+                     text->size(), [text](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                         consume(utility::wrap_text(*text, 78, 2, 30).size());
+                     });
+
+      auto output = std::make_shared<std::string>();
+      benchmarks.add("utility/wrap_text_iterator", "bytes=" + std::to_string(text->size()),
+                     text->size(), [text, output](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         output->clear();
+                         utility::wrap_text(*text, std::back_inserter(*output), 78, 2, 30);
+                         consume(output->size());
+                       }
+                     });
+    }
+
+    {
+      auto p = std::make_shared<parser>();
+      for (int i = 0; i < 100; ++i) {
+        auto& opt = p->group("Group " + std::to_string(i / 10))
+          .add_option("option-" + std::to_string(i));
+        opt.description("Description of option number " + std::to_string(i)
+                        + ", which is long enough to need wrapping in the help text");
+        if (i % 3 == 0)
+          opt.argument("VALUE");
+      }
+      benchmarks.add("print_help", "options=100", 100,
+                     [p](std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i) {
+                         std::ostringstream oss;
+                         p->print_help(oss);
+                         consume(oss.str().size());
+                       }
+                     });
+    }
+  }
+
+} // End namespace
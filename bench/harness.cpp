@@ -0,0 +1,145 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for the benchmark harness.
+ */
+
+#include "harness.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+
+namespace optionpp_bench {
+
+  namespace {
+
+    volatile std::size_t sink; //< Receives consumed values.
+
+    /**
+     * @brief Write a string as a JSON string literal.
+     * @param os Output stream.
+     * @param str The string.
+     */
+    void write_json_string(std::ostream& os, const std::string& str) {
+      os << '"';
+      for (char c : str) {
+        if (c == '"' || c == '\\')
+          os << '\\';
+        os << c;
+      }
+      os << '"';
+    }
+
+    /**
+     * @brief Write a string as a CSV field.
+     * @param os Output stream.
+     * @param str The string.
+     */
+    void write_csv_field(std::ostream& os, const std::string& str) {
+      if (str.find_first_of(",\"") == std::string::npos) {
+        os << str;
+        return;
+      }
+
+      os << '"';
+      for (char c : str) {
+        if (c == '"')
+          os << '"';
+        os << c;
+      }
+      os << '"';
+    }
+
+    /**
+     * @brief Compute the throughput of a measurement.
+     * @param result The measurement.
+     * @return Items handled per second, based on the median time.
+     */
+    double items_per_second(const measurement& result) {
+      if (result.median_ns <= 0)
+        return 0;
+      return result.bench->items * 1e9 / result.median_ns;
+    }
+
+  } // End anonymous namespace
+
+  void consume(std::size_t value) noexcept {
+    sink = sink + value;
+  }
+
+  measurement measure(const benchmark& bench, double min_time_ms,
+                      std::size_t samples) {
+    using clock = std::chrono::steady_clock;
+    auto time_ns = [&](std::size_t iterations) {
+      auto start = clock::now();
+      bench.run(iterations);
+      std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+      return elapsed.count();
+    };
+
+    // Find a number of iterations that takes long enough to time
+    std::size_t iterations = 1;
+    while (time_ns(iterations) < min_time_ms * 1e6 && iterations < (std::size_t{1} << 40))
+      iterations *= 2;
+
+    std::vector<double> times;
+    for (std::size_t i = 0; i < std::max<std::size_t>(samples, 1); ++i)
+      times.push_back(time_ns(iterations) / iterations);
+    std::sort(times.begin(), times.end());
+
+    return measurement{&bench, iterations, times.front(),
+        times[times.size() / 2], times.back()};
+  }
+
+  void write_json(std::ostream& os, const std::vector<measurement>& results) {
+    os << "{\n  \"benchmarks\": [";
+    bool first = true;
+    for (const auto& result : results) {
+      os << (first ? "\n" : ",\n") << "    {\"name\": ";
+      write_json_string(os, result.bench->name);
+      os << ", \"params\": ";
+      write_json_string(os, result.bench->params);
+      os << ", \"iterations\": " << result.iterations
+         << ", \"min_ns\": " << result.min_ns
+         << ", \"median_ns\": " << result.median_ns
+         << ", \"max_ns\": " << result.max_ns
+         << ", \"items_per_second\": " << items_per_second(result) << "}";
+      first = false;
+    }
+    os << "\n  ]\n}\n";
+  }
+
+  void write_csv(std::ostream& os, const std::vector<measurement>& results) {
+    os << "name,params,iterations,min_ns,median_ns,max_ns,items_per_second\n";
+    for (const auto& result : results) {
+      write_csv_field(os, result.bench->name);
+      os << ',';
+      write_csv_field(os, result.bench->params);
+      os << ',' << result.iterations
+         << ',' << result.min_ns
+         << ',' << result.median_ns
+         << ',' << result.max_ns
+         << ',' << items_per_second(result) << '\n';
+    }
+  }
+
+} // End namespace
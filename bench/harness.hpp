@@ -0,0 +1,151 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for the benchmark harness.
+ */
+
+#ifndef OPTIONPP_BENCH_HARNESS_HPP
+#define OPTIONPP_BENCH_HARNESS_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace optionpp_bench {
+
+  /**
+   * @brief Function that runs a workload a given number of times.
+   */
+  using workload = std::function<void(std::size_t iterations)>;
+
+  /**
+   * @brief A named workload.
+   */
+  struct benchmark {
+    std::string name; //< Name of the benchmark, such as `parse/argv`.
+    std::string params; //< Parameters of the workload, such as `options=100`.
+    std::size_t items; //< Number of items (tokens, bytes...) handled per iteration.
+    workload run; //< Runs the workload.
+  };
+
+  /**
+   * @brief Measurements for one benchmark.
+   */
+  struct measurement {
+    const benchmark* bench; //< The benchmark.
+    std::size_t iterations; //< Iterations in each sample.
+    double min_ns; //< Fastest time per iteration in nanoseconds.
+    double median_ns; //< Median time per iteration in nanoseconds.
+    double max_ns; //< Slowest time per iteration in nanoseconds.
+  };
+
+  /**
+   * @brief Collection of benchmarks.
+   */
+  class suite {
+  public:
+    /**
+     * @brief Add a benchmark.
+     * @param name Name of the benchmark.
+     * @param params Parameters of the workload.
+     * @param items Number of items handled per iteration.
+     * @param run Function running the workload.
+     */
+    void add(std::string name, std::string params, std::size_t items,
+             workload run) {
+      m_benchmarks.push_back(benchmark{std::move(name), std::move(params),
+            items, std::move(run)});
+    }
+
+    /**
+     * @brief Get the benchmarks.
+     * @return The benchmarks in the order they were added.
+     */
+    const std::vector<benchmark>& benchmarks() const noexcept {
+      return m_benchmarks;
+    }
+
+  private:
+    std::vector<benchmark> m_benchmarks; //< The benchmarks.
+  };
+
+  /**
+   * @brief Keep a value from being optimized away.
+   * @param value Any number derived from the result of a workload.
+   */
+  void consume(std::size_t value) noexcept;
+
+  /**
+   * @brief Time a benchmark.
+   *
+   * The number of iterations is doubled until one sample takes at
+   * least `min_time_ms`, and then `samples` samples are timed.
+   *
+   * @param bench The benchmark.
+   * @param min_time_ms Minimum duration of one sample.
+   * @param samples Number of samples.
+   * @return The measurement.
+   */
+  measurement measure(const benchmark& bench, double min_time_ms,
+                      std::size_t samples);
+
+  /**
+   * @brief Write measurements as JSON.
+   * @param os Output stream.
+   * @param results The measurements.
+   */
+  void write_json(std::ostream& os, const std::vector<measurement>& results);
+
+  /**
+   * @brief Write measurements as CSV, with a header line.
+   * @param os Output stream.
+   * @param results The measurements.
+   */
+  void write_csv(std::ostream& os, const std::vector<measurement>& results);
+
+  /**
+   * @brief Add the parser benchmarks.
+   * @param benchmarks Suite to add to.
+   */
+  void add_parser_benchmarks(suite& benchmarks);
+
+  /**
+   * @brief Add the utility and help benchmarks.
+   * @param benchmarks Suite to add to.
+   */
+  void add_utility_benchmarks(suite& benchmarks);
+
+  /**
+   * @brief Add the result query benchmarks.
+   * @param benchmarks Suite to add to.
+   */
+  void add_result_benchmarks(suite& benchmarks);
+
+  /**
+   * @brief Add the compile-time option schema benchmarks.
+   * @param benchmarks Suite to add to.
+   */
+  void add_schema_benchmarks(suite& benchmarks);
+
+} // End namespace
+
+#endif
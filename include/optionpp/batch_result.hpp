@@ -0,0 +1,302 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `batch_result` class.
+ */
+
+#ifndef OPTIONPP_BATCH_RESULT_HPP
+#define OPTIONPP_BATCH_RESULT_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <optionpp/error.hpp>
+#include <optionpp/option.hpp>
+#include <optionpp/parse_status.hpp>
+#include <optionpp/parser_result.hpp>
+#include <optionpp/parser_result_ref.hpp>
+#include <optionpp/string_ref.hpp>
+#include <optionpp/text_arena.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Holds the parsed data for many command lines.
+   *
+   * This is the result type of `compiled_parser::parse_batch`. The
+   * entries of all lines are stored together, one column for each
+   * field of `parsed_entry`, and the entries of line `i` are those
+   * with indices from `first_entry(i)` up to (but not including)
+   * `first_entry(i + 1)`. A line that could not be parsed has no
+   * entries; its status records the error instead.
+   *
+   * All text is kept in storage owned by the `batch_result`, except
+   * for the long names, which refer to the options of the parser
+   * (like the `opt_info` column). The parser must therefore outlive
+   * the result and must not be modified while it is in use.
+   */
+  class batch_result {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes and indices.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an empty result.
+     */
+    batch_result() noexcept {}
+
+    batch_result(const batch_result&) = delete;
+    batch_result& operator=(const batch_result&) = delete;
+
+    /**
+     * @brief Move constructor.
+     * @param other The result to move from.
+     */
+    batch_result(batch_result&& other) noexcept;
+    /**
+     * @brief Move assignment operator.
+     * @param other The result to move from.
+     * @return Reference to the current instance.
+     */
+    batch_result& operator=(batch_result&& other) noexcept;
+
+    /**
+     * @brief Erase all lines.
+     *
+     * Memory is kept for reuse.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Return the number of lines.
+     * @return Number of command lines that were parsed.
+     */
+    size_type line_count() const noexcept { return m_error.size(); }
+    /**
+     * @brief Return the total number of entries.
+     * @return Number of entries in all lines.
+     */
+    size_type entry_count() const noexcept { return m_is_option.size(); }
+    /**
+     * @brief Return the number of lines that could not be parsed.
+     * @return Number of lines with an error.
+     */
+    size_type error_count() const noexcept { return m_error_count; }
+
+    /**
+     * @brief Return whether a line was parsed successfully.
+     * @param line Index of the line.
+     * @return True if the line was parsed without error.
+     */
+    bool ok(size_type line) const noexcept {
+      return m_error[line] == parse_errc::none;
+    }
+    /**
+     * @brief Return the kind of error for a line.
+     * @param line Index of the line.
+     * @return The error, or `parse_errc::none`.
+     */
+    parse_errc error(size_type line) const noexcept { return m_error[line]; }
+    /**
+     * @brief Return the index of the argument that caused the error
+     *        for a line.
+     * @param line Index of the line.
+     * @return See `parse_status::token_index`.
+     */
+    size_type error_token(size_type line) const noexcept {
+      return m_error_token[line];
+    }
+    /**
+     * @brief Return the byte offset of the error within its argument.
+     * @param line Index of the line.
+     * @return See `parse_status::offset`.
+     */
+    size_type error_offset(size_type line) const noexcept {
+      return m_error_offset[line];
+    }
+    /**
+     * @brief Return the option that caused the error for a line.
+     * @param line Index of the line.
+     * @return The option as written on the command line, if any.
+     */
+    string_ref error_option(size_type line) const noexcept {
+      return m_error_option[line];
+    }
+    /**
+     * @brief Build the error message for a line.
+     * @param line Index of the line.
+     * @return The message that `parse` would have thrown, or an empty
+     *         string if the line was parsed successfully.
+     */
+    std::string error_message(size_type line) const {
+      return parse_status::message(m_error[line], m_error_option[line]);
+    }
+
+    /**
+     * @brief Return the index of the first entry of a line.
+     * @param line Index of the line (may be equal to `line_count()`).
+     * @return Index of the first entry belonging to the line.
+     */
+    size_type first_entry(size_type line) const noexcept {
+      return line < m_line_begin.size() ? m_line_begin[line] : entry_count();
+    }
+    /**
+     * @brief Return the number of entries in a line.
+     * @param line Index of the line.
+     * @return Number of entries belonging to the line.
+     */
+    size_type entry_count(size_type line) const noexcept {
+      return first_entry(line + 1) - first_entry(line);
+    }
+
+    /**
+     * @brief Column of original text.
+     * @return The `original_text` field of every entry.
+     */
+    const std::vector<string_ref>& original_text() const noexcept {
+      return m_original_text;
+    }
+    /**
+     * @brief Column of original text without arguments.
+     * @return The `original_without_argument` field of every entry.
+     */
+    const std::vector<string_ref>& original_without_argument() const noexcept {
+      return m_original_without_argument;
+    }
+    /**
+     * @brief Column of option flags.
+     * @return The `is_option` field of every entry (nonzero if true).
+     */
+    const std::vector<char>& is_option() const noexcept { return m_is_option; }
+    /**
+     * @brief Column of long names.
+     * @return The `long_name` field of every entry.
+     */
+    const std::vector<string_ref>& long_name() const noexcept { return m_long_name; }
+    /**
+     * @brief Column of short names.
+     * @return The `short_name` field of every entry.
+     */
+    const std::vector<char>& short_name() const noexcept { return m_short_name; }
+    /**
+     * @brief Column of option arguments.
+     * @return The `argument` field of every entry.
+     */
+    const std::vector<string_ref>& argument() const noexcept { return m_argument; }
+    /**
+     * @brief Column of option pointers.
+     * @return The `opt_info` field of every entry.
+     */
+    const std::vector<const option*>& opt_info() const noexcept { return m_opt_info; }
+
+    /**
+     * @brief Gather the fields of one entry.
+     * @param index Index of the entry.
+     * @return The entry.
+     * @throw out_of_range Thrown if `index >= entry_count()`.
+     */
+    parsed_entry_ref entry(size_type index) const;
+
+    /**
+     * @brief Make a `parser_result` for one line.
+     * @param line Index of the line.
+     * @return `parser_result` holding copies of the line's entries.
+     * @throw out_of_range Thrown if `line >= line_count()`.
+     */
+    parser_result line_result(size_type line) const;
+
+  private:
+    friend class compiled_parser;
+
+    /**
+     * @brief Add an entry to the current line.
+     * @param entry The entry. Its text must already be stored in the
+     *              result.
+     */
+    void push_back(const parsed_entry_ref& entry);
+
+    /**
+     * @brief Complete the last entry with an argument given as a
+     *        separate command-line argument.
+     * @param argument The argument. It must already be stored in the
+     *                 result.
+     */
+    void add_argument(string_ref argument) {
+      string_ref& text = m_original_text.back();
+      text = store(text, " ", argument);
+      m_argument.back() = argument;
+    }
+
+    /**
+     * @brief Finish the current line.
+     */
+    void end_line();
+
+    /**
+     * @brief Discard the entries of the current line and finish it
+     *        with an error.
+     * @param status The error.
+     */
+    void fail_line(const parse_status& status);
+
+    /**
+     * @brief Copy text into storage owned by the result.
+     * @param a First string.
+     * @param b Second string, if any.
+     * @param c Third string, if any.
+     * @return Reference to the stored text.
+     */
+    string_ref store(string_ref a, string_ref b = string_ref{},
+                     string_ref c = string_ref{});
+
+    /**
+     * @brief Move the lines of another result to the end of this one.
+     * @param other The result to take lines from.
+     */
+    void append(batch_result&& other);
+
+    std::vector<size_type> m_line_begin; //< Index of the first entry of each line.
+    size_type m_current_begin{0}; //< Index of the first entry of the line being parsed.
+    std::vector<parse_errc> m_error; //< Kind of error for each line.
+    std::vector<size_type> m_error_token; //< Index of the offending argument for each line.
+    std::vector<size_type> m_error_offset; //< Offset of the error for each line.
+    std::vector<string_ref> m_error_option; //< Option that caused the error for each line.
+    size_type m_error_count{0}; //< Number of lines with an error.
+
+    std::vector<string_ref> m_original_text; //< Column of `original_text`.
+    std::vector<string_ref> m_original_without_argument; //< Column of `original_without_argument`.
+    std::vector<char> m_is_option; //< Column of `is_option`.
+    std::vector<string_ref> m_long_name; //< Column of `long_name`.
+    std::vector<char> m_short_name; //< Column of `short_name`.
+    std::vector<string_ref> m_argument; //< Column of `argument`.
+    std::vector<const option*> m_opt_info; //< Column of `opt_info`.
+
+    std::vector<text_arena> m_text; //< Storage for all text (the last arena is filled).
+  };
+
+} // End namespace
+
+#endif
@@ -0,0 +1,150 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for locale-independent number conversion.
+ */
+
+#ifndef OPTIONPP_CHARCONV_HPP
+#define OPTIONPP_CHARCONV_HPP
+
+#include <limits>
+#include <system_error>
+
+namespace optionpp {
+
+  /**
+   * @brief Result of a call to `from_chars`.
+   */
+  struct from_chars_result {
+    const char* ptr; //< One past the last character that was used.
+    std::errc ec; //< Error code, or a value-initialized `std::errc` on success.
+  };
+
+  /**
+   * @brief Convert the start of a character range to an integer.
+   *
+   * Works like `std::from_chars` from C++17 with base 10, except that
+   * a leading `+` is accepted. Digits are always ASCII decimal digits,
+   * regardless of the current locale. The function never throws and
+   * never allocates.
+   *
+   * @param first Pointer to the first character.
+   * @param last Pointer to one past the last character.
+   * @param value Receives the converted value. It is left unchanged
+   *              if there is an error.
+   * @return `from_chars_result` with `ptr` pointing to the first
+   *         character that is not part of the number. `ec` is
+   *         `std::errc::invalid_argument` if there is no number (then
+   *         `ptr` is `first`) or `std::errc::result_out_of_range` if
+   *         the number does not fit in `value`.
+   */
+  from_chars_result from_chars(const char* first, const char* last,
+                               long long& value) noexcept;
+
+  /**
+   * @brief Convert the start of a character range to an unsigned
+   *        integer.
+   *
+   * See `from_chars(const char*, const char*, long long&)`. A minus
+   * sign is not accepted.
+   *
+   * @param first Pointer to the first character.
+   * @param last Pointer to one past the last character.
+   * @param value Receives the converted value.
+   * @return `from_chars_result` describing the conversion.
+   */
+  from_chars_result from_chars(const char* first, const char* last,
+                               unsigned long long& value) noexcept;
+
+  /**
+   * @brief Convert the start of a character range to an `int`.
+   *
+   * See `from_chars(const char*, const char*, long long&)`.
+   *
+   * @param first Pointer to the first character.
+   * @param last Pointer to one past the last character.
+   * @param value Receives the converted value.
+   * @return `from_chars_result` describing the conversion.
+   */
+  inline from_chars_result from_chars(const char* first, const char* last,
+                                      int& value) noexcept {
+    long long wide = 0;
+    auto result = from_chars(first, last, wide);
+    if (result.ec == std::errc{}) {
+      if (wide < std::numeric_limits<int>::min()
+          || wide > std::numeric_limits<int>::max())
+        result.ec = std::errc::result_out_of_range;
+      else
+        value = static_cast<int>(wide);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Convert the start of a character range to an `unsigned`.
+   *
+   * See `from_chars(const char*, const char*, unsigned long long&)`.
+   *
+   * @param first Pointer to the first character.
+   * @param last Pointer to one past the last character.
+   * @param value Receives the converted value.
+   * @return `from_chars_result` describing the conversion.
+   */
+  inline from_chars_result from_chars(const char* first, const char* last,
+                                      unsigned& value) noexcept {
+    unsigned long long wide = 0;
+    auto result = from_chars(first, last, wide);
+    if (result.ec == std::errc{}) {
+      if (wide > std::numeric_limits<unsigned>::max())
+        result.ec = std::errc::result_out_of_range;
+      else
+        value = static_cast<unsigned>(wide);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Convert the start of a character range to a `double`.
+   *
+   * Accepts an optional sign, decimal digits with an optional `.`
+   * (always a period, regardless of the current locale), and an
+   * optional exponent introduced by `e` or `E`; or `inf`, `infinity`
+   * or `nan` in any case. The result is correctly rounded to nearest.
+   *
+   * Most numbers are converted with the Clinger fast path or the
+   * Eisel-Lemire algorithm, which never allocate. Numbers with more
+   * than 19 significant digits, and the rare inputs that Eisel-Lemire
+   * cannot round with certainty, fall back to `std::strtod`.
+   *
+   * @param first Pointer to the first character.
+   * @param last Pointer to one past the last character.
+   * @param value Receives the converted value.
+   * @return `from_chars_result` describing the conversion. `ec` is
+   *         `std::errc::result_out_of_range` if a finite number
+   *         overflows to infinity or a nonzero number underflows to
+   *         zero.
+   */
+  from_chars_result from_chars(const char* first, const char* last,
+                               double& value) noexcept;
+
+} // End namespace
+
+#endif
@@ -0,0 +1,352 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `command_parser` class.
+ */
+
+#ifndef OPTIONPP_COMMAND_PARSER_HPP
+#define OPTIONPP_COMMAND_PARSER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <optionpp/command_result.hpp>
+#include <optionpp/compiled_parser.hpp>
+#include <optionpp/parse_status.hpp>
+#include <optionpp/parser.hpp>
+#include <optionpp/string_ref.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Parses command lines with git-style subcommands.
+   *
+   * A `command_parser` has its own options, given by `options`, and
+   * any number of named subcommands. Each subcommand is itself a
+   * `command_parser`, whose options (and nested subcommands) are set
+   * up by a factory function. A factory only runs the first time its
+   * subcommand is selected on a command line, so a program with many
+   * subcommands only builds the option tables that it needs:
+   * ```
+   * command_parser ctl;
+   * ctl.options()["verbose"].short_name('v');
+   * ctl.add_command("status", [](command_parser& status) {
+   *     status.options()["short"].short_name('s');
+   *   });
+   * ctl.add_command("remote", [](command_parser& remote) {
+   *     remote.add_command("add", [](command_parser& add) {
+   *         add.options()["fetch"].short_name('f');
+   *       });
+   *   });
+   *
+   * command_result result = ctl.parse(argc, argv);
+   * if (result.command_path() == std::vector<std::string>{"remote", "add"}) {
+   *   // result.global_options() holds the options before "remote",
+   *   // result.command_options() those after "add"
+   * }
+   * ```
+   *
+   * Arguments are parsed with the options of the current command
+   * until the first non-option argument. If the command has
+   * subcommands, that argument must name one of them, and parsing
+   * continues after it with the subcommand's options; otherwise it is
+   * a parse error of kind `parse_errc::unknown_command`. A command
+   * without subcommands takes all remaining arguments, including
+   * non-options. Arguments after an end-of-options marker are never
+   * taken as subcommands, nor are arguments read from response files.
+   *
+   * All `const` methods can be called from several threads at once.
+   * Each subcommand is built under a lock of its own, so a factory
+   * may use the parent's other subcommands, but must not select its
+   * own subcommand.
+   *
+   * @see command_result
+   */
+  class command_parser {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Type of function that sets up a subcommand.
+     *
+     * The function receives the new, empty `command_parser` for the
+     * subcommand, and should add its options and subcommands.
+     */
+    using factory_type = std::function<void(command_parser&)>;
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs a command without options or subcommands.
+     */
+    command_parser() {}
+
+    command_parser(const command_parser&) = delete;
+    command_parser& operator=(const command_parser&) = delete;
+
+    /**
+     * @brief Get the options of this command.
+     * @return The `parser` used for the arguments given before any
+     *         subcommand.
+     */
+    parser& options() noexcept { return m_options; }
+    /**
+     * @brief Get the options of this command.
+     * @return The `parser` used for the arguments given before any
+     *         subcommand.
+     */
+    const parser& options() const noexcept { return m_options; }
+
+    /**
+     * @brief Add a subcommand.
+     *
+     * If a subcommand with the same name exists, it is replaced, and
+     * will be set up again by the new factory.
+     *
+     * @param name Name of the subcommand, as given on the command
+     *             line.
+     * @param factory Sets up the subcommand. It is called at most
+     *                once, when the subcommand is first needed.
+     * @return Reference to the current instance (for chaining calls).
+     */
+    command_parser& add_command(const std::string& name, factory_type factory);
+
+    /**
+     * @brief Get the number of subcommands.
+     * @return Number of subcommands added with `add_command`.
+     */
+    size_type command_count() const noexcept { return m_commands.size(); }
+
+    /**
+     * @brief Check whether a subcommand exists.
+     * @param name Name of the subcommand.
+     * @return True if a subcommand with that name was added.
+     */
+    bool has_command(const std::string& name) const noexcept {
+      return find_entry(name) != nullptr;
+    }
+
+    /**
+     * @brief Check whether a subcommand has been set up.
+     * @param name Name of the subcommand.
+     * @return True if the subcommand's factory has run.
+     */
+    bool is_command_built(const std::string& name) const;
+
+    /**
+     * @brief Get a subcommand, setting it up if necessary.
+     * @param name Name of the subcommand.
+     * @return The subcommand.
+     * @throw out_of_range If there is no subcommand with that name.
+     */
+    command_parser& command(const std::string& name);
+
+    /**
+     * @brief Parse command-line arguments from a sequence of
+     *        strings.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return `command_result` holding the selected subcommands and
+     *         the entries of each level.
+     * @throw parse_error If an invalid option or subcommand is
+     *                    entered or a mandatory argument is missing.
+     */
+    template <typename InputIt>
+    command_result parse(InputIt first, InputIt last, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments.
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return `command_result` holding the selected subcommands and
+     *         the entries of each level.
+     * @throw parse_error If an invalid option or subcommand is
+     *                    entered or a mandatory argument is missing.
+     */
+    command_result parse(int argc, char* argv[], bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string.
+     *
+     * The string is split as in `parser::parse(const std::string&,
+     * bool)`.
+     *
+     * @param cmd_line The command-line arguments to parse.
+     * @param ignore_first If true, the first argument is ignored.
+     * @return `command_result` holding the selected subcommands and
+     *         the entries of each level.
+     * @throw parse_error If an invalid option or subcommand is
+     *                    entered or a mandatory argument is missing.
+     */
+    command_result parse(const std::string& cmd_line, bool ignore_first = false) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result
+     *        without throwing on invalid input.
+     *
+     * Parsing stops at the first error, and `result` then holds the
+     * subcommands and entries parsed before it.
+     *
+     * @param result The `command_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     */
+    template <typename InputIt>
+    void parse_into(command_result& result, InputIt first, InputIt last,
+                    parse_status& status, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result
+     *        without throwing on invalid input.
+     * @param result The `command_result` to fill. It is cleared first.
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     */
+    void parse_into(command_result& result, int argc, char* argv[],
+                    parse_status& status, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string into an
+     *        existing result without throwing on invalid input.
+     * @param result The `command_result` to fill. It is cleared first.
+     * @param cmd_line The command-line arguments to parse.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument is ignored.
+     */
+    void parse_into(command_result& result, const std::string& cmd_line,
+                    parse_status& status, bool ignore_first = false) const;
+
+  private:
+
+    /**
+     * @brief A subcommand and its factory.
+     */
+    struct command_entry {
+      std::string name; //< Name of the subcommand.
+      factory_type factory; //< Sets up the subcommand.
+      std::unique_ptr<std::mutex> build_mutex; //< Serializes builds of this subcommand.
+      /**
+       * @brief The subcommand, once set up.
+       *
+       * Set by the `const` method `build`, so it is `mutable`. It is
+       * only written while holding both `build_mutex` and the parent's
+       * `m_mutex`, and must be read while holding either of them.
+       */
+      mutable std::unique_ptr<command_parser> command;
+    };
+
+    /**
+     * @brief Find a subcommand by name.
+     * @param name Name of the subcommand.
+     * @return Pointer to the entry, or `nullptr` if not found.
+     */
+    const command_entry* find_entry(string_ref name) const noexcept;
+
+    /**
+     * @brief Get a subcommand, setting it up if necessary.
+     * @param entry The subcommand's entry.
+     * @return The subcommand.
+     */
+    command_parser& build(const command_entry& entry) const;
+
+    parser m_options; //< Options of this command.
+    std::vector<command_entry> m_commands; //< The subcommands.
+    mutable std::mutex m_mutex; //< Guards the publication of built subcommands.
+  };
+
+} // End namespace
+
+/* Implementation */
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+template <typename InputIt>
+optionpp::command_result
+optionpp::command_parser::parse(InputIt first, InputIt last, bool ignore_first) const {
+  command_result result;
+  parse_status status;
+  parse_into(result, first, last, status, ignore_first);
+  if (!status)
+    throw status.to_error();
+  return result;
+}
+
+template <typename InputIt>
+void optionpp::command_parser::parse_into(command_result& result,
+                                          InputIt first, InputIt last,
+                                          parse_status& status,
+                                          bool ignore_first) const {
+  result.clear();
+  status.clear();
+
+  const command_parser* current = this;
+  parser_result* entries = &result.m_levels.front();
+  compiled_parser::size_type index = 0;
+  if (ignore_first && first != last) {
+    ++first;
+    ++index;
+  }
+
+  for (;;) {
+    // Parse up to the first non-option, which names the subcommand
+    compiled_parser::result_sink sink{*entries};
+    compiled_parser::parse_state state{status};
+    state.index = index;
+    state.stop_at_non_option = !current->m_commands.empty();
+    if (!current->m_options.compiled().parse_range(first, last, false, state, sink)
+        || !state.stopped)
+      return;
+
+    const auto& arg = *first;
+    string_ref name = arg;
+    const command_entry* entry = current->find_entry(name);
+    if (!entry) {
+      status.set(parse_errc::unknown_command, state.index, 0, name);
+      return;
+    }
+
+    current = &current->build(*entry);
+    entries = &result.add_level(entry->name);
+    ++first;
+    index = state.index + 1;
+  }
+}
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
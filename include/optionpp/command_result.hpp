@@ -0,0 +1,154 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `command_result` class.
+ */
+
+#ifndef OPTIONPP_COMMAND_RESULT_HPP
+#define OPTIONPP_COMMAND_RESULT_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <optionpp/parser_result.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Holds the result of parsing a command line with
+   *        subcommands.
+   *
+   * A command line such as `ctl -v remote --force add origin url` is
+   * split into levels: level 0 holds the entries before the first
+   * subcommand (`-v`), level 1 the entries after it (`--force`), and
+   * so on, with the non-option arguments after the last subcommand
+   * (`origin` and `url`) in the last level. Each level is a separate
+   * `parser_result`, parsed with the options of its own command.
+   *
+   * The selected subcommands are given by `command_path`, which for
+   * the example above is `{"remote", "add"}`.
+   *
+   * @see command_parser
+   */
+  class command_result {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes and indices.
+     */
+    using size_type = std::vector<parser_result>::size_type;
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs a result with a single, empty level and no
+     * subcommands.
+     */
+    command_result() : m_levels(1) {}
+
+    /**
+     * @brief Get the selected subcommands.
+     * @return Names of the subcommands, outermost first.
+     */
+    const std::vector<std::string>& command_path() const noexcept {
+      return m_path;
+    }
+
+    /**
+     * @brief Check whether a subcommand was selected.
+     * @return True if the command line named at least one subcommand.
+     */
+    bool has_command() const noexcept { return !m_path.empty(); }
+
+    /**
+     * @brief Get the number of levels.
+     * @return One more than the number of selected subcommands.
+     */
+    size_type size() const noexcept { return m_levels.size(); }
+
+    /**
+     * @brief Get the entries of one level.
+     * @param level Zero for the entries before the first subcommand,
+     *              or `n` for the entries after the `n`th subcommand.
+     * @return The entries of the level.
+     */
+    const parser_result& operator[](size_type level) const noexcept {
+      return m_levels[level];
+    }
+    /**
+     * @brief Get the entries of one level, with bounds checking.
+     * @param level Index of the level, as for `operator[]`.
+     * @return The entries of the level.
+     * @throw out_of_range If `level` is not less than `size()`.
+     */
+    const parser_result& at(size_type level) const;
+
+    /**
+     * @brief Get the entries that come before the first subcommand.
+     * @return The entries of level 0.
+     */
+    const parser_result& global_options() const noexcept {
+      return m_levels.front();
+    }
+    /**
+     * @brief Get the entries that come after the last subcommand.
+     *
+     * If no subcommand was selected, these are the same entries as
+     * those given by `global_options`.
+     *
+     * @return The entries of the last level.
+     */
+    const parser_result& command_options() const noexcept {
+      return m_levels.back();
+    }
+
+    /**
+     * @brief Remove all subcommands and entries.
+     *
+     * The memory held by the first level is kept for reuse.
+     */
+    void clear() {
+      m_path.clear();
+      m_levels.resize(1);
+      m_levels.front().clear();
+    }
+
+  private:
+    friend class command_parser;
+
+    /**
+     * @brief Start the level for a newly selected subcommand.
+     * @param name Name of the subcommand.
+     * @return The new level.
+     */
+    parser_result& add_level(const std::string& name) {
+      m_path.push_back(name);
+      m_levels.emplace_back();
+      return m_levels.back();
+    }
+
+    std::vector<std::string> m_path; //< Names of the selected subcommands.
+    std::vector<parser_result> m_levels; //< Entries of each level.
+  };
+
+} // End namespace
+
+#endif
@@ -0,0 +1,1383 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `compiled_parser` class.
+ */
+
+#ifndef OPTIONPP_COMPILED_PARSER_HPP
+#define OPTIONPP_COMPILED_PARSER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include <optionpp/batch_result.hpp>
+#include <optionpp/error.hpp>
+#include <optionpp/mapped_file.hpp>
+#include <optionpp/option.hpp>
+#include <optionpp/option_index.hpp>
+#include <optionpp/option_syntax.hpp>
+#include <optionpp/parse_status.hpp>
+#include <optionpp/parse_target.hpp>
+#include <optionpp/parser_result.hpp>
+#include <optionpp/parser_result_ref.hpp>
+#include <optionpp/string_ref.hpp>
+#include <optionpp/suggestion_index.hpp>
+#include <optionpp/tokenizer.hpp>
+
+namespace optionpp {
+
+  class parser;
+
+  /**
+   * @brief Read-only snapshot of a `parser`, optimized for repeated
+   *        parsing.
+   *
+   * A `compiled_parser` is created by `parser::compile`. It holds a
+   * copy of every option in every group of the `parser`, stored in a
+   * single flat table, together with a perfect-hash `option_index`
+   * over that table and the parser's custom strings. Later changes to
+   * the original `parser` do not affect the snapshot.
+   *
+   * The `parse` methods behave exactly like the corresponding
+   * `parser::parse` overloads. Since a `compiled_parser` cannot be
+   * modified, it can be shared between threads and used by all of
+   * them at once. Note however that parsing writes to any variables
+   * that were bound to the options, and those writes are not
+   * synchronized; bind members with `option::bind(T C::*)` instead
+   * and parse into a separate `parse_target` on each thread.
+   *
+   * The `opt_info` field of each `parsed_entry` produced by a
+   * `compiled_parser` points into the snapshot's option table, and
+   * remains valid as long as the `compiled_parser` does. The same
+   * holds for the `long_name` field of the entries produced by
+   * `parse_ref`.
+   *
+   * The snapshot keeps whole `option` objects, even though parsing
+   * only needs their names, argument modes and bindings: `opt_info`
+   * and `option_handler`s see the same `option` as they would with
+   * the `parser`. The strings of the options are not copied, since
+   * they live in the parser's `text_pool`, which the snapshot shares;
+   * strings added to the parser later go to the end of the pool and
+   * never move the ones the snapshot uses. Creating a snapshot
+   * therefore only copies the fixed-size option records.
+   *
+   * @see parser
+   */
+  class compiled_parser {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::vector<option>::size_type;
+
+    /**
+     * @brief Type of function used to run batch parsing tasks.
+     *
+     * The function is given a task and must arrange for it to be run
+     * exactly once, on any thread, either before returning or later.
+     */
+    using executor_type = std::function<void(std::function<void()>)>;
+
+    /**
+     * @brief Type of function that receives each option from `visit`.
+     *
+     * The function is given the option and its argument, which is
+     * empty if none was given. It returns false to stop parsing.
+     */
+    using option_handler = std::function<bool(const option&, string_ref)>;
+
+    /**
+     * @brief Type of function that receives each non-option argument
+     *        from `visit`.
+     *
+     * The function returns false to stop parsing.
+     */
+    using non_option_handler = std::function<bool(string_ref)>;
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs a snapshot that does not accept any options.
+     */
+    compiled_parser() noexcept {}
+
+    /**
+     * @brief Construct a snapshot of a `parser`.
+     *
+     * Equivalent to `source.compile()`.
+     *
+     * @param source The `parser` to copy the options and custom
+     *               strings from.
+     */
+    explicit compiled_parser(const parser& source);
+
+    /**
+     * @brief Copy constructor.
+     * @param other The `compiled_parser` to copy.
+     */
+    compiled_parser(const compiled_parser& other);
+    /**
+     * @brief Move constructor.
+     * @param other The `compiled_parser` to move from.
+     */
+    compiled_parser(compiled_parser&& other) noexcept;
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other The `compiled_parser` to copy.
+     * @return Reference to the current instance.
+     */
+    compiled_parser& operator=(const compiled_parser& other);
+    /**
+     * @brief Move assignment operator.
+     * @param other The `compiled_parser` to move from.
+     * @return Reference to the current instance.
+     */
+    compiled_parser& operator=(compiled_parser&& other) noexcept;
+
+    /**
+     * @brief Return the number of options in the snapshot.
+     * @return Number of options, counting every group.
+     */
+    size_type size() const noexcept { return m_options.size(); }
+
+    /**
+     * @brief Parse command-line arguments from a sequence of
+     *        strings.
+     *
+     * See `parser::parse(InputIt, InputIt, bool)` for details.
+     *
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return `parser_result` containing the parsed data.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    template <typename InputIt>
+    parser_result parse(InputIt first, InputIt last, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments.
+     *
+     * See `parser::parse(int, char*[], bool)` for details.
+     *
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return `parser_result` containing the parsed data.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    parser_result parse(int argc, char* argv[], bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string.
+     *
+     * See `parser::parse(const std::string&, bool)` for details.
+     *
+     * @param cmd_line The command-line arguments to parse.
+     * @param ignore_first If true, the first argument is ignored.
+     * @return `parser_result` containing the parsed data.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    parser_result parse(const std::string& cmd_line, bool ignore_first = false) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result.
+     *
+     * See `parser::parse_into(parser_result&, InputIt, InputIt, bool)`
+     * for details.
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result.
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string into an
+     *        existing result.
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param cmd_line The command-line arguments to parse.
+     * @param ignore_first If true, the first argument is ignored.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    bool ignore_first = false) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result
+     *        without throwing on invalid input.
+     *
+     * Works like `parse_into(parser_result&, InputIt, InputIt, bool)`,
+     * but an invalid option or argument is reported through `status`
+     * instead of a `parse_error`. Parsing stops at the first error,
+     * and `result` then holds the entries parsed before it. No error
+     * message is built unless `status.message()` is called.
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @see parse_status
+     */
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    parse_status& status, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result
+     *        without throwing on invalid input.
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     */
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    parse_status& status, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string into an
+     *        existing result without throwing on invalid input.
+     *
+     * The token index in `status` counts the arguments split from
+     * `cmd_line`.
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param cmd_line The command-line arguments to parse.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument is ignored.
+     */
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    parse_status& status, bool ignore_first = false) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result,
+     *        writing bound members to a target object.
+     *
+     * See `parser::parse_into(parser_result&, InputIt, InputIt,
+     * const parse_target&, parse_status&, bool)` for details.
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param target Object receiving the members bound with
+     *               `option::bind(T C::*)`.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     */
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result,
+     *        writing bound members to a target object.
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param target Object receiving the members bound with
+     *               `option::bind(T C::*)`.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     */
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string into an
+     *        existing result, writing bound members to a target
+     *        object.
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param cmd_line The command-line arguments to parse.
+     * @param target Object receiving the members bound with
+     *               `option::bind(T C::*)`.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument is ignored.
+     */
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = false) const;
+
+    /**
+     * @brief Parse the options at the start of a command line,
+     *        leaving the rest untouched.
+     *
+     * Parsing stops before the first non-option argument, as with
+     * the `+` flag of POSIX `getopt` or with `POSIXLY_CORRECT` set,
+     * or after an end-of-options marker, which is consumed. The
+     * remaining arguments are neither copied nor looked at, so a
+     * wrapper program can hand them to another program as they are:
+     * ```
+     * parser_result result;
+     * char** tail = my_parser.parse_leading_options(result, argv, argv + argc);
+     * if (tail != argv + argc)
+     *   execv(tail[0], tail);
+     * ```
+     *
+     * An option that takes an optional argument still takes the
+     * following non-option argument, as in `parse`. Arguments read
+     * from a response file never stop parsing; it stops before the
+     * first argument after the file instead.
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return Iterator to the first argument that was not parsed, or
+     *         `last` if every argument was parsed.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    template <typename InputIt>
+    InputIt parse_leading_options(parser_result& result, InputIt first,
+                                  InputIt last, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse the options at the start of a command line without
+     *        throwing on invalid input.
+     *
+     * See `parse_leading_options(parser_result&, InputIt, InputIt,
+     * bool)`.
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return Iterator to the first argument that was not parsed, or
+     *         `last` if every argument was parsed. On error, the
+     *         iterator points to the argument that caused it.
+     */
+    template <typename InputIt>
+    InputIt parse_leading_options(parser_result& result, InputIt first,
+                                  InputIt last, parse_status& status,
+                                  bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments without copying them.
+     *
+     * Parses exactly like the corresponding `parse` overload, but
+     * produces a `parser_result_ref` whose entries refer to the
+     * strings in `[first, last)` instead of copying them. Those
+     * strings must outlive the result.
+     *
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return `parser_result_ref` containing the parsed data.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    template <typename InputIt>
+    parser_result_ref parse_ref(InputIt first, InputIt last,
+                                bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments without copying them.
+     *
+     * The entries refer directly to the strings in `argv`.
+     *
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return `parser_result_ref` containing the parsed data.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    parser_result_ref parse_ref(int argc, char* argv[],
+                                bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string without
+     *        copying each argument separately.
+     *
+     * The arguments are split as in `parse(const std::string&, bool)`
+     * and stored in the result's own storage, so `cmd_line` need not
+     * outlive the result.
+     *
+     * @param cmd_line The command-line arguments to parse.
+     * @param ignore_first If true, the first argument is ignored.
+     * @return `parser_result_ref` containing the parsed data.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    parser_result_ref parse_ref(const std::string& cmd_line,
+                                bool ignore_first = false) const;
+
+    /**
+     * @brief Parse command-line arguments, passing each entry to a
+     *        handler instead of storing it.
+     *
+     * Each option is passed to `on_option` and each non-option
+     * argument to `on_non_option`, in command-line order, and bound
+     * variables are written as by `parse`. No result is built, so
+     * memory use does not grow with the number of arguments. An
+     * option that may take its argument from the next command-line
+     * argument is passed on once that argument has been seen, and
+     * before that argument is checked, so the handler may see an
+     * invalid separate argument just before parsing fails.
+     *
+     * A handler stops parsing by returning false; no further entries
+     * are then passed on, and no further bound variables are written
+     * except by options in the same command-line argument. The
+     * strings given to the handlers are only valid during the call.
+     *
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param on_option Receives each option. May be empty.
+     * @param on_non_option Receives each non-option argument. May be
+     *                      empty.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return True if every argument was parsed and passed on; false
+     *         if there was an error (given by `status`) or a handler
+     *         stopped parsing.
+     */
+    template <typename InputIt>
+    bool visit(InputIt first, InputIt last, const option_handler& on_option,
+               const non_option_handler& on_non_option, parse_status& status,
+               bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments, passing each entry to a
+     *        handler instead of storing it.
+     *
+     * See `visit(InputIt, InputIt, const option_handler&, const
+     * non_option_handler&, parse_status&, bool)`.
+     *
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param on_option Receives each option. May be empty.
+     * @param on_non_option Receives each non-option argument. May be
+     *                      empty.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return True if every argument was parsed and passed on.
+     */
+    bool visit(int argc, char* argv[], const option_handler& on_option,
+               const non_option_handler& on_non_option, parse_status& status,
+               bool ignore_first = true) const;
+
+    /**
+     * @brief Parse a very long sequence of command-line arguments in
+     *        parallel.
+     *
+     * The arguments are divided into tasks of `args_per_task`
+     * arguments each, which are parsed speculatively on `executor`
+     * as if no option were waiting for an argument at the start of
+     * the task. A short sequential pass then reparses the first few
+     * arguments of any task where that guess was wrong (because an
+     * option in the previous task takes its argument from this one,
+     * or because an end-of-options marker came before it) until the
+     * two parses agree, and the entries of all tasks are joined.
+     * Bound variables are written afterward, in command-line order.
+     *
+     * The result, the values written to bound variables and any
+     * error are the same as those of `parse`. When parsing fails, or
+     * when the arguments after an end-of-options marker span whole
+     * tasks, the affected arguments are parsed sequentially, so the
+     * parallel parse pays off for long command lines that consist
+     * mostly of non-option arguments and options.
+     *
+     * The executor is used as described for `parse_batch(ForwardIt,
+     * ForwardIt, const executor_type&, size_type, bool)`.
+     *
+     * @tparam ForwardIt Iterator type. Each element must be
+     *                   convertible to `string_ref`.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param executor Function that runs the tasks. If empty, the
+     *                 arguments are parsed on the calling thread.
+     * @param args_per_task Number of arguments in each task.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return `parser_result` containing the parsed data.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    template <typename ForwardIt>
+    parser_result parse_parallel(ForwardIt first, ForwardIt last,
+                                 const executor_type& executor,
+                                 size_type args_per_task = 16384,
+                                 bool ignore_first = true) const;
+
+    /**
+     * @brief Parse a very long sequence of command-line arguments in
+     *        parallel into an existing result, without throwing on
+     *        invalid input.
+     *
+     * See `parse_parallel`.
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param executor Function that runs the tasks. If empty, the
+     *                 arguments are parsed on the calling thread.
+     * @param status Receives the outcome. It is cleared first.
+     * @param args_per_task Number of arguments in each task.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     */
+    template <typename ForwardIt>
+    void parse_parallel_into(parser_result& result, ForwardIt first,
+                             ForwardIt last, const executor_type& executor,
+                             parse_status& status,
+                             size_type args_per_task = 16384,
+                             bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string, passing each
+     *        entry to a handler instead of storing it.
+     *
+     * The string is split as in `parse(const std::string&, bool)`.
+     * See `visit(InputIt, InputIt, const option_handler&, const
+     * non_option_handler&, parse_status&, bool)`.
+     *
+     * @param cmd_line The command-line arguments to parse.
+     * @param on_option Receives each option. May be empty.
+     * @param on_non_option Receives each non-option argument. May be
+     *                      empty.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument is ignored.
+     * @return True if every argument was parsed and passed on.
+     */
+    bool visit(const std::string& cmd_line, const option_handler& on_option,
+               const non_option_handler& on_non_option, parse_status& status,
+               bool ignore_first = false) const;
+
+    /**
+     * @brief Parse many command lines.
+     *
+     * Each element of `[first, last)` is a command line, which is
+     * split and parsed like `parse(const std::string&, bool)`. The
+     * state used by the parser (such as its scratch buffers) is
+     * reused from line to line, and all lines are stored together in
+     * a single `batch_result`.
+     *
+     * An invalid line does not stop the batch: its error is recorded
+     * in the `batch_result` and parsing continues with the next line.
+     * Batch parsing checks option arguments but never writes to
+     * bound variables.
+     *
+     * @tparam InputIt Iterator type. Each element must be convertible
+     *                 to `string_ref` (for example, a `std::string`).
+     * @param first Iterator pointing to the first command line.
+     * @param last Iterator pointing to one past the last command line.
+     * @param ignore_first If true, the first argument of each line is
+     *                     ignored.
+     * @return `batch_result` holding the entries and status of every
+     *         line.
+     */
+    template <typename InputIt>
+    batch_result parse_batch(InputIt first, InputIt last,
+                             bool ignore_first = false) const;
+
+    /**
+     * @brief Parse many command lines in parallel.
+     *
+     * Works like `parse_batch(InputIt, InputIt, bool)`, but divides
+     * the lines into tasks of `lines_per_task` lines each and hands
+     * the tasks to `executor` (typically a function that submits them
+     * to a thread pool). The call returns once every task has
+     * finished, and the result is the same as if the lines had been
+     * parsed in order. The executor must not run the tasks on the
+     * calling thread after `parse_batch` has started to wait for them,
+     * or the wait will never end.
+     *
+     * @tparam ForwardIt Iterator type. Each element must be
+     *                   convertible to `string_ref`.
+     * @param first Iterator pointing to the first command line.
+     * @param last Iterator pointing to one past the last command line.
+     * @param executor Function that runs the tasks. If empty, the
+     *                 lines are parsed on the calling thread.
+     * @param lines_per_task Number of lines in each task.
+     * @param ignore_first If true, the first argument of each line is
+     *                     ignored.
+     * @return `batch_result` holding the entries and status of every
+     *         line.
+     */
+    template <typename ForwardIt>
+    batch_result parse_batch(ForwardIt first, ForwardIt last,
+                             const executor_type& executor,
+                             size_type lines_per_task = 256,
+                             bool ignore_first = false) const;
+
+  private:
+    friend class command_parser;
+    friend class parser;
+    friend class incremental_parser;
+
+    /**
+     * @brief Tag type selecting the non-copying constructor.
+     */
+    struct borrow_tag {};
+
+    /**
+     * @brief Construct a view of a `parser` without copying its
+     *        options.
+     *
+     * The index points directly at the options held by `source`, so
+     * the result is only valid until `source` is modified. The
+     * `parser` uses this to parse through the same code as a real
+     * snapshot.
+     *
+     * @param source The `parser` to index.
+     */
+    compiled_parser(const parser& source, borrow_tag);
+
+    /**
+     * @brief Copy the custom strings from a `parser`.
+     * @param source The `parser` to copy from.
+     */
+    void copy_strings(const parser& source);
+
+    /**
+     * @brief Rebuild the index over the owned option table.
+     */
+    void reindex();
+
+    /**
+     * @brief Receives entries from the parsing engine.
+     *
+     * The engine reports each entry through `add` as soon as it has
+     * seen the option or non-option argument. If the option's
+     * argument turns out to be in the next command-line argument,
+     * `add_argument` is called afterward to complete the entry.
+     */
+    class entry_sink {
+    public:
+      /**
+       * @brief Destructor.
+       */
+      virtual ~entry_sink() {}
+
+      /**
+       * @brief Receive a new entry.
+       * @param entry The entry. Its `long_name` and `argument` fields
+       *              point into the option table or into the current
+       *              command-line argument.
+       * @param transient_text If true, `original_text` (and
+       *                       `original_without_argument`, which is
+       *                       always a prefix of it) point into a
+       *                       scratch buffer that is reused for the
+       *                       next entry.
+       */
+      virtual void add(const parsed_entry_ref& entry, bool transient_text) = 0;
+
+      /**
+       * @brief Complete the most recent entry with an argument given
+       *        as a separate command-line argument.
+       * @param argument The argument.
+       */
+      virtual void add_argument(string_ref argument) = 0;
+
+      /**
+       * @brief Signal that the most recent entry, whose option could
+       *        take a separate argument, does not have one.
+       */
+      virtual void no_argument() {}
+
+      /**
+       * @brief Keep a command-line argument that was split from a
+       *        string.
+       *
+       * Split arguments live in a buffer that the tokenizer reuses,
+       * so a sink that keeps references to them must copy them here.
+       *
+       * @param token The argument.
+       * @return Reference to the argument that stays valid as long as
+       *         the sink needs it.
+       */
+      virtual string_ref keep(string_ref token) { return token; }
+    };
+
+    /**
+     * @brief Sink that appends entries to a `parser_result`.
+     */
+    class result_sink : public entry_sink {
+    public:
+      /**
+       * @brief Constructor.
+       * @param result The `parser_result` to append to.
+       */
+      explicit result_sink(parser_result& result) noexcept : m_result(result) {}
+
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+
+    private:
+      parser_result& m_result; //< Result being filled.
+    };
+
+    /**
+     * @brief Sink that appends entries to a `parser_result_ref`.
+     *
+     * Only text from the scratch buffer is copied; everything else
+     * is referenced in place.
+     */
+    class result_ref_sink : public entry_sink {
+    public:
+      /**
+       * @brief Constructor.
+       * @param result The `parser_result_ref` to append to.
+       */
+      explicit result_ref_sink(parser_result_ref& result) noexcept : m_result(result) {}
+
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+      string_ref keep(string_ref token) override { return m_result.store(token); }
+
+    private:
+      parser_result_ref& m_result; //< Result being filled.
+    };
+
+    /**
+     * @brief Sink that appends entries to a `batch_result`.
+     *
+     * The command-line arguments must already be stored in the
+     * result.
+     */
+    class batch_sink : public entry_sink {
+    public:
+      /**
+       * @brief Constructor.
+       * @param result The `batch_result` to append to.
+       */
+      explicit batch_sink(batch_result& result) noexcept : m_result(result) {}
+
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+      string_ref keep(string_ref token) override { return m_result.store(token); }
+
+    private:
+      batch_result& m_result; //< Result being filled.
+    };
+
+    /**
+     * @brief Sink that only counts entries.
+     */
+    class count_sink : public entry_sink {
+    public:
+      void add(const parsed_entry_ref&, bool) override { ++m_count; }
+      void add_argument(string_ref) override {}
+
+      /**
+       * @brief Get the number of entries added so far.
+       * @return Number of entries.
+       */
+      size_type count() const noexcept { return m_count; }
+
+    private:
+      size_type m_count{0}; //< Number of entries added.
+    };
+
+    /**
+     * @brief Sink that writes entries to consecutive elements of an
+     *        existing array, reusing their strings.
+     */
+    class slice_sink : public entry_sink {
+    public:
+      /**
+       * @brief Constructor.
+       * @param entries The array. It must have room for every entry.
+       * @param position Position of the first entry to write.
+       */
+      slice_sink(std::vector<parsed_entry>& entries, size_type position) noexcept
+        : m_entries(entries), m_position(position) {}
+
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+
+      /**
+       * @brief Get the position of the next entry to write.
+       * @return Position in the array.
+       */
+      size_type position() const noexcept { return m_position; }
+
+    private:
+      std::vector<parsed_entry>& m_entries; //< The array.
+      size_type m_position; //< Position of the next entry to write.
+    };
+
+    /**
+     * @brief Represents the type of a command-line argument.
+     */
+    enum class cl_arg_type { non_option, //< If the argument is not an option.
+                             end_indicator, //< If the argument is an end-of-options marker.
+                             arg_required, //< If the argument ends with an option that needs a mandatory argument.
+                             arg_optional, //< If the argument ends with an option that can take an optional argument.
+                             no_arg //< If the argument ends with an option that does not take an argument (or an argument was already given).
+    };
+
+    /**
+     * @brief State carried by the engine from one command-line
+     *        argument to the next.
+     */
+    struct parse_state {
+      /**
+       * @brief Constructor.
+       * @param status Receives the error, if any.
+       */
+      explicit parse_state(parse_status& status) noexcept : status(status) {}
+
+      cl_arg_type type{cl_arg_type::non_option}; //< Type of the previous argument.
+      const option* pending{nullptr}; //< Option waiting for a separate argument.
+      std::string pending_name; //< Name used for the pending option.
+      size_type pending_index{0}; //< Index of the argument holding the pending option.
+      size_type pending_offset{0}; //< Offset of the pending option within its argument.
+      size_type index{0}; //< Index of the current argument.
+      string_ref token; //< The current argument.
+      std::string scratch; //< Buffer for text that must be pieced together.
+      bool write_bound{true}; //< Whether to write to bound variables.
+      const parse_target* target{nullptr}; //< Object receiving bound members, if any.
+      bool stop_at_non_option{false}; //< Whether to stop before the first non-option argument.
+      bool stop_after_end_indicator{false}; //< Whether to stop before the first argument after an end-of-options marker.
+      bool stopped{false}; //< Whether parsing stopped before the current argument.
+      std::vector<mapped_file::id_type> open_files; //< Response files being expanded, outermost first.
+      parse_status& status; //< Receives the error, if any.
+    };
+
+    /**
+     * @brief Sink that passes entries to the handlers of `visit`.
+     *
+     * An option that may still receive a separate argument is held
+     * back until the engine adds the argument or signals that there
+     * is none.
+     */
+    class visit_sink : public entry_sink {
+    public:
+      /**
+       * @brief Constructor.
+       * @param on_option Receives each option.
+       * @param on_non_option Receives each non-option argument.
+       * @param state Parsing state, marked as stopped when a handler
+       *              returns false.
+       */
+      visit_sink(const option_handler& on_option,
+                 const non_option_handler& on_non_option,
+                 parse_state& state) noexcept
+        : m_on_option(on_option), m_on_non_option(on_non_option),
+          m_state(state) {}
+
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+      void no_argument() override { flush(); }
+
+      /**
+       * @brief Pass the held option, if any, on without an argument.
+       */
+      void flush();
+
+    private:
+      /**
+       * @brief Pass an option on, unless parsing has stopped.
+       * @param opt The option.
+       * @param argument Its argument, or an empty string.
+       */
+      void visit_option(const option& opt, string_ref argument);
+
+      const option_handler& m_on_option; //< Receives each option.
+      const non_option_handler& m_on_non_option; //< Receives each non-option.
+      parse_state& m_state; //< Parsing state.
+      const option* m_held{nullptr}; //< Option waiting for a separate argument.
+    };
+
+    /**
+     * @brief Parse a single command-line argument.
+     *
+     * Decides from the state left by the previous argument whether
+     * `token` is an option argument, a non-option, or an option (or
+     * group of options), and reports the result to `sink`.
+     *
+     * @param token Command-line argument to parse.
+     * @param state Parsing state, updated for the next argument.
+     * @param sink Receives the parsed entries.
+     * @return False if an option is invalid or an option argument
+     *         cannot be converted; the error is stored in the state's
+     *         status.
+     */
+    bool parse_token(string_ref token, parse_state& state, entry_sink& sink) const;
+
+    /**
+     * @brief Parse each argument in a response file.
+     *
+     * The file is split lazily, one argument at a time, and every
+     * argument is passed through `parse_token`, so nested response
+     * files are expanded recursively.
+     *
+     * @param path Path of the response file.
+     * @param state Parsing state.
+     * @param sink Receives the parsed entries.
+     * @return False if the file cannot be read, if it is already being
+     *         expanded, or if one of its arguments cannot be parsed.
+     */
+    bool parse_response_file(string_ref path, parse_state& state,
+                             entry_sink& sink) const;
+
+    /**
+     * @brief Split a command-line string and parse each argument.
+     * @param cmd_line The command-line string.
+     * @param ignore_first If true, the first argument is skipped.
+     * @param buffer Tokenizer buffer to reuse.
+     * @param state Parsing state.
+     * @param sink Receives the parsed entries.
+     * @return False if there was an error.
+     */
+    bool parse_string(string_ref cmd_line, bool ignore_first,
+                      std::string& buffer, parse_state& state,
+                      entry_sink& sink) const;
+
+    /**
+     * @brief Parse one line of a batch.
+     *
+     * Errors are recorded in the result instead of being thrown.
+     *
+     * @param line The command line.
+     * @param ignore_first If true, the first argument is ignored.
+     * @param state Parsing state to reuse.
+     * @param buffer Tokenizer buffer to reuse.
+     * @param result The `batch_result` to append the line to.
+     */
+    void parse_line(string_ref line, bool ignore_first, parse_state& state,
+                    std::string& buffer, batch_result& result) const;
+
+    /**
+     * @brief Run tasks, possibly in parallel, and wait for them.
+     * @param task_count Number of tasks.
+     * @param run_task Runs the task with the given number.
+     * @param executor Function that runs the tasks, or an empty
+     *                 function to run them on the calling thread.
+     * @throw Any exception thrown by a task or by the executor, once
+     *        every task that was submitted has finished.
+     */
+    static void run_tasks(size_type task_count,
+                          const std::function<void(size_type)>& run_task,
+                          const executor_type& executor);
+
+    /**
+     * @brief Parse a sequence of command-line arguments in parallel.
+     * @param args The arguments.
+     * @param executor Function that runs the tasks.
+     * @param args_per_task Number of arguments in each task.
+     * @param ignore_first If true, the first argument is ignored.
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param status Receives the outcome. It is cleared first.
+     */
+    void parse_args(const std::vector<string_ref>& args,
+                    const executor_type& executor, size_type args_per_task,
+                    bool ignore_first, parser_result& result,
+                    parse_status& status) const;
+
+    /**
+     * @brief Parse the lines of a batch, possibly in parallel.
+     * @param lines The command lines.
+     * @param executor Function that runs the tasks, or an empty
+     *                 function to parse on the calling thread.
+     * @param lines_per_task Number of lines in each task.
+     * @param ignore_first If true, the first argument of each line is
+     *                     ignored.
+     * @return The `batch_result`.
+     */
+    batch_result parse_lines(const std::vector<string_ref>& lines,
+                             const executor_type& executor,
+                             size_type lines_per_task,
+                             bool ignore_first) const;
+
+    /**
+     * @brief Finish parsing.
+     * @param state Parsing state after the last argument.
+     * @return False if the last option is missing a mandatory
+     *         argument.
+     */
+    bool finish(parse_state& state) const;
+
+    /**
+     * @brief Record an error in the state's status.
+     * @param state Parsing state.
+     * @param error The kind of error.
+     * @param offset Byte offset within the current argument.
+     * @param prefix Start of the option text.
+     * @param name Rest of the option text.
+     * @return Always false.
+     */
+    static bool fail(parse_state& state, parse_errc error,
+                     string_ref::size_type offset, string_ref prefix,
+                     string_ref name = string_ref{});
+
+    /**
+     * @brief Convert an option argument and write it where the state
+     *        directs.
+     *
+     * With a target in the state, only bound members of the target are
+     * written; otherwise only bound variables are.
+     *
+     * @param opt The option.
+     * @param argument The option argument.
+     * @param state Parsing state.
+     * @return `parse_errc::none`, or the reason the argument could not
+     *         be converted.
+     */
+    static parse_errc write_argument(const option& opt, string_ref argument,
+                                     const parse_state& state) {
+      if (state.target)
+        return opt.write_argument(argument, *state.target, state.write_bound);
+      return opt.write_argument(argument, state.write_bound);
+    }
+
+    /**
+     * @brief Record that an option was set, where the state directs.
+     * @param opt The option.
+     * @param state Parsing state.
+     */
+    static void write_flag(const option& opt, const parse_state& state) noexcept {
+      if (!state.write_bound)
+        return;
+      if (state.target)
+        opt.write_bool(true, *state.target);
+      else
+        opt.write_bool(true);
+    }
+
+    /**
+     * @brief Search for an option by long name.
+     * @param long_name Long name for the option.
+     * @return Pointer to the option, or `nullptr` if not found.
+     */
+    const option* find_option(string_ref long_name) const noexcept {
+      return m_index.find(long_name.data(), long_name.size());
+    }
+
+    /**
+     * @brief Search for an option by short name.
+     * @param short_name Short name for the option.
+     * @return Pointer to the option, or `nullptr` if not found.
+     */
+    const option* find_option(char short_name) const noexcept {
+      return m_index.find(short_name);
+    }
+
+    /**
+     * @brief Return the syntax used to classify arguments.
+     * @return View of the option prefixes, end-of-options marker and
+     *         equals string.
+     */
+    option_syntax syntax() const noexcept {
+      return option_syntax{m_short_option_prefix, m_long_option_prefix,
+                           m_end_of_options, m_equals};
+    }
+
+    /**
+     * @brief Parse a command-line argument that is not an option
+     *        argument.
+     * @param argument Argument to parse.
+     * @param state Parsing state. The type will be set to the
+     *              appropriate argument type.
+     * @param sink Receives the parsed entries.
+     * @return False if the option is invalid or its argument cannot
+     *         be converted.
+     * @see cl_arg_type
+     */
+    bool parse_argument(string_ref argument, parse_state& state,
+                        entry_sink& sink) const;
+
+    /**
+     * @brief Parse a group of short options.
+     * @param specifier The argument up to the equals string, if any.
+     * @param argument Option argument that was provided, if any.
+     * @param has_arg Should be true if an argument was found (even an
+     *                empty one).
+     * @param state Parsing state. The type will be set to the
+     *              appropriate argument type.
+     * @param sink Receives the parsed entries.
+     * @return False if an option is invalid or an argument cannot be
+     *         converted.
+     * @see cl_arg_type
+     */
+    bool parse_short_option_group(string_ref specifier,
+                                  string_ref argument, bool has_arg,
+                                  parse_state& state, entry_sink& sink) const;
+
+    /**
+     * @brief Parse a sequence of command-line arguments.
+     * @tparam InputIt The iterator type.
+     * @param first Iterator pointing to the first argument. It is
+     *              advanced past the parsed arguments, so it points to
+     *              the argument where parsing stopped if the state's
+     *              `stopped` flag is set.
+     * @param last Iterator pointing to one past the last argument.
+     * @param ignore_first If true, the first argument is skipped.
+     * @param state Parsing state.
+     * @param sink Receives the parsed entries.
+     * @return False if there was an error.
+     */
+    template <typename InputIt>
+    bool parse_range(InputIt& first, InputIt last, bool ignore_first,
+                     parse_state& state, entry_sink& sink) const;
+
+    std::vector<option> m_options; //< Flattened option table (empty for a borrowed view).
+    option_index m_index; //< Lookup table for the options.
+
+    std::string m_delims{" \t\n\r"}; //< Delimiters used to separate command-line arguments.
+    std::string m_short_option_prefix{"-"}; //< String that indicates a group of short option names.
+    std::string m_long_option_prefix{"--"}; //< String that indicates a long option name.
+    std::string m_end_of_options{"--"}; //< String that marks the end of the program options.
+    std::string m_equals{"="}; //< String used to specify an explicit argument to an option.
+    std::string m_response_file_prefix; //< String that introduces a response file, or empty if disabled.
+    bool m_allow_abbreviations{false}; //< Whether long options can be given by a unique prefix.
+    std::shared_ptr<const suggestion_index> m_suggestions; //< Long names to suggest for misspelled options, or null if disabled.
+    tokenizer m_tokenizer; //< Splits command-line strings over `m_delims`.
+  };
+
+} // End namespace
+
+/* Implementation */
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+template <typename InputIt>
+optionpp::parser_result
+optionpp::compiled_parser::parse(InputIt first, InputIt last, bool ignore_first) const {
+  parser_result result{};
+  parse_into(result, first, last, ignore_first);
+  return result;
+}
+
+template <typename InputIt>
+void optionpp::compiled_parser::parse_into(parser_result& result,
+                                           InputIt first, InputIt last,
+                                           bool ignore_first) const {
+  parse_status status;
+  parse_into(result, first, last, status, ignore_first);
+  if (!status)
+    throw status.to_error();
+}
+
+template <typename InputIt>
+void optionpp::compiled_parser::parse_into(parser_result& result,
+                                           InputIt first, InputIt last,
+                                           parse_status& status,
+                                           bool ignore_first) const {
+  result.clear();
+  status.clear();
+  result_sink sink{result};
+  parse_state state{status};
+  parse_range(first, last, ignore_first, state, sink);
+}
+
+template <typename InputIt>
+void optionpp::compiled_parser::parse_into(parser_result& result,
+                                           InputIt first, InputIt last,
+                                           const parse_target& target,
+                                           parse_status& status,
+                                           bool ignore_first) const {
+  result.clear();
+  status.clear();
+  result_sink sink{result};
+  parse_state state{status};
+  state.target = &target;
+  parse_range(first, last, ignore_first, state, sink);
+}
+
+template <typename InputIt>
+InputIt optionpp::compiled_parser::parse_leading_options(parser_result& result,
+                                                         InputIt first,
+                                                         InputIt last,
+                                                         bool ignore_first) const {
+  parse_status status;
+  first = parse_leading_options(result, first, last, status, ignore_first);
+  if (!status)
+    throw status.to_error();
+  return first;
+}
+
+template <typename InputIt>
+InputIt optionpp::compiled_parser::parse_leading_options(parser_result& result,
+                                                         InputIt first,
+                                                         InputIt last,
+                                                         parse_status& status,
+                                                         bool ignore_first) const {
+  result.clear();
+  status.clear();
+  result_sink sink{result};
+  parse_state state{status};
+  state.stop_at_non_option = true;
+  state.stop_after_end_indicator = true;
+  parse_range(first, last, ignore_first, state, sink);
+  return first;
+}
+
+template <typename InputIt>
+optionpp::parser_result_ref
+optionpp::compiled_parser::parse_ref(InputIt first, InputIt last,
+                                     bool ignore_first) const {
+  parser_result_ref result{};
+  result_ref_sink sink{result};
+  parse_status status;
+  parse_state state{status};
+  if (!parse_range(first, last, ignore_first, state, sink))
+    throw status.to_error();
+  return result;
+}
+
+template <typename InputIt>
+bool optionpp::compiled_parser::parse_range(InputIt& first, InputIt last,
+                                            bool ignore_first,
+                                            parse_state& state,
+                                            entry_sink& sink) const {
+  if (ignore_first && first != last) {
+    ++first;
+    ++state.index;
+  }
+
+  for (; first != last; ++first) {
+    const auto& arg = *first;
+    if (!parse_token(arg, state, sink))
+      return false;
+    if (state.stopped)
+      break;
+  }
+
+  return state.stopped || finish(state);
+}
+
+template <typename InputIt>
+bool optionpp::compiled_parser::visit(InputIt first, InputIt last,
+                                      const option_handler& on_option,
+                                      const non_option_handler& on_non_option,
+                                      parse_status& status,
+                                      bool ignore_first) const {
+  status.clear();
+  parse_state state{status};
+  visit_sink sink{on_option, on_non_option, state};
+  if (!parse_range(first, last, ignore_first, state, sink))
+    return false;
+  sink.flush();
+  return !state.stopped;
+}
+
+template <typename InputIt>
+optionpp::batch_result
+optionpp::compiled_parser::parse_batch(InputIt first, InputIt last,
+                                       bool ignore_first) const {
+  batch_result result{};
+  parse_status status;
+  parse_state state{status};
+  state.write_bound = false;
+  std::string buffer;
+  for (; first != last; ++first) {
+    const auto& line = *first;
+    parse_line(line, ignore_first, state, buffer, result);
+  }
+  return result;
+}
+
+template <typename ForwardIt>
+optionpp::parser_result
+optionpp::compiled_parser::parse_parallel(ForwardIt first, ForwardIt last,
+                                          const executor_type& executor,
+                                          size_type args_per_task,
+                                          bool ignore_first) const {
+  parser_result result{};
+  parse_status status;
+  parse_parallel_into(result, first, last, executor, status, args_per_task,
+                      ignore_first);
+  if (!status)
+    throw status.to_error();
+  return result;
+}
+
+template <typename ForwardIt>
+void optionpp::compiled_parser::parse_parallel_into(parser_result& result,
+                                                    ForwardIt first,
+                                                    ForwardIt last,
+                                                    const executor_type& executor,
+                                                    parse_status& status,
+                                                    size_type args_per_task,
+                                                    bool ignore_first) const {
+  std::vector<string_ref> args;
+  args.reserve(std::distance(first, last));
+  for (; first != last; ++first) {
+    const auto& arg = *first;
+    args.push_back(arg);
+  }
+  parse_args(args, executor, args_per_task, ignore_first, result, status);
+}
+
+template <typename ForwardIt>
+optionpp::batch_result
+optionpp::compiled_parser::parse_batch(ForwardIt first, ForwardIt last,
+                                       const executor_type& executor,
+                                       size_type lines_per_task,
+                                       bool ignore_first) const {
+  std::vector<string_ref> lines;
+  for (; first != last; ++first) {
+    const auto& line = *first;
+    lines.push_back(line);
+  }
+  return parse_lines(lines, executor, lines_per_task, ignore_first);
+}
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
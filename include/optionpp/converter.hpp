@@ -0,0 +1,333 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `converter` traits, which convert option
+ *        arguments to the types of bound variables.
+ */
+
+#ifndef OPTIONPP_CONVERTER_HPP
+#define OPTIONPP_CONVERTER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <optionpp/parse_status.hpp>
+#include <optionpp/string_ref.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief A number of bytes, written with an optional unit suffix.
+   *
+   * Bind a `byte_size` to an option to accept arguments such as
+   * `512`, `64K`, `64M`, `1.5GiB` or `2tb`. The suffixes `K`, `M`,
+   * `G`, `T`, `P` and `E` (in any case, optionally followed by `i`
+   * and/or `B`) multiply by powers of 1024; a lone `B` means bytes.
+   * Fractional values are rounded to the nearest byte.
+   */
+  struct byte_size {
+    unsigned long long bytes{0}; //< The number of bytes.
+
+    /**
+     * @brief Default constructor. Sets the size to zero.
+     */
+    byte_size() noexcept {}
+
+    /**
+     * @brief Constructor.
+     * @param bytes The number of bytes.
+     */
+    explicit byte_size(unsigned long long bytes) noexcept : bytes{bytes} {}
+  };
+
+  /**
+   * @brief Names of the values of an enumeration, for use in option
+   *        arguments.
+   *
+   * Specialize this template with a static `names` function that
+   * returns a range of pairs, each holding a name and the
+   * corresponding value. An option bound to the enumeration then
+   * accepts exactly those names:
+   * ```
+   * enum class color { red, green };
+   *
+   * namespace optionpp {
+   *   template <>
+   *   struct enum_names<color> {
+   *     using table = std::vector<std::pair<std::string, color>>;
+   *     static const table& names() {
+   *       static const table values{{"red", color::red},
+   *                                 {"green", color::green}};
+   *       return values;
+   *     }
+   *   };
+   * }
+   * ```
+   * Without a specialization, the argument is read as the underlying
+   * integer value.
+   *
+   * @tparam T The enumeration type.
+   */
+  template <typename T>
+  struct enum_names {};
+
+  /**
+   * @brief Traits that convert an option argument to a `T`.
+   *
+   * Each specialization provides two static functions:
+   * ```
+   * static const char* argument_name() noexcept;
+   * static parse_errc convert(string_ref argument, T& value);
+   * ```
+   * `argument_name` gives the argument name used in the help text
+   * when none was set, and `convert` converts `argument`, storing the
+   * result in `value` only on success.
+   *
+   * Specializations are provided for `std::string`, all integer and
+   * floating-point types (except `bool`), `std::chrono::duration`,
+   * `byte_size` and enumerations (see `enum_names`). Specialize the
+   * template to support other types in `option::bind`.
+   *
+   * @tparam T Type of the bound variable.
+   * @tparam Enable Used to select specializations for families of
+   *                types with `std::enable_if`.
+   */
+  template <typename T, typename Enable = void>
+  struct converter;
+
+  /**
+   * @brief Convert an argument to a signed integer in a given range.
+   * @param argument The argument.
+   * @param value Receives the value on success.
+   * @param min Smallest allowed value.
+   * @param max Largest allowed value.
+   * @return `parse_errc::none`, `parse_errc::not_an_integer` or
+   *         `parse_errc::out_of_range`.
+   */
+  parse_errc convert_integer(string_ref argument, long long& value,
+                             long long min, long long max) noexcept;
+
+  /**
+   * @brief Convert an argument to an unsigned integer up to a given
+   *        maximum.
+   * @param argument The argument.
+   * @param value Receives the value on success.
+   * @param max Largest allowed value.
+   * @return `parse_errc::none`, `parse_errc::not_an_integer`,
+   *         `parse_errc::negative_argument` or
+   *         `parse_errc::out_of_range`.
+   */
+  parse_errc convert_unsigned(string_ref argument, unsigned long long& value,
+                              unsigned long long max) noexcept;
+
+  /**
+   * @brief Convert an argument to a floating-point number whose
+   *        magnitude is at most a given maximum.
+   * @param argument The argument.
+   * @param value Receives the value on success.
+   * @param max Largest allowed finite magnitude.
+   * @return `parse_errc::none`, `parse_errc::not_a_number` or
+   *         `parse_errc::out_of_range`.
+   */
+  parse_errc convert_floating(string_ref argument, double& value,
+                              double max) noexcept;
+
+  /**
+   * @brief Convert an argument to a number of bytes.
+   * @param argument The argument, as described for `byte_size`.
+   * @param value Receives the number of bytes on success.
+   * @return `parse_errc::none`, `parse_errc::not_a_number`,
+   *         `parse_errc::negative_argument`,
+   *         `parse_errc::invalid_value` for an unknown suffix, or
+   *         `parse_errc::out_of_range`.
+   */
+  parse_errc convert_byte_size(string_ref argument,
+                               unsigned long long& value) noexcept;
+
+  /**
+   * @brief Convert an argument to a count of time units.
+   *
+   * The argument is a number followed by an optional unit: `ns`,
+   * `us`, `ms`, `s`, `m` or `min`, `h` or `d`. Without a unit, the
+   * number is a count of the target units.
+   *
+   * @param argument The argument.
+   * @param num Numerator of the target unit, in seconds.
+   * @param den Denominator of the target unit, in seconds.
+   * @param integral If true, the count is rounded to the nearest
+   *                 integer and stored in `count`; otherwise it is
+   *                 stored in `real`.
+   * @param count Receives an integral count on success.
+   * @param real Receives a floating-point count on success.
+   * @return `parse_errc::none`, `parse_errc::not_a_number`,
+   *         `parse_errc::invalid_value` for an unknown unit, or
+   *         `parse_errc::out_of_range`.
+   */
+  parse_errc convert_duration(string_ref argument,
+                              std::intmax_t num, std::intmax_t den,
+                              bool integral, long long& count,
+                              long double& real) noexcept;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+  template <>
+  struct converter<std::string> {
+    static const char* argument_name() noexcept { return "STRING"; }
+
+    static parse_errc convert(string_ref argument, std::string& value) {
+      value.assign(argument.data(), argument.size());
+      return parse_errc::none;
+    }
+  };
+
+  template <typename T>
+  struct converter<T, typename std::enable_if<std::is_integral<T>::value
+                                              && std::is_signed<T>::value>::type> {
+    static const char* argument_name() noexcept { return "INTEGER"; }
+
+    static parse_errc convert(string_ref argument, T& value) noexcept {
+      long long wide = 0;
+      auto err = convert_integer(argument, wide,
+                                 std::numeric_limits<T>::min(),
+                                 std::numeric_limits<T>::max());
+      if (err == parse_errc::none)
+        value = static_cast<T>(wide);
+      return err;
+    }
+  };
+
+  template <typename T>
+  struct converter<T, typename std::enable_if<std::is_integral<T>::value
+                                              && std::is_unsigned<T>::value
+                                              && !std::is_same<T, bool>::value>::type> {
+    static const char* argument_name() noexcept { return "INTEGER"; }
+
+    static parse_errc convert(string_ref argument, T& value) noexcept {
+      unsigned long long wide = 0;
+      auto err = convert_unsigned(argument, wide, std::numeric_limits<T>::max());
+      if (err == parse_errc::none)
+        value = static_cast<T>(wide);
+      return err;
+    }
+  };
+
+  template <typename T>
+  struct converter<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    static const char* argument_name() noexcept { return "NUMBER"; }
+
+    static parse_errc convert(string_ref argument, T& value) noexcept {
+      const double max = std::numeric_limits<T>::max() < std::numeric_limits<double>::max()
+        ? static_cast<double>(std::numeric_limits<T>::max())
+        : std::numeric_limits<double>::max();
+      double wide = 0;
+      auto err = convert_floating(argument, wide, max);
+      if (err == parse_errc::none)
+        value = static_cast<T>(wide);
+      return err;
+    }
+  };
+
+  template <typename Rep, typename Period>
+  struct converter<std::chrono::duration<Rep, Period>> {
+    static const char* argument_name() noexcept { return "DURATION"; }
+
+    static parse_errc convert(string_ref argument,
+                              std::chrono::duration<Rep, Period>& value) noexcept {
+      long long count = 0;
+      long double real = 0;
+      auto err = convert_duration(argument, Period::num, Period::den,
+                                  std::is_integral<Rep>::value, count, real);
+      if (err != parse_errc::none)
+        return err;
+      return store(count, real, value, std::is_integral<Rep>{});
+    }
+
+  private:
+    static parse_errc store(long long count, long double,
+                            std::chrono::duration<Rep, Period>& value,
+                            std::true_type) noexcept {
+      const bool out_of_range = count < 0
+        ? count < static_cast<long long>(std::numeric_limits<Rep>::min())
+        : static_cast<unsigned long long>(count)
+          > static_cast<unsigned long long>(std::numeric_limits<Rep>::max());
+      if (out_of_range)
+        return parse_errc::out_of_range;
+      value = std::chrono::duration<Rep, Period>{static_cast<Rep>(count)};
+      return parse_errc::none;
+    }
+
+    static parse_errc store(long long, long double real,
+                            std::chrono::duration<Rep, Period>& value,
+                            std::false_type) noexcept {
+      value = std::chrono::duration<Rep, Period>{static_cast<Rep>(real)};
+      return parse_errc::none;
+    }
+  };
+
+  template <>
+  struct converter<byte_size> {
+    static const char* argument_name() noexcept { return "SIZE"; }
+
+    static parse_errc convert(string_ref argument, byte_size& value) noexcept {
+      return convert_byte_size(argument, value.bytes);
+    }
+  };
+
+  template <typename T>
+  struct converter<T, typename std::enable_if<std::is_enum<T>::value>::type> {
+    static const char* argument_name() noexcept { return "VALUE"; }
+
+    static parse_errc convert(string_ref argument, T& value) {
+      return find(argument, value, 0);
+    }
+
+  private:
+    // Chosen when enum_names<T> provides names
+    template <typename U>
+    static auto find(string_ref argument, U& value, int)
+      -> decltype(enum_names<U>::names(), parse_errc{}) {
+      for (const auto& entry : enum_names<U>::names()) {
+        if (argument == string_ref{entry.first}) {
+          value = entry.second;
+          return parse_errc::none;
+        }
+      }
+      return parse_errc::invalid_value;
+    }
+
+    template <typename U>
+    static parse_errc find(string_ref argument, U& value, long) {
+      using underlying = typename std::underlying_type<U>::type;
+      underlying number{};
+      auto err = converter<underlying>::convert(argument, number);
+      if (err == parse_errc::none)
+        value = static_cast<U>(number);
+      return err;
+    }
+  };
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+} // End namespace
+
+#endif
@@ -96,6 +96,59 @@ namespace optionpp {
       : error(msg, fn_name) {}
   };
 
+  /**
+   * @brief Exception indicating that an option name is already in
+   *        use.
+   */
+  class duplicate_option_error : public error {
+  public:
+    /**
+     * @brief Constructor.
+     * @param msg Description of the error.
+     * @param fn_name Name of the function in which error occurred.
+     * @param option The name that is already in use.
+     */
+    duplicate_option_error(const std::string& msg,
+                           const std::string& fn_name,
+                           const std::string& option)
+      : error(msg, fn_name), m_option{option} {}
+
+    /**
+     * @brief Return option name.
+     * @return The name that is already in use.
+     */
+    const std::string& option() const noexcept { return m_option; }
+
+  private:
+    std::string m_option; //< The name that is already in use.
+  };
+
+  /**
+   * @brief Exception class indicating an invalid option.
+   */
+  class parse_error : public error {
+  public:
+    /**
+     * @brief Constructor.
+     * @param msg String describing the error.
+     * @param fn_name Name of the function that threw the exception.
+     * @param option Name of the option that triggered the error (if
+     *               any).
+     */
+    parse_error(const std::string msg, const std::string fn_name,
+                const std::string option = "")
+      : error(msg, fn_name), m_option{option} {}
+
+    /**
+     * @brief Return option name.
+     * @return Option that triggered the error, if any.
+     */
+    const std::string& option() const noexcept { return m_option; }
+
+  private:
+    std::string m_option; //< Option that triggered the error.
+  };
+
 } // End namespace
 
 #endif
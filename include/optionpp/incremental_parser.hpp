@@ -0,0 +1,246 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `incremental_parser` class.
+ */
+
+#ifndef OPTIONPP_INCREMENTAL_PARSER_HPP
+#define OPTIONPP_INCREMENTAL_PARSER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <optionpp/compiled_parser.hpp>
+#include <optionpp/parse_status.hpp>
+#include <optionpp/parser.hpp>
+#include <optionpp/parser_result_ref.hpp>
+#include <optionpp/string_ref.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Parser that accepts command-line arguments one at a time.
+   *
+   * An `incremental_parser` is fed each command-line argument with
+   * `feed` as it becomes available, and `finish` is called after the
+   * last one. Each entry is passed to a handler as soon as it is
+   * complete: an option that takes an argument is held back until
+   * the next command-line argument shows whether that argument is
+   * present. At most one entry is held at a time, so memory use does
+   * not grow with the number of arguments.
+   *
+   * The entries, the values written to bound variables and the errors
+   * are the same as those of `parser::parse` over the same sequence of
+   * arguments, except that after an error no further entries are
+   * passed to the handler.
+   *
+   * Example:
+   * ```
+   * incremental_parser session{my_parser, [](const parsed_entry_ref& entry) {
+   *     // Act on the entry...
+   *   }};
+   * while (read_argument(arg))
+   *   session.feed(arg);
+   * session.finish();
+   * ```
+   *
+   * The strings in the entry given to the handler are only valid
+   * during the call (use `parsed_entry_ref::to_entry` to keep a
+   * copy), and an argument passed to `feed` only needs to stay valid
+   * until `feed` returns.
+   */
+  class incremental_parser {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Type of function that receives the complete entries.
+     */
+    using entry_handler = std::function<void(const parsed_entry_ref&)>;
+
+    /**
+     * @brief Construct from a `compiled_parser`.
+     * @param source The `compiled_parser`. It must outlive the
+     *               `incremental_parser`.
+     * @param handler Receives each entry once it is complete. May be
+     *                empty, if only bound variables are of interest.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     */
+    incremental_parser(const compiled_parser& source, entry_handler handler,
+                       bool ignore_first = false);
+
+    /**
+     * @brief Construct from a `parser`.
+     * @param source The `parser`. It must outlive the
+     *               `incremental_parser`, and its options must not be
+     *               changed while the `incremental_parser` is in use.
+     * @param handler Receives each entry once it is complete.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     */
+    incremental_parser(const parser& source, entry_handler handler,
+                       bool ignore_first = false)
+      : incremental_parser(source.compiled(), std::move(handler), ignore_first) {}
+
+    incremental_parser(const incremental_parser&) = delete;
+    incremental_parser& operator=(const incremental_parser&) = delete;
+
+    /**
+     * @brief Parse the next command-line argument.
+     * @param argument The argument.
+     * @throw parse_error If the argument is invalid, or if an earlier
+     *                    call failed and `reset` was not called.
+     */
+    void feed(string_ref argument);
+
+    /**
+     * @brief Parse the next command-line argument without throwing on
+     *        invalid input.
+     * @param argument The argument.
+     * @param status Receives the outcome.
+     * @return True on success.
+     */
+    bool feed(string_ref argument, parse_status& status);
+
+    /**
+     * @brief Signal that there are no more arguments.
+     *
+     * Passes the held entry, if any, to the handler and resets the
+     * parser for a new command line.
+     *
+     * @throw parse_error If the last option is missing a mandatory
+     *                    argument, or if an earlier call failed.
+     */
+    void finish();
+
+    /**
+     * @brief Signal that there are no more arguments, without throwing
+     *        on invalid input.
+     * @param status Receives the outcome.
+     * @return True on success.
+     */
+    bool finish(parse_status& status);
+
+    /**
+     * @brief Discard the current command line and start a new one.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Return the number of arguments fed since the last reset.
+     * @return Number of arguments, including an ignored first one.
+     */
+    size_type argument_count() const noexcept { return m_state.index; }
+
+    /**
+     * @brief Check whether an option is waiting for its argument.
+     * @return True if the last entry is being held back until the
+     *         next argument.
+     */
+    bool waiting_for_argument() const noexcept {
+      return m_state.type == compiled_parser::cl_arg_type::arg_required
+        || m_state.type == compiled_parser::cl_arg_type::arg_optional;
+    }
+
+  private:
+
+    /**
+     * @brief Sink that holds back the most recent entry.
+     */
+    class entry_buffer : public compiled_parser::entry_sink {
+    public:
+      /**
+       * @brief Constructor.
+       * @param handler Receives the complete entries.
+       */
+      explicit entry_buffer(entry_handler handler)
+        : m_handler{std::move(handler)} {}
+
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+
+      /**
+       * @brief Copy an argument read from a response file.
+       *
+       * The held entry is copied first, since it may still refer to
+       * the previous argument from the file.
+       *
+       * @param token The argument.
+       * @return Reference to the copy, valid until the next call.
+       */
+      string_ref keep(string_ref token) override;
+
+      /**
+       * @brief Pass the held entry, if any, to the handler.
+       */
+      void flush();
+
+      /**
+       * @brief Copy the held entry's text so that it outlives the
+       *        current argument and the engine's scratch buffer.
+       */
+      void keep();
+
+      /**
+       * @brief Drop the held entry.
+       */
+      void discard() noexcept { m_has_entry = false; }
+
+    private:
+      entry_handler m_handler; //< Receives the complete entries.
+      parsed_entry_ref m_entry; //< The held entry.
+      bool m_has_entry{false}; //< Whether an entry is held.
+      std::string m_text; //< Storage for the held entry's text.
+      std::string m_joined; //< Storage for an entry completed by a separate argument.
+      std::string m_token; //< Storage for the latest argument from a response file.
+    };
+
+    /**
+     * @brief Parse one argument, recording any error in `m_status`.
+     * @param argument The argument.
+     * @return True on success.
+     */
+    bool step(string_ref argument);
+
+    /**
+     * @brief Finish the command line, recording any error in
+     *        `m_status`.
+     * @return True on success.
+     */
+    bool step_finish();
+
+    const compiled_parser* m_parser; //< Parser providing the options.
+    bool m_ignore_first; //< Whether to skip the first argument.
+    bool m_skip_next; //< Whether to skip the next argument.
+    bool m_failed{false}; //< Whether an error occurred since the last reset.
+    parse_status m_status; //< Most recent error.
+    compiled_parser::parse_state m_state; //< Engine state kept between arguments.
+    entry_buffer m_buffer; //< Holds back incomplete entries.
+  };
+
+} // End namespace
+
+#endif
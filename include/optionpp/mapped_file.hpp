@@ -0,0 +1,160 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `mapped_file` class.
+ */
+
+#ifndef OPTIONPP_MAPPED_FILE_HPP
+#define OPTIONPP_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <optionpp/string_ref.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Read-only view of the contents of a file.
+   *
+   * Where the platform supports it (POSIX or Windows), a regular file
+   * is memory-mapped, so that its pages are only read from disk as
+   * they are accessed and can be dropped again by the system once
+   * they have been scanned. Files that cannot be mapped, such as
+   * pipes, are read into memory instead. Directories and devices
+   * cannot be opened.
+   *
+   * A `mapped_file` also identifies the file it views, so that a
+   * caller opening files recursively can tell whether a file is
+   * already open under another name.
+   */
+  class mapped_file {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Identifies a file independently of the path used to
+     *        open it.
+     */
+    struct id_type {
+      unsigned long long device{0}; //< Device or volume holding the file.
+      unsigned long long file{0}; //< File number within the device.
+
+      /**
+       * @brief Compare two file identifiers.
+       * @param other The identifier to compare with.
+       * @return True if both identify the same file.
+       */
+      bool operator==(const id_type& other) const noexcept {
+        return device == other.device && file == other.file;
+      }
+
+      /**
+       * @brief Compare two file identifiers.
+       * @param other The identifier to compare with.
+       * @return True if the identifiers refer to different files.
+       */
+      bool operator!=(const id_type& other) const noexcept {
+        return !(*this == other);
+      }
+    };
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an object that does not view any file.
+     */
+    mapped_file() noexcept {}
+
+    /**
+     * @brief Open a file.
+     *
+     * Use `is_open` to find out whether the file could be read.
+     *
+     * @param path Path of the file to open.
+     */
+    explicit mapped_file(const std::string& path) { open(path); }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    /**
+     * @brief Destructor. Unmaps the file.
+     */
+    ~mapped_file() { close(); }
+
+    /**
+     * @brief Open a file, closing any file that was already open.
+     * @param path Path of the file to open.
+     * @return True if the file could be read; false if it does not
+     *         exist, is a directory or device, or a read failed.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Close the file.
+     *
+     * Any `string_ref` returned by `contents` becomes invalid.
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Check whether a file is open.
+     * @return True if a file was opened successfully.
+     */
+    bool is_open() const noexcept { return m_open; }
+
+    /**
+     * @brief Get the contents of the file.
+     * @return Reference to the contents, valid until the file is
+     *         closed.
+     */
+    string_ref contents() const noexcept { return string_ref{m_data, m_size}; }
+
+    /**
+     * @brief Get the identity of the file.
+     * @return The file's identifier.
+     */
+    const id_type& id() const noexcept { return m_id; }
+
+  private:
+
+    /**
+     * @brief Read the whole file into `m_buffer`.
+     * @param path Path of the file to read.
+     * @return True if the file could be read.
+     */
+    bool read(const std::string& path);
+
+    const char* m_data{nullptr}; //< Start of the contents.
+    size_type m_size{0}; //< Size of the contents in bytes.
+    id_type m_id; //< Identity of the open file.
+    bool m_open{false}; //< Whether a file is open.
+    bool m_mapped{false}; //< Whether `m_data` points to a mapping.
+    std::string m_buffer; //< Contents of a file that was read instead of mapped.
+  };
+
+} // End namespace
+
+#endif
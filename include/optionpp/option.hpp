@@ -19,16 +19,152 @@
 
 /**
  * @file
- * @brief Header file for `option` class.
+ * @brief Header file for `option` and `change_tracker` classes.
  */
 
 #ifndef OPTIONPP_OPTION_HPP
 #define OPTIONPP_OPTION_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
+#include <optionpp/converter.hpp>
+#include <optionpp/parse_status.hpp>
+#include <optionpp/parse_target.hpp>
+#include <optionpp/string_ref.hpp>
+#include <optionpp/text_pool.hpp>
 
 namespace optionpp {
 
+  class option;
+
+  /**
+   * @brief Reports changes to the options held by a `parser`.
+   *
+   * Each `option` and `option_group` stored in a `parser` has a
+   * tracker that points to the parser's change log, so that
+   * modifying the object through a reference marks the parser's
+   * lookup tables and help text as out of date.
+   *
+   * Renamed options are listed in the log, so that the parser can
+   * update its name index for them instead of rebuilding it. Changes
+   * that move options, or rename them in ways the tracker cannot
+   * list, mark the whole index as out of date.
+   *
+   * The log also holds the pool in which the parser keeps the
+   * strings of its options, so that a tracked option can store new
+   * strings there.
+   *
+   * The pointer belongs to the object's place in the parser rather
+   * than to its value: copies and moves start out detached, and
+   * assigning a new value to a tracked object counts as a change.
+   */
+  class change_tracker {
+  public:
+    /**
+     * @brief Changes reported to a `parser` by the trackers attached
+     *        to it.
+     */
+    struct change_log {
+      std::atomic<unsigned long> changes{1}; //< Incremented on every change.
+      std::vector<const option*> renamed; //< Options renamed or added since `renamed` was last cleared.
+      std::size_t rename_limit{64}; //< Length of `renamed` at which the whole index is marked out of date instead.
+      bool moved{true}; //< Whether options moved, or were renamed without being listed in `renamed`.
+      std::shared_ptr<text_pool> text; //< Pool holding the strings of the parser's options, or null until it is needed.
+
+      /**
+       * @brief Return the pool for option strings, creating it if
+       *        necessary.
+       * @return The pool.
+       */
+      const std::shared_ptr<text_pool>& pool() {
+        if (!text)
+          text = std::make_shared<text_pool>();
+        return text;
+      }
+    };
+
+    /**
+     * @brief Default constructor. The tracker starts out detached.
+     */
+    change_tracker() noexcept {}
+    /**
+     * @brief Copy constructor. The new tracker starts out detached.
+     */
+    change_tracker(const change_tracker&) noexcept {}
+    /**
+     * @brief Copy assignment. Keeps the current log, and reports a
+     *        change to it that may have renamed the object.
+     * @return Reference to the current instance.
+     */
+    change_tracker& operator=(const change_tracker&) noexcept {
+      notify_moved();
+      return *this;
+    }
+
+    /**
+     * @brief Set the log that receives changes.
+     * @param log The log, or `nullptr` to detach.
+     */
+    void attach(change_log* log) noexcept { m_log = log; }
+    /**
+     * @brief Get the log that receives changes.
+     * @return The log, or `nullptr` if detached.
+     */
+    change_log* log() const noexcept { return m_log; }
+
+    /**
+     * @brief Report a change that leaves every name in place, if
+     *        attached.
+     */
+    void notify() const noexcept {
+      if (m_log)
+        m_log->changes.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Report that an option was renamed or added, if
+     *        attached.
+     * @param opt The option, which must stay at the same address
+     *            until the log is next read, unless `notify_moved` is
+     *            called first.
+     */
+    void notify_renamed(const option& opt) const noexcept {
+      if (!m_log)
+        return;
+      notify();
+      if (m_log->moved)
+        return;
+      if (m_log->renamed.size() >= m_log->rename_limit) {
+        m_log->moved = true;
+        return;
+      }
+      try {
+        m_log->renamed.push_back(&opt);
+      } catch (...) {
+        m_log->moved = true;
+      }
+    }
+
+    /**
+     * @brief Report that options were moved, or renamed without
+     *        being listed, if attached.
+     */
+    void notify_moved() const noexcept {
+      if (m_log) {
+        notify();
+        m_log->moved = true;
+      }
+    }
+
+  private:
+    change_log* m_log{nullptr}; //< Log that receives changes, if any.
+  };
+
   /**
    * @brief Describes a valid program command-line option.
    *
@@ -55,6 +191,16 @@ namespace optionpp {
    * A description and a group name can be set as well. These are used
    * in generating the program help text.
    *
+   * The long name, description and argument name are not stored in
+   * the `option` itself but in a `text_pool`, to which the option
+   * holds a shared pointer and three fixed-size offset records. All
+   * options held by a `parser` share the parser's pool, so adding an
+   * option does not allocate memory for its strings one at a time.
+   * An option outside a parser has a small pool of its own, shared
+   * with its copies until one of them is changed. The accessors
+   * return a `string_ref` into the pool, which stays valid until the
+   * option is changed or destroyed.
+   *
    * Note that many of the methods in the class return a reference to
    * the current instance. This allows for convenient chaining. For
    * example, to create an option with a long name of `help`, a short
@@ -73,7 +219,8 @@ namespace optionpp {
     enum arg_type { string_arg, //< Indicates a string argument.
                     int_arg, //< Indicates an integer argument.
                     uint_arg, //< Indicates an unsigned int argument.
-                    double_arg //< Indicates a floating-point argument.
+                    double_arg, //< Indicates a floating-point argument.
+                    custom_arg //< Indicates an argument of some other type, bound with `bind`.
     };
 
     /**
@@ -102,10 +249,10 @@ namespace optionpp {
      *                 uppercase).
      * @param arg_required Set to true if argument is mandatory.
      */
-    option(const std::string& long_name,
+    option(string_ref long_name,
            char short_name = '\0',
-           const std::string& description = "",
-           const std::string& arg_name = "",
+           string_ref description = string_ref{},
+           string_ref arg_name = string_ref{},
            bool arg_required = false);
 
     /**
@@ -114,9 +261,10 @@ namespace optionpp {
      * @param short_name Single-character short option name.
      * @return Reference to the current instance (for chaining calls).
      */
-    option& name(const std::string& long_name, char short_name = '\0') {
-      m_long_name = long_name;
+    option& name(string_ref long_name, char short_name = '\0') {
+      set_text(m_long_name, long_name);
       m_short_name = short_name;
+      m_tracker.notify_renamed(*this);
       return *this;
     }
 
@@ -128,9 +276,9 @@ namespace optionpp {
      *
      * @return Option name.
      */
-    std::string name() const noexcept {
-      if (!m_long_name.empty())
-        return m_long_name;
+    std::string name() const {
+      if (m_long_name.size != 0)
+        return long_name().str();
       else if (m_short_name != '\0')
         return std::string{m_short_name};
       else
@@ -142,15 +290,16 @@ namespace optionpp {
      * @param name The long name to use.
      * @return Reference to the current instance (for chaining calls).
      */
-    option& long_name(const std::string& name) {
-      m_long_name = name;
+    option& long_name(string_ref name) {
+      set_text(m_long_name, name);
+      m_tracker.notify_renamed(*this);
       return *this;
     }
     /**
      * @brief Retrieve the option's long name.
      * @return The long name for the option.
      */
-    const std::string& long_name() const noexcept { return m_long_name; }
+    string_ref long_name() const noexcept { return text(m_long_name); }
 
     /**
      * @brief Set the option's short name.
@@ -159,6 +308,7 @@ namespace optionpp {
      */
     option& short_name(char name) noexcept {
       m_short_name = name;
+      m_tracker.notify_renamed(*this);
       return *this;
     }
     /**
@@ -177,7 +327,7 @@ namespace optionpp {
      *                 is optional.
      * @return Reference to the current instance (for chaining calls).
      */
-    option& argument(const std::string& name,
+    option& argument(string_ref name,
                      bool required = true);
     /**
      * @brief Retrieve the option's argument name.
@@ -186,7 +336,7 @@ namespace optionpp {
      *
      * @return The name of the argument.
      */
-    const std::string& argument_name() const noexcept { return m_arg_name; }
+    string_ref argument_name() const noexcept { return text(m_arg_name); }
     /**
      * @brief Return true if the argument is mandatory.
      * @return True if the argument is required and false if it is optional.
@@ -215,7 +365,7 @@ namespace optionpp {
      * @param var Address of string to receive argument value.
      * @return Reference to the current instance (for chaining calls).
      */
-    option& bind_string(std::string* var) noexcept;
+    option& bind_string(std::string* var);
     /**
      * @brief Designates that the option should take an integer
      *        argument which should be stored in `*var`.
@@ -226,7 +376,7 @@ namespace optionpp {
      * @param var Address of integer to receive argument value.
      * @return Reference to the current instance (for chaining calls).
      */
-    option& bind_int(int* var) noexcept;
+    option& bind_int(int* var);
     /**
      * @brief Designates that the option should take an unsigned
      *        integer argument which should be stored in `*var`.
@@ -238,7 +388,7 @@ namespace optionpp {
      * @param var Address of unsigned int to receive argument value.
      * @return Reference to the current instance (for chaining calls).
      */
-    option& bind_uint(unsigned int* var) noexcept;
+    option& bind_uint(unsigned int* var);
     /**
      * @brief Designates that the option should take a
      * double-precision floating point argument which should be stored
@@ -250,17 +400,125 @@ namespace optionpp {
      * @param var Address of double to receive argument value.
      * @return Reference to the current instance (for chaining calls).
      */
-    option& bind_double(double* var) noexcept;
+    option& bind_double(double* var);
+    /**
+     * @brief Designates that the option should take an argument of
+     *        type `T` which should be stored in `*var`.
+     *
+     * The argument is converted by `converter<T>`, which supports
+     * strings, all integer and floating-point types (except `bool`),
+     * `std::chrono` durations, `byte_size` and enumerations, and can
+     * be specialized for other types. The conversion is chosen at
+     * compile time and stored in the option as a single function
+     * pointer, so that every bound type is handled the same way
+     * during parsing.
+     *
+     * If the argument cannot be converted, then the `parser` will
+     * throw a `parse_error` exception. If the option has no argument
+     * name yet, a default one is set and the argument is made
+     * mandatory.
+     *
+     * The `bind_string`, `bind_int`, `bind_uint` and `bind_double`
+     * methods are equivalent to `bind` with the corresponding type.
+     *
+     * @tparam T Type of the variable (typically deduced).
+     * @param var Address of the variable to receive the argument
+     *            value.
+     * @return Reference to the current instance (for chaining calls).
+     */
+    template <typename T>
+    option& bind(T* var);
+    /**
+     * @brief Designates that the option's argument should be stored
+     *        in a member of the object given by a `parse_target`.
+     *
+     * Works like `bind(T*)`, except that the variable is chosen for
+     * each parse: the argument is written to `target_object.*member`,
+     * where `target_object` is the object of class `C` passed to
+     * `parser::parse_into` in a `parse_target`. When parsing without
+     * a target, the argument is converted and checked, but not
+     * stored. This replaces any variable bound with `bind(T*)`.
+     *
+     * @tparam C Class containing the member (typically deduced).
+     * @tparam T Type of the member (typically deduced).
+     * @param member Pointer to the member to receive the argument
+     *               value.
+     * @return Reference to the current instance (for chaining calls).
+     * @see parse_target
+     */
+    template <typename C, typename T>
+    option& bind(T C::* member);
+    /**
+     * @brief Designates a member of the object given by a
+     *        `parse_target` to store whether the option was set.
+     *
+     * If the option is encountered on the command line, the member is
+     * set to true; it is otherwise left unchanged, so it should be
+     * initialized to false. This replaces any variable bound with
+     * `bind_bool(bool*)`.
+     *
+     * @tparam C Class containing the member (typically deduced).
+     * @param member Pointer to the member to set.
+     * @return Reference to the current instance (for chaining calls).
+     * @see parse_target
+     */
+    template <typename C>
+    option& bind_bool(bool C::* member) noexcept;
     /**
      * @brief Returns true if a variable has been bound to the
      *        option's argument.
      *
      * Note that binding a boolean value to the option does not affect
-     * the return value of this method.
+     * the return value of this method. Members bound with
+     * `bind(T C::*)` count as bound variables.
      *
      * @return True if a variable is bound, false otherwise.
      */
-    bool has_bound_argument_variable() const noexcept { return m_bound_variable; }
+    bool has_bound_argument_variable() const noexcept {
+      return m_bound_variable || m_target_type;
+    }
+    /**
+     * @brief Convert an argument and write it to the bound variable.
+     *
+     * Nothing is written if the argument cannot be converted. If no
+     * variable is bound, the argument is accepted without being
+     * checked. A member bound with `bind(T C::*)` is only checked;
+     * use the overload taking a `parse_target` to write it.
+     *
+     * @param argument The option argument.
+     * @param store If false, the argument is only checked, and the
+     *              bound variable is left unchanged.
+     * @return `parse_errc::none`, or the reason the argument could not
+     *         be converted.
+     */
+    parse_errc write_argument(string_ref argument, bool store = true) const {
+      if (!has_bound_argument_variable())
+        return parse_errc::none;
+      return m_writer(argument, m_bound_variable, &m_member,
+                      store && m_bound_variable);
+    }
+    /**
+     * @brief Convert an argument and write it to the bound member of
+     *        a target object.
+     *
+     * Only members bound with `bind(T C::*)` are written; a variable
+     * bound with `bind(T*)` is left unchanged, so that parsing into a
+     * target never touches shared variables. The argument is still
+     * checked in either case.
+     *
+     * @param argument The option argument.
+     * @param target The object to write to.
+     * @param store If false, the argument is only checked.
+     * @return `parse_errc::none`, or the reason the argument could not
+     *         be converted.
+     */
+    parse_errc write_argument(string_ref argument, const parse_target& target,
+                              bool store = true) const {
+      if (!has_bound_argument_variable())
+        return parse_errc::none;
+      void* object = m_target_type ? target.object(m_target_type) : nullptr;
+      return m_writer(argument, object, &m_member, store && object);
+    }
     /**
      * @brief Writes to the bound boolean variable that was specified
      * in `bind_bool`.
@@ -271,6 +529,23 @@ namespace optionpp {
      * @param value Value to write to the bound bool variable.
      */
     void write_bool(bool value) const noexcept;
+    /**
+     * @brief Writes to the boolean member of a target object that was
+     *        specified in `bind_bool(bool C::*)`.
+     *
+     * A variable bound with `bind_bool(bool*)` is left unchanged.
+     * Nothing is written if no member is bound or if `target` does
+     * not hold an object of the member's class.
+     *
+     * @param value Value to write to the bound bool member.
+     * @param target The object to write to.
+     */
+    void write_bool(bool value, const parse_target& target) const noexcept {
+      void* object = m_flag_target_type ? target.object(m_flag_target_type)
+                                        : nullptr;
+      if (object)
+        m_flag_writer(object, &m_flag_member, value);
+    }
     /**
      * @brief Writes to the bound string variable that was specified
      * in `bind_string`.
@@ -328,28 +603,220 @@ namespace optionpp {
      * @param desc Description of the option.
      * @return Reference to the current instance (for chaining calls).
      */
-    option& description(const std::string& desc) {
-      m_desc = desc;
+    option& description(string_ref desc) {
+      set_text(m_desc, desc);
+      m_tracker.notify();
       return *this;
     }
     /**
      * @brief Retrieve the option description.
      * @return Option description, used in generating program help text.
      */
-    const std::string& description() const noexcept { return m_desc; }
+    string_ref description() const noexcept { return text(m_desc); }
 
   private:
-    std::string m_long_name; //< The long name.
-    char m_short_name{'\0'}; //< The short name.
-    std::string m_desc; //< Description of option (for help text).
+    /**
+     * @brief Get one of the option's strings.
+     * @param s Location of the string in `m_text`.
+     * @return The string.
+     */
+    string_ref text(text_pool::span s) const noexcept {
+      return s.size != 0 ? m_text->get(s) : string_ref{};
+    }
+
+    /**
+     * @brief Replace one of the option's strings.
+     *
+     * The string is stored in the pool of the parser holding the
+     * option, if any, or else in the option's own pool. A pool shared
+     * with other options outside a parser is left unchanged: the
+     * option's strings are first copied into a new pool.
+     *
+     * @param field The member to set.
+     * @param value The new string.
+     */
+    void set_text(text_pool::span& field, string_ref value);
+
+    /**
+     * @brief Copy the option's strings into another pool.
+     * @param pool The pool to use from now on.
+     */
+    void move_text(const std::shared_ptr<text_pool>& pool);
+
+    /**
+     * @brief Type of function that converts an argument and writes it
+     *        to a bound variable.
+     */
+    using argument_writer = parse_errc (*)(string_ref argument, void* var,
+                                           const void* member, bool store);
+    /**
+     * @brief Type of function that writes to a bound boolean member.
+     */
+    using flag_writer = void (*)(void* object, const void* member, bool value);
+
+    /**
+     * @brief Storage large enough for a pointer to a data member of
+     *        any class.
+     */
+    using member_storage = std::aligned_storage<2 * sizeof(std::ptrdiff_t),
+                                                alignof(std::ptrdiff_t)>::type;
+
+    /**
+     * @brief Convert an argument with `converter<T>` and write it to
+     *        a variable of type `T`.
+     * @tparam T Type of the variable.
+     * @param argument The option argument.
+     * @param var Address of the variable.
+     * @param member Unused.
+     * @param store If false, the argument is only checked.
+     * @return `parse_errc::none`, or the reason the argument could not
+     *         be converted.
+     */
+    template <typename T>
+    static parse_errc write_converted(string_ref argument, void* var,
+                                      const void* member, bool store) {
+      (void) member;
+      if (store)
+        return converter<T>::convert(argument, *static_cast<T*>(var));
+      T value{};
+      return converter<T>::convert(argument, value);
+    }
+
+    /**
+     * @brief Convert an argument with `converter<T>` and write it to
+     *        a member of type `T` of an object of class `C`.
+     * @tparam C Class of the object.
+     * @tparam T Type of the member.
+     * @param argument The option argument.
+     * @param object Address of the object.
+     * @param member Address of the stored `T C::*`.
+     * @param store If false, the argument is only checked.
+     * @return `parse_errc::none`, or the reason the argument could not
+     *         be converted.
+     */
+    template <typename C, typename T>
+    static parse_errc write_member(string_ref argument, void* object,
+                                   const void* member, bool store) {
+      if (store)
+        return converter<T>::convert(argument,
+                                     static_cast<C*>(object)->*load<T C::*>(member));
+      T value{};
+      return converter<T>::convert(argument, value);
+    }
+
+    /**
+     * @brief Write to a boolean member of an object of class `C`.
+     * @tparam C Class of the object.
+     * @param object Address of the object.
+     * @param member Address of the stored `bool C::*`.
+     * @param value Value to write.
+     */
+    template <typename C>
+    static void write_flag(void* object, const void* member, bool value) {
+      static_cast<C*>(object)->*load<bool C::*>(member) = value;
+    }
+
+    /**
+     * @brief Store a member pointer in a `member_storage`.
+     * @tparam M Type of the member pointer.
+     * @param storage Storage to write to.
+     * @param member The member pointer.
+     */
+    template <typename M>
+    static void store(member_storage& storage, M member) noexcept {
+      static_assert(sizeof(M) <= sizeof(member_storage),
+                    "member pointer too large to bind");
+      std::memcpy(&storage, &member, sizeof(M));
+    }
 
-    std::string m_arg_name; //< The name of the argument (for help text).
+    /**
+     * @brief Load a member pointer stored with `store`.
+     * @tparam M Type of the member pointer.
+     * @param storage Address of the storage.
+     * @return The member pointer.
+     */
+    template <typename M>
+    static M load(const void* storage) noexcept {
+      M member;
+      std::memcpy(&member, storage, sizeof(M));
+      return member;
+    }
+
+    /**
+     * @brief Get the `arg_type` that describes a type.
+     * @return `custom_arg`, or the matching type for the types that
+     *         have their own `bind_` method.
+     */
+    template <typename T>
+    static constexpr arg_type type_of(const T*) noexcept { return custom_arg; }
+    static constexpr arg_type type_of(const std::string*) noexcept { return string_arg; }
+    static constexpr arg_type type_of(const int*) noexcept { return int_arg; }
+    static constexpr arg_type type_of(const unsigned*) noexcept { return uint_arg; }
+    static constexpr arg_type type_of(const double*) noexcept { return double_arg; }
+
+    std::shared_ptr<text_pool> m_text; //< Pool holding the strings, or null if they are all empty.
+    text_pool::span m_long_name{0, 0}; //< The long name.
+    text_pool::span m_desc{0, 0}; //< Description of option (for help text).
+    text_pool::span m_arg_name{0, 0}; //< The name of the argument (for help text).
+    char m_short_name{'\0'}; //< The short name.
     bool m_arg_required{false}; //< True if argument is mandatory, false if optional.
     arg_type m_arg_type{string_arg}; //< Type of argument that is expected.
     bool* m_is_option_set = nullptr; //< Pointer to value to hold whether the option was set.
     void* m_bound_variable = nullptr; //< Pointer to hold argument value.
+    const void* m_target_type = nullptr; //< Class of the `parse_target` holding the bound member, if any.
+    member_storage m_member{}; //< Bound member pointer, if any.
+    argument_writer m_writer = nullptr; //< Converts arguments for the bound variable or member.
+    const void* m_flag_target_type = nullptr; //< Class of the `parse_target` holding the bound bool member, if any.
+    member_storage m_flag_member{}; //< Bound bool member pointer, if any.
+    flag_writer m_flag_writer = nullptr; //< Writes to the bound bool member.
+
+    change_tracker m_tracker; //< Reports changes to the parser holding this option, if any.
+
+    friend class option_group;
+    friend class parser;
   };
 
 } // End namespace
 
+/* Implementation */
+
+template <typename T>
+optionpp::option& optionpp::option::bind(T* var) {
+  if (var && m_arg_name.size == 0) {
+    set_text(m_arg_name, converter<T>::argument_name());
+    m_arg_required = true;
+  }
+  m_arg_type = type_of(var);
+  m_bound_variable = var;
+  m_target_type = nullptr;
+  m_writer = &write_converted<T>;
+  m_tracker.notify();
+  return *this;
+}
+
+template <typename C, typename T>
+optionpp::option& optionpp::option::bind(T C::* member) {
+  if (member && m_arg_name.size == 0) {
+    set_text(m_arg_name, converter<T>::argument_name());
+    m_arg_required = true;
+  }
+  m_arg_type = type_of(static_cast<T*>(nullptr));
+  m_bound_variable = nullptr;
+  m_target_type = member ? parse_target::type_id<C>() : nullptr;
+  store(m_member, member);
+  m_writer = &write_member<C, T>;
+  m_tracker.notify();
+  return *this;
+}
+
+template <typename C>
+optionpp::option& optionpp::option::bind_bool(bool C::* member) noexcept {
+  m_is_option_set = nullptr;
+  m_flag_target_type = member ? parse_target::type_id<C>() : nullptr;
+  store(m_flag_member, member);
+  m_flag_writer = &write_flag<C>;
+  m_tracker.notify();
+  return *this;
+}
+
 #endif
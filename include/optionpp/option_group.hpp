@@ -119,7 +119,17 @@ namespace optionpp {
      * @return Reference to the inserted `option`, for chaining.
      */
     option& add_option(const option& opt = option{}) {
-      m_options.push_back(opt);
+      return add_option(option{opt});
+    }
+    /**
+     * @brief Move a program option into the group.
+     * @param opt The `option` to add.
+     * @return Reference to the inserted `option`, for chaining.
+     */
+    option& add_option(option&& opt) {
+      const option* old_data = m_options.data();
+      m_options.push_back(std::move(opt));
+      track_new_options(old_data, m_options.size() - 1);
       return m_options.back();
     }
     /**
@@ -137,6 +147,27 @@ namespace optionpp {
                        const std::string& description = "",
                        const std::string& arg_name = "",
                        bool arg_required = false);
+    /**
+     * @brief Add a sequence of program options to the group.
+     *
+     * With forward iterators, room for all the options is reserved
+     * once. Pass `std::move_iterator`s to move the options instead of
+     * copying them. Unlike `operator[]`, this does not look for
+     * existing options with the same names.
+     *
+     * @tparam InputIt The iterator type (usually deduced).
+     * @param first The iterator pointing to the start of the
+     *              sequence.
+     * @param last The iterator pointing to one past the end of the
+     *             sequence.
+     */
+    template <typename InputIt>
+    void add_options(InputIt first, InputIt last) {
+      const option* old_data = m_options.data();
+      size_type old_size = m_options.size();
+      m_options.insert(m_options.end(), first, last);
+      track_new_options(old_data, old_size);
+    }
 
     /**
      * @brief Return the number of options in the group.
@@ -148,6 +179,15 @@ namespace optionpp {
      * @return True if the `option` container is empty, false otherwise.
      */
     bool empty() const noexcept { return m_options.empty(); }
+    /**
+     * @brief Reserve room for a number of options.
+     * @param count Total number of options to reserve room for.
+     */
+    void reserve(size_type count) {
+      const option* old_data = m_options.data();
+      m_options.reserve(count);
+      track_new_options(old_data, m_options.size());
+    }
 
     /**
      * @brief Return an `iterator` to the first option in the group.
@@ -291,8 +331,45 @@ namespace optionpp {
     option& operator[](char short_name);
 
   private:
+
+    /**
+     * @brief Attach the group and its options to a parser's change
+     *        log.
+     * @param log The log, or `nullptr` to detach.
+     */
+    void attach(change_tracker::change_log* log) noexcept;
+
+    /**
+     * @brief Attach options that were just inserted to the group's
+     *        change log, and report the change.
+     *
+     * The new options are reported as renamed. If the insertion moved
+     * the existing options, they are attached again too, and the move
+     * is reported instead. The strings of the new options are then
+     * copied into the parser's pool.
+     *
+     * @param old_data Start of the option storage before the
+     *                 insertion.
+     * @param first Position of the first inserted option.
+     */
+    void track_new_options(const option* old_data, size_type first) noexcept;
+
+    /**
+     * @brief Copy the strings of the group's options into the pool of
+     *        the parser holding the group, if attached.
+     *
+     * If memory runs out, the remaining options keep their strings
+     * where they are.
+     *
+     * @param first Position of the first option to move.
+     */
+    void adopt_text(size_type first) noexcept;
+
     std::string m_name; //< Group name.
     container_type m_options; //< Collection of program options.
+    change_tracker m_tracker; //< Reports changes to the parser holding this group, if any.
+
+    friend class parser;
   };
 
 } // End namespace
@@ -0,0 +1,286 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `option_index` class.
+ */
+
+#ifndef OPTIONPP_OPTION_INDEX_HPP
+#define OPTIONPP_OPTION_INDEX_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <optionpp/option.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Lookup table for finding options by name.
+   *
+   * An `option_index` maps long names to options through a hash
+   * table and short names to options through a direct table with one
+   * entry for each possible character, so that lookups take constant
+   * time regardless of how many options are indexed.
+   *
+   * The index does not own the options: it only stores pointers to
+   * them. It must be rebuilt whenever the indexed options are moved
+   * or renamed.
+   *
+   * The names are not copied: each hash table entry is a small
+   * record holding the hash of a long name and its position in the
+   * list of indexed options, and lookups compare the name held by
+   * the option itself. Since the hashes are compared first, a lookup
+   * usually reads the name of the matching option only. An option
+   * renamed after it was indexed is no longer found under its old
+   * name.
+   *
+   * If several options share the same name, the one that was
+   * inserted first is found.
+   *
+   * Once all options have been inserted, `optimize` can be called to
+   * arrange the hash table so that every long name is found on the
+   * first probe, and `sort_names` can be called to allow long names
+   * to be looked up by prefix.
+   */
+  class option_index {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Iterator over the options found by `find_prefix`.
+     */
+    using name_iterator = std::vector<const option*>::const_iterator;
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an empty index.
+     */
+    option_index() noexcept { m_short_names.fill(nullptr); }
+
+    /**
+     * @brief Remove all options from the index.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Reserve room for a number of options.
+     *
+     * Inserting up to `count` options with long names will not cause
+     * the hash table to be rebuilt.
+     *
+     * @param count Number of options to reserve room for.
+     */
+    void reserve(size_type count);
+
+    /**
+     * @brief Add an option to the index.
+     *
+     * The option is indexed by its long name and by its short name,
+     * if it has them. A name that is already in the index is left
+     * pointing to the option that was inserted earlier.
+     *
+     * @param opt The `option` to index. The `option` must outlive the
+     *            index, or the index must be cleared first.
+     */
+    void insert(const option& opt);
+
+    /**
+     * @brief Arrange the long name table for single-probe lookups.
+     *
+     * Uses the hash-and-displace method to build a perfect hash for
+     * the long names currently in the index: each name is assigned a
+     * bucket, and each bucket a displacement that places all of its
+     * names in distinct free slots. A lookup then examines exactly
+     * one slot.
+     *
+     * If no perfect hash can be found (which can only happen if two
+     * names have the same hash value), the table is left as it was.
+     * A later call to `insert` switches back to an ordinary hash
+     * table.
+     *
+     * @return True if the table was rearranged.
+     */
+    bool optimize();
+
+    /**
+     * @brief Return whether the index currently uses a perfect hash.
+     * @return True if `optimize` succeeded and no option has been
+     *         inserted since.
+     */
+    bool is_optimized() const noexcept { return !m_displacements.empty(); }
+
+    /**
+     * @brief Return the number of long names in the index.
+     * @return Number of distinct long names.
+     */
+    size_type size() const noexcept { return m_options.size(); }
+    /**
+     * @brief Return whether the index is empty.
+     * @return True if no long or short names are indexed.
+     */
+    bool empty() const noexcept { return m_options.empty() && m_short_count == 0; }
+
+    /**
+     * @brief Look up an option by long name.
+     * @param long_name Long name for the option.
+     * @return Pointer to the option, or `nullptr` if not found.
+     */
+    const option* find(const std::string& long_name) const noexcept {
+      return find(long_name.data(), long_name.size());
+    }
+    /**
+     * @brief Look up an option by long name.
+     * @param long_name Pointer to the first character of the long
+     *                  name (need not be null-terminated).
+     * @param length Number of characters in the long name.
+     * @return Pointer to the option, or `nullptr` if not found.
+     */
+    const option* find(const char* long_name, size_type length) const noexcept;
+    /**
+     * @brief Return whether a long name may belong to an option that
+     *        was renamed after it was indexed.
+     *
+     * An option renamed after it was indexed is no longer found under
+     * its old name, but it still hides any other option with that
+     * name that was inserted after it. This returns true if such an
+     * option is in the way of `long_name`, in which case the index
+     * should be rebuilt. It may also return true, rarely, for
+     * different names with the same hash.
+     *
+     * @param long_name Long name that `find` did not find.
+     * @return True if `long_name` may be hidden.
+     */
+    bool has_renamed(const std::string& long_name) const noexcept;
+    /**
+     * @brief Look up an option by short name.
+     * @param short_name Short name for the option.
+     * @return Pointer to the option, or `nullptr` if not found.
+     */
+    const option* find(char short_name) const noexcept {
+      return m_short_names[static_cast<unsigned char>(short_name)];
+    }
+
+    /**
+     * @brief Sort the long names so that they can be looked up by
+     *        prefix.
+     *
+     * Names inserted after the most recent call are not found by
+     * `find_prefix`.
+     */
+    void sort_names();
+
+    /**
+     * @brief Look up the options whose long names start with a
+     *        prefix.
+     *
+     * The long names are kept in a sorted array, so the matching
+     * names are adjacent and are found by binary search in
+     * O(`length` log n) time, without examining the other names.
+     * Only names present at the last call to `sort_names` are
+     * considered.
+     *
+     * @param prefix Pointer to the first character of the prefix
+     *               (need not be null-terminated).
+     * @param length Number of characters in the prefix.
+     * @return Range of the matching options, in order of long name.
+     */
+    std::pair<name_iterator, name_iterator>
+    find_prefix(const char* prefix, size_type length) const;
+
+    /**
+     * @brief Compute the hash of a name.
+     * @param str Pointer to the first character of the name.
+     * @param length Number of characters in the name.
+     * @return Hash value.
+     */
+    static std::size_t hash(const char* str, size_type length) noexcept;
+
+  private:
+
+    /**
+     * @brief Position in `m_options` marking a free slot.
+     */
+    static const std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+    /**
+     * @brief Entry in a long name table.
+     */
+    struct slot {
+      std::uint32_t hash; //< Hash of the option's long name.
+      std::uint32_t id; //< Position of the option in `m_options`, or `npos` if the slot is free.
+    };
+
+    /**
+     * @brief Find a long name in the ordinary hash table.
+     * @param name The long name.
+     * @param h Hash of the name.
+     * @return Position of the slot holding the name, or of the free
+     *         slot where it would be inserted.
+     */
+    size_type probe(string_ref name, std::uint32_t h) const noexcept;
+
+    /**
+     * @brief Rebuild the ordinary hash table with room for a number
+     *        of long names.
+     * @param count Number of names.
+     */
+    void rehash(size_type count);
+
+    /**
+     * @brief Return the bucket used by the perfect hash for a name.
+     * @param h Hash of the name.
+     * @return Index into the displacement table.
+     */
+    size_type bucket(std::uint32_t h) const noexcept {
+      return (h ^ (h >> 16)) & (m_displacements.size() - 1);
+    }
+
+    /**
+     * @brief Return the slot used by the perfect hash for a name.
+     * @param h Hash of the name.
+     * @param displacement Displacement of the name's bucket.
+     * @return Index into the slot table.
+     */
+    size_type displaced_slot(std::uint32_t h,
+                             std::uint32_t displacement) const noexcept;
+
+    std::vector<const option*> m_options; //< Option for each distinct long name, in order of insertion.
+    std::vector<std::uint32_t> m_hashes; //< Hash of each long name.
+    std::vector<slot> m_table; //< Ordinary long name table, using linear probing.
+    std::vector<slot> m_slots; //< Perfect long name table (empty unless optimized).
+    std::vector<std::uint32_t> m_displacements; //< Per-bucket displacements (empty unless optimized).
+    std::array<const option*, 256> m_short_names; //< Short name table, indexed by character.
+    size_type m_short_count{0}; //< Number of indexed short names.
+    std::vector<std::uint32_t> m_sorted_ids; //< Long names present at the last `sort_names`, in order.
+    std::vector<const option*> m_names; //< Option for each entry of `m_sorted_ids`.
+  };
+
+} // End namespace
+
+#endif
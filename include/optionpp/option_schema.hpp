@@ -0,0 +1,1087 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `option_spec`, `schema_parser` and
+ *        `option_schema`.
+ */
+
+#ifndef OPTIONPP_OPTION_SCHEMA_HPP
+#define OPTIONPP_OPTION_SCHEMA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <optionpp/converter.hpp>
+#include <optionpp/option_syntax.hpp>
+#include <optionpp/parse_status.hpp>
+#include <optionpp/string_ref.hpp>
+
+/**
+ * @brief Defined to 1 if `option_schema` and `make_schema` are
+ *        available (C++17 or later), and to 0 otherwise.
+ */
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define OPTIONPP_CONSTEXPR_SCHEMA 1
+#include <array>
+#include <iterator>
+#include <stdexcept>
+#else
+#define OPTIONPP_CONSTEXPR_SCHEMA 0
+#endif
+
+namespace optionpp {
+
+  /**
+   * @brief Static description of a program option.
+   *
+   * An `option_spec` holds the same information as an `option` that
+   * is not bound to a variable, but refers to string literals instead
+   * of owning copies, so an array of them can be declared `constexpr`
+   * and costs nothing at startup. Such an array is the input of
+   * `make_schema`.
+   *
+   * Example:
+   * ```
+   * constexpr optionpp::option_spec my_options[] = {
+   *   {"help", '?', "Show this help message."},
+   *   {"jobs", 'j', "Run up to N jobs at once.", "N", true,
+   *    optionpp::option_spec::check<unsigned>()},
+   *   {"verbose", 'v', "Show verbose output."}
+   * };
+   * ```
+   */
+  struct option_spec {
+    /**
+     * @brief Type of function that checks an argument.
+     */
+    using argument_checker = parse_errc (*)(string_ref);
+
+    /**
+     * @brief Constructor.
+     * @param long_name Long name for the option, or an empty string.
+     * @param short_name Short name for the option, or `'\0'`.
+     * @param description Option description (for help message).
+     * @param arg_name Argument name, or an empty string if the
+     *                 option takes no argument.
+     * @param arg_required Set to true if argument is mandatory.
+     * @param checker Function that checks arguments, or `nullptr` to
+     *                accept any string (see `check`).
+     */
+    constexpr option_spec(const char* long_name, char short_name = '\0',
+                          const char* description = "",
+                          const char* arg_name = "",
+                          bool arg_required = false,
+                          argument_checker checker = nullptr) noexcept
+      : long_name{long_name}, short_name{short_name},
+        description{description}, arg_name{arg_name},
+        arg_required{arg_required}, checker{checker} {}
+
+    /**
+     * @brief Get a function that accepts the arguments that
+     *        `converter<T>` can convert.
+     *
+     * The arguments are checked as for an `option` bound with
+     * `option::bind<T>`, with the same errors.
+     *
+     * @tparam T Type of the argument.
+     * @return Pointer to the checking function.
+     */
+    template <typename T>
+    static constexpr argument_checker check() noexcept { return &check_converted<T>; }
+
+    const char* long_name; //< Long name, or an empty string.
+    char short_name; //< Short name, or `'\0'`.
+    const char* description; //< Description (for help message).
+    const char* arg_name; //< Argument name, or an empty string if the option takes no argument.
+    bool arg_required; //< True if the argument is mandatory.
+    argument_checker checker; //< Checks arguments, or `nullptr` to accept any string.
+
+  private:
+
+    /**
+     * @brief Check that an argument can be converted to a type.
+     * @tparam T Type of the argument.
+     * @param argument The argument.
+     * @return `parse_errc::none`, or the reason the argument could not
+     *         be converted.
+     */
+    template <typename T>
+    static parse_errc check_converted(string_ref argument) {
+      T value{};
+      return converter<T>::convert(argument, value);
+    }
+  };
+
+  /**
+   * @brief Parses command-line arguments with lookup tables that were
+   *        built at compile time.
+   *
+   * A `schema_parser` is a view of the tables of an `option_schema`:
+   * a perfect hash table of long names, a table of short names and the
+   * formatted help text. It is a small object of pointers that needs
+   * no setup, so parsing with it does not build any `option`,
+   * `std::string` or container first.
+   *
+   * Arguments are classified by the same `option_syntax` as
+   * `compiled_parser` uses, with the default prefixes (`-`, `--` and
+   * `=`), and produce the same entries and errors as a `parser` with
+   * the same options. Each entry is passed to a handler, as by
+   * `compiled_parser::visit`. Abbreviated
+   * long names, response files and bound variables are not supported;
+   * use a `parser` for those.
+   *
+   * All methods are `const` and may be called concurrently.
+   */
+  class schema_parser {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Type of function that receives each option and its
+     *        argument (empty if none was given). Returning false
+     *        stops parsing.
+     */
+    using option_handler = std::function<bool(const option_spec&, string_ref)>;
+
+    /**
+     * @brief Type of function that receives each non-option argument.
+     *        Returning false stops parsing.
+     */
+    using non_option_handler = std::function<bool(string_ref)>;
+
+    /**
+     * @brief Table entry that holds no option.
+     */
+    static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+    /**
+     * @brief Constructor.
+     *
+     * The tables are normally produced by `option_schema`, which
+     * returns a `schema_parser` from `option_schema::parser`.
+     *
+     * @param specs The options.
+     * @param count Number of options.
+     * @param slots Perfect hash table of long names: the position in
+     *              `specs` of the option in each slot, or `npos`.
+     * @param slot_count Number of slots (a power of two).
+     * @param displacements Displacement of each bucket of long names.
+     * @param bucket_count Number of buckets (a power of two).
+     * @param short_names Position in `specs` of the option with each
+     *                    short name, or `npos`; indexed by character.
+     * @param help Formatted help text.
+     * @param help_size Length of the help text.
+     */
+    constexpr schema_parser(const option_spec* specs, size_type count,
+                            const std::uint32_t* slots, size_type slot_count,
+                            const std::uint32_t* displacements,
+                            size_type bucket_count,
+                            const std::uint32_t* short_names,
+                            const char* help, size_type help_size) noexcept
+      : m_specs{specs}, m_count{count}, m_slots{slots},
+        m_slot_count{slot_count}, m_displacements{displacements},
+        m_bucket_count{bucket_count}, m_short_names{short_names},
+        m_help{help}, m_help_size{help_size} {}
+
+    /**
+     * @brief Return the number of options.
+     * @return Number of options.
+     */
+    size_type size() const noexcept { return m_count; }
+
+    /**
+     * @brief Return the position of an option in the schema.
+     * @param spec An option passed to a handler by `visit`.
+     * @return Position of the option in the array given to
+     *         `make_schema`.
+     */
+    size_type index(const option_spec& spec) const noexcept {
+      return static_cast<size_type>(&spec - m_specs);
+    }
+
+    /**
+     * @brief Look up an option by long name.
+     * @param long_name Long name for the option.
+     * @return Pointer to the option, or `nullptr` if not found.
+     */
+    const option_spec* find(string_ref long_name) const noexcept;
+    /**
+     * @brief Look up an option by short name.
+     * @param short_name Short name for the option.
+     * @return Pointer to the option, or `nullptr` if not found.
+     */
+    const option_spec* find(char short_name) const noexcept {
+      std::uint32_t pos = m_short_names[static_cast<unsigned char>(short_name)];
+      return short_name != '\0' && pos != npos ? m_specs + pos : nullptr;
+    }
+
+    /**
+     * @brief Return the help text.
+     *
+     * The text is the same as that written by `parser::print_help`
+     * with the default formatting, for a parser with the same options
+     * in one unnamed group.
+     *
+     * @return The formatted help text.
+     */
+    string_ref help() const noexcept { return string_ref{m_help, m_help_size}; }
+
+    /**
+     * @brief Print program help message.
+     * @param os Output stream.
+     * @return The output stream that was initially given.
+     */
+    std::ostream& print_help(std::ostream& os) const;
+
+    /**
+     * @brief Parse command-line arguments, passing each entry to a
+     *        handler.
+     *
+     * Works like `compiled_parser::visit`: each option is passed to
+     * `on_option` and each non-option argument to `on_non_option`, in
+     * command-line order. An option that may take its argument from
+     * the next command-line argument is passed on once that argument
+     * has been seen. Arguments are checked with the option's
+     * `option_spec::checker`.
+     *
+     * An argument given in the same command-line argument as its
+     * option (`--width=x`, `-wx`) is checked before the option is
+     * passed on, so an invalid one is never passed on. An argument
+     * given separately (`--width x`) is checked after the option and
+     * the argument have been passed on, exactly as by
+     * `compiled_parser::visit`; the handler may then see an invalid
+     * argument just before parsing fails.
+     *
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param on_option Receives each option. May be empty.
+     * @param on_non_option Receives each non-option argument. May be
+     *                      empty.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return True if every argument was parsed and passed on; false
+     *         if there was an error (given by `status`) or a handler
+     *         stopped parsing.
+     */
+    template <typename InputIt>
+    bool visit(InputIt first, InputIt last, const option_handler& on_option,
+               const non_option_handler& on_non_option, parse_status& status,
+               bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments, passing each entry to a
+     *        handler.
+     *
+     * See `visit(InputIt, InputIt, const option_handler&, const
+     * non_option_handler&, parse_status&, bool)`.
+     *
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param on_option Receives each option. May be empty.
+     * @param on_non_option Receives each non-option argument. May be
+     *                      empty.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return True if every argument was parsed and passed on.
+     */
+    bool visit(int argc, char* argv[], const option_handler& on_option,
+               const non_option_handler& on_non_option, parse_status& status,
+               bool ignore_first = true) const {
+      return visit(argv, argv + argc, on_option, on_non_option, status,
+                   ignore_first);
+    }
+
+    /**
+     * @brief Return the bucket of a long name in the perfect hash.
+     * @param h Hash of the name, as computed by `string_pool::hash`.
+     * @param bucket_count Number of buckets (a power of two).
+     * @return Index into the displacement table.
+     */
+    static constexpr size_type bucket(std::uint32_t h, size_type bucket_count) noexcept {
+      return (h ^ (h >> 16)) & (bucket_count - 1);
+    }
+
+    /**
+     * @brief Return the slot of a long name in the perfect hash.
+     * @param h Hash of the name, as computed by `string_pool::hash`.
+     * @param displacement Displacement of the name's bucket.
+     * @param slot_count Number of slots (a power of two).
+     * @return Index into the slot table.
+     */
+    static constexpr size_type displaced_slot(std::uint32_t h,
+                                              std::uint32_t displacement,
+                                              size_type slot_count) noexcept {
+      return finish_mix(mix(h ^ static_cast<std::uint32_t>(displacement * 0x9e3779b9u)))
+        & (slot_count - 1);
+    }
+
+  private:
+
+    /**
+     * @brief State of a call to `visit`.
+     */
+    struct visit_state {
+      /**
+       * @brief Constructor.
+       * @param on_option Receives each option.
+       * @param on_non_option Receives each non-option argument.
+       * @param status Receives the outcome.
+       */
+      visit_state(const option_handler& on_option,
+                  const non_option_handler& on_non_option,
+                  parse_status& status) noexcept
+        : on_option(on_option), on_non_option(on_non_option),
+          status(status) {}
+
+      const option_handler& on_option; //< Receives each option.
+      const non_option_handler& on_non_option; //< Receives each non-option argument.
+      parse_status& status; //< Receives the outcome.
+      size_type index{0}; //< Index of the current argument.
+      const option_spec* pending{nullptr}; //< Option waiting for a separate argument.
+      std::string pending_name; //< Name used for the pending option, with its prefix.
+      size_type pending_index{0}; //< Index of the argument that holds the pending option.
+      size_type pending_offset{0}; //< Offset of the pending option in that argument.
+      bool end_of_options{false}; //< Whether the end-of-options marker was seen.
+      bool stopped{false}; //< Whether a handler stopped parsing.
+    };
+
+    /**
+     * @brief First half of the slot mixing function.
+     * @param x Value to mix.
+     * @return Mixed value.
+     */
+    static constexpr std::uint32_t mix(std::uint32_t x) noexcept {
+      return static_cast<std::uint32_t>((x ^ (x >> 16)) * 0x85ebca6bu);
+    }
+    /**
+     * @brief Second half of the slot mixing function.
+     * @param x Value to mix.
+     * @return Mixed value.
+     */
+    static constexpr std::uint32_t finish_mix(std::uint32_t x) noexcept {
+      return x ^ (x >> 13);
+    }
+
+    /**
+     * @brief Parse one command-line argument.
+     * @param token The argument.
+     * @param state Parsing state.
+     * @return False if there was an error.
+     */
+    bool parse_token(string_ref token, visit_state& state) const;
+
+    /**
+     * @brief Parse an argument that may be an option.
+     * @param token The argument.
+     * @param state Parsing state.
+     * @return False if there was an error.
+     */
+    bool parse_argument(string_ref token, visit_state& state) const;
+
+    /**
+     * @brief Parse a group of short options.
+     * @param token The whole argument.
+     * @param specifier The part of `token` before any `=`.
+     * @param argument The part of `token` after the `=`, if any.
+     * @param has_arg Whether `token` has an `=`.
+     * @param state Parsing state.
+     * @return False if there was an error.
+     */
+    bool parse_short_option_group(string_ref token, string_ref specifier,
+                                  string_ref argument, bool has_arg,
+                                  visit_state& state) const;
+
+    /**
+     * @brief Pass on an option that is still waiting for an argument
+     *        at the end of the arguments.
+     * @param state Parsing state.
+     * @return False if the argument was mandatory.
+     */
+    static bool finish(visit_state& state);
+
+    /**
+     * @brief Check an option argument and pass the option on.
+     * @param spec The option.
+     * @param argument Its argument.
+     * @param offset Offset of the argument in the current
+     *               command-line argument, for errors.
+     * @param prefix Option prefix or specifier, for errors.
+     * @param name Option name, if not included in `prefix`.
+     * @param state Parsing state.
+     * @return False if the argument is invalid.
+     */
+    static bool accept(const option_spec& spec, string_ref argument,
+                       size_type offset, string_ref prefix, string_ref name,
+                       visit_state& state);
+
+    /**
+     * @brief Check an option argument.
+     * @param spec The option.
+     * @param argument Its argument.
+     * @param offset Offset of the argument in the current
+     *               command-line argument, for errors.
+     * @param prefix Option prefix or specifier, for errors.
+     * @param name Option name, if not included in `prefix`.
+     * @param state Parsing state.
+     * @return False if the argument is invalid.
+     */
+    static bool check(const option_spec& spec, string_ref argument,
+                      size_type offset, string_ref prefix, string_ref name,
+                      visit_state& state);
+
+    /**
+     * @brief Pass an option to the handler, unless parsing stopped.
+     * @param spec The option.
+     * @param argument Its argument, or an empty string.
+     * @param state Parsing state.
+     */
+    static void pass_option(const option_spec& spec, string_ref argument,
+                            visit_state& state);
+
+    /**
+     * @brief Pass a non-option argument to the handler, unless parsing
+     *        stopped.
+     * @param argument The argument.
+     * @param state Parsing state.
+     */
+    static void pass_non_option(string_ref argument, visit_state& state);
+
+    /**
+     * @brief Record an error for the current argument.
+     * @param state Parsing state.
+     * @param error Kind of error.
+     * @param offset Byte offset of the error in the argument.
+     * @param prefix Option prefix or specifier.
+     * @param name Option name, if not included in `prefix`.
+     * @return False, so that callers can `return fail(...)`.
+     */
+    static bool fail(visit_state& state, parse_errc error, size_type offset,
+                     string_ref prefix, string_ref name = string_ref{});
+
+    const option_spec* m_specs; //< The options.
+    size_type m_count; //< Number of options.
+    const std::uint32_t* m_slots; //< Perfect hash table of long names.
+    size_type m_slot_count; //< Number of slots.
+    const std::uint32_t* m_displacements; //< Displacement of each bucket.
+    size_type m_bucket_count; //< Number of buckets.
+    const std::uint32_t* m_short_names; //< Option for each short name.
+    const char* m_help; //< Formatted help text.
+    size_type m_help_size; //< Length of the help text.
+  };
+
+#if OPTIONPP_CONSTEXPR_SCHEMA
+
+  /**
+   * @brief Compile-time layout of the tables of an `option_schema`.
+   *
+   * Holds the functions that `make_schema` uses to size and fill the
+   * tables. They are evaluated by the compiler.
+   */
+  struct schema_layout {
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Return the number of slots in the long name table.
+     * @param count Number of options.
+     * @return Smallest power of two of at least 16 that keeps the
+     *         table at most half full.
+     */
+    static constexpr size_type slot_count(size_type count) noexcept {
+      size_type slots = 16;
+      while (slots < 2 * count)
+        slots *= 2;
+      return slots;
+    }
+
+    /**
+     * @brief Return the number of buckets of the perfect hash.
+     * @param count Number of options.
+     * @return Power of two giving about two names per bucket.
+     */
+    static constexpr size_type bucket_count(size_type count) noexcept {
+      size_type buckets = 1;
+      while (2 * buckets < count)
+        buckets *= 2;
+      return buckets;
+    }
+
+    /**
+     * @brief Compute the hash of a name, as `string_pool::hash` does.
+     * @param str The name (null-terminated).
+     * @return Hash value.
+     */
+    static constexpr std::uint32_t hash(const char* str) noexcept {
+      // 32-bit FNV-1a
+      std::uint32_t h = 2166136261u;
+      for (; *str; ++str) {
+        h ^= static_cast<unsigned char>(*str);
+        h *= 16777619u;
+      }
+      return h;
+    }
+
+    /**
+     * @brief Return whether two names are equal.
+     * @param a First name (null-terminated).
+     * @param b Second name (null-terminated).
+     * @return True if the names are equal.
+     */
+    static constexpr bool equal(const char* a, const char* b) noexcept {
+      for (; *a && *a == *b; ++a, ++b) {}
+      return *a == *b;
+    }
+
+    /**
+     * @brief Format the help text for some options.
+     *
+     * Produces the text of `parser::print_help` with the default
+     * formatting for a parser holding the options in one unnamed
+     * group.
+     *
+     * @param specs The options.
+     * @param count Number of options.
+     * @param out Where to write the text, or `nullptr` to only
+     *            measure it.
+     * @return Length of the text.
+     */
+    static constexpr size_type format_help(const option_spec* specs,
+                                           size_type count, char* out) noexcept {
+      writer dest{out};
+      for (size_type i = 0; i < count; ++i) {
+        const option_spec& spec = specs[i];
+        if (i != 0)
+          dest.put('\n');
+
+        text usage;
+        usage.add_spaces(option_indent);
+
+        // Short name
+        if (spec.short_name != '\0') {
+          usage.add("-", 1);
+          usage.add(&spec.short_name, 1);
+          if (*spec.long_name)
+            usage.add(", ", 2);
+        } else {
+          usage.add_spaces(4);
+        }
+
+        // Long name
+        if (*spec.long_name) {
+          usage.add("--", 2);
+          usage.add(spec.long_name);
+        }
+
+        // Argument
+        if (*spec.arg_name) {
+          if (spec.arg_required) {
+            usage.add("=", 1);
+            usage.add(spec.arg_name);
+          } else {
+            usage.add("[=", 2);
+            usage.add(spec.arg_name);
+            usage.add("]", 1);
+          }
+        }
+
+        // Description
+        int spacing = desc_first_line_indent - static_cast<int>(usage.size());
+        if (spacing <= 1) {
+          wrap(usage, dest, line_length, 0, 0);
+          if (*spec.description) {
+            dest.put('\n');
+            text desc;
+            desc.add(spec.description);
+            wrap(desc, dest, line_length, desc_multiline_indent,
+                 desc_first_line_indent);
+          }
+        } else {
+          if (*spec.description) {
+            usage.add_spaces(static_cast<size_type>(spacing));
+            usage.add(spec.description);
+          }
+          wrap(usage, dest, line_length, desc_multiline_indent, 0);
+        }
+      }
+      return dest.size;
+    }
+
+  private:
+
+    static constexpr int line_length = 78; //< Default `max_line_length` of `parser::print_help`.
+    static constexpr int option_indent = 2; //< Default `option_indent`.
+    static constexpr int desc_first_line_indent = 30; //< Default `desc_first_line_indent`.
+    static constexpr int desc_multiline_indent = 32; //< Default `desc_multiline_indent`.
+
+    /**
+     * @brief Text made of a few pieces, without copying them.
+     */
+    struct text {
+      static constexpr size_type max_pieces = 12; //< Most pieces in a line of help.
+
+      /**
+       * @brief Append a string.
+       * @param str The string.
+       * @param length Its length.
+       */
+      constexpr void add(const char* str, size_type length) noexcept {
+        data[count] = str;
+        sizes[count++] = length;
+        total += length;
+      }
+      /**
+       * @brief Append a null-terminated string.
+       * @param str The string.
+       */
+      constexpr void add(const char* str) noexcept {
+        size_type length = 0;
+        while (str[length])
+          ++length;
+        add(str, length);
+      }
+      /**
+       * @brief Append spaces.
+       * @param length Number of spaces.
+       */
+      constexpr void add_spaces(size_type length) noexcept { add(nullptr, length); }
+
+      /**
+       * @brief Return the length of the text.
+       * @return Number of characters.
+       */
+      constexpr size_type size() const noexcept { return total; }
+
+      /**
+       * @brief Get a character.
+       * @param pos Position of the character.
+       * @return The character.
+       */
+      constexpr char operator[](size_type pos) const noexcept {
+        size_type i = 0;
+        while (pos >= sizes[i])
+          pos -= sizes[i++];
+        return data[i] ? data[i][pos] : ' ';
+      }
+
+      const char* data[max_pieces]{}; //< Each piece, or `nullptr` for spaces.
+      size_type sizes[max_pieces]{}; //< Length of each piece.
+      size_type count{0}; //< Number of pieces.
+      size_type total{0}; //< Total length.
+    };
+
+    /**
+     * @brief Destination of the help text.
+     */
+    struct writer {
+      /**
+       * @brief Write a character.
+       * @param c The character.
+       */
+      constexpr void put(char c) noexcept {
+        if (out)
+          out[size] = c;
+        ++size;
+      }
+      /**
+       * @brief Write spaces.
+       * @param count Number of spaces.
+       */
+      constexpr void fill(int count) noexcept {
+        for (; count > 0; --count)
+          put(' ');
+      }
+
+      char* out; //< Where to write, or `nullptr` to only count.
+      size_type size{0}; //< Number of characters written.
+    };
+
+    /**
+     * @brief Return whether a character is whitespace.
+     * @param c The character.
+     * @return True for the characters `std::isspace` accepts in the
+     *         "C" locale.
+     */
+    static constexpr bool is_space(char c) noexcept {
+      return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    /**
+     * @brief Wrap text as `utility::wrap_text` does.
+     * @param str The text.
+     * @param dest Destination.
+     * @param line_len Maximum line length (positive).
+     * @param indent Indentation of lines after the first.
+     * @param first_line_indent Indentation of the first line.
+     */
+    static constexpr void wrap(const text& str, writer& dest, int line_len,
+                               int indent, int first_line_indent) noexcept {
+      if (indent > line_len - 1)
+        indent = line_len - 1;
+      if (first_line_indent > line_len - 1)
+        first_line_indent = line_len - 1;
+
+      bool written = false;
+      size_type line_start = 0;
+      while (line_start <= str.size()) {
+        size_type line_end = line_start;
+        while (line_end < str.size() && str[line_end] != '\n')
+          ++line_end;
+        const size_type base = line_start;
+        const size_type length = line_end - line_start;
+        const int cur_first_indent = line_start == 0 ? first_line_indent : indent;
+        line_start = line_end + 1;
+
+        if (written)
+          dest.put('\n');
+
+        bool line_written = false;
+        size_type pos = 0;
+        while (pos < length) {
+          const int cur_indent = line_written ? indent : cur_first_indent;
+          size_type start = pos;
+          if (line_written) {
+            while (start < length && is_space(str[base + start]))
+              ++start;
+          }
+
+          size_type end = start + static_cast<size_type>(line_len - cur_indent);
+          if (end > length)
+            end = length;
+          if (end < length) {
+            size_type word_start = end;
+            while (word_start > start && !is_space(str[base + word_start]))
+              --word_start;
+            if (word_start > start)
+              end = word_start;
+          }
+
+          pos = end;
+          while (end > start && is_space(str[base + end - 1]))
+            --end;
+
+          if (end > start) {
+            if (line_written)
+              dest.put('\n');
+            dest.fill(cur_indent);
+            for (size_type i = start; i < end; ++i)
+              dest.put(str[base + i]);
+            line_written = true;
+            written = true;
+          }
+        }
+      }
+    }
+  };
+
+  /**
+   * @brief Option table whose lookup tables and help text are built
+   *        at compile time.
+   *
+   * An `option_schema` is made by `make_schema` from a `constexpr`
+   * array of `option_spec`s, and is normally itself declared
+   * `constexpr`. The compiler then generates
+   *
+   * - a perfect hash table of the long names (built with the
+   *   hash-and-displace method of `option_index::optimize`), so a
+   *   lookup examines one slot;
+   * - a table of the short names, indexed by character;
+   * - the help text.
+   *
+   * Arguments are checked by each option's `option_spec::checker`.
+   * Parsing goes through the `schema_parser` returned by `parser`, and
+   * starts without any runtime setup or static initialization.
+   *
+   * A long or short name that appears twice makes the schema fail to
+   * compile. Requires C++17; check `OPTIONPP_CONSTEXPR_SCHEMA`.
+   *
+   * Example:
+   * ```
+   * static constexpr auto schema = optionpp::make_schema<my_options>();
+   *
+   * optionpp::parse_status status;
+   * schema.parser().visit(argc, argv,
+   *   [](const optionpp::option_spec& spec, optionpp::string_ref arg) {
+   *     switch (schema.parser().index(spec)) {
+   *     case schema.index_of("help"):
+   *       std::cout << schema.parser().help() << '\n';
+   *       break;
+   *     // ...
+   *     }
+   *     return true;
+   *   }, nullptr, status);
+   * ```
+   *
+   * @tparam N Number of options.
+   * @tparam SlotCount Number of slots in the long name table.
+   * @tparam BucketCount Number of buckets of the perfect hash.
+   * @tparam HelpSize Length of the help text.
+   */
+  template <std::size_t N, std::size_t SlotCount, std::size_t BucketCount,
+            std::size_t HelpSize>
+  class option_schema {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Position returned by `index_of` for a missing option.
+     */
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    /**
+     * @brief Constructor.
+     *
+     * Use `make_schema` instead, which computes the template
+     * arguments.
+     *
+     * @param specs The options (an array of `N` elements with static
+     *              storage duration).
+     * @throw std::logic_error If a name appears twice. In a constant
+     *                         expression, this is a compile error.
+     */
+    constexpr explicit option_schema(const option_spec* specs) : m_specs{specs} {
+      for (auto& entry : m_short_names)
+        entry = schema_parser::npos;
+      for (size_type i = 0; i < N; ++i) {
+        if (specs[i].short_name == '\0')
+          continue;
+        auto& entry = m_short_names[static_cast<unsigned char>(specs[i].short_name)];
+        if (entry != schema_parser::npos)
+          throw std::logic_error{"option_schema: duplicate short option name"};
+        entry = static_cast<std::uint32_t>(i);
+      }
+
+      build_long_names();
+      schema_layout::format_help(specs, N, m_help.data());
+    }
+
+    /**
+     * @brief Return the number of options.
+     * @return Number of options.
+     */
+    constexpr size_type size() const noexcept { return N; }
+
+    /**
+     * @brief Access an option.
+     * @param pos Position of the option.
+     * @return The option.
+     */
+    constexpr const option_spec& operator[](size_type pos) const noexcept {
+      return m_specs[pos];
+    }
+
+    /**
+     * @brief Find the position of an option by long name.
+     *
+     * Can be used in a constant expression, for example as a `case`
+     * label to compare with `schema_parser::index`.
+     *
+     * @param long_name Long name for the option.
+     * @return Position of the option, or `npos` if not found.
+     */
+    constexpr size_type index_of(const char* long_name) const noexcept {
+      if (!*long_name)
+        return npos;
+      std::uint32_t h = schema_layout::hash(long_name);
+      std::uint32_t pos = m_slots[schema_parser::displaced_slot(
+        h, m_displacements[schema_parser::bucket(h, BucketCount)], SlotCount)];
+      if (pos == schema_parser::npos
+          || !schema_layout::equal(m_specs[pos].long_name, long_name))
+        return npos;
+      return pos;
+    }
+    /**
+     * @brief Find the position of an option by short name.
+     * @param short_name Short name for the option.
+     * @return Position of the option, or `npos` if not found.
+     */
+    constexpr size_type index_of(char short_name) const noexcept {
+      std::uint32_t pos = m_short_names[static_cast<unsigned char>(short_name)];
+      return short_name != '\0' && pos != schema_parser::npos ? pos : npos;
+    }
+
+    /**
+     * @brief Get a parser that uses the tables of this schema.
+     * @return The parser. It refers to the schema, which must outlive
+     *         it.
+     */
+    constexpr schema_parser parser() const noexcept {
+      return schema_parser{m_specs, N, m_slots.data(), SlotCount,
+                           m_displacements.data(), BucketCount,
+                           m_short_names.data(), m_help.data(), HelpSize};
+    }
+
+  private:
+
+    /**
+     * @brief Build the perfect hash table of the long names.
+     *
+     * Uses the hash-and-displace method: the names are split into
+     * buckets, and the buckets are placed largest first, each with
+     * the smallest displacement that puts all of its names in free
+     * slots.
+     *
+     * @throw std::logic_error If a long name appears twice, or if two
+     *                         names have the same hash.
+     */
+    constexpr void build_long_names() {
+      for (auto& slot : m_slots)
+        slot = schema_parser::npos;
+
+      // Group the names by bucket
+      std::array<std::uint32_t, N + 1> hashes{};
+      std::array<size_type, BucketCount + 1> starts{};
+      for (size_type i = 0; i < N; ++i) {
+        if (!*m_specs[i].long_name)
+          continue;
+        hashes[i] = schema_layout::hash(m_specs[i].long_name);
+        ++starts[schema_parser::bucket(hashes[i], BucketCount) + 1];
+      }
+      size_type largest = 0;
+      for (size_type b = 0; b < BucketCount; ++b) {
+        largest = starts[b + 1] > largest ? starts[b + 1] : largest;
+        starts[b + 1] += starts[b];
+      }
+      std::array<std::uint32_t, N + 1> members{};
+      std::array<size_type, BucketCount> filled{};
+      for (size_type i = 0; i < N; ++i) {
+        if (!*m_specs[i].long_name)
+          continue;
+        size_type b = schema_parser::bucket(hashes[i], BucketCount);
+        members[starts[b] + filled[b]++] = static_cast<std::uint32_t>(i);
+      }
+
+      // Place the largest buckets first, while the table is emptiest
+      for (size_type size = largest; size > 0; --size) {
+        for (size_type b = 0; b < BucketCount; ++b) {
+          if (starts[b + 1] - starts[b] != size)
+            continue;
+          const size_type first = starts[b];
+          const size_type last = starts[b + 1];
+
+          for (size_type i = first; i < last; ++i) {
+            for (size_type j = first; j < i; ++j) {
+              if (hashes[members[i]] != hashes[members[j]])
+                continue;
+              if (schema_layout::equal(m_specs[members[i]].long_name,
+                                       m_specs[members[j]].long_name))
+                throw std::logic_error{"option_schema: duplicate long option name"};
+              throw std::logic_error{"option_schema: long option names with equal hashes"};
+            }
+          }
+
+          bool placed = false;
+          for (std::uint32_t d = 0; !placed; ++d) {
+            if (d == max_displacement)
+              throw std::logic_error{"option_schema: no perfect hash found"};
+
+            size_type i = first;
+            for (; i < last; ++i) {
+              auto& slot = m_slots[schema_parser::displaced_slot(hashes[members[i]], d, SlotCount)];
+              if (slot != schema_parser::npos)
+                break;
+              slot = members[i];
+            }
+
+            placed = i == last;
+            if (!placed) { // Take back the names placed so far
+              while (i-- > first)
+                m_slots[schema_parser::displaced_slot(hashes[members[i]], d, SlotCount)]
+                  = schema_parser::npos;
+            } else {
+              m_displacements[b] = d;
+            }
+          }
+        }
+      }
+    }
+
+    static constexpr std::uint32_t max_displacement = 1u << 16; //< Displacements to try for each bucket.
+
+    const option_spec* m_specs; //< The options.
+    std::array<std::uint32_t, SlotCount> m_slots{}; //< Perfect hash table of long names.
+    std::array<std::uint32_t, BucketCount> m_displacements{}; //< Displacement of each bucket.
+    std::array<std::uint32_t, 256> m_short_names{}; //< Option for each short name.
+    std::array<char, HelpSize + 1> m_help{}; //< Formatted help text, null-terminated.
+  };
+
+  /**
+   * @brief Build an `option_schema` from an array of options.
+   *
+   * Meant to initialize a `constexpr` variable, so that all tables
+   * are generated by the compiler:
+   * ```
+   * static constexpr auto schema = optionpp::make_schema<my_options>();
+   * ```
+   *
+   * @tparam Specs A `constexpr` array of `option_spec` (built-in or
+   *               `std::array`) with static storage duration.
+   * @return The schema.
+   */
+  template <const auto& Specs>
+  constexpr auto make_schema() {
+    constexpr std::size_t count = std::size(Specs);
+    constexpr std::size_t help_size
+      = schema_layout::format_help(std::data(Specs), count, nullptr);
+    return option_schema<count, schema_layout::slot_count(count),
+                         schema_layout::bucket_count(count), help_size>{std::data(Specs)};
+  }
+
+#endif
+
+} // End namespace
+
+/* Implementation */
+
+template <typename InputIt>
+bool optionpp::schema_parser::visit(InputIt first, InputIt last,
+                                    const option_handler& on_option,
+                                    const non_option_handler& on_non_option,
+                                    parse_status& status,
+                                    bool ignore_first) const {
+  status.clear();
+  visit_state state{on_option, on_non_option, status};
+  if (ignore_first && first != last) {
+    ++first;
+    ++state.index;
+  }
+
+  for (; first != last; ++first) {
+    if (!parse_token(string_ref{*first}, state) || state.stopped)
+      return false;
+  }
+  return finish(state) && !state.stopped;
+}
+
+#endif
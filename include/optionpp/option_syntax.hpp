@@ -0,0 +1,156 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `option_syntax` class.
+ */
+
+#ifndef OPTIONPP_OPTION_SYNTAX_HPP
+#define OPTIONPP_OPTION_SYNTAX_HPP
+
+#include <optionpp/string_ref.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Classifies command-line arguments by the strings that
+   *        introduce options.
+   *
+   * Holds references to the short and long option prefixes, the
+   * end-of-options marker and the equals string, and splits each
+   * command-line argument into its kind, option specifier and
+   * assigned argument. Every parsing engine (`compiled_parser` and
+   * `schema_parser`) classifies arguments through this class, so
+   * that they agree on what is an option.
+   *
+   * The referenced strings must outlive the `option_syntax`.
+   */
+  class option_syntax {
+  public:
+
+    /**
+     * @brief Kind of command-line argument.
+     */
+    enum class token_kind {
+      non_option, //< An argument that is not an option.
+      end_of_options, //< The end-of-options marker.
+      long_option, //< A long option, such as `--name` or `--name=value`.
+      short_options, //< A group of short options, such as `-abc` or `-a=value`.
+      bad_assignment //< A prefix directly followed by the equals string, such as `--=`.
+    };
+
+    /**
+     * @brief A command-line argument split into its parts.
+     */
+    struct token_parts {
+      token_kind kind; //< Kind of argument.
+      string_ref specifier; //< The part before the equals string, or the whole argument.
+      string_ref argument; //< The part after the equals string, if any.
+      bool has_argument; //< Whether the argument contains the equals string.
+    };
+
+    /**
+     * @brief Default constructor.
+     *
+     * Uses the default syntax: `-` for short options, `--` for long
+     * options and for the end-of-options marker, and `=` for
+     * assignments.
+     */
+    option_syntax() noexcept
+      : m_short_prefix{"-", 1}, m_long_prefix{"--", 2},
+        m_end_of_options{"--", 2}, m_equals{"=", 1} {}
+
+    /**
+     * @brief Constructor.
+     * @param short_prefix String that introduces a group of short
+     *                     options.
+     * @param long_prefix String that introduces a long option.
+     * @param end_of_options String that marks the end of the options.
+     * @param equals String that assigns an argument to an option.
+     */
+    option_syntax(string_ref short_prefix, string_ref long_prefix,
+                  string_ref end_of_options, string_ref equals) noexcept
+      : m_short_prefix{short_prefix}, m_long_prefix{long_prefix},
+        m_end_of_options{end_of_options}, m_equals{equals} {}
+
+    /**
+     * @brief Return the short option prefix.
+     * @return String that introduces a group of short options.
+     */
+    string_ref short_prefix() const noexcept { return m_short_prefix; }
+    /**
+     * @brief Return the long option prefix.
+     * @return String that introduces a long option.
+     */
+    string_ref long_prefix() const noexcept { return m_long_prefix; }
+    /**
+     * @brief Return the end-of-options marker.
+     * @return String that marks the end of the options.
+     */
+    string_ref end_of_options() const noexcept { return m_end_of_options; }
+    /**
+     * @brief Return the equals string.
+     * @return String that assigns an argument to an option.
+     */
+    string_ref equals() const noexcept { return m_equals; }
+
+    /**
+     * @brief Split a command-line argument into its parts.
+     * @param token The argument.
+     * @return Kind, specifier and assigned argument of `token`.
+     */
+    token_parts split(string_ref token) const noexcept;
+
+    /**
+     * @brief Determine whether an argument is a non-option argument.
+     *
+     * An option waiting for an optional argument only takes the next
+     * argument if this returns true for it.
+     *
+     * @param token Argument to check.
+     * @return True if the argument is not an option or an
+     *         end-of-options marker.
+     */
+    bool is_non_option(string_ref token) const noexcept {
+      return token != m_end_of_options
+        && !has_prefix(token, m_long_prefix)
+        && !has_prefix(token, m_short_prefix);
+    }
+
+    /**
+     * @brief Determine whether a string starts with a prefix.
+     * @param str String to check.
+     * @param prefix Prefix to look for.
+     * @return True if `str` is longer than `prefix` and starts with it.
+     */
+    static bool has_prefix(string_ref str, string_ref prefix) noexcept {
+      return str.size() > prefix.size() && str.starts_with(prefix);
+    }
+
+  private:
+    string_ref m_short_prefix; //< String that introduces a group of short options.
+    string_ref m_long_prefix; //< String that introduces a long option.
+    string_ref m_end_of_options; //< String that marks the end of the options.
+    string_ref m_equals; //< String that assigns an argument to an option.
+  };
+
+} // End namespace
+
+#endif
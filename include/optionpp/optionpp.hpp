@@ -25,7 +25,18 @@
 #ifndef OPTIONPP_OPTIONPP_HPP
 #define OPTIONPP_OPTIONPP_HPP
 
+#include <optionpp/batch_result.hpp>
+#include <optionpp/command_parser.hpp>
+#include <optionpp/command_result.hpp>
+#include <optionpp/compiled_parser.hpp>
+#include <optionpp/converter.hpp>
+#include <optionpp/incremental_parser.hpp>
+#include <optionpp/option_schema.hpp>
+#include <optionpp/parse_status.hpp>
+#include <optionpp/parse_target.hpp>
 #include <optionpp/parser.hpp>
+#include <optionpp/parser_result_ref.hpp>
 #include <optionpp/result_iterator.hpp>
+#include <optionpp/string_ref.hpp>
 
 #endif
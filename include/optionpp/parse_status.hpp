@@ -0,0 +1,244 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `parse_status` class.
+ */
+
+#ifndef OPTIONPP_PARSE_STATUS_HPP
+#define OPTIONPP_PARSE_STATUS_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include <optionpp/error.hpp>
+#include <optionpp/string_ref.hpp>
+#include <optionpp/suggestion_index.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Kind of error found while parsing.
+   */
+  enum class parse_errc {
+    none, //< No error.
+    invalid_option, //< The option is not recognized.
+    missing_argument, //< A mandatory option argument was not given.
+    unexpected_argument, //< An argument was given to an option that does not take one.
+    not_an_integer, //< An integer argument could not be converted.
+    negative_argument, //< An unsigned integer argument was negative.
+    not_a_number, //< A floating-point argument could not be converted.
+    out_of_range, //< A numeric argument does not fit in its type.
+    unreadable_file, //< A response file could not be read.
+    recursive_file, //< A response file includes itself.
+    invalid_value, //< An argument is not one of the accepted values, or has an unknown unit.
+    ambiguous_option, //< An abbreviated long option matches more than one option.
+    unknown_command //< A non-option argument does not name a subcommand.
+  };
+
+  /**
+   * @brief Outcome of a parse that reports errors without throwing.
+   *
+   * A failed parse records the kind of error, the index of the
+   * command-line argument where it was found and the byte offset
+   * within that argument. The human-readable message is only built
+   * when `message` or `to_error` is called.
+   *
+   * A `parse_status` can be reused: setting an error reuses the
+   * storage held for the option name, so a status that is passed to
+   * parse after parse does not allocate once that storage is large
+   * enough.
+   */
+  class parse_status {
+  public:
+
+    /**
+     * @brief Integer type used for indices and offsets.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Check whether parsing succeeded.
+     * @return True if there was no error.
+     */
+    bool ok() const noexcept { return m_error == parse_errc::none; }
+
+    /**
+     * @brief Check whether parsing succeeded.
+     * @return True if there was no error.
+     */
+    explicit operator bool() const noexcept { return ok(); }
+
+    /**
+     * @brief Get the kind of error.
+     * @return The error, or `parse_errc::none`.
+     */
+    parse_errc error() const noexcept { return m_error; }
+
+    /**
+     * @brief Get the index of the command-line argument that caused
+     *        the error.
+     *
+     * Ignored arguments (such as the program name) are counted, so
+     * the index refers to the sequence that was given to the parser.
+     *
+     * @return Index of the argument.
+     */
+    size_type token_index() const noexcept { return m_token_index; }
+
+    /**
+     * @brief Get the byte offset within the command-line argument
+     *        where the error was found.
+     * @return Offset from the start of the argument.
+     */
+    size_type offset() const noexcept { return m_offset; }
+
+    /**
+     * @brief Get the option that caused the error.
+     * @return Option as it was written on the command line, including
+     *         its prefix, the file name for a response file error,
+     *         or the command name for an unknown command.
+     */
+    const std::string& option() const noexcept { return m_option; }
+
+    /**
+     * @brief Get the options that an ambiguous abbreviation matches.
+     * @return Each matching option, including its prefix, in order of
+     *         name; empty unless the error is
+     *         `parse_errc::ambiguous_option`.
+     */
+    const std::vector<std::string>& candidates() const noexcept {
+      return m_candidates;
+    }
+
+    /**
+     * @brief Get the options closest to a misspelled long option.
+     *
+     * The suggestions are computed when this method is called, from
+     * the long option names of the parser that reported the error, so
+     * a failed parse only pays for them if they are requested. They
+     * are only available for `parse_errc::invalid_option` errors on
+     * long options, and only if the parser had suggestions enabled
+     * (see `parser::set_suggestions`).
+     *
+     * @return Up to three options, including their prefix, closest
+     *         first.
+     */
+    std::vector<std::string> suggestions() const;
+
+    /**
+     * @brief Build the error message.
+     *
+     * For `parse_errc::ambiguous_option`, the message lists the
+     * candidates. For `parse_errc::invalid_option`, it includes the
+     * `suggestions`, if any.
+     *
+     * @return Message identical to the one carried by the
+     *         `parse_error` that the throwing methods would raise, or
+     *         an empty string if there was no error.
+     */
+    std::string message() const;
+
+    /**
+     * @brief Build the `parse_error` for this status.
+     * @return `parse_error` with the message and option.
+     */
+    parse_error to_error() const;
+
+    /**
+     * @brief Reset the status to success.
+     */
+    void clear() noexcept {
+      m_error = parse_errc::none;
+      m_token_index = 0;
+      m_offset = 0;
+      m_option.clear();
+      m_candidates.clear();
+      m_suggestions.reset();
+    }
+
+    /**
+     * @brief Build the message for an error.
+     * @param error The kind of error.
+     * @param option The option that caused the error.
+     * @return The error message, or an empty string for
+     *         `parse_errc::none`.
+     */
+    static std::string message(parse_errc error, string_ref option);
+
+  private:
+    friend class command_parser;
+    friend class compiled_parser;
+    friend class schema_parser;
+
+    /**
+     * @brief Record an error.
+     * @param error The kind of error.
+     * @param token_index Index of the command-line argument.
+     * @param offset Byte offset within the argument.
+     * @param prefix Start of the option text.
+     * @param name Rest of the option text.
+     */
+    void set(parse_errc error, size_type token_index, size_type offset,
+             string_ref prefix, string_ref name = string_ref{}) {
+      m_error = error;
+      m_token_index = token_index;
+      m_offset = offset;
+      m_option.assign(prefix.data(), prefix.size());
+      m_option.append(name.data(), name.size());
+      m_candidates.clear();
+      m_suggestions.reset();
+    }
+
+    /**
+     * @brief Make suggestions available for an invalid long option.
+     * @param suggestions Names of the parser's long options.
+     * @param prefix_size Length of the long option prefix at the start
+     *                    of the stored option.
+     */
+    void set_suggestions(const std::shared_ptr<const suggestion_index>& suggestions,
+                         size_type prefix_size) noexcept {
+      m_suggestions = suggestions;
+      m_prefix_size = prefix_size;
+    }
+
+    /**
+     * @brief Record an option matched by an ambiguous abbreviation.
+     * @param prefix Prefix of the option.
+     * @param name Name of the option.
+     */
+    void add_candidate(string_ref prefix, string_ref name) {
+      m_candidates.push_back(prefix.str());
+      m_candidates.back().append(name.data(), name.size());
+    }
+
+    parse_errc m_error{parse_errc::none}; //< Kind of error.
+    size_type m_token_index{0}; //< Index of the offending argument.
+    size_type m_offset{0}; //< Byte offset within the argument.
+    std::string m_option; //< Option that caused the error.
+    std::vector<std::string> m_candidates; //< Options matched by an ambiguous abbreviation.
+    std::shared_ptr<const suggestion_index> m_suggestions; //< Long option names to suggest from, if any.
+    size_type m_prefix_size{0}; //< Length of the prefix of `m_option`, when suggesting.
+  };
+
+} // End namespace
+
+#endif
@@ -0,0 +1,124 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `parse_target` class.
+ */
+
+#ifndef OPTIONPP_PARSE_TARGET_HPP
+#define OPTIONPP_PARSE_TARGET_HPP
+
+namespace optionpp {
+
+  /**
+   * @brief Object that receives the values of the options bound to
+   *        its members, for a single parse.
+   *
+   * Options bound with `option::bind(T C::*)` or
+   * `option::bind_bool(bool C::*)` name a member of a class `C`
+   * rather than a particular variable. A `parse_target` supplies the
+   * `C` object that those members are written to, and is passed to the
+   * `parse_into` overloads that take one. Since each parse can write
+   * to its own object, one `parser` can serve many threads at once:
+   * ```
+   * struct settings { bool verbose{}; int jobs{1}; };
+   *
+   * parser p;
+   * p["verbose"].bind_bool(&settings::verbose);
+   * p["jobs"].bind(&settings::jobs);
+   *
+   * // On any thread:
+   * settings s;
+   * parser_result result;
+   * parse_status status;
+   * p.parse_into(result, argc, argv, parse_target{s}, status);
+   * ```
+   *
+   * Members are only written when the target has exactly the class
+   * named in the member pointer; they are still checked otherwise.
+   */
+  class parse_target {
+  public:
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs a target without an object, so that member bindings
+     * are checked but not written.
+     */
+    parse_target() noexcept {}
+
+    /**
+     * @brief Constructor.
+     * @tparam C Class of the object.
+     * @param object The object to write member bindings to. It must
+     *               outlive the parse.
+     */
+    template <typename C>
+    explicit parse_target(C& object) noexcept
+      : m_object{&object}, m_type{type_id<C>()} {}
+
+    /**
+     * @brief Get the object, if it has a given class.
+     * @param type Identifier of the class, as given by `type_id`.
+     * @return Pointer to the object, or `nullptr` if the target has
+     *         another class or no object.
+     */
+    void* object(const void* type) const noexcept;
+
+    /**
+     * @brief Get a unique identifier for a class.
+     *
+     * The identifier is the address of a variable that exists once
+     * for each class, so no run-time type information is needed.
+     *
+     * @tparam C The class.
+     * @return Identifier for `C`.
+     */
+    template <typename C>
+    static const void* type_id() noexcept { return &type_tag<C>::id; }
+
+  private:
+
+    /**
+     * @brief Holds a variable whose address identifies a class.
+     * @tparam C The class.
+     */
+    template <typename C>
+    struct type_tag {
+      static const char id; //< Variable whose address identifies `C`.
+    };
+
+    void* m_object{nullptr}; //< The object receiving member bindings.
+    const void* m_type{nullptr}; //< Identifier for the object's class.
+  };
+
+} // End namespace
+
+/* Implementation */
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+template <typename C>
+const char optionpp::parse_target::type_tag<C>::id = 0;
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
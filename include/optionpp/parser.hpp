@@ -25,14 +25,26 @@
 #ifndef OPTIONPP_PARSER_HPP
 #define OPTIONPP_PARSER_HPP
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <initializer_list>
 #include <iosfwd>
+#include <iterator>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
+#include <optionpp/batch_result.hpp>
+#include <optionpp/compiled_parser.hpp>
+#include <optionpp/error.hpp>
 #include <optionpp/option_group.hpp>
+#include <optionpp/option_index.hpp>
+#include <optionpp/parse_status.hpp>
+#include <optionpp/parse_target.hpp>
 #include <optionpp/parser_result.hpp>
+#include <optionpp/string_pool.hpp>
 #include <optionpp/utility.hpp>
 
 /**
@@ -42,32 +54,6 @@
  */
 namespace optionpp {
 
-  /**
-   * @brief Exception class indicating an invalid option.
-   */
-  class parse_error : public error {
-  public:
-    /**
-     * @brief Constructor.
-     * @param msg String describing the error.
-     * @param fn_name Name of the function that threw the exception.
-     * @param option Name of the option that triggered the error (if
-     *               any).
-     */
-    parse_error(const std::string msg, const std::string fn_name,
-                const std::string option = "")
-      : error(msg, fn_name), m_option{option} {}
-
-    /**
-     * @brief Return option name.
-     * @return Option that triggered the error, if any.
-     */
-    const std::string& option() const noexcept { return m_option; }
-
-  private:
-    std::string m_option; //< Option that triggered the error.
-  };
-
   /**
    * @brief Parses program options.
    *
@@ -81,6 +67,30 @@ namespace optionpp {
    * For more information about the argument parsing, refer to the
    * documentation for the `parse` method.
    *
+   * Options are looked up through an `option_index` that is built
+   * the first time the parser is used after its options change. The
+   * options and groups held by the parser report every change to it,
+   * including changes made through references returned by `group`,
+   * `add_option` or `operator[]`, so such references can be kept and
+   * used to modify the options between calls to `parse`. `operator[]`
+   * uses a second index, which is updated for each option that is
+   * added or renamed, so looking up or adding an option takes
+   * constant time on average.
+   *
+   * When the same options are used to parse many command lines, the
+   * `compile` method can be used to take a read-only snapshot of the
+   * parser that can be shared between threads.
+   *
+   * A `parser` that is not being modified can also be shared between
+   * threads directly: all of its `const` methods, including `parse`,
+   * `parse_into` and `print_help`, may be called concurrently. The
+   * caches they fill are guarded internally. Parsing does however
+   * write to any variables bound with `option::bind` or
+   * `option::bind_bool`, and those writes are not synchronized.
+   * Threads sharing a parser should instead bind options to members
+   * with `option::bind(T C::*)`, and give each parse its own object
+   * through the `parse_into` overloads that take a `parse_target`.
+   *
    * @see option
    * @see parser_result
    */
@@ -108,6 +118,7 @@ namespace optionpp {
      */
     parser(const std::initializer_list<option>& il) {
       m_groups.emplace_back("", il.begin(), il.end());
+      track_groups();
     }
     /**
      * @brief Construct from a sequence.
@@ -124,7 +135,38 @@ namespace optionpp {
      *             sequence.
      */
     template <typename InputIt>
-    parser(InputIt first, InputIt last) { m_groups.emplace_back("", first, last); }
+    parser(InputIt first, InputIt last) {
+      m_groups.emplace_back("", first, last);
+      track_groups();
+    }
+
+    /**
+     * @brief Copy constructor.
+     *
+     * The option index is not copied; the new parser builds its own
+     * index when it is first used.
+     *
+     * @param other The `parser` to copy.
+     */
+    parser(const parser& other);
+    /**
+     * @brief Move constructor.
+     * @param other The `parser` to move from.
+     */
+    parser(parser&& other) noexcept;
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other The `parser` to copy.
+     * @return Reference to the current instance.
+     */
+    parser& operator=(const parser& other);
+    /**
+     * @brief Move assignment operator.
+     * @param other The `parser` to move from.
+     * @return Reference to the current instance.
+     */
+    parser& operator=(parser&& other) noexcept;
 
     /**
      * @brief Returns a reference to a particular group.
@@ -157,6 +199,12 @@ namespace optionpp {
      * @return Reference to the inserted `option`, for chaining.
      */
     option& add_option(const option& opt = option{});
+    /**
+     * @brief Move a program option into the parser.
+     * @param opt The `option` to add.
+     * @return Reference to the inserted `option`, for chaining.
+     */
+    option& add_option(option&& opt);
 
     /**
      * @brief Add a program option.
@@ -176,6 +224,38 @@ namespace optionpp {
                        bool arg_required = false,
                        const std::string& group_name = "");
 
+    /**
+     * @brief Add many program options at once.
+     *
+     * This is the fastest way to register a large option table:
+     * `add_options` checks all the names in one pass with a hash
+     * table, reserves room for the options once, and leaves the
+     * option indexes to be built once, when the parser is next used.
+     *
+     * Pass `std::move_iterator`s to move the options into the parser
+     * instead of copying them:
+     * ```
+     * opt_parser.add_options(std::make_move_iterator(opts.begin()),
+     *                        std::make_move_iterator(opts.end()));
+     * ```
+     *
+     * If a long or short name of one of the new options is already
+     * used by another new option or by an option in any group of the
+     * parser, nothing is added.
+     *
+     * @tparam ForwardIt The iterator type (usually deduced). It must
+     *                   be possible to traverse the sequence twice.
+     * @param first The iterator pointing to the start of the
+     *              sequence.
+     * @param last The iterator pointing to one past the end of the
+     *             sequence.
+     * @param group_name Name of group the options should be added to.
+     * @throw duplicate_option_error If a name is already in use.
+     */
+    template <typename ForwardIt>
+    void add_options(ForwardIt first, ForwardIt last,
+                     const std::string& group_name = "");
+
     /**
      * @brief Parse command-line arguments from a sequence of
      *        strings.
@@ -258,6 +338,444 @@ namespace optionpp {
      */
     parser_result parse(const std::string& cmd_line, bool ignore_first = false) const;
 
+    /**
+     * @brief Parse command-line arguments into an existing result.
+     *
+     * Works like `parse(InputIt, InputIt, bool)`, but stores the
+     * parsed data in `result` instead of returning a new
+     * `parser_result`. The result is cleared first, and the memory
+     * held by its earlier entries is reused. When the same
+     * `parser_result` is used for every parse, parsing a command line
+     * no longer than an earlier one does not allocate any memory.
+     *
+     * If an exception is thrown, `result` holds the entries parsed
+     * before the error.
+     *
+     * @param result The `parser_result` to fill.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     * @see parser_result::clear
+     */
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result.
+     *
+     * Works like `parse(int, char*[], bool)`; see
+     * `parse_into(parser_result&, InputIt, InputIt, bool)` for
+     * details.
+     *
+     * @param result The `parser_result` to fill.
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string into an
+     *        existing result.
+     *
+     * Works like `parse(const std::string&, bool)`; see
+     * `parse_into(parser_result&, InputIt, InputIt, bool)` for
+     * details. Arguments are passed to the parser as slices of
+     * `cmd_line`; only an argument containing quotes or escape
+     * characters is first copied into a temporary buffer.
+     *
+     * @param result The `parser_result` to fill.
+     * @param cmd_line The command-line arguments to parse.
+     * @param ignore_first If true, the first argument is ignored.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    bool ignore_first = false) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result
+     *        without throwing on invalid input.
+     *
+     * Works like `parse_into(parser_result&, InputIt, InputIt, bool)`,
+     * but an invalid option or argument is reported through `status`
+     * instead of a `parse_error`. Parsing stops at the first error,
+     * leaving the entries parsed before it in `result`. The error
+     * message is only built if `status.message()` is called, so this
+     * is much cheaper than catching a `parse_error` when invalid input
+     * is common.
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @see parse_status
+     */
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    parse_status& status, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result
+     *        without throwing on invalid input.
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     */
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    parse_status& status, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string into an
+     *        existing result without throwing on invalid input.
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param cmd_line The command-line arguments to parse.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument is ignored.
+     */
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    parse_status& status, bool ignore_first = false) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result,
+     *        writing bound members to a target object.
+     *
+     * Works like `parse_into(parser_result&, InputIt, InputIt,
+     * parse_status&, bool)`, but the arguments of options bound with
+     * `option::bind(T C::*)` and `option::bind_bool(bool C::*)` are
+     * written to the object held by `target`. Variables bound with
+     * `option::bind(T*)` and `option::bind_bool(bool*)` are not
+     * written, although arguments are still checked against their
+     * types. Since nothing but `result`, `target` and `status` is
+     * modified, several threads can call this method on the same
+     * parser at once, each with its own target:
+     * ```
+     * struct settings { bool verbose{}; int jobs{1}; };
+     *
+     * parser p;
+     * p["verbose"].bind_bool(&settings::verbose);
+     * p["jobs"].bind(&settings::jobs);
+     *
+     * settings s;
+     * parser_result result;
+     * parse_status status;
+     * p.parse_into(result, args.begin(), args.end(), parse_target{s}, status);
+     * ```
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param target Object receiving the bound members.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @see parse_target
+     */
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments into an existing result,
+     *        writing bound members to a target object.
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param target Object receiving the bound members.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     */
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string into an
+     *        existing result, writing bound members to a target
+     *        object.
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param cmd_line The command-line arguments to parse.
+     * @param target Object receiving the bound members.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument is ignored.
+     */
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = false) const;
+
+    /**
+     * @brief Parse the options at the start of a command line,
+     *        leaving the rest untouched.
+     *
+     * See `compiled_parser::parse_leading_options(parser_result&,
+     * InputIt, InputIt, bool)`.
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return Iterator to the first argument that was not parsed, or
+     *         `last` if every argument was parsed.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    template <typename InputIt>
+    InputIt parse_leading_options(parser_result& result, InputIt first,
+                                  InputIt last, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse the options at the start of a command line without
+     *        throwing on invalid input.
+     *
+     * See `compiled_parser::parse_leading_options(parser_result&,
+     * InputIt, InputIt, parse_status&, bool)`.
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return Iterator to the first argument that was not parsed, or
+     *         to the argument that caused an error.
+     */
+    template <typename InputIt>
+    InputIt parse_leading_options(parser_result& result, InputIt first,
+                                  InputIt last, parse_status& status,
+                                  bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments without copying them.
+     *
+     * Works like `parse(InputIt, InputIt, bool)`, but returns a
+     * `parser_result_ref` whose entries refer directly to the strings
+     * in `[first, last)` and to the names stored in this parser's
+     * options, instead of copying them. The arguments must outlive the
+     * result, and the options of this parser must not be changed
+     * while the result is in use.
+     *
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return `parser_result_ref` containing the parsed data.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     * @see parser_result_ref
+     */
+    template <typename InputIt>
+    parser_result_ref parse_ref(InputIt first, InputIt last,
+                                bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments without copying them.
+     *
+     * Works like `parse(int, char*[], bool)`; see
+     * `parse_ref(InputIt, InputIt, bool)` for the lifetime
+     * requirements.
+     *
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return `parser_result_ref` containing the parsed data.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    parser_result_ref parse_ref(int argc, char* argv[],
+                                bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string without
+     *        copying each argument separately.
+     *
+     * Works like `parse(const std::string&, bool)`. The split
+     * arguments are kept in the result itself, so only the options of
+     * this parser need to stay unchanged while the result is in use.
+     *
+     * @param cmd_line The command-line arguments to parse.
+     * @param ignore_first If true, the first argument is ignored.
+     * @return `parser_result_ref` containing the parsed data.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    parser_result_ref parse_ref(const std::string& cmd_line,
+                                bool ignore_first = false) const;
+
+    /**
+     * @brief Parse command-line arguments, passing each entry to a
+     *        handler instead of storing it.
+     *
+     * See `compiled_parser::visit(InputIt, InputIt, const
+     * compiled_parser::option_handler&, const
+     * compiled_parser::non_option_handler&, parse_status&, bool)`.
+     *
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param on_option Receives each option. May be empty.
+     * @param on_non_option Receives each non-option argument. May be
+     *                      empty.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return True if every argument was parsed and passed on; false
+     *         if there was an error or a handler stopped parsing.
+     */
+    template <typename InputIt>
+    bool visit(InputIt first, InputIt last,
+               const compiled_parser::option_handler& on_option,
+               const compiled_parser::non_option_handler& on_non_option,
+               parse_status& status, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments, passing each entry to a
+     *        handler instead of storing it.
+     * @param argc The number of arguments given on the command line.
+     * @param argv All command-line arguments.
+     * @param on_option Receives each option. May be empty.
+     * @param on_non_option Receives each non-option argument. May be
+     *                      empty.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return True if every argument was parsed and passed on.
+     */
+    bool visit(int argc, char* argv[],
+               const compiled_parser::option_handler& on_option,
+               const compiled_parser::non_option_handler& on_non_option,
+               parse_status& status, bool ignore_first = true) const;
+
+    /**
+     * @brief Parse command-line arguments from a string, passing each
+     *        entry to a handler instead of storing it.
+     * @param cmd_line The command-line arguments to parse.
+     * @param on_option Receives each option. May be empty.
+     * @param on_non_option Receives each non-option argument. May be
+     *                      empty.
+     * @param status Receives the outcome. It is cleared first.
+     * @param ignore_first If true, the first argument is ignored.
+     * @return True if every argument was parsed and passed on.
+     */
+    bool visit(const std::string& cmd_line,
+               const compiled_parser::option_handler& on_option,
+               const compiled_parser::non_option_handler& on_non_option,
+               parse_status& status, bool ignore_first = false) const;
+
+    /**
+     * @brief Parse many command lines.
+     *
+     * See `compiled_parser::parse_batch(InputIt, InputIt, bool)`.
+     * Bound variables are never written. The entries refer to the
+     * options of this parser, which must not be changed while the
+     * result is in use.
+     *
+     * @param first Iterator pointing to the first command line.
+     * @param last Iterator pointing to one past the last command line.
+     * @param ignore_first If true, the first argument of each line is
+     *                     ignored.
+     * @return `batch_result` holding the entries and status of every
+     *         line.
+     * @see batch_result
+     */
+    template <typename InputIt>
+    batch_result parse_batch(InputIt first, InputIt last,
+                             bool ignore_first = false) const;
+
+    /**
+     * @brief Parse many command lines in parallel.
+     *
+     * See `compiled_parser::parse_batch(ForwardIt, ForwardIt, const
+     * compiled_parser::executor_type&, size_type, bool)`.
+     *
+     * @param first Iterator pointing to the first command line.
+     * @param last Iterator pointing to one past the last command line.
+     * @param executor Function that runs the tasks.
+     * @param lines_per_task Number of lines in each task.
+     * @param ignore_first If true, the first argument of each line is
+     *                     ignored.
+     * @return `batch_result` holding the entries and status of every
+     *         line.
+     */
+    template <typename ForwardIt>
+    batch_result parse_batch(ForwardIt first, ForwardIt last,
+                             const compiled_parser::executor_type& executor,
+                             compiled_parser::size_type lines_per_task = 256,
+                             bool ignore_first = false) const;
+
+    /**
+     * @brief Parse a very long sequence of command-line arguments in
+     *        parallel.
+     *
+     * See `compiled_parser::parse_parallel`.
+     *
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param executor Function that runs the tasks.
+     * @param args_per_task Number of arguments in each task.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     * @return `parser_result` containing the parsed data.
+     * @throw parse_error If an invalid option is entered or a
+     *                    mandatory argument is missing.
+     */
+    template <typename ForwardIt>
+    parser_result parse_parallel(ForwardIt first, ForwardIt last,
+                                 const compiled_parser::executor_type& executor,
+                                 compiled_parser::size_type args_per_task = 16384,
+                                 bool ignore_first = true) const;
+
+    /**
+     * @brief Parse a very long sequence of command-line arguments in
+     *        parallel into an existing result, without throwing on
+     *        invalid input.
+     *
+     * See `compiled_parser::parse_parallel_into`.
+     *
+     * @param result The `parser_result` to fill. It is cleared first.
+     * @param first An iterator pointing to the first argument.
+     * @param last An iterator pointing to one past the last argument.
+     * @param executor Function that runs the tasks.
+     * @param status Receives the outcome. It is cleared first.
+     * @param args_per_task Number of arguments in each task.
+     * @param ignore_first If true, the first argument (typically the
+     *                     program filename) is ignored.
+     */
+    template <typename ForwardIt>
+    void parse_parallel_into(parser_result& result, ForwardIt first,
+                             ForwardIt last,
+                             const compiled_parser::executor_type& executor,
+                             parse_status& status,
+                             compiled_parser::size_type args_per_task = 16384,
+                             bool ignore_first = true) const;
+
+    /**
+     * @brief Take a read-only snapshot of the parser.
+     *
+     * The returned `compiled_parser` holds its own copy of every
+     * option and of the custom strings, and is not affected by later
+     * changes to this parser.
+     *
+     * @return `compiled_parser` that parses exactly like this parser.
+     * @see compiled_parser
+     */
+    compiled_parser compile() const { return compiled_parser{*this}; }
+
     /**
      * @brief Change special strings used by the parser.
      *
@@ -281,6 +799,108 @@ namespace optionpp {
                             const std::string& end_indicator = "",
                             const std::string& equals = "");
 
+    /**
+     * @brief Enable or disable response files.
+     *
+     * When enabled, a command-line argument consisting of `prefix`
+     * followed by a file name is replaced by the arguments read from
+     * that file (a "response file"). The file is split using the same
+     * quote and escape rules as `utility::split`, with spaces, tabs
+     * and newlines as delimiters, and may itself name other response
+     * files. A file that cannot be read, or that includes itself
+     * directly or indirectly, is a parse error.
+     *
+     * Response files are memory-mapped where possible and split one
+     * argument at a time, so expanding them takes memory proportional
+     * to the longest argument rather than to the size of the file.
+     * Expansion happens before any other processing, so it also
+     * applies to option arguments and to arguments after the
+     * end-of-options marker. Argument indices reported in errors
+     * count the arguments after expansion.
+     *
+     * Response files are disabled by default.
+     *
+     * @param prefix String that introduces a response file name
+     *               (usually `"@"`), or an empty string to disable
+     *               response files.
+     */
+    void set_response_file_prefix(const std::string& prefix = "@") {
+      invalidate_index();
+      m_response_file_prefix = prefix;
+    }
+
+    /**
+     * @brief Get the prefix that introduces a response file.
+     * @return The response file prefix, or an empty string if
+     *         response files are disabled.
+     * @see set_response_file_prefix
+     */
+    const std::string& response_file_prefix() const noexcept {
+      return m_response_file_prefix;
+    }
+
+    /**
+     * @brief Allow or disallow abbreviated long options.
+     *
+     * When allowed, a long option can be given by any prefix of its
+     * name that is not a prefix of another long option name, as with
+     * `getopt_long`: if `verbose` and `version` are the only long
+     * names starting with `v`, then `--verb` selects `verbose`. A
+     * name that matches an option exactly is always accepted, even if
+     * it is also a prefix of other names. A prefix shared by several
+     * options is a parse error of kind
+     * `parse_errc::ambiguous_option`, whose message lists the
+     * candidates (see `parse_status::candidates`). The entries in the
+     * result hold the full long name of the option.
+     *
+     * Prefixes are resolved by binary search over the sorted long
+     * names of all groups, without scanning the options. Abbreviations
+     * are not allowed by default.
+     *
+     * @param allow True to allow abbreviations, false to require
+     *              exact names.
+     */
+    void set_allow_abbreviations(bool allow = true) {
+      invalidate_index();
+      m_allow_abbreviations = allow;
+    }
+
+    /**
+     * @brief Check whether long options can be abbreviated.
+     * @return True if abbreviations are allowed.
+     * @see set_allow_abbreviations
+     */
+    bool allow_abbreviations() const noexcept { return m_allow_abbreviations; }
+
+    /**
+     * @brief Enable or disable suggestions for misspelled options.
+     *
+     * When enabled, an invalid long option is reported together with
+     * the closest long option names, for example `invalid option:
+     * '--verbos'; did you mean '--verbose'?`. The suggestions are
+     * also available from `parse_status::suggestions`.
+     *
+     * The long names are arranged in a `suggestion_index` when the
+     * parser is first used, and suggestions are only looked up when
+     * an error message is built, so enabling them does not slow down
+     * the parsing of valid command lines. Suggestions are disabled by
+     * default.
+     *
+     * @param enable True to enable suggestions.
+     */
+    void set_suggestions(bool enable = true) {
+      invalidate_index();
+      m_suggestions_enabled = enable;
+    }
+
+    /**
+     * @brief Check whether suggestions are enabled.
+     * @return True if invalid long options are reported with
+     *         suggestions.
+     * @see set_suggestions
+     */
+    bool suggestions_enabled() const noexcept { return m_suggestions_enabled; }
+
     /**
      * @brief Sorts the groups by name.
      *
@@ -342,6 +962,15 @@ namespace optionpp {
      * the total level of indentation, counted from the leftmost
      * character of the line.
      *
+     * The formatted text is cached for the last few sets of
+     * formatting parameters, so printing the same help again only
+     * writes the cached text to the stream. The cache is cleared by
+     * any method that can change the options. Note that changes made
+     * through an `option` reference obtained before the help was
+     * printed are not detected; call `group` or `operator[]` again
+     * (or `sort_options`) after such changes. Concurrent calls are
+     * serialized, so that each writes the complete text.
+     *
      * @param os Output stream.
      * @param max_line_length Text will be wrapped so that each line
      *                        is at most this many characters.
@@ -362,6 +991,9 @@ namespace optionpp {
 
 
   private:
+    friend class command_parser;
+    friend class compiled_parser;
+    friend class incremental_parser;
 
     /**
      * @brief Type used to hold `option_group` objects.
@@ -396,122 +1028,145 @@ namespace optionpp {
      */
     group_const_iterator find_group(const std::string& name) const;
 
+    /**
+     * @brief Checks that the names of options about to be added are
+     *        not in use.
+     *
+     * Each new option is checked as it is visited, so options
+     * returned by value from an iterator need not outlive the check.
+     */
+    class name_checker {
+    public:
+      /**
+       * @brief Record the names already used in a parser.
+       * @param owner The parser the options will be added to.
+       * @param count Number of options about to be added.
+       */
+      name_checker(const parser& owner, std::size_t count);
+
+      /**
+       * @brief Check and record the names of a new option.
+       * @param opt The option about to be added.
+       * @throw duplicate_option_error If a long or short name of the
+       *                               option appeared in an earlier
+       *                               new option, or is already used
+       *                               in the parser.
+       */
+      void add(const option& opt);
+
+    private:
+      string_pool m_long_names; //< Long names seen so far
+      std::array<bool, 256> m_short_names; //< Short names seen so far
+    };
+
     /**
      * @brief Search for an option by long name.
+     *
+     * Uses the name index, updating it first if necessary.
+     *
      * @param long_name Long name for the option.
      * @return Pointer to the option, or `nullptr` if not found.
      */
     option* find_option(const std::string& long_name);
-    /**
-     * @copydoc find_option
-     */
-    const option* find_option(const std::string& long_name) const;
 
     /**
      * @brief Search for an option by short name.
+     *
+     * Uses the name index, updating it first if necessary.
+     *
      * @param short_name Short name for the option.
      * @return Pointer to the option, or `nullptr` if not found.
      */
     option* find_option(char short_name);
+
     /**
-     * @copydoc find_option
+     * @brief Bring the name index up to date with the change log.
+     *
+     * The options listed as renamed in the log are added to the
+     * index. The index is rebuilt instead if options were moved, or
+     * if a listed option takes a name that the index gives to another
+     * option, since which of them is found then depends on their
+     * order.
+     *
+     * Names that options have given up stay in the index, so a lookup
+     * must check the name of the option it finds.
+     *
+     * @return The name index.
      */
-    const option* find_option(char short_name) const;
+    const option_index& update_lookup();
 
     /**
-     * @brief Determines whether an argument is an end-of-option
-     *        marker.
-     * @param argument Argument to check.
-     * @return True if the argument is an end-of-option marker.
+     * @brief Rebuild the name index from all the options.
      */
-    bool is_end_indicator(const std::string& argument) const noexcept {
-      return argument == m_end_of_options;
-    }
+    void rebuild_lookup();
 
     /**
-     * @brief Determines whether an argument is a long command-line
-     *        option.
-     * @param argument Argument to check.
-     * @return True if the argument begins with a long option prefix.
+     * @brief Return a view of the parser used for parsing,
+     *        rebuilding it if necessary.
+     *
+     * The view indexes the options in place rather than copying
+     * them. It is safe to call this method from several threads at
+     * once.
+     *
+     * @return Up-to-date `compiled_parser` view of this parser.
      */
-    bool is_long_option(const std::string& argument) const noexcept {
-      return argument.size() > m_long_option_prefix.size()
-        && utility::is_substr_at_pos(argument, m_long_option_prefix);
-    }
+    const compiled_parser& compiled() const;
 
     /**
-     * @brief Determines whether an argument is a short command-line
-     *        option group.
-     * @param argument Argument to check.
-     * @return True if the argument begins with a short option prefix.
+     * @brief Formatted help text for one set of formatting
+     *        parameters.
      */
-    bool is_short_option_group(const std::string& argument) const noexcept {
-      return argument.size() > m_short_option_prefix.size()
-        && utility::is_substr_at_pos(argument, m_short_option_prefix);
-    }
+    struct help_layout {
+      int max_line_length; //< Maximum line length.
+      int group_indent; //< Indentation of group names.
+      int option_indent; //< Indentation of option names.
+      int desc_first_line_indent; //< Indentation of the first line of each description.
+      int desc_multiline_indent; //< Indentation of the other description lines.
+      std::string text; //< The formatted help text.
+    };
 
     /**
-     * @brief Determines whether an argument is a non-option argument.
-     * @param argument Argument to check.
-     * @return True if the argument is a non-option argument.
+     * @brief Maximum number of help layouts kept in the cache.
      */
-    bool is_non_option(const std::string& argument) const noexcept {
-      return !is_end_indicator(argument)
-        && !is_long_option(argument)
-        && !is_short_option_group(argument);
-    }
+    static constexpr std::size_t max_help_layouts = 4;
 
     /**
-     * @brief Write to an option's bound argument variable.
+     * @brief Format the help text.
      *
-     * The argument will be converted to the appropriate type. If it
-     * cannot be converted, an exception is raised. If no variable was
-     * bound to the option, then nothing is done.
+     * See `print_help` for the meaning of the parameters.
      *
-     * @param entry Object holding parsed result information for the
-     *              option, including the argument to assign.
+     * @param text String to append the help text to.
      */
-    void write_option_argument(const parsed_entry& entry) const;
+    void format_help(std::string& text,
+                     int max_line_length,
+                     int group_indent,
+                     int option_indent,
+                     int desc_first_line_indent,
+                     int desc_multiline_indent) const;
 
     /**
-     * @brief Represents the type of a command-line argument.
+     * @brief Mark the option indexes and the cached help text as out
+     *        of date.
      */
-    enum class cl_arg_type { non_option, //< If the argument is not an option.
-                             end_indicator, //< If the argument is an end-of-options marker.
-                             arg_required, //< If the argument ends with an option that needs a mandatory argument.
-                             arg_optional, //< If the argument ends with an option that can take an optional argument.
-                             no_arg //< If the argument ends with an option that does not take an argument (or an argument was already given).
-    };
-
-    /**
-     * @brief Parse a command-line argument.
-     * @param argument Argument to parse.
-     * @param result Current `parser_result`. New entries will be added
-     *               to the end.
-     * @param type Will be set to the appropriate option type.
-     * @throw parse_error Thrown if option is invalid or missing a
-     *                    required argument.
-     * @see cl_arg_type
-     */
-    void parse_argument(const std::string& argument,
-                        parser_result& result, cl_arg_type& type) const;
+    void invalidate_index() noexcept {
+      m_log.changes.fetch_add(1, std::memory_order_release);
+      m_log.moved = true;
+    }
 
     /**
-     * @brief Parse a group of short options.
-     * @param short_names String of short option name characters to parse.
-     * @param argument Option argument that was provided, if any.
-     * @param has_arg Should be true if an argument was found (even an
-     *                empty one).
-     * @param result Current `parser_result`. New entries will be added
-     *               to the end.
-     * @param type Will be set to the appropriate option type.
-     * @throw parse_error Thrown if option is invalid or missing a
-     *                    required argument.
-     * @see cl_arg_type
+     * @brief Attach every group and option to this parser's change
+     *        log, and copy the option strings into this parser's
+     *        pool.
+     *
+     * Needed whenever groups are created, copied or moved into the
+     * parser.
      */
-    void parse_short_option_group(const std::string& short_names,
-                                  const std::string& argument, bool has_arg,
-                                  parser_result& result, cl_arg_type& type) const;
+    void track_groups() noexcept {
+      for (auto& g : m_groups) {
+        g.attach(&m_log);
+        g.adopt_text(0);
+      }
+    }
 
     group_container m_groups; //< The container of option groups.
 
@@ -520,6 +1175,17 @@ namespace optionpp {
     std::string m_long_option_prefix{"--"}; //< String that indicates a long option name.
     std::string m_end_of_options{"--"}; //< String that marks the end of the program options.
     std::string m_equals{"="}; //< String used to specify an explicit argument to an option.
+    std::string m_response_file_prefix; //< String that introduces a response file, or empty if disabled.
+    bool m_allow_abbreviations{false}; //< Whether long options can be given by a unique prefix.
+    bool m_suggestions_enabled{false}; //< Whether invalid long options are reported with suggestions.
+
+    change_tracker::change_log m_log; //< Changes made to the options since the indexes were built.
+    option_index m_lookup; //< Name index used by the non-`const` lookups.
+    mutable std::mutex m_cache_mutex; //< Guards `m_compiled` and `m_help_layouts` in `const` methods.
+    mutable compiled_parser m_compiled; //< View of the options used for parsing.
+    mutable std::atomic<unsigned long> m_compiled_changes{0}; //< Value of `m_log.changes` when `m_compiled` was built.
+    mutable std::vector<help_layout> m_help_layouts; //< Cached help text, oldest first.
+    mutable unsigned long m_help_changes{0}; //< Value of `m_log.changes` when `m_help_layouts` was filled.
   };
 
   /**
@@ -547,57 +1213,111 @@ namespace optionpp {
 // function, so we'll ask it to skip this part of the header
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
+template <typename ForwardIt>
+void optionpp::parser::add_options(ForwardIt first, ForwardIt last,
+                                   const std::string& group_name) {
+  name_checker checker{*this,
+      static_cast<std::size_t>(std::distance(first, last))};
+  for (ForwardIt it = first; it != last; ++it)
+    checker.add(*it);
+
+  group(group_name).add_options(first, last);
+}
+
 template <typename InputIt>
 optionpp::parser_result
 optionpp::parser::parse(InputIt first, InputIt last, bool ignore_first) const {
-  if (ignore_first && first != last)
-    ++first;
-
-  InputIt it{first};
-
-  parser_result result{};
-  cl_arg_type prev_type{cl_arg_type::non_option};
-  while (it != last) {
-    const std::string& arg{*it};
-
-    // If we are expecting a standalone option argument...
-    if (prev_type == cl_arg_type::arg_required
-        || prev_type == cl_arg_type::arg_optional) {
-      // ...then this token should be a non-option; but if the
-      // argument is required we'll interpret it that way regardless
-      if (is_non_option(arg)
-          || prev_type == cl_arg_type::arg_required) {
-        auto& arg_info = result.back();
-        arg_info.argument = arg;
-        arg_info.original_text.push_back(' ');
-        arg_info.original_text += arg;
-        prev_type = cl_arg_type::non_option;
-        if (arg_info.opt_info)
-          write_option_argument(arg_info);
-      } else { // Found an option, reset type and continue
-        prev_type = cl_arg_type::non_option;
-        continue; // Continue without incrementing 'it' in order to reevaluate current token
-      }
-    } else if (prev_type == cl_arg_type::end_indicator) { // Ignore options
-      parsed_entry arg_info;
-      arg_info.original_text = arg;
-      arg_info.is_option = false;
-      result.push_back(std::move(arg_info));
-    } else { // Regular argument
-      parse_argument(arg, result, prev_type);
-    }
+  return compiled().parse(first, last, ignore_first);
+}
+
+template <typename InputIt>
+void optionpp::parser::parse_into(parser_result& result, InputIt first,
+                                  InputIt last, bool ignore_first) const {
+  compiled().parse_into(result, first, last, ignore_first);
+}
+
+template <typename InputIt>
+void optionpp::parser::parse_into(parser_result& result, InputIt first,
+                                  InputIt last, parse_status& status,
+                                  bool ignore_first) const {
+  compiled().parse_into(result, first, last, status, ignore_first);
+}
 
-    ++it;
-  }
+template <typename InputIt>
+void optionpp::parser::parse_into(parser_result& result, InputIt first,
+                                  InputIt last, const parse_target& target,
+                                  parse_status& status,
+                                  bool ignore_first) const {
+  compiled().parse_into(result, first, last, target, status, ignore_first);
+}
+
+template <typename InputIt>
+InputIt optionpp::parser::parse_leading_options(parser_result& result,
+                                                InputIt first, InputIt last,
+                                                bool ignore_first) const {
+  return compiled().parse_leading_options(result, first, last, ignore_first);
+}
+
+template <typename InputIt>
+InputIt optionpp::parser::parse_leading_options(parser_result& result,
+                                                InputIt first, InputIt last,
+                                                parse_status& status,
+                                                bool ignore_first) const {
+  return compiled().parse_leading_options(result, first, last, status,
+                                          ignore_first);
+}
+
+template <typename InputIt>
+optionpp::parser_result_ref
+optionpp::parser::parse_ref(InputIt first, InputIt last, bool ignore_first) const {
+  return compiled().parse_ref(first, last, ignore_first);
+}
 
-  // Make sure we don't still need a mandatory argument
-  if (prev_type == cl_arg_type::arg_required) {
-    const auto& opt_name = result.back().original_text;
-    throw parse_error{"option '" + opt_name + "' requires an argument",
-        "optionpp::parser::parse", opt_name};
-  }
+template <typename InputIt>
+bool optionpp::parser::visit(InputIt first, InputIt last,
+                             const compiled_parser::option_handler& on_option,
+                             const compiled_parser::non_option_handler& on_non_option,
+                             parse_status& status, bool ignore_first) const {
+  return compiled().visit(first, last, on_option, on_non_option, status,
+                          ignore_first);
+}
+
+template <typename InputIt>
+optionpp::batch_result
+optionpp::parser::parse_batch(InputIt first, InputIt last,
+                              bool ignore_first) const {
+  return compiled().parse_batch(first, last, ignore_first);
+}
+
+template <typename ForwardIt>
+optionpp::batch_result
+optionpp::parser::parse_batch(ForwardIt first, ForwardIt last,
+                              const compiled_parser::executor_type& executor,
+                              compiled_parser::size_type lines_per_task,
+                              bool ignore_first) const {
+  return compiled().parse_batch(first, last, executor, lines_per_task,
+                                ignore_first);
+}
+
+template <typename ForwardIt>
+optionpp::parser_result
+optionpp::parser::parse_parallel(ForwardIt first, ForwardIt last,
+                                 const compiled_parser::executor_type& executor,
+                                 compiled_parser::size_type args_per_task,
+                                 bool ignore_first) const {
+  return compiled().parse_parallel(first, last, executor, args_per_task,
+                                   ignore_first);
+}
 
-  return result;
+template <typename ForwardIt>
+void optionpp::parser::parse_parallel_into(parser_result& result,
+                                           ForwardIt first, ForwardIt last,
+                                           const compiled_parser::executor_type& executor,
+                                           parse_status& status,
+                                           compiled_parser::size_type args_per_task,
+                                           bool ignore_first) const {
+  compiled().parse_parallel_into(result, first, last, executor, status,
+                                 args_per_task, ignore_first);
 }
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
@@ -25,14 +25,17 @@
 #ifndef OPTIONPP_PARSER_RESULT_HPP
 #define OPTIONPP_PARSER_RESULT_HPP
 
+#include <atomic>
 #include <cstddef>
 #include <initializer_list>
 #include <iterator>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 #include <optionpp/error.hpp>
 #include <optionpp/option.hpp>
+#include <optionpp/option_index.hpp>
 
 namespace optionpp {
 
@@ -148,6 +151,21 @@ namespace optionpp {
    * then the corresponding `parser_result` would hold seven data
    * entries: `-a`, `-f`, `-n`, `file1.txt`, `file2.txt`, `--verbose`,
    * `file3.txt`, in that order.
+   *
+   * As entries are added, the `parser_result` groups them by option,
+   * so that `is_option_set`, `get_argument`, `count` and
+   * `occurrences` take constant time no matter how many entries
+   * there are. Entries are grouped by the `option` that their
+   * `opt_info` field points to; entries without one, such as those
+   * made by hand, belong to the option whose long name (or, failing
+   * that, short name) they share with an earlier entry.
+   *
+   * Any non-const accessor (`begin`, `operator[]`, `back` and so on)
+   * marks the grouping as out of date, since the entries might be
+   * changed through it, and the next query rebuilds it; iterate over
+   * a `const parser_result&` to avoid this. Queries on a
+   * `parser_result` that is not being modified may be made from
+   * several threads at once.
    */
   class parser_result {
   public:
@@ -182,6 +200,144 @@ namespace optionpp {
      */
     using const_reverse_iterator = container_type::const_reverse_iterator;
 
+    /**
+     * @brief Sequence of the entries for a single option.
+     *
+     * Returned by `occurrences`. The entries are visited in the order
+     * in which they appear in the `parser_result`. The list refers to
+     * the `parser_result` and is invalidated by any change to it.
+     */
+    class occurrence_list {
+    public:
+
+      /**
+       * @brief Forward iterator over the entries.
+       */
+      class const_iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag; //< Iterator category.
+        using value_type = parsed_entry; //< Type of entry.
+        using difference_type = std::ptrdiff_t; //< Difference type.
+        using pointer = const parsed_entry*; //< Pointer to entry.
+        using reference = const parsed_entry&; //< Reference to entry.
+
+        /**
+         * @brief Default constructor.
+         *
+         * Constructs an end iterator.
+         */
+        const_iterator() noexcept {}
+
+        /**
+         * @brief Dereference operator.
+         * @return Reference to the current entry.
+         */
+        reference operator*() const noexcept { return (*m_result)[m_index]; }
+        /**
+         * @brief Member access operator.
+         * @return Pointer to the current entry.
+         */
+        pointer operator->() const noexcept { return &**this; }
+
+        /**
+         * @brief Prefix increment operator.
+         * @return Reference to the current instance.
+         */
+        const_iterator& operator++() noexcept {
+          m_index = m_result->m_index.links[m_index];
+          return *this;
+        }
+        /**
+         * @brief Postfix increment operator.
+         * @return Copy of the iterator before it was incremented.
+         */
+        const_iterator operator++(int) noexcept {
+          const_iterator temp{*this};
+          ++*this;
+          return temp;
+        }
+
+        /**
+         * @brief Equality operator.
+         * @param other Iterator to compare with.
+         * @return True if both iterators point to the same entry.
+         */
+        bool operator==(const const_iterator& other) const noexcept {
+          return m_index == other.m_index;
+        }
+        /**
+         * @brief Inequality operator.
+         * @param other Iterator to compare with.
+         * @return True if the iterators point to different entries.
+         */
+        bool operator!=(const const_iterator& other) const noexcept {
+          return !(*this == other);
+        }
+
+      private:
+        friend class occurrence_list;
+
+        /**
+         * @brief Constructor.
+         * @param result The `parser_result` holding the entries.
+         * @param index Index of the current entry.
+         */
+        const_iterator(const parser_result* result, size_type index) noexcept
+          : m_result{result}, m_index{index} {}
+
+        const parser_result* m_result{nullptr}; //< The `parser_result`.
+        size_type m_index{npos}; //< Index of the current entry.
+      };
+
+      /**
+       * @brief Default constructor.
+       *
+       * Constructs an empty list.
+       */
+      occurrence_list() noexcept {}
+
+      /**
+       * @brief Return an iterator to the first entry.
+       * @return Iterator pointing to the first entry.
+       */
+      const_iterator begin() const noexcept {
+        return const_iterator{m_result, m_first};
+      }
+      /**
+       * @brief Return an iterator to one past the last entry.
+       * @return End iterator.
+       */
+      const_iterator end() const noexcept { return const_iterator{}; }
+
+      /**
+       * @brief Return the number of entries.
+       * @return Number of times the option occurred.
+       */
+      size_type size() const noexcept { return m_size; }
+      /**
+       * @brief Return whether the list is empty.
+       * @return True if the option did not occur.
+       */
+      bool empty() const noexcept { return m_size == 0; }
+
+    private:
+      friend class parser_result;
+
+      /**
+       * @brief Constructor.
+       * @param result The `parser_result` holding the entries.
+       * @param first Index of the first entry.
+       * @param size Number of entries.
+       */
+      occurrence_list(const parser_result* result, size_type first,
+                      size_type size) noexcept
+        : m_result{result}, m_first{first}, m_size{size} {}
+
+      const parser_result* m_result{nullptr}; //< The `parser_result`.
+      size_type m_first{npos}; //< Index of the first entry.
+      size_type m_size{0}; //< Number of entries.
+    };
+
     /**
      * @brief Default constructor.
      *
@@ -193,7 +349,7 @@ namespace optionpp {
      * @param il The `initializer_list` holding the parsed data.
      */
     parser_result(const std::initializer_list<value_type>& il)
-      : m_entries{il} {}
+      : m_entries{il}, m_size{m_entries.size()} { rebuild_index(); }
     /**
      * @brief Construct from a sequence.
      * @tparam InputIt The type of iterator (usually deduced).
@@ -201,22 +357,100 @@ namespace optionpp {
      * @param last Iterator pointing to one past the end of the sequence.
      */
     template <typename InputIt>
-    parser_result(InputIt first, InputIt last) : m_entries{first, last} {}
+    parser_result(InputIt first, InputIt last)
+      : m_entries{first, last}, m_size{m_entries.size()} { rebuild_index(); }
+
+    /**
+     * @brief Copy constructor.
+     *
+     * Only the current entries are copied, not the storage kept for
+     * reuse.
+     *
+     * @param other The `parser_result` to copy.
+     */
+    parser_result(const parser_result& other)
+      : m_entries{other.begin(), other.end()}, m_size{other.m_size} {
+      rebuild_index();
+    }
+    /**
+     * @brief Move constructor.
+     * @param other The `parser_result` to move from.
+     */
+    parser_result(parser_result&& other) noexcept
+      : m_entries{std::move(other.m_entries)}, m_size{other.m_size},
+        m_index{std::move(other.m_index)},
+        m_pending{other.m_pending.load(std::memory_order_relaxed)} {
+      other.m_entries.clear();
+      other.m_size = 0;
+      other.m_index.clear();
+      other.m_pending.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     *
+     * Storage kept from earlier entries is reused.
+     *
+     * @param other The `parser_result` to copy.
+     * @return Reference to the current instance.
+     */
+    parser_result& operator=(const parser_result& other);
+    /**
+     * @brief Move assignment operator.
+     * @param other The `parser_result` to move from.
+     * @return Reference to the current instance.
+     */
+    parser_result& operator=(parser_result&& other) noexcept;
 
     /**
      * @brief Add a `parsed_entry` to the back of the container.
+     *
+     * If an entry was erased by `clear`, its storage is reused, so
+     * that the strings of the new entry are copied into buffers that
+     * already exist.
+     *
      * @param entry The parsed data entry to add.
      */
-    void push_back(const value_type& entry) { m_entries.push_back(entry); }
+    void push_back(const value_type& entry) {
+      next_entry() = entry;
+      if (!m_index.stale)
+        index_entry(m_size - 1);
+    }
     /**
      * @copydoc push_back
      */
-    void push_back(value_type&& entry) { m_entries.push_back(std::move(entry)); }
+    void push_back(value_type&& entry) {
+      next_entry() = std::move(entry);
+      if (!m_index.stale)
+        index_entry(m_size - 1);
+    }
 
     /**
      * @brief Erase all data entries currently stored.
+     *
+     * The erased entries, along with their strings, are kept so that
+     * later calls to `push_back` (and `parser::parse_into`) can reuse
+     * their memory. Use `shrink_to_fit` to free it.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Reserve room for a number of entries.
+     * @param count Number of entries to reserve room for.
      */
-    void clear() noexcept { m_entries.clear(); }
+    void reserve(size_type count) {
+      m_entries.reserve(count);
+      m_index.links.reserve(count);
+    }
+
+    /**
+     * @brief Free the storage kept for reuse by `clear`.
+     */
+    void shrink_to_fit() {
+      m_entries.erase(m_entries.begin() + m_size, m_entries.end());
+      m_entries.shrink_to_fit();
+      m_index.links.shrink_to_fit();
+    }
 
     /**
      * @brief Return the number of data entries.
@@ -227,18 +461,21 @@ namespace optionpp {
      * @return The number of option and non-option argument data
      *         entries.
      */
-    size_type size() const noexcept { return m_entries.size(); }
+    size_type size() const noexcept { return m_size; }
     /**
      * @brief Return whether the container is empty.
      * @return True if the entry container is empty, false otherwise.
      */
-    bool empty() const noexcept { return m_entries.empty(); }
+    bool empty() const noexcept { return m_size == 0; }
 
     /**
      * @brief Return an `iterator` to the beginning of the container.
      * @return An `iterator` pointing to the first entry.
      */
-    iterator begin() noexcept { return m_entries.begin(); }
+    iterator begin() noexcept {
+      mark_stale();
+      return m_entries.begin();
+    }
     /**
      * @copydoc cbegin
      */
@@ -247,7 +484,7 @@ namespace optionpp {
      * @brief Return an `iterator` to the end of the container.
      * @return An `iterator` pointing to one past the last entry.
      */
-    iterator end() noexcept { return m_entries.end(); }
+    iterator end() noexcept { return begin() + m_size; }
     /**
      * @copydoc cend
      */
@@ -262,14 +499,14 @@ namespace optionpp {
      * @brief Return a `const_iterator` to the end of the container.
      * @return A `const_iterator` pointing to one past the last entry.
      */
-    const_iterator cend() const noexcept { return m_entries.cend(); }
+    const_iterator cend() const noexcept { return cbegin() + m_size; }
 
     /**
      * @brief Return a `reverse_iterator` to the beginning.
      * @return A `reverse_iterator` pointing to the first entry in the
      *         reversed sequence.
      */
-    reverse_iterator rbegin() noexcept { return m_entries.rbegin(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
     /**
      * @copydoc crbegin
      */
@@ -279,7 +516,10 @@ namespace optionpp {
      * @return A `reverse_iterator` pointing to one past the last
      *         entry in the reversed sequence.
      */
-    reverse_iterator rend() noexcept { return m_entries.rend(); }
+    reverse_iterator rend() noexcept {
+      mark_stale();
+      return m_entries.rend();
+    }
     /**
      * @copydoc crend
      */
@@ -290,7 +530,9 @@ namespace optionpp {
      * @return A `const_reverse_iterator` pointing to the first entry
      *         in the reversed sequence.
      */
-    const_reverse_iterator crbegin() const noexcept { return m_entries.crbegin(); }
+    const_reverse_iterator crbegin() const noexcept {
+      return const_reverse_iterator{cend()};
+    }
     /**
      * @brief Return a `const_reverse_iterator` to the end.
      * @return A `const_reverse_iterator` pointing to one past the last
@@ -325,7 +567,10 @@ namespace optionpp {
      * @param index The index of the data entry to return.
      * @return The `parsed_entry` corresponding to the `index`.
      */
-    value_type& operator[](size_type index) { return m_entries[index]; }
+    value_type& operator[](size_type index) {
+      mark_stale();
+      return m_entries[index];
+    }
     /**
      * @copydoc operator[]
      */
@@ -342,7 +587,8 @@ namespace optionpp {
       if (empty())
         throw out_of_range("out of bounds parser_result access",
                            "optionpp::parser_result::back");
-      return m_entries.back();
+      mark_stale();
+      return m_entries[m_size - 1];
     }
 
     /**
@@ -352,7 +598,7 @@ namespace optionpp {
       if (empty())
         throw out_of_range("out of bounds parser_result access",
                            "optionpp::parser_result::at");
-      return m_entries.back();
+      return m_entries[m_size - 1];
     }
 
     /**
@@ -361,14 +607,93 @@ namespace optionpp {
      * @return True if the option was present on the command-line,
      *         and false otherwise.
      */
-    bool is_option_set(const std::string& long_name) const noexcept;
+    bool is_option_set(const std::string& long_name) const {
+      return find_record(long_name) != nullptr;
+    }
     /**
      * @brief Returns whether the specified option is set.
      * @param short_name The short name for the option.
      * @return True if the option was present on the command-line,
      *         and false otherwise.
      */
-    bool is_option_set(char short_name) const noexcept;
+    bool is_option_set(char short_name) const {
+      return find_record(short_name) != nullptr;
+    }
+    /**
+     * @brief Returns whether the specified option is set.
+     *
+     * Only entries whose `opt_info` field points to `opt` are
+     * considered, so `opt` must be the `option` held by the `parser`
+     * or `compiled_parser` that produced the entries.
+     *
+     * @param opt The option.
+     * @return True if the option was present on the command-line,
+     *         and false otherwise.
+     */
+    bool is_option_set(const option& opt) const {
+      return find_record(opt) != nullptr;
+    }
+
+    /**
+     * @brief Return the number of times an option was given.
+     * @param long_name The long name for the option.
+     * @return Number of entries for the option.
+     */
+    size_type count(const std::string& long_name) const {
+      const option_record* r = find_record(long_name);
+      return r ? r->count : 0;
+    }
+    /**
+     * @brief Return the number of times an option was given.
+     * @param short_name The short name for the option.
+     * @return Number of entries for the option.
+     */
+    size_type count(char short_name) const {
+      const option_record* r = find_record(short_name);
+      return r ? r->count : 0;
+    }
+    /**
+     * @brief Return the number of times an option was given.
+     *
+     * See `is_option_set(const option&) const` for which entries are
+     * counted.
+     *
+     * @param opt The option.
+     * @return Number of entries for the option.
+     */
+    size_type count(const option& opt) const {
+      const option_record* r = find_record(opt);
+      return r ? r->count : 0;
+    }
+
+    /**
+     * @brief Return all entries for an option.
+     * @param long_name The long name for the option.
+     * @return List of the entries, in order.
+     */
+    occurrence_list occurrences(const std::string& long_name) const {
+      return make_occurrences(find_record(long_name));
+    }
+    /**
+     * @brief Return all entries for an option.
+     * @param short_name The short name for the option.
+     * @return List of the entries, in order.
+     */
+    occurrence_list occurrences(char short_name) const {
+      return make_occurrences(find_record(short_name));
+    }
+    /**
+     * @brief Return all entries for an option.
+     *
+     * See `is_option_set(const option&) const` for which entries are
+     * included.
+     *
+     * @param opt The option.
+     * @return List of the entries, in order.
+     */
+    occurrence_list occurrences(const option& opt) const {
+      return make_occurrences(find_record(opt));
+    }
 
     /**
      * @brief Get the argument for the specified option.
@@ -377,9 +702,12 @@ namespace optionpp {
      * multiple arguments were given, the last is returned.
      *
      * @param long_name The long name for the option.
-     * @return The argument given to the option.
+     * @return The argument given to the option. The reference is
+     *         valid until the `parser_result` is changed.
      */
-    std::string get_argument(std::string long_name) const noexcept;
+    const std::string& get_argument(const std::string& long_name) const {
+      return last_argument(find_record(long_name));
+    }
     /**
      * @brief Get the argument for the specified option.
      *
@@ -387,12 +715,197 @@ namespace optionpp {
      * multiple arguments were given, the last is returned.
      *
      * @param short_name The short name for the option.
-     * @return The argument given to the option.
+     * @return The argument given to the option. The reference is
+     *         valid until the `parser_result` is changed.
+     */
+    const std::string& get_argument(char short_name) const {
+      return last_argument(find_record(short_name));
+    }
+    /**
+     * @brief Get the argument for the specified option.
+     *
+     * See `is_option_set(const option&) const` for which entries are
+     * considered.
+     *
+     * @param opt The option.
+     * @return The argument given to the option. The reference is
+     *         valid until the `parser_result` is changed.
      */
-    std::string get_argument(char short_name) const noexcept;
+    const std::string& get_argument(const option& opt) const {
+      return last_argument(find_record(opt));
+    }
 
   private:
+    friend class compiled_parser;
+
+    /**
+     * @brief Append an entry, reusing erased storage if possible.
+     *
+     * The fields of the returned entry are left over from an erased
+     * entry (or default-constructed), so the caller must assign all
+     * of them.
+     *
+     * @return Reference to the new last entry.
+     */
+    value_type& next_entry() {
+      if (m_size == m_entries.size())
+        m_entries.emplace_back();
+      return m_entries[m_size++];
+    }
+
+    /**
+     * @brief Value used for "no entry".
+     */
+    static const size_type npos = static_cast<size_type>(-1);
+
+    /**
+     * @brief The entries for one option.
+     */
+    struct option_record {
+      const option* opt_info; //< The option, or `nullptr` if it is known only by name.
+      size_type first; //< Index of the first entry.
+      size_type last; //< Index of the last entry.
+      size_type count; //< Number of entries.
+    };
+
+    /**
+     * @brief Name table entry.
+     */
+    struct name_slot {
+      std::size_t hash; //< Hash of the name.
+      size_type record; //< Position of the option record, or `npos` if the slot is free.
+      size_type entry; //< Index of an entry holding the name.
+      char short_name; //< Short name, or a null character for a long name.
+    };
+
+    /**
+     * @brief Grouping of the entries by option.
+     */
+    struct index_data {
+      /**
+       * @brief Remove all records, keeping the memory.
+       */
+      void clear() noexcept;
+
+      std::vector<option_record> records; //< One record for each option, in order of first occurrence.
+      std::vector<size_type> by_option; //< Open-addressed table from `opt_info` to record position.
+      std::vector<name_slot> by_name; //< Open-addressed table from option names to record position.
+      size_type name_count{0}; //< Number of occupied slots in `by_name`.
+      std::vector<size_type> links; //< Index of the next entry for the same option, one for each entry.
+      size_type named_records{0}; //< Number of records whose names are in `by_name`.
+      bool stale{false}; //< Whether the entries might have changed since they were indexed.
+    };
+
+    /**
+     * @brief Mark the index as out of date.
+     */
+    void mark_stale() noexcept {
+      m_index.stale = true;
+      m_pending.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Return the index, first rebuilding it if it is out of
+     *        date and adding any names it is missing.
+     * @return The current index.
+     */
+    const index_data& current_index() const;
+
+    /**
+     * @brief Add the names of the records that were added without
+     *        them.
+     */
+    void name_records() const;
+
+    /**
+     * @brief Rebuild the index from all entries.
+     */
+    void rebuild_index() const;
+
+    /**
+     * @brief Add the entry at the given position to the index.
+     * @param index Position of the entry (must be the last entry).
+     */
+    void index_entry(size_type index) const;
+
+    /**
+     * @brief Find the name table slot for a name, or the free slot
+     *        where it belongs.
+     * @param hash Hash of the name.
+     * @param long_name The long name, if `short_name` is null.
+     * @param short_name The short name, or a null character.
+     * @return Position of the slot, or `npos` if the table is empty.
+     */
+    size_type probe_name(std::size_t hash, const std::string* long_name,
+                         char short_name) const noexcept;
+
+    /**
+     * @brief Add a name to the name table unless it is already there.
+     * @param hash Hash of the name.
+     * @param index Index of the entry holding the name.
+     * @param short_name The short name, or a null character for the
+     *                   long name of the entry.
+     * @param record Position of the option record.
+     */
+    void insert_name(std::size_t hash, size_type index, char short_name,
+                     size_type record) const;
+
+    /**
+     * @brief Find the record for an option, or the free slot where it
+     *        belongs.
+     * @param opt The option.
+     * @return Position of the slot in `by_option`, or `npos` if the
+     *         table is empty.
+     */
+    size_type probe_option(const option* opt) const noexcept;
+
+    /**
+     * @brief Add a record to the option table.
+     * @param record Position of the record, which must have an
+     *               option.
+     */
+    void insert_option(size_type record) const;
+
+    /**
+     * @brief Look up a long name.
+     * @param long_name The long name.
+     * @return Pointer to the record, or `nullptr` if the option is not set.
+     */
+    const option_record* find_record(const std::string& long_name) const;
+    /**
+     * @brief Look up a short name.
+     * @param short_name The short name.
+     * @return Pointer to the record, or `nullptr` if the option is not set.
+     */
+    const option_record* find_record(char short_name) const;
+    /**
+     * @brief Look up an option.
+     * @param opt The option.
+     * @return Pointer to the record, or `nullptr` if the option is not set.
+     */
+    const option_record* find_record(const option& opt) const;
+
+    /**
+     * @brief Return the entries of a record.
+     * @param r The record, or `nullptr`.
+     * @return List of the entries.
+     */
+    occurrence_list make_occurrences(const option_record* r) const noexcept {
+      return r ? occurrence_list{this, r->first, r->count} : occurrence_list{};
+    }
+
+    /**
+     * @brief Return the argument of the last entry of a record.
+     * @param r The record, or `nullptr`.
+     * @return The argument, or an empty string.
+     */
+    const std::string& last_argument(const option_record* r) const noexcept;
+
     container_type m_entries; //< The internal container of `parsed_entry` instances.
+    size_type m_size{0}; //< Number of entries in use (the rest are kept for reuse).
+    mutable index_data m_index; //< Entries grouped by option.
+    mutable std::atomic<bool> m_pending{false}; //< Whether the index must be updated before a query.
+    mutable std::mutex m_index_mutex; //< Serializes updates of the index by queries.
   };
 
 } // End namespace
@@ -0,0 +1,330 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `parser_result_ref` class.
+ */
+
+#ifndef OPTIONPP_PARSER_RESULT_REF_HPP
+#define OPTIONPP_PARSER_RESULT_REF_HPP
+
+#include <vector>
+#include <optionpp/error.hpp>
+#include <optionpp/option.hpp>
+#include <optionpp/parser_result.hpp>
+#include <optionpp/string_ref.hpp>
+#include <optionpp/text_arena.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Lightweight version of `parsed_entry` that does not own
+   *        its strings.
+   *
+   * The fields have the same meaning as in `parsed_entry`, but each
+   * string is a `string_ref` pointing into the parsed arguments, into
+   * the option table, or into storage owned by the
+   * `parser_result_ref` that holds the entry.
+   */
+  struct parsed_entry_ref {
+    /**
+     * @brief The original text used on the command line.
+     * @see parsed_entry::original_text
+     */
+    string_ref original_text;
+
+    /**
+     * @brief The original text used on the command line but without
+     * any option argument.
+     * @see parsed_entry::original_without_argument
+     */
+    string_ref original_without_argument;
+
+    /**
+     * @brief True if this entry represents a program option, false
+     * otherwise.
+     */
+    bool is_option{false};
+
+    /**
+     * @brief The long name of the option, referring to the name
+     * stored in the `option` itself.
+     *
+     * If `is_option` is false, this is empty.
+     */
+    string_ref long_name;
+
+    /**
+     * @brief The short name of the option, or a null character if
+     * `is_option` is false.
+     */
+    char short_name{'\0'};
+
+    /**
+     * @brief The argument that was passed to the option, if any.
+     */
+    string_ref argument;
+
+    /**
+     * @brief Pointer to the `option` instance representing this
+     * option, if any.
+     */
+    const option* opt_info{nullptr};
+
+    /**
+     * @brief Make an owning copy of the entry.
+     * @return `parsed_entry` holding copies of all the strings.
+     */
+    parsed_entry to_entry() const;
+  };
+
+  /**
+   * @brief Holds parsed command-line data without copying it.
+   *
+   * This is the result type of the `parse_ref` methods of `parser`
+   * and `compiled_parser`. It works like `parser_result`, but its
+   * entries are `parsed_entry_ref` instances whose strings point
+   * directly into the arguments that were parsed whenever possible.
+   * Text that does not appear verbatim in the arguments (for example
+   * `-b` from the short option group `-abc`) is stored in a single
+   * `text_arena` owned by the result, so parsing a typical command
+   * line makes almost no allocations.
+   *
+   * As a consequence, a `parser_result_ref` is only valid as long as
+   * the parsed arguments are, and as long as the options of the
+   * parser that produced it are left unchanged.
+   *
+   * A `parser_result_ref` can be moved but not copied; use
+   * `to_result` to get an independent copy.
+   */
+  class parser_result_ref {
+  public:
+
+    /**
+     * @brief Type used for storing argument data.
+     */
+    using value_type = parsed_entry_ref;
+    /**
+     * @brief Type of container used to store the data entries.
+     */
+    using container_type = std::vector<value_type>;
+    /**
+     * @brief Unsigned integer type that can hold the container size.
+     */
+    using size_type = container_type::size_type;
+    /**
+     * @brief Plain iterator type.
+     */
+    using iterator = container_type::iterator;
+    /**
+     * @brief Constant iterator type.
+     */
+    using const_iterator = container_type::const_iterator;
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an empty result.
+     */
+    parser_result_ref() noexcept {}
+
+    parser_result_ref(const parser_result_ref&) = delete;
+    parser_result_ref& operator=(const parser_result_ref&) = delete;
+
+    /**
+     * @brief Move constructor.
+     * @param other The result to move from.
+     */
+    parser_result_ref(parser_result_ref&& other) noexcept = default;
+    /**
+     * @brief Move assignment operator.
+     * @param other The result to move from.
+     * @return Reference to the current instance.
+     */
+    parser_result_ref& operator=(parser_result_ref&& other) noexcept = default;
+
+    /**
+     * @brief Add an entry to the back of the container.
+     *
+     * The entry's strings are not copied. Use `store` first for any
+     * text that might not outlive the result.
+     *
+     * @param entry The entry to add.
+     */
+    void push_back(const value_type& entry) { m_entries.push_back(entry); }
+
+    /**
+     * @brief Copy text into storage owned by the result.
+     * @param str The text to copy.
+     * @return Reference to the stored copy, valid until the result is
+     *         cleared or destroyed.
+     */
+    string_ref store(string_ref str) { return m_text.store(str); }
+    /**
+     * @brief Copy the concatenation of several strings into storage
+     *        owned by the result.
+     * @param a First string.
+     * @param b Second string.
+     * @param c Third string, if any.
+     * @return Reference to the stored text, valid until the result is
+     *         cleared or destroyed.
+     */
+    string_ref store(string_ref a, string_ref b, string_ref c = string_ref{}) {
+      return m_text.store(a, b, c);
+    }
+
+    /**
+     * @brief Erase all entries and stored text.
+     *
+     * Memory is kept for reuse.
+     */
+    void clear() noexcept {
+      m_entries.clear();
+      m_text.clear();
+    }
+
+    /**
+     * @brief Return the number of entries.
+     * @return The number of option and non-option argument entries.
+     */
+    size_type size() const noexcept { return m_entries.size(); }
+    /**
+     * @brief Return whether the container is empty.
+     * @return True if there are no entries.
+     */
+    bool empty() const noexcept { return m_entries.empty(); }
+
+    /**
+     * @brief Return an `iterator` to the first entry.
+     * @return An `iterator` pointing to the first entry.
+     */
+    iterator begin() noexcept { return m_entries.begin(); }
+    /**
+     * @copydoc cbegin
+     */
+    const_iterator begin() const noexcept { return cbegin(); }
+    /**
+     * @brief Return an `iterator` to one past the last entry.
+     * @return An `iterator` pointing to one past the last entry.
+     */
+    iterator end() noexcept { return m_entries.end(); }
+    /**
+     * @copydoc cend
+     */
+    const_iterator end() const noexcept { return cend(); }
+    /**
+     * @brief Return a `const_iterator` to the first entry.
+     * @return A `const_iterator` pointing to the first entry.
+     */
+    const_iterator cbegin() const noexcept { return m_entries.cbegin(); }
+    /**
+     * @brief Return a `const_iterator` to one past the last entry.
+     * @return A `const_iterator` pointing to one past the last entry.
+     */
+    const_iterator cend() const noexcept { return m_entries.cend(); }
+
+    /**
+     * @brief Range-checked subscript.
+     * @param index The index of the entry to return.
+     * @return The entry corresponding to the `index`.
+     * @throw out_of_range Thrown if `index >= size()`.
+     */
+    const value_type& at(size_type index) const {
+      if (index >= size())
+        throw out_of_range("out of bounds parser_result_ref access",
+                           "optionpp::parser_result_ref::at");
+      return m_entries[index];
+    }
+
+    /**
+     * @brief Subscript operator.
+     * @param index The index of the entry to return.
+     * @return The entry corresponding to the `index`.
+     */
+    value_type& operator[](size_type index) { return m_entries[index]; }
+    /**
+     * @copydoc operator[]
+     */
+    const value_type& operator[](size_type index) const {
+      return m_entries[index];
+    }
+
+    /**
+     * @brief Access the last entry.
+     * @throw out_of_range If container is empty.
+     * @return Reference to last entry.
+     */
+    value_type& back() {
+      if (empty())
+        throw out_of_range("out of bounds parser_result_ref access",
+                           "optionpp::parser_result_ref::back");
+      return m_entries.back();
+    }
+
+    /**
+     * @brief Returns whether the specified option is set.
+     * @param long_name The long name for the option.
+     * @return True if the option was present on the command-line,
+     *         and false otherwise.
+     */
+    bool is_option_set(string_ref long_name) const noexcept;
+    /**
+     * @brief Returns whether the specified option is set.
+     * @param short_name The short name for the option.
+     * @return True if the option was present on the command-line,
+     *         and false otherwise.
+     */
+    bool is_option_set(char short_name) const noexcept;
+
+    /**
+     * @brief Get the argument for the specified option.
+     *
+     * If no argument was given, an empty reference is returned. If
+     * multiple arguments were given, the last is returned.
+     *
+     * @param long_name The long name for the option.
+     * @return The argument given to the option.
+     */
+    string_ref get_argument(string_ref long_name) const noexcept;
+    /**
+     * @brief Get the argument for the specified option.
+     *
+     * If no argument was given, an empty reference is returned. If
+     * multiple arguments were given, the last is returned.
+     *
+     * @param short_name The short name for the option.
+     * @return The argument given to the option.
+     */
+    string_ref get_argument(char short_name) const noexcept;
+
+    /**
+     * @brief Make an owning copy of the result.
+     * @return `parser_result` holding copies of all the entries.
+     */
+    parser_result to_result() const;
+
+  private:
+    container_type m_entries; //< The parsed entries.
+    text_arena m_text; //< Storage for text not found in the arguments.
+  };
+
+} // End namespace
+
+#endif
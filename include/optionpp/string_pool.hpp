@@ -0,0 +1,207 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `string_pool` class.
+ */
+
+#ifndef OPTIONPP_STRING_POOL_HPP
+#define OPTIONPP_STRING_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optionpp/string_ref.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Interned strings stored in one buffer.
+   *
+   * A `string_pool` keeps each distinct string once, in a single
+   * contiguous buffer, and identifies it by a small integer id. The
+   * ids are assigned consecutively from zero in the order in which
+   * the strings are first interned, so they can be used directly as
+   * indices into arrays kept alongside the pool.
+   *
+   * Each string is described by a fixed-size record holding its
+   * offset and length in the buffer, and the strings are found
+   * through an open-addressed hash table of ids. Storing many strings
+   * therefore takes a handful of allocations in total, and looking
+   * one up only touches these arrays.
+   *
+   * The `string_ref` returned by `get` refers to the buffer, which
+   * may move when a new string is interned.
+   */
+  class string_pool {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Integer type used for string ids.
+     */
+    using id_type = std::uint32_t;
+
+    /**
+     * @brief Id returned by `find` for strings not in the pool.
+     */
+    static constexpr id_type npos = static_cast<id_type>(-1);
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an empty pool.
+     */
+    string_pool() noexcept {}
+
+    /**
+     * @brief Remove all strings from the pool.
+     *
+     * The memory is kept for reuse.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Reserve room for strings.
+     * @param count Number of distinct strings to reserve room for.
+     * @param length Total number of characters in those strings.
+     */
+    void reserve(size_type count, size_type length = 0);
+
+    /**
+     * @brief Add a string to the pool, unless it is already there.
+     * @param str The string to add.
+     * @return Id of the string. A string equal to one interned
+     *         earlier gets the same id.
+     * @throw std::length_error If the pool would exceed the size that
+     *                          the records can address.
+     */
+    id_type intern(string_ref str) {
+      return intern(str, hash(str.data(), str.size()));
+    }
+    /**
+     * @brief Add a string whose hash is already known to the pool,
+     *        unless it is already there.
+     * @param str The string to add.
+     * @param h Hash of the string, as computed by `hash`.
+     * @return Id of the string. A string equal to one interned
+     *         earlier gets the same id.
+     * @throw std::length_error If the pool would exceed the size that
+     *                          the records can address.
+     */
+    id_type intern(string_ref str, std::uint32_t h);
+
+    /**
+     * @brief Look up a string.
+     * @param str The string to find.
+     * @return Id of the string, or `npos` if it has not been
+     *         interned.
+     */
+    id_type find(string_ref str) const noexcept {
+      return find(str, hash(str.data(), str.size()));
+    }
+    /**
+     * @brief Look up a string whose hash is already known.
+     * @param str The string to find.
+     * @param h Hash of the string, as computed by `hash`.
+     * @return Id of the string, or `npos` if it has not been
+     *         interned.
+     */
+    id_type find(string_ref str, std::uint32_t h) const noexcept;
+
+    /**
+     * @brief Get an interned string.
+     * @param id Id of the string (must be less than `size()`).
+     * @return Reference to the string in the pool.
+     */
+    string_ref get(id_type id) const noexcept {
+      const record& r = m_records[id];
+      return string_ref{m_text.data() + r.offset, r.length};
+    }
+
+    /**
+     * @brief Return the number of strings in the pool.
+     * @return Number of distinct strings.
+     */
+    size_type size() const noexcept { return m_records.size(); }
+    /**
+     * @brief Return whether the pool is empty.
+     * @return True if no strings have been interned.
+     */
+    bool empty() const noexcept { return m_records.empty(); }
+
+    /**
+     * @brief Return the total length of the strings in the pool.
+     * @return Number of characters in the buffer.
+     */
+    size_type text_size() const noexcept { return m_text.size(); }
+
+    /**
+     * @brief Compute the hash of a string.
+     * @param str Pointer to the first character of the string.
+     * @param length Number of characters in the string.
+     * @return Hash value.
+     */
+    static std::uint32_t hash(const char* str, size_type length) noexcept;
+
+  private:
+
+    /**
+     * @brief Location of a string in the buffer.
+     */
+    struct record {
+      std::uint32_t offset; //< Position of the first character.
+      std::uint32_t length; //< Number of characters.
+    };
+
+    /**
+     * @brief Entry in the hash table.
+     */
+    struct slot {
+      std::uint32_t hash; //< Hash of the string.
+      id_type id; //< Id of the string, or `npos` if the slot is free.
+    };
+
+    /**
+     * @brief Resize the hash table and reinsert all ids.
+     * @param slot_count New number of slots (must be a power of two).
+     */
+    void rehash(size_type slot_count);
+
+    /**
+     * @brief Place an id into the first free slot in its probe
+     *        sequence.
+     * @param entry Entry to place.
+     */
+    void place(const slot& entry) noexcept;
+
+    std::string m_text; //< All strings, one after another.
+    std::vector<record> m_records; //< Location of each string, by id.
+    std::vector<slot> m_slots; //< Open-addressed hash table of ids.
+  };
+
+} // End namespace
+
+#endif
@@ -0,0 +1,259 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `string_ref` class.
+ */
+
+#ifndef OPTIONPP_STRING_REF_HPP
+#define OPTIONPP_STRING_REF_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <iosfwd>
+#include <string>
+
+namespace optionpp {
+
+  /**
+   * @brief Non-owning reference to a sequence of characters.
+   *
+   * A `string_ref` stores a pointer and a length. It never allocates
+   * and never copies the characters it refers to, so the referenced
+   * string must outlive it. The referenced characters need not be
+   * null-terminated.
+   *
+   * `string_ref` can be implicitly constructed from a `std::string`
+   * or a null-terminated C string, so it can be passed wherever a
+   * read-only string argument is expected.
+   */
+  class string_ref {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes and positions.
+     */
+    using size_type = std::size_t;
+    /**
+     * @brief Iterator type.
+     */
+    using const_iterator = const char*;
+    /**
+     * @brief Iterator type (the same as `const_iterator`).
+     */
+    using iterator = const_iterator;
+
+    /**
+     * @brief Value returned by search functions when nothing is
+     *        found.
+     */
+    static const size_type npos = static_cast<size_type>(-1);
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an empty reference.
+     */
+    string_ref() noexcept : m_data{""}, m_size{0} {}
+    /**
+     * @brief Construct from a pointer and a length.
+     * @param str Pointer to the first character.
+     * @param length Number of characters.
+     */
+    string_ref(const char* str, size_type length) noexcept
+      : m_data{str}, m_size{length} {}
+    /**
+     * @brief Construct from a null-terminated string.
+     * @param str The string to refer to.
+     */
+    string_ref(const char* str) noexcept
+      : m_data{str}, m_size{std::strlen(str)} {}
+    /**
+     * @brief Construct from a `std::string`.
+     * @param str The string to refer to.
+     */
+    string_ref(const std::string& str) noexcept
+      : m_data{str.data()}, m_size{str.size()} {}
+
+    /**
+     * @brief Return a pointer to the first character.
+     * @return Pointer to the referenced characters (not necessarily
+     *         null-terminated).
+     */
+    const char* data() const noexcept { return m_data; }
+    /**
+     * @brief Return the number of characters.
+     * @return Length of the referenced string.
+     */
+    size_type size() const noexcept { return m_size; }
+    /**
+     * @copydoc size
+     */
+    size_type length() const noexcept { return m_size; }
+    /**
+     * @brief Return whether the reference is empty.
+     * @return True if `size() == 0`.
+     */
+    bool empty() const noexcept { return m_size == 0; }
+
+    /**
+     * @brief Return an iterator to the first character.
+     * @return Pointer to the first character.
+     */
+    const_iterator begin() const noexcept { return m_data; }
+    /**
+     * @brief Return an iterator to one past the last character.
+     * @return Pointer to one past the last character.
+     */
+    const_iterator end() const noexcept { return m_data + m_size; }
+
+    /**
+     * @brief Subscript operator.
+     * @param index Position of the character (must be less than
+     *              `size()`).
+     * @return The character at position `index`.
+     */
+    char operator[](size_type index) const noexcept { return m_data[index]; }
+
+    /**
+     * @brief Return a reference to part of the string.
+     *
+     * Out-of-range arguments are clamped to the end of the string.
+     *
+     * @param pos Position of the first character.
+     * @param count Maximum number of characters.
+     * @return Reference to the requested characters.
+     */
+    string_ref substr(size_type pos, size_type count = npos) const noexcept {
+      if (pos > m_size)
+        pos = m_size;
+      if (count > m_size - pos)
+        count = m_size - pos;
+      return string_ref{m_data + pos, count};
+    }
+
+    /**
+     * @brief Find the first occurrence of a character.
+     * @param c Character to search for.
+     * @param pos Position at which to start the search.
+     * @return Position of the character, or `npos` if not found.
+     */
+    size_type find(char c, size_type pos = 0) const noexcept;
+    /**
+     * @brief Find the first occurrence of a substring.
+     * @param str Substring to search for.
+     * @param pos Position at which to start the search.
+     * @return Position of the substring, or `npos` if not found.
+     */
+    size_type find(string_ref str, size_type pos = 0) const noexcept;
+
+    /**
+     * @brief Determine whether the string starts with a prefix.
+     * @param prefix The prefix to check for.
+     * @return True if the first characters match `prefix`.
+     */
+    bool starts_with(string_ref prefix) const noexcept {
+      return m_size >= prefix.m_size
+        && std::memcmp(m_data, prefix.m_data, prefix.m_size) == 0;
+    }
+
+    /**
+     * @brief Compare with another string.
+     * @param other String to compare with.
+     * @return Negative, zero, or positive if this string is
+     *         respectively less than, equal to, or greater than
+     *         `other` in lexicographical order.
+     */
+    int compare(string_ref other) const noexcept;
+
+    /**
+     * @brief Copy the referenced characters into a `std::string`.
+     * @return A new `std::string` with the same contents.
+     */
+    std::string str() const { return std::string(m_data, m_size); }
+    /**
+     * @copydoc str
+     */
+    explicit operator std::string() const { return str(); }
+
+  private:
+    const char* m_data; //< Pointer to the first character.
+    size_type m_size; //< Number of characters.
+  };
+
+  /**
+   * @brief Equality operator.
+   * @param a Left operand.
+   * @param b Right operand.
+   * @return True if both strings have the same contents.
+   */
+  inline bool operator==(string_ref a, string_ref b) noexcept {
+    return a.size() == b.size()
+      && std::memcmp(a.data(), b.data(), a.size()) == 0;
+  }
+  /**
+   * @brief Inequality operator.
+   * @param a Left operand.
+   * @param b Right operand.
+   * @return True if the strings have different contents.
+   */
+  inline bool operator!=(string_ref a, string_ref b) noexcept {
+    return !(a == b);
+  }
+  /**
+   * @brief Less-than operator.
+   * @param a Left operand.
+   * @param b Right operand.
+   * @return True if `a` comes before `b` in lexicographical order.
+   */
+  inline bool operator<(string_ref a, string_ref b) noexcept {
+    return a.compare(b) < 0;
+  }
+
+  /**
+   * @brief Output operator.
+   * @param os Output stream.
+   * @param str String to write.
+   * @return The given output stream.
+   */
+  std::ostream& operator<<(std::ostream& os, string_ref str);
+
+  /**
+   * @brief Concatenate a `std::string` and a `string_ref`.
+   * @param a Left operand.
+   * @param b Right operand.
+   * @return A new string holding `a` followed by `b`.
+   */
+  inline std::string operator+(const std::string& a, string_ref b) {
+    return std::string{a}.append(b.data(), b.size());
+  }
+  /**
+   * @brief Concatenate a `string_ref` and a `std::string`.
+   * @param a Left operand.
+   * @param b Right operand.
+   * @return A new string holding `a` followed by `b`.
+   */
+  inline std::string operator+(string_ref a, const std::string& b) {
+    return a.str() + b;
+  }
+
+} // End namespace
+
+#endif
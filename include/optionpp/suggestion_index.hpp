@@ -0,0 +1,152 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `suggestion_index` class.
+ */
+
+#ifndef OPTIONPP_SUGGESTION_INDEX_HPP
+#define OPTIONPP_SUGGESTION_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optionpp/string_pool.hpp>
+#include <optionpp/string_ref.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Finds the names closest to a misspelled word.
+   *
+   * A `suggestion_index` holds a set of names in a BK-tree: each name
+   * is stored below the first name of the tree, in the branch labeled
+   * with its edit distance to that name, and so on recursively. Since
+   * the Levenshtein distance satisfies the triangle inequality, a
+   * search for the names within distance `d` of a word only needs to
+   * follow the branches whose labels are within `d` of the word's
+   * distance to each visited name. A typical search for a small `d`
+   * therefore computes the distance to a small fraction of the names.
+   *
+   * The index owns copies of the names, kept in a `string_pool`, so
+   * it stays valid after the options it was built from change. Each
+   * tree node is a small record of indices: the name of a node is the
+   * string in the pool with the same id.
+   */
+  class suggestion_index {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes and distances.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an empty index.
+     */
+    suggestion_index() noexcept {}
+
+    /**
+     * @brief Add a name to the index.
+     *
+     * Empty names and names already in the index are ignored.
+     *
+     * @param name The name to add.
+     */
+    void insert(string_ref name);
+
+    /**
+     * @brief Return the number of names in the index.
+     * @return Number of distinct names.
+     */
+    size_type size() const noexcept { return m_nodes.size(); }
+    /**
+     * @brief Return whether the index is empty.
+     * @return True if the index holds no names.
+     */
+    bool empty() const noexcept { return m_nodes.empty(); }
+
+    /**
+     * @brief Find the names closest to a word.
+     * @param word The (possibly misspelled) word.
+     * @param max_distance Largest edit distance of a name to return.
+     * @param max_results Largest number of names to return.
+     * @return The names within `max_distance` of `word`, closest
+     *         first, and in alphabetical order among names at the
+     *         same distance.
+     */
+    std::vector<std::string> find(string_ref word, size_type max_distance,
+                                  size_type max_results) const;
+
+    /**
+     * @brief Compute the Levenshtein distance between two strings.
+     *
+     * The distance is the smallest number of single-character
+     * insertions, deletions and substitutions that turn one string
+     * into the other.
+     *
+     * @param a First string.
+     * @param b Second string.
+     * @param limit The computation stops once the distance is known to
+     *              exceed this value.
+     * @return The distance, or `limit + 1` if it exceeds `limit`.
+     */
+    static size_type distance(string_ref a, string_ref b, size_type limit);
+
+  private:
+
+    /**
+     * @brief Node of the BK-tree.
+     */
+    struct node {
+      std::uint32_t distance; //< Distance to the parent's name.
+      std::uint32_t first_child; //< Index of the first child, or `none`.
+      std::uint32_t next_sibling; //< Index of the next child of the parent, or `none`.
+    };
+
+    /**
+     * @brief Compute the Levenshtein distance between a word of at
+     *        most 64 characters and a text, with bit-parallel
+     *        operations.
+     * @param masks For each character, the bit mask of the positions
+     *              where it occurs in the word.
+     * @param length Length of the word (from 1 to 64).
+     * @param text The text.
+     * @param limit As in `distance(string_ref, string_ref, size_type)`.
+     * @return The distance, or `limit + 1` if it exceeds `limit`.
+     */
+    static size_type distance(const std::uint64_t* masks, size_type length,
+                              string_ref text, size_type limit) noexcept;
+
+    /**
+     * @brief Index used for missing children and siblings.
+     */
+    static constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+
+    string_pool m_names; //< Name of each node, by index.
+    std::vector<node> m_nodes; //< Nodes of the tree; the first is the root.
+  };
+
+} // End namespace
+
+#endif
@@ -0,0 +1,141 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `text_arena` class.
+ */
+
+#ifndef OPTIONPP_TEXT_ARENA_HPP
+#define OPTIONPP_TEXT_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <optionpp/string_ref.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Storage for many small strings.
+   *
+   * A `text_arena` copies strings into large blocks of memory, so
+   * that storing a string usually does not need a separate
+   * allocation. Each stored string is returned as a `string_ref`
+   * that stays valid until the arena is cleared or destroyed. Moving
+   * an arena does not invalidate these references.
+   *
+   * Clearing the arena keeps its blocks, so an arena that is cleared
+   * and refilled with a similar amount of text stops allocating
+   * altogether.
+   */
+  class text_arena {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Constructor.
+     * @param block_size Size of each block of memory, in bytes.
+     *                   Longer strings get a block of their own.
+     */
+    explicit text_arena(size_type block_size = 4096) noexcept
+      : m_block_size{block_size ? block_size : 1} {}
+
+    text_arena(const text_arena&) = delete;
+    text_arena& operator=(const text_arena&) = delete;
+
+    /**
+     * @brief Move constructor.
+     * @param other The arena to move from.
+     */
+    text_arena(text_arena&& other) noexcept;
+    /**
+     * @brief Move assignment operator.
+     * @param other The arena to move from.
+     * @return Reference to the current instance.
+     */
+    text_arena& operator=(text_arena&& other) noexcept;
+
+    /**
+     * @brief Copy a string into the arena.
+     * @param str The string to copy.
+     * @return Reference to the stored copy.
+     */
+    string_ref store(string_ref str);
+
+    /**
+     * @brief Copy the concatenation of several strings into the
+     *        arena.
+     * @param a First string.
+     * @param b Second string.
+     * @param c Third string, if any.
+     * @return Reference to the stored concatenation.
+     */
+    string_ref store(string_ref a, string_ref b,
+                     string_ref c = string_ref{});
+
+    /**
+     * @brief Discard all stored strings.
+     *
+     * Memory blocks are kept for reuse. All references returned by
+     * `store` become invalid.
+     */
+    void clear() noexcept {
+      m_current = 0;
+      m_used = 0;
+    }
+
+    /**
+     * @brief Release all memory held by the arena.
+     */
+    void release() noexcept {
+      m_blocks.clear();
+      clear();
+    }
+
+  private:
+
+    /**
+     * @brief Block of memory owned by the arena.
+     */
+    struct block {
+      std::unique_ptr<char[]> data; //< Memory for the block.
+      size_type size; //< Size of the block in bytes.
+    };
+
+    /**
+     * @brief Reserve room for a string.
+     * @param length Number of bytes to reserve.
+     * @return Pointer to the reserved bytes.
+     */
+    char* allocate(size_type length);
+
+    std::vector<block> m_blocks; //< All blocks, including unused ones.
+    size_type m_block_size; //< Default size for new blocks.
+    size_type m_current{0}; //< Index of the block being filled.
+    size_type m_used{0}; //< Bytes used in the current block.
+  };
+
+} // End namespace
+
+#endif
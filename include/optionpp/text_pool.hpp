@@ -0,0 +1,157 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+
+/**
+ * @file
+ * @brief Header file for `text_pool` class.
+ */
+
+#ifndef OPTIONPP_TEXT_POOL_HPP
+#define OPTIONPP_TEXT_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optionpp/string_ref.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Append-only storage for strings addressed by offset.
+   *
+   * A `text_pool` copies strings into blocks of memory and refers to
+   * each stored string by a `span`, a fixed-size record holding its
+   * offset and length. The offsets number the bytes of all blocks
+   * one after another: the first block holds 64 bytes and each
+   * further block is twice as large as the one before it, so the
+   * block holding an offset is found with a little arithmetic.
+   *
+   * Stored strings are never moved or overwritten. A `string_ref`
+   * returned by `get` therefore stays valid as long as the pool
+   * does, and a pool can be read from several threads while one
+   * other thread stores new strings, provided each reader obtained
+   * its spans after they were stored.
+   */
+  class text_pool {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Location of a stored string.
+     */
+    struct span {
+      std::uint32_t offset; //< Position of the first character.
+      std::uint32_t size; //< Number of characters.
+    };
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an empty pool. No memory is allocated until a string
+     * is stored.
+     */
+    text_pool() noexcept {}
+
+    text_pool(const text_pool&) = delete;
+    text_pool& operator=(const text_pool&) = delete;
+
+    /**
+     * @brief Copy a string into the pool.
+     * @param str The string to copy.
+     * @return Location of the stored copy. An empty string is not
+     *         stored, and gets a span of length zero.
+     * @throw std::length_error If the pool would exceed the size that
+     *                          the spans can address.
+     */
+    span store(string_ref str);
+
+    /**
+     * @brief Get a stored string.
+     * @param s Location returned by `store`.
+     * @return Reference to the string in the pool.
+     */
+    string_ref get(span s) const noexcept {
+      if (s.size == 0)
+        return string_ref{};
+      size_type b = block_of(s.offset);
+      return string_ref{m_blocks[b].get() + (s.offset - block_start(b)), s.size};
+    }
+
+    /**
+     * @brief Return the number of bytes used.
+     *
+     * This includes the ends of blocks that were skipped because the
+     * next string did not fit.
+     *
+     * @return Offset at which the next string would be stored.
+     */
+    size_type size() const noexcept { return m_end; }
+
+  private:
+
+    /**
+     * @brief Size of the first block, in bytes.
+     */
+    static const size_type first_block_size = 64;
+
+    /**
+     * @brief Number of blocks needed to address every 32-bit offset.
+     */
+    static const size_type max_blocks = 26;
+
+    /**
+     * @brief Return the offset of the first byte of a block.
+     * @param b Index of the block.
+     * @return Offset of the block.
+     */
+    static size_type block_start(size_type b) noexcept {
+      return first_block_size * ((size_type{1} << b) - 1);
+    }
+
+    /**
+     * @brief Return the block holding an offset.
+     * @param offset The offset.
+     * @return Index of the block.
+     */
+    static size_type block_of(std::uint32_t offset) noexcept {
+      // Block b starts at first_block_size * (2^b - 1), so b is the
+      // position of the highest bit of offset / first_block_size + 1
+      std::uint32_t x = offset / first_block_size + 1;
+#ifdef __GNUC__
+      return static_cast<size_type>(31 - __builtin_clz(x));
+#else
+      size_type b = 0;
+      while (x >>= 1)
+        ++b;
+      return b;
+#endif
+    }
+
+    std::unique_ptr<char[]> m_blocks[max_blocks]; //< Blocks, allocated when first used.
+    size_type m_end{0}; //< Offset at which the next string is stored.
+  };
+
+} // End namespace
+
+#endif
@@ -0,0 +1,166 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Header file for `tokenizer` class.
+ */
+
+#ifndef OPTIONPP_TOKENIZER_HPP
+#define OPTIONPP_TOKENIZER_HPP
+
+#include <array>
+#include <string>
+#include <optionpp/string_ref.hpp>
+#include <optionpp/text_arena.hpp>
+
+namespace optionpp {
+
+  /**
+   * @brief Splits a string into tokens.
+   *
+   * Tokens are separated by delimiter characters. A token can
+   * contain delimiters if they are quoted or preceded by an escape
+   * character; the quotes and escape characters themselves are
+   * removed. The rules are the same as for `utility::split`, which
+   * is implemented with this class.
+   *
+   * The input is scanned for the next delimiter, quote or escape
+   * character 16 or 32 bytes at a time with SSE2 or AVX2 compares,
+   * when the compiler targets those instruction sets, and one byte at
+   * a time with a lookup table otherwise. A token that contains no
+   * quotes or escape characters is returned as a `string_ref` into
+   * the input, without copying. Only the other tokens are built in a
+   * separate buffer.
+   */
+  class tokenizer {
+  public:
+
+    /**
+     * @brief Unsigned integer type used for positions.
+     */
+    using size_type = string_ref::size_type;
+
+    /**
+     * @brief Constructor.
+     * @param delims Each character in this string is treated as a
+     *               delimiter.
+     * @param quotes Each character in this string is treated as a
+     *               quotation mark. A quoted section ends with the
+     *               same character that began it.
+     * @param escape_char Character that removes any special meaning
+     *                    from the character that follows it.
+     * @param allow_empty Whether to produce empty tokens between
+     *                    adjacent delimiters.
+     */
+    explicit tokenizer(const std::string& delims = " \t\n\r",
+                       const std::string& quotes = "\"\'",
+                       char escape_char = '\\',
+                       bool allow_empty = false);
+
+    /**
+     * @brief Find the next token.
+     *
+     * Start with `pos` set to zero and call repeatedly until it
+     * returns false.
+     *
+     * @param input The string being split.
+     * @param pos Position at which to continue scanning. Updated to
+     *            the position after the token.
+     * @param token Set to the token. This refers either to `input` or
+     *              to `buffer`.
+     * @param buffer Used to build tokens that contain quotes or
+     *               escape characters.
+     * @return True if a token was found, false if the end of the
+     *         input was reached.
+     */
+    bool next(string_ref input, size_type& pos, string_ref& token,
+              std::string& buffer) const;
+
+    /**
+     * @brief Split a string into tokens without copying them.
+     *
+     * Tokens that contain quotes or escape characters are stored in
+     * `storage`; all other tokens refer to `input`.
+     *
+     * @tparam OutputIt Output iterator type that accepts `string_ref`
+     *                  values.
+     * @param input The string to split.
+     * @param dest Output iterator to write the tokens to.
+     * @param storage Storage for rewritten tokens.
+     */
+    template <typename OutputIt>
+    void split(string_ref input, OutputIt dest, text_arena& storage) const;
+
+  private:
+
+    /**
+     * @brief Character classes (bit flags).
+     */
+    enum char_class : unsigned char { plain = 0, //< Ordinary character.
+                                      delim = 1, //< Delimiter.
+                                      quote = 2, //< Quotation mark.
+                                      escape = 4 //< Escape character.
+    };
+
+    /**
+     * @brief Find the first delimiter, quote or escape character.
+     * @param first Pointer to the first character to examine.
+     * @param last Pointer to one past the last character.
+     * @return Pointer to the character, or `last` if there is none.
+     */
+    const char* find_special(const char* first, const char* last) const noexcept;
+
+    /**
+     * @brief Finish a token that contains quotes or escape
+     *        characters.
+     * @param input The string being split.
+     * @param pos Position of the first quote or escape character.
+     *            Updated to the position after the token.
+     * @param buffer Holds the start of the token; the rest is
+     *               appended.
+     * @return True if the token ended at a delimiter, false if it
+     *         ended at the end of the input.
+     */
+    bool finish_token(string_ref input, size_type& pos,
+                      std::string& buffer) const;
+
+    std::array<unsigned char, 256> m_classes; //< Class of each character.
+    std::string m_specials; //< All characters that are not plain.
+    bool m_allow_empty; //< Whether to produce empty tokens.
+  };
+
+} // End namespace
+
+/* Implementation */
+
+template <typename OutputIt>
+void optionpp::tokenizer::split(string_ref input, OutputIt dest,
+                                text_arena& storage) const {
+  std::string buffer;
+  string_ref token;
+  size_type pos = 0;
+  while (next(input, pos, token, buffer)) {
+    if (token.data() == buffer.data())
+      token = storage.store(token);
+    *dest++ = token;
+  }
+}
+
+#endif
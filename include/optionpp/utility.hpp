@@ -25,8 +25,12 @@
 #ifndef OPTIONPP_UTILITY_HPP
 #define OPTIONPP_UTILITY_HPP
 
+#include <algorithm>
+#include <cctype>
 #include <stdexcept>
 #include <string>
+#include <optionpp/string_ref.hpp>
+#include <optionpp/tokenizer.hpp>
 
 namespace optionpp {
 
@@ -46,6 +50,9 @@ namespace optionpp {
      * the `quotes` parameter) are ignored. Within quotes, an escape
      * character can be used to escape a quote symbol.
      *
+     * Use `tokenizer` directly to get the tokens without copying
+     * them.
+     *
      * @tparam OutputIt Type of output iterator (typically deduced).
      * @param str The string to split.
      * @param dest An output iterator specifying where the tokens
@@ -112,6 +119,32 @@ namespace optionpp {
                           int indent,
                           int first_line_indent);
 
+    /**
+     * @brief Perform word-wrapping on a string, writing the result
+     *        to an output iterator.
+     *
+     * Produces exactly the same characters as `wrap_text(const
+     * std::string&, int, int, int)`, but writes them one at a time to
+     * `dest` in a single pass over `str`, without building any
+     * intermediate strings. To write directly to a stream, pass a
+     * `std::ostreambuf_iterator<char>`; to append to a string, pass a
+     * `std::back_insert_iterator`.
+     *
+     * @tparam OutputIt Type of output iterator (typically deduced).
+     * @param str Text to wrap.
+     * @param dest An output iterator specifying where the wrapped
+     *             text should be written.
+     * @param line_len Maximum desired line length, if any.
+     * @param indent Number of spaces to indent each line after the
+     *               first one.
+     * @param first_line_indent Number of spaces to indent the first
+     *                          line.
+     * @return Iterator one past the last character written.
+     */
+    template <typename OutputIt>
+    OutputIt wrap_text(string_ref str, OutputIt dest,
+                       int line_len, int indent, int first_line_indent);
+
     /**
      * @brief Determine if a string occurs within another string at a
      * particular position.
@@ -147,54 +180,110 @@ void optionpp::utility::split(const std::string& str, OutputIt dest,
                               const std::string& quotes,
                               char escape_char,
                               bool allow_empty) {
-  using size_type = decltype(str.size());
-  size_type pos{0};
-  bool escape_next{false};
-  bool in_quotes{false};
-  size_type quote_index{0};
-  std::string cur_token;
-  while (pos < str.size()) {
-    if (in_quotes) {
-      // Look for closing quote, unless we are escaping
-      if (escape_next || str[pos] != quotes[quote_index]) {
-        if (!escape_next && str[pos] == escape_char)
-          escape_next = true;
-        else {
-          cur_token.push_back(str[pos]);
-          escape_next = false;
-        }
-      } else { // Found closing quote
-        in_quotes = false;
+  tokenizer tok{delims, quotes, escape_char, allow_empty};
+  std::string buffer;
+  string_ref token;
+  tokenizer::size_type pos{0};
+  while (tok.next(str, pos, token, buffer))
+    *dest++ = token.str();
+}
+
+template <typename OutputIt>
+OutputIt optionpp::utility::wrap_text(string_ref str, OutputIt dest,
+                                      int line_len, int indent,
+                                      int first_line_indent) {
+  using size_type = string_ref::size_type;
+  auto is_space = [](char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+  };
+  auto fill = [&dest](int count) {
+    for (; count > 0; --count)
+      *dest++ = ' ';
+  };
+
+  // Validate indentation
+  if (line_len > 0) {
+    if (indent < 0)
+      indent = 0;
+    else if (indent > line_len - 1)
+      indent = line_len - 1;
+    if (first_line_indent < 0)
+      first_line_indent = 0;
+    else if (first_line_indent > line_len - 1)
+      first_line_indent = line_len - 1;
+  }
+
+  // Each line of the input is wrapped separately. A newline is only
+  // written between lines once some text has been written.
+  bool written = false;
+  size_type line_start = 0;
+  while (line_start <= str.size()) {
+    size_type line_end = str.find('\n', line_start);
+    if (line_end == string_ref::npos)
+      line_end = str.size();
+    const string_ref line = str.substr(line_start, line_end - line_start);
+    const int cur_first_indent = line_start == 0 ? first_line_indent : indent;
+    line_start = line_end + 1;
+
+    if (written)
+      *dest++ = '\n';
+
+    // Check for unlimited length
+    if (line_len <= 0) {
+      fill(cur_first_indent);
+      dest = std::copy(line.begin(), line.end(), dest);
+      written = written || cur_first_indent > 0 || !line.empty();
+      continue;
+    }
+
+    bool line_written = false;
+    size_type pos = 0;
+    while (pos < line.size()) {
+      const int cur_indent = line_written ? indent : cur_first_indent;
+      size_type start = pos;
+
+      // After the first line, new lines should start at
+      // non-whitespace characters
+      if (line_written) {
+        while (start < line.size() && is_space(line[start]))
+          ++start;
       }
-    } else {
-      // Look for delimiter
-      if (escape_next || delims.find(str[pos]) == std::string::npos) {
-        if (!escape_next && str[pos] == escape_char)
-          escape_next = true;
-        else if (escape_next) {
-          cur_token.push_back(str[pos]);
-          escape_next = false;
-        } else {
-          // Look for quote
-          quote_index = quotes.find(str[pos]);
-          if (quote_index != std::string::npos)
-            in_quotes = true;
-          else
-            cur_token.push_back(str[pos]);
-        }
-      } else { // We hit a delimiter
-        if (!cur_token.empty() || allow_empty)
-          *dest++ = cur_token;
-        cur_token.clear();
+
+      // Find ideal end point
+      size_type end = start + (line_len - cur_indent);
+      if (end > line.size())
+        end = line.size();
+
+      // We don't want to split in the middle of a word unless we
+      // don't have a choice
+      if (end < line.size()) {
+        size_type word_start = end;
+        while (word_start > start && !is_space(line[word_start]))
+          --word_start;
+
+        if (word_start > start)
+          end = word_start;
       }
-    }
 
-    ++pos;
+      // Mark position of next line
+      pos = end;
+
+      // We don't want trailing whitespace
+      while (end > start && is_space(line[end - 1]))
+        --end;
+
+      if (end > start) {
+        if (line_written)
+          *dest++ = '\n';
+        fill(cur_indent);
+        dest = std::copy(line.begin() + start, line.begin() + end, dest);
+        line_written = true;
+        written = true;
+      }
+    }
   }
 
-  // Do we have any characters leftover?
-  if (!cur_token.empty() || allow_empty)
-    *dest++ = cur_token;
+  return dest;
 }
 
 #endif
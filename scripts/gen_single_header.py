@@ -43,8 +43,35 @@ _start_comment = """\
 
 """
 
-_transl_units = ['error', 'utility', 'option', 'option_group', 'parser_result',\
-                 'result_iterator', 'parser']
+_transl_units = [
+    'error',
+    'charconv',
+    'string_ref',
+    'option_syntax',
+    'string_pool',
+    'suggestion_index',
+    'parse_status',
+    'converter',
+    'text_arena',
+    'text_pool',
+    'tokenizer',
+    'mapped_file',
+    'utility',
+    'parse_target',
+    'option',
+    'option_group',
+    'option_index',
+    'parser_result',
+    'parser_result_ref',
+    'batch_result',
+    'result_iterator',
+    'compiled_parser',
+    'parser',
+    'command_result',
+    'command_parser',
+    'incremental_parser',
+    'option_schema',
+]
 
 def generate():
     single_header_dir = Path('..') / Path('single_header')
@@ -97,35 +124,51 @@ def _parse_file(filename, header=False):
     content = ''
     in_comment = False
     found_content = False
+    depth = 0 # Nesting level of conditional blocks, not counting the guard
 
     with open(filename) as file:
-        for line in file:
-            sline = line.strip()
-            if sline.startswith('/*'): # Skip commented lines
-                in_comment = True
-            if in_comment:
-                if sline.endswith('*/'):
-                    in_comment = False
-                continue
-            if header and sline.startswith('#ifndef'): # Header guard
-                found_content = True
-                continue
-
-            if not header and sline.startswith('using namespace optionpp'):
-                found_content = True
-            elif not header and sline.startswith('namespace'):
-                found_content = True
-            elif sline.startswith('#include <optionpp'):
-                continue # Ignore local library includes
-            elif sline.startswith('#include'): # Add unique includes
-                includes += line
-                continue
-            elif header and sline.startswith('#endif'):
+        lines = file.readlines()
+
+    # The header guard is the first #ifndef and the last #endif
+    guard_end = len(lines)
+    if header:
+        for i in reversed(range(len(lines))):
+            if lines[i].strip().startswith('#endif'):
+                guard_end = i
                 break
-            if found_content and not sline.startswith('#define'):
-                content += line.partition('//')[0].rstrip()
-                if not content.endswith('\n'):
-                    content += '\n'
+
+    for line in lines[:guard_end]:
+        sline = line.strip()
+        if sline.startswith('/*'): # Skip commented lines
+            in_comment = True
+        if in_comment:
+            if sline.endswith('*/'):
+                in_comment = False
+            continue
+        if header and not found_content and sline.startswith('#ifndef'): # Header guard
+            found_content = True
+            continue
+
+        if sline.startswith('#if'):
+            depth += 1
+            found_content = True
+        elif sline.startswith('#endif'):
+            depth -= 1
+
+        if not header and sline.startswith('using namespace optionpp'):
+            found_content = True
+        elif not header and sline.startswith('namespace'):
+            found_content = True
+        elif sline.startswith('#include <optionpp'):
+            continue # Ignore local library includes
+        elif sline.startswith('#include') and depth == 0: # Add unique includes
+            includes += line
+            continue
+        is_guard = sline.startswith('#define OPTIONPP_') and sline.endswith('_HPP')
+        if found_content and not (header and is_guard):
+            content += line.partition('//')[0].rstrip()
+            if not content.endswith('\n'):
+                content += '\n'
     return (includes, content)
 
 def _remove_dupes(string):
@@ -17,15 +17,28 @@
  */
 /* Written by Greg Kikola <gkikola@gmail.com>. */
 
-// Single-header generated 2020-06-07T22:52:55Z
+// Single-header generated 2026-10-16T09:24:23Z
 
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
 #include <iosfwd>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -54,6 +67,610 @@ namespace optionpp {
     type_error(const std::string& msg, const std::string& fn_name)
       : error(msg, fn_name) {}
   };
+  class duplicate_option_error : public error {
+  public:
+    duplicate_option_error(const std::string& msg,
+                           const std::string& fn_name,
+                           const std::string& option)
+      : error(msg, fn_name), m_option{option} {}
+    const std::string& option() const noexcept { return m_option; }
+  private:
+    std::string m_option;
+  };
+  class parse_error : public error {
+  public:
+    parse_error(const std::string msg, const std::string fn_name,
+                const std::string option = "")
+      : error(msg, fn_name), m_option{option} {}
+    const std::string& option() const noexcept { return m_option; }
+  private:
+    std::string m_option;
+  };
+}
+
+
+namespace optionpp {
+  struct from_chars_result {
+    const char* ptr;
+    std::errc ec;
+  };
+  from_chars_result from_chars(const char* first, const char* last,
+                               long long& value) noexcept;
+  from_chars_result from_chars(const char* first, const char* last,
+                               unsigned long long& value) noexcept;
+  inline from_chars_result from_chars(const char* first, const char* last,
+                                      int& value) noexcept {
+    long long wide = 0;
+    auto result = from_chars(first, last, wide);
+    if (result.ec == std::errc{}) {
+      if (wide < std::numeric_limits<int>::min()
+          || wide > std::numeric_limits<int>::max())
+        result.ec = std::errc::result_out_of_range;
+      else
+        value = static_cast<int>(wide);
+    }
+    return result;
+  }
+  inline from_chars_result from_chars(const char* first, const char* last,
+                                      unsigned& value) noexcept {
+    unsigned long long wide = 0;
+    auto result = from_chars(first, last, wide);
+    if (result.ec == std::errc{}) {
+      if (wide > std::numeric_limits<unsigned>::max())
+        result.ec = std::errc::result_out_of_range;
+      else
+        value = static_cast<unsigned>(wide);
+    }
+    return result;
+  }
+  from_chars_result from_chars(const char* first, const char* last,
+                               double& value) noexcept;
+}
+
+
+namespace optionpp {
+  class string_ref {
+  public:
+    using size_type = std::size_t;
+    using const_iterator = const char*;
+    using iterator = const_iterator;
+    static const size_type npos = static_cast<size_type>(-1);
+    string_ref() noexcept : m_data{""}, m_size{0} {}
+    string_ref(const char* str, size_type length) noexcept
+      : m_data{str}, m_size{length} {}
+    string_ref(const char* str) noexcept
+      : m_data{str}, m_size{std::strlen(str)} {}
+    string_ref(const std::string& str) noexcept
+      : m_data{str.data()}, m_size{str.size()} {}
+    const char* data() const noexcept { return m_data; }
+    size_type size() const noexcept { return m_size; }
+    size_type length() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+    const_iterator begin() const noexcept { return m_data; }
+    const_iterator end() const noexcept { return m_data + m_size; }
+    char operator[](size_type index) const noexcept { return m_data[index]; }
+    string_ref substr(size_type pos, size_type count = npos) const noexcept {
+      if (pos > m_size)
+        pos = m_size;
+      if (count > m_size - pos)
+        count = m_size - pos;
+      return string_ref{m_data + pos, count};
+    }
+    size_type find(char c, size_type pos = 0) const noexcept;
+    size_type find(string_ref str, size_type pos = 0) const noexcept;
+    bool starts_with(string_ref prefix) const noexcept {
+      return m_size >= prefix.m_size
+        && std::memcmp(m_data, prefix.m_data, prefix.m_size) == 0;
+    }
+    int compare(string_ref other) const noexcept;
+    std::string str() const { return std::string(m_data, m_size); }
+    explicit operator std::string() const { return str(); }
+  private:
+    const char* m_data;
+    size_type m_size;
+  };
+  inline bool operator==(string_ref a, string_ref b) noexcept {
+    return a.size() == b.size()
+      && std::memcmp(a.data(), b.data(), a.size()) == 0;
+  }
+  inline bool operator!=(string_ref a, string_ref b) noexcept {
+    return !(a == b);
+  }
+  inline bool operator<(string_ref a, string_ref b) noexcept {
+    return a.compare(b) < 0;
+  }
+  std::ostream& operator<<(std::ostream& os, string_ref str);
+  inline std::string operator+(const std::string& a, string_ref b) {
+    return std::string{a}.append(b.data(), b.size());
+  }
+  inline std::string operator+(string_ref a, const std::string& b) {
+    return a.str() + b;
+  }
+}
+
+
+namespace optionpp {
+  class option_syntax {
+  public:
+    enum class token_kind {
+      non_option,
+      end_of_options,
+      long_option,
+      short_options,
+      bad_assignment
+    };
+    struct token_parts {
+      token_kind kind;
+      string_ref specifier;
+      string_ref argument;
+      bool has_argument;
+    };
+    option_syntax() noexcept
+      : m_short_prefix{"-", 1}, m_long_prefix{"--", 2},
+        m_end_of_options{"--", 2}, m_equals{"=", 1} {}
+    option_syntax(string_ref short_prefix, string_ref long_prefix,
+                  string_ref end_of_options, string_ref equals) noexcept
+      : m_short_prefix{short_prefix}, m_long_prefix{long_prefix},
+        m_end_of_options{end_of_options}, m_equals{equals} {}
+    string_ref short_prefix() const noexcept { return m_short_prefix; }
+    string_ref long_prefix() const noexcept { return m_long_prefix; }
+    string_ref end_of_options() const noexcept { return m_end_of_options; }
+    string_ref equals() const noexcept { return m_equals; }
+    token_parts split(string_ref token) const noexcept;
+    bool is_non_option(string_ref token) const noexcept {
+      return token != m_end_of_options
+        && !has_prefix(token, m_long_prefix)
+        && !has_prefix(token, m_short_prefix);
+    }
+    static bool has_prefix(string_ref str, string_ref prefix) noexcept {
+      return str.size() > prefix.size() && str.starts_with(prefix);
+    }
+  private:
+    string_ref m_short_prefix;
+    string_ref m_long_prefix;
+    string_ref m_end_of_options;
+    string_ref m_equals;
+  };
+}
+
+
+namespace optionpp {
+  class string_pool {
+  public:
+    using size_type = std::size_t;
+    using id_type = std::uint32_t;
+    static constexpr id_type npos = static_cast<id_type>(-1);
+    string_pool() noexcept {}
+    void clear() noexcept;
+    void reserve(size_type count, size_type length = 0);
+    id_type intern(string_ref str) {
+      return intern(str, hash(str.data(), str.size()));
+    }
+    id_type intern(string_ref str, std::uint32_t h);
+    id_type find(string_ref str) const noexcept {
+      return find(str, hash(str.data(), str.size()));
+    }
+    id_type find(string_ref str, std::uint32_t h) const noexcept;
+    string_ref get(id_type id) const noexcept {
+      const record& r = m_records[id];
+      return string_ref{m_text.data() + r.offset, r.length};
+    }
+    size_type size() const noexcept { return m_records.size(); }
+    bool empty() const noexcept { return m_records.empty(); }
+    size_type text_size() const noexcept { return m_text.size(); }
+    static std::uint32_t hash(const char* str, size_type length) noexcept;
+  private:
+    struct record {
+      std::uint32_t offset;
+      std::uint32_t length;
+    };
+    struct slot {
+      std::uint32_t hash;
+      id_type id;
+    };
+    void rehash(size_type slot_count);
+    void place(const slot& entry) noexcept;
+    std::string m_text;
+    std::vector<record> m_records;
+    std::vector<slot> m_slots;
+  };
+}
+
+
+namespace optionpp {
+  class suggestion_index {
+  public:
+    using size_type = std::size_t;
+    suggestion_index() noexcept {}
+    void insert(string_ref name);
+    size_type size() const noexcept { return m_nodes.size(); }
+    bool empty() const noexcept { return m_nodes.empty(); }
+    std::vector<std::string> find(string_ref word, size_type max_distance,
+                                  size_type max_results) const;
+    static size_type distance(string_ref a, string_ref b, size_type limit);
+  private:
+    struct node {
+      std::uint32_t distance;
+      std::uint32_t first_child;
+      std::uint32_t next_sibling;
+    };
+    static size_type distance(const std::uint64_t* masks, size_type length,
+                              string_ref text, size_type limit) noexcept;
+    static constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+    string_pool m_names;
+    std::vector<node> m_nodes;
+  };
+}
+
+
+namespace optionpp {
+  enum class parse_errc {
+    none,
+    invalid_option,
+    missing_argument,
+    unexpected_argument,
+    not_an_integer,
+    negative_argument,
+    not_a_number,
+    out_of_range,
+    unreadable_file,
+    recursive_file,
+    invalid_value,
+    ambiguous_option,
+    unknown_command
+  };
+  class parse_status {
+  public:
+    using size_type = std::size_t;
+    bool ok() const noexcept { return m_error == parse_errc::none; }
+    explicit operator bool() const noexcept { return ok(); }
+    parse_errc error() const noexcept { return m_error; }
+    size_type token_index() const noexcept { return m_token_index; }
+    size_type offset() const noexcept { return m_offset; }
+    const std::string& option() const noexcept { return m_option; }
+    const std::vector<std::string>& candidates() const noexcept {
+      return m_candidates;
+    }
+    std::vector<std::string> suggestions() const;
+    std::string message() const;
+    parse_error to_error() const;
+    void clear() noexcept {
+      m_error = parse_errc::none;
+      m_token_index = 0;
+      m_offset = 0;
+      m_option.clear();
+      m_candidates.clear();
+      m_suggestions.reset();
+    }
+    static std::string message(parse_errc error, string_ref option);
+  private:
+    friend class command_parser;
+    friend class compiled_parser;
+    friend class schema_parser;
+    void set(parse_errc error, size_type token_index, size_type offset,
+             string_ref prefix, string_ref name = string_ref{}) {
+      m_error = error;
+      m_token_index = token_index;
+      m_offset = offset;
+      m_option.assign(prefix.data(), prefix.size());
+      m_option.append(name.data(), name.size());
+      m_candidates.clear();
+      m_suggestions.reset();
+    }
+    void set_suggestions(const std::shared_ptr<const suggestion_index>& suggestions,
+                         size_type prefix_size) noexcept {
+      m_suggestions = suggestions;
+      m_prefix_size = prefix_size;
+    }
+    void add_candidate(string_ref prefix, string_ref name) {
+      m_candidates.push_back(prefix.str());
+      m_candidates.back().append(name.data(), name.size());
+    }
+    parse_errc m_error{parse_errc::none};
+    size_type m_token_index{0};
+    size_type m_offset{0};
+    std::string m_option;
+    std::vector<std::string> m_candidates;
+    std::shared_ptr<const suggestion_index> m_suggestions;
+    size_type m_prefix_size{0};
+  };
+}
+
+
+namespace optionpp {
+  struct byte_size {
+    unsigned long long bytes{0};
+    byte_size() noexcept {}
+    explicit byte_size(unsigned long long bytes) noexcept : bytes{bytes} {}
+  };
+  template <typename T>
+  struct enum_names {};
+  template <typename T, typename Enable = void>
+  struct converter;
+  parse_errc convert_integer(string_ref argument, long long& value,
+                             long long min, long long max) noexcept;
+  parse_errc convert_unsigned(string_ref argument, unsigned long long& value,
+                              unsigned long long max) noexcept;
+  parse_errc convert_floating(string_ref argument, double& value,
+                              double max) noexcept;
+  parse_errc convert_byte_size(string_ref argument,
+                               unsigned long long& value) noexcept;
+  parse_errc convert_duration(string_ref argument,
+                              std::intmax_t num, std::intmax_t den,
+                              bool integral, long long& count,
+                              long double& real) noexcept;
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  template <>
+  struct converter<std::string> {
+    static const char* argument_name() noexcept { return "STRING"; }
+    static parse_errc convert(string_ref argument, std::string& value) {
+      value.assign(argument.data(), argument.size());
+      return parse_errc::none;
+    }
+  };
+  template <typename T>
+  struct converter<T, typename std::enable_if<std::is_integral<T>::value
+                                              && std::is_signed<T>::value>::type> {
+    static const char* argument_name() noexcept { return "INTEGER"; }
+    static parse_errc convert(string_ref argument, T& value) noexcept {
+      long long wide = 0;
+      auto err = convert_integer(argument, wide,
+                                 std::numeric_limits<T>::min(),
+                                 std::numeric_limits<T>::max());
+      if (err == parse_errc::none)
+        value = static_cast<T>(wide);
+      return err;
+    }
+  };
+  template <typename T>
+  struct converter<T, typename std::enable_if<std::is_integral<T>::value
+                                              && std::is_unsigned<T>::value
+                                              && !std::is_same<T, bool>::value>::type> {
+    static const char* argument_name() noexcept { return "INTEGER"; }
+    static parse_errc convert(string_ref argument, T& value) noexcept {
+      unsigned long long wide = 0;
+      auto err = convert_unsigned(argument, wide, std::numeric_limits<T>::max());
+      if (err == parse_errc::none)
+        value = static_cast<T>(wide);
+      return err;
+    }
+  };
+  template <typename T>
+  struct converter<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    static const char* argument_name() noexcept { return "NUMBER"; }
+    static parse_errc convert(string_ref argument, T& value) noexcept {
+      const double max = std::numeric_limits<T>::max() < std::numeric_limits<double>::max()
+        ? static_cast<double>(std::numeric_limits<T>::max())
+        : std::numeric_limits<double>::max();
+      double wide = 0;
+      auto err = convert_floating(argument, wide, max);
+      if (err == parse_errc::none)
+        value = static_cast<T>(wide);
+      return err;
+    }
+  };
+  template <typename Rep, typename Period>
+  struct converter<std::chrono::duration<Rep, Period>> {
+    static const char* argument_name() noexcept { return "DURATION"; }
+    static parse_errc convert(string_ref argument,
+                              std::chrono::duration<Rep, Period>& value) noexcept {
+      long long count = 0;
+      long double real = 0;
+      auto err = convert_duration(argument, Period::num, Period::den,
+                                  std::is_integral<Rep>::value, count, real);
+      if (err != parse_errc::none)
+        return err;
+      return store(count, real, value, std::is_integral<Rep>{});
+    }
+  private:
+    static parse_errc store(long long count, long double,
+                            std::chrono::duration<Rep, Period>& value,
+                            std::true_type) noexcept {
+      const bool out_of_range = count < 0
+        ? count < static_cast<long long>(std::numeric_limits<Rep>::min())
+        : static_cast<unsigned long long>(count)
+          > static_cast<unsigned long long>(std::numeric_limits<Rep>::max());
+      if (out_of_range)
+        return parse_errc::out_of_range;
+      value = std::chrono::duration<Rep, Period>{static_cast<Rep>(count)};
+      return parse_errc::none;
+    }
+    static parse_errc store(long long, long double real,
+                            std::chrono::duration<Rep, Period>& value,
+                            std::false_type) noexcept {
+      value = std::chrono::duration<Rep, Period>{static_cast<Rep>(real)};
+      return parse_errc::none;
+    }
+  };
+  template <>
+  struct converter<byte_size> {
+    static const char* argument_name() noexcept { return "SIZE"; }
+    static parse_errc convert(string_ref argument, byte_size& value) noexcept {
+      return convert_byte_size(argument, value.bytes);
+    }
+  };
+  template <typename T>
+  struct converter<T, typename std::enable_if<std::is_enum<T>::value>::type> {
+    static const char* argument_name() noexcept { return "VALUE"; }
+    static parse_errc convert(string_ref argument, T& value) {
+      return find(argument, value, 0);
+    }
+  private:
+    template <typename U>
+    static auto find(string_ref argument, U& value, int)
+      -> decltype(enum_names<U>::names(), parse_errc{}) {
+      for (const auto& entry : enum_names<U>::names()) {
+        if (argument == string_ref{entry.first}) {
+          value = entry.second;
+          return parse_errc::none;
+        }
+      }
+      return parse_errc::invalid_value;
+    }
+    template <typename U>
+    static parse_errc find(string_ref argument, U& value, long) {
+      using underlying = typename std::underlying_type<U>::type;
+      underlying number{};
+      auto err = converter<underlying>::convert(argument, number);
+      if (err == parse_errc::none)
+        value = static_cast<U>(number);
+      return err;
+    }
+  };
+#endif
+}
+
+
+namespace optionpp {
+  class text_arena {
+  public:
+    using size_type = std::size_t;
+    explicit text_arena(size_type block_size = 4096) noexcept
+      : m_block_size{block_size ? block_size : 1} {}
+    text_arena(const text_arena&) = delete;
+    text_arena& operator=(const text_arena&) = delete;
+    text_arena(text_arena&& other) noexcept;
+    text_arena& operator=(text_arena&& other) noexcept;
+    string_ref store(string_ref str);
+    string_ref store(string_ref a, string_ref b,
+                     string_ref c = string_ref{});
+    void clear() noexcept {
+      m_current = 0;
+      m_used = 0;
+    }
+    void release() noexcept {
+      m_blocks.clear();
+      clear();
+    }
+  private:
+    struct block {
+      std::unique_ptr<char[]> data;
+      size_type size;
+    };
+    char* allocate(size_type length);
+    std::vector<block> m_blocks;
+    size_type m_block_size;
+    size_type m_current{0};
+    size_type m_used{0};
+  };
+}
+
+
+namespace optionpp {
+  class text_pool {
+  public:
+    using size_type = std::size_t;
+    struct span {
+      std::uint32_t offset;
+      std::uint32_t size;
+    };
+    text_pool() noexcept {}
+    text_pool(const text_pool&) = delete;
+    text_pool& operator=(const text_pool&) = delete;
+    span store(string_ref str);
+    string_ref get(span s) const noexcept {
+      if (s.size == 0)
+        return string_ref{};
+      size_type b = block_of(s.offset);
+      return string_ref{m_blocks[b].get() + (s.offset - block_start(b)), s.size};
+    }
+    size_type size() const noexcept { return m_end; }
+  private:
+    static const size_type first_block_size = 64;
+    static const size_type max_blocks = 26;
+    static size_type block_start(size_type b) noexcept {
+      return first_block_size * ((size_type{1} << b) - 1);
+    }
+    static size_type block_of(std::uint32_t offset) noexcept {
+      std::uint32_t x = offset / first_block_size + 1;
+#ifdef __GNUC__
+      return static_cast<size_type>(31 - __builtin_clz(x));
+#else
+      size_type b = 0;
+      while (x >>= 1)
+        ++b;
+      return b;
+#endif
+    }
+    std::unique_ptr<char[]> m_blocks[max_blocks];
+    size_type m_end{0};
+  };
+}
+
+
+namespace optionpp {
+  class tokenizer {
+  public:
+    using size_type = string_ref::size_type;
+    explicit tokenizer(const std::string& delims = " \t\n\r",
+                       const std::string& quotes = "\"\'",
+                       char escape_char = '\\',
+                       bool allow_empty = false);
+    bool next(string_ref input, size_type& pos, string_ref& token,
+              std::string& buffer) const;
+    template <typename OutputIt>
+    void split(string_ref input, OutputIt dest, text_arena& storage) const;
+  private:
+    enum char_class : unsigned char { plain = 0,
+                                      delim = 1,
+                                      quote = 2,
+                                      escape = 4
+    };
+    const char* find_special(const char* first, const char* last) const noexcept;
+    bool finish_token(string_ref input, size_type& pos,
+                      std::string& buffer) const;
+    std::array<unsigned char, 256> m_classes;
+    std::string m_specials;
+    bool m_allow_empty;
+  };
+}
+template <typename OutputIt>
+void optionpp::tokenizer::split(string_ref input, OutputIt dest,
+                                text_arena& storage) const {
+  std::string buffer;
+  string_ref token;
+  size_type pos = 0;
+  while (next(input, pos, token, buffer)) {
+    if (token.data() == buffer.data())
+      token = storage.store(token);
+    *dest++ = token;
+  }
+}
+
+
+namespace optionpp {
+  class mapped_file {
+  public:
+    using size_type = std::size_t;
+    struct id_type {
+      unsigned long long device{0};
+      unsigned long long file{0};
+      bool operator==(const id_type& other) const noexcept {
+        return device == other.device && file == other.file;
+      }
+      bool operator!=(const id_type& other) const noexcept {
+        return !(*this == other);
+      }
+    };
+    mapped_file() noexcept {}
+    explicit mapped_file(const std::string& path) { open(path); }
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    ~mapped_file() { close(); }
+    bool open(const std::string& path);
+    void close() noexcept;
+    bool is_open() const noexcept { return m_open; }
+    string_ref contents() const noexcept { return string_ref{m_data, m_size}; }
+    const id_type& id() const noexcept { return m_id; }
+  private:
+    bool read(const std::string& path);
+    const char* m_data{nullptr};
+    size_type m_size{0};
+    id_type m_id;
+    bool m_open{false};
+    bool m_mapped{false};
+    std::string m_buffer;
+  };
 }
 
 
@@ -72,6 +689,9 @@ namespace optionpp {
                           int line_len,
                           int indent,
                           int first_line_indent);
+    template <typename OutputIt>
+    OutputIt wrap_text(string_ref str, OutputIt dest,
+                       int line_len, int indent, int first_line_indent);
     bool is_substr_at_pos(const std::string& str, const std::string& substr,
                           std::string::size_type pos = 0) noexcept;
   }
@@ -82,121 +702,363 @@ void optionpp::utility::split(const std::string& str, OutputIt dest,
                               const std::string& quotes,
                               char escape_char,
                               bool allow_empty) {
-  using size_type = decltype(str.size());
-  size_type pos{0};
-  bool escape_next{false};
-  bool in_quotes{false};
-  size_type quote_index{0};
-  std::string cur_token;
-  while (pos < str.size()) {
-    if (in_quotes) {
-      if (escape_next || str[pos] != quotes[quote_index]) {
-        if (!escape_next && str[pos] == escape_char)
-          escape_next = true;
-        else {
-          cur_token.push_back(str[pos]);
-          escape_next = false;
-        }
-      } else {
-        in_quotes = false;
+  tokenizer tok{delims, quotes, escape_char, allow_empty};
+  std::string buffer;
+  string_ref token;
+  tokenizer::size_type pos{0};
+  while (tok.next(str, pos, token, buffer))
+    *dest++ = token.str();
+}
+template <typename OutputIt>
+OutputIt optionpp::utility::wrap_text(string_ref str, OutputIt dest,
+                                      int line_len, int indent,
+                                      int first_line_indent) {
+  using size_type = string_ref::size_type;
+  auto is_space = [](char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+  };
+  auto fill = [&dest](int count) {
+    for (; count > 0; --count)
+      *dest++ = ' ';
+  };
+  if (line_len > 0) {
+    if (indent < 0)
+      indent = 0;
+    else if (indent > line_len - 1)
+      indent = line_len - 1;
+    if (first_line_indent < 0)
+      first_line_indent = 0;
+    else if (first_line_indent > line_len - 1)
+      first_line_indent = line_len - 1;
+  }
+  bool written = false;
+  size_type line_start = 0;
+  while (line_start <= str.size()) {
+    size_type line_end = str.find('\n', line_start);
+    if (line_end == string_ref::npos)
+      line_end = str.size();
+    const string_ref line = str.substr(line_start, line_end - line_start);
+    const int cur_first_indent = line_start == 0 ? first_line_indent : indent;
+    line_start = line_end + 1;
+    if (written)
+      *dest++ = '\n';
+    if (line_len <= 0) {
+      fill(cur_first_indent);
+      dest = std::copy(line.begin(), line.end(), dest);
+      written = written || cur_first_indent > 0 || !line.empty();
+      continue;
+    }
+    bool line_written = false;
+    size_type pos = 0;
+    while (pos < line.size()) {
+      const int cur_indent = line_written ? indent : cur_first_indent;
+      size_type start = pos;
+      if (line_written) {
+        while (start < line.size() && is_space(line[start]))
+          ++start;
       }
-    } else {
-      if (escape_next || delims.find(str[pos]) == std::string::npos) {
-        if (!escape_next && str[pos] == escape_char)
-          escape_next = true;
-        else if (escape_next) {
-          cur_token.push_back(str[pos]);
-          escape_next = false;
-        } else {
-          quote_index = quotes.find(str[pos]);
-          if (quote_index != std::string::npos)
-            in_quotes = true;
-          else
-            cur_token.push_back(str[pos]);
-        }
-      } else {
-        if (!cur_token.empty() || allow_empty)
-          *dest++ = cur_token;
-        cur_token.clear();
+      size_type end = start + (line_len - cur_indent);
+      if (end > line.size())
+        end = line.size();
+      if (end < line.size()) {
+        size_type word_start = end;
+        while (word_start > start && !is_space(line[word_start]))
+          --word_start;
+        if (word_start > start)
+          end = word_start;
+      }
+      pos = end;
+      while (end > start && is_space(line[end - 1]))
+        --end;
+      if (end > start) {
+        if (line_written)
+          *dest++ = '\n';
+        fill(cur_indent);
+        dest = std::copy(line.begin() + start, line.begin() + end, dest);
+        line_written = true;
+        written = true;
       }
     }
-    ++pos;
   }
-  if (!cur_token.empty() || allow_empty)
-    *dest++ = cur_token;
+  return dest;
+}
+
+
+namespace optionpp {
+  class parse_target {
+  public:
+    parse_target() noexcept {}
+    template <typename C>
+    explicit parse_target(C& object) noexcept
+      : m_object{&object}, m_type{type_id<C>()} {}
+    void* object(const void* type) const noexcept;
+    template <typename C>
+    static const void* type_id() noexcept { return &type_tag<C>::id; }
+  private:
+    template <typename C>
+    struct type_tag {
+      static const char id;
+    };
+    void* m_object{nullptr};
+    const void* m_type{nullptr};
+  };
 }
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <typename C>
+const char optionpp::parse_target::type_tag<C>::id = 0;
+#endif
 
 
 namespace optionpp {
+  class option;
+  class change_tracker {
+  public:
+    struct change_log {
+      std::atomic<unsigned long> changes{1};
+      std::vector<const option*> renamed;
+      std::size_t rename_limit{64};
+      bool moved{true};
+      std::shared_ptr<text_pool> text;
+      const std::shared_ptr<text_pool>& pool() {
+        if (!text)
+          text = std::make_shared<text_pool>();
+        return text;
+      }
+    };
+    change_tracker() noexcept {}
+    change_tracker(const change_tracker&) noexcept {}
+    change_tracker& operator=(const change_tracker&) noexcept {
+      notify_moved();
+      return *this;
+    }
+    void attach(change_log* log) noexcept { m_log = log; }
+    change_log* log() const noexcept { return m_log; }
+    void notify() const noexcept {
+      if (m_log)
+        m_log->changes.fetch_add(1, std::memory_order_release);
+    }
+    void notify_renamed(const option& opt) const noexcept {
+      if (!m_log)
+        return;
+      notify();
+      if (m_log->moved)
+        return;
+      if (m_log->renamed.size() >= m_log->rename_limit) {
+        m_log->moved = true;
+        return;
+      }
+      try {
+        m_log->renamed.push_back(&opt);
+      } catch (...) {
+        m_log->moved = true;
+      }
+    }
+    void notify_moved() const noexcept {
+      if (m_log) {
+        notify();
+        m_log->moved = true;
+      }
+    }
+  private:
+    change_log* m_log{nullptr};
+  };
   class option {
   public:
     enum arg_type { string_arg,
                     int_arg,
                     uint_arg,
-                    double_arg
+                    double_arg,
+                    custom_arg
     };
     option() noexcept {}
     option(char short_name) : m_short_name{short_name} {}
-    option(const std::string& long_name,
+    option(string_ref long_name,
            char short_name = '\0',
-           const std::string& description = "",
-           const std::string& arg_name = "",
+           string_ref description = string_ref{},
+           string_ref arg_name = string_ref{},
            bool arg_required = false);
-    option& name(const std::string& long_name, char short_name = '\0') {
-      m_long_name = long_name;
+    option& name(string_ref long_name, char short_name = '\0') {
+      set_text(m_long_name, long_name);
       m_short_name = short_name;
+      m_tracker.notify_renamed(*this);
       return *this;
     }
-    std::string name() const noexcept {
-      if (!m_long_name.empty())
-        return m_long_name;
+    std::string name() const {
+      if (m_long_name.size != 0)
+        return long_name().str();
       else if (m_short_name != '\0')
         return std::string{m_short_name};
       else
         return "";
     }
-    option& long_name(const std::string& name) {
-      m_long_name = name;
+    option& long_name(string_ref name) {
+      set_text(m_long_name, name);
+      m_tracker.notify_renamed(*this);
       return *this;
     }
-    const std::string& long_name() const noexcept { return m_long_name; }
+    string_ref long_name() const noexcept { return text(m_long_name); }
     option& short_name(char name) noexcept {
       m_short_name = name;
+      m_tracker.notify_renamed(*this);
       return *this;
     }
     char short_name() const noexcept { return m_short_name; }
-    option& argument(const std::string& name,
+    option& argument(string_ref name,
                      bool required = true);
-    const std::string& argument_name() const noexcept { return m_arg_name; }
+    string_ref argument_name() const noexcept { return text(m_arg_name); }
     bool is_argument_required() const noexcept { return m_arg_required; }
     arg_type argument_type() const noexcept { return m_arg_type; }
     option& bind_bool(bool* var) noexcept;
-    option& bind_string(std::string* var) noexcept;
-    option& bind_int(int* var) noexcept;
-    option& bind_uint(unsigned int* var) noexcept;
-    option& bind_double(double* var) noexcept;
-    bool has_bound_argument_variable() const noexcept { return m_bound_variable; }
+    option& bind_string(std::string* var);
+    option& bind_int(int* var);
+    option& bind_uint(unsigned int* var);
+    option& bind_double(double* var);
+    template <typename T>
+    option& bind(T* var);
+    template <typename C, typename T>
+    option& bind(T C::* member);
+    template <typename C>
+    option& bind_bool(bool C::* member) noexcept;
+    bool has_bound_argument_variable() const noexcept {
+      return m_bound_variable || m_target_type;
+    }
+    parse_errc write_argument(string_ref argument, bool store = true) const {
+      if (!has_bound_argument_variable())
+        return parse_errc::none;
+      return m_writer(argument, m_bound_variable, &m_member,
+                      store && m_bound_variable);
+    }
+    parse_errc write_argument(string_ref argument, const parse_target& target,
+                              bool store = true) const {
+      if (!has_bound_argument_variable())
+        return parse_errc::none;
+      void* object = m_target_type ? target.object(m_target_type) : nullptr;
+      return m_writer(argument, object, &m_member, store && object);
+    }
     void write_bool(bool value) const noexcept;
+    void write_bool(bool value, const parse_target& target) const noexcept {
+      void* object = m_flag_target_type ? target.object(m_flag_target_type)
+                                        : nullptr;
+      if (object)
+        m_flag_writer(object, &m_flag_member, value);
+    }
     void write_string(const std::string& value) const;
     void write_int(int value) const;
     void write_uint(unsigned int value) const;
     void write_double(double value) const;
-    option& description(const std::string& desc) {
-      m_desc = desc;
+    option& description(string_ref desc) {
+      set_text(m_desc, desc);
+      m_tracker.notify();
       return *this;
     }
-    const std::string& description() const noexcept { return m_desc; }
+    string_ref description() const noexcept { return text(m_desc); }
   private:
-    std::string m_long_name;
+    string_ref text(text_pool::span s) const noexcept {
+      return s.size != 0 ? m_text->get(s) : string_ref{};
+    }
+    void set_text(text_pool::span& field, string_ref value);
+    void move_text(const std::shared_ptr<text_pool>& pool);
+    using argument_writer = parse_errc (*)(string_ref argument, void* var,
+                                           const void* member, bool store);
+    using flag_writer = void (*)(void* object, const void* member, bool value);
+    using member_storage = std::aligned_storage<2 * sizeof(std::ptrdiff_t),
+                                                alignof(std::ptrdiff_t)>::type;
+    template <typename T>
+    static parse_errc write_converted(string_ref argument, void* var,
+                                      const void* member, bool store) {
+      (void) member;
+      if (store)
+        return converter<T>::convert(argument, *static_cast<T*>(var));
+      T value{};
+      return converter<T>::convert(argument, value);
+    }
+    template <typename C, typename T>
+    static parse_errc write_member(string_ref argument, void* object,
+                                   const void* member, bool store) {
+      if (store)
+        return converter<T>::convert(argument,
+                                     static_cast<C*>(object)->*load<T C::*>(member));
+      T value{};
+      return converter<T>::convert(argument, value);
+    }
+    template <typename C>
+    static void write_flag(void* object, const void* member, bool value) {
+      static_cast<C*>(object)->*load<bool C::*>(member) = value;
+    }
+    template <typename M>
+    static void store(member_storage& storage, M member) noexcept {
+      static_assert(sizeof(M) <= sizeof(member_storage),
+                    "member pointer too large to bind");
+      std::memcpy(&storage, &member, sizeof(M));
+    }
+    template <typename M>
+    static M load(const void* storage) noexcept {
+      M member;
+      std::memcpy(&member, storage, sizeof(M));
+      return member;
+    }
+    template <typename T>
+    static constexpr arg_type type_of(const T*) noexcept { return custom_arg; }
+    static constexpr arg_type type_of(const std::string*) noexcept { return string_arg; }
+    static constexpr arg_type type_of(const int*) noexcept { return int_arg; }
+    static constexpr arg_type type_of(const unsigned*) noexcept { return uint_arg; }
+    static constexpr arg_type type_of(const double*) noexcept { return double_arg; }
+    std::shared_ptr<text_pool> m_text;
+    text_pool::span m_long_name{0, 0};
+    text_pool::span m_desc{0, 0};
+    text_pool::span m_arg_name{0, 0};
     char m_short_name{'\0'};
-    std::string m_desc;
-    std::string m_arg_name;
     bool m_arg_required{false};
     arg_type m_arg_type{string_arg};
     bool* m_is_option_set = nullptr;
     void* m_bound_variable = nullptr;
+    const void* m_target_type = nullptr;
+    member_storage m_member{};
+    argument_writer m_writer = nullptr;
+    const void* m_flag_target_type = nullptr;
+    member_storage m_flag_member{};
+    flag_writer m_flag_writer = nullptr;
+    change_tracker m_tracker;
+    friend class option_group;
+    friend class parser;
   };
 }
+template <typename T>
+optionpp::option& optionpp::option::bind(T* var) {
+  if (var && m_arg_name.size == 0) {
+    set_text(m_arg_name, converter<T>::argument_name());
+    m_arg_required = true;
+  }
+  m_arg_type = type_of(var);
+  m_bound_variable = var;
+  m_target_type = nullptr;
+  m_writer = &write_converted<T>;
+  m_tracker.notify();
+  return *this;
+}
+template <typename C, typename T>
+optionpp::option& optionpp::option::bind(T C::* member) {
+  if (member && m_arg_name.size == 0) {
+    set_text(m_arg_name, converter<T>::argument_name());
+    m_arg_required = true;
+  }
+  m_arg_type = type_of(static_cast<T*>(nullptr));
+  m_bound_variable = nullptr;
+  m_target_type = member ? parse_target::type_id<C>() : nullptr;
+  store(m_member, member);
+  m_writer = &write_member<C, T>;
+  m_tracker.notify();
+  return *this;
+}
+template <typename C>
+optionpp::option& optionpp::option::bind_bool(bool C::* member) noexcept {
+  m_is_option_set = nullptr;
+  m_flag_target_type = member ? parse_target::type_id<C>() : nullptr;
+  store(m_flag_member, member);
+  m_flag_writer = &write_flag<C>;
+  m_tracker.notify();
+  return *this;
+}
 
 
 namespace optionpp {
@@ -217,7 +1079,12 @@ namespace optionpp {
       : m_name{name}, m_options{first, last} {}
     const std::string& name() const noexcept { return m_name; }
     option& add_option(const option& opt = option{}) {
-      m_options.push_back(opt);
+      return add_option(option{opt});
+    }
+    option& add_option(option&& opt) {
+      const option* old_data = m_options.data();
+      m_options.push_back(std::move(opt));
+      track_new_options(old_data, m_options.size() - 1);
       return m_options.back();
     }
     option& add_option(const std::string& long_name,
@@ -225,8 +1092,20 @@ namespace optionpp {
                        const std::string& description = "",
                        const std::string& arg_name = "",
                        bool arg_required = false);
+    template <typename InputIt>
+    void add_options(InputIt first, InputIt last) {
+      const option* old_data = m_options.data();
+      size_type old_size = m_options.size();
+      m_options.insert(m_options.end(), first, last);
+      track_new_options(old_data, old_size);
+    }
     size_type size() const noexcept { return m_options.size(); }
     bool empty() const noexcept { return m_options.empty(); }
+    void reserve(size_type count) {
+      const option* old_data = m_options.data();
+      m_options.reserve(count);
+      track_new_options(old_data, m_options.size());
+    }
     iterator begin() noexcept { return m_options.begin(); }
     const_iterator begin() const noexcept { return cbegin(); }
     iterator end() noexcept { return m_options.end(); }
@@ -247,8 +1126,64 @@ namespace optionpp {
     option& operator[](const std::string long_name);
     option& operator[](char short_name);
   private:
+    void attach(change_tracker::change_log* log) noexcept;
+    void track_new_options(const option* old_data, size_type first) noexcept;
+    void adopt_text(size_type first) noexcept;
     std::string m_name;
     container_type m_options;
+    change_tracker m_tracker;
+    friend class parser;
+  };
+}
+
+
+namespace optionpp {
+  class option_index {
+  public:
+    using size_type = std::size_t;
+    using name_iterator = std::vector<const option*>::const_iterator;
+    option_index() noexcept { m_short_names.fill(nullptr); }
+    void clear() noexcept;
+    void reserve(size_type count);
+    void insert(const option& opt);
+    bool optimize();
+    bool is_optimized() const noexcept { return !m_displacements.empty(); }
+    size_type size() const noexcept { return m_options.size(); }
+    bool empty() const noexcept { return m_options.empty() && m_short_count == 0; }
+    const option* find(const std::string& long_name) const noexcept {
+      return find(long_name.data(), long_name.size());
+    }
+    const option* find(const char* long_name, size_type length) const noexcept;
+    bool has_renamed(const std::string& long_name) const noexcept;
+    const option* find(char short_name) const noexcept {
+      return m_short_names[static_cast<unsigned char>(short_name)];
+    }
+    void sort_names();
+    std::pair<name_iterator, name_iterator>
+    find_prefix(const char* prefix, size_type length) const;
+    static std::size_t hash(const char* str, size_type length) noexcept;
+  private:
+    static const std::uint32_t npos = static_cast<std::uint32_t>(-1);
+    struct slot {
+      std::uint32_t hash;
+      std::uint32_t id;
+    };
+    size_type probe(string_ref name, std::uint32_t h) const noexcept;
+    void rehash(size_type count);
+    size_type bucket(std::uint32_t h) const noexcept {
+      return (h ^ (h >> 16)) & (m_displacements.size() - 1);
+    }
+    size_type displaced_slot(std::uint32_t h,
+                             std::uint32_t displacement) const noexcept;
+    std::vector<const option*> m_options;
+    std::vector<std::uint32_t> m_hashes;
+    std::vector<slot> m_table;
+    std::vector<slot> m_slots;
+    std::vector<std::uint32_t> m_displacements;
+    std::array<const option*, 256> m_short_names;
+    size_type m_short_count{0};
+    std::vector<std::uint32_t> m_sorted_ids;
+    std::vector<const option*> m_names;
   };
 }
 
@@ -280,27 +1215,118 @@ namespace optionpp {
     using const_iterator = container_type::const_iterator;
     using reverse_iterator = container_type::reverse_iterator;
     using const_reverse_iterator = container_type::const_reverse_iterator;
+    class occurrence_list {
+    public:
+      class const_iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = parsed_entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const parsed_entry*;
+        using reference = const parsed_entry&;
+        const_iterator() noexcept {}
+        reference operator*() const noexcept { return (*m_result)[m_index]; }
+        pointer operator->() const noexcept { return &**this; }
+        const_iterator& operator++() noexcept {
+          m_index = m_result->m_index.links[m_index];
+          return *this;
+        }
+        const_iterator operator++(int) noexcept {
+          const_iterator temp{*this};
+          ++*this;
+          return temp;
+        }
+        bool operator==(const const_iterator& other) const noexcept {
+          return m_index == other.m_index;
+        }
+        bool operator!=(const const_iterator& other) const noexcept {
+          return !(*this == other);
+        }
+      private:
+        friend class occurrence_list;
+        const_iterator(const parser_result* result, size_type index) noexcept
+          : m_result{result}, m_index{index} {}
+        const parser_result* m_result{nullptr};
+        size_type m_index{npos};
+      };
+      occurrence_list() noexcept {}
+      const_iterator begin() const noexcept {
+        return const_iterator{m_result, m_first};
+      }
+      const_iterator end() const noexcept { return const_iterator{}; }
+      size_type size() const noexcept { return m_size; }
+      bool empty() const noexcept { return m_size == 0; }
+    private:
+      friend class parser_result;
+      occurrence_list(const parser_result* result, size_type first,
+                      size_type size) noexcept
+        : m_result{result}, m_first{first}, m_size{size} {}
+      const parser_result* m_result{nullptr};
+      size_type m_first{npos};
+      size_type m_size{0};
+    };
     parser_result() noexcept {}
     parser_result(const std::initializer_list<value_type>& il)
-      : m_entries{il} {}
+      : m_entries{il}, m_size{m_entries.size()} { rebuild_index(); }
     template <typename InputIt>
-    parser_result(InputIt first, InputIt last) : m_entries{first, last} {}
-    void push_back(const value_type& entry) { m_entries.push_back(entry); }
-    void push_back(value_type&& entry) { m_entries.push_back(std::move(entry)); }
-    void clear() noexcept { m_entries.clear(); }
-    size_type size() const noexcept { return m_entries.size(); }
-    bool empty() const noexcept { return m_entries.empty(); }
-    iterator begin() noexcept { return m_entries.begin(); }
+    parser_result(InputIt first, InputIt last)
+      : m_entries{first, last}, m_size{m_entries.size()} { rebuild_index(); }
+    parser_result(const parser_result& other)
+      : m_entries{other.begin(), other.end()}, m_size{other.m_size} {
+      rebuild_index();
+    }
+    parser_result(parser_result&& other) noexcept
+      : m_entries{std::move(other.m_entries)}, m_size{other.m_size},
+        m_index{std::move(other.m_index)},
+        m_pending{other.m_pending.load(std::memory_order_relaxed)} {
+      other.m_entries.clear();
+      other.m_size = 0;
+      other.m_index.clear();
+      other.m_pending.store(false, std::memory_order_relaxed);
+    }
+    parser_result& operator=(const parser_result& other);
+    parser_result& operator=(parser_result&& other) noexcept;
+    void push_back(const value_type& entry) {
+      next_entry() = entry;
+      if (!m_index.stale)
+        index_entry(m_size - 1);
+    }
+    void push_back(value_type&& entry) {
+      next_entry() = std::move(entry);
+      if (!m_index.stale)
+        index_entry(m_size - 1);
+    }
+    void clear() noexcept;
+    void reserve(size_type count) {
+      m_entries.reserve(count);
+      m_index.links.reserve(count);
+    }
+    void shrink_to_fit() {
+      m_entries.erase(m_entries.begin() + m_size, m_entries.end());
+      m_entries.shrink_to_fit();
+      m_index.links.shrink_to_fit();
+    }
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+    iterator begin() noexcept {
+      mark_stale();
+      return m_entries.begin();
+    }
     const_iterator begin() const noexcept { return cbegin(); }
-    iterator end() noexcept { return m_entries.end(); }
+    iterator end() noexcept { return begin() + m_size; }
     const_iterator end() const noexcept { return cend(); }
     const_iterator cbegin() const noexcept { return m_entries.cbegin(); }
-    const_iterator cend() const noexcept { return m_entries.cend(); }
-    reverse_iterator rbegin() noexcept { return m_entries.rbegin(); }
+    const_iterator cend() const noexcept { return cbegin() + m_size; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
     const_reverse_iterator rbegin() const noexcept { return crbegin(); }
-    reverse_iterator rend() noexcept { return m_entries.rend(); }
+    reverse_iterator rend() noexcept {
+      mark_stale();
+      return m_entries.rend();
+    }
     const_reverse_iterator rend() const noexcept { return crend(); }
-    const_reverse_iterator crbegin() const noexcept { return m_entries.crbegin(); }
+    const_reverse_iterator crbegin() const noexcept {
+      return const_reverse_iterator{cend()};
+    }
     const_reverse_iterator crend() const noexcept { return m_entries.crend(); }
     value_type& at(size_type index) {
       if (index >= size())
@@ -314,7 +1340,10 @@ namespace optionpp {
                            "optionpp::parser_result::at");
       return (*this)[index];
     }
-    value_type& operator[](size_type index) { return m_entries[index]; }
+    value_type& operator[](size_type index) {
+      mark_stale();
+      return m_entries[index];
+    }
     const value_type& operator[](size_type index) const {
       return m_entries[index];
     }
@@ -322,20 +1351,258 @@ namespace optionpp {
       if (empty())
         throw out_of_range("out of bounds parser_result access",
                            "optionpp::parser_result::back");
-      return m_entries.back();
+      mark_stale();
+      return m_entries[m_size - 1];
     }
     const value_type& back() const {
       if (empty())
         throw out_of_range("out of bounds parser_result access",
                            "optionpp::parser_result::at");
+      return m_entries[m_size - 1];
+    }
+    bool is_option_set(const std::string& long_name) const {
+      return find_record(long_name) != nullptr;
+    }
+    bool is_option_set(char short_name) const {
+      return find_record(short_name) != nullptr;
+    }
+    bool is_option_set(const option& opt) const {
+      return find_record(opt) != nullptr;
+    }
+    size_type count(const std::string& long_name) const {
+      const option_record* r = find_record(long_name);
+      return r ? r->count : 0;
+    }
+    size_type count(char short_name) const {
+      const option_record* r = find_record(short_name);
+      return r ? r->count : 0;
+    }
+    size_type count(const option& opt) const {
+      const option_record* r = find_record(opt);
+      return r ? r->count : 0;
+    }
+    occurrence_list occurrences(const std::string& long_name) const {
+      return make_occurrences(find_record(long_name));
+    }
+    occurrence_list occurrences(char short_name) const {
+      return make_occurrences(find_record(short_name));
+    }
+    occurrence_list occurrences(const option& opt) const {
+      return make_occurrences(find_record(opt));
+    }
+    const std::string& get_argument(const std::string& long_name) const {
+      return last_argument(find_record(long_name));
+    }
+    const std::string& get_argument(char short_name) const {
+      return last_argument(find_record(short_name));
+    }
+    const std::string& get_argument(const option& opt) const {
+      return last_argument(find_record(opt));
+    }
+  private:
+    friend class compiled_parser;
+    value_type& next_entry() {
+      if (m_size == m_entries.size())
+        m_entries.emplace_back();
+      return m_entries[m_size++];
+    }
+    static const size_type npos = static_cast<size_type>(-1);
+    struct option_record {
+      const option* opt_info;
+      size_type first;
+      size_type last;
+      size_type count;
+    };
+    struct name_slot {
+      std::size_t hash;
+      size_type record;
+      size_type entry;
+      char short_name;
+    };
+    struct index_data {
+      void clear() noexcept;
+      std::vector<option_record> records;
+      std::vector<size_type> by_option;
+      std::vector<name_slot> by_name;
+      size_type name_count{0};
+      std::vector<size_type> links;
+      size_type named_records{0};
+      bool stale{false};
+    };
+    void mark_stale() noexcept {
+      m_index.stale = true;
+      m_pending.store(true, std::memory_order_relaxed);
+    }
+    const index_data& current_index() const;
+    void name_records() const;
+    void rebuild_index() const;
+    void index_entry(size_type index) const;
+    size_type probe_name(std::size_t hash, const std::string* long_name,
+                         char short_name) const noexcept;
+    void insert_name(std::size_t hash, size_type index, char short_name,
+                     size_type record) const;
+    size_type probe_option(const option* opt) const noexcept;
+    void insert_option(size_type record) const;
+    const option_record* find_record(const std::string& long_name) const;
+    const option_record* find_record(char short_name) const;
+    const option_record* find_record(const option& opt) const;
+    occurrence_list make_occurrences(const option_record* r) const noexcept {
+      return r ? occurrence_list{this, r->first, r->count} : occurrence_list{};
+    }
+    const std::string& last_argument(const option_record* r) const noexcept;
+    container_type m_entries;
+    size_type m_size{0};
+    mutable index_data m_index;
+    mutable std::atomic<bool> m_pending{false};
+    mutable std::mutex m_index_mutex;
+  };
+}
+
+
+namespace optionpp {
+  struct parsed_entry_ref {
+    string_ref original_text;
+    string_ref original_without_argument;
+    bool is_option{false};
+    string_ref long_name;
+    char short_name{'\0'};
+    string_ref argument;
+    const option* opt_info{nullptr};
+    parsed_entry to_entry() const;
+  };
+  class parser_result_ref {
+  public:
+    using value_type = parsed_entry_ref;
+    using container_type = std::vector<value_type>;
+    using size_type = container_type::size_type;
+    using iterator = container_type::iterator;
+    using const_iterator = container_type::const_iterator;
+    parser_result_ref() noexcept {}
+    parser_result_ref(const parser_result_ref&) = delete;
+    parser_result_ref& operator=(const parser_result_ref&) = delete;
+    parser_result_ref(parser_result_ref&& other) noexcept = default;
+    parser_result_ref& operator=(parser_result_ref&& other) noexcept = default;
+    void push_back(const value_type& entry) { m_entries.push_back(entry); }
+    string_ref store(string_ref str) { return m_text.store(str); }
+    string_ref store(string_ref a, string_ref b, string_ref c = string_ref{}) {
+      return m_text.store(a, b, c);
+    }
+    void clear() noexcept {
+      m_entries.clear();
+      m_text.clear();
+    }
+    size_type size() const noexcept { return m_entries.size(); }
+    bool empty() const noexcept { return m_entries.empty(); }
+    iterator begin() noexcept { return m_entries.begin(); }
+    const_iterator begin() const noexcept { return cbegin(); }
+    iterator end() noexcept { return m_entries.end(); }
+    const_iterator end() const noexcept { return cend(); }
+    const_iterator cbegin() const noexcept { return m_entries.cbegin(); }
+    const_iterator cend() const noexcept { return m_entries.cend(); }
+    const value_type& at(size_type index) const {
+      if (index >= size())
+        throw out_of_range("out of bounds parser_result_ref access",
+                           "optionpp::parser_result_ref::at");
+      return m_entries[index];
+    }
+    value_type& operator[](size_type index) { return m_entries[index]; }
+    const value_type& operator[](size_type index) const {
+      return m_entries[index];
+    }
+    value_type& back() {
+      if (empty())
+        throw out_of_range("out of bounds parser_result_ref access",
+                           "optionpp::parser_result_ref::back");
       return m_entries.back();
     }
-    bool is_option_set(const std::string& long_name) const noexcept;
+    bool is_option_set(string_ref long_name) const noexcept;
     bool is_option_set(char short_name) const noexcept;
-    std::string get_argument(std::string long_name) const noexcept;
-    std::string get_argument(char short_name) const noexcept;
+    string_ref get_argument(string_ref long_name) const noexcept;
+    string_ref get_argument(char short_name) const noexcept;
+    parser_result to_result() const;
   private:
     container_type m_entries;
+    text_arena m_text;
+  };
+}
+
+
+namespace optionpp {
+  class batch_result {
+  public:
+    using size_type = std::size_t;
+    batch_result() noexcept {}
+    batch_result(const batch_result&) = delete;
+    batch_result& operator=(const batch_result&) = delete;
+    batch_result(batch_result&& other) noexcept;
+    batch_result& operator=(batch_result&& other) noexcept;
+    void clear() noexcept;
+    size_type line_count() const noexcept { return m_error.size(); }
+    size_type entry_count() const noexcept { return m_is_option.size(); }
+    size_type error_count() const noexcept { return m_error_count; }
+    bool ok(size_type line) const noexcept {
+      return m_error[line] == parse_errc::none;
+    }
+    parse_errc error(size_type line) const noexcept { return m_error[line]; }
+    size_type error_token(size_type line) const noexcept {
+      return m_error_token[line];
+    }
+    size_type error_offset(size_type line) const noexcept {
+      return m_error_offset[line];
+    }
+    string_ref error_option(size_type line) const noexcept {
+      return m_error_option[line];
+    }
+    std::string error_message(size_type line) const {
+      return parse_status::message(m_error[line], m_error_option[line]);
+    }
+    size_type first_entry(size_type line) const noexcept {
+      return line < m_line_begin.size() ? m_line_begin[line] : entry_count();
+    }
+    size_type entry_count(size_type line) const noexcept {
+      return first_entry(line + 1) - first_entry(line);
+    }
+    const std::vector<string_ref>& original_text() const noexcept {
+      return m_original_text;
+    }
+    const std::vector<string_ref>& original_without_argument() const noexcept {
+      return m_original_without_argument;
+    }
+    const std::vector<char>& is_option() const noexcept { return m_is_option; }
+    const std::vector<string_ref>& long_name() const noexcept { return m_long_name; }
+    const std::vector<char>& short_name() const noexcept { return m_short_name; }
+    const std::vector<string_ref>& argument() const noexcept { return m_argument; }
+    const std::vector<const option*>& opt_info() const noexcept { return m_opt_info; }
+    parsed_entry_ref entry(size_type index) const;
+    parser_result line_result(size_type line) const;
+  private:
+    friend class compiled_parser;
+    void push_back(const parsed_entry_ref& entry);
+    void add_argument(string_ref argument) {
+      string_ref& text = m_original_text.back();
+      text = store(text, " ", argument);
+      m_argument.back() = argument;
+    }
+    void end_line();
+    void fail_line(const parse_status& status);
+    string_ref store(string_ref a, string_ref b = string_ref{},
+                     string_ref c = string_ref{});
+    void append(batch_result&& other);
+    std::vector<size_type> m_line_begin;
+    size_type m_current_begin{0};
+    std::vector<parse_errc> m_error;
+    std::vector<size_type> m_error_token;
+    std::vector<size_type> m_error_offset;
+    std::vector<string_ref> m_error_option;
+    size_type m_error_count{0};
+    std::vector<string_ref> m_original_text;
+    std::vector<string_ref> m_original_without_argument;
+    std::vector<char> m_is_option;
+    std::vector<string_ref> m_long_name;
+    std::vector<char> m_short_name;
+    std::vector<string_ref> m_argument;
+    std::vector<const option*> m_opt_info;
+    std::vector<text_arena> m_text;
   };
 }
 
@@ -457,40 +1724,561 @@ bool optionpp::result_iterator<T, Ptr, Ref, IsOption>
 
 
 namespace optionpp {
-  class parse_error : public error {
+  class parser;
+  class compiled_parser {
   public:
-    parse_error(const std::string msg, const std::string fn_name,
-                const std::string option = "")
-      : error(msg, fn_name), m_option{option} {}
-    const std::string& option() const noexcept { return m_option; }
+    using size_type = std::vector<option>::size_type;
+    using executor_type = std::function<void(std::function<void()>)>;
+    using option_handler = std::function<bool(const option&, string_ref)>;
+    using non_option_handler = std::function<bool(string_ref)>;
+    compiled_parser() noexcept {}
+    explicit compiled_parser(const parser& source);
+    compiled_parser(const compiled_parser& other);
+    compiled_parser(compiled_parser&& other) noexcept;
+    compiled_parser& operator=(const compiled_parser& other);
+    compiled_parser& operator=(compiled_parser&& other) noexcept;
+    size_type size() const noexcept { return m_options.size(); }
+    template <typename InputIt>
+    parser_result parse(InputIt first, InputIt last, bool ignore_first = true) const;
+    parser_result parse(int argc, char* argv[], bool ignore_first = true) const;
+    parser_result parse(const std::string& cmd_line, bool ignore_first = false) const;
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    bool ignore_first = true) const;
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    bool ignore_first = true) const;
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    bool ignore_first = false) const;
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    parse_status& status, bool ignore_first = true) const;
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    parse_status& status, bool ignore_first = true) const;
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    parse_status& status, bool ignore_first = false) const;
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = true) const;
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = true) const;
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = false) const;
+    template <typename InputIt>
+    InputIt parse_leading_options(parser_result& result, InputIt first,
+                                  InputIt last, bool ignore_first = true) const;
+    template <typename InputIt>
+    InputIt parse_leading_options(parser_result& result, InputIt first,
+                                  InputIt last, parse_status& status,
+                                  bool ignore_first = true) const;
+    template <typename InputIt>
+    parser_result_ref parse_ref(InputIt first, InputIt last,
+                                bool ignore_first = true) const;
+    parser_result_ref parse_ref(int argc, char* argv[],
+                                bool ignore_first = true) const;
+    parser_result_ref parse_ref(const std::string& cmd_line,
+                                bool ignore_first = false) const;
+    template <typename InputIt>
+    bool visit(InputIt first, InputIt last, const option_handler& on_option,
+               const non_option_handler& on_non_option, parse_status& status,
+               bool ignore_first = true) const;
+    bool visit(int argc, char* argv[], const option_handler& on_option,
+               const non_option_handler& on_non_option, parse_status& status,
+               bool ignore_first = true) const;
+    template <typename ForwardIt>
+    parser_result parse_parallel(ForwardIt first, ForwardIt last,
+                                 const executor_type& executor,
+                                 size_type args_per_task = 16384,
+                                 bool ignore_first = true) const;
+    template <typename ForwardIt>
+    void parse_parallel_into(parser_result& result, ForwardIt first,
+                             ForwardIt last, const executor_type& executor,
+                             parse_status& status,
+                             size_type args_per_task = 16384,
+                             bool ignore_first = true) const;
+    bool visit(const std::string& cmd_line, const option_handler& on_option,
+               const non_option_handler& on_non_option, parse_status& status,
+               bool ignore_first = false) const;
+    template <typename InputIt>
+    batch_result parse_batch(InputIt first, InputIt last,
+                             bool ignore_first = false) const;
+    template <typename ForwardIt>
+    batch_result parse_batch(ForwardIt first, ForwardIt last,
+                             const executor_type& executor,
+                             size_type lines_per_task = 256,
+                             bool ignore_first = false) const;
   private:
-    std::string m_option;
+    friend class command_parser;
+    friend class parser;
+    friend class incremental_parser;
+    struct borrow_tag {};
+    compiled_parser(const parser& source, borrow_tag);
+    void copy_strings(const parser& source);
+    void reindex();
+    class entry_sink {
+    public:
+      virtual ~entry_sink() {}
+      virtual void add(const parsed_entry_ref& entry, bool transient_text) = 0;
+      virtual void add_argument(string_ref argument) = 0;
+      virtual void no_argument() {}
+      virtual string_ref keep(string_ref token) { return token; }
+    };
+    class result_sink : public entry_sink {
+    public:
+      explicit result_sink(parser_result& result) noexcept : m_result(result) {}
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+    private:
+      parser_result& m_result;
+    };
+    class result_ref_sink : public entry_sink {
+    public:
+      explicit result_ref_sink(parser_result_ref& result) noexcept : m_result(result) {}
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+      string_ref keep(string_ref token) override { return m_result.store(token); }
+    private:
+      parser_result_ref& m_result;
+    };
+    class batch_sink : public entry_sink {
+    public:
+      explicit batch_sink(batch_result& result) noexcept : m_result(result) {}
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+      string_ref keep(string_ref token) override { return m_result.store(token); }
+    private:
+      batch_result& m_result;
+    };
+    class count_sink : public entry_sink {
+    public:
+      void add(const parsed_entry_ref&, bool) override { ++m_count; }
+      void add_argument(string_ref) override {}
+      size_type count() const noexcept { return m_count; }
+    private:
+      size_type m_count{0};
+    };
+    class slice_sink : public entry_sink {
+    public:
+      slice_sink(std::vector<parsed_entry>& entries, size_type position) noexcept
+        : m_entries(entries), m_position(position) {}
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+      size_type position() const noexcept { return m_position; }
+    private:
+      std::vector<parsed_entry>& m_entries;
+      size_type m_position;
+    };
+    enum class cl_arg_type { non_option,
+                             end_indicator,
+                             arg_required,
+                             arg_optional,
+                             no_arg
+    };
+    struct parse_state {
+      explicit parse_state(parse_status& status) noexcept : status(status) {}
+      cl_arg_type type{cl_arg_type::non_option};
+      const option* pending{nullptr};
+      std::string pending_name;
+      size_type pending_index{0};
+      size_type pending_offset{0};
+      size_type index{0};
+      string_ref token;
+      std::string scratch;
+      bool write_bound{true};
+      const parse_target* target{nullptr};
+      bool stop_at_non_option{false};
+      bool stop_after_end_indicator{false};
+      bool stopped{false};
+      std::vector<mapped_file::id_type> open_files;
+      parse_status& status;
+    };
+    class visit_sink : public entry_sink {
+    public:
+      visit_sink(const option_handler& on_option,
+                 const non_option_handler& on_non_option,
+                 parse_state& state) noexcept
+        : m_on_option(on_option), m_on_non_option(on_non_option),
+          m_state(state) {}
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+      void no_argument() override { flush(); }
+      void flush();
+    private:
+      void visit_option(const option& opt, string_ref argument);
+      const option_handler& m_on_option;
+      const non_option_handler& m_on_non_option;
+      parse_state& m_state;
+      const option* m_held{nullptr};
+    };
+    bool parse_token(string_ref token, parse_state& state, entry_sink& sink) const;
+    bool parse_response_file(string_ref path, parse_state& state,
+                             entry_sink& sink) const;
+    bool parse_string(string_ref cmd_line, bool ignore_first,
+                      std::string& buffer, parse_state& state,
+                      entry_sink& sink) const;
+    void parse_line(string_ref line, bool ignore_first, parse_state& state,
+                    std::string& buffer, batch_result& result) const;
+    static void run_tasks(size_type task_count,
+                          const std::function<void(size_type)>& run_task,
+                          const executor_type& executor);
+    void parse_args(const std::vector<string_ref>& args,
+                    const executor_type& executor, size_type args_per_task,
+                    bool ignore_first, parser_result& result,
+                    parse_status& status) const;
+    batch_result parse_lines(const std::vector<string_ref>& lines,
+                             const executor_type& executor,
+                             size_type lines_per_task,
+                             bool ignore_first) const;
+    bool finish(parse_state& state) const;
+    static bool fail(parse_state& state, parse_errc error,
+                     string_ref::size_type offset, string_ref prefix,
+                     string_ref name = string_ref{});
+    static parse_errc write_argument(const option& opt, string_ref argument,
+                                     const parse_state& state) {
+      if (state.target)
+        return opt.write_argument(argument, *state.target, state.write_bound);
+      return opt.write_argument(argument, state.write_bound);
+    }
+    static void write_flag(const option& opt, const parse_state& state) noexcept {
+      if (!state.write_bound)
+        return;
+      if (state.target)
+        opt.write_bool(true, *state.target);
+      else
+        opt.write_bool(true);
+    }
+    const option* find_option(string_ref long_name) const noexcept {
+      return m_index.find(long_name.data(), long_name.size());
+    }
+    const option* find_option(char short_name) const noexcept {
+      return m_index.find(short_name);
+    }
+    option_syntax syntax() const noexcept {
+      return option_syntax{m_short_option_prefix, m_long_option_prefix,
+                           m_end_of_options, m_equals};
+    }
+    bool parse_argument(string_ref argument, parse_state& state,
+                        entry_sink& sink) const;
+    bool parse_short_option_group(string_ref specifier,
+                                  string_ref argument, bool has_arg,
+                                  parse_state& state, entry_sink& sink) const;
+    template <typename InputIt>
+    bool parse_range(InputIt& first, InputIt last, bool ignore_first,
+                     parse_state& state, entry_sink& sink) const;
+    std::vector<option> m_options;
+    option_index m_index;
+    std::string m_delims{" \t\n\r"};
+    std::string m_short_option_prefix{"-"};
+    std::string m_long_option_prefix{"--"};
+    std::string m_end_of_options{"--"};
+    std::string m_equals{"="};
+    std::string m_response_file_prefix;
+    bool m_allow_abbreviations{false};
+    std::shared_ptr<const suggestion_index> m_suggestions;
+    tokenizer m_tokenizer;
   };
+}
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <typename InputIt>
+optionpp::parser_result
+optionpp::compiled_parser::parse(InputIt first, InputIt last, bool ignore_first) const {
+  parser_result result{};
+  parse_into(result, first, last, ignore_first);
+  return result;
+}
+template <typename InputIt>
+void optionpp::compiled_parser::parse_into(parser_result& result,
+                                           InputIt first, InputIt last,
+                                           bool ignore_first) const {
+  parse_status status;
+  parse_into(result, first, last, status, ignore_first);
+  if (!status)
+    throw status.to_error();
+}
+template <typename InputIt>
+void optionpp::compiled_parser::parse_into(parser_result& result,
+                                           InputIt first, InputIt last,
+                                           parse_status& status,
+                                           bool ignore_first) const {
+  result.clear();
+  status.clear();
+  result_sink sink{result};
+  parse_state state{status};
+  parse_range(first, last, ignore_first, state, sink);
+}
+template <typename InputIt>
+void optionpp::compiled_parser::parse_into(parser_result& result,
+                                           InputIt first, InputIt last,
+                                           const parse_target& target,
+                                           parse_status& status,
+                                           bool ignore_first) const {
+  result.clear();
+  status.clear();
+  result_sink sink{result};
+  parse_state state{status};
+  state.target = &target;
+  parse_range(first, last, ignore_first, state, sink);
+}
+template <typename InputIt>
+InputIt optionpp::compiled_parser::parse_leading_options(parser_result& result,
+                                                         InputIt first,
+                                                         InputIt last,
+                                                         bool ignore_first) const {
+  parse_status status;
+  first = parse_leading_options(result, first, last, status, ignore_first);
+  if (!status)
+    throw status.to_error();
+  return first;
+}
+template <typename InputIt>
+InputIt optionpp::compiled_parser::parse_leading_options(parser_result& result,
+                                                         InputIt first,
+                                                         InputIt last,
+                                                         parse_status& status,
+                                                         bool ignore_first) const {
+  result.clear();
+  status.clear();
+  result_sink sink{result};
+  parse_state state{status};
+  state.stop_at_non_option = true;
+  state.stop_after_end_indicator = true;
+  parse_range(first, last, ignore_first, state, sink);
+  return first;
+}
+template <typename InputIt>
+optionpp::parser_result_ref
+optionpp::compiled_parser::parse_ref(InputIt first, InputIt last,
+                                     bool ignore_first) const {
+  parser_result_ref result{};
+  result_ref_sink sink{result};
+  parse_status status;
+  parse_state state{status};
+  if (!parse_range(first, last, ignore_first, state, sink))
+    throw status.to_error();
+  return result;
+}
+template <typename InputIt>
+bool optionpp::compiled_parser::parse_range(InputIt& first, InputIt last,
+                                            bool ignore_first,
+                                            parse_state& state,
+                                            entry_sink& sink) const {
+  if (ignore_first && first != last) {
+    ++first;
+    ++state.index;
+  }
+  for (; first != last; ++first) {
+    const auto& arg = *first;
+    if (!parse_token(arg, state, sink))
+      return false;
+    if (state.stopped)
+      break;
+  }
+  return state.stopped || finish(state);
+}
+template <typename InputIt>
+bool optionpp::compiled_parser::visit(InputIt first, InputIt last,
+                                      const option_handler& on_option,
+                                      const non_option_handler& on_non_option,
+                                      parse_status& status,
+                                      bool ignore_first) const {
+  status.clear();
+  parse_state state{status};
+  visit_sink sink{on_option, on_non_option, state};
+  if (!parse_range(first, last, ignore_first, state, sink))
+    return false;
+  sink.flush();
+  return !state.stopped;
+}
+template <typename InputIt>
+optionpp::batch_result
+optionpp::compiled_parser::parse_batch(InputIt first, InputIt last,
+                                       bool ignore_first) const {
+  batch_result result{};
+  parse_status status;
+  parse_state state{status};
+  state.write_bound = false;
+  std::string buffer;
+  for (; first != last; ++first) {
+    const auto& line = *first;
+    parse_line(line, ignore_first, state, buffer, result);
+  }
+  return result;
+}
+template <typename ForwardIt>
+optionpp::parser_result
+optionpp::compiled_parser::parse_parallel(ForwardIt first, ForwardIt last,
+                                          const executor_type& executor,
+                                          size_type args_per_task,
+                                          bool ignore_first) const {
+  parser_result result{};
+  parse_status status;
+  parse_parallel_into(result, first, last, executor, status, args_per_task,
+                      ignore_first);
+  if (!status)
+    throw status.to_error();
+  return result;
+}
+template <typename ForwardIt>
+void optionpp::compiled_parser::parse_parallel_into(parser_result& result,
+                                                    ForwardIt first,
+                                                    ForwardIt last,
+                                                    const executor_type& executor,
+                                                    parse_status& status,
+                                                    size_type args_per_task,
+                                                    bool ignore_first) const {
+  std::vector<string_ref> args;
+  args.reserve(std::distance(first, last));
+  for (; first != last; ++first) {
+    const auto& arg = *first;
+    args.push_back(arg);
+  }
+  parse_args(args, executor, args_per_task, ignore_first, result, status);
+}
+template <typename ForwardIt>
+optionpp::batch_result
+optionpp::compiled_parser::parse_batch(ForwardIt first, ForwardIt last,
+                                       const executor_type& executor,
+                                       size_type lines_per_task,
+                                       bool ignore_first) const {
+  std::vector<string_ref> lines;
+  for (; first != last; ++first) {
+    const auto& line = *first;
+    lines.push_back(line);
+  }
+  return parse_lines(lines, executor, lines_per_task, ignore_first);
+}
+#endif
+
+
+namespace optionpp {
   class parser {
   public:
     parser() noexcept {}
     parser(const std::initializer_list<option>& il) {
       m_groups.emplace_back("", il.begin(), il.end());
+      track_groups();
     }
     template <typename InputIt>
-    parser(InputIt first, InputIt last) { m_groups.emplace_back("", first, last); }
+    parser(InputIt first, InputIt last) {
+      m_groups.emplace_back("", first, last);
+      track_groups();
+    }
+    parser(const parser& other);
+    parser(parser&& other) noexcept;
+    parser& operator=(const parser& other);
+    parser& operator=(parser&& other) noexcept;
     option_group& group(const std::string& name);
     option& add_option(const option& opt = option{});
+    option& add_option(option&& opt);
     option& add_option(const std::string& long_name,
                        char short_name = '\0',
                        const std::string& description = "",
                        const std::string& arg_name = "",
                        bool arg_required = false,
                        const std::string& group_name = "");
+    template <typename ForwardIt>
+    void add_options(ForwardIt first, ForwardIt last,
+                     const std::string& group_name = "");
     template <typename InputIt>
     parser_result parse(InputIt first, InputIt last, bool ignore_first = true) const;
     parser_result parse(int argc, char* argv[], bool ignore_first = true) const;
     parser_result parse(const std::string& cmd_line, bool ignore_first = false) const;
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    bool ignore_first = true) const;
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    bool ignore_first = true) const;
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    bool ignore_first = false) const;
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    parse_status& status, bool ignore_first = true) const;
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    parse_status& status, bool ignore_first = true) const;
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    parse_status& status, bool ignore_first = false) const;
+    template <typename InputIt>
+    void parse_into(parser_result& result, InputIt first, InputIt last,
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = true) const;
+    void parse_into(parser_result& result, int argc, char* argv[],
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = true) const;
+    void parse_into(parser_result& result, const std::string& cmd_line,
+                    const parse_target& target, parse_status& status,
+                    bool ignore_first = false) const;
+    template <typename InputIt>
+    InputIt parse_leading_options(parser_result& result, InputIt first,
+                                  InputIt last, bool ignore_first = true) const;
+    template <typename InputIt>
+    InputIt parse_leading_options(parser_result& result, InputIt first,
+                                  InputIt last, parse_status& status,
+                                  bool ignore_first = true) const;
+    template <typename InputIt>
+    parser_result_ref parse_ref(InputIt first, InputIt last,
+                                bool ignore_first = true) const;
+    parser_result_ref parse_ref(int argc, char* argv[],
+                                bool ignore_first = true) const;
+    parser_result_ref parse_ref(const std::string& cmd_line,
+                                bool ignore_first = false) const;
+    template <typename InputIt>
+    bool visit(InputIt first, InputIt last,
+               const compiled_parser::option_handler& on_option,
+               const compiled_parser::non_option_handler& on_non_option,
+               parse_status& status, bool ignore_first = true) const;
+    bool visit(int argc, char* argv[],
+               const compiled_parser::option_handler& on_option,
+               const compiled_parser::non_option_handler& on_non_option,
+               parse_status& status, bool ignore_first = true) const;
+    bool visit(const std::string& cmd_line,
+               const compiled_parser::option_handler& on_option,
+               const compiled_parser::non_option_handler& on_non_option,
+               parse_status& status, bool ignore_first = false) const;
+    template <typename InputIt>
+    batch_result parse_batch(InputIt first, InputIt last,
+                             bool ignore_first = false) const;
+    template <typename ForwardIt>
+    batch_result parse_batch(ForwardIt first, ForwardIt last,
+                             const compiled_parser::executor_type& executor,
+                             compiled_parser::size_type lines_per_task = 256,
+                             bool ignore_first = false) const;
+    template <typename ForwardIt>
+    parser_result parse_parallel(ForwardIt first, ForwardIt last,
+                                 const compiled_parser::executor_type& executor,
+                                 compiled_parser::size_type args_per_task = 16384,
+                                 bool ignore_first = true) const;
+    template <typename ForwardIt>
+    void parse_parallel_into(parser_result& result, ForwardIt first,
+                             ForwardIt last,
+                             const compiled_parser::executor_type& executor,
+                             parse_status& status,
+                             compiled_parser::size_type args_per_task = 16384,
+                             bool ignore_first = true) const;
+    compiled_parser compile() const { return compiled_parser{*this}; }
     void set_custom_strings(const std::string& delims,
                             const std::string& short_prefix = "",
                             const std::string& long_prefix = "",
                             const std::string& end_indicator = "",
                             const std::string& equals = "");
+    void set_response_file_prefix(const std::string& prefix = "@") {
+      invalidate_index();
+      m_response_file_prefix = prefix;
+    }
+    const std::string& response_file_prefix() const noexcept {
+      return m_response_file_prefix;
+    }
+    void set_allow_abbreviations(bool allow = true) {
+      invalidate_index();
+      m_allow_abbreviations = allow;
+    }
+    bool allow_abbreviations() const noexcept { return m_allow_abbreviations; }
+    void set_suggestions(bool enable = true) {
+      invalidate_index();
+      m_suggestions_enabled = enable;
+    }
+    bool suggestions_enabled() const noexcept { return m_suggestions_enabled; }
     void sort_groups();
     void sort_options();
     option& operator[](const std::string& long_name);
@@ -502,6 +2290,9 @@ namespace optionpp {
                              int desc_first_line_indent = 30,
                              int desc_multiline_indent = 32) const;
   private:
+    friend class command_parser;
+    friend class compiled_parser;
+    friend class incremental_parser;
     using group_container = std::vector<option_group>;
     using group_iterator = group_container::iterator;
     using group_const_iterator = group_container::const_iterator;
@@ -509,373 +2300,4424 @@ namespace optionpp {
     using option_const_iterator = option_group::const_iterator;
     group_iterator find_group(const std::string& name);
     group_const_iterator find_group(const std::string& name) const;
+    class name_checker {
+    public:
+      name_checker(const parser& owner, std::size_t count);
+      void add(const option& opt);
+    private:
+      string_pool m_long_names;
+      std::array<bool, 256> m_short_names;
+    };
     option* find_option(const std::string& long_name);
-    const option* find_option(const std::string& long_name) const;
     option* find_option(char short_name);
-    const option* find_option(char short_name) const;
-    bool is_end_indicator(const std::string& argument) const noexcept {
-      return argument == m_end_of_options;
-    }
-    bool is_long_option(const std::string& argument) const noexcept {
-      return argument.size() > m_long_option_prefix.size()
-        && utility::is_substr_at_pos(argument, m_long_option_prefix);
-    }
-    bool is_short_option_group(const std::string& argument) const noexcept {
-      return argument.size() > m_short_option_prefix.size()
-        && utility::is_substr_at_pos(argument, m_short_option_prefix);
+    const option_index& update_lookup();
+    void rebuild_lookup();
+    const compiled_parser& compiled() const;
+    struct help_layout {
+      int max_line_length;
+      int group_indent;
+      int option_indent;
+      int desc_first_line_indent;
+      int desc_multiline_indent;
+      std::string text;
+    };
+    static constexpr std::size_t max_help_layouts = 4;
+    void format_help(std::string& text,
+                     int max_line_length,
+                     int group_indent,
+                     int option_indent,
+                     int desc_first_line_indent,
+                     int desc_multiline_indent) const;
+    void invalidate_index() noexcept {
+      m_log.changes.fetch_add(1, std::memory_order_release);
+      m_log.moved = true;
     }
-    bool is_non_option(const std::string& argument) const noexcept {
-      return !is_end_indicator(argument)
-        && !is_long_option(argument)
-        && !is_short_option_group(argument);
+    void track_groups() noexcept {
+      for (auto& g : m_groups) {
+        g.attach(&m_log);
+        g.adopt_text(0);
+      }
     }
-    void write_option_argument(const parsed_entry& entry) const;
-    enum class cl_arg_type { non_option,
-                             end_indicator,
-                             arg_required,
-                             arg_optional,
-                             no_arg
-    };
-    void parse_argument(const std::string& argument,
-                        parser_result& result, cl_arg_type& type) const;
-    void parse_short_option_group(const std::string& short_names,
-                                  const std::string& argument, bool has_arg,
-                                  parser_result& result, cl_arg_type& type) const;
     group_container m_groups;
     std::string m_delims{" \t\n\r"};
     std::string m_short_option_prefix{"-"};
     std::string m_long_option_prefix{"--"};
     std::string m_end_of_options{"--"};
     std::string m_equals{"="};
+    std::string m_response_file_prefix;
+    bool m_allow_abbreviations{false};
+    bool m_suggestions_enabled{false};
+    change_tracker::change_log m_log;
+    option_index m_lookup;
+    mutable std::mutex m_cache_mutex;
+    mutable compiled_parser m_compiled;
+    mutable std::atomic<unsigned long> m_compiled_changes{0};
+    mutable std::vector<help_layout> m_help_layouts;
+    mutable unsigned long m_help_changes{0};
   };
   std::ostream& operator<<(std::ostream& os, const parser& parser);
 }
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <typename ForwardIt>
+void optionpp::parser::add_options(ForwardIt first, ForwardIt last,
+                                   const std::string& group_name) {
+  name_checker checker{*this,
+      static_cast<std::size_t>(std::distance(first, last))};
+  for (ForwardIt it = first; it != last; ++it)
+    checker.add(*it);
+  group(group_name).add_options(first, last);
+}
 template <typename InputIt>
 optionpp::parser_result
 optionpp::parser::parse(InputIt first, InputIt last, bool ignore_first) const {
-  if (ignore_first && first != last)
-    ++first;
-  InputIt it{first};
-  parser_result result{};
-  cl_arg_type prev_type{cl_arg_type::non_option};
-  while (it != last) {
-    const std::string& arg{*it};
-    if (prev_type == cl_arg_type::arg_required
-        || prev_type == cl_arg_type::arg_optional) {
-      if (is_non_option(arg)
-          || prev_type == cl_arg_type::arg_required) {
-        auto& arg_info = result.back();
-        arg_info.argument = arg;
-        arg_info.original_text.push_back(' ');
-        arg_info.original_text += arg;
-        prev_type = cl_arg_type::non_option;
-        if (arg_info.opt_info)
-          write_option_argument(arg_info);
-      } else {
-        prev_type = cl_arg_type::non_option;
-        continue;
-      }
-    } else if (prev_type == cl_arg_type::end_indicator) {
-      parsed_entry arg_info;
-      arg_info.original_text = arg;
-      arg_info.is_option = false;
-      result.push_back(std::move(arg_info));
-    } else {
-      parse_argument(arg, result, prev_type);
-    }
-    ++it;
-  }
-  if (prev_type == cl_arg_type::arg_required) {
-    const auto& opt_name = result.back().original_text;
-    throw parse_error{"option '" + opt_name + "' requires an argument",
-        "optionpp::parser::parse", opt_name};
-  }
-  return result;
+  return compiled().parse(first, last, ignore_first);
 }
+template <typename InputIt>
+void optionpp::parser::parse_into(parser_result& result, InputIt first,
+                                  InputIt last, bool ignore_first) const {
+  compiled().parse_into(result, first, last, ignore_first);
+}
+template <typename InputIt>
+void optionpp::parser::parse_into(parser_result& result, InputIt first,
+                                  InputIt last, parse_status& status,
+                                  bool ignore_first) const {
+  compiled().parse_into(result, first, last, status, ignore_first);
+}
+template <typename InputIt>
+void optionpp::parser::parse_into(parser_result& result, InputIt first,
+                                  InputIt last, const parse_target& target,
+                                  parse_status& status,
+                                  bool ignore_first) const {
+  compiled().parse_into(result, first, last, target, status, ignore_first);
+}
+template <typename InputIt>
+InputIt optionpp::parser::parse_leading_options(parser_result& result,
+                                                InputIt first, InputIt last,
+                                                bool ignore_first) const {
+  return compiled().parse_leading_options(result, first, last, ignore_first);
+}
+template <typename InputIt>
+InputIt optionpp::parser::parse_leading_options(parser_result& result,
+                                                InputIt first, InputIt last,
+                                                parse_status& status,
+                                                bool ignore_first) const {
+  return compiled().parse_leading_options(result, first, last, status,
+                                          ignore_first);
+}
+template <typename InputIt>
+optionpp::parser_result_ref
+optionpp::parser::parse_ref(InputIt first, InputIt last, bool ignore_first) const {
+  return compiled().parse_ref(first, last, ignore_first);
+}
+template <typename InputIt>
+bool optionpp::parser::visit(InputIt first, InputIt last,
+                             const compiled_parser::option_handler& on_option,
+                             const compiled_parser::non_option_handler& on_non_option,
+                             parse_status& status, bool ignore_first) const {
+  return compiled().visit(first, last, on_option, on_non_option, status,
+                          ignore_first);
+}
+template <typename InputIt>
+optionpp::batch_result
+optionpp::parser::parse_batch(InputIt first, InputIt last,
+                              bool ignore_first) const {
+  return compiled().parse_batch(first, last, ignore_first);
+}
+template <typename ForwardIt>
+optionpp::batch_result
+optionpp::parser::parse_batch(ForwardIt first, ForwardIt last,
+                              const compiled_parser::executor_type& executor,
+                              compiled_parser::size_type lines_per_task,
+                              bool ignore_first) const {
+  return compiled().parse_batch(first, last, executor, lines_per_task,
+                                ignore_first);
+}
+template <typename ForwardIt>
+optionpp::parser_result
+optionpp::parser::parse_parallel(ForwardIt first, ForwardIt last,
+                                 const compiled_parser::executor_type& executor,
+                                 compiled_parser::size_type args_per_task,
+                                 bool ignore_first) const {
+  return compiled().parse_parallel(first, last, executor, args_per_task,
+                                   ignore_first);
+}
+template <typename ForwardIt>
+void optionpp::parser::parse_parallel_into(parser_result& result,
+                                           ForwardIt first, ForwardIt last,
+                                           const compiled_parser::executor_type& executor,
+                                           parse_status& status,
+                                           compiled_parser::size_type args_per_task,
+                                           bool ignore_first) const {
+  compiled().parse_parallel_into(result, first, last, executor, status,
+                                 args_per_task, ignore_first);
+}
+#endif
 
 
-
-#ifdef OPTIONPP_MAIN
-
-
-#include <algorithm>
-#include <cctype>
-#include <iostream>
-#include <iterator>
-#include <limits>
-#include <stdexcept>
-#include <vector>
-
 namespace optionpp {
-  namespace utility {
-    bool is_space(char c) {
-      return std::isspace(static_cast<unsigned char>(c));
+  class command_result {
+  public:
+    using size_type = std::vector<parser_result>::size_type;
+    command_result() : m_levels(1) {}
+    const std::vector<std::string>& command_path() const noexcept {
+      return m_path;
     }
-    std::string wrap_line(const std::string& str,
-                          int line_len,
-                          int indent,
-                          int first_line_indent) {
-      if (line_len <= 0)
-        return std::string(first_line_indent, ' ') + str;
-      if (indent < 0)
-        indent = 0;
-      else if (indent > line_len - 1)
-        indent = line_len - 1;
-      if (first_line_indent < 0)
-        first_line_indent = 0;
-      else if (first_line_indent > line_len - 1)
-        first_line_indent = line_len - 1;
-      std::string result;
-      std::string::size_type pos{0};
-      while (pos < str.size()) {
-        int cur_indent = result.empty() ? first_line_indent : indent;
-        auto start = pos;
-        if (!result.empty()) {
-          while (start < str.size() && is_space(str[start]))
-            ++start;
-        }
-        auto end = start + line_len - cur_indent;
-        if (end > str.size())
-          end = str.size();
-        if (end < str.size()) {
-          auto word_start = end;
-          while (word_start > start && !is_space(str[word_start]))
-            --word_start;
-          if (word_start > start)
-            end = word_start;
-        }
-        pos = end;
-        while (end > start && is_space(str[end - 1]))
-          --end;
-        if (end > start) {
-          if (!result.empty())
-            result.push_back('\n');
-          if (cur_indent > 0)
-            result += std::string(cur_indent, ' ');
-          result += str.substr(start, end - start);
-        }
-      }
-      return result;
+    bool has_command() const noexcept { return !m_path.empty(); }
+    size_type size() const noexcept { return m_levels.size(); }
+    const parser_result& operator[](size_type level) const noexcept {
+      return m_levels[level];
     }
-    std::string wrap_text(const std::string& str,
-                          int line_len,
-                          int indent) {
-      return wrap_text(str, line_len, indent, indent);
+    const parser_result& at(size_type level) const;
+    const parser_result& global_options() const noexcept {
+      return m_levels.front();
     }
-    std::string wrap_text(const std::string& str,
-                          int line_len,
-                          int indent,
+    const parser_result& command_options() const noexcept {
+      return m_levels.back();
+    }
+    void clear() {
+      m_path.clear();
+      m_levels.resize(1);
+      m_levels.front().clear();
+    }
+  private:
+    friend class command_parser;
+    parser_result& add_level(const std::string& name) {
+      m_path.push_back(name);
+      m_levels.emplace_back();
+      return m_levels.back();
+    }
+    std::vector<std::string> m_path;
+    std::vector<parser_result> m_levels;
+  };
+}
+
+
+namespace optionpp {
+  class command_parser {
+  public:
+    using size_type = std::size_t;
+    using factory_type = std::function<void(command_parser&)>;
+    command_parser() {}
+    command_parser(const command_parser&) = delete;
+    command_parser& operator=(const command_parser&) = delete;
+    parser& options() noexcept { return m_options; }
+    const parser& options() const noexcept { return m_options; }
+    command_parser& add_command(const std::string& name, factory_type factory);
+    size_type command_count() const noexcept { return m_commands.size(); }
+    bool has_command(const std::string& name) const noexcept {
+      return find_entry(name) != nullptr;
+    }
+    bool is_command_built(const std::string& name) const;
+    command_parser& command(const std::string& name);
+    template <typename InputIt>
+    command_result parse(InputIt first, InputIt last, bool ignore_first = true) const;
+    command_result parse(int argc, char* argv[], bool ignore_first = true) const;
+    command_result parse(const std::string& cmd_line, bool ignore_first = false) const;
+    template <typename InputIt>
+    void parse_into(command_result& result, InputIt first, InputIt last,
+                    parse_status& status, bool ignore_first = true) const;
+    void parse_into(command_result& result, int argc, char* argv[],
+                    parse_status& status, bool ignore_first = true) const;
+    void parse_into(command_result& result, const std::string& cmd_line,
+                    parse_status& status, bool ignore_first = false) const;
+  private:
+    struct command_entry {
+      std::string name;
+      factory_type factory;
+      std::unique_ptr<std::mutex> build_mutex;
+      mutable std::unique_ptr<command_parser> command;
+    };
+    const command_entry* find_entry(string_ref name) const noexcept;
+    command_parser& build(const command_entry& entry) const;
+    parser m_options;
+    std::vector<command_entry> m_commands;
+    mutable std::mutex m_mutex;
+  };
+}
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <typename InputIt>
+optionpp::command_result
+optionpp::command_parser::parse(InputIt first, InputIt last, bool ignore_first) const {
+  command_result result;
+  parse_status status;
+  parse_into(result, first, last, status, ignore_first);
+  if (!status)
+    throw status.to_error();
+  return result;
+}
+template <typename InputIt>
+void optionpp::command_parser::parse_into(command_result& result,
+                                          InputIt first, InputIt last,
+                                          parse_status& status,
+                                          bool ignore_first) const {
+  result.clear();
+  status.clear();
+  const command_parser* current = this;
+  parser_result* entries = &result.m_levels.front();
+  compiled_parser::size_type index = 0;
+  if (ignore_first && first != last) {
+    ++first;
+    ++index;
+  }
+  for (;;) {
+    compiled_parser::result_sink sink{*entries};
+    compiled_parser::parse_state state{status};
+    state.index = index;
+    state.stop_at_non_option = !current->m_commands.empty();
+    if (!current->m_options.compiled().parse_range(first, last, false, state, sink)
+        || !state.stopped)
+      return;
+    const auto& arg = *first;
+    string_ref name = arg;
+    const command_entry* entry = current->find_entry(name);
+    if (!entry) {
+      status.set(parse_errc::unknown_command, state.index, 0, name);
+      return;
+    }
+    current = &current->build(*entry);
+    entries = &result.add_level(entry->name);
+    ++first;
+    index = state.index + 1;
+  }
+}
+#endif
+
+
+namespace optionpp {
+  class incremental_parser {
+  public:
+    using size_type = std::size_t;
+    using entry_handler = std::function<void(const parsed_entry_ref&)>;
+    incremental_parser(const compiled_parser& source, entry_handler handler,
+                       bool ignore_first = false);
+    incremental_parser(const parser& source, entry_handler handler,
+                       bool ignore_first = false)
+      : incremental_parser(source.compiled(), std::move(handler), ignore_first) {}
+    incremental_parser(const incremental_parser&) = delete;
+    incremental_parser& operator=(const incremental_parser&) = delete;
+    void feed(string_ref argument);
+    bool feed(string_ref argument, parse_status& status);
+    void finish();
+    bool finish(parse_status& status);
+    void reset() noexcept;
+    size_type argument_count() const noexcept { return m_state.index; }
+    bool waiting_for_argument() const noexcept {
+      return m_state.type == compiled_parser::cl_arg_type::arg_required
+        || m_state.type == compiled_parser::cl_arg_type::arg_optional;
+    }
+  private:
+    class entry_buffer : public compiled_parser::entry_sink {
+    public:
+      explicit entry_buffer(entry_handler handler)
+        : m_handler{std::move(handler)} {}
+      void add(const parsed_entry_ref& entry, bool transient_text) override;
+      void add_argument(string_ref argument) override;
+      string_ref keep(string_ref token) override;
+      void flush();
+      void keep();
+      void discard() noexcept { m_has_entry = false; }
+    private:
+      entry_handler m_handler;
+      parsed_entry_ref m_entry;
+      bool m_has_entry{false};
+      std::string m_text;
+      std::string m_joined;
+      std::string m_token;
+    };
+    bool step(string_ref argument);
+    bool step_finish();
+    const compiled_parser* m_parser;
+    bool m_ignore_first;
+    bool m_skip_next;
+    bool m_failed{false};
+    parse_status m_status;
+    compiled_parser::parse_state m_state;
+    entry_buffer m_buffer;
+  };
+}
+
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define OPTIONPP_CONSTEXPR_SCHEMA 1
+#include <array>
+#include <iterator>
+#include <stdexcept>
+#else
+#define OPTIONPP_CONSTEXPR_SCHEMA 0
+#endif
+namespace optionpp {
+  struct option_spec {
+    using argument_checker = parse_errc (*)(string_ref);
+    constexpr option_spec(const char* long_name, char short_name = '\0',
+                          const char* description = "",
+                          const char* arg_name = "",
+                          bool arg_required = false,
+                          argument_checker checker = nullptr) noexcept
+      : long_name{long_name}, short_name{short_name},
+        description{description}, arg_name{arg_name},
+        arg_required{arg_required}, checker{checker} {}
+    template <typename T>
+    static constexpr argument_checker check() noexcept { return &check_converted<T>; }
+    const char* long_name;
+    char short_name;
+    const char* description;
+    const char* arg_name;
+    bool arg_required;
+    argument_checker checker;
+  private:
+    template <typename T>
+    static parse_errc check_converted(string_ref argument) {
+      T value{};
+      return converter<T>::convert(argument, value);
+    }
+  };
+  class schema_parser {
+  public:
+    using size_type = std::size_t;
+    using option_handler = std::function<bool(const option_spec&, string_ref)>;
+    using non_option_handler = std::function<bool(string_ref)>;
+    static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+    constexpr schema_parser(const option_spec* specs, size_type count,
+                            const std::uint32_t* slots, size_type slot_count,
+                            const std::uint32_t* displacements,
+                            size_type bucket_count,
+                            const std::uint32_t* short_names,
+                            const char* help, size_type help_size) noexcept
+      : m_specs{specs}, m_count{count}, m_slots{slots},
+        m_slot_count{slot_count}, m_displacements{displacements},
+        m_bucket_count{bucket_count}, m_short_names{short_names},
+        m_help{help}, m_help_size{help_size} {}
+    size_type size() const noexcept { return m_count; }
+    size_type index(const option_spec& spec) const noexcept {
+      return static_cast<size_type>(&spec - m_specs);
+    }
+    const option_spec* find(string_ref long_name) const noexcept;
+    const option_spec* find(char short_name) const noexcept {
+      std::uint32_t pos = m_short_names[static_cast<unsigned char>(short_name)];
+      return short_name != '\0' && pos != npos ? m_specs + pos : nullptr;
+    }
+    string_ref help() const noexcept { return string_ref{m_help, m_help_size}; }
+    std::ostream& print_help(std::ostream& os) const;
+    template <typename InputIt>
+    bool visit(InputIt first, InputIt last, const option_handler& on_option,
+               const non_option_handler& on_non_option, parse_status& status,
+               bool ignore_first = true) const;
+    bool visit(int argc, char* argv[], const option_handler& on_option,
+               const non_option_handler& on_non_option, parse_status& status,
+               bool ignore_first = true) const {
+      return visit(argv, argv + argc, on_option, on_non_option, status,
+                   ignore_first);
+    }
+    static constexpr size_type bucket(std::uint32_t h, size_type bucket_count) noexcept {
+      return (h ^ (h >> 16)) & (bucket_count - 1);
+    }
+    static constexpr size_type displaced_slot(std::uint32_t h,
+                                              std::uint32_t displacement,
+                                              size_type slot_count) noexcept {
+      return finish_mix(mix(h ^ static_cast<std::uint32_t>(displacement * 0x9e3779b9u)))
+        & (slot_count - 1);
+    }
+  private:
+    struct visit_state {
+      visit_state(const option_handler& on_option,
+                  const non_option_handler& on_non_option,
+                  parse_status& status) noexcept
+        : on_option(on_option), on_non_option(on_non_option),
+          status(status) {}
+      const option_handler& on_option;
+      const non_option_handler& on_non_option;
+      parse_status& status;
+      size_type index{0};
+      const option_spec* pending{nullptr};
+      std::string pending_name;
+      size_type pending_index{0};
+      size_type pending_offset{0};
+      bool end_of_options{false};
+      bool stopped{false};
+    };
+    static constexpr std::uint32_t mix(std::uint32_t x) noexcept {
+      return static_cast<std::uint32_t>((x ^ (x >> 16)) * 0x85ebca6bu);
+    }
+    static constexpr std::uint32_t finish_mix(std::uint32_t x) noexcept {
+      return x ^ (x >> 13);
+    }
+    bool parse_token(string_ref token, visit_state& state) const;
+    bool parse_argument(string_ref token, visit_state& state) const;
+    bool parse_short_option_group(string_ref token, string_ref specifier,
+                                  string_ref argument, bool has_arg,
+                                  visit_state& state) const;
+    static bool finish(visit_state& state);
+    static bool accept(const option_spec& spec, string_ref argument,
+                       size_type offset, string_ref prefix, string_ref name,
+                       visit_state& state);
+    static bool check(const option_spec& spec, string_ref argument,
+                      size_type offset, string_ref prefix, string_ref name,
+                      visit_state& state);
+    static void pass_option(const option_spec& spec, string_ref argument,
+                            visit_state& state);
+    static void pass_non_option(string_ref argument, visit_state& state);
+    static bool fail(visit_state& state, parse_errc error, size_type offset,
+                     string_ref prefix, string_ref name = string_ref{});
+    const option_spec* m_specs;
+    size_type m_count;
+    const std::uint32_t* m_slots;
+    size_type m_slot_count;
+    const std::uint32_t* m_displacements;
+    size_type m_bucket_count;
+    const std::uint32_t* m_short_names;
+    const char* m_help;
+    size_type m_help_size;
+  };
+#if OPTIONPP_CONSTEXPR_SCHEMA
+  struct schema_layout {
+    using size_type = std::size_t;
+    static constexpr size_type slot_count(size_type count) noexcept {
+      size_type slots = 16;
+      while (slots < 2 * count)
+        slots *= 2;
+      return slots;
+    }
+    static constexpr size_type bucket_count(size_type count) noexcept {
+      size_type buckets = 1;
+      while (2 * buckets < count)
+        buckets *= 2;
+      return buckets;
+    }
+    static constexpr std::uint32_t hash(const char* str) noexcept {
+      std::uint32_t h = 2166136261u;
+      for (; *str; ++str) {
+        h ^= static_cast<unsigned char>(*str);
+        h *= 16777619u;
+      }
+      return h;
+    }
+    static constexpr bool equal(const char* a, const char* b) noexcept {
+      for (; *a && *a == *b; ++a, ++b) {}
+      return *a == *b;
+    }
+    static constexpr size_type format_help(const option_spec* specs,
+                                           size_type count, char* out) noexcept {
+      writer dest{out};
+      for (size_type i = 0; i < count; ++i) {
+        const option_spec& spec = specs[i];
+        if (i != 0)
+          dest.put('\n');
+        text usage;
+        usage.add_spaces(option_indent);
+        if (spec.short_name != '\0') {
+          usage.add("-", 1);
+          usage.add(&spec.short_name, 1);
+          if (*spec.long_name)
+            usage.add(", ", 2);
+        } else {
+          usage.add_spaces(4);
+        }
+        if (*spec.long_name) {
+          usage.add("--", 2);
+          usage.add(spec.long_name);
+        }
+        if (*spec.arg_name) {
+          if (spec.arg_required) {
+            usage.add("=", 1);
+            usage.add(spec.arg_name);
+          } else {
+            usage.add("[=", 2);
+            usage.add(spec.arg_name);
+            usage.add("]", 1);
+          }
+        }
+        int spacing = desc_first_line_indent - static_cast<int>(usage.size());
+        if (spacing <= 1) {
+          wrap(usage, dest, line_length, 0, 0);
+          if (*spec.description) {
+            dest.put('\n');
+            text desc;
+            desc.add(spec.description);
+            wrap(desc, dest, line_length, desc_multiline_indent,
+                 desc_first_line_indent);
+          }
+        } else {
+          if (*spec.description) {
+            usage.add_spaces(static_cast<size_type>(spacing));
+            usage.add(spec.description);
+          }
+          wrap(usage, dest, line_length, desc_multiline_indent, 0);
+        }
+      }
+      return dest.size;
+    }
+  private:
+    static constexpr int line_length = 78;
+    static constexpr int option_indent = 2;
+    static constexpr int desc_first_line_indent = 30;
+    static constexpr int desc_multiline_indent = 32;
+    struct text {
+      static constexpr size_type max_pieces = 12;
+      constexpr void add(const char* str, size_type length) noexcept {
+        data[count] = str;
+        sizes[count++] = length;
+        total += length;
+      }
+      constexpr void add(const char* str) noexcept {
+        size_type length = 0;
+        while (str[length])
+          ++length;
+        add(str, length);
+      }
+      constexpr void add_spaces(size_type length) noexcept { add(nullptr, length); }
+      constexpr size_type size() const noexcept { return total; }
+      constexpr char operator[](size_type pos) const noexcept {
+        size_type i = 0;
+        while (pos >= sizes[i])
+          pos -= sizes[i++];
+        return data[i] ? data[i][pos] : ' ';
+      }
+      const char* data[max_pieces]{};
+      size_type sizes[max_pieces]{};
+      size_type count{0};
+      size_type total{0};
+    };
+    struct writer {
+      constexpr void put(char c) noexcept {
+        if (out)
+          out[size] = c;
+        ++size;
+      }
+      constexpr void fill(int count) noexcept {
+        for (; count > 0; --count)
+          put(' ');
+      }
+      char* out;
+      size_type size{0};
+    };
+    static constexpr bool is_space(char c) noexcept {
+      return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+    static constexpr void wrap(const text& str, writer& dest, int line_len,
+                               int indent, int first_line_indent) noexcept {
+      if (indent > line_len - 1)
+        indent = line_len - 1;
+      if (first_line_indent > line_len - 1)
+        first_line_indent = line_len - 1;
+      bool written = false;
+      size_type line_start = 0;
+      while (line_start <= str.size()) {
+        size_type line_end = line_start;
+        while (line_end < str.size() && str[line_end] != '\n')
+          ++line_end;
+        const size_type base = line_start;
+        const size_type length = line_end - line_start;
+        const int cur_first_indent = line_start == 0 ? first_line_indent : indent;
+        line_start = line_end + 1;
+        if (written)
+          dest.put('\n');
+        bool line_written = false;
+        size_type pos = 0;
+        while (pos < length) {
+          const int cur_indent = line_written ? indent : cur_first_indent;
+          size_type start = pos;
+          if (line_written) {
+            while (start < length && is_space(str[base + start]))
+              ++start;
+          }
+          size_type end = start + static_cast<size_type>(line_len - cur_indent);
+          if (end > length)
+            end = length;
+          if (end < length) {
+            size_type word_start = end;
+            while (word_start > start && !is_space(str[base + word_start]))
+              --word_start;
+            if (word_start > start)
+              end = word_start;
+          }
+          pos = end;
+          while (end > start && is_space(str[base + end - 1]))
+            --end;
+          if (end > start) {
+            if (line_written)
+              dest.put('\n');
+            dest.fill(cur_indent);
+            for (size_type i = start; i < end; ++i)
+              dest.put(str[base + i]);
+            line_written = true;
+            written = true;
+          }
+        }
+      }
+    }
+  };
+  template <std::size_t N, std::size_t SlotCount, std::size_t BucketCount,
+            std::size_t HelpSize>
+  class option_schema {
+  public:
+    using size_type = std::size_t;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+    constexpr explicit option_schema(const option_spec* specs) : m_specs{specs} {
+      for (auto& entry : m_short_names)
+        entry = schema_parser::npos;
+      for (size_type i = 0; i < N; ++i) {
+        if (specs[i].short_name == '\0')
+          continue;
+        auto& entry = m_short_names[static_cast<unsigned char>(specs[i].short_name)];
+        if (entry != schema_parser::npos)
+          throw std::logic_error{"option_schema: duplicate short option name"};
+        entry = static_cast<std::uint32_t>(i);
+      }
+      build_long_names();
+      schema_layout::format_help(specs, N, m_help.data());
+    }
+    constexpr size_type size() const noexcept { return N; }
+    constexpr const option_spec& operator[](size_type pos) const noexcept {
+      return m_specs[pos];
+    }
+    constexpr size_type index_of(const char* long_name) const noexcept {
+      if (!*long_name)
+        return npos;
+      std::uint32_t h = schema_layout::hash(long_name);
+      std::uint32_t pos = m_slots[schema_parser::displaced_slot(
+        h, m_displacements[schema_parser::bucket(h, BucketCount)], SlotCount)];
+      if (pos == schema_parser::npos
+          || !schema_layout::equal(m_specs[pos].long_name, long_name))
+        return npos;
+      return pos;
+    }
+    constexpr size_type index_of(char short_name) const noexcept {
+      std::uint32_t pos = m_short_names[static_cast<unsigned char>(short_name)];
+      return short_name != '\0' && pos != schema_parser::npos ? pos : npos;
+    }
+    constexpr schema_parser parser() const noexcept {
+      return schema_parser{m_specs, N, m_slots.data(), SlotCount,
+                           m_displacements.data(), BucketCount,
+                           m_short_names.data(), m_help.data(), HelpSize};
+    }
+  private:
+    constexpr void build_long_names() {
+      for (auto& slot : m_slots)
+        slot = schema_parser::npos;
+      std::array<std::uint32_t, N + 1> hashes{};
+      std::array<size_type, BucketCount + 1> starts{};
+      for (size_type i = 0; i < N; ++i) {
+        if (!*m_specs[i].long_name)
+          continue;
+        hashes[i] = schema_layout::hash(m_specs[i].long_name);
+        ++starts[schema_parser::bucket(hashes[i], BucketCount) + 1];
+      }
+      size_type largest = 0;
+      for (size_type b = 0; b < BucketCount; ++b) {
+        largest = starts[b + 1] > largest ? starts[b + 1] : largest;
+        starts[b + 1] += starts[b];
+      }
+      std::array<std::uint32_t, N + 1> members{};
+      std::array<size_type, BucketCount> filled{};
+      for (size_type i = 0; i < N; ++i) {
+        if (!*m_specs[i].long_name)
+          continue;
+        size_type b = schema_parser::bucket(hashes[i], BucketCount);
+        members[starts[b] + filled[b]++] = static_cast<std::uint32_t>(i);
+      }
+      for (size_type size = largest; size > 0; --size) {
+        for (size_type b = 0; b < BucketCount; ++b) {
+          if (starts[b + 1] - starts[b] != size)
+            continue;
+          const size_type first = starts[b];
+          const size_type last = starts[b + 1];
+          for (size_type i = first; i < last; ++i) {
+            for (size_type j = first; j < i; ++j) {
+              if (hashes[members[i]] != hashes[members[j]])
+                continue;
+              if (schema_layout::equal(m_specs[members[i]].long_name,
+                                       m_specs[members[j]].long_name))
+                throw std::logic_error{"option_schema: duplicate long option name"};
+              throw std::logic_error{"option_schema: long option names with equal hashes"};
+            }
+          }
+          bool placed = false;
+          for (std::uint32_t d = 0; !placed; ++d) {
+            if (d == max_displacement)
+              throw std::logic_error{"option_schema: no perfect hash found"};
+            size_type i = first;
+            for (; i < last; ++i) {
+              auto& slot = m_slots[schema_parser::displaced_slot(hashes[members[i]], d, SlotCount)];
+              if (slot != schema_parser::npos)
+                break;
+              slot = members[i];
+            }
+            placed = i == last;
+            if (!placed) {
+              while (i-- > first)
+                m_slots[schema_parser::displaced_slot(hashes[members[i]], d, SlotCount)]
+                  = schema_parser::npos;
+            } else {
+              m_displacements[b] = d;
+            }
+          }
+        }
+      }
+    }
+    static constexpr std::uint32_t max_displacement = 1u << 16;
+    const option_spec* m_specs;
+    std::array<std::uint32_t, SlotCount> m_slots{};
+    std::array<std::uint32_t, BucketCount> m_displacements{};
+    std::array<std::uint32_t, 256> m_short_names{};
+    std::array<char, HelpSize + 1> m_help{};
+  };
+  template <const auto& Specs>
+  constexpr auto make_schema() {
+    constexpr std::size_t count = std::size(Specs);
+    constexpr std::size_t help_size
+      = schema_layout::format_help(std::data(Specs), count, nullptr);
+    return option_schema<count, schema_layout::slot_count(count),
+                         schema_layout::bucket_count(count), help_size>{std::data(Specs)};
+  }
+#endif
+}
+template <typename InputIt>
+bool optionpp::schema_parser::visit(InputIt first, InputIt last,
+                                    const option_handler& on_option,
+                                    const non_option_handler& on_non_option,
+                                    parse_status& status,
+                                    bool ignore_first) const {
+  status.clear();
+  visit_state state{on_option, on_non_option, status};
+  if (ignore_first && first != last) {
+    ++first;
+    ++state.index;
+  }
+  for (; first != last; ++first) {
+    if (!parse_token(string_ref{*first}, state) || state.stopped)
+      return false;
+  }
+  return finish(state) && !state.stopped;
+}
+
+
+
+#ifdef OPTIONPP_MAIN
+
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cfloat>
+#include <clocale>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace optionpp {
+  namespace {
+    const std::uint64_t power_of_five_128[] = {
+      0xeef453d6923bd65a, 0x113faa2906a13b3f,
+      0x9558b4661b6565f8, 0x4ac7ca59a424c507,
+      0xbaaee17fa23ebf76, 0x5d79bcf00d2df649,
+      0xe95a99df8ace6f53, 0xf4d82c2c107973dc,
+      0x91d8a02bb6c10594, 0x79071b9b8a4be869,
+      0xb64ec836a47146f9, 0x9748e2826cdee284,
+      0xe3e27a444d8d98b7, 0xfd1b1b2308169b25,
+      0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7,
+      0xb208ef855c969f4f, 0xbdbd2d335e51a935,
+      0xde8b2b66b3bc4723, 0xad2c788035e61382,
+      0x8b16fb203055ac76, 0x4c3bcb5021afcc31,
+      0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d,
+      0xd953e8624b85dd78, 0xd71d6dad34a2af0d,
+      0x87d4713d6f33aa6b, 0x8672648c40e5ad68,
+      0xa9c98d8ccb009506, 0x680efdaf511f18c2,
+      0xd43bf0effdc0ba48, 0x0212bd1b2566def2,
+      0x84a57695fe98746d, 0x014bb630f7604b57,
+      0xa5ced43b7e3e9188, 0x419ea3bd35385e2d,
+      0xcf42894a5dce35ea, 0x52064cac828675b9,
+      0x818995ce7aa0e1b2, 0x7343efebd1940993,
+      0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8,
+      0xca66fa129f9b60a6, 0xd41a26e077774ef6,
+      0xfd00b897478238d0, 0x8920b098955522b4,
+      0x9e20735e8cb16382, 0x55b46e5f5d5535b0,
+      0xc5a890362fddbc62, 0xeb2189f734aa831d,
+      0xf712b443bbd52b7b, 0xa5e9ec7501d523e4,
+      0x9a6bb0aa55653b2d, 0x47b233c92125366e,
+      0xc1069cd4eabe89f8, 0x999ec0bb696e840a,
+      0xf148440a256e2c76, 0xc00670ea43ca250d,
+      0x96cd2a865764dbca, 0x380406926a5e5728,
+      0xbc807527ed3e12bc, 0xc605083704f5ecf2,
+      0xeba09271e88d976b, 0xf7864a44c633682e,
+      0x93445b8731587ea3, 0x7ab3ee6afbe0211d,
+      0xb8157268fdae9e4c, 0x5960ea05bad82964,
+      0xe61acf033d1a45df, 0x6fb92487298e33bd,
+      0x8fd0c16206306bab, 0xa5d3b6d479f8e056,
+      0xb3c4f1ba87bc8696, 0x8f48a4899877186c,
+      0xe0b62e2929aba83c, 0x331acdabfe94de87,
+      0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14,
+      0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9,
+      0xdb71e91432b1a24a, 0xc9e82cd9f69d6150,
+      0x892731ac9faf056e, 0xbe311c083a225cd2,
+      0xab70fe17c79ac6ca, 0x6dbd630a48aaf406,
+      0xd64d3d9db981787d, 0x092cbbccdad5b108,
+      0x85f0468293f0eb4e, 0x25bbf56008c58ea5,
+      0xa76c582338ed2621, 0xaf2af2b80af6f24e,
+      0xd1476e2c07286faa, 0x1af5af660db4aee1,
+      0x82cca4db847945ca, 0x50d98d9fc890ed4d,
+      0xa37fce126597973c, 0xe50ff107bab528a0,
+      0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8,
+      0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a,
+      0x9faacf3df73609b1, 0x77b191618c54e9ac,
+      0xc795830d75038c1d, 0xd59df5b9ef6a2417,
+      0xf97ae3d0d2446f25, 0x4b0573286b44ad1d,
+      0x9becce62836ac577, 0x4ee367f9430aec32,
+      0xc2e801fb244576d5, 0x229c41f793cda73f,
+      0xf3a20279ed56d48a, 0x6b43527578c1110f,
+      0x9845418c345644d6, 0x830a13896b78aaa9,
+      0xbe5691ef416bd60c, 0x23cc986bc656d553,
+      0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8,
+      0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9,
+      0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53,
+      0xe858ad248f5c22c9, 0xd1b3400f8f9cff68,
+      0x91376c36d99995be, 0x23100809b9c21fa1,
+      0xb58547448ffffb2d, 0xabd40a0c2832a78a,
+      0xe2e69915b3fff9f9, 0x16c90c8f323f516c,
+      0x8dd01fad907ffc3b, 0xae3da7d97f6792e3,
+      0xb1442798f49ffb4a, 0x99cd11cfdf41779c,
+      0xdd95317f31c7fa1d, 0x40405643d711d583,
+      0x8a7d3eef7f1cfc52, 0x482835ea666b2572,
+      0xad1c8eab5ee43b66, 0xda3243650005eecf,
+      0xd863b256369d4a40, 0x90bed43e40076a82,
+      0x873e4f75e2224e68, 0x5a7744a6e804a291,
+      0xa90de3535aaae202, 0x711515d0a205cb36,
+      0xd3515c2831559a83, 0x0d5a5b44ca873e03,
+      0x8412d9991ed58091, 0xe858790afe9486c2,
+      0xa5178fff668ae0b6, 0x626e974dbe39a872,
+      0xce5d73ff402d98e3, 0xfb0a3d212dc8128f,
+      0x80fa687f881c7f8e, 0x7ce66634bc9d0b99,
+      0xa139029f6a239f72, 0x1c1fffc1ebc44e80,
+      0xc987434744ac874e, 0xa327ffb266b56220,
+      0xfbe9141915d7a922, 0x4bf1ff9f0062baa8,
+      0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9,
+      0xc4ce17b399107c22, 0xcb550fb4384d21d3,
+      0xf6019da07f549b2b, 0x7e2a53a146606a48,
+      0x99c102844f94e0fb, 0x2eda7444cbfc426d,
+      0xc0314325637a1939, 0xfa911155fefb5308,
+      0xf03d93eebc589f88, 0x793555ab7eba27ca,
+      0x96267c7535b763b5, 0x4bc1558b2f3458de,
+      0xbbb01b9283253ca2, 0x9eb1aaedfb016f16,
+      0xea9c227723ee8bcb, 0x465e15a979c1cadc,
+      0x92a1958a7675175f, 0x0bfacd89ec191ec9,
+      0xb749faed14125d36, 0xcef980ec671f667b,
+      0xe51c79a85916f484, 0x82b7e12780e7401a,
+      0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810,
+      0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15,
+      0xdfbdcece67006ac9, 0x67a791e093e1d49a,
+      0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0,
+      0xaecc49914078536d, 0x58fae9f773886e18,
+      0xda7f5bf590966848, 0xaf39a475506a899e,
+      0x888f99797a5e012d, 0x6d8406c952429603,
+      0xaab37fd7d8f58178, 0xc8e5087ba6d33b83,
+      0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64,
+      0x855c3be0a17fcd26, 0x5cf2eea09a55067f,
+      0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e,
+      0xd0601d8efc57b08b, 0xf13b94daf124da26,
+      0x823c12795db6ce57, 0x76c53d08d6b70858,
+      0xa2cb1717b52481ed, 0x54768c4b0c64ca6e,
+      0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09,
+      0xfe5d54150b090b02, 0xd3f93b35435d7c4c,
+      0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf,
+      0xc6b8e9b0709f109a, 0x359ab6419ca1091b,
+      0xf867241c8cc6d4c0, 0xc30163d203c94b62,
+      0x9b407691d7fc44f8, 0x79e0de63425dcf1d,
+      0xc21094364dfb5636, 0x985915fc12f542e4,
+      0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d,
+      0x979cf3ca6cec5b5a, 0xa705992ceecf9c42,
+      0xbd8430bd08277231, 0x50c6ff782a838353,
+      0xece53cec4a314ebd, 0xa4f8bf5635246428,
+      0x940f4613ae5ed136, 0x871b7795e136be99,
+      0xb913179899f68584, 0x28e2557b59846e3f,
+      0xe757dd7ec07426e5, 0x331aeada2fe589cf,
+      0x9096ea6f3848984f, 0x3ff0d2c85def7621,
+      0xb4bca50b065abe63, 0x0fed077a756b53a9,
+      0xe1ebce4dc7f16dfb, 0xd3e8495912c62894,
+      0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c,
+      0xb080392cc4349dec, 0xbd8d794d96aacfb3,
+      0xdca04777f541c567, 0xecf0d7a0fc5583a0,
+      0x89e42caaf9491b60, 0xf41686c49db57244,
+      0xac5d37d5b79b6239, 0x311c2875c522ced5,
+      0xd77485cb25823ac7, 0x7d633293366b828b,
+      0x86a8d39ef77164bc, 0xae5dff9c02033197,
+      0xa8530886b54dbdeb, 0xd9f57f830283fdfc,
+      0xd267caa862a12d66, 0xd072df63c324fd7b,
+      0x8380dea93da4bc60, 0x4247cb9e59f71e6d,
+      0xa46116538d0deb78, 0x52d9be85f074e608,
+      0xcd795be870516656, 0x67902e276c921f8b,
+      0x806bd9714632dff6, 0x00ba1cd8a3db53b6,
+      0xa086cfcd97bf97f3, 0x80e8a40eccd228a4,
+      0xc8a883c0fdaf7df0, 0x6122cd128006b2cd,
+      0xfad2a4b13d1b5d6c, 0x796b805720085f81,
+      0x9cc3a6eec6311a63, 0xcbe3303674053bb0,
+      0xc3f490aa77bd60fc, 0xbedbfc4411068a9c,
+      0xf4f1b4d515acb93b, 0xee92fb5515482d44,
+      0x991711052d8bf3c5, 0x751bdd152d4d1c4a,
+      0xbf5cd54678eef0b6, 0xd262d45a78a0635d,
+      0xef340a98172aace4, 0x86fb897116c87c34,
+      0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0,
+      0xbae0a846d2195712, 0x8974836059cca109,
+      0xe998d258869facd7, 0x2bd1a438703fc94b,
+      0x91ff83775423cc06, 0x7b6306a34627ddcf,
+      0xb67f6455292cbf08, 0x1a3bc84c17b1d542,
+      0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93,
+      0x8e938662882af53e, 0x547eb47b7282ee9c,
+      0xb23867fb2a35b28d, 0xe99e619a4f23aa43,
+      0xdec681f9f4c31f31, 0x6405fa00e2ec94d4,
+      0x8b3c113c38f9f37e, 0xde83bc408dd3dd04,
+      0xae0b158b4738705e, 0x9624ab50b148d445,
+      0xd98ddaee19068c76, 0x3badd624dd9b0957,
+      0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6,
+      0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c,
+      0xd47487cc8470652b, 0x7647c3200069671f,
+      0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073,
+      0xa5fb0a17c777cf09, 0xf468107100525890,
+      0xcf79cc9db955c2cc, 0x7182148d4066eeb4,
+      0x81ac1fe293d599bf, 0xc6f14cd848405530,
+      0xa21727db38cb002f, 0xb8ada00e5a506a7c,
+      0xca9cf1d206fdc03b, 0xa6d90811f0e4851c,
+      0xfd442e4688bd304a, 0x908f4a166d1da663,
+      0x9e4a9cec15763e2e, 0x9a598e4e043287fe,
+      0xc5dd44271ad3cdba, 0x40eff1e1853f29fd,
+      0xf7549530e188c128, 0xd12bee59e68ef47c,
+      0x9a94dd3e8cf578b9, 0x82bb74f8301958ce,
+      0xc13a148e3032d6e7, 0xe36a52363c1faf01,
+      0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1,
+      0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9,
+      0xbcb2b812db11a5de, 0x7415d448f6b6f0e7,
+      0xebdf661791d60f56, 0x111b495b3464ad21,
+      0x936b9fcebb25c995, 0xcab10dd900beec34,
+      0xb84687c269ef3bfb, 0x3d5d514f40eea742,
+      0xe65829b3046b0afa, 0x0cb4a5a3112a5112,
+      0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab,
+      0xb3f4e093db73a093, 0x59ed216765690f56,
+      0xe0f218b8d25088b8, 0x306869c13ec3532c,
+      0x8c974f7383725573, 0x1e414218c73a13fb,
+      0xafbd2350644eeacf, 0xe5d1929ef90898fa,
+      0xdbac6c247d62a583, 0xdf45f746b74abf39,
+      0x894bc396ce5da772, 0x6b8bba8c328eb783,
+      0xab9eb47c81f5114f, 0x066ea92f3f326564,
+      0xd686619ba27255a2, 0xc80a537b0efefebd,
+      0x8613fd0145877585, 0xbd06742ce95f5f36,
+      0xa798fc4196e952e7, 0x2c48113823b73704,
+      0xd17f3b51fca3a7a0, 0xf75a15862ca504c5,
+      0x82ef85133de648c4, 0x9a984d73dbe722fb,
+      0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba,
+      0xcc963fee10b7d1b3, 0x318df905079926a8,
+      0xffbbcfe994e5c61f, 0xfdf17746497f7052,
+      0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633,
+      0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0,
+      0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0,
+      0x9c1661a651213e2d, 0x06bea10ca65c084e,
+      0xc31bfa0fe5698db8, 0x486e494fcff30a62,
+      0xf3e2f893dec3f126, 0x5a89dba3c3efccfa,
+      0x986ddb5c6b3a76b7, 0xf89629465a75e01c,
+      0xbe89523386091465, 0xf6bbb397f1135823,
+      0xee2ba6c0678b597f, 0x746aa07ded582e2c,
+      0x94db483840b717ef, 0xa8c2a44eb4571cdc,
+      0xba121a4650e4ddeb, 0x92f34d62616ce413,
+      0xe896a0d7e51e1566, 0x77b020baf9c81d17,
+      0x915e2486ef32cd60, 0x0ace1474dc1d122e,
+      0xb5b5ada8aaff80b8, 0x0d819992132456ba,
+      0xe3231912d5bf60e6, 0x10e1fff697ed6c69,
+      0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1,
+      0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2,
+      0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde,
+      0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b,
+      0xad4ab7112eb3929d, 0x86c16c98d2c953c6,
+      0xd89d64d57a607744, 0xe871c7bf077ba8b7,
+      0x87625f056c7c4a8b, 0x11471cd764ad4972,
+      0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf,
+      0xd389b47879823479, 0x4aff1d108d4ec2c3,
+      0x843610cb4bf160cb, 0xcedf722a585139ba,
+      0xa54394fe1eedb8fe, 0xc2974eb4ee658828,
+      0xce947a3da6a9273e, 0x733d226229feea32,
+      0x811ccc668829b887, 0x0806357d5a3f525f,
+      0xa163ff802a3426a8, 0xca07c2dcb0cf26f7,
+      0xc9bcff6034c13052, 0xfc89b393dd02f0b5,
+      0xfc2c3f3841f17c67, 0xbbac2078d443ace2,
+      0x9d9ba7832936edc0, 0xd54b944b84aa4c0d,
+      0xc5029163f384a931, 0x0a9e795e65d4df11,
+      0xf64335bcf065d37d, 0x4d4617b5ff4a16d5,
+      0x99ea0196163fa42e, 0x504bced1bf8e4e45,
+      0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6,
+      0xf07da27a82c37088, 0x5d767327bb4e5a4c,
+      0x964e858c91ba2655, 0x3a6a07f8d510f86f,
+      0xbbe226efb628afea, 0x890489f70a55368b,
+      0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e,
+      0x92c8ae6b464fc96f, 0x3b0b8bc90012929d,
+      0xb77ada0617e3bbcb, 0x09ce6ebb40173744,
+      0xe55990879ddcaabd, 0xcc420a6a101d0515,
+      0x8f57fa54c2a9eab6, 0x9fa946824a12232d,
+      0xb32df8e9f3546564, 0x47939822dc96abf9,
+      0xdff9772470297ebd, 0x59787e2b93bc56f7,
+      0x8bfbea76c619ef36, 0x57eb4edb3c55b65a,
+      0xaefae51477a06b03, 0xede622920b6b23f1,
+      0xdab99e59958885c4, 0xe95fab368e45eced,
+      0x88b402f7fd75539b, 0x11dbcb0218ebb414,
+      0xaae103b5fcd2a881, 0xd652bdc29f26a119,
+      0xd59944a37c0752a2, 0x4be76d3346f0495f,
+      0x857fcae62d8493a5, 0x6f70a4400c562ddb,
+      0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952,
+      0xd097ad07a71f26b2, 0x7e2000a41346a7a7,
+      0x825ecc24c873782f, 0x8ed400668c0c28c8,
+      0xa2f67f2dfa90563b, 0x728900802f0f32fa,
+      0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9,
+      0xfea126b7d78186bc, 0xe2f610c84987bfa8,
+      0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9,
+      0xc6ede63fa05d3143, 0x91503d1c79720dbb,
+      0xf8a95fcf88747d94, 0x75a44c6397ce912a,
+      0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba,
+      0xc24452da229b021b, 0xfbe85badce996168,
+      0xf2d56790ab41c2a2, 0xfae27299423fb9c3,
+      0x97c560ba6b0919a5, 0xdccd879fc967d41a,
+      0xbdb6b8e905cb600f, 0x5400e987bbc1c920,
+      0xed246723473e3813, 0x290123e9aab23b68,
+      0x9436c0760c86e30b, 0xf9a0b6720aaf6521,
+      0xb94470938fa89bce, 0xf808e40e8d5b3e69,
+      0xe7958cb87392c2c2, 0xb60b1d1230b20e04,
+      0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2,
+      0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3,
+      0xe2280b6c20dd5232, 0x25c6da63c38de1b0,
+      0x8d590723948a535f, 0x579c487e5a38ad0e,
+      0xb0af48ec79ace837, 0x2d835a9df0c6d851,
+      0xdcdb1b2798182244, 0xf8e431456cf88e65,
+      0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff,
+      0xac8b2d36eed2dac5, 0xe272467e3d222f3f,
+      0xd7adf884aa879177, 0x5b0ed81dcc6abb0f,
+      0x86ccbb52ea94baea, 0x98e947129fc2b4e9,
+      0xa87fea27a539e9a5, 0x3f2398d747b36224,
+      0xd29fe4b18e88640e, 0x8eec7f0d19a03aad,
+      0x83a3eeeef9153e89, 0x1953cf68300424ac,
+      0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7,
+      0xcdb02555653131b6, 0x3792f412cb06794d,
+      0x808e17555f3ebf11, 0xe2bbd88bbee40bd0,
+      0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4,
+      0xc8de047564d20a8b, 0xf245825a5a445275,
+      0xfb158592be068d2e, 0xeed6e2f0f0d56712,
+      0x9ced737bb6c4183d, 0x55464dd69685606b,
+      0xc428d05aa4751e4c, 0xaa97e14c3c26b886,
+      0xf53304714d9265df, 0xd53dd99f4b3066a8,
+      0x993fe2c6d07b7fab, 0xe546a8038efe4029,
+      0xbf8fdb78849a5f96, 0xde98520472bdd033,
+      0xef73d256a5c0f77c, 0x963e66858f6d4440,
+      0x95a8637627989aad, 0xdde7001379a44aa8,
+      0xbb127c53b17ec159, 0x5560c018580d5d52,
+      0xe9d71b689dde71af, 0xaab8f01e6e10b4a6,
+      0x9226712162ab070d, 0xcab3961304ca70e8,
+      0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22,
+      0xe45c10c42a2b3b05, 0x8cb89a7db77c506a,
+      0x8eb98a7a9a5b04e3, 0x77f3608e92adb242,
+      0xb267ed1940f1c61c, 0x55f038b237591ed3,
+      0xdf01e85f912e37a3, 0x6b6c46dec52f6688,
+      0x8b61313bbabce2c6, 0x2323ac4b3b3da015,
+      0xae397d8aa96c1b77, 0xabec975e0a0d081a,
+      0xd9c7dced53c72255, 0x96e7bd358c904a21,
+      0x881cea14545c7575, 0x7e50d64177da2e54,
+      0xaa242499697392d2, 0xdde50bd1d5d0b9e9,
+      0xd4ad2dbfc3d07787, 0x955e4ec64b44e864,
+      0x84ec3c97da624ab4, 0xbd5af13bef0b113e,
+      0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e,
+      0xcfb11ead453994ba, 0x67de18eda5814af2,
+      0x81ceb32c4b43fcf4, 0x80eacf948770ced7,
+      0xa2425ff75e14fc31, 0xa1258379a94d028d,
+      0xcad2f7f5359a3b3e, 0x096ee45813a04330,
+      0xfd87b5f28300ca0d, 0x8bca9d6e188853fc,
+      0x9e74d1b791e07e48, 0x775ea264cf55347e,
+      0xc612062576589dda, 0x95364afe032a819e,
+      0xf79687aed3eec551, 0x3a83ddbd83f52205,
+      0x9abe14cd44753b52, 0xc4926a9672793543,
+      0xc16d9a0095928a27, 0x75b7053c0f178294,
+      0xf1c90080baf72cb1, 0x5324c68b12dd6339,
+      0x971da05074da7bee, 0xd3f6fc16ebca5e04,
+      0xbce5086492111aea, 0x88f4bb1ca6bcf585,
+      0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6,
+      0x9392ee8e921d5d07, 0x3aff322e62439fd0,
+      0xb877aa3236a4b449, 0x09befeb9fad487c3,
+      0xe69594bec44de15b, 0x4c2ebe687989a9b4,
+      0x901d7cf73ab0acd9, 0x0f9d37014bf60a11,
+      0xb424dc35095cd80f, 0x538484c19ef38c95,
+      0xe12e13424bb40e13, 0x2865a5f206b06fba,
+      0x8cbccc096f5088cb, 0xf93f87b7442e45d4,
+      0xafebff0bcb24aafe, 0xf78f69a51539d749,
+      0xdbe6fecebdedd5be, 0xb573440e5a884d1c,
+      0x89705f4136b4a597, 0x31680a88f8953031,
+      0xabcc77118461cefc, 0xfdc20d2b36ba7c3e,
+      0xd6bf94d5e57a42bc, 0x3d32907604691b4d,
+      0x8637bd05af6c69b5, 0xa63f9a49c2c1b110,
+      0xa7c5ac471b478423, 0x0fcf80dc33721d54,
+      0xd1b71758e219652b, 0xd3c36113404ea4a9,
+      0x83126e978d4fdf3b, 0x645a1cac083126ea,
+      0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4,
+      0xcccccccccccccccc, 0xcccccccccccccccd,
+      0x8000000000000000, 0x0000000000000000,
+      0xa000000000000000, 0x0000000000000000,
+      0xc800000000000000, 0x0000000000000000,
+      0xfa00000000000000, 0x0000000000000000,
+      0x9c40000000000000, 0x0000000000000000,
+      0xc350000000000000, 0x0000000000000000,
+      0xf424000000000000, 0x0000000000000000,
+      0x9896800000000000, 0x0000000000000000,
+      0xbebc200000000000, 0x0000000000000000,
+      0xee6b280000000000, 0x0000000000000000,
+      0x9502f90000000000, 0x0000000000000000,
+      0xba43b74000000000, 0x0000000000000000,
+      0xe8d4a51000000000, 0x0000000000000000,
+      0x9184e72a00000000, 0x0000000000000000,
+      0xb5e620f480000000, 0x0000000000000000,
+      0xe35fa931a0000000, 0x0000000000000000,
+      0x8e1bc9bf04000000, 0x0000000000000000,
+      0xb1a2bc2ec5000000, 0x0000000000000000,
+      0xde0b6b3a76400000, 0x0000000000000000,
+      0x8ac7230489e80000, 0x0000000000000000,
+      0xad78ebc5ac620000, 0x0000000000000000,
+      0xd8d726b7177a8000, 0x0000000000000000,
+      0x878678326eac9000, 0x0000000000000000,
+      0xa968163f0a57b400, 0x0000000000000000,
+      0xd3c21bcecceda100, 0x0000000000000000,
+      0x84595161401484a0, 0x0000000000000000,
+      0xa56fa5b99019a5c8, 0x0000000000000000,
+      0xcecb8f27f4200f3a, 0x0000000000000000,
+      0x813f3978f8940984, 0x4000000000000000,
+      0xa18f07d736b90be5, 0x5000000000000000,
+      0xc9f2c9cd04674ede, 0xa400000000000000,
+      0xfc6f7c4045812296, 0x4d00000000000000,
+      0x9dc5ada82b70b59d, 0xf020000000000000,
+      0xc5371912364ce305, 0x6c28000000000000,
+      0xf684df56c3e01bc6, 0xc732000000000000,
+      0x9a130b963a6c115c, 0x3c7f400000000000,
+      0xc097ce7bc90715b3, 0x4b9f100000000000,
+      0xf0bdc21abb48db20, 0x1e86d40000000000,
+      0x96769950b50d88f4, 0x1314448000000000,
+      0xbc143fa4e250eb31, 0x17d955a000000000,
+      0xeb194f8e1ae525fd, 0x5dcfab0800000000,
+      0x92efd1b8d0cf37be, 0x5aa1cae500000000,
+      0xb7abc627050305ad, 0xf14a3d9e40000000,
+      0xe596b7b0c643c719, 0x6d9ccd05d0000000,
+      0x8f7e32ce7bea5c6f, 0xe4820023a2000000,
+      0xb35dbf821ae4f38b, 0xdda2802c8a800000,
+      0xe0352f62a19e306e, 0xd50b2037ad200000,
+      0x8c213d9da502de45, 0x4526f422cc340000,
+      0xaf298d050e4395d6, 0x9670b12b7f410000,
+      0xdaf3f04651d47b4c, 0x3c0cdd765f114000,
+      0x88d8762bf324cd0f, 0xa5880a69fb6ac800,
+      0xab0e93b6efee0053, 0x8eea0d047a457a00,
+      0xd5d238a4abe98068, 0x72a4904598d6d880,
+      0x85a36366eb71f041, 0x47a6da2b7f864750,
+      0xa70c3c40a64e6c51, 0x999090b65f67d924,
+      0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d,
+      0x82818f1281ed449f, 0xbff8f10e7a8921a4,
+      0xa321f2d7226895c7, 0xaff72d52192b6a0d,
+      0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490,
+      0xfee50b7025c36a08, 0x02f236d04753d5b4,
+      0x9f4f2726179a2245, 0x01d762422c946590,
+      0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5,
+      0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2,
+      0x9b934c3b330c8577, 0x63cc55f49f88eb2f,
+      0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb,
+      0xf316271c7fc3908a, 0x8bef464e3945ef7a,
+      0x97edd871cfda3a56, 0x97758bf0e3cbb5ac,
+      0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317,
+      0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd,
+      0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a,
+      0xb975d6b6ee39e436, 0xb3e2fd538e122b44,
+      0xe7d34c64a9c85d44, 0x60dbbca87196b616,
+      0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd,
+      0xb51d13aea4a488dd, 0x6babab6398bdbe41,
+      0xe264589a4dcdab14, 0xc696963c7eed2dd1,
+      0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2,
+      0xb0de65388cc8ada8, 0x3b25a55f43294bcb,
+      0xdd15fe86affad912, 0x49ef0eb713f39ebe,
+      0x8a2dbf142dfcc7ab, 0x6e3569326c784337,
+      0xacb92ed9397bf996, 0x49c2c37f07965404,
+      0xd7e77a8f87daf7fb, 0xdc33745ec97be906,
+      0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3,
+      0xa8acd7c0222311bc, 0xc40832ea0d68ce0c,
+      0xd2d80db02aabd62b, 0xf50a3fa490c30190,
+      0x83c7088e1aab65db, 0x792667c6da79e0fa,
+      0xa4b8cab1a1563f52, 0x577001b891185938,
+      0xcde6fd5e09abcf26, 0xed4c0226b55e6f86,
+      0x80b05e5ac60b6178, 0x544f8158315b05b4,
+      0xa0dc75f1778e39d6, 0x696361ae3db1c721,
+      0xc913936dd571c84c, 0x03bc3a19cd1e38e9,
+      0xfb5878494ace3a5f, 0x04ab48a04065c723,
+      0x9d174b2dcec0e47b, 0x62eb0d64283f9c76,
+      0xc45d1df942711d9a, 0x3ba5d0bd324f8394,
+      0xf5746577930d6500, 0xca8f44ec7ee36479,
+      0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb,
+      0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e,
+      0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e,
+      0x95d04aee3b80ece5, 0xbba1f1d158724a12,
+      0xbb445da9ca61281f, 0x2a8a6e45ae8edc97,
+      0xea1575143cf97226, 0xf52d09d71a3293bd,
+      0x924d692ca61be758, 0x593c2626705f9c56,
+      0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c,
+      0xe498f455c38b997a, 0x0b6dfb9c0f956447,
+      0x8edf98b59a373fec, 0x4724bd4189bd5eac,
+      0xb2977ee300c50fe7, 0x58edec91ec2cb657,
+      0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed,
+      0x8b865b215899f46c, 0xbd79e0d20082ee74,
+      0xae67f1e9aec07187, 0xecd8590680a3aa11,
+      0xda01ee641a708de9, 0xe80e6f4820cc9495,
+      0x884134fe908658b2, 0x3109058d147fdcdd,
+      0xaa51823e34a7eede, 0xbd4b46f0599fd415,
+      0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a,
+      0x850fadc09923329e, 0x03e2cf6bc604ddb0,
+      0xa6539930bf6bff45, 0x84db8346b786151c,
+      0xcfe87f7cef46ff16, 0xe612641865679a63,
+      0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e,
+      0xa26da3999aef7749, 0xe3be5e330f38f09d,
+      0xcb090c8001ab551c, 0x5cadf5bfd3072cc5,
+      0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6,
+      0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa,
+      0xc646d63501a1511d, 0xb281e1fd541501b8,
+      0xf7d88bc24209a565, 0x1f225a7ca91a4226,
+      0x9ae757596946075f, 0x3375788de9b06958,
+      0xc1a12d2fc3978937, 0x0052d6b1641c83ae,
+      0xf209787bb47d6b84, 0xc0678c5dbd23a49a,
+      0x9745eb4d50ce6332, 0xf840b7ba963646e0,
+      0xbd176620a501fbff, 0xb650e5a93bc3d898,
+      0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe,
+      0x93ba47c980e98cdf, 0xc66f336c36b10137,
+      0xb8a8d9bbe123f017, 0xb80b0047445d4184,
+      0xe6d3102ad96cec1d, 0xa60dc059157491e5,
+      0x9043ea1ac7e41392, 0x87c89837ad68db2f,
+      0xb454e4a179dd1877, 0x29babe4598c311fb,
+      0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a,
+      0x8ce2529e2734bb1d, 0x1899e4a65f58660c,
+      0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f,
+      0xdc21a1171d42645d, 0x76707543f4fa1f73,
+      0x899504ae72497eba, 0x6a06494a791c53a8,
+      0xabfa45da0edbde69, 0x0487db9d17636892,
+      0xd6f8d7509292d603, 0x45a9d2845d3c42b6,
+      0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2,
+      0xa7f26836f282b732, 0x8e6cac7768d7141e,
+      0xd1ef0244af2364ff, 0x3207d795430cd926,
+      0x8335616aed761f1f, 0x7f44e6bd49e807b8,
+      0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6,
+      0xcd036837130890a1, 0x36dba887c37a8c0f,
+      0x802221226be55a64, 0xc2494954da2c9789,
+      0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c,
+      0xc83553c5c8965d3d, 0x6f92829494e5acc7,
+      0xfa42a8b73abbf48c, 0xcb772339ba1f17f9,
+      0x9c69a97284b578d7, 0xff2a760414536efb,
+      0xc38413cf25e2d70d, 0xfef5138519684aba,
+      0xf46518c2ef5b8cd1, 0x7eb258665fc25d69,
+      0x98bf2f79d5993802, 0xef2f773ffbd97a61,
+      0xbeeefb584aff8603, 0xaafb550ffacfd8fa,
+      0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38,
+      0x952ab45cfa97a0b2, 0xdd945a747bf26183,
+      0xba756174393d88df, 0x94f971119aeef9e4,
+      0xe912b9d1478ceb17, 0x7a37cd5601aab85d,
+      0x91abb422ccb812ee, 0xac62e055c10ab33a,
+      0xb616a12b7fe617aa, 0x577b986b314d6009,
+      0xe39c49765fdf9d94, 0xed5a7e85fda0b80b,
+      0x8e41ade9fbebc27d, 0x14588f13be847307,
+      0xb1d219647ae6b31c, 0x596eb2d8ae258fc8,
+      0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb,
+      0x8aec23d680043bee, 0x25de7bb9480d5854,
+      0xada72ccc20054ae9, 0xaf561aa79a10ae6a,
+      0xd910f7ff28069da4, 0x1b2ba1518094da04,
+      0x87aa9aff79042286, 0x90fb44d2f05d0842,
+      0xa99541bf57452b28, 0x353a1607ac744a53,
+      0xd3fa922f2d1675f2, 0x42889b8997915ce8,
+      0x847c9b5d7c2e09b7, 0x69956135febada11,
+      0xa59bc234db398c25, 0x43fab9837e699095,
+      0xcf02b2c21207ef2e, 0x94f967e45e03f4bb,
+      0x8161afb94b44f57d, 0x1d1be0eebac278f5,
+      0xa1ba1ba79e1632dc, 0x6462d92a69731732,
+      0xca28a291859bbf93, 0x7d7b8f7503cfdcfe,
+      0xfcb2cb35e702af78, 0x5cda735244c3d43e,
+      0x9defbf01b061adab, 0x3a0888136afa64a7,
+      0xc56baec21c7a1916, 0x088aaa1845b8fdd0,
+      0xf6c69a72a3989f5b, 0x8aad549e57273d45,
+      0x9a3c2087a63f6399, 0x36ac54e2f678864b,
+      0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd,
+      0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5,
+      0x969eb7c47859e743, 0x9f644ae5a4b1b325,
+      0xbc4665b596706114, 0x873d5d9f0dde1fee,
+      0xeb57ff22fc0c7959, 0xa90cb506d155a7ea,
+      0x9316ff75dd87cbd8, 0x09a7f12442d588f2,
+      0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f,
+      0xe5d3ef282a242e81, 0x8f1668c8a86da5fa,
+      0x8fa475791a569d10, 0xf96e017d694487bc,
+      0xb38d92d760ec4455, 0x37c981dcc395a9ac,
+      0xe070f78d3927556a, 0x85bbe253f47b1417,
+      0x8c469ab843b89562, 0x93956d7478ccec8e,
+      0xaf58416654a6babb, 0x387ac8d1970027b2,
+      0xdb2e51bfe9d0696a, 0x06997b05fcc0319e,
+      0x88fcf317f22241e2, 0x441fece3bdf81f03,
+      0xab3c2fddeeaad25a, 0xd527e81cad7626c3,
+      0xd60b3bd56a5586f1, 0x8a71e223d8d3b074,
+      0x85c7056562757456, 0xf6872d5667844e49,
+      0xa738c6bebb12d16c, 0xb428f8ac016561db,
+      0xd106f86e69d785c7, 0xe13336d701beba52,
+      0x82a45b450226b39c, 0xecc0024661173473,
+      0xa34d721642b06084, 0x27f002d7f95d0190,
+      0xcc20ce9bd35c78a5, 0x31ec038df7b441f4,
+      0xff290242c83396ce, 0x7e67047175a15271,
+      0x9f79a169bd203e41, 0x0f0062c6e984d386,
+      0xc75809c42c684dd1, 0x52c07b78a3e60868,
+      0xf92e0c3537826145, 0xa7709a56ccdf8a82,
+      0x9bbcc7a142b17ccb, 0x88a66076400bb691,
+      0xc2abf989935ddbfe, 0x6acff893d00ea435,
+      0xf356f7ebf83552fe, 0x0583f6b8c4124d43,
+      0x98165af37b2153de, 0xc3727a337a8b704a,
+      0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c,
+      0xeda2ee1c7064130c, 0x1162def06f79df73,
+      0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8,
+      0xb9a74a0637ce2ee1, 0x6d953e2bd7173692,
+      0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437,
+      0x910ab1d4db9914a0, 0x1d9c9892400a22a2,
+      0xb54d5e4a127f59c8, 0x2503beb6d00cab4b,
+      0xe2a0b5dc971f303a, 0x2e44ae64840fd61d,
+      0x8da471a9de737e24, 0x5ceaecfed289e5d2,
+      0xb10d8e1456105dad, 0x7425a83e872c5f47,
+      0xdd50f1996b947518, 0xd12f124e28f77719,
+      0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f,
+      0xace73cbfdc0bfb7b, 0x636cc64d1001550b,
+      0xd8210befd30efa5a, 0x3c47f7e05401aa4e,
+      0x8714a775e3e95c78, 0x65acfaec34810a71,
+      0xa8d9d1535ce3b396, 0x7f1839a741a14d0d,
+      0xd31045a8341ca07c, 0x1ede48111209a050,
+      0x83ea2b892091e44d, 0x934aed0aab460432,
+      0xa4e4b66b68b65d60, 0xf81da84d5617853f,
+      0xce1de40642e3f4b9, 0x36251260ab9d668e,
+      0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019,
+      0xa1075a24e4421730, 0xb24cf65b8612f81f,
+      0xc94930ae1d529cfc, 0xdee033f26797b627,
+      0xfb9b7cd9a4a7443c, 0x169840ef017da3b1,
+      0x9d412e0806e88aa5, 0x8e1f289560ee864e,
+      0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2,
+      0xf5b5d7ec8acb58a2, 0xae10af696774b1db,
+      0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29,
+      0xbff610b0cc6edd3f, 0x17fd090a58d32af3,
+      0xeff394dcff8a948e, 0xddfc4b4cef07f5b0,
+      0x95f83d0a1fb69cd9, 0x4abdaf101564f98e,
+      0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1,
+      0xea53df5fd18d5513, 0x84c86189216dc5ed,
+      0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4,
+      0xb7118682dbb66a77, 0x3fbc8c33221dc2a1,
+      0xe4d5e82392a40515, 0x0fabaf3feaa5334a,
+      0x8f05b1163ba6832d, 0x29cb4d87f2a7400e,
+      0xb2c71d5bca9023f8, 0x743e20e9ef511012,
+      0xdf78e4b2bd342cf6, 0x914da9246b255416,
+      0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e,
+      0xae9672aba3d0c320, 0xa184ac2473b529b1,
+      0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e,
+      0x8865899617fb1871, 0x7e2fa67c7a658892,
+      0xaa7eebfb9df9de8d, 0xddbb901b98feeab7,
+      0xd51ea6fa85785631, 0x552a74227f3ea565,
+      0x8533285c936b35de, 0xd53a88958f87275f,
+      0xa67ff273b8460356, 0x8a892abaf368f137,
+      0xd01fef10a657842c, 0x2d2b7569b0432d85,
+      0x8213f56a67f6b29b, 0x9c3b29620e29fc73,
+      0xa298f2c501f45f42, 0x8349f3ba91b47b8f,
+      0xcb3f2f7642717713, 0x241c70a936219a73,
+      0xfe0efb53d30dd4d7, 0xed238cd383aa0110,
+      0x9ec95d1463e8a506, 0xf4363804324a40aa,
+      0xc67bb4597ce2ce48, 0xb143c6053edcd0d5,
+      0xf81aa16fdc1b81da, 0xdd94b7868e94050a,
+      0x9b10a4e5e9913128, 0xca7cf2b4191c8326,
+      0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0,
+      0xf24a01a73cf2dccf, 0xbc633b39673c8cec,
+      0x976e41088617ca01, 0xd5be0503e085d813,
+      0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18,
+      0xec9c459d51852ba2, 0xddf8e7d60ed1219e,
+      0x93e1ab8252f33b45, 0xcabb90e5c942b503,
+      0xb8da1662e7b00a17, 0x3d6a751f3b936243,
+      0xe7109bfba19c0c9d, 0x0cc512670a783ad4,
+      0x906a617d450187e2, 0x27fb2b80668b24c5,
+      0xb484f9dc9641e9da, 0xb1f9f660802dedf6,
+      0xe1a63853bbd26451, 0x5e7873f8a0396973,
+      0x8d07e33455637eb2, 0xdb0b487b6423e1e8,
+      0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62,
+      0xdc5c5301c56b75f7, 0x7641a140cc7810fb,
+      0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d,
+      0xac2820d9623bf429, 0x546345fa9fbdcd44,
+      0xd732290fbacaf133, 0xa97c177947ad4095,
+      0x867f59a9d4bed6c0, 0x49ed8eabcccc485d,
+      0xa81f301449ee8c70, 0x5c68f256bfff5a74,
+      0xd226fc195c6a2f8c, 0x73832eec6fff3111,
+      0x83585d8fd9c25db7, 0xc831fd53c5ff7eab,
+      0xa42e74f3d032f525, 0xba3e7ca8b77f5e55,
+      0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb,
+      0x80444b5e7aa7cf85, 0x7980d163cf5b81b3,
+      0xa0555e361951c366, 0xd7e105bcc332621f,
+      0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7,
+      0xfa856334878fc150, 0xb14f98f6f0feb951,
+      0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3,
+      0xc3b8358109e84f07, 0x0a862f80ec4700c8,
+      0xf4a642e14c6262c8, 0xcd27bb612758c0fa,
+      0x98e7e9cccfbd7dbd, 0x8038d51cb897789c,
+      0xbf21e44003acdd2c, 0xe0470a63e6bd56c3,
+      0xeeea5d5004981478, 0x1858ccfce06cac74,
+      0x95527a5202df0ccb, 0x0f37801e0c43ebc8,
+      0xbaa718e68396cffd, 0xd30560258f54e6ba,
+      0xe950df20247c83fd, 0x47c6b82ef32a2069,
+      0x91d28b7416cdd27e, 0x4cdc331d57fa5441,
+      0xb6472e511c81471d, 0xe0133fe4adf8e952,
+      0xe3d8f9e563a198e5, 0x58180fddd97723a6,
+      0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648,
+    };
+    const int smallest_power_of_ten = -342;
+    const int largest_power_of_ten = 308;
+    const double exact_powers_of_ten[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    inline bool is_digit(char c) noexcept {
+      return c >= '0' && c <= '9';
+    }
+    bool match_word(const char* p, const char* last, const char* word) noexcept {
+      for (; *word; ++word, ++p) {
+        if (p == last || (*p | 0x20) != *word)
+          return false;
+      }
+      return true;
+    }
+    struct uint128 {
+      std::uint64_t high;
+      std::uint64_t low;
+    };
+    uint128 full_multiplication(std::uint64_t a, std::uint64_t b) noexcept {
+#ifdef __SIZEOF_INT128__
+      __extension__ typedef unsigned __int128 wide_type;
+      wide_type product = static_cast<wide_type>(a) * b;
+      return uint128{static_cast<std::uint64_t>(product >> 64),
+          static_cast<std::uint64_t>(product)};
+#else
+      const std::uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+      const std::uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+      const std::uint64_t lo_lo = a_lo * b_lo;
+      const std::uint64_t hi_lo = a_hi * b_lo;
+      const std::uint64_t lo_hi = a_lo * b_hi;
+      const std::uint64_t hi_hi = a_hi * b_hi;
+      const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+      return uint128{(hi_lo >> 32) + (cross >> 32) + hi_hi,
+          (cross << 32) | (lo_lo & 0xffffffff)};
+#endif
+    }
+    inline int leading_zeroes(std::uint64_t value) noexcept {
+#ifdef __GNUC__
+      return __builtin_clzll(value);
+#else
+      int count = 0;
+      for (std::uint64_t bit = std::uint64_t{1} << 63; !(value & bit); bit >>= 1)
+        ++count;
+      return count;
+#endif
+    }
+    bool clinger(std::uint64_t mantissa, long long exponent, double& value) noexcept {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+      if (exponent < -22 || exponent > 22 || mantissa > (std::uint64_t{1} << 53))
+        return false;
+      value = static_cast<double>(mantissa);
+      if (exponent < 0)
+        value /= exact_powers_of_ten[-exponent];
+      else
+        value *= exact_powers_of_ten[exponent];
+      return true;
+#else
+      (void) mantissa;
+      (void) exponent;
+      (void) value;
+      return false;
+#endif
+    }
+    bool eisel_lemire(std::uint64_t mantissa, long long exponent,
+                      double& value) noexcept {
+      const int mantissa_bits = 52;
+      const int minimum_exponent = -1023;
+      const int infinite_power = 0x7ff;
+      if (exponent < smallest_power_of_ten) {
+        value = 0.0;
+        return true;
+      }
+      if (exponent > largest_power_of_ten) {
+        value = HUGE_VAL;
+        return true;
+      }
+      const int q = static_cast<int>(exponent);
+      const int lz = leading_zeroes(mantissa);
+      mantissa <<= lz;
+      const std::size_t index = 2 * static_cast<std::size_t>(q - smallest_power_of_ten);
+      uint128 product = full_multiplication(mantissa, power_of_five_128[index]);
+      const std::uint64_t precision_mask = ~std::uint64_t{0} >> (mantissa_bits + 3);
+      if ((product.high & precision_mask) == precision_mask) {
+        uint128 second = full_multiplication(mantissa, power_of_five_128[index + 1]);
+        product.low += second.high;
+        if (second.high > product.low)
+          ++product.high;
+      }
+      if (product.low == ~std::uint64_t{0} && (q < -27 || q > 55))
+        return false;
+      const int upper_bit = static_cast<int>(product.high >> 63);
+      std::uint64_t bits = product.high >> (upper_bit + 64 - mantissa_bits - 3);
+      int power2 = (((152170 + 65536) * q) >> 16) + 63 + upper_bit - lz - minimum_exponent;
+      if (power2 <= 0) {
+        if (-power2 + 1 >= 64) {
+          value = 0.0;
+          return true;
+        }
+        bits >>= -power2 + 1;
+        bits += bits & 1;
+        bits >>= 1;
+        power2 = bits < (std::uint64_t{1} << mantissa_bits) ? 0 : 1;
+      } else {
+        if (product.low <= 1 && q >= -4 && q <= 23 && (bits & 3) == 1
+            && (bits << (upper_bit + 64 - mantissa_bits - 3)) == product.high)
+          bits &= ~std::uint64_t{1};
+        bits += bits & 1;
+        bits >>= 1;
+        if (bits >= (std::uint64_t{2} << mantissa_bits)) {
+          bits = std::uint64_t{1} << mantissa_bits;
+          ++power2;
+        }
+        bits &= ~(std::uint64_t{1} << mantissa_bits);
+        if (power2 >= infinite_power) {
+          value = HUGE_VAL;
+          return true;
+        }
+      }
+      const std::uint64_t word = bits | (static_cast<std::uint64_t>(power2) << mantissa_bits);
+      std::memcpy(&value, &word, sizeof value);
+      return true;
+    }
+    bool slow_path(const char* first, const char* last, double& value) noexcept {
+      const char point = *std::localeconv()->decimal_point;
+      char small[128];
+      std::string large;
+      char* buffer = small;
+      const std::size_t size = last - first;
+      if (size >= sizeof small) {
+        try {
+          large.resize(size + 1);
+        } catch (...) {
+          return false;
+        }
+        buffer = &large[0];
+      }
+      for (std::size_t i = 0; i != size; ++i)
+        buffer[i] = first[i] == '.' ? point : first[i];
+      buffer[size] = '\0';
+      errno = 0;
+      char* end = nullptr;
+      value = std::strtod(buffer, &end);
+      return end == buffer + size;
+    }
+  }
+  from_chars_result from_chars(const char* first, const char* last,
+                               long long& value) noexcept {
+    const char* p = first;
+    bool negative = false;
+    if (p != last && (*p == '-' || *p == '+')) {
+      negative = *p == '-';
+      ++p;
+    }
+    const unsigned long long limit = negative
+      ? static_cast<unsigned long long>(std::numeric_limits<long long>::max()) + 1
+      : static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+    const char* digits = p;
+    unsigned long long magnitude = 0;
+    bool overflow = false;
+    for (; p != last && is_digit(*p); ++p) {
+      unsigned digit = *p - '0';
+      if (magnitude > (limit - digit) / 10)
+        overflow = true;
+      else
+        magnitude = magnitude * 10 + digit;
+    }
+    if (p == digits)
+      return from_chars_result{first, std::errc::invalid_argument};
+    if (overflow)
+      return from_chars_result{p, std::errc::result_out_of_range};
+    if (!negative)
+      value = static_cast<long long>(magnitude);
+    else if (magnitude == limit)
+      value = std::numeric_limits<long long>::min();
+    else
+      value = -static_cast<long long>(magnitude);
+    return from_chars_result{p, std::errc{}};
+  }
+  from_chars_result from_chars(const char* first, const char* last,
+                               unsigned long long& value) noexcept {
+    const char* p = first;
+    if (p != last && *p == '+')
+      ++p;
+    const unsigned long long limit = std::numeric_limits<unsigned long long>::max();
+    const char* digits = p;
+    unsigned long long magnitude = 0;
+    bool overflow = false;
+    for (; p != last && is_digit(*p); ++p) {
+      unsigned digit = *p - '0';
+      if (magnitude > (limit - digit) / 10)
+        overflow = true;
+      else
+        magnitude = magnitude * 10 + digit;
+    }
+    if (p == digits)
+      return from_chars_result{first, std::errc::invalid_argument};
+    if (overflow)
+      return from_chars_result{p, std::errc::result_out_of_range};
+    value = magnitude;
+    return from_chars_result{p, std::errc{}};
+  }
+  from_chars_result from_chars(const char* first, const char* last,
+                               double& value) noexcept {
+    const char* p = first;
+    bool negative = false;
+    if (p != last && (*p == '-' || *p == '+')) {
+      negative = *p == '-';
+      ++p;
+    }
+    if (p != last && !is_digit(*p) && *p != '.') {
+      double special;
+      if (match_word(p, last, "inf")) {
+        p += match_word(p, last, "infinity") ? 8 : 3;
+        special = HUGE_VAL;
+      } else if (match_word(p, last, "nan")) {
+        p += 3;
+        special = std::numeric_limits<double>::quiet_NaN();
+      } else {
+        return from_chars_result{first, std::errc::invalid_argument};
+      }
+      value = negative ? -special : special;
+      return from_chars_result{p, std::errc{}};
+    }
+    std::uint64_t mantissa = 0;
+    int digit_count = 0;
+    bool too_many_digits = false;
+    long long exponent = 0;
+    bool any_digits = false;
+    for (; p != last && is_digit(*p); ++p) {
+      any_digits = true;
+      if (digit_count == 19) {
+        too_many_digits = true;
+      } else if (mantissa != 0 || *p != '0') {
+        mantissa = mantissa * 10 + (*p - '0');
+        ++digit_count;
+      }
+    }
+    if (p != last && *p == '.') {
+      for (++p; p != last && is_digit(*p); ++p) {
+        any_digits = true;
+        if (digit_count == 19) {
+          too_many_digits = true;
+        } else {
+          if (mantissa != 0 || *p != '0') {
+            mantissa = mantissa * 10 + (*p - '0');
+            ++digit_count;
+          }
+          --exponent;
+        }
+      }
+    }
+    if (!any_digits)
+      return from_chars_result{first, std::errc::invalid_argument};
+    if (p != last && (*p == 'e' || *p == 'E')) {
+      const char* e = p + 1;
+      bool negative_exponent = false;
+      if (e != last && (*e == '-' || *e == '+')) {
+        negative_exponent = *e == '-';
+        ++e;
+      }
+      if (e != last && is_digit(*e)) {
+        long long explicit_exponent = 0;
+        for (; e != last && is_digit(*e); ++e) {
+          if (explicit_exponent < 100000000)
+            explicit_exponent = explicit_exponent * 10 + (*e - '0');
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+        p = e;
+      }
+    }
+    double result = 0.0;
+    if (too_many_digits) {
+      if (!slow_path(first, p, result))
+        return from_chars_result{first, std::errc::invalid_argument};
+      result = std::fabs(result);
+    } else if (mantissa != 0
+               && !clinger(mantissa, exponent, result)
+               && !eisel_lemire(mantissa, exponent, result)) {
+      if (!slow_path(first, p, result))
+        return from_chars_result{first, std::errc::invalid_argument};
+      result = std::fabs(result);
+    }
+    if ((mantissa != 0 || too_many_digits) && (result == 0.0 || std::isinf(result)))
+      return from_chars_result{p, std::errc::result_out_of_range};
+    value = negative ? -result : result;
+    return from_chars_result{p, std::errc{}};
+  }
+}
+
+namespace optionpp {
+  const string_ref::size_type string_ref::npos;
+  auto string_ref::find(char c, size_type pos) const noexcept -> size_type {
+    if (pos >= m_size)
+      return npos;
+    const void* found = std::memchr(m_data + pos, c, m_size - pos);
+    if (!found)
+      return npos;
+    return static_cast<const char*>(found) - m_data;
+  }
+  auto string_ref::find(string_ref str, size_type pos) const noexcept -> size_type {
+    if (str.m_size == 1)
+      return find(str.m_data[0], pos);
+    if (pos > m_size || str.m_size > m_size - pos)
+      return npos;
+    auto it = std::search(begin() + pos, end(), str.begin(), str.end());
+    if (it == end() && !str.empty())
+      return npos;
+    return it - begin();
+  }
+  int string_ref::compare(string_ref other) const noexcept {
+    size_type len = std::min(m_size, other.m_size);
+    int result = len ? std::memcmp(m_data, other.m_data, len) : 0;
+    if (result != 0)
+      return result;
+    if (m_size == other.m_size)
+      return 0;
+    return m_size < other.m_size ? -1 : 1;
+  }
+  std::ostream& operator<<(std::ostream& os, string_ref str) {
+    return os.write(str.data(), str.size());
+  }
+}
+
+namespace optionpp {
+  auto option_syntax::split(string_ref token) const noexcept -> token_parts {
+    token_parts parts{token_kind::non_option, token, string_ref{}, false};
+    if (token == m_end_of_options) {
+      parts.kind = token_kind::end_of_options;
+      return parts;
+    }
+    auto pos = m_equals.size() == 1 ? token.find(m_equals[0]) : token.find(m_equals);
+    if (pos != string_ref::npos) {
+      parts.has_argument = true;
+      parts.specifier = token.substr(0, pos);
+      parts.argument = token.substr(pos + m_equals.size());
+      if (parts.specifier == m_short_prefix || parts.specifier == m_long_prefix) {
+        parts.kind = token_kind::bad_assignment;
+        return parts;
+      }
+    }
+    if (has_prefix(parts.specifier, m_long_prefix))
+      parts.kind = token_kind::long_option;
+    else if (has_prefix(parts.specifier, m_short_prefix))
+      parts.kind = token_kind::short_options;
+    return parts;
+  }
+}
+
+namespace optionpp {
+  constexpr string_pool::id_type string_pool::npos;
+  void string_pool::clear() noexcept {
+    m_text.clear();
+    m_records.clear();
+    std::fill(m_slots.begin(), m_slots.end(), slot{0, npos});
+  }
+  void string_pool::reserve(size_type count, size_type length) {
+    size_type slot_count = 16;
+    while (slot_count < 2 * count)
+      slot_count *= 2;
+    if (slot_count > m_slots.size())
+      rehash(slot_count);
+    m_records.reserve(count);
+    m_text.reserve(length);
+  }
+  auto string_pool::intern(string_ref str, std::uint32_t h) -> id_type {
+    id_type id = find(str, h);
+    if (id != npos)
+      return id;
+    const size_type limit = std::numeric_limits<std::uint32_t>::max();
+    if (m_records.size() >= limit - 1 || str.size() > limit - m_text.size())
+      throw std::length_error{"string_pool is full"};
+    if (2 * (m_records.size() + 1) > m_slots.size())
+      rehash(std::max<size_type>(16, 2 * m_slots.size()));
+    id = static_cast<id_type>(m_records.size());
+    m_records.push_back(record{static_cast<std::uint32_t>(m_text.size()),
+                               static_cast<std::uint32_t>(str.size())});
+    m_text.append(str.data(), str.size());
+    place(slot{h, id});
+    return id;
+  }
+  std::uint32_t string_pool::hash(const char* str, size_type length) noexcept {
+    std::uint32_t h = 2166136261u;
+    for (size_type i = 0; i < length; ++i) {
+      h ^= static_cast<unsigned char>(str[i]);
+      h *= 16777619u;
+    }
+    return h;
+  }
+  auto string_pool::find(string_ref str, std::uint32_t h) const noexcept
+    -> id_type {
+    if (m_records.empty())
+      return npos;
+    size_type mask = m_slots.size() - 1;
+    for (size_type i = h & mask; m_slots[i].id != npos; i = (i + 1) & mask) {
+      const slot& s = m_slots[i];
+      if (s.hash == h) {
+        const record& r = m_records[s.id];
+        if (r.length == str.size()
+            && std::memcmp(m_text.data() + r.offset, str.data(), r.length) == 0)
+          return s.id;
+      }
+    }
+    return npos;
+  }
+  void string_pool::rehash(size_type slot_count) {
+    std::vector<slot> old(slot_count, slot{0, npos});
+    old.swap(m_slots);
+    for (const auto& s : old) {
+      if (s.id != npos)
+        place(s);
+    }
+  }
+  void string_pool::place(const slot& entry) noexcept {
+    size_type mask = m_slots.size() - 1;
+    size_type i = entry.hash & mask;
+    while (m_slots[i].id != npos)
+      i = (i + 1) & mask;
+    m_slots[i] = entry;
+  }
+}
+
+namespace optionpp {
+  constexpr std::uint32_t suggestion_index::none;
+  void suggestion_index::insert(string_ref name) {
+    if (name.empty() || m_names.find(name) != string_pool::npos)
+      return;
+    if (m_nodes.empty()) {
+      m_names.intern(name);
+      m_nodes.push_back(node{0, none, none});
+      return;
+    }
+    size_type current = 0;
+    for (;;) {
+      auto d = static_cast<std::uint32_t>(
+        distance(name, m_names.get(static_cast<string_pool::id_type>(current)),
+                 none - 1));
+      std::uint32_t child = m_nodes[current].first_child;
+      while (child != none && m_nodes[child].distance != d)
+        child = m_nodes[child].next_sibling;
+      if (child == none) {
+        m_names.intern(name);
+        m_nodes.push_back(node{d, none, m_nodes[current].first_child});
+        m_nodes[current].first_child = static_cast<std::uint32_t>(m_nodes.size() - 1);
+        return;
+      }
+      current = child;
+    }
+  }
+  std::vector<std::string> suggestion_index::find(string_ref word,
+                                                  size_type max_distance,
+                                                  size_type max_results) const {
+    const bool bit_parallel = !word.empty() && word.size() <= 64;
+    std::array<std::uint64_t, 256> masks{};
+    if (bit_parallel) {
+      for (size_type i = 0; i < word.size(); ++i)
+        masks[static_cast<unsigned char>(word[i])] |= std::uint64_t{1} << i;
+    }
+    std::vector<std::pair<size_type, size_type>> matches;
+    std::vector<size_type> pending;
+    if (!m_nodes.empty())
+      pending.push_back(0);
+    while (!pending.empty()) {
+      size_type current = pending.back();
+      pending.pop_back();
+      size_type limit = 0;
+      for (size_type child = m_nodes[current].first_child; child != none;
+           child = m_nodes[child].next_sibling)
+        limit = std::max<size_type>(limit, m_nodes[child].distance);
+      limit += max_distance;
+      string_ref name = m_names.get(static_cast<string_pool::id_type>(current));
+      size_type d = bit_parallel ? distance(masks.data(), word.size(), name, limit)
+                                 : distance(word, name, limit);
+      if (d <= max_distance)
+        matches.emplace_back(d, current);
+      if (d > limit)
+        continue;
+      size_type low = d > max_distance ? d - max_distance : 0;
+      size_type high = d + max_distance;
+      for (size_type child = m_nodes[current].first_child; child != none;
+           child = m_nodes[child].next_sibling) {
+        if (m_nodes[child].distance >= low && m_nodes[child].distance <= high)
+          pending.push_back(child);
+      }
+    }
+    std::sort(matches.begin(), matches.end(),
+              [this](const std::pair<size_type, size_type>& a,
+                     const std::pair<size_type, size_type>& b) {
+                if (a.first != b.first)
+                  return a.first < b.first;
+                return m_names.get(static_cast<string_pool::id_type>(a.second))
+                  < m_names.get(static_cast<string_pool::id_type>(b.second));
+              });
+    std::vector<std::string> result;
+    for (size_type i = 0; i < matches.size() && i < max_results; ++i)
+      result.push_back(m_names.get(static_cast<string_pool::id_type>(matches[i].second)).str());
+    return result;
+  }
+  auto suggestion_index::distance(const std::uint64_t* masks, size_type length,
+                                  string_ref text, size_type limit) noexcept
+    -> size_type {
+    if (text.size() > length + limit || length > text.size() + limit)
+      return limit + 1;
+    const std::uint64_t last = std::uint64_t{1} << (length - 1);
+    std::uint64_t plus = ~std::uint64_t{0};
+    std::uint64_t minus = 0;
+    size_type score = length;
+    for (size_type i = 0; i < text.size(); ++i) {
+      std::uint64_t eq = masks[static_cast<unsigned char>(text[i])];
+      std::uint64_t xv = eq | minus;
+      std::uint64_t xh = (((eq & plus) + plus) ^ plus) | eq;
+      std::uint64_t hplus = minus | ~(xh | plus);
+      std::uint64_t hminus = plus & xh;
+      if (hplus & last)
+        ++score;
+      else if (hminus & last)
+        --score;
+      hplus = (hplus << 1) | 1;
+      hminus <<= 1;
+      plus = hminus | ~(xv | hplus);
+      minus = hplus & xv;
+    }
+    return std::min(score, limit + 1);
+  }
+  auto suggestion_index::distance(string_ref a, string_ref b, size_type limit)
+    -> size_type {
+    if (a.size() < b.size())
+      std::swap(a, b);
+    if (a.size() - b.size() > limit)
+      return limit + 1;
+    const size_type local_size = 64;
+    size_type local_row[local_size];
+    std::vector<size_type> heap_row;
+    size_type* row = local_row;
+    if (b.size() >= local_size) {
+      heap_row.resize(b.size() + 1);
+      row = heap_row.data();
+    }
+    for (size_type j = 0; j <= b.size(); ++j)
+      row[j] = j;
+    for (size_type i = 1; i <= a.size(); ++i) {
+      size_type diagonal = row[0];
+      row[0] = i;
+      size_type row_min = row[0];
+      for (size_type j = 1; j <= b.size(); ++j) {
+        size_type above = row[j];
+        size_type cost = a[i - 1] == b[j - 1] ? 0 : 1;
+        row[j] = std::min(std::min(above, row[j - 1]) + 1, diagonal + cost);
+        diagonal = above;
+        row_min = std::min(row_min, row[j]);
+      }
+      if (row_min > limit)
+        return limit + 1;
+    }
+    return std::min(row[b.size()], limit + 1);
+  }
+}
+
+namespace optionpp {
+  parse_error parse_status::to_error() const {
+    const char* fn_name;
+    switch (m_error) {
+    case parse_errc::missing_argument:
+      fn_name = "optionpp::parser::parse";
+      break;
+    case parse_errc::invalid_option:
+    case parse_errc::unexpected_argument:
+    case parse_errc::ambiguous_option:
+      fn_name = "optionpp::parser::parse_argument";
+      break;
+    case parse_errc::unreadable_file:
+    case parse_errc::recursive_file:
+      fn_name = "optionpp::compiled_parser::parse_response_file";
+      break;
+    case parse_errc::unknown_command:
+      fn_name = "optionpp::command_parser::parse";
+      break;
+    default:
+      fn_name = "optionpp::option::write_argument";
+      break;
+    }
+    return parse_error{message(), fn_name, m_option};
+  }
+  std::vector<std::string> parse_status::suggestions() const {
+    if (!m_suggestions || m_error != parse_errc::invalid_option)
+      return std::vector<std::string>{};
+    string_ref name{m_option.data() + m_prefix_size,
+                    m_option.size() - m_prefix_size};
+    size_type max_distance = std::max<size_type>(1, std::min<size_type>(3, name.size() / 3));
+    auto result = m_suggestions->find(name, max_distance, 3);
+    for (auto& suggestion : result)
+      suggestion.insert(0, m_option, 0, m_prefix_size);
+    return result;
+  }
+  std::string parse_status::message() const {
+    std::string msg = message(m_error, m_option);
+    if (!m_candidates.empty()) {
+      msg += "; possibilities:";
+      for (const auto& candidate : m_candidates)
+        msg += " '" + candidate + "'";
+    }
+    auto suggested = suggestions();
+    if (!suggested.empty()) {
+      msg += "; did you mean ";
+      for (std::size_t i = 0; i < suggested.size(); ++i) {
+        if (i != 0)
+          msg += i + 1 == suggested.size() ? " or " : ", ";
+        msg += "'" + suggested[i] + "'";
+      }
+      msg += "?";
+    }
+    return msg;
+  }
+  std::string parse_status::message(parse_errc error, string_ref option) {
+    const std::string name = option.str();
+    switch (error) {
+    case parse_errc::none:
+      return std::string{};
+    case parse_errc::invalid_option:
+      return "invalid option: '" + name + "'";
+    case parse_errc::missing_argument:
+      return "option '" + name + "' requires an argument";
+    case parse_errc::unexpected_argument:
+      return "option '" + name + "' does not accept arguments";
+    case parse_errc::not_an_integer:
+      return "argument for option '" + name + "' must be an integer";
+    case parse_errc::negative_argument:
+      return "argument for option '" + name + "' must not be negative";
+    case parse_errc::not_a_number:
+      return "argument for option '" + name + "' must be a number";
+    case parse_errc::unreadable_file:
+      return "cannot read response file '" + name + "'";
+    case parse_errc::recursive_file:
+      return "response file '" + name + "' includes itself";
+    case parse_errc::invalid_value:
+      return "argument for option '" + name + "' is not valid";
+    case parse_errc::ambiguous_option:
+      return "option '" + name + "' is ambiguous";
+    case parse_errc::unknown_command:
+      return "unknown command: '" + name + "'";
+    case parse_errc::out_of_range:
+    default:
+      return "argument for option '" + name + "' is out of range";
+    }
+  }
+}
+
+namespace optionpp {
+  namespace {
+    bool checked_multiply(unsigned long long a, unsigned long long b,
+                          unsigned long long& product) noexcept {
+      if (a != 0 && b > std::numeric_limits<unsigned long long>::max() / a)
+        return false;
+      product = a * b;
+      return true;
+    }
+    bool unit_is(string_ref unit, const char* expected) noexcept {
+      string_ref::size_type i = 0;
+      for (; i != unit.size() && expected[i] != '\0'; ++i) {
+        char c = unit[i];
+        if (c >= 'A' && c <= 'Z')
+          c = static_cast<char>(c - 'A' + 'a');
+        if (c != expected[i])
+          return false;
+      }
+      return i == unit.size() && expected[i] == '\0';
+    }
+  }
+  parse_errc convert_integer(string_ref argument, long long& value,
+                             long long min, long long max) noexcept {
+    const char* first = argument.data();
+    const char* last = first + argument.size();
+    long long result = 0;
+    auto conv = from_chars(first, last, result);
+    if (conv.ec == std::errc::invalid_argument || conv.ptr != last)
+      return parse_errc::not_an_integer;
+    if (conv.ec == std::errc::result_out_of_range || result < min || result > max)
+      return parse_errc::out_of_range;
+    value = result;
+    return parse_errc::none;
+  }
+  parse_errc convert_unsigned(string_ref argument, unsigned long long& value,
+                              unsigned long long max) noexcept {
+    const char* first = argument.data();
+    const char* last = first + argument.size();
+    if (first != last && *first == '-') {
+      long long negative = 0;
+      auto err = convert_integer(argument, negative,
+                                 std::numeric_limits<long long>::min(),
+                                 std::numeric_limits<long long>::max());
+      if (err != parse_errc::none)
+        return err;
+      if (negative < 0)
+        return parse_errc::negative_argument;
+      value = 0;
+      return parse_errc::none;
+    }
+    unsigned long long result = 0;
+    auto conv = from_chars(first, last, result);
+    if (conv.ec == std::errc::invalid_argument || conv.ptr != last)
+      return parse_errc::not_an_integer;
+    if (conv.ec == std::errc::result_out_of_range || result > max)
+      return parse_errc::out_of_range;
+    value = result;
+    return parse_errc::none;
+  }
+  parse_errc convert_floating(string_ref argument, double& value,
+                              double max) noexcept {
+    const char* first = argument.data();
+    const char* last = first + argument.size();
+    double result = 0;
+    auto conv = from_chars(first, last, result);
+    if (conv.ec == std::errc::invalid_argument || conv.ptr != last)
+      return parse_errc::not_a_number;
+    if (conv.ec == std::errc::result_out_of_range
+        || (std::isfinite(result) && std::fabs(result) > max))
+      return parse_errc::out_of_range;
+    value = result;
+    return parse_errc::none;
+  }
+  parse_errc convert_byte_size(string_ref argument,
+                               unsigned long long& value) noexcept {
+    const char* first = argument.data();
+    const char* last = first + argument.size();
+    if (first != last && *first == '-')
+      return parse_errc::negative_argument;
+    unsigned long long integer = 0;
+    double real = 0;
+    auto int_conv = from_chars(first, last, integer);
+    auto real_conv = from_chars(first, last, real);
+    if (real_conv.ec == std::errc::invalid_argument)
+      return parse_errc::not_a_number;
+    const bool is_integer = int_conv.ec != std::errc::invalid_argument
+      && int_conv.ptr == real_conv.ptr;
+    if (is_integer && int_conv.ec == std::errc::result_out_of_range)
+      return parse_errc::out_of_range;
+    if (!is_integer && !std::isfinite(real))
+      return parse_errc::not_a_number;
+    string_ref unit{real_conv.ptr, static_cast<string_ref::size_type>(last - real_conv.ptr)};
+    unsigned long long multiplier = 1;
+    if (!unit.empty() && !unit_is(unit, "b")) {
+      static const char prefixes[] = "kmgtpe";
+      char prefix = unit[0];
+      if (prefix >= 'A' && prefix <= 'Z')
+        prefix = static_cast<char>(prefix - 'A' + 'a');
+      int power = 0;
+      while (prefixes[power] != '\0' && prefixes[power] != prefix)
+        ++power;
+      if (prefixes[power] == '\0')
+        return parse_errc::invalid_value;
+      string_ref rest = unit.substr(1);
+      if (!rest.empty() && !unit_is(rest, "b") && !unit_is(rest, "i")
+          && !unit_is(rest, "ib"))
+        return parse_errc::invalid_value;
+      multiplier = 1ULL << (10 * (power + 1));
+    }
+    if (is_integer) {
+      if (!checked_multiply(integer, multiplier, value))
+        return parse_errc::out_of_range;
+      return parse_errc::none;
+    }
+    const long double bytes = std::floor(static_cast<long double>(real) * multiplier + 0.5L);
+    if (!(bytes < 18446744073709551616.0L))
+      return parse_errc::out_of_range;
+    value = static_cast<unsigned long long>(bytes);
+    return parse_errc::none;
+  }
+  parse_errc convert_duration(string_ref argument,
+                              std::intmax_t num, std::intmax_t den,
+                              bool integral, long long& count,
+                              long double& real) noexcept {
+    const char* first = argument.data();
+    const char* last = first + argument.size();
+    long long integer = 0;
+    double number = 0;
+    auto int_conv = from_chars(first, last, integer);
+    auto real_conv = from_chars(first, last, number);
+    if (real_conv.ec == std::errc::invalid_argument)
+      return parse_errc::not_a_number;
+    const bool is_integer = int_conv.ec == std::errc{}
+      && int_conv.ptr == real_conv.ptr;
+    struct unit_info {
+      const char* name;
+      std::intmax_t num;
+      std::intmax_t den;
+    };
+    static const unit_info units[] = {
+      {"ns", 1, 1000000000}, {"us", 1, 1000000}, {"ms", 1, 1000},
+      {"s", 1, 1}, {"m", 60, 1}, {"min", 60, 1}, {"h", 3600, 1},
+      {"d", 86400, 1}
+    };
+    string_ref unit{real_conv.ptr, static_cast<string_ref::size_type>(last - real_conv.ptr)};
+    std::intmax_t unit_num = num;
+    std::intmax_t unit_den = den;
+    if (!unit.empty()) {
+      const unit_info* info = nullptr;
+      for (const auto& u : units) {
+        if (unit == u.name)
+          info = &u;
+      }
+      if (!info)
+        return parse_errc::invalid_value;
+      unit_num = info->num;
+      unit_den = info->den;
+    }
+    unsigned long long scale_num = 0, scale_den = 0;
+    if (integral && is_integer
+        && checked_multiply(static_cast<unsigned long long>(unit_num),
+                            static_cast<unsigned long long>(den), scale_num)
+        && checked_multiply(static_cast<unsigned long long>(unit_den),
+                            static_cast<unsigned long long>(num), scale_den)
+        && scale_num % scale_den == 0) {
+      const unsigned long long factor = scale_num / scale_den;
+      const unsigned long long magnitude = integer < 0
+        ? 0ULL - static_cast<unsigned long long>(integer)
+        : static_cast<unsigned long long>(integer);
+      unsigned long long scaled = 0;
+      const unsigned long long limit = integer < 0
+        ? static_cast<unsigned long long>(std::numeric_limits<long long>::max()) + 1
+        : static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+      if (!checked_multiply(magnitude, factor, scaled) || scaled > limit)
+        return parse_errc::out_of_range;
+      count = integer < 0 ? static_cast<long long>(0ULL - scaled)
+        : static_cast<long long>(scaled);
+      return parse_errc::none;
+    }
+    if (real_conv.ec == std::errc::result_out_of_range)
+      return parse_errc::out_of_range;
+    const long double value = static_cast<long double>(number) * unit_num / unit_den
+      * den / num;
+    if (!integral) {
+      real = value;
+      return parse_errc::none;
+    }
+    const long double rounded = std::floor(value + 0.5L);
+    if (!(rounded >= -9223372036854775808.0L && rounded < 9223372036854775808.0L))
+      return parse_errc::out_of_range;
+    count = static_cast<long long>(rounded);
+    return parse_errc::none;
+  }
+}
+
+namespace optionpp {
+  text_arena::text_arena(text_arena&& other) noexcept
+    : m_blocks{std::move(other.m_blocks)},
+      m_block_size{other.m_block_size},
+      m_current{other.m_current},
+      m_used{other.m_used} {
+    other.release();
+  }
+  text_arena& text_arena::operator=(text_arena&& other) noexcept {
+    if (this != &other) {
+      m_blocks = std::move(other.m_blocks);
+      m_block_size = other.m_block_size;
+      m_current = other.m_current;
+      m_used = other.m_used;
+      other.release();
+    }
+    return *this;
+  }
+  string_ref text_arena::store(string_ref str) {
+    if (str.empty())
+      return string_ref{};
+    char* dest = allocate(str.size());
+    std::memcpy(dest, str.data(), str.size());
+    return string_ref{dest, str.size()};
+  }
+  string_ref text_arena::store(string_ref a, string_ref b, string_ref c) {
+    size_type length = a.size() + b.size() + c.size();
+    if (length == 0)
+      return string_ref{};
+    char* dest = allocate(length);
+    char* pos = dest;
+    for (string_ref part : { a, b, c }) {
+      if (!part.empty())
+        std::memcpy(pos, part.data(), part.size());
+      pos += part.size();
+    }
+    return string_ref{dest, length};
+  }
+  char* text_arena::allocate(size_type length) {
+    while (m_current < m_blocks.size()
+           && m_blocks[m_current].size - m_used < length) {
+      ++m_current;
+      m_used = 0;
+    }
+    if (m_current == m_blocks.size()) {
+      size_type size = std::max(m_block_size, length);
+      m_blocks.push_back(block{std::unique_ptr<char[]>{new char[size]}, size});
+    }
+    char* result = m_blocks[m_current].data.get() + m_used;
+    m_used += length;
+    return result;
+  }
+}
+
+namespace optionpp {
+  const text_pool::size_type text_pool::first_block_size;
+  const text_pool::size_type text_pool::max_blocks;
+  auto text_pool::store(string_ref str) -> span {
+    if (str.empty())
+      return span{0, 0};
+    size_type b = block_of(static_cast<std::uint32_t>(m_end));
+    size_type offset = m_end;
+    while (b >= max_blocks || str.size() > block_start(b + 1) - offset) {
+      if (++b >= max_blocks)
+        throw std::length_error{"text_pool is full"};
+      offset = block_start(b);
+    }
+    if (!m_blocks[b])
+      m_blocks[b].reset(new char[block_start(b + 1) - block_start(b)]);
+    std::memcpy(m_blocks[b].get() + (offset - block_start(b)),
+                str.data(), str.size());
+    m_end = offset + str.size();
+    return span{static_cast<std::uint32_t>(offset),
+                static_cast<std::uint32_t>(str.size())};
+  }
+}
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+namespace optionpp {
+  namespace {
+    inline unsigned lowest_bit(unsigned mask) noexcept {
+#if defined(_MSC_VER)
+      unsigned long index;
+      _BitScanForward(&index, mask);
+      return static_cast<unsigned>(index);
+#else
+      return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+    const std::string::size_type max_parallel_chars = 8;
+  }
+  tokenizer::tokenizer(const std::string& delims, const std::string& quotes,
+                       char escape_char, bool allow_empty)
+    : m_allow_empty{allow_empty} {
+    m_classes.fill(plain);
+    for (char c : delims)
+      m_classes[static_cast<unsigned char>(c)] |= delim;
+    for (char c : quotes)
+      m_classes[static_cast<unsigned char>(c)] |= quote;
+    m_classes[static_cast<unsigned char>(escape_char)] |= escape;
+    for (unsigned c = 0; c != m_classes.size(); ++c) {
+      if (m_classes[c] != plain)
+        m_specials.push_back(static_cast<char>(c));
+    }
+  }
+  bool tokenizer::next(string_ref input, size_type& pos, string_ref& token,
+                       std::string& buffer) const {
+    const char* data = input.data();
+    const char* end = data + input.size();
+    while (pos <= input.size()) {
+      const char* start = data + pos;
+      const char* found = find_special(start, end);
+      if (found == end) {
+        token = string_ref{start, static_cast<size_type>(end - start)};
+        pos = input.size() + 1;
+      } else if (m_classes[static_cast<unsigned char>(*found)] & delim) {
+        token = string_ref{start, static_cast<size_type>(found - start)};
+        pos = found - data + 1;
+      } else {
+        buffer.assign(start, found);
+        pos = found - data;
+        if (!finish_token(input, pos, buffer))
+          pos = input.size() + 1;
+        token = string_ref{buffer};
+      }
+      if (!token.empty() || m_allow_empty)
+        return true;
+    }
+    return false;
+  }
+  bool tokenizer::finish_token(string_ref input, size_type& pos,
+                               std::string& buffer) const {
+    const char* data = input.data();
+    bool escape_next = false;
+    bool in_quotes = false;
+    char closing_quote = '\0';
+    while (pos < input.size()) {
+      char c = data[pos];
+      unsigned char cls = m_classes[static_cast<unsigned char>(c)];
+      if (in_quotes) {
+        if (escape_next) {
+          buffer.push_back(c);
+          escape_next = false;
+        } else if (c == closing_quote) {
+          in_quotes = false;
+        } else if (cls & escape) {
+          escape_next = true;
+        } else {
+          buffer.push_back(c);
+        }
+      } else if (escape_next) {
+        buffer.push_back(c);
+        escape_next = false;
+      } else if (cls & delim) {
+        ++pos;
+        return true;
+      } else if (cls & escape) {
+        escape_next = true;
+      } else if (cls & quote) {
+        in_quotes = true;
+        closing_quote = c;
+      } else {
+        const char* found = find_special(data + pos, data + input.size());
+        buffer.append(data + pos, found);
+        pos = found - data;
+        continue;
+      }
+      ++pos;
+    }
+    return false;
+  }
+  const char* tokenizer::find_special(const char* first,
+                                      const char* last) const noexcept {
+    const auto count = m_specials.size();
+    if (count == 0)
+      return last;
+    if (count <= max_parallel_chars) {
+#if defined(__AVX2__)
+      __m256i needles32[max_parallel_chars];
+      for (std::string::size_type i = 0; i != count; ++i)
+        needles32[i] = _mm256_set1_epi8(m_specials[i]);
+      while (last - first >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        __m256i match = _mm256_cmpeq_epi8(block, needles32[0]);
+        for (std::string::size_type i = 1; i != count; ++i)
+          match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, needles32[i]));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(match));
+        if (mask != 0)
+          return first + lowest_bit(mask);
+        first += 32;
+      }
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+      __m128i needles16[max_parallel_chars];
+      for (std::string::size_type i = 0; i != count; ++i)
+        needles16[i] = _mm_set1_epi8(m_specials[i]);
+      while (last - first >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i match = _mm_cmpeq_epi8(block, needles16[0]);
+        for (std::string::size_type i = 1; i != count; ++i)
+          match = _mm_or_si128(match, _mm_cmpeq_epi8(block, needles16[i]));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(match));
+        if (mask != 0)
+          return first + lowest_bit(mask);
+        first += 16;
+      }
+#endif
+    }
+    for (; first != last; ++first) {
+      if (m_classes[static_cast<unsigned char>(*first)] != plain)
+        return first;
+    }
+    return last;
+  }
+}
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+namespace optionpp {
+#if defined(_WIN32)
+  bool mapped_file::open(const std::string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+    BY_HANDLE_FILE_INFORMATION info;
+    if (!GetFileInformationByHandle(file, &info)
+        || (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+      CloseHandle(file);
+      return false;
+    }
+    m_id.device = info.dwVolumeSerialNumber;
+    m_id.file = (static_cast<unsigned long long>(info.nFileIndexHigh) << 32)
+      | info.nFileIndexLow;
+    const unsigned long long size
+      = (static_cast<unsigned long long>(info.nFileSizeHigh) << 32)
+      | info.nFileSizeLow;
+    if (size == 0) {
+      CloseHandle(file);
+      m_open = true;
+      return true;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY,
+                                        0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+      : nullptr;
+    if (mapping)
+      CloseHandle(mapping);
+    CloseHandle(file);
+    if (!view)
+      return read(path);
+    m_data = static_cast<const char*>(view);
+    m_size = static_cast<size_type>(size);
+    m_mapped = true;
+    m_open = true;
+    return true;
+  }
+  void mapped_file::close() noexcept {
+    if (m_mapped)
+      UnmapViewOfFile(m_data);
+    m_data = nullptr;
+    m_size = 0;
+    m_id = id_type{};
+    m_open = false;
+    m_mapped = false;
+    m_buffer.clear();
+  }
+#elif defined(__unix__) || defined(__APPLE__)
+  bool mapped_file::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+      ::close(fd);
+      return false;
+    }
+    m_id.device = static_cast<unsigned long long>(info.st_dev);
+    m_id.file = static_cast<unsigned long long>(info.st_ino);
+    if (!S_ISREG(info.st_mode)) {
+      bool ok = S_ISFIFO(info.st_mode);
+      char chunk[4096];
+      while (ok) {
+        ssize_t count = ::read(fd, chunk, sizeof(chunk));
+        if (count > 0)
+          m_buffer.append(chunk, static_cast<std::size_t>(count));
+        else if (count == 0)
+          break;
+        else if (errno != EINTR)
+          ok = false;
+      }
+      ::close(fd);
+      if (!ok) {
+        close();
+        return false;
+      }
+      m_data = m_buffer.data();
+      m_size = m_buffer.size();
+      m_open = true;
+      return true;
+    }
+    if (info.st_size == 0) {
+      ::close(fd);
+      m_open = true;
+      return true;
+    }
+    const auto size = static_cast<size_type>(info.st_size);
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+      return read(path);
+#ifdef POSIX_MADV_SEQUENTIAL
+    posix_madvise(view, size, POSIX_MADV_SEQUENTIAL);
+#endif
+    m_data = static_cast<const char*>(view);
+    m_size = size;
+    m_mapped = true;
+    m_open = true;
+    return true;
+  }
+  void mapped_file::close() noexcept {
+    if (m_mapped)
+      munmap(const_cast<char*>(m_data), m_size);
+    m_data = nullptr;
+    m_size = 0;
+    m_id = id_type{};
+    m_open = false;
+    m_mapped = false;
+    m_buffer.clear();
+  }
+#else
+  bool mapped_file::open(const std::string& path) {
+    close();
+    m_id.file = std::hash<std::string>{}(path);
+    return read(path);
+  }
+  void mapped_file::close() noexcept {
+    m_data = nullptr;
+    m_size = 0;
+    m_id = id_type{};
+    m_open = false;
+    m_buffer.clear();
+  }
+#endif
+  bool mapped_file::read(const std::string& path) {
+    std::ifstream file{path, std::ios::in | std::ios::binary};
+    if (!file)
+      return false;
+    try {
+      m_buffer.assign(std::istreambuf_iterator<char>{file},
+                      std::istreambuf_iterator<char>{});
+    } catch (const std::ios_base::failure&) {
+      m_buffer.clear();
+      return false;
+    }
+    if (file.bad()) {
+      m_buffer.clear();
+      return false;
+    }
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    m_open = true;
+    return true;
+  }
+}
+
+namespace optionpp {
+  namespace utility {
+    std::string wrap_text(const std::string& str,
+                          int line_len,
+                          int indent) {
+      return wrap_text(str, line_len, indent, indent);
+    }
+    std::string wrap_text(const std::string& str,
+                          int line_len,
+                          int indent,
                           int first_line_indent) {
-      std::vector<std::string> lines;
-      split(str, std::back_inserter(lines), "\n", "", '\0', true);
       std::string result;
-      for (const auto& line : lines) {
-        if (!result.empty())
-          result.push_back('\n');
-        result += wrap_line(line, line_len, indent, first_line_indent);
-        first_line_indent = indent;
+      wrap_text(string_ref{str}, std::back_inserter(result),
+                line_len, indent, first_line_indent);
+      return result;
+    }
+    bool is_substr_at_pos(const std::string& str, const std::string& substr,
+                          typename std::string::size_type pos) noexcept {
+      if (pos + substr.size() > str.size())
+        return false;
+      for (decltype(pos) i{0}; i < substr.size(); ++i) {
+        if (str[pos + i] != substr[i])
+          return false;
+      }
+      return true;
+    }
+  }
+}
+
+namespace optionpp {
+  void* parse_target::object(const void* type) const noexcept {
+    return type == m_type ? m_object : nullptr;
+  }
+}
+
+namespace optionpp {
+  option::option(string_ref long_name, char short_name,
+                 string_ref description,
+                 string_ref arg_name, bool arg_required) :
+    m_short_name{short_name}, m_arg_required{arg_required} {
+    set_text(m_long_name, long_name);
+    set_text(m_desc, description);
+    set_text(m_arg_name, arg_name);
+  }
+  option& option::argument(string_ref name, bool required) {
+    set_text(m_arg_name, name);
+    m_arg_required = required;
+    m_tracker.notify();
+    return *this;
+  }
+  option& option::bind_bool(bool* var) noexcept {
+    m_is_option_set = var;
+    m_flag_target_type = nullptr;
+    if (var)
+      *var = false;
+    m_tracker.notify();
+    return *this;
+  }
+  option& option::bind_string(std::string* var) {
+    return bind(var);
+  }
+  option& option::bind_int(int* var) {
+    return bind(var);
+  }
+  option& option::bind_uint(unsigned int* var) {
+    return bind(var);
+  }
+  option& option::bind_double(double* var) {
+    return bind(var);
+  }
+  void option::set_text(text_pool::span& field, string_ref value) {
+    if (value.empty()) {
+      field = text_pool::span{0, 0};
+      return;
+    }
+    std::shared_ptr<text_pool> pool;
+    if (change_tracker::change_log* log = m_tracker.log())
+      pool = log->pool();
+    else if (m_text && m_text.use_count() == 1) {
+      std::size_t live = m_long_name.size + m_desc.size + m_arg_name.size;
+      if (m_text->size() <= 4 * live + 256)
+        pool = m_text;
+    }
+    if (!pool)
+      pool = std::make_shared<text_pool>();
+    if (pool != m_text)
+      move_text(pool);
+    field = m_text->store(value);
+  }
+  void option::move_text(const std::shared_ptr<text_pool>& pool) {
+    if (pool == m_text)
+      return;
+    text_pool::span new_long_name = pool->store(long_name());
+    text_pool::span new_desc = pool->store(description());
+    text_pool::span new_arg_name = pool->store(argument_name());
+    m_text = pool;
+    m_long_name = new_long_name;
+    m_desc = new_desc;
+    m_arg_name = new_arg_name;
+  }
+  void option::write_bool(bool value) const noexcept {
+    if (m_is_option_set)
+      *m_is_option_set = value;
+  }
+  void option::write_string(const std::string& value) const {
+    if (m_arg_type != string_arg || !m_bound_variable)
+      throw type_error{"option '" + name() + "' does not accept a string argument",
+          "optionpp::option::write_string"};
+    *static_cast<std::string*>(m_bound_variable) = value;
+  }
+  void option::write_int(int value) const {
+    if (m_arg_type != int_arg || !m_bound_variable)
+      throw type_error{"option '" + name() + "' does not accept an int argument",
+          "optionpp::option::write_int"};
+    *static_cast<int*>(m_bound_variable) = value;
+  }
+  void option::write_uint(unsigned int value) const {
+    if (m_arg_type != uint_arg || !m_bound_variable)
+      throw type_error{"option '" + name() + "' does not accept an unsigned int argument",
+          "optionpp::option::write_uint"};
+    *static_cast<unsigned int*>(m_bound_variable) = value;
+  }
+  void option::write_double(double value) const {
+    if (m_arg_type != double_arg || !m_bound_variable)
+      throw type_error{"option '" + name() + "' does not accept a double argument",
+          "optionpp::option::write_double"};
+    *static_cast<double*>(m_bound_variable) = value;
+  }
+}
+
+namespace optionpp {
+  option& option_group::add_option(const std::string& long_name,
+                                   char short_name,
+                                   const std::string& description,
+                                   const std::string& arg_name,
+                                   bool arg_required) {
+    const option* old_data = m_options.data();
+    m_options.emplace_back();
+    option& opt = m_options.back();
+    opt.m_tracker.attach(m_tracker.log());
+    try {
+      opt.set_text(opt.m_long_name, long_name);
+      opt.set_text(opt.m_desc, description);
+      opt.set_text(opt.m_arg_name, arg_name);
+    } catch (...) {
+      m_options.pop_back();
+      track_new_options(old_data, m_options.size());
+      throw;
+    }
+    opt.m_short_name = short_name;
+    opt.m_arg_required = arg_required;
+    track_new_options(old_data, m_options.size() - 1);
+    return opt;
+  }
+  option& option_group::operator[](const std::string long_name) {
+    auto it = find(long_name);
+    if (it == end())
+      return add_option().long_name(long_name);
+    else
+      return *it;
+  }
+  option& option_group::operator[](char short_name) {
+    auto it = find(short_name);
+    if (it == end())
+      return add_option().short_name(short_name);
+    else
+      return *it;
+  }
+  auto option_group::find(const std::string& long_name) -> iterator {
+    return std::find_if(m_options.begin(), m_options.end(),
+                        [&](const option& o) { return o.long_name() == long_name; });
+  }
+  auto option_group::find(const std::string& long_name) const -> const_iterator {
+    return std::find_if(m_options.begin(), m_options.end(),
+                        [&](const option& o) { return o.long_name() == long_name; });
+  }
+  auto option_group::find(char short_name) -> iterator {
+    return std::find_if(m_options.begin(), m_options.end(),
+                        [&](const option& o) { return o.short_name() == short_name; });
+  }
+  auto option_group::find(char short_name) const -> const_iterator {
+    return std::find_if(m_options.begin(), m_options.end(),
+                        [&](const option& o) { return o.short_name() == short_name; });
+  }
+  void option_group::sort() {
+    std::sort(m_options.begin(), m_options.end(),
+              [](const option& a, const option& b) {
+                return a.name() < b.name();
+              });
+  }
+  void option_group::attach(change_tracker::change_log* log) noexcept {
+    m_tracker.attach(log);
+    for (auto& opt : m_options)
+      opt.m_tracker.attach(log);
+  }
+  void option_group::track_new_options(const option* old_data,
+                                       size_type first) noexcept {
+    change_tracker::change_log* log = m_tracker.log();
+    if (!log)
+      return;
+    if (m_options.data() != old_data) {
+      for (auto& opt : m_options)
+        opt.m_tracker.attach(log);
+      m_tracker.notify_moved();
+    } else {
+      for (size_type i = first; i < m_options.size(); ++i) {
+        m_options[i].m_tracker.attach(log);
+        m_tracker.notify_renamed(m_options[i]);
+      }
+    }
+    adopt_text(first);
+  }
+  void option_group::adopt_text(size_type first) noexcept {
+    change_tracker::change_log* log = m_tracker.log();
+    if (!log)
+      return;
+    try {
+      const std::shared_ptr<text_pool>& pool = log->pool();
+      for (size_type i = first; i < m_options.size(); ++i)
+        m_options[i].move_text(pool);
+    } catch (...) {}
+  }
+}
+
+namespace optionpp {
+  const std::uint32_t option_index::npos;
+  void option_index::clear() noexcept {
+    m_options.clear();
+    m_hashes.clear();
+    m_table.clear();
+    m_slots.clear();
+    m_displacements.clear();
+    m_short_names.fill(nullptr);
+    m_short_count = 0;
+    m_sorted_ids.clear();
+    m_names.clear();
+  }
+  void option_index::reserve(size_type count) {
+    m_options.reserve(count);
+    m_hashes.reserve(count);
+    if (2 * count > m_table.size())
+      rehash(count);
+  }
+  void option_index::insert(const option& opt) {
+    char short_name = opt.short_name();
+    if (short_name != '\0') {
+      auto& entry = m_short_names[static_cast<unsigned char>(short_name)];
+      if (!entry) {
+        entry = &opt;
+        ++m_short_count;
       }
-      return result;
     }
-    bool is_substr_at_pos(const std::string& str, const std::string& substr,
-                          typename std::string::size_type pos) noexcept {
-      if (pos + substr.size() > str.size())
+    string_ref long_name = opt.long_name();
+    if (long_name.empty())
+      return;
+    std::uint32_t h = string_pool::hash(long_name.data(), long_name.size());
+    if (2 * (m_options.size() + 1) > m_table.size())
+      rehash(m_options.size() + 1);
+    size_type pos = probe(long_name, h);
+    if (m_table[pos].id != npos)
+      return;
+    m_options.push_back(&opt);
+    try {
+      m_hashes.push_back(h);
+    } catch (...) {
+      m_options.pop_back();
+      throw;
+    }
+    m_table[pos] = slot{h, static_cast<std::uint32_t>(m_options.size() - 1)};
+    m_slots.clear();
+    m_displacements.clear();
+  }
+  void option_index::sort_names() {
+    m_sorted_ids.resize(m_options.size());
+    for (size_type i = 0; i < m_sorted_ids.size(); ++i)
+      m_sorted_ids[i] = static_cast<std::uint32_t>(i);
+    std::sort(m_sorted_ids.begin(), m_sorted_ids.end(),
+              [this](std::uint32_t a, std::uint32_t b) {
+                return m_options[a]->long_name() < m_options[b]->long_name();
+              });
+    m_names.resize(m_sorted_ids.size());
+    for (size_type i = 0; i < m_names.size(); ++i)
+      m_names[i] = m_options[m_sorted_ids[i]];
+  }
+  auto option_index::find_prefix(const char* prefix, size_type length) const
+    -> std::pair<name_iterator, name_iterator> {
+    auto compare = [this, length](std::uint32_t id, const char* str) {
+      string_ref name = m_options[id]->long_name();
+      size_type n = std::min(name.size(), length);
+      int cmp = std::memcmp(name.data(), str, n);
+      return cmp < 0 || (cmp == 0 && n < length);
+    };
+    auto compare_reverse = [this, length](const char* str, std::uint32_t id) {
+      string_ref name = m_options[id]->long_name();
+      size_type n = std::min(name.size(), length);
+      return std::memcmp(str, name.data(), n) < 0;
+    };
+    auto first = std::lower_bound(m_sorted_ids.begin(), m_sorted_ids.end(),
+                                  prefix, compare);
+    auto last = std::upper_bound(first, m_sorted_ids.end(), prefix,
+                                 compare_reverse);
+    return {m_names.begin() + (first - m_sorted_ids.begin()),
+            m_names.begin() + (last - m_sorted_ids.begin())};
+  }
+  const option* option_index::find(const char* long_name,
+                                   size_type length) const noexcept {
+    if (m_options.empty())
+      return nullptr;
+    string_ref name{long_name, length};
+    std::uint32_t h = string_pool::hash(long_name, length);
+    if (is_optimized()) {
+      const slot& s = m_slots[displaced_slot(h, m_displacements[bucket(h)])];
+      if (s.id != npos && s.hash == h && m_options[s.id]->long_name() == name)
+        return m_options[s.id];
+      return nullptr;
+    }
+    std::uint32_t id = m_table[probe(name, h)].id;
+    return id != npos ? m_options[id] : nullptr;
+  }
+  bool option_index::has_renamed(const std::string& long_name) const noexcept {
+    if (m_options.empty())
+      return false;
+    std::uint32_t h = string_pool::hash(long_name.data(), long_name.size());
+    size_type mask = m_table.size() - 1;
+    for (size_type pos = h & mask; m_table[pos].id != npos; pos = (pos + 1) & mask) {
+      if (m_table[pos].hash == h)
+        return true;
+    }
+    return false;
+  }
+  bool option_index::optimize() {
+    if (m_options.empty() || is_optimized())
+      return is_optimized();
+    size_type slot_count = 16;
+    while (slot_count < 2 * m_options.size())
+      slot_count *= 2;
+    size_type bucket_count = 1;
+    while (2 * bucket_count < m_options.size())
+      bucket_count *= 2;
+    m_displacements.assign(bucket_count, 0);
+    std::vector<std::vector<slot>> buckets(bucket_count);
+    for (size_type i = 0; i < m_options.size(); ++i) {
+      std::uint32_t h = m_hashes[i];
+      buckets[bucket(h)].push_back(slot{h, static_cast<std::uint32_t>(i)});
+    }
+    std::vector<size_type> order(bucket_count);
+    for (size_type i = 0; i < bucket_count; ++i)
+      order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_type a, size_type b) {
+                       return buckets[a].size() > buckets[b].size();
+                     });
+    const std::uint32_t max_displacement = 1u << 16;
+    m_slots.assign(slot_count, slot{0, npos});
+    std::vector<size_type> positions;
+    for (size_type b : order) {
+      const auto& entries = buckets[b];
+      if (entries.empty())
+        break;
+      bool placed = false;
+      for (std::uint32_t d = 0; !placed && d < max_displacement; ++d) {
+        positions.clear();
+        placed = true;
+        for (const auto& entry : entries) {
+          size_type pos = displaced_slot(entry.hash, d);
+          if (m_slots[pos].id != npos
+              || std::find(positions.begin(), positions.end(), pos)
+                 != positions.end()) {
+            placed = false;
+            break;
+          }
+          positions.push_back(pos);
+        }
+        if (placed) {
+          for (size_type i = 0; i < entries.size(); ++i)
+            m_slots[positions[i]] = entries[i];
+          m_displacements[b] = d;
+        }
+      }
+      if (!placed) {
+        m_slots.clear();
+        m_displacements.clear();
         return false;
-      for (decltype(pos) i{0}; i < substr.size(); ++i) {
-        if (str[pos + i] != substr[i])
-          return false;
       }
-      return true;
+    }
+    return true;
+  }
+  auto option_index::probe(string_ref name, std::uint32_t h) const noexcept
+    -> size_type {
+    size_type mask = m_table.size() - 1;
+    for (size_type pos = h & mask; ; pos = (pos + 1) & mask) {
+      const slot& s = m_table[pos];
+      if (s.id == npos
+          || (s.hash == h && m_options[s.id]->long_name() == name))
+        return pos;
+    }
+  }
+  void option_index::rehash(size_type count) {
+    size_type slot_count = 16;
+    while (slot_count < 2 * count)
+      slot_count *= 2;
+    m_table.assign(slot_count, slot{0, npos});
+    size_type mask = slot_count - 1;
+    for (size_type i = 0; i < m_options.size(); ++i) {
+      size_type pos = m_hashes[i] & mask;
+      while (m_table[pos].id != npos)
+        pos = (pos + 1) & mask;
+      m_table[pos] = slot{m_hashes[i], static_cast<std::uint32_t>(i)};
     }
   }
+  std::size_t option_index::hash(const char* str, size_type length) noexcept {
+    return string_pool::hash(str, length);
+  }
+  auto option_index::displaced_slot(std::uint32_t h,
+                                    std::uint32_t displacement) const noexcept
+    -> size_type {
+    std::uint32_t x = h ^ (displacement * 0x9e3779b9u);
+    x ^= x >> 16;
+    x *= 0x85ebca6bu;
+    x ^= x >> 13;
+    return x & (m_slots.size() - 1);
+  }
 }
 
 namespace optionpp {
-  option::option(const std::string& long_name, char short_name,
-                 const std::string& description,
-                 const std::string& arg_name, bool arg_required) :
-    m_long_name{long_name}, m_short_name{short_name},
-    m_desc{description}, m_arg_name{arg_name},
-    m_arg_required{arg_required} {}
-  option& option::argument(const std::string& name, bool required) {
-    m_arg_name = name;
-    m_arg_required = required;
+  parser_result& parser_result::operator=(const parser_result& other) {
+    if (this != &other) {
+      clear();
+      for (const auto& entry : other)
+        push_back(entry);
+    }
     return *this;
   }
-  option& option::bind_bool(bool* var) noexcept {
-    m_is_option_set = var;
-    if (var)
-      *var = false;
+  parser_result& parser_result::operator=(parser_result&& other) noexcept {
+    if (this != &other) {
+      m_entries = std::move(other.m_entries);
+      m_size = other.m_size;
+      m_index = std::move(other.m_index);
+      m_pending.store(other.m_pending.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+      other.m_entries.clear();
+      other.m_size = 0;
+      other.m_index.clear();
+      other.m_pending.store(false, std::memory_order_relaxed);
+    }
     return *this;
   }
-  option& option::bind_string(std::string* var) noexcept {
-    if (var && m_arg_name.empty()) {
-      m_arg_name = "STRING";
-      m_arg_required = true;
+  const parser_result::size_type parser_result::npos;
+  void parser_result::clear() noexcept {
+    m_size = 0;
+    m_index.clear();
+    m_pending.store(false, std::memory_order_relaxed);
+  }
+  void parser_result::index_data::clear() noexcept {
+    records.clear();
+    std::fill(by_option.begin(), by_option.end(), npos);
+    if (name_count != 0) {
+      std::fill(by_name.begin(), by_name.end(), name_slot{0, npos, npos, '\0'});
+      name_count = 0;
     }
-    m_arg_type = string_arg;
-    m_bound_variable = var;
-    return *this;
+    named_records = 0;
+    stale = false;
+  }
+  auto parser_result::current_index() const -> const index_data& {
+    if (m_pending.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock{m_index_mutex};
+      if (m_pending.load(std::memory_order_relaxed)) {
+        if (m_index.stale)
+          rebuild_index();
+        name_records();
+        m_pending.store(false, std::memory_order_release);
+      }
+    }
+    return m_index;
   }
-  option& option::bind_int(int* var) noexcept {
-    if (var && m_arg_name.empty()) {
-      m_arg_name = "INTEGER";
-      m_arg_required = true;
+  void parser_result::name_records() const {
+    for (auto& r = m_index.named_records; r != m_index.records.size(); ++r) {
+      const auto& entry = m_entries[m_index.records[r].first];
+      if (!entry.long_name.empty())
+        insert_name(option_index::hash(entry.long_name.data(), entry.long_name.size()),
+                    m_index.records[r].first, '\0', r);
+      if (entry.short_name != '\0')
+        insert_name(option_index::hash(&entry.short_name, 1),
+                    m_index.records[r].first, entry.short_name, r);
     }
-    m_arg_type = int_arg;
-    m_bound_variable = var;
-    return *this;
   }
-  option& option::bind_uint(unsigned int* var) noexcept {
-    if (var && m_arg_name.empty()) {
-      m_arg_name = "INTEGER";
-      m_arg_required = true;
+  void parser_result::rebuild_index() const {
+    m_index.clear();
+    for (size_type i = 0; i < m_size; ++i)
+      index_entry(i);
+  }
+  void parser_result::index_entry(size_type index) const {
+    auto& links = m_index.links;
+    if (links.size() <= index)
+      links.resize(index + 1);
+    links[index] = npos;
+    const auto& entry = m_entries[index];
+    if (!entry.is_option)
+      return;
+    size_type record = npos;
+    if (entry.opt_info) {
+      size_type pos = probe_option(entry.opt_info);
+      if (pos != npos)
+        record = m_index.by_option[pos];
+    } else {
+      name_records();
+      if (!entry.long_name.empty()) {
+        size_type pos = probe_name(option_index::hash(entry.long_name.data(),
+                                                      entry.long_name.size()),
+                                   &entry.long_name, '\0');
+        if (pos != npos)
+          record = m_index.by_name[pos].record;
+      }
+      if (record == npos && entry.short_name != '\0') {
+        size_type pos = probe_name(option_index::hash(&entry.short_name, 1),
+                                   nullptr, entry.short_name);
+        if (pos != npos)
+          record = m_index.by_name[pos].record;
+      }
+    }
+    if (record == npos) {
+      record = m_index.records.size();
+      m_index.records.push_back(option_record{entry.opt_info, index, index, 1});
+      if (entry.opt_info) {
+        insert_option(record);
+        m_pending.store(true, std::memory_order_relaxed);
+      }
+    } else {
+      option_record& r = m_index.records[record];
+      links[r.last] = index;
+      r.last = index;
+      ++r.count;
+    }
+    if (entry.opt_info)
+      return;
+    m_index.named_records = m_index.records.size();
+    if (!entry.long_name.empty())
+      insert_name(option_index::hash(entry.long_name.data(), entry.long_name.size()),
+                  index, '\0', record);
+    if (entry.short_name != '\0')
+      insert_name(option_index::hash(&entry.short_name, 1),
+                  index, entry.short_name, record);
+  }
+  auto parser_result::probe_name(std::size_t hash, const std::string* long_name,
+                                 char short_name) const noexcept -> size_type {
+    const auto& table = m_index.by_name;
+    if (table.empty())
+      return npos;
+    size_type mask = table.size() - 1;
+    for (size_type i = hash & mask; ; i = (i + 1) & mask) {
+      const name_slot& s = table[i];
+      if (s.record == npos)
+        return i;
+      if (s.hash == hash && s.short_name == short_name
+          && (short_name != '\0' || m_entries[s.entry].long_name == *long_name))
+        return i;
     }
-    m_arg_type = uint_arg;
-    m_bound_variable = var;
-    return *this;
   }
-  option& option::bind_double(double* var) noexcept {
-    if (var && m_arg_name.empty()) {
-      m_arg_name = "NUMBER";
-      m_arg_required = true;
+  void parser_result::insert_name(std::size_t hash, size_type index,
+                                  char short_name, size_type record) const {
+    auto& table = m_index.by_name;
+    if (2 * (m_index.name_count + 1) > table.size()) {
+      std::vector<name_slot> old(table.empty() ? 16 : 2 * table.size(),
+                                 name_slot{0, npos, npos, '\0'});
+      old.swap(table);
+      size_type mask = table.size() - 1;
+      for (const auto& s : old) {
+        if (s.record == npos)
+          continue;
+        size_type i = s.hash & mask;
+        while (table[i].record != npos)
+          i = (i + 1) & mask;
+        table[i] = s;
+      }
+    }
+    name_slot& s = table[probe_name(hash, &m_entries[index].long_name, short_name)];
+    if (s.record == npos) {
+      s = name_slot{hash, record, index, short_name};
+      ++m_index.name_count;
+    }
+  }
+  auto parser_result::probe_option(const option* opt) const noexcept -> size_type {
+    const auto& table = m_index.by_option;
+    if (table.empty())
+      return npos;
+    auto key = reinterpret_cast<std::uintptr_t>(opt) / sizeof(option);
+    size_type mask = table.size() - 1;
+    for (size_type i = static_cast<size_type>(key * 0x9e3779b97f4a7c15ull) & mask;
+         ; i = (i + 1) & mask) {
+      if (table[i] == npos || m_index.records[table[i]].opt_info == opt)
+        return i;
+    }
+  }
+  void parser_result::insert_option(size_type record) const {
+    auto& table = m_index.by_option;
+    if (2 * m_index.records.size() > table.size()) {
+      table.assign(table.empty() ? 16 : 2 * table.size(), npos);
+      for (size_type r = 0; r != m_index.records.size(); ++r) {
+        if (m_index.records[r].opt_info)
+          table[probe_option(m_index.records[r].opt_info)] = r;
+      }
+    } else {
+      table[probe_option(m_index.records[record].opt_info)] = record;
+    }
+  }
+  auto parser_result::find_record(const std::string& long_name) const
+    -> const option_record* {
+    const index_data& index = current_index();
+    if (long_name.empty())
+      return nullptr;
+    size_type pos = probe_name(option_index::hash(long_name.data(), long_name.size()),
+                               &long_name, '\0');
+    return pos != npos && index.by_name[pos].record != npos
+      ? &index.records[index.by_name[pos].record] : nullptr;
+  }
+  auto parser_result::find_record(char short_name) const -> const option_record* {
+    const index_data& index = current_index();
+    if (short_name == '\0')
+      return nullptr;
+    size_type pos = probe_name(option_index::hash(&short_name, 1), nullptr, short_name);
+    return pos != npos && index.by_name[pos].record != npos
+      ? &index.records[index.by_name[pos].record] : nullptr;
+  }
+  auto parser_result::find_record(const option& opt) const -> const option_record* {
+    const index_data& index = current_index();
+    size_type pos = probe_option(&opt);
+    return pos != npos && index.by_option[pos] != npos
+      ? &index.records[index.by_option[pos]] : nullptr;
+  }
+  const std::string& parser_result::last_argument(const option_record* r) const noexcept {
+    static const std::string empty;
+    return r ? m_entries[r->last].argument : empty;
+  }
+}
+
+namespace optionpp {
+  parsed_entry parsed_entry_ref::to_entry() const {
+    parsed_entry entry{original_text.str(), is_option, long_name.str(),
+        short_name, argument.str()};
+    entry.original_without_argument = original_without_argument.str();
+    entry.opt_info = opt_info;
+    return entry;
+  }
+  bool parser_result_ref::is_option_set(string_ref long_name) const noexcept {
+    if (long_name.empty())
+      return false;
+    else
+      return std::any_of(begin(), end(),
+                         [&](const parsed_entry_ref& i) {
+                           return i.is_option && i.long_name == long_name;
+                         });
+  }
+  bool parser_result_ref::is_option_set(char short_name) const noexcept {
+    if (short_name == '\0')
+      return false;
+    else
+      return std::any_of(begin(), end(),
+                         [&](const parsed_entry_ref& i) {
+                           return i.is_option && i.short_name == short_name;
+                         });
+  }
+  string_ref parser_result_ref::get_argument(string_ref long_name) const noexcept {
+    if (long_name.empty())
+      return string_ref{};
+    auto it = std::find_if(m_entries.rbegin(), m_entries.rend(),
+                           [&](const parsed_entry_ref& i) {
+                             return i.is_option && i.long_name == long_name;
+                           });
+    if (it != m_entries.rend())
+      return it->argument;
+    else
+      return string_ref{};
+  }
+  string_ref parser_result_ref::get_argument(char short_name) const noexcept {
+    if (short_name == '\0')
+      return string_ref{};
+    auto it = std::find_if(m_entries.rbegin(), m_entries.rend(),
+                           [=](const parsed_entry_ref& i) {
+                             return i.is_option && i.short_name == short_name;
+                           });
+    if (it != m_entries.rend())
+      return it->argument;
+    else
+      return string_ref{};
+  }
+  parser_result parser_result_ref::to_result() const {
+    parser_result result;
+    for (const auto& entry : m_entries)
+      result.push_back(entry.to_entry());
+    return result;
+  }
+}
+
+namespace optionpp {
+  batch_result::batch_result(batch_result&& other) noexcept
+    : m_line_begin{std::move(other.m_line_begin)},
+      m_current_begin{other.m_current_begin},
+      m_error{std::move(other.m_error)},
+      m_error_token{std::move(other.m_error_token)},
+      m_error_offset{std::move(other.m_error_offset)},
+      m_error_option{std::move(other.m_error_option)},
+      m_error_count{other.m_error_count},
+      m_original_text{std::move(other.m_original_text)},
+      m_original_without_argument{std::move(other.m_original_without_argument)},
+      m_is_option{std::move(other.m_is_option)},
+      m_long_name{std::move(other.m_long_name)},
+      m_short_name{std::move(other.m_short_name)},
+      m_argument{std::move(other.m_argument)},
+      m_opt_info{std::move(other.m_opt_info)},
+      m_text{std::move(other.m_text)} {
+    other.clear();
+  }
+  batch_result& batch_result::operator=(batch_result&& other) noexcept {
+    if (this != &other) {
+      m_line_begin = std::move(other.m_line_begin);
+      m_current_begin = other.m_current_begin;
+      m_error = std::move(other.m_error);
+      m_error_token = std::move(other.m_error_token);
+      m_error_offset = std::move(other.m_error_offset);
+      m_error_option = std::move(other.m_error_option);
+      m_error_count = other.m_error_count;
+      m_original_text = std::move(other.m_original_text);
+      m_original_without_argument = std::move(other.m_original_without_argument);
+      m_is_option = std::move(other.m_is_option);
+      m_long_name = std::move(other.m_long_name);
+      m_short_name = std::move(other.m_short_name);
+      m_argument = std::move(other.m_argument);
+      m_opt_info = std::move(other.m_opt_info);
+      m_text = std::move(other.m_text);
+      other.clear();
     }
-    m_arg_type = double_arg;
-    m_bound_variable = var;
     return *this;
   }
-  void option::write_bool(bool value) const noexcept {
-    if (m_is_option_set)
-      *m_is_option_set = value;
+  void batch_result::clear() noexcept {
+    m_line_begin.clear();
+    m_current_begin = 0;
+    m_error.clear();
+    m_error_token.clear();
+    m_error_offset.clear();
+    m_error_option.clear();
+    m_error_count = 0;
+    m_original_text.clear();
+    m_original_without_argument.clear();
+    m_is_option.clear();
+    m_long_name.clear();
+    m_short_name.clear();
+    m_argument.clear();
+    m_opt_info.clear();
+    if (m_text.size() > 1)
+      m_text.erase(m_text.begin() + 1, m_text.end());
+    if (!m_text.empty())
+      m_text.front().clear();
   }
-  void option::write_string(const std::string& value) const {
-    if (m_arg_type != string_arg || !m_bound_variable)
-      throw type_error{"option '" + name() + "' does not accept a string argument",
-          "optionpp::option::write_string"};
-    *static_cast<std::string*>(m_bound_variable) = value;
+  parsed_entry_ref batch_result::entry(size_type index) const {
+    if (index >= entry_count())
+      throw out_of_range("out of bounds batch_result access",
+                         "optionpp::batch_result::entry");
+    parsed_entry_ref entry;
+    entry.original_text = m_original_text[index];
+    entry.original_without_argument = m_original_without_argument[index];
+    entry.is_option = m_is_option[index] != 0;
+    entry.long_name = m_long_name[index];
+    entry.short_name = m_short_name[index];
+    entry.argument = m_argument[index];
+    entry.opt_info = m_opt_info[index];
+    return entry;
   }
-  void option::write_int(int value) const {
-    if (m_arg_type != int_arg || !m_bound_variable)
-      throw type_error{"option '" + name() + "' does not accept an int argument",
-          "optionpp::option::write_int"};
-    *static_cast<int*>(m_bound_variable) = value;
+  parser_result batch_result::line_result(size_type line) const {
+    if (line >= line_count())
+      throw out_of_range("out of bounds batch_result access",
+                         "optionpp::batch_result::line_result");
+    parser_result result;
+    result.reserve(entry_count(line));
+    for (size_type i = first_entry(line); i != first_entry(line + 1); ++i)
+      result.push_back(entry(i).to_entry());
+    return result;
   }
-  void option::write_uint(unsigned int value) const {
-    if (m_arg_type != uint_arg || !m_bound_variable)
-      throw type_error{"option '" + name() + "' does not accept an unsigned int argument",
-          "optionpp::option::write_uint"};
-    *static_cast<unsigned int*>(m_bound_variable) = value;
+  void batch_result::push_back(const parsed_entry_ref& entry) {
+    m_original_text.push_back(entry.original_text);
+    m_original_without_argument.push_back(entry.original_without_argument);
+    m_is_option.push_back(entry.is_option ? 1 : 0);
+    m_long_name.push_back(entry.long_name);
+    m_short_name.push_back(entry.short_name);
+    m_argument.push_back(entry.argument);
+    m_opt_info.push_back(entry.opt_info);
   }
-  void option::write_double(double value) const {
-    if (m_arg_type != double_arg || !m_bound_variable)
-      throw type_error{"option '" + name() + "' does not accept a double argument",
-          "optionpp::option::write_double"};
-    *static_cast<double*>(m_bound_variable) = value;
+  void batch_result::end_line() {
+    m_line_begin.push_back(m_current_begin);
+    m_error.push_back(parse_errc::none);
+    m_error_token.push_back(0);
+    m_error_offset.push_back(0);
+    m_error_option.push_back(string_ref{});
+    m_current_begin = entry_count();
+  }
+  void batch_result::fail_line(const parse_status& status) {
+    m_original_text.resize(m_current_begin);
+    m_original_without_argument.resize(m_current_begin);
+    m_is_option.resize(m_current_begin);
+    m_long_name.resize(m_current_begin);
+    m_short_name.resize(m_current_begin);
+    m_argument.resize(m_current_begin);
+    m_opt_info.resize(m_current_begin);
+    m_line_begin.push_back(m_current_begin);
+    m_error.push_back(status.error());
+    m_error_token.push_back(status.token_index());
+    m_error_offset.push_back(status.offset());
+    m_error_option.push_back(store(status.option()));
+    ++m_error_count;
+  }
+  string_ref batch_result::store(string_ref a, string_ref b, string_ref c) {
+    if (m_text.empty())
+      m_text.emplace_back();
+    return m_text.back().store(a, b, c);
+  }
+  void batch_result::append(batch_result&& other) {
+    size_type offset = entry_count();
+    for (size_type begin : other.m_line_begin)
+      m_line_begin.push_back(begin + offset);
+    m_error.insert(m_error.end(), other.m_error.begin(), other.m_error.end());
+    m_error_token.insert(m_error_token.end(),
+                         other.m_error_token.begin(), other.m_error_token.end());
+    m_error_offset.insert(m_error_offset.end(),
+                          other.m_error_offset.begin(), other.m_error_offset.end());
+    m_error_option.insert(m_error_option.end(),
+                          other.m_error_option.begin(), other.m_error_option.end());
+    m_error_count += other.m_error_count;
+    m_original_text.insert(m_original_text.end(),
+                           other.m_original_text.begin(), other.m_original_text.end());
+    m_original_without_argument.insert(m_original_without_argument.end(),
+                                       other.m_original_without_argument.begin(),
+                                       other.m_original_without_argument.end());
+    m_is_option.insert(m_is_option.end(),
+                       other.m_is_option.begin(), other.m_is_option.end());
+    m_long_name.insert(m_long_name.end(),
+                       other.m_long_name.begin(), other.m_long_name.end());
+    m_short_name.insert(m_short_name.end(),
+                        other.m_short_name.begin(), other.m_short_name.end());
+    m_argument.insert(m_argument.end(),
+                      other.m_argument.begin(), other.m_argument.end());
+    m_opt_info.insert(m_opt_info.end(),
+                      other.m_opt_info.begin(), other.m_opt_info.end());
+    m_current_begin = entry_count();
+    for (auto& arena : other.m_text)
+      m_text.insert(m_text.end() - (m_text.empty() ? 0 : 1), std::move(arena));
+    other.clear();
   }
 }
 
+
 namespace optionpp {
-  option& option_group::add_option(const std::string& long_name,
-                                   char short_name,
-                                   const std::string& description,
-                                   const std::string& arg_name,
-                                   bool arg_required) {
-    m_options.emplace_back(long_name, short_name, description,
-                           arg_name, arg_required);
-    return m_options.back();
+  compiled_parser::compiled_parser(const parser& source) {
+    size_type count = 0;
+    for (const auto& group : source.m_groups)
+      count += group.size();
+    m_options.reserve(count);
+    for (const auto& group : source.m_groups)
+      m_options.insert(m_options.end(), group.begin(), group.end());
+    copy_strings(source);
+    reindex();
+    if (source.m_suggestions_enabled) {
+      auto suggestions = std::make_shared<suggestion_index>();
+      for (const auto& opt : m_options)
+        suggestions->insert(opt.long_name());
+      m_suggestions = std::move(suggestions);
+    }
   }
-  option& option_group::operator[](const std::string long_name) {
-    auto it = find(long_name);
-    if (it == end())
-      return add_option().long_name(long_name);
+  compiled_parser::compiled_parser(const parser& source, borrow_tag) {
+    size_type count = 0;
+    for (const auto& group : source.m_groups)
+      count += group.size();
+    m_index.reserve(count);
+    for (const auto& group : source.m_groups) {
+      for (const auto& opt : group)
+        m_index.insert(opt);
+    }
+    copy_strings(source);
+    if (m_allow_abbreviations)
+      m_index.sort_names();
+    if (source.m_suggestions_enabled) {
+      auto suggestions = std::make_shared<suggestion_index>();
+      for (const auto& group : source.m_groups) {
+        for (const auto& opt : group)
+          suggestions->insert(opt.long_name());
+      }
+      m_suggestions = std::move(suggestions);
+    }
+  }
+  compiled_parser::compiled_parser(const compiled_parser& other)
+    : m_options{other.m_options},
+      m_delims{other.m_delims},
+      m_short_option_prefix{other.m_short_option_prefix},
+      m_long_option_prefix{other.m_long_option_prefix},
+      m_end_of_options{other.m_end_of_options},
+      m_equals{other.m_equals},
+      m_response_file_prefix{other.m_response_file_prefix},
+      m_allow_abbreviations{other.m_allow_abbreviations},
+      m_suggestions{other.m_suggestions},
+      m_tokenizer{other.m_tokenizer} {
+    if (m_options.empty())
+      m_index = other.m_index;
     else
-      return *it;
+      reindex();
   }
-  option& option_group::operator[](char short_name) {
-    auto it = find(short_name);
-    if (it == end())
-      return add_option().short_name(short_name);
+  compiled_parser::compiled_parser(compiled_parser&& other) noexcept
+    : m_options{std::move(other.m_options)},
+      m_index{std::move(other.m_index)},
+      m_delims{std::move(other.m_delims)},
+      m_short_option_prefix{std::move(other.m_short_option_prefix)},
+      m_long_option_prefix{std::move(other.m_long_option_prefix)},
+      m_end_of_options{std::move(other.m_end_of_options)},
+      m_equals{std::move(other.m_equals)},
+      m_response_file_prefix{std::move(other.m_response_file_prefix)},
+      m_allow_abbreviations{other.m_allow_abbreviations},
+      m_suggestions{std::move(other.m_suggestions)},
+      m_tokenizer{std::move(other.m_tokenizer)} {
+    other.m_options.clear();
+    other.m_index.clear();
+  }
+  compiled_parser& compiled_parser::operator=(const compiled_parser& other) {
+    if (this != &other) {
+      compiled_parser copy{other};
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+  compiled_parser& compiled_parser::operator=(compiled_parser&& other) noexcept {
+    if (this != &other) {
+      m_options = std::move(other.m_options);
+      m_index = std::move(other.m_index);
+      m_delims = std::move(other.m_delims);
+      m_short_option_prefix = std::move(other.m_short_option_prefix);
+      m_long_option_prefix = std::move(other.m_long_option_prefix);
+      m_end_of_options = std::move(other.m_end_of_options);
+      m_equals = std::move(other.m_equals);
+      m_response_file_prefix = std::move(other.m_response_file_prefix);
+      m_allow_abbreviations = other.m_allow_abbreviations;
+      m_suggestions = std::move(other.m_suggestions);
+      m_tokenizer = std::move(other.m_tokenizer);
+      other.m_options.clear();
+      other.m_index.clear();
+    }
+    return *this;
+  }
+  parser_result compiled_parser::parse(int argc, char* argv[],
+                                       bool ignore_first) const {
+    return parse(argv, argv + argc, ignore_first);
+  }
+  parser_result compiled_parser::parse(const std::string& cmd_line,
+                                       bool ignore_first) const {
+    parser_result result{};
+    parse_into(result, cmd_line, ignore_first);
+    return result;
+  }
+  void compiled_parser::parse_into(parser_result& result, int argc,
+                                   char* argv[], bool ignore_first) const {
+    parse_into(result, argv, argv + argc, ignore_first);
+  }
+  void compiled_parser::parse_into(parser_result& result,
+                                   const std::string& cmd_line,
+                                   bool ignore_first) const {
+    parse_status status;
+    parse_into(result, cmd_line, status, ignore_first);
+    if (!status)
+      throw status.to_error();
+  }
+  void compiled_parser::parse_into(parser_result& result, int argc,
+                                   char* argv[], parse_status& status,
+                                   bool ignore_first) const {
+    parse_into(result, argv, argv + argc, status, ignore_first);
+  }
+  void compiled_parser::parse_into(parser_result& result,
+                                   const std::string& cmd_line,
+                                   parse_status& status,
+                                   bool ignore_first) const {
+    result.clear();
+    status.clear();
+    result_sink sink{result};
+    parse_state state{status};
+    std::string buffer;
+    parse_string(cmd_line, ignore_first, buffer, state, sink);
+  }
+  void compiled_parser::parse_into(parser_result& result, int argc,
+                                   char* argv[], const parse_target& target,
+                                   parse_status& status,
+                                   bool ignore_first) const {
+    parse_into(result, argv, argv + argc, target, status, ignore_first);
+  }
+  void compiled_parser::parse_into(parser_result& result,
+                                   const std::string& cmd_line,
+                                   const parse_target& target,
+                                   parse_status& status,
+                                   bool ignore_first) const {
+    result.clear();
+    status.clear();
+    result_sink sink{result};
+    parse_state state{status};
+    state.target = &target;
+    std::string buffer;
+    parse_string(cmd_line, ignore_first, buffer, state, sink);
+  }
+  parser_result_ref compiled_parser::parse_ref(int argc, char* argv[],
+                                               bool ignore_first) const {
+    return parse_ref(argv, argv + argc, ignore_first);
+  }
+  parser_result_ref compiled_parser::parse_ref(const std::string& cmd_line,
+                                               bool ignore_first) const {
+    parser_result_ref result{};
+    result_ref_sink sink{result};
+    parse_status status;
+    parse_state state{status};
+    std::string buffer;
+    if (!parse_string(cmd_line, ignore_first, buffer, state, sink))
+      throw status.to_error();
+    return result;
+  }
+  bool compiled_parser::visit(int argc, char* argv[],
+                              const option_handler& on_option,
+                              const non_option_handler& on_non_option,
+                              parse_status& status, bool ignore_first) const {
+    return visit(argv, argv + argc, on_option, on_non_option, status,
+                 ignore_first);
+  }
+  bool compiled_parser::visit(const std::string& cmd_line,
+                              const option_handler& on_option,
+                              const non_option_handler& on_non_option,
+                              parse_status& status, bool ignore_first) const {
+    status.clear();
+    parse_state state{status};
+    visit_sink sink{on_option, on_non_option, state};
+    std::string buffer;
+    if (!parse_string(cmd_line, ignore_first, buffer, state, sink))
+      return false;
+    sink.flush();
+    return !state.stopped;
+  }
+  void compiled_parser::copy_strings(const parser& source) {
+    m_delims = source.m_delims;
+    m_short_option_prefix = source.m_short_option_prefix;
+    m_long_option_prefix = source.m_long_option_prefix;
+    m_end_of_options = source.m_end_of_options;
+    m_equals = source.m_equals;
+    m_response_file_prefix = source.m_response_file_prefix;
+    m_allow_abbreviations = source.m_allow_abbreviations;
+    m_tokenizer = tokenizer{m_delims};
+  }
+  void compiled_parser::reindex() {
+    m_index.clear();
+    m_index.reserve(m_options.size());
+    for (const auto& opt : m_options)
+      m_index.insert(opt);
+    m_index.optimize();
+    if (m_allow_abbreviations)
+      m_index.sort_names();
+  }
+  void compiled_parser::result_sink::add(const parsed_entry_ref& entry, bool) {
+    auto& dest = m_result.next_entry();
+    dest.original_text.assign(entry.original_text.data(),
+                              entry.original_text.size());
+    dest.original_without_argument.assign(entry.original_without_argument.data(),
+                                          entry.original_without_argument.size());
+    dest.is_option = entry.is_option;
+    dest.long_name.assign(entry.long_name.data(), entry.long_name.size());
+    dest.short_name = entry.short_name;
+    dest.argument.assign(entry.argument.data(), entry.argument.size());
+    dest.opt_info = entry.opt_info;
+    m_result.index_entry(m_result.size() - 1);
+  }
+  void compiled_parser::result_sink::add_argument(string_ref argument) {
+    auto& entry = m_result.m_entries[m_result.m_size - 1];
+    entry.argument.assign(argument.data(), argument.size());
+    entry.original_text.push_back(' ');
+    entry.original_text.append(argument.data(), argument.size());
+  }
+  void compiled_parser::result_ref_sink::add(const parsed_entry_ref& entry,
+                                             bool transient_text) {
+    if (!transient_text) {
+      m_result.push_back(entry);
+      return;
+    }
+    parsed_entry_ref copy = entry;
+    copy.original_text = m_result.store(entry.original_text);
+    copy.original_without_argument
+      = copy.original_text.substr(0, entry.original_without_argument.size());
+    m_result.push_back(copy);
+  }
+  void compiled_parser::result_ref_sink::add_argument(string_ref argument) {
+    auto& entry = m_result.back();
+    entry.argument = argument;
+    entry.original_text = m_result.store(entry.original_text, " ", argument);
+  }
+  void compiled_parser::batch_sink::add(const parsed_entry_ref& entry,
+                                       bool transient_text) {
+    if (!transient_text) {
+      m_result.push_back(entry);
+      return;
+    }
+    parsed_entry_ref copy = entry;
+    copy.original_text = m_result.store(entry.original_text);
+    copy.original_without_argument
+      = copy.original_text.substr(0, entry.original_without_argument.size());
+    m_result.push_back(copy);
+  }
+  void compiled_parser::batch_sink::add_argument(string_ref argument) {
+    m_result.add_argument(argument);
+  }
+  void compiled_parser::slice_sink::add(const parsed_entry_ref& entry, bool) {
+    auto& dest = m_entries[m_position++];
+    dest.original_text.assign(entry.original_text.data(),
+                              entry.original_text.size());
+    dest.original_without_argument.assign(entry.original_without_argument.data(),
+                                          entry.original_without_argument.size());
+    dest.is_option = entry.is_option;
+    dest.long_name.assign(entry.long_name.data(), entry.long_name.size());
+    dest.short_name = entry.short_name;
+    dest.argument.assign(entry.argument.data(), entry.argument.size());
+    dest.opt_info = entry.opt_info;
+  }
+  void compiled_parser::slice_sink::add_argument(string_ref argument) {
+    auto& entry = m_entries[m_position - 1];
+    entry.argument.assign(argument.data(), argument.size());
+    entry.original_text.push_back(' ');
+    entry.original_text.append(argument.data(), argument.size());
+  }
+  void compiled_parser::visit_sink::add(const parsed_entry_ref& entry, bool) {
+    flush();
+    if (!entry.is_option) {
+      if (!m_state.stopped && m_on_non_option
+          && !m_on_non_option(entry.original_text))
+        m_state.stopped = true;
+      return;
+    }
+    const option& opt = *entry.opt_info;
+    if (!opt.argument_name().empty()
+        && entry.original_text.size() == entry.original_without_argument.size())
+      m_held = &opt;
     else
-      return *it;
+      visit_option(opt, entry.argument);
   }
-  auto option_group::find(const std::string& long_name) -> iterator {
-    return std::find_if(m_options.begin(), m_options.end(),
-                        [&](const option& o) { return o.long_name() == long_name; });
+  void compiled_parser::visit_sink::add_argument(string_ref argument) {
+    const option* opt = m_held;
+    m_held = nullptr;
+    if (opt)
+      visit_option(*opt, argument);
   }
-  auto option_group::find(const std::string& long_name) const -> const_iterator {
-    return std::find_if(m_options.begin(), m_options.end(),
-                        [&](const option& o) { return o.long_name() == long_name; });
+  void compiled_parser::visit_sink::flush() {
+    const option* opt = m_held;
+    m_held = nullptr;
+    if (opt)
+      visit_option(*opt, string_ref{});
+  }
+  void compiled_parser::visit_sink::visit_option(const option& opt,
+                                                 string_ref argument) {
+    if (!m_state.stopped && m_on_option && !m_on_option(opt, argument))
+      m_state.stopped = true;
+  }
+  void compiled_parser::parse_line(string_ref line, bool ignore_first,
+                                   parse_state& state, std::string& buffer,
+                                   batch_result& result) const {
+    batch_sink sink{result};
+    state.type = cl_arg_type::non_option;
+    state.pending = nullptr;
+    state.index = 0;
+    if (parse_string(line, ignore_first, buffer, state, sink))
+      result.end_line();
+    else
+      result.fail_line(state.status);
+  }
+  batch_result compiled_parser::parse_lines(const std::vector<string_ref>& lines,
+                                            const executor_type& executor,
+                                            size_type lines_per_task,
+                                            bool ignore_first) const {
+    if (lines_per_task == 0)
+      lines_per_task = 1;
+    const size_type task_count = (lines.size() + lines_per_task - 1) / lines_per_task;
+    std::vector<batch_result> parts(task_count);
+    auto run_task = [&](size_type task) {
+      parse_status status;
+      parse_state state{status};
+      state.write_bound = false;
+      std::string buffer;
+      size_type end = std::min(lines.size(), (task + 1) * lines_per_task);
+      for (size_type i = task * lines_per_task; i != end; ++i)
+        parse_line(lines[i], ignore_first, state, buffer, parts[task]);
+    };
+    run_tasks(task_count, run_task, executor);
+    batch_result result{};
+    for (auto& part : parts)
+      result.append(std::move(part));
+    return result;
+  }
+  void compiled_parser::run_tasks(size_type task_count,
+                                  const std::function<void(size_type)>& run_task,
+                                  const executor_type& executor) {
+    if (!executor || task_count <= 1) {
+      for (size_type task = 0; task != task_count; ++task)
+        run_task(task);
+    } else {
+      std::mutex mutex;
+      std::condition_variable finished;
+      size_type remaining = task_count;
+      std::exception_ptr error;
+      size_type submitted = 0;
+      try {
+        for (; submitted != task_count; ++submitted) {
+          executor([&, submitted] {
+              try {
+                run_task(submitted);
+              } catch (...) {
+                std::lock_guard<std::mutex> lock{mutex};
+                if (!error)
+                  error = std::current_exception();
+              }
+              std::lock_guard<std::mutex> lock{mutex};
+              if (--remaining == 0)
+                finished.notify_all();
+            });
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock{mutex};
+        remaining -= task_count - submitted;
+        if (!error)
+          error = std::current_exception();
+      }
+      std::unique_lock<std::mutex> lock{mutex};
+      finished.wait(lock, [&] { return remaining == 0; });
+      if (error)
+        std::rethrow_exception(error);
+    }
+  }
+  void compiled_parser::parse_args(const std::vector<string_ref>& args,
+                                   const executor_type& executor,
+                                   size_type args_per_task,
+                                   bool ignore_first, parser_result& result,
+                                   parse_status& status) const {
+    const size_type begin = ignore_first && !args.empty() ? 1 : 0;
+    if (args_per_task == 0)
+      args_per_task = 1;
+    const size_type task_count = (args.size() - begin + args_per_task - 1) / args_per_task;
+    if (!executor || task_count <= 1) {
+      parse_into(result, args.begin(), args.end(), status, ignore_first);
+      return;
+    }
+    const size_type max_rejoin = 8;
+    auto settled = [](cl_arg_type type) {
+      return type == cl_arg_type::non_option || type == cl_arg_type::no_arg;
+    };
+    struct chunk {
+      size_type first;
+      size_type last;
+      size_type count;
+      bool failed;
+      std::vector<std::pair<size_type, size_type>> settled_at;
+      cl_arg_type type;
+      const option* pending;
+      std::string pending_name;
+      size_type pending_index;
+      size_type pending_offset;
+    };
+    std::vector<chunk> chunks(task_count);
+    run_tasks(task_count, [&](size_type task) {
+        chunk& c = chunks[task];
+        c.first = begin + task * args_per_task;
+        c.last = std::min(args.size(), c.first + args_per_task);
+        c.failed = false;
+        c.settled_at.emplace_back(c.first, 0);
+        parse_status spec_status;
+        parse_state state{spec_status};
+        state.write_bound = false;
+        state.index = c.first;
+        count_sink sink;
+        for (size_type i = c.first; i != c.last; ++i) {
+          if (!parse_token(args[i], state, sink)) {
+            c.failed = true;
+            break;
+          }
+          if (i - c.first < max_rejoin && settled(state.type))
+            c.settled_at.emplace_back(i + 1, sink.count());
+        }
+        c.count = sink.count();
+        c.type = state.type;
+        c.pending = state.pending;
+        c.pending_name = std::move(state.pending_name);
+        c.pending_index = state.pending_index;
+        c.pending_offset = state.pending_offset;
+      }, executor);
+    struct segment {
+      size_type first;
+      size_type last;
+      size_type offset;
+    };
+    std::vector<segment> segments;
+    segments.reserve(task_count);
+    auto fall_back = [&] {
+      parse_into(result, args.begin(), args.end(), status, ignore_first);
+    };
+    status.clear();
+    parse_state state{status};
+    state.write_bound = false;
+    size_type total = 0;
+    for (auto& c : chunks) {
+      size_type i = c.first;
+      auto settled_it = c.settled_at.begin();
+      count_sink sink;
+      for (;;) {
+        while (settled_it != c.settled_at.end() && settled_it->first < i)
+          ++settled_it;
+        if (settled(state.type) && settled_it != c.settled_at.end()
+            && settled_it->first == i)
+          break;
+        if (i == c.last) {
+          settled_it = c.settled_at.end();
+          break;
+        }
+        state.index = i;
+        if (!parse_token(args[i], state, sink))
+          return fall_back();
+        ++i;
+      }
+      total += sink.count();
+      if (settled_it == c.settled_at.end()) {
+        segments.back().last = c.last;
+        continue;
+      }
+      if (c.failed)
+        return fall_back();
+      if (!segments.empty())
+        segments.back().last = i;
+      segments.push_back(segment{i, c.last, total});
+      total += c.count - settled_it->second;
+      state.type = c.type;
+      state.pending = c.pending;
+      state.pending_name = c.pending_name;
+      state.pending_index = c.pending_index;
+      state.pending_offset = c.pending_offset;
+    }
+    if (!finish(state))
+      return fall_back();
+    result.clear();
+    auto& entries = result.m_entries;
+    if (entries.size() < total)
+      entries.resize(total);
+    std::vector<std::vector<size_type>> option_positions(segments.size());
+    run_tasks(segments.size(), [&](size_type task) {
+        const segment& seg = segments[task];
+        parse_status seg_status;
+        parse_state seg_state{seg_status};
+        seg_state.write_bound = false;
+        seg_state.index = seg.first;
+        slice_sink sink{entries, seg.offset};
+        for (size_type i = seg.first; i != seg.last; ++i)
+          parse_token(args[i], seg_state, sink);
+        for (size_type i = seg.offset; i != sink.position(); ++i) {
+          if (entries[i].is_option)
+            option_positions[task].push_back(i);
+        }
+      }, executor);
+    result.m_size = total;
+    result.m_index.links.assign(total, parser_result::npos);
+    state.write_bound = true;
+    for (const auto& positions : option_positions) {
+      for (size_type i : positions) {
+        result.index_entry(i);
+        const auto& entry = entries[i];
+        if (!entry.opt_info)
+          continue;
+        write_flag(*entry.opt_info, state);
+        if (entry.original_text.size() != entry.original_without_argument.size())
+          write_argument(*entry.opt_info, entry.argument, state);
+      }
+    }
+  }
+  bool compiled_parser::parse_string(string_ref cmd_line, bool ignore_first,
+                                     std::string& buffer, parse_state& state,
+                                     entry_sink& sink) const {
+    string_ref token;
+    tokenizer::size_type pos = 0;
+    bool skip = ignore_first;
+    while (m_tokenizer.next(cmd_line, pos, token, buffer)) {
+      if (skip) {
+        skip = false;
+        ++state.index;
+      } else if (!parse_token(sink.keep(token), state, sink)) {
+        return false;
+      } else if (state.stopped) {
+        return true;
+      }
+    }
+    return finish(state);
+  }
+  bool compiled_parser::parse_token(string_ref token, parse_state& state,
+                                    entry_sink& sink) const {
+    if (!m_response_file_prefix.empty()
+        && option_syntax::has_prefix(token, m_response_file_prefix))
+      return parse_response_file(token.substr(m_response_file_prefix.size()),
+                                 state, sink);
+    state.token = token;
+    if (state.type == cl_arg_type::arg_required
+        || state.type == cl_arg_type::arg_optional) {
+      if (syntax().is_non_option(token)
+          || state.type == cl_arg_type::arg_required) {
+        state.type = cl_arg_type::non_option;
+        sink.add_argument(token);
+        auto err = write_argument(*state.pending, token, state);
+        if (err != parse_errc::none)
+          return fail(state, err, 0, state.pending_name);
+        state.pending = nullptr;
+        ++state.index;
+        return true;
+      }
+      state.type = cl_arg_type::non_option;
+      state.pending = nullptr;
+      sink.no_argument();
+    }
+    if (state.type == cl_arg_type::end_indicator) {
+      if (state.stop_after_end_indicator && state.open_files.empty()) {
+        state.stopped = true;
+        return true;
+      }
+      parsed_entry_ref arg_info;
+      arg_info.original_text = token;
+      sink.add(arg_info, false);
+    } else if (state.stop_at_non_option && state.open_files.empty()
+               && syntax().is_non_option(token)) {
+      state.stopped = true;
+      return true;
+    } else if (!parse_argument(token, state, sink)) {
+      return false;
+    }
+    ++state.index;
+    return true;
+  }
+  bool compiled_parser::parse_response_file(string_ref path,
+                                            parse_state& state,
+                                            entry_sink& sink) const {
+    static const tokenizer file_tokenizer{};
+    mapped_file file{path.str()};
+    if (!file.is_open())
+      return fail(state, parse_errc::unreadable_file, 0, path);
+    auto& open_files = state.open_files;
+    if (std::find(open_files.begin(), open_files.end(), file.id()) != open_files.end())
+      return fail(state, parse_errc::recursive_file, 0, path);
+    open_files.push_back(file.id());
+    const string_ref contents = file.contents();
+    string_ref token;
+    tokenizer::size_type pos = 0;
+    std::string buffer;
+    while (file_tokenizer.next(contents, pos, token, buffer)) {
+      if (!parse_token(sink.keep(token), state, sink)) {
+        open_files.pop_back();
+        return false;
+      }
+      if (state.stopped)
+        break;
+    }
+    open_files.pop_back();
+    return true;
+  }
+  bool compiled_parser::finish(parse_state& state) const {
+    if (state.type == cl_arg_type::arg_required) {
+      state.status.set(parse_errc::missing_argument, state.pending_index,
+                       state.pending_offset, state.pending_name);
+      return false;
+    }
+    return true;
   }
-  auto option_group::find(char short_name) -> iterator {
-    return std::find_if(m_options.begin(), m_options.end(),
-                        [&](const option& o) { return o.short_name() == short_name; });
+  bool compiled_parser::fail(parse_state& state, parse_errc error,
+                             string_ref::size_type offset,
+                             string_ref prefix, string_ref name) {
+    state.status.set(error, state.index, offset, prefix, name);
+    return false;
   }
-  auto option_group::find(char short_name) const -> const_iterator {
-    return std::find_if(m_options.begin(), m_options.end(),
-                        [&](const option& o) { return o.short_name() == short_name; });
+  bool compiled_parser::parse_argument(string_ref argument,
+                                       parse_state& state,
+                                       entry_sink& sink) const {
+    using token_kind = option_syntax::token_kind;
+    const auto parts = syntax().split(argument);
+    const string_ref option_specifier = parts.specifier;
+    const string_ref option_argument = parts.argument;
+    const bool assignment_found = parts.has_argument;
+    if (parts.kind == token_kind::end_of_options) {
+      state.type = cl_arg_type::end_indicator;
+      return true;
+    } else if (parts.kind == token_kind::bad_assignment) {
+      return fail(state, parse_errc::invalid_option, 0,
+                  option_specifier, m_equals);
+    }
+    parsed_entry_ref arg_info;
+    if (parts.kind == token_kind::long_option) {
+      string_ref option_name = option_specifier.substr(m_long_option_prefix.size());
+      const option* opt = find_option(option_name);
+      if (!opt && m_allow_abbreviations) {
+        auto matches = m_index.find_prefix(option_name.data(),
+                                           option_name.size());
+        if (matches.second - matches.first == 1) {
+          opt = *matches.first;
+        } else if (matches.first != matches.second) {
+          fail(state, parse_errc::ambiguous_option, 0, option_specifier);
+          for (auto it = matches.first; it != matches.second; ++it)
+            state.status.add_candidate(m_long_option_prefix, (*it)->long_name());
+          return false;
+        }
+      }
+      if (!opt) {
+        fail(state, parse_errc::invalid_option, 0, option_specifier);
+        if (m_suggestions)
+          state.status.set_suggestions(m_suggestions, m_long_option_prefix.size());
+        return false;
+      }
+      arg_info.opt_info = opt;
+      if (!opt->argument_name().empty()) {
+        if (!assignment_found) {
+          if (opt->is_argument_required())
+            state.type = cl_arg_type::arg_required;
+          else
+            state.type = cl_arg_type::arg_optional;
+          state.pending = opt;
+          state.pending_name.assign(option_specifier.data(),
+                                    option_specifier.size());
+          state.pending_index = state.index;
+          state.pending_offset = 0;
+        } else {
+          state.type = cl_arg_type::no_arg;
+          arg_info.argument = option_argument;
+        }
+      } else {
+        if (assignment_found)
+          return fail(state, parse_errc::unexpected_argument,
+                      option_specifier.size(), option_specifier);
+        state.type = cl_arg_type::no_arg;
+      }
+      arg_info.original_text = argument;
+      arg_info.original_without_argument = option_specifier;
+      arg_info.is_option = true;
+      arg_info.long_name = opt->long_name();
+      arg_info.short_name = opt->short_name();
+      if (assignment_found) {
+        auto err = write_argument(*opt, option_argument, state);
+        if (err != parse_errc::none)
+          return fail(state, err, option_argument.data() - argument.data(),
+                      option_specifier);
+      }
+      write_flag(*opt, state);
+      sink.add(arg_info, false);
+    } else if (parts.kind == token_kind::short_options) {
+      return parse_short_option_group(option_specifier, option_argument,
+                                      assignment_found, state, sink);
+    } else {
+      state.type = cl_arg_type::non_option;
+      arg_info.original_text = argument;
+      arg_info.is_option = false;
+      sink.add(arg_info, false);
+    }
+    return true;
   }
-  void option_group::sort() {
-    std::sort(m_options.begin(), m_options.end(),
-              [](const option& a, const option& b) {
-                return a.name() < b.name();
-              });
+  bool compiled_parser::parse_short_option_group(string_ref specifier,
+                                                 string_ref argument,
+                                                 bool has_arg,
+                                                 parse_state& state,
+                                                 entry_sink& sink) const {
+    using sz_t = string_ref::size_type;
+    const sz_t prefix_size = m_short_option_prefix.size();
+    const string_ref token{specifier.data(), has_arg
+        ? static_cast<sz_t>(argument.end() - specifier.begin())
+        : specifier.size()};
+    const string_ref short_names = specifier.substr(prefix_size);
+    for (sz_t pos = 0; pos != short_names.size(); ++pos) {
+      const char name = short_names[pos];
+      const bool is_last = pos + 1 == short_names.size();
+      const string_ref name_text = short_names.substr(pos, 1);
+      const option* opt = find_option(name);
+      if (!opt)
+        return fail(state, parse_errc::invalid_option, prefix_size + pos,
+                    m_short_option_prefix, name_text);
+      const bool takes_arg = !opt->argument_name().empty();
+      if (is_last && has_arg && !takes_arg) {
+        write_flag(*opt, state);
+        return fail(state, parse_errc::unexpected_argument, specifier.size(),
+                    m_short_option_prefix, name_text);
+      }
+      string_ref tail = token.substr(prefix_size + pos, takes_arg ? string_ref::npos : 1);
+      string_ref text = tail;
+      bool transient = false;
+      if (pos != 0) {
+        state.scratch.assign(m_short_option_prefix);
+        state.scratch.append(tail.data(), tail.size());
+        text = state.scratch;
+        transient = true;
+      } else {
+        text = token.substr(0, prefix_size + tail.size());
+      }
+      parsed_entry_ref arg_info;
+      arg_info.original_text = text;
+      arg_info.original_without_argument = text.substr(0, prefix_size + 1);
+      arg_info.is_option = true;
+      arg_info.long_name = opt->long_name();
+      arg_info.short_name = name;
+      arg_info.opt_info = opt;
+      write_flag(*opt, state);
+      if (takes_arg) {
+        string_ref opt_arg;
+        if (!is_last) {
+          opt_arg = tail.substr(1);
+          state.type = cl_arg_type::no_arg;
+        } else if (has_arg) {
+          opt_arg = argument;
+          state.type = cl_arg_type::no_arg;
+        } else {
+          if (opt->is_argument_required())
+            state.type = cl_arg_type::arg_required;
+          else
+            state.type = cl_arg_type::arg_optional;
+          state.pending = opt;
+          state.pending_name.assign(text.data(), prefix_size + 1);
+          state.pending_index = state.index;
+          state.pending_offset = prefix_size + pos;
+        }
+        if (state.type == cl_arg_type::no_arg) {
+          arg_info.argument = opt_arg;
+          auto err = write_argument(*opt, opt_arg, state);
+          if (err != parse_errc::none)
+            return fail(state, err, opt_arg.data() - token.data(),
+                        m_short_option_prefix, name_text);
+        }
+        sink.add(arg_info, transient);
+        break;
+      }
+      sink.add(arg_info, transient);
+      state.type = cl_arg_type::no_arg;
+      if (state.stopped)
+        break;
+    }
+    return true;
   }
 }
 
 namespace optionpp {
-  bool parser_result::is_option_set(const std::string& long_name) const noexcept {
-    if (long_name.empty())
-      return false;
-    else
-      return std::any_of(begin(), end(),
-                         [&](const parsed_entry& i) {
-                           return i.is_option && i.long_name == long_name;
-                         });
+  static_assert(std::is_nothrow_move_constructible<option_group>::value,
+                "option_group must be nothrow move constructible");
+  parser::parser(const parser& other)
+    : m_groups{other.m_groups},
+      m_delims{other.m_delims},
+      m_short_option_prefix{other.m_short_option_prefix},
+      m_long_option_prefix{other.m_long_option_prefix},
+      m_end_of_options{other.m_end_of_options},
+      m_equals{other.m_equals},
+      m_response_file_prefix{other.m_response_file_prefix},
+      m_allow_abbreviations{other.m_allow_abbreviations},
+      m_suggestions_enabled{other.m_suggestions_enabled} {
+    track_groups();
   }
-  bool parser_result::is_option_set(char short_name) const noexcept {
-    if (short_name == '\0')
-      return false;
-    else
-      return std::any_of(begin(), end(),
-                         [&](const parsed_entry& i) {
-                           return i.is_option && i.short_name == short_name;
-                         });
+  parser::parser(parser&& other) noexcept
+    : m_groups{std::move(other.m_groups)},
+      m_delims{std::move(other.m_delims)},
+      m_short_option_prefix{std::move(other.m_short_option_prefix)},
+      m_long_option_prefix{std::move(other.m_long_option_prefix)},
+      m_end_of_options{std::move(other.m_end_of_options)},
+      m_equals{std::move(other.m_equals)},
+      m_response_file_prefix{std::move(other.m_response_file_prefix)},
+      m_allow_abbreviations{other.m_allow_abbreviations},
+      m_suggestions_enabled{other.m_suggestions_enabled} {
+    m_log.text = std::move(other.m_log.text);
+    track_groups();
+    other.invalidate_index();
   }
-  std::string parser_result::get_argument(std::string long_name) const noexcept {
-    if (long_name == "")
-      return "";
-    auto it = std::find_if(rbegin(), rend(),
-                           [&](const parsed_entry& i) {
-                             return i.is_option && i.long_name == long_name;
-                           });
-    if (it != rend())
-      return it->argument;
-    else
-      return "";
+  parser& parser::operator=(const parser& other) {
+    if (this != &other) {
+      m_groups = other.m_groups;
+      m_delims = other.m_delims;
+      m_short_option_prefix = other.m_short_option_prefix;
+      m_long_option_prefix = other.m_long_option_prefix;
+      m_end_of_options = other.m_end_of_options;
+      m_equals = other.m_equals;
+      m_response_file_prefix = other.m_response_file_prefix;
+      m_allow_abbreviations = other.m_allow_abbreviations;
+      m_suggestions_enabled = other.m_suggestions_enabled;
+      m_log.text.reset();
+      track_groups();
+      invalidate_index();
+    }
+    return *this;
   }
-  std::string parser_result::get_argument(char short_name) const noexcept {
-    if (short_name == '\0')
-      return "";
-    auto it = std::find_if(rbegin(), rend(),
-                           [=](const parsed_entry& i) {
-                             return i.is_option && i.short_name == short_name;
-                           });
-    if (it != rend())
-      return it->argument;
-    else
-      return "";
+  parser& parser::operator=(parser&& other) noexcept {
+    if (this != &other) {
+      m_groups = std::move(other.m_groups);
+      m_delims = std::move(other.m_delims);
+      m_short_option_prefix = std::move(other.m_short_option_prefix);
+      m_long_option_prefix = std::move(other.m_long_option_prefix);
+      m_end_of_options = std::move(other.m_end_of_options);
+      m_equals = std::move(other.m_equals);
+      m_response_file_prefix = std::move(other.m_response_file_prefix);
+      m_allow_abbreviations = other.m_allow_abbreviations;
+      m_suggestions_enabled = other.m_suggestions_enabled;
+      m_log.text = std::move(other.m_log.text);
+      track_groups();
+      invalidate_index();
+      other.invalidate_index();
+    }
+    return *this;
   }
-}
-
-
-namespace optionpp {
   option& parser::add_option(const option& opt) {
+    return add_option(option{opt});
+  }
+  option& parser::add_option(option&& opt) {
     auto it = find_group("");
     if (it == m_groups.end()) {
       m_groups.emplace_back("");
-      return m_groups.back().add_option(opt);
+      track_groups();
+      return m_groups.back().add_option(std::move(opt));
     } else {
-      return it->add_option(opt);
+      return it->add_option(std::move(opt));
     }
   }
   option& parser::add_option(const std::string& long_name,
@@ -894,6 +6736,8 @@ namespace optionpp {
                            });
     if (it == m_groups.rend()) {
       m_groups.emplace_back(name);
+      track_groups();
+      m_groups.back().m_tracker.notify();
       return m_groups.back();
     } else {
       return *it;
@@ -904,6 +6748,7 @@ namespace optionpp {
                                   const std::string& long_prefix,
                                   const std::string& end_indicator,
                                   const std::string& equals) {
+    invalidate_index();
     if (!delims.empty())
       m_delims = delims;
     if (!short_prefix.empty())
@@ -916,12 +6761,14 @@ namespace optionpp {
       m_equals = equals;
   }
   void parser::sort_groups() {
+    invalidate_index();
     std::sort(m_groups.begin(), m_groups.end(),
               [](const option_group& a, const option_group& b) {
                 return a.name() < b.name();
               });
   }
   void parser::sort_options() {
+    invalidate_index();
     std::for_each(m_groups.begin(), m_groups.end(),
                   [](option_group& g) { g.sort(); });
   }
@@ -939,31 +6786,69 @@ namespace optionpp {
     else
       return add_option().short_name(short_name);
   }
+  constexpr std::size_t parser::max_help_layouts;
   std::ostream& parser::print_help(std::ostream& os,
                                    int max_line_length,
                                    int group_indent,
                                    int option_indent,
                                    int desc_first_line_indent,
                                    int desc_multiline_indent) const {
+    std::lock_guard<std::mutex> lock{m_cache_mutex};
+    unsigned long changes = m_log.changes.load(std::memory_order_acquire);
+    if (m_help_changes != changes) {
+      m_help_layouts.clear();
+      m_help_changes = changes;
+    }
+    auto it = std::find_if(m_help_layouts.begin(), m_help_layouts.end(),
+                           [&](const help_layout& layout) {
+                             return layout.max_line_length == max_line_length
+                               && layout.group_indent == group_indent
+                               && layout.option_indent == option_indent
+                               && layout.desc_first_line_indent
+                                  == desc_first_line_indent
+                               && layout.desc_multiline_indent
+                                  == desc_multiline_indent;
+                           });
+    if (it == m_help_layouts.end()) {
+      if (m_help_layouts.size() == max_help_layouts)
+        m_help_layouts.erase(m_help_layouts.begin());
+      help_layout layout{max_line_length, group_indent, option_indent,
+                         desc_first_line_indent, desc_multiline_indent, {}};
+      format_help(layout.text, max_line_length, group_indent, option_indent,
+                  desc_first_line_indent, desc_multiline_indent);
+      m_help_layouts.push_back(std::move(layout));
+      it = m_help_layouts.end() - 1;
+    }
+    return os.write(it->text.data(), it->text.size());
+  }
+  void parser::format_help(std::string& text,
+                           int max_line_length,
+                           int group_indent,
+                           int option_indent,
+                           int desc_first_line_indent,
+                           int desc_multiline_indent) const {
     bool first = true;
+    std::string usage;
+    auto out = std::back_inserter(text);
     for (const auto& group : m_groups) {
       if (group.empty())
         continue;
       if (first)
         first = false;
       else
-        os << "\n\n";
+        text += "\n\n";
       if (!group.name().empty()) {
-        os << utility::wrap_text(group.name(), max_line_length, group_indent)
-           << "\n";
+        utility::wrap_text(group.name(), out, max_line_length,
+                           group_indent, group_indent);
+        text += "\n";
       }
       bool first_opt = true;
       for (const auto& opt : group) {
         if (first_opt)
           first_opt = false;
         else
-          os << "\n";
-        std::string usage(option_indent, ' ');
+          text += "\n";
+        usage.assign(option_indent, ' ');
         if (opt.short_name() != '\0') {
           usage += m_short_option_prefix;
           usage += opt.short_name();
@@ -974,34 +6859,35 @@ namespace optionpp {
         }
         if (!opt.long_name().empty()) {
           usage += m_long_option_prefix;
-          usage += opt.long_name();
+          usage.append(opt.long_name().data(), opt.long_name().size());
         }
-        if (!opt.argument_name().empty()) {
-          if (opt.is_argument_required())
-            usage += m_equals + opt.argument_name();
-          else
-            usage += "[" + m_equals + opt.argument_name() + "]";
+        string_ref arg_name = opt.argument_name();
+        if (!arg_name.empty()) {
+          if (!opt.is_argument_required())
+            usage += '[';
+          usage += m_equals;
+          usage.append(arg_name.data(), arg_name.size());
+          if (!opt.is_argument_required())
+            usage += ']';
         }
         int spacing = desc_first_line_indent - usage.size();
         if (spacing <= 1) {
-          os << utility::wrap_text(usage, max_line_length);
+          utility::wrap_text(usage, out, max_line_length, 0, 0);
           if (!opt.description().empty()) {
-            os << "\n" << utility::wrap_text(opt.description(),
-                                             max_line_length,
-                                             desc_multiline_indent,
-                                             desc_first_line_indent);
+            text += "\n";
+            utility::wrap_text(opt.description(), out, max_line_length,
+                               desc_multiline_indent, desc_first_line_indent);
           }
         } else {
           if (!opt.description().empty()) {
             usage += std::string(spacing, ' ');
-            usage += opt.description();
+            usage.append(opt.description().data(), opt.description().size());
           }
-          os << utility::wrap_text(usage, max_line_length,
-                                   desc_multiline_indent, 0);
+          utility::wrap_text(usage, out, max_line_length,
+                             desc_multiline_indent, 0);
         }
       }
     }
-    return os;
   }
   auto parser::find_group(const std::string& name) -> group_iterator {
     return std::find_if(m_groups.begin(), m_groups.end(),
@@ -1015,239 +6901,517 @@ namespace optionpp {
                           return g.name() == name;
                         });
   }
-  option* parser::find_option(const std::string& long_name) {
-    for (auto& group : m_groups) {
-      auto it = group.find(long_name);
-      if (it != group.end())
-        return &(*it);
+  parser::name_checker::name_checker(const parser& owner, std::size_t count)
+    : m_short_names{} {
+    for (const auto& group : owner.m_groups)
+      count += group.size();
+    m_long_names.reserve(count);
+    for (const auto& group : owner.m_groups) {
+      for (const auto& opt : group) {
+        if (!opt.long_name().empty())
+          m_long_names.intern(opt.long_name());
+        m_short_names[static_cast<unsigned char>(opt.short_name())] = true;
+      }
     }
-    return nullptr;
   }
-  const option* parser::find_option(const std::string& long_name) const {
-    for (const auto& group : m_groups) {
-      auto it = group.find(long_name);
-      if (it != group.end())
-        return &(*it);
+  void parser::name_checker::add(const option& opt) {
+    string_ref long_name = opt.long_name();
+    std::size_t before = m_long_names.size();
+    if (!long_name.empty() && m_long_names.intern(long_name) < before)
+      throw duplicate_option_error{"option name '" + long_name + "' is already in use",
+          "optionpp::parser::add_options", long_name.str()};
+    char short_name = opt.short_name();
+    auto& used = m_short_names[static_cast<unsigned char>(short_name)];
+    if (short_name != '\0' && used)
+      throw duplicate_option_error{"option name '" + std::string(1, short_name)
+          + "' is already in use", "optionpp::parser::add_options",
+          std::string(1, short_name)};
+    used = true;
+  }
+  option* parser::find_option(const std::string& long_name) {
+    const option* opt = update_lookup().find(long_name);
+    if (!opt && m_lookup.has_renamed(long_name)) {
+      rebuild_lookup();
+      opt = m_lookup.find(long_name);
     }
-    return nullptr;
+    return const_cast<option*>(opt);
   }
   option* parser::find_option(char short_name) {
-    for (auto& group : m_groups) {
-      auto it = group.find(short_name);
-      if (it != group.end())
-        return &(*it);
+    const option* opt = update_lookup().find(short_name);
+    if (opt && opt->short_name() != short_name) {
+      rebuild_lookup();
+      opt = m_lookup.find(short_name);
     }
-    return nullptr;
+    return const_cast<option*>(opt);
+  }
+  const option_index& parser::update_lookup() {
+    if (m_log.moved) {
+      rebuild_lookup();
+      return m_lookup;
+    }
+    for (const option* opt : m_log.renamed) {
+      const option* by_long = opt->long_name().empty() ? nullptr
+        : m_lookup.find(opt->long_name().data(), opt->long_name().size());
+      const option* by_short = opt->short_name() == '\0' ? nullptr
+        : m_lookup.find(opt->short_name());
+      if ((by_long && by_long != opt) || (by_short && by_short != opt)) {
+        rebuild_lookup();
+        return m_lookup;
+      }
+      m_lookup.insert(*opt);
+    }
+    m_log.renamed.clear();
+    return m_lookup;
   }
-  const option* parser::find_option(char short_name) const {
+  void parser::rebuild_lookup() {
+    m_lookup.clear();
+    std::size_t count = 0;
+    for (const auto& group : m_groups)
+      count += group.size();
+    m_lookup.reserve(count);
     for (const auto& group : m_groups) {
-      auto it = group.find(short_name);
-      if (it != group.end())
-        return &(*it);
+      for (const auto& opt : group)
+        m_lookup.insert(opt);
     }
-    return nullptr;
+    m_log.renamed.clear();
+    m_log.rename_limit = std::max<std::size_t>(64, count);
+    m_log.moved = false;
+  }
+  const compiled_parser& parser::compiled() const {
+    unsigned long changes = m_log.changes.load(std::memory_order_acquire);
+    if (m_compiled_changes.load(std::memory_order_acquire) != changes) {
+      std::lock_guard<std::mutex> lock{m_cache_mutex};
+      changes = m_log.changes.load(std::memory_order_acquire);
+      if (m_compiled_changes.load(std::memory_order_relaxed) != changes) {
+        m_compiled = compiled_parser{*this, compiled_parser::borrow_tag{}};
+        m_compiled_changes.store(changes, std::memory_order_release);
+      }
+    }
+    return m_compiled;
   }
   parser_result parser::parse(int argc, char* argv[], bool ignore_first) const {
-    return parse(argv, argv + argc, ignore_first);
+    return compiled().parse(argc, argv, ignore_first);
   }
   parser_result parser::parse(const std::string& cmd_line, bool ignore_first) const {
-    std::vector<std::string> container;
-    utility::split(cmd_line, std::back_inserter(container),
-                   m_delims, "\"'", '\\');
-    return parse(container.begin(), container.end(), ignore_first);
+    return compiled().parse(cmd_line, ignore_first);
+  }
+  void parser::parse_into(parser_result& result, int argc, char* argv[],
+                          bool ignore_first) const {
+    compiled().parse_into(result, argc, argv, ignore_first);
+  }
+  void parser::parse_into(parser_result& result, const std::string& cmd_line,
+                          bool ignore_first) const {
+    compiled().parse_into(result, cmd_line, ignore_first);
+  }
+  void parser::parse_into(parser_result& result, int argc, char* argv[],
+                          parse_status& status, bool ignore_first) const {
+    compiled().parse_into(result, argc, argv, status, ignore_first);
+  }
+  void parser::parse_into(parser_result& result, const std::string& cmd_line,
+                          parse_status& status, bool ignore_first) const {
+    compiled().parse_into(result, cmd_line, status, ignore_first);
+  }
+  void parser::parse_into(parser_result& result, int argc, char* argv[],
+                          const parse_target& target, parse_status& status,
+                          bool ignore_first) const {
+    compiled().parse_into(result, argc, argv, target, status, ignore_first);
+  }
+  void parser::parse_into(parser_result& result, const std::string& cmd_line,
+                          const parse_target& target, parse_status& status,
+                          bool ignore_first) const {
+    compiled().parse_into(result, cmd_line, target, status, ignore_first);
+  }
+  parser_result_ref parser::parse_ref(int argc, char* argv[],
+                                      bool ignore_first) const {
+    return compiled().parse_ref(argc, argv, ignore_first);
+  }
+  parser_result_ref parser::parse_ref(const std::string& cmd_line,
+                                      bool ignore_first) const {
+    return compiled().parse_ref(cmd_line, ignore_first);
+  }
+  bool parser::visit(int argc, char* argv[],
+                     const compiled_parser::option_handler& on_option,
+                     const compiled_parser::non_option_handler& on_non_option,
+                     parse_status& status, bool ignore_first) const {
+    return compiled().visit(argc, argv, on_option, on_non_option, status,
+                            ignore_first);
+  }
+  bool parser::visit(const std::string& cmd_line,
+                     const compiled_parser::option_handler& on_option,
+                     const compiled_parser::non_option_handler& on_non_option,
+                     parse_status& status, bool ignore_first) const {
+    return compiled().visit(cmd_line, on_option, on_non_option, status,
+                            ignore_first);
+  }
+  std::ostream& operator<<(std::ostream& os, const parser& opt_parser) {
+    return opt_parser.print_help(os);
+  }
+}
+
+namespace optionpp {
+  const parser_result& command_result::at(size_type level) const {
+    if (level >= m_levels.size())
+      throw out_of_range("out of bounds command_result access",
+                         "optionpp::command_result::at");
+    return m_levels[level];
+  }
+}
+
+namespace optionpp {
+  command_parser& command_parser::add_command(const std::string& name,
+                                              factory_type factory) {
+    auto it = std::find_if(m_commands.begin(), m_commands.end(),
+                           [&](const command_entry& entry) {
+                             return entry.name == name;
+                           });
+    if (it == m_commands.end()) {
+      m_commands.push_back(command_entry{name, std::move(factory),
+            std::unique_ptr<std::mutex>{new std::mutex}, nullptr});
+    } else {
+      it->factory = std::move(factory);
+      it->command.reset();
+    }
+    return *this;
+  }
+  bool command_parser::is_command_built(const std::string& name) const {
+    const command_entry* entry = find_entry(name);
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return entry && entry->command;
+  }
+  command_parser& command_parser::command(const std::string& name) {
+    const command_entry* entry = find_entry(name);
+    if (!entry)
+      throw out_of_range("no subcommand named '" + name + "'",
+                         "optionpp::command_parser::command");
+    return build(*entry);
+  }
+  command_result command_parser::parse(int argc, char* argv[],
+                                       bool ignore_first) const {
+    return parse(argv, argv + argc, ignore_first);
+  }
+  command_result command_parser::parse(const std::string& cmd_line,
+                                       bool ignore_first) const {
+    std::vector<std::string> args;
+    utility::split(cmd_line, std::back_inserter(args), m_options.m_delims);
+    return parse(args.begin(), args.end(), ignore_first);
+  }
+  void command_parser::parse_into(command_result& result, int argc,
+                                  char* argv[], parse_status& status,
+                                  bool ignore_first) const {
+    parse_into(result, argv, argv + argc, status, ignore_first);
+  }
+  void command_parser::parse_into(command_result& result,
+                                  const std::string& cmd_line,
+                                  parse_status& status,
+                                  bool ignore_first) const {
+    std::vector<std::string> args;
+    utility::split(cmd_line, std::back_inserter(args), m_options.m_delims);
+    parse_into(result, args.begin(), args.end(), status, ignore_first);
+  }
+  auto command_parser::find_entry(string_ref name) const noexcept
+    -> const command_entry* {
+    for (const auto& entry : m_commands) {
+      if (name == entry.name)
+        return &entry;
+    }
+    return nullptr;
+  }
+  command_parser& command_parser::build(const command_entry& entry) const {
+    std::lock_guard<std::mutex> build_lock{*entry.build_mutex};
+    if (!entry.command) {
+      std::unique_ptr<command_parser> command{new command_parser};
+      if (entry.factory)
+        entry.factory(*command);
+      std::lock_guard<std::mutex> lock{m_mutex};
+      entry.command = std::move(command);
+    }
+    return *entry.command;
+  }
+}
+
+namespace optionpp {
+  incremental_parser::incremental_parser(const compiled_parser& source,
+                                         entry_handler handler,
+                                         bool ignore_first)
+    : m_parser{&source}, m_ignore_first{ignore_first},
+      m_skip_next{ignore_first}, m_state{m_status},
+      m_buffer{std::move(handler)} {}
+  void incremental_parser::feed(string_ref argument) {
+    if (!step(argument))
+      throw m_status.to_error();
+  }
+  bool incremental_parser::feed(string_ref argument, parse_status& status) {
+    if (!step(argument)) {
+      status = m_status;
+      return false;
+    }
+    status.clear();
+    return true;
+  }
+  void incremental_parser::finish() {
+    if (!step_finish())
+      throw m_status.to_error();
   }
-  void parser::write_option_argument(const parsed_entry& entry) const {
-    if (!entry.opt_info)
+  bool incremental_parser::finish(parse_status& status) {
+    if (!step_finish()) {
+      status = m_status;
+      return false;
+    }
+    status.clear();
+    return true;
+  }
+  void incremental_parser::reset() noexcept {
+    m_skip_next = m_ignore_first;
+    m_failed = false;
+    m_status.clear();
+    m_state.type = compiled_parser::cl_arg_type::non_option;
+    m_state.pending = nullptr;
+    m_state.index = 0;
+    m_buffer.discard();
+  }
+  bool incremental_parser::step(string_ref argument) {
+    if (m_failed)
+      return false;
+    if (m_skip_next) {
+      m_skip_next = false;
+      ++m_state.index;
+      return true;
+    }
+    if (!m_parser->parse_token(argument, m_state, m_buffer)) {
+      m_buffer.discard();
+      m_failed = true;
+      return false;
+    }
+    if (waiting_for_argument())
+      m_buffer.keep();
+    else
+      m_buffer.flush();
+    return true;
+  }
+  bool incremental_parser::step_finish() {
+    if (m_failed)
+      return false;
+    if (!m_parser->finish(m_state)) {
+      m_buffer.discard();
+      m_failed = true;
+      return false;
+    }
+    m_buffer.flush();
+    reset();
+    return true;
+  }
+  void incremental_parser::entry_buffer::add(const parsed_entry_ref& entry,
+                                             bool transient_text) {
+    flush();
+    m_entry = entry;
+    m_has_entry = true;
+    if (transient_text)
+      keep();
+  }
+  void incremental_parser::entry_buffer::add_argument(string_ref argument) {
+    const auto name_size = m_entry.original_without_argument.size();
+    m_joined.assign(m_entry.original_text.data(), m_entry.original_text.size());
+    m_joined.push_back(' ');
+    m_joined.append(argument.data(), argument.size());
+    string_ref joined{m_joined};
+    m_entry.original_text = joined;
+    m_entry.original_without_argument = joined.substr(0, name_size);
+    m_entry.argument = joined.substr(joined.size() - argument.size());
+  }
+  string_ref incremental_parser::entry_buffer::keep(string_ref token) {
+    keep();
+    m_token.assign(token.data(), token.size());
+    return m_token;
+  }
+  void incremental_parser::entry_buffer::flush() {
+    if (!m_has_entry)
       return;
-    const option& opt = *entry.opt_info;
-    if (!opt.has_bound_argument_variable())
+    m_has_entry = false;
+    if (m_handler)
+      m_handler(m_entry);
+  }
+  void incremental_parser::entry_buffer::keep() {
+    if (!m_has_entry)
       return;
-    std::string::size_type pos = 0;
-    const std::string& arg = entry.argument;
-    const std::string& opt_name = entry.original_without_argument;
-    const std::string& fn_name = "optionpp::parser::write_option_argument";
-    try {
-      switch (opt.argument_type()) {
-      case option::uint_arg: {
-        long long value = std::stoll(entry.argument, &pos);
-        if (pos != arg.size())
-          throw std::invalid_argument{"invalid argument"};
-        if (value < 0)
-          throw parse_error{"argument for option '" + opt_name + "' must not be negative",
-              fn_name, opt_name};
-        else if (value > std::numeric_limits<unsigned>::max())
-          throw std::out_of_range{"out of range"};
-        opt.write_uint(static_cast<unsigned>(value));
-        break;
-      }
-      case option::int_arg: {
-        int value = std::stoi(entry.argument, &pos);
-        if (pos != arg.size())
-          throw std::invalid_argument{"invalid argument"};
-        opt.write_int(value);
-        break;
-      }
-      case option::double_arg: {
-        double value = std::stod(entry.argument, &pos);
-        if (pos != arg.size())
-          throw std::invalid_argument{"invalid argument"};
-        opt.write_double(value);
-        break;
-      }
-      default:
-      case option::string_arg:
-        opt.write_string(arg);
-        break;
+    const auto name_size = m_entry.original_without_argument.size();
+    const auto arg_size = m_entry.argument.size();
+    m_text.assign(m_entry.original_text.data(), m_entry.original_text.size());
+    string_ref text{m_text};
+    m_entry.original_text = text;
+    m_entry.original_without_argument = text.substr(0, name_size);
+    if (arg_size != 0)
+      m_entry.argument = text.substr(text.size() - arg_size);
+  }
+}
+
+namespace optionpp {
+  namespace {
+    const option_syntax default_syntax{};
+  }
+  constexpr std::uint32_t schema_parser::npos;
+  const option_spec* schema_parser::find(string_ref long_name) const noexcept {
+    if (long_name.empty())
+      return nullptr;
+    std::uint32_t h = string_pool::hash(long_name.data(), long_name.size());
+    std::uint32_t pos = m_slots[displaced_slot(h, m_displacements[bucket(h, m_bucket_count)],
+                                               m_slot_count)];
+    if (pos == npos)
+      return nullptr;
+    const char* name = m_specs[pos].long_name;
+    if (std::strncmp(name, long_name.data(), long_name.size()) != 0
+        || name[long_name.size()] != '\0')
+      return nullptr;
+    return m_specs + pos;
+  }
+  std::ostream& schema_parser::print_help(std::ostream& os) const {
+    return os.write(m_help, static_cast<std::streamsize>(m_help_size));
+  }
+  bool schema_parser::parse_token(string_ref token, visit_state& state) const {
+    if (state.pending) {
+      const option_spec& spec = *state.pending;
+      if (default_syntax.is_non_option(token) || spec.arg_required) {
+        state.pending = nullptr;
+        pass_option(spec, token, state);
+        if (!check(spec, token, 0, state.pending_name, string_ref{}, state))
+          return false;
+        ++state.index;
+        return true;
       }
-    } catch(const std::invalid_argument&) {
-      switch (opt.argument_type()) {
-      case option::uint_arg:
-      case option::int_arg:
-        throw parse_error{"argument for option '" + opt_name + "' must be an integer",
-            fn_name, opt_name};
-      case option::double_arg:
-        throw parse_error{"argument for option '" + opt_name + "' must be a number",
-            fn_name, opt_name};
-      default:
-        throw type_error{"type error in argument for option '" + opt_name + "'", fn_name};
-      }
-    } catch(const std::out_of_range&) {
-      throw parse_error{"argument for option '" + opt_name + "' is out of range",
-          fn_name, opt_name};
-    }
-  }
-  void parser::parse_argument(const std::string& argument,
-                              parser_result& result, cl_arg_type& type) const {
-    if (is_end_indicator(argument)) {
-      type = cl_arg_type::end_indicator;
-      return;
+      state.pending = nullptr;
+      pass_option(spec, string_ref{}, state);
+      if (state.stopped)
+        return true;
     }
-    std::string option_specifier;
-    std::string option_argument;
-    bool assignment_found = false;
-    auto pos = argument.find(m_equals);
-    if (pos == std::string::npos)
-      option_specifier = argument;
-    else {
-      assignment_found = true;
-      option_specifier = argument.substr(0, pos);
-      pos += m_equals.size();
-      option_argument = argument.substr(pos);
-      if (option_specifier == m_short_option_prefix
-          || option_specifier == m_long_option_prefix) {
-        option_specifier += m_equals;
-        throw parse_error{"invalid option: '" + option_specifier + "'",
-            "optionpp::parser::parse_argument", option_specifier};
-      }
-    }
-    parsed_entry arg_info;
-    if (is_long_option(option_specifier)) {
-      std::string option_name = option_specifier.substr(m_long_option_prefix.size());
-      const option* opt = find_option(option_name);
-      if (!opt)
-        throw parse_error{"invalid option: '" + option_specifier + "'",
-            "optionpp::parser::parse_argument", option_specifier};
-      arg_info.opt_info = &(*opt);
-      if (!opt->argument_name().empty()) {
-        if (!assignment_found) {
-          if (opt->is_argument_required())
-            type = cl_arg_type::arg_required;
-          else
-            type = cl_arg_type::arg_optional;
-        } else {
-          type = cl_arg_type::no_arg;
-          arg_info.argument = option_argument;
-        }
-      } else {
-        if (assignment_found)
-          throw parse_error{"option '" + option_specifier + "' does not accept arguments",
-              "optionpp::parser::parse_argument", option_specifier};
-        type = cl_arg_type::no_arg;
-      }
-      arg_info.original_text = argument;
-      arg_info.original_without_argument = option_specifier;
-      arg_info.is_option = true;
-      arg_info.long_name = option_name;
-      arg_info.short_name = opt->short_name();
-      if (assignment_found)
-        write_option_argument(arg_info);
-      opt->write_bool(true);
-      result.push_back(std::move(arg_info));
-    } else if (is_short_option_group(option_specifier)) {
-      parse_short_option_group(option_specifier.substr(m_short_option_prefix.size()),
-                               option_argument, assignment_found,
-                               result, type);
+    if (state.end_of_options)
+      pass_non_option(token, state);
+    else if (!parse_argument(token, state))
+      return false;
+    ++state.index;
+    return true;
+  }
+  bool schema_parser::parse_argument(string_ref token, visit_state& state) const {
+    using token_kind = option_syntax::token_kind;
+    const auto parts = default_syntax.split(token);
+    const string_ref specifier = parts.specifier;
+    switch (parts.kind) {
+    case token_kind::end_of_options:
+      state.end_of_options = true;
+      return true;
+    case token_kind::bad_assignment:
+      return fail(state, parse_errc::invalid_option, 0, specifier,
+                  default_syntax.equals());
+    case token_kind::short_options:
+      return parse_short_option_group(token, specifier, parts.argument,
+                                      parts.has_argument, state);
+    case token_kind::non_option:
+      pass_non_option(token, state);
+      return true;
+    case token_kind::long_option:
+      break;
+    }
+    const option_spec* spec = find(specifier.substr(default_syntax.long_prefix().size()));
+    if (!spec)
+      return fail(state, parse_errc::invalid_option, 0, specifier);
+    if (!*spec->arg_name) {
+      if (parts.has_argument)
+        return fail(state, parse_errc::unexpected_argument, specifier.size(), specifier);
+      pass_option(*spec, string_ref{}, state);
+    } else if (!parts.has_argument) {
+      state.pending = spec;
+      state.pending_name.assign(specifier.data(), specifier.size());
+      state.pending_index = state.index;
+      state.pending_offset = 0;
     } else {
-      type = cl_arg_type::non_option;
-      arg_info.original_text = argument;
-      arg_info.is_option = false;
-      result.push_back(std::move(arg_info));
+      return accept(*spec, parts.argument, parts.argument.data() - token.data(),
+                    specifier, string_ref{}, state);
     }
+    return true;
   }
-  void parser::parse_short_option_group(const std::string& short_names,
-                                        const std::string& argument, bool has_arg,
-                                        parser_result& result, cl_arg_type& type) const {
-    using sz_t = std::string::size_type;
-    for (sz_t pos = 0; pos != short_names.size(); ++pos) {
-      const option* opt = find_option(short_names[pos]);
-      if (!opt) {
-        auto opt_name = m_short_option_prefix;
-        opt_name.push_back(short_names[pos]);
-        throw parse_error{"invalid option: '" + opt_name + "'",
-            "optionpp::parser::parse_short_option_group", opt_name};
-      }
-      parsed_entry arg_info;
-      arg_info.original_text = m_short_option_prefix;
-      arg_info.original_text.push_back(short_names[pos]);
-      arg_info.original_without_argument = arg_info.original_text;
-      arg_info.is_option = true;
-      arg_info.long_name = opt->long_name();
-      arg_info.short_name = short_names[pos];
-      arg_info.opt_info = &(*opt);
-      opt->write_bool(true);
-      if (!opt->argument_name().empty()) {
-        if (pos + 1 < short_names.size()) {
-          arg_info.argument = short_names.substr(pos + 1);
-          if (has_arg) {
-            arg_info.argument += m_equals;
-            arg_info.argument += argument;
-          }
-          arg_info.original_text += arg_info.argument;
-          write_option_argument(arg_info);
-          result.push_back(std::move(arg_info));
-          type = cl_arg_type::no_arg;
-          break;
-        } else {
-          if (has_arg) {
-            arg_info.original_text += m_equals;
-            arg_info.original_text += argument;
-            arg_info.argument = argument;
-            write_option_argument(arg_info);
-            type = cl_arg_type::no_arg;
-          } else if (opt->is_argument_required()) {
-            type = cl_arg_type::arg_required;
-          } else {
-            type = cl_arg_type::arg_optional;
-          }
-          result.push_back(std::move(arg_info));
-          break;
-        }
+  bool schema_parser::parse_short_option_group(string_ref token,
+                                               string_ref specifier,
+                                               string_ref argument,
+                                               bool has_arg,
+                                               visit_state& state) const {
+    using sz_t = string_ref::size_type;
+    const string_ref prefix = default_syntax.short_prefix();
+    const string_ref short_names = specifier.substr(prefix.size());
+    for (sz_t pos = 0; pos != short_names.size() && !state.stopped; ++pos) {
+      const bool is_last = pos + 1 == short_names.size();
+      const string_ref name_text = short_names.substr(pos, 1);
+      const option_spec* spec = find(short_names[pos]);
+      if (!spec)
+        return fail(state, parse_errc::invalid_option, prefix.size() + pos,
+                    prefix, name_text);
+      if (!*spec->arg_name) {
+        if (is_last && has_arg)
+          return fail(state, parse_errc::unexpected_argument, specifier.size(),
+                      prefix, name_text);
+        pass_option(*spec, string_ref{}, state);
+        continue;
+      }
+      if (!is_last) {
+        string_ref opt_arg = token.substr(prefix.size() + pos + 1);
+        return accept(*spec, opt_arg, opt_arg.data() - token.data(), prefix,
+                      name_text, state);
+      } else if (has_arg) {
+        return accept(*spec, argument, argument.data() - token.data(), prefix,
+                      name_text, state);
       }
-      if (pos + 1 == short_names.size() && has_arg) {
-        auto opt_name = m_short_option_prefix;
-        opt_name.push_back(short_names[pos]);
-        throw parse_error{"option '" + opt_name + "' does not accept arguments",
-            "optionpp::parser::parse_short_option_group", opt_name};
+      state.pending = spec;
+      state.pending_name.assign(prefix.data(), prefix.size());
+      state.pending_name += short_names[pos];
+      state.pending_index = state.index;
+      state.pending_offset = prefix.size() + pos;
+    }
+    return true;
+  }
+  bool schema_parser::finish(visit_state& state) {
+    if (state.pending) {
+      if (state.pending->arg_required) {
+        state.status.set(parse_errc::missing_argument, state.pending_index,
+                         state.pending_offset, state.pending_name);
+        return false;
       }
-      result.push_back(std::move(arg_info));
-      type = cl_arg_type::no_arg;
-      arg_info = parsed_entry{};
+      pass_option(*state.pending, string_ref{}, state);
+      state.pending = nullptr;
     }
+    return true;
   }
-  std::ostream& operator<<(std::ostream& os, const parser& opt_parser) {
-    return opt_parser.print_help(os);
+  bool schema_parser::accept(const option_spec& spec, string_ref argument,
+                             size_type offset, string_ref prefix,
+                             string_ref name, visit_state& state) {
+    if (!check(spec, argument, offset, prefix, name, state))
+      return false;
+    pass_option(spec, argument, state);
+    return true;
+  }
+  bool schema_parser::check(const option_spec& spec, string_ref argument,
+                            size_type offset, string_ref prefix,
+                            string_ref name, visit_state& state) {
+    if (spec.checker) {
+      auto err = spec.checker(argument);
+      if (err != parse_errc::none)
+        return fail(state, err, offset, prefix, name);
+    }
+    return true;
+  }
+  void schema_parser::pass_option(const option_spec& spec, string_ref argument,
+                                  visit_state& state) {
+    if (!state.stopped && state.on_option && !state.on_option(spec, argument))
+      state.stopped = true;
+  }
+  void schema_parser::pass_non_option(string_ref argument, visit_state& state) {
+    if (!state.stopped && state.on_non_option && !state.on_non_option(argument))
+      state.stopped = true;
+  }
+  bool schema_parser::fail(visit_state& state, parse_errc error,
+                           size_type offset, string_ref prefix,
+                           string_ref name) {
+    state.status.set(error, state.index, offset, prefix, name);
+    return false;
   }
 }
 
 
 #endif
+#undef OPTIONPP_MAIN
@@ -0,0 +1,204 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `batch_result` class implementation.
+ */
+
+#include <optionpp/batch_result.hpp>
+
+#include <utility>
+
+namespace optionpp {
+
+  batch_result::batch_result(batch_result&& other) noexcept
+    : m_line_begin{std::move(other.m_line_begin)},
+      m_current_begin{other.m_current_begin},
+      m_error{std::move(other.m_error)},
+      m_error_token{std::move(other.m_error_token)},
+      m_error_offset{std::move(other.m_error_offset)},
+      m_error_option{std::move(other.m_error_option)},
+      m_error_count{other.m_error_count},
+      m_original_text{std::move(other.m_original_text)},
+      m_original_without_argument{std::move(other.m_original_without_argument)},
+      m_is_option{std::move(other.m_is_option)},
+      m_long_name{std::move(other.m_long_name)},
+      m_short_name{std::move(other.m_short_name)},
+      m_argument{std::move(other.m_argument)},
+      m_opt_info{std::move(other.m_opt_info)},
+      m_text{std::move(other.m_text)} {
+    other.clear();
+  }
+
+  batch_result& batch_result::operator=(batch_result&& other) noexcept {
+    if (this != &other) {
+      m_line_begin = std::move(other.m_line_begin);
+      m_current_begin = other.m_current_begin;
+      m_error = std::move(other.m_error);
+      m_error_token = std::move(other.m_error_token);
+      m_error_offset = std::move(other.m_error_offset);
+      m_error_option = std::move(other.m_error_option);
+      m_error_count = other.m_error_count;
+      m_original_text = std::move(other.m_original_text);
+      m_original_without_argument = std::move(other.m_original_without_argument);
+      m_is_option = std::move(other.m_is_option);
+      m_long_name = std::move(other.m_long_name);
+      m_short_name = std::move(other.m_short_name);
+      m_argument = std::move(other.m_argument);
+      m_opt_info = std::move(other.m_opt_info);
+      m_text = std::move(other.m_text);
+      other.clear();
+    }
+    return *this;
+  }
+
+  void batch_result::clear() noexcept {
+    m_line_begin.clear();
+    m_current_begin = 0;
+    m_error.clear();
+    m_error_token.clear();
+    m_error_offset.clear();
+    m_error_option.clear();
+    m_error_count = 0;
+    m_original_text.clear();
+    m_original_without_argument.clear();
+    m_is_option.clear();
+    m_long_name.clear();
+    m_short_name.clear();
+    m_argument.clear();
+    m_opt_info.clear();
+
+    // Keep one arena, which still has its blocks
+    if (m_text.size() > 1)
+      m_text.erase(m_text.begin() + 1, m_text.end());
+    if (!m_text.empty())
+      m_text.front().clear();
+  }
+
+  parsed_entry_ref batch_result::entry(size_type index) const {
+    if (index >= entry_count())
+      throw out_of_range("out of bounds batch_result access",
+                         "optionpp::batch_result::entry");
+
+    parsed_entry_ref entry;
+    entry.original_text = m_original_text[index];
+    entry.original_without_argument = m_original_without_argument[index];
+    entry.is_option = m_is_option[index] != 0;
+    entry.long_name = m_long_name[index];
+    entry.short_name = m_short_name[index];
+    entry.argument = m_argument[index];
+    entry.opt_info = m_opt_info[index];
+    return entry;
+  }
+
+  parser_result batch_result::line_result(size_type line) const {
+    if (line >= line_count())
+      throw out_of_range("out of bounds batch_result access",
+                         "optionpp::batch_result::line_result");
+
+    parser_result result;
+    result.reserve(entry_count(line));
+    for (size_type i = first_entry(line); i != first_entry(line + 1); ++i)
+      result.push_back(entry(i).to_entry());
+    return result;
+  }
+
+  void batch_result::push_back(const parsed_entry_ref& entry) {
+    m_original_text.push_back(entry.original_text);
+    m_original_without_argument.push_back(entry.original_without_argument);
+    m_is_option.push_back(entry.is_option ? 1 : 0);
+    m_long_name.push_back(entry.long_name);
+    m_short_name.push_back(entry.short_name);
+    m_argument.push_back(entry.argument);
+    m_opt_info.push_back(entry.opt_info);
+  }
+
+  void batch_result::end_line() {
+    m_line_begin.push_back(m_current_begin);
+    m_error.push_back(parse_errc::none);
+    m_error_token.push_back(0);
+    m_error_offset.push_back(0);
+    m_error_option.push_back(string_ref{});
+    m_current_begin = entry_count();
+  }
+
+  void batch_result::fail_line(const parse_status& status) {
+    // Drop whatever was parsed before the error
+    m_original_text.resize(m_current_begin);
+    m_original_without_argument.resize(m_current_begin);
+    m_is_option.resize(m_current_begin);
+    m_long_name.resize(m_current_begin);
+    m_short_name.resize(m_current_begin);
+    m_argument.resize(m_current_begin);
+    m_opt_info.resize(m_current_begin);
+
+    m_line_begin.push_back(m_current_begin);
+    m_error.push_back(status.error());
+    m_error_token.push_back(status.token_index());
+    m_error_offset.push_back(status.offset());
+    m_error_option.push_back(store(status.option()));
+    ++m_error_count;
+  }
+
+  string_ref batch_result::store(string_ref a, string_ref b, string_ref c) {
+    if (m_text.empty())
+      m_text.emplace_back();
+    return m_text.back().store(a, b, c);
+  }
+
+  void batch_result::append(batch_result&& other) {
+    size_type offset = entry_count();
+    for (size_type begin : other.m_line_begin)
+      m_line_begin.push_back(begin + offset);
+    m_error.insert(m_error.end(), other.m_error.begin(), other.m_error.end());
+    m_error_token.insert(m_error_token.end(),
+                         other.m_error_token.begin(), other.m_error_token.end());
+    m_error_offset.insert(m_error_offset.end(),
+                          other.m_error_offset.begin(), other.m_error_offset.end());
+    m_error_option.insert(m_error_option.end(),
+                          other.m_error_option.begin(), other.m_error_option.end());
+    m_error_count += other.m_error_count;
+
+    m_original_text.insert(m_original_text.end(),
+                           other.m_original_text.begin(), other.m_original_text.end());
+    m_original_without_argument.insert(m_original_without_argument.end(),
+                                       other.m_original_without_argument.begin(),
+                                       other.m_original_without_argument.end());
+    m_is_option.insert(m_is_option.end(),
+                       other.m_is_option.begin(), other.m_is_option.end());
+    m_long_name.insert(m_long_name.end(),
+                       other.m_long_name.begin(), other.m_long_name.end());
+    m_short_name.insert(m_short_name.end(),
+                        other.m_short_name.begin(), other.m_short_name.end());
+    m_argument.insert(m_argument.end(),
+                      other.m_argument.begin(), other.m_argument.end());
+    m_opt_info.insert(m_opt_info.end(),
+                      other.m_opt_info.begin(), other.m_opt_info.end());
+    m_current_begin = entry_count();
+
+    // Moving an arena keeps the stored text where it is, so the
+    // references taken from the other result stay valid. The arena
+    // being filled has to stay last.
+    for (auto& arena : other.m_text)
+      m_text.insert(m_text.end() - (m_text.empty() ? 0 : 1), std::move(arena));
+    other.clear();
+  }
+
+} // End namespace
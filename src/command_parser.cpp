@@ -0,0 +1,117 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `command_parser` class implementation.
+ */
+
+#include <optionpp/command_parser.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <optionpp/error.hpp>
+#include <optionpp/utility.hpp>
+
+namespace optionpp {
+
+  command_parser& command_parser::add_command(const std::string& name,
+                                              factory_type factory) {
+    auto it = std::find_if(m_commands.begin(), m_commands.end(),
+                           [&](const command_entry& entry) {
+                             return entry.name == name;
+                           });
+    if (it == m_commands.end()) {
+      m_commands.push_back(command_entry{name, std::move(factory),
+            std::unique_ptr<std::mutex>{new std::mutex}, nullptr});
+    } else {
+      it->factory = std::move(factory);
+      it->command.reset();
+    }
+    return *this;
+  }
+
+  bool command_parser::is_command_built(const std::string& name) const {
+    const command_entry* entry = find_entry(name);
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return entry && entry->command;
+  }
+
+  command_parser& command_parser::command(const std::string& name) {
+    const command_entry* entry = find_entry(name);
+    if (!entry)
+      throw out_of_range("no subcommand named '" + name + "'",
+                         "optionpp::command_parser::command");
+    return build(*entry);
+  }
+
+  command_result command_parser::parse(int argc, char* argv[],
+                                       bool ignore_first) const {
+    return parse(argv, argv + argc, ignore_first);
+  }
+
+  command_result command_parser::parse(const std::string& cmd_line,
+                                       bool ignore_first) const {
+    std::vector<std::string> args;
+    utility::split(cmd_line, std::back_inserter(args), m_options.m_delims);
+    return parse(args.begin(), args.end(), ignore_first);
+  }
+
+  void command_parser::parse_into(command_result& result, int argc,
+                                  char* argv[], parse_status& status,
+                                  bool ignore_first) const {
+    parse_into(result, argv, argv + argc, status, ignore_first);
+  }
+
+  void command_parser::parse_into(command_result& result,
+                                  const std::string& cmd_line,
+                                  parse_status& status,
+                                  bool ignore_first) const {
+    std::vector<std::string> args;
+    utility::split(cmd_line, std::back_inserter(args), m_options.m_delims);
+    parse_into(result, args.begin(), args.end(), status, ignore_first);
+  }
+
+  auto command_parser::find_entry(string_ref name) const noexcept
+    -> const command_entry* {
+    for (const auto& entry : m_commands) {
+      if (name == entry.name)
+        return &entry;
+    }
+    return nullptr;
+  }
+
+  command_parser& command_parser::build(const command_entry& entry) const {
+    // Run the factory without holding m_mutex, so that it can use the
+    // other subcommands of this parser
+    std::lock_guard<std::mutex> build_lock{*entry.build_mutex};
+    if (!entry.command) {
+      // Only keep the subcommand once its factory has succeeded
+      std::unique_ptr<command_parser> command{new command_parser};
+      if (entry.factory)
+        entry.factory(*command);
+
+      std::lock_guard<std::mutex> lock{m_mutex};
+      entry.command = std::move(command);
+    }
+    return *entry.command;
+  }
+
+} // End namespace
@@ -0,0 +1,38 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `command_result` class implementation.
+ */
+
+#include <optionpp/command_result.hpp>
+
+#include <optionpp/error.hpp>
+
+namespace optionpp {
+
+  const parser_result& command_result::at(size_type level) const {
+    if (level >= m_levels.size())
+      throw out_of_range("out of bounds command_result access",
+                         "optionpp::command_result::at");
+    return m_levels[level];
+  }
+
+} // End namespace
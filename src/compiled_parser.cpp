@@ -0,0 +1,974 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `compiled_parser` implementation.
+ */
+
+#include <optionpp/compiled_parser.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <utility>
+#include <optionpp/parser.hpp>
+
+namespace optionpp {
+
+  compiled_parser::compiled_parser(const parser& source) {
+    size_type count = 0;
+    for (const auto& group : source.m_groups)
+      count += group.size();
+
+    m_options.reserve(count);
+    for (const auto& group : source.m_groups)
+      m_options.insert(m_options.end(), group.begin(), group.end());
+
+    copy_strings(source);
+    reindex();
+
+    if (source.m_suggestions_enabled) {
+      auto suggestions = std::make_shared<suggestion_index>();
+      for (const auto& opt : m_options)
+        suggestions->insert(opt.long_name());
+      m_suggestions = std::move(suggestions);
+    }
+  }
+
+  compiled_parser::compiled_parser(const parser& source, borrow_tag) {
+    size_type count = 0;
+    for (const auto& group : source.m_groups)
+      count += group.size();
+
+    m_index.reserve(count);
+    for (const auto& group : source.m_groups) {
+      for (const auto& opt : group)
+        m_index.insert(opt);
+    }
+
+    copy_strings(source);
+    if (m_allow_abbreviations)
+      m_index.sort_names();
+
+    if (source.m_suggestions_enabled) {
+      auto suggestions = std::make_shared<suggestion_index>();
+      for (const auto& group : source.m_groups) {
+        for (const auto& opt : group)
+          suggestions->insert(opt.long_name());
+      }
+      m_suggestions = std::move(suggestions);
+    }
+  }
+
+  compiled_parser::compiled_parser(const compiled_parser& other)
+    : m_options{other.m_options},
+      m_delims{other.m_delims},
+      m_short_option_prefix{other.m_short_option_prefix},
+      m_long_option_prefix{other.m_long_option_prefix},
+      m_end_of_options{other.m_end_of_options},
+      m_equals{other.m_equals},
+      m_response_file_prefix{other.m_response_file_prefix},
+      m_allow_abbreviations{other.m_allow_abbreviations},
+      m_suggestions{other.m_suggestions},
+      m_tokenizer{other.m_tokenizer} {
+    // A borrowed view can share the other index, but a snapshot needs
+    // an index that points at its own copies
+    if (m_options.empty())
+      m_index = other.m_index;
+    else
+      reindex();
+  }
+
+  compiled_parser::compiled_parser(compiled_parser&& other) noexcept
+    : m_options{std::move(other.m_options)},
+      m_index{std::move(other.m_index)},
+      m_delims{std::move(other.m_delims)},
+      m_short_option_prefix{std::move(other.m_short_option_prefix)},
+      m_long_option_prefix{std::move(other.m_long_option_prefix)},
+      m_end_of_options{std::move(other.m_end_of_options)},
+      m_equals{std::move(other.m_equals)},
+      m_response_file_prefix{std::move(other.m_response_file_prefix)},
+      m_allow_abbreviations{other.m_allow_abbreviations},
+      m_suggestions{std::move(other.m_suggestions)},
+      m_tokenizer{std::move(other.m_tokenizer)} {
+    other.m_options.clear();
+    other.m_index.clear();
+  }
+
+  compiled_parser& compiled_parser::operator=(const compiled_parser& other) {
+    if (this != &other) {
+      compiled_parser copy{other};
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  compiled_parser& compiled_parser::operator=(compiled_parser&& other) noexcept {
+    if (this != &other) {
+      m_options = std::move(other.m_options);
+      m_index = std::move(other.m_index);
+      m_delims = std::move(other.m_delims);
+      m_short_option_prefix = std::move(other.m_short_option_prefix);
+      m_long_option_prefix = std::move(other.m_long_option_prefix);
+      m_end_of_options = std::move(other.m_end_of_options);
+      m_equals = std::move(other.m_equals);
+      m_response_file_prefix = std::move(other.m_response_file_prefix);
+      m_allow_abbreviations = other.m_allow_abbreviations;
+      m_suggestions = std::move(other.m_suggestions);
+      m_tokenizer = std::move(other.m_tokenizer);
+      other.m_options.clear();
+      other.m_index.clear();
+    }
+    return *this;
+  }
+
+  parser_result compiled_parser::parse(int argc, char* argv[],
+                                       bool ignore_first) const {
+    return parse(argv, argv + argc, ignore_first);
+  }
+
+  parser_result compiled_parser::parse(const std::string& cmd_line,
+                                       bool ignore_first) const {
+    parser_result result{};
+    parse_into(result, cmd_line, ignore_first);
+    return result;
+  }
+
+  void compiled_parser::parse_into(parser_result& result, int argc,
+                                   char* argv[], bool ignore_first) const {
+    parse_into(result, argv, argv + argc, ignore_first);
+  }
+
+  void compiled_parser::parse_into(parser_result& result,
+                                   const std::string& cmd_line,
+                                   bool ignore_first) const {
+    parse_status status;
+    parse_into(result, cmd_line, status, ignore_first);
+    if (!status)
+      throw status.to_error();
+  }
+
+  void compiled_parser::parse_into(parser_result& result, int argc,
+                                   char* argv[], parse_status& status,
+                                   bool ignore_first) const {
+    parse_into(result, argv, argv + argc, status, ignore_first);
+  }
+
+  void compiled_parser::parse_into(parser_result& result,
+                                   const std::string& cmd_line,
+                                   parse_status& status,
+                                   bool ignore_first) const {
+    result.clear();
+    status.clear();
+    result_sink sink{result};
+    parse_state state{status};
+    std::string buffer;
+    parse_string(cmd_line, ignore_first, buffer, state, sink);
+  }
+
+  void compiled_parser::parse_into(parser_result& result, int argc,
+                                   char* argv[], const parse_target& target,
+                                   parse_status& status,
+                                   bool ignore_first) const {
+    parse_into(result, argv, argv + argc, target, status, ignore_first);
+  }
+
+  void compiled_parser::parse_into(parser_result& result,
+                                   const std::string& cmd_line,
+                                   const parse_target& target,
+                                   parse_status& status,
+                                   bool ignore_first) const {
+    result.clear();
+    status.clear();
+    result_sink sink{result};
+    parse_state state{status};
+    state.target = &target;
+    std::string buffer;
+    parse_string(cmd_line, ignore_first, buffer, state, sink);
+  }
+
+  parser_result_ref compiled_parser::parse_ref(int argc, char* argv[],
+                                               bool ignore_first) const {
+    return parse_ref(argv, argv + argc, ignore_first);
+  }
+
+  parser_result_ref compiled_parser::parse_ref(const std::string& cmd_line,
+                                               bool ignore_first) const {
+    // The sink keeps the arguments in the result so that it does not
+    // depend on the command-line string
+    parser_result_ref result{};
+    result_ref_sink sink{result};
+    parse_status status;
+    parse_state state{status};
+    std::string buffer;
+    if (!parse_string(cmd_line, ignore_first, buffer, state, sink))
+      throw status.to_error();
+    return result;
+  }
+
+  bool compiled_parser::visit(int argc, char* argv[],
+                              const option_handler& on_option,
+                              const non_option_handler& on_non_option,
+                              parse_status& status, bool ignore_first) const {
+    return visit(argv, argv + argc, on_option, on_non_option, status,
+                 ignore_first);
+  }
+
+  bool compiled_parser::visit(const std::string& cmd_line,
+                              const option_handler& on_option,
+                              const non_option_handler& on_non_option,
+                              parse_status& status, bool ignore_first) const {
+    status.clear();
+    parse_state state{status};
+    visit_sink sink{on_option, on_non_option, state};
+    std::string buffer;
+    if (!parse_string(cmd_line, ignore_first, buffer, state, sink))
+      return false;
+    sink.flush();
+    return !state.stopped;
+  }
+
+  void compiled_parser::copy_strings(const parser& source) {
+    m_delims = source.m_delims;
+    m_short_option_prefix = source.m_short_option_prefix;
+    m_long_option_prefix = source.m_long_option_prefix;
+    m_end_of_options = source.m_end_of_options;
+    m_equals = source.m_equals;
+    m_response_file_prefix = source.m_response_file_prefix;
+    m_allow_abbreviations = source.m_allow_abbreviations;
+    m_tokenizer = tokenizer{m_delims};
+  }
+
+  void compiled_parser::reindex() {
+    m_index.clear();
+    m_index.reserve(m_options.size());
+    for (const auto& opt : m_options)
+      m_index.insert(opt);
+    m_index.optimize();
+    if (m_allow_abbreviations)
+      m_index.sort_names();
+  }
+
+  void compiled_parser::result_sink::add(const parsed_entry_ref& entry, bool) {
+    // Assign each string so that buffers left by a cleared result are
+    // reused
+    auto& dest = m_result.next_entry();
+    dest.original_text.assign(entry.original_text.data(),
+                              entry.original_text.size());
+    dest.original_without_argument.assign(entry.original_without_argument.data(),
+                                          entry.original_without_argument.size());
+    dest.is_option = entry.is_option;
+    dest.long_name.assign(entry.long_name.data(), entry.long_name.size());
+    dest.short_name = entry.short_name;
+    dest.argument.assign(entry.argument.data(), entry.argument.size());
+    dest.opt_info = entry.opt_info;
+    m_result.index_entry(m_result.size() - 1);
+  }
+
+  void compiled_parser::result_sink::add_argument(string_ref argument) {
+    // Changing the argument leaves the index valid
+    auto& entry = m_result.m_entries[m_result.m_size - 1];
+    entry.argument.assign(argument.data(), argument.size());
+    entry.original_text.push_back(' ');
+    entry.original_text.append(argument.data(), argument.size());
+  }
+
+  void compiled_parser::result_ref_sink::add(const parsed_entry_ref& entry,
+                                             bool transient_text) {
+    if (!transient_text) {
+      m_result.push_back(entry);
+      return;
+    }
+
+    // original_without_argument is a prefix of original_text, so one
+    // copy covers both
+    parsed_entry_ref copy = entry;
+    copy.original_text = m_result.store(entry.original_text);
+    copy.original_without_argument
+      = copy.original_text.substr(0, entry.original_without_argument.size());
+    m_result.push_back(copy);
+  }
+
+  void compiled_parser::result_ref_sink::add_argument(string_ref argument) {
+    auto& entry = m_result.back();
+    entry.argument = argument;
+    entry.original_text = m_result.store(entry.original_text, " ", argument);
+  }
+
+  void compiled_parser::batch_sink::add(const parsed_entry_ref& entry,
+                                       bool transient_text) {
+    if (!transient_text) {
+      m_result.push_back(entry);
+      return;
+    }
+
+    parsed_entry_ref copy = entry;
+    copy.original_text = m_result.store(entry.original_text);
+    copy.original_without_argument
+      = copy.original_text.substr(0, entry.original_without_argument.size());
+    m_result.push_back(copy);
+  }
+
+  void compiled_parser::batch_sink::add_argument(string_ref argument) {
+    m_result.add_argument(argument);
+  }
+
+  void compiled_parser::slice_sink::add(const parsed_entry_ref& entry, bool) {
+    auto& dest = m_entries[m_position++];
+    dest.original_text.assign(entry.original_text.data(),
+                              entry.original_text.size());
+    dest.original_without_argument.assign(entry.original_without_argument.data(),
+                                          entry.original_without_argument.size());
+    dest.is_option = entry.is_option;
+    dest.long_name.assign(entry.long_name.data(), entry.long_name.size());
+    dest.short_name = entry.short_name;
+    dest.argument.assign(entry.argument.data(), entry.argument.size());
+    dest.opt_info = entry.opt_info;
+  }
+
+  void compiled_parser::slice_sink::add_argument(string_ref argument) {
+    auto& entry = m_entries[m_position - 1];
+    entry.argument.assign(argument.data(), argument.size());
+    entry.original_text.push_back(' ');
+    entry.original_text.append(argument.data(), argument.size());
+  }
+
+  void compiled_parser::visit_sink::add(const parsed_entry_ref& entry, bool) {
+    flush();
+    if (!entry.is_option) {
+      if (!m_state.stopped && m_on_non_option
+          && !m_on_non_option(entry.original_text))
+        m_state.stopped = true;
+      return;
+    }
+
+    // Without any argument text, the argument may still follow
+    const option& opt = *entry.opt_info;
+    if (!opt.argument_name().empty()
+        && entry.original_text.size() == entry.original_without_argument.size())
+      m_held = &opt;
+    else
+      visit_option(opt, entry.argument);
+  }
+
+  void compiled_parser::visit_sink::add_argument(string_ref argument) {
+    const option* opt = m_held;
+    m_held = nullptr;
+    if (opt)
+      visit_option(*opt, argument);
+  }
+
+  void compiled_parser::visit_sink::flush() {
+    const option* opt = m_held;
+    m_held = nullptr;
+    if (opt)
+      visit_option(*opt, string_ref{});
+  }
+
+  void compiled_parser::visit_sink::visit_option(const option& opt,
+                                                 string_ref argument) {
+    if (!m_state.stopped && m_on_option && !m_on_option(opt, argument))
+      m_state.stopped = true;
+  }
+
+  void compiled_parser::parse_line(string_ref line, bool ignore_first,
+                                   parse_state& state, std::string& buffer,
+                                   batch_result& result) const {
+    batch_sink sink{result};
+    state.type = cl_arg_type::non_option;
+    state.pending = nullptr;
+    state.index = 0;
+
+    if (parse_string(line, ignore_first, buffer, state, sink))
+      result.end_line();
+    else
+      result.fail_line(state.status);
+  }
+
+  batch_result compiled_parser::parse_lines(const std::vector<string_ref>& lines,
+                                            const executor_type& executor,
+                                            size_type lines_per_task,
+                                            bool ignore_first) const {
+    if (lines_per_task == 0)
+      lines_per_task = 1;
+    const size_type task_count = (lines.size() + lines_per_task - 1) / lines_per_task;
+
+    // Each task fills its own part, and the parts are joined at the end
+    std::vector<batch_result> parts(task_count);
+    auto run_task = [&](size_type task) {
+      parse_status status;
+      parse_state state{status};
+      state.write_bound = false;
+      std::string buffer;
+      size_type end = std::min(lines.size(), (task + 1) * lines_per_task);
+      for (size_type i = task * lines_per_task; i != end; ++i)
+        parse_line(lines[i], ignore_first, state, buffer, parts[task]);
+    };
+
+    run_tasks(task_count, run_task, executor);
+
+    batch_result result{};
+    for (auto& part : parts)
+      result.append(std::move(part));
+    return result;
+  }
+
+  void compiled_parser::run_tasks(size_type task_count,
+                                  const std::function<void(size_type)>& run_task,
+                                  const executor_type& executor) {
+    if (!executor || task_count <= 1) {
+      for (size_type task = 0; task != task_count; ++task)
+        run_task(task);
+    } else {
+      std::mutex mutex;
+      std::condition_variable finished;
+      size_type remaining = task_count;
+      std::exception_ptr error;
+
+      size_type submitted = 0;
+      try {
+        for (; submitted != task_count; ++submitted) {
+          executor([&, submitted] {
+              try {
+                run_task(submitted);
+              } catch (...) {
+                std::lock_guard<std::mutex> lock{mutex};
+                if (!error)
+                  error = std::current_exception();
+              }
+
+              std::lock_guard<std::mutex> lock{mutex};
+              if (--remaining == 0)
+                finished.notify_all();
+            });
+        }
+      } catch (...) { // The executor failed, so wait only for the submitted tasks
+        std::lock_guard<std::mutex> lock{mutex};
+        remaining -= task_count - submitted;
+        if (!error)
+          error = std::current_exception();
+      }
+
+      std::unique_lock<std::mutex> lock{mutex};
+      finished.wait(lock, [&] { return remaining == 0; });
+      if (error)
+        std::rethrow_exception(error);
+    }
+  }
+
+  void compiled_parser::parse_args(const std::vector<string_ref>& args,
+                                   const executor_type& executor,
+                                   size_type args_per_task,
+                                   bool ignore_first, parser_result& result,
+                                   parse_status& status) const {
+    const size_type begin = ignore_first && !args.empty() ? 1 : 0;
+    if (args_per_task == 0)
+      args_per_task = 1;
+    const size_type task_count = (args.size() - begin + args_per_task - 1) / args_per_task;
+    if (!executor || task_count <= 1) {
+      parse_into(result, args.begin(), args.end(), status, ignore_first);
+      return;
+    }
+
+    // Number of leading arguments after which the sequential pass
+    // gives up trying to rejoin a task's speculative parse
+    const size_type max_rejoin = 8;
+
+    // A state is settled if the next argument is parsed the same way
+    // whatever came before it
+    auto settled = [](cl_arg_type type) {
+      return type == cl_arg_type::non_option || type == cl_arg_type::no_arg;
+    };
+
+    struct chunk {
+      size_type first; //< Position of the first argument.
+      size_type last; //< Position of one past the last argument.
+      size_type count; //< Number of speculative entries.
+      bool failed; //< Whether the speculative parse failed.
+      std::vector<std::pair<size_type, size_type>> settled_at; //< Leading positions with a settled state, and the entry count there.
+      cl_arg_type type; //< State type at the end.
+      const option* pending; //< Option waiting for an argument at the end.
+      std::string pending_name; //< Name used for that option.
+      size_type pending_index; //< Index of the argument holding that option.
+      size_type pending_offset; //< Offset of that option within its argument.
+    };
+    std::vector<chunk> chunks(task_count);
+
+    // First pass: count the entries of each task as if it started a
+    // command line
+    run_tasks(task_count, [&](size_type task) {
+        chunk& c = chunks[task];
+        c.first = begin + task * args_per_task;
+        c.last = std::min(args.size(), c.first + args_per_task);
+        c.failed = false;
+        c.settled_at.emplace_back(c.first, 0);
+
+        parse_status spec_status;
+        parse_state state{spec_status};
+        state.write_bound = false;
+        state.index = c.first;
+        count_sink sink;
+        for (size_type i = c.first; i != c.last; ++i) {
+          if (!parse_token(args[i], state, sink)) {
+            c.failed = true;
+            break;
+          }
+          if (i - c.first < max_rejoin && settled(state.type))
+            c.settled_at.emplace_back(i + 1, sink.count());
+        }
+
+        c.count = sink.count();
+        c.type = state.type;
+        c.pending = state.pending;
+        c.pending_name = std::move(state.pending_name);
+        c.pending_index = state.pending_index;
+        c.pending_offset = state.pending_offset;
+      }, executor);
+
+    // Sequential pass: carry the real state across the tasks. Where a
+    // guess was wrong, arguments are parsed in order until the state
+    // is settled at a position where the guessed state was settled
+    // too; from there on both parses agree. This divides the
+    // arguments into segments that each start in a settled state.
+    struct segment {
+      size_type first; //< Position of the first argument.
+      size_type last; //< Position of one past the last argument.
+      size_type offset; //< Position of the first entry in the result.
+    };
+    std::vector<segment> segments;
+    segments.reserve(task_count);
+
+    auto fall_back = [&] {
+      parse_into(result, args.begin(), args.end(), status, ignore_first);
+    };
+    status.clear();
+    parse_state state{status};
+    state.write_bound = false;
+    size_type total = 0;
+    for (auto& c : chunks) {
+      size_type i = c.first;
+      auto settled_it = c.settled_at.begin();
+      count_sink sink;
+      for (;;) {
+        while (settled_it != c.settled_at.end() && settled_it->first < i)
+          ++settled_it;
+        if (settled(state.type) && settled_it != c.settled_at.end()
+            && settled_it->first == i)
+          break;
+        if (i == c.last) {
+          settled_it = c.settled_at.end();
+          break;
+        }
+
+        state.index = i;
+        if (!parse_token(args[i], state, sink))
+          return fall_back();
+        ++i;
+      }
+      total += sink.count();
+
+      if (settled_it == c.settled_at.end()) {
+        segments.back().last = c.last;
+        continue;
+      }
+
+      // Errors after the point where the parses agree are real
+      if (c.failed)
+        return fall_back();
+      if (!segments.empty())
+        segments.back().last = i;
+      segments.push_back(segment{i, c.last, total});
+      total += c.count - settled_it->second;
+      state.type = c.type;
+      state.pending = c.pending;
+      state.pending_name = c.pending_name;
+      state.pending_index = c.pending_index;
+      state.pending_offset = c.pending_offset;
+    }
+    if (!finish(state))
+      return fall_back();
+
+    // Second pass: parse each segment straight into its place in the
+    // result, reusing the strings of earlier entries. The first pass
+    // has shown that these arguments parse without errors.
+    result.clear();
+    auto& entries = result.m_entries;
+    if (entries.size() < total)
+      entries.resize(total);
+    std::vector<std::vector<size_type>> option_positions(segments.size());
+    run_tasks(segments.size(), [&](size_type task) {
+        const segment& seg = segments[task];
+        parse_status seg_status;
+        parse_state seg_state{seg_status};
+        seg_state.write_bound = false;
+        seg_state.index = seg.first;
+        slice_sink sink{entries, seg.offset};
+        for (size_type i = seg.first; i != seg.last; ++i)
+          parse_token(args[i], seg_state, sink);
+
+        for (size_type i = seg.offset; i != sink.position(); ++i) {
+          if (entries[i].is_option)
+            option_positions[task].push_back(i);
+        }
+      }, executor);
+
+    // Only options need to be indexed, and only they write to bound
+    // variables, which happens in command-line order. Their arguments
+    // were already checked.
+    result.m_size = total;
+    result.m_index.links.assign(total, parser_result::npos);
+    state.write_bound = true;
+    for (const auto& positions : option_positions) {
+      for (size_type i : positions) {
+        result.index_entry(i);
+        const auto& entry = entries[i];
+        if (!entry.opt_info)
+          continue;
+        write_flag(*entry.opt_info, state);
+        if (entry.original_text.size() != entry.original_without_argument.size())
+          write_argument(*entry.opt_info, entry.argument, state);
+      }
+    }
+  }
+
+  bool compiled_parser::parse_string(string_ref cmd_line, bool ignore_first,
+                                     std::string& buffer, parse_state& state,
+                                     entry_sink& sink) const {
+    string_ref token;
+    tokenizer::size_type pos = 0;
+    bool skip = ignore_first;
+    while (m_tokenizer.next(cmd_line, pos, token, buffer)) {
+      if (skip) {
+        skip = false;
+        ++state.index;
+      } else if (!parse_token(sink.keep(token), state, sink)) {
+        return false;
+      } else if (state.stopped) {
+        return true;
+      }
+    }
+
+    return finish(state);
+  }
+
+  bool compiled_parser::parse_token(string_ref token, parse_state& state,
+                                    entry_sink& sink) const {
+    // Response files are expanded before anything else
+    if (!m_response_file_prefix.empty()
+        && option_syntax::has_prefix(token, m_response_file_prefix))
+      return parse_response_file(token.substr(m_response_file_prefix.size()),
+                                 state, sink);
+
+    state.token = token;
+
+    // If we are expecting a standalone option argument...
+    if (state.type == cl_arg_type::arg_required
+        || state.type == cl_arg_type::arg_optional) {
+      // ...then this token should be a non-option; but if the
+      // argument is required we'll interpret it that way regardless
+      if (syntax().is_non_option(token)
+          || state.type == cl_arg_type::arg_required) {
+        state.type = cl_arg_type::non_option;
+        sink.add_argument(token);
+        auto err = write_argument(*state.pending, token, state);
+        if (err != parse_errc::none)
+          return fail(state, err, 0, state.pending_name);
+        state.pending = nullptr;
+        ++state.index;
+        return true;
+      }
+
+      // Found an option, reset type and reevaluate current token
+      state.type = cl_arg_type::non_option;
+      state.pending = nullptr;
+      sink.no_argument();
+    }
+
+    if (state.type == cl_arg_type::end_indicator) { // Ignore options
+      if (state.stop_after_end_indicator && state.open_files.empty()) {
+        // Leave the rest for the caller
+        state.stopped = true;
+        return true;
+      }
+      parsed_entry_ref arg_info;
+      arg_info.original_text = token;
+      sink.add(arg_info, false);
+    } else if (state.stop_at_non_option && state.open_files.empty()
+               && syntax().is_non_option(token)) {
+      // Leave the argument for the caller
+      state.stopped = true;
+      return true;
+    } else if (!parse_argument(token, state, sink)) { // Regular argument
+      return false;
+    }
+
+    ++state.index;
+    return true;
+  }
+
+  bool compiled_parser::parse_response_file(string_ref path,
+                                            parse_state& state,
+                                            entry_sink& sink) const {
+    // Split with the same rules as utility::split
+    static const tokenizer file_tokenizer{};
+
+    mapped_file file{path.str()};
+    if (!file.is_open())
+      return fail(state, parse_errc::unreadable_file, 0, path);
+
+    // A file that is already open would be expanded forever
+    auto& open_files = state.open_files;
+    if (std::find(open_files.begin(), open_files.end(), file.id()) != open_files.end())
+      return fail(state, parse_errc::recursive_file, 0, path);
+    open_files.push_back(file.id());
+
+    // Arguments point into the mapping, which goes away on return, so
+    // the sink must keep whatever it holds on to
+    const string_ref contents = file.contents();
+    string_ref token;
+    tokenizer::size_type pos = 0;
+    std::string buffer;
+    while (file_tokenizer.next(contents, pos, token, buffer)) {
+      if (!parse_token(sink.keep(token), state, sink)) {
+        open_files.pop_back();
+        return false;
+      }
+      if (state.stopped)
+        break;
+    }
+
+    open_files.pop_back();
+    return true;
+  }
+
+  bool compiled_parser::finish(parse_state& state) const {
+    // Make sure we don't still need a mandatory argument
+    if (state.type == cl_arg_type::arg_required) {
+      state.status.set(parse_errc::missing_argument, state.pending_index,
+                       state.pending_offset, state.pending_name);
+      return false;
+    }
+    return true;
+  }
+
+  bool compiled_parser::fail(parse_state& state, parse_errc error,
+                             string_ref::size_type offset,
+                             string_ref prefix, string_ref name) {
+    state.status.set(error, state.index, offset, prefix, name);
+    return false;
+  }
+
+  bool compiled_parser::parse_argument(string_ref argument,
+                                       parse_state& state,
+                                       entry_sink& sink) const {
+    using token_kind = option_syntax::token_kind;
+    const auto parts = syntax().split(argument);
+    const string_ref option_specifier = parts.specifier;
+    const string_ref option_argument = parts.argument;
+    const bool assignment_found = parts.has_argument;
+
+    // Check for end-of-option marker and bad syntax like -= and --=
+    if (parts.kind == token_kind::end_of_options) {
+      state.type = cl_arg_type::end_indicator;
+      return true;
+    } else if (parts.kind == token_kind::bad_assignment) {
+      return fail(state, parse_errc::invalid_option, 0,
+                  option_specifier, m_equals);
+    }
+
+    // Check option type
+    parsed_entry_ref arg_info;
+    if (parts.kind == token_kind::long_option) {
+      // Extract option name and look up option info
+      string_ref option_name = option_specifier.substr(m_long_option_prefix.size());
+      const option* opt = find_option(option_name);
+      if (!opt && m_allow_abbreviations) {
+        // An exact match always wins; otherwise the prefix must be
+        // unique
+        auto matches = m_index.find_prefix(option_name.data(),
+                                           option_name.size());
+        if (matches.second - matches.first == 1) {
+          opt = *matches.first;
+        } else if (matches.first != matches.second) {
+          fail(state, parse_errc::ambiguous_option, 0, option_specifier);
+          for (auto it = matches.first; it != matches.second; ++it)
+            state.status.add_candidate(m_long_option_prefix, (*it)->long_name());
+          return false;
+        }
+      }
+      if (!opt) {
+        fail(state, parse_errc::invalid_option, 0, option_specifier);
+        if (m_suggestions)
+          state.status.set_suggestions(m_suggestions, m_long_option_prefix.size());
+        return false;
+      }
+      arg_info.opt_info = opt;
+
+      // Does this option take an argument?
+      if (!opt->argument_name().empty()) {
+        if (!assignment_found) { // No arg was found, caller should look for it
+          if (opt->is_argument_required())
+            state.type = cl_arg_type::arg_required;
+          else
+            state.type = cl_arg_type::arg_optional;
+          state.pending = opt;
+          state.pending_name.assign(option_specifier.data(),
+                                    option_specifier.size());
+          state.pending_index = state.index;
+          state.pending_offset = 0;
+        } else { // Found an argument
+          state.type = cl_arg_type::no_arg; // Caller should not look for argument
+          arg_info.argument = option_argument;
+        }
+      } else { // Does not take an argument
+        if (assignment_found) // Found an argument where there should be none
+          return fail(state, parse_errc::unexpected_argument,
+                      option_specifier.size(), option_specifier);
+        state.type = cl_arg_type::no_arg;
+      }
+      arg_info.original_text = argument;
+      arg_info.original_without_argument = option_specifier;
+      arg_info.is_option = true;
+      arg_info.long_name = opt->long_name();
+      arg_info.short_name = opt->short_name();
+      if (assignment_found) {
+        auto err = write_argument(*opt, option_argument, state);
+        if (err != parse_errc::none)
+          return fail(state, err, option_argument.data() - argument.data(),
+                      option_specifier);
+      }
+      write_flag(*opt, state);
+      sink.add(arg_info, false);
+    } else if (parts.kind == token_kind::short_options) { // Short options
+      return parse_short_option_group(option_specifier, option_argument,
+                                      assignment_found, state, sink);
+    } else {
+      // If we get here, this argument is not an option
+      state.type = cl_arg_type::non_option;
+      arg_info.original_text = argument;
+      arg_info.is_option = false;
+      sink.add(arg_info, false);
+    }
+    return true;
+  }
+
+  bool compiled_parser::parse_short_option_group(string_ref specifier,
+                                                 string_ref argument,
+                                                 bool has_arg,
+                                                 parse_state& state,
+                                                 entry_sink& sink) const {
+    using sz_t = string_ref::size_type;
+
+    // Since the specifier and argument come from the same token, the
+    // text for any option in the group is the short option prefix
+    // followed by a slice of that token
+    const sz_t prefix_size = m_short_option_prefix.size();
+    const string_ref token{specifier.data(), has_arg
+        ? static_cast<sz_t>(argument.end() - specifier.begin())
+        : specifier.size()};
+    const string_ref short_names = specifier.substr(prefix_size);
+
+    for (sz_t pos = 0; pos != short_names.size(); ++pos) {
+      const char name = short_names[pos];
+      const bool is_last = pos + 1 == short_names.size();
+      const string_ref name_text = short_names.substr(pos, 1);
+
+      // Look up option info
+      const option* opt = find_option(name);
+      if (!opt)
+        return fail(state, parse_errc::invalid_option, prefix_size + pos,
+                    m_short_option_prefix, name_text);
+
+      // If we make it here with an argument, the option must take one
+      const bool takes_arg = !opt->argument_name().empty();
+      if (is_last && has_arg && !takes_arg) {
+        write_flag(*opt, state);
+        return fail(state, parse_errc::unexpected_argument, specifier.size(),
+                    m_short_option_prefix, name_text);
+      }
+
+      // An option that takes an argument uses up the rest of the token
+      string_ref tail = token.substr(prefix_size + pos, takes_arg ? string_ref::npos : 1);
+      string_ref text = tail;
+      bool transient = false;
+      if (pos != 0) {
+        state.scratch.assign(m_short_option_prefix);
+        state.scratch.append(tail.data(), tail.size());
+        text = state.scratch;
+        transient = true;
+      } else {
+        text = token.substr(0, prefix_size + tail.size());
+      }
+
+      parsed_entry_ref arg_info;
+      arg_info.original_text = text;
+      arg_info.original_without_argument = text.substr(0, prefix_size + 1);
+      arg_info.is_option = true;
+      arg_info.long_name = opt->long_name();
+      arg_info.short_name = name;
+      arg_info.opt_info = opt;
+      write_flag(*opt, state);
+
+      // Check if option takes an argument
+      if (takes_arg) {
+        string_ref opt_arg;
+        if (!is_last) {
+          // This isn't the last option, so the rest of the string is
+          // an argument (if an assignment symbol was found, it is
+          // actually part of the argument)
+          opt_arg = tail.substr(1);
+          state.type = cl_arg_type::no_arg;
+        } else if (has_arg) {
+          // This is the last option and its argument was assigned
+          opt_arg = argument;
+          state.type = cl_arg_type::no_arg;
+        } else {
+          // This is the last option and it needs an argument
+          if (opt->is_argument_required())
+            state.type = cl_arg_type::arg_required;
+          else
+            state.type = cl_arg_type::arg_optional;
+          state.pending = opt;
+          state.pending_name.assign(text.data(), prefix_size + 1);
+          state.pending_index = state.index;
+          state.pending_offset = prefix_size + pos;
+        }
+
+        if (state.type == cl_arg_type::no_arg) {
+          arg_info.argument = opt_arg;
+          auto err = write_argument(*opt, opt_arg, state);
+          if (err != parse_errc::none)
+            return fail(state, err, opt_arg.data() - token.data(),
+                        m_short_option_prefix, name_text);
+        }
+        sink.add(arg_info, transient);
+        break;
+      }
+
+      sink.add(arg_info, transient);
+      state.type = cl_arg_type::no_arg;
+      if (state.stopped)
+        break;
+    } // End for loop
+    return true;
+  }
+
+} // End namespace
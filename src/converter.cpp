@@ -0,0 +1,270 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for the non-template parts of `converter`.
+ */
+
+#include <optionpp/converter.hpp>
+
+#include <cmath>
+#include <system_error>
+#include <optionpp/charconv.hpp>
+
+namespace optionpp {
+
+  namespace {
+
+    /**
+     * @brief Multiply two unsigned numbers, checking for overflow.
+     * @param a First factor.
+     * @param b Second factor.
+     * @param product Receives the product if there is no overflow.
+     * @return False if the product does not fit.
+     */
+    bool checked_multiply(unsigned long long a, unsigned long long b,
+                          unsigned long long& product) noexcept {
+      if (a != 0 && b > std::numeric_limits<unsigned long long>::max() / a)
+        return false;
+      product = a * b;
+      return true;
+    }
+
+    /**
+     * @brief Compare a unit suffix with an expected spelling, ignoring
+     *        case.
+     * @param unit The suffix.
+     * @param expected The expected spelling, in lower case.
+     * @return True if they match.
+     */
+    bool unit_is(string_ref unit, const char* expected) noexcept {
+      string_ref::size_type i = 0;
+      for (; i != unit.size() && expected[i] != '\0'; ++i) {
+        char c = unit[i];
+        if (c >= 'A' && c <= 'Z')
+          c = static_cast<char>(c - 'A' + 'a');
+        if (c != expected[i])
+          return false;
+      }
+      return i == unit.size() && expected[i] == '\0';
+    }
+
+  } // End anonymous namespace
+
+  parse_errc convert_integer(string_ref argument, long long& value,
+                             long long min, long long max) noexcept {
+    const char* first = argument.data();
+    const char* last = first + argument.size();
+
+    long long result = 0;
+    auto conv = from_chars(first, last, result);
+    if (conv.ec == std::errc::invalid_argument || conv.ptr != last)
+      return parse_errc::not_an_integer;
+    if (conv.ec == std::errc::result_out_of_range || result < min || result > max)
+      return parse_errc::out_of_range;
+    value = result;
+    return parse_errc::none;
+  }
+
+  parse_errc convert_unsigned(string_ref argument, unsigned long long& value,
+                              unsigned long long max) noexcept {
+    const char* first = argument.data();
+    const char* last = first + argument.size();
+
+    // Read negative numbers as signed so that they get their own error
+    if (first != last && *first == '-') {
+      long long negative = 0;
+      auto err = convert_integer(argument, negative,
+                                 std::numeric_limits<long long>::min(),
+                                 std::numeric_limits<long long>::max());
+      if (err != parse_errc::none)
+        return err;
+      if (negative < 0)
+        return parse_errc::negative_argument;
+      value = 0;
+      return parse_errc::none;
+    }
+
+    unsigned long long result = 0;
+    auto conv = from_chars(first, last, result);
+    if (conv.ec == std::errc::invalid_argument || conv.ptr != last)
+      return parse_errc::not_an_integer;
+    if (conv.ec == std::errc::result_out_of_range || result > max)
+      return parse_errc::out_of_range;
+    value = result;
+    return parse_errc::none;
+  }
+
+  parse_errc convert_floating(string_ref argument, double& value,
+                              double max) noexcept {
+    const char* first = argument.data();
+    const char* last = first + argument.size();
+
+    double result = 0;
+    auto conv = from_chars(first, last, result);
+    if (conv.ec == std::errc::invalid_argument || conv.ptr != last)
+      return parse_errc::not_a_number;
+    if (conv.ec == std::errc::result_out_of_range
+        || (std::isfinite(result) && std::fabs(result) > max))
+      return parse_errc::out_of_range;
+    value = result;
+    return parse_errc::none;
+  }
+
+  parse_errc convert_byte_size(string_ref argument,
+                               unsigned long long& value) noexcept {
+    const char* first = argument.data();
+    const char* last = first + argument.size();
+    if (first != last && *first == '-')
+      return parse_errc::negative_argument;
+
+    // Read the number as an integer if possible, so that sizes near
+    // the top of the range stay exact
+    unsigned long long integer = 0;
+    double real = 0;
+    auto int_conv = from_chars(first, last, integer);
+    auto real_conv = from_chars(first, last, real);
+    if (real_conv.ec == std::errc::invalid_argument)
+      return parse_errc::not_a_number;
+    const bool is_integer = int_conv.ec != std::errc::invalid_argument
+      && int_conv.ptr == real_conv.ptr;
+    if (is_integer && int_conv.ec == std::errc::result_out_of_range)
+      return parse_errc::out_of_range;
+    if (!is_integer && !std::isfinite(real))
+      return parse_errc::not_a_number;
+
+    // Find the multiplier
+    string_ref unit{real_conv.ptr, static_cast<string_ref::size_type>(last - real_conv.ptr)};
+    unsigned long long multiplier = 1;
+    if (!unit.empty() && !unit_is(unit, "b")) {
+      static const char prefixes[] = "kmgtpe";
+      char prefix = unit[0];
+      if (prefix >= 'A' && prefix <= 'Z')
+        prefix = static_cast<char>(prefix - 'A' + 'a');
+
+      int power = 0;
+      while (prefixes[power] != '\0' && prefixes[power] != prefix)
+        ++power;
+      if (prefixes[power] == '\0')
+        return parse_errc::invalid_value;
+
+      string_ref rest = unit.substr(1);
+      if (!rest.empty() && !unit_is(rest, "b") && !unit_is(rest, "i")
+          && !unit_is(rest, "ib"))
+        return parse_errc::invalid_value;
+      multiplier = 1ULL << (10 * (power + 1));
+    }
+
+    if (is_integer) {
+      if (!checked_multiply(integer, multiplier, value))
+        return parse_errc::out_of_range;
+      return parse_errc::none;
+    }
+
+    const long double bytes = std::floor(static_cast<long double>(real) * multiplier + 0.5L);
+    if (!(bytes < 18446744073709551616.0L))
+      return parse_errc::out_of_range;
+    value = static_cast<unsigned long long>(bytes);
+    return parse_errc::none;
+  }
+
+  parse_errc convert_duration(string_ref argument,
+                              std::intmax_t num, std::intmax_t den,
+                              bool integral, long long& count,
+                              long double& real) noexcept {
+    const char* first = argument.data();
+    const char* last = first + argument.size();
+
+    long long integer = 0;
+    double number = 0;
+    auto int_conv = from_chars(first, last, integer);
+    auto real_conv = from_chars(first, last, number);
+    if (real_conv.ec == std::errc::invalid_argument)
+      return parse_errc::not_a_number;
+    const bool is_integer = int_conv.ec == std::errc{}
+      && int_conv.ptr == real_conv.ptr;
+
+    // Look up the unit, in seconds
+    struct unit_info {
+      const char* name;
+      std::intmax_t num;
+      std::intmax_t den;
+    };
+    static const unit_info units[] = {
+      {"ns", 1, 1000000000}, {"us", 1, 1000000}, {"ms", 1, 1000},
+      {"s", 1, 1}, {"m", 60, 1}, {"min", 60, 1}, {"h", 3600, 1},
+      {"d", 86400, 1}
+    };
+    string_ref unit{real_conv.ptr, static_cast<string_ref::size_type>(last - real_conv.ptr)};
+    std::intmax_t unit_num = num;
+    std::intmax_t unit_den = den;
+    if (!unit.empty()) {
+      const unit_info* info = nullptr;
+      for (const auto& u : units) {
+        if (unit == u.name)
+          info = &u;
+      }
+      if (!info)
+        return parse_errc::invalid_value;
+      unit_num = info->num;
+      unit_den = info->den;
+    }
+
+    // Scale from the given unit to the target unit: when that is an
+    // integer factor, integer counts are converted exactly
+    unsigned long long scale_num = 0, scale_den = 0;
+    if (integral && is_integer
+        && checked_multiply(static_cast<unsigned long long>(unit_num),
+                            static_cast<unsigned long long>(den), scale_num)
+        && checked_multiply(static_cast<unsigned long long>(unit_den),
+                            static_cast<unsigned long long>(num), scale_den)
+        && scale_num % scale_den == 0) {
+      const unsigned long long factor = scale_num / scale_den;
+      const unsigned long long magnitude = integer < 0
+        ? 0ULL - static_cast<unsigned long long>(integer)
+        : static_cast<unsigned long long>(integer);
+      unsigned long long scaled = 0;
+      const unsigned long long limit = integer < 0
+        ? static_cast<unsigned long long>(std::numeric_limits<long long>::max()) + 1
+        : static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+      if (!checked_multiply(magnitude, factor, scaled) || scaled > limit)
+        return parse_errc::out_of_range;
+      count = integer < 0 ? static_cast<long long>(0ULL - scaled)
+        : static_cast<long long>(scaled);
+      return parse_errc::none;
+    }
+
+    if (real_conv.ec == std::errc::result_out_of_range)
+      return parse_errc::out_of_range;
+    const long double value = static_cast<long double>(number) * unit_num / unit_den
+      * den / num;
+    if (!integral) {
+      real = value;
+      return parse_errc::none;
+    }
+
+    const long double rounded = std::floor(value + 0.5L);
+    if (!(rounded >= -9223372036854775808.0L && rounded < 9223372036854775808.0L))
+      return parse_errc::out_of_range;
+    count = static_cast<long long>(rounded);
+    return parse_errc::none;
+  }
+
+} // End namespace
@@ -0,0 +1,168 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `incremental_parser` class implementation.
+ */
+
+#include <optionpp/incremental_parser.hpp>
+
+namespace optionpp {
+
+  incremental_parser::incremental_parser(const compiled_parser& source,
+                                         entry_handler handler,
+                                         bool ignore_first)
+    : m_parser{&source}, m_ignore_first{ignore_first},
+      m_skip_next{ignore_first}, m_state{m_status},
+      m_buffer{std::move(handler)} {}
+
+  void incremental_parser::feed(string_ref argument) {
+    if (!step(argument))
+      throw m_status.to_error();
+  }
+
+  bool incremental_parser::feed(string_ref argument, parse_status& status) {
+    if (!step(argument)) {
+      status = m_status;
+      return false;
+    }
+    status.clear();
+    return true;
+  }
+
+  void incremental_parser::finish() {
+    if (!step_finish())
+      throw m_status.to_error();
+  }
+
+  bool incremental_parser::finish(parse_status& status) {
+    if (!step_finish()) {
+      status = m_status;
+      return false;
+    }
+    status.clear();
+    return true;
+  }
+
+  void incremental_parser::reset() noexcept {
+    m_skip_next = m_ignore_first;
+    m_failed = false;
+    m_status.clear();
+    m_state.type = compiled_parser::cl_arg_type::non_option;
+    m_state.pending = nullptr;
+    m_state.index = 0;
+    m_buffer.discard();
+  }
+
+  bool incremental_parser::step(string_ref argument) {
+    if (m_failed)
+      return false;
+
+    if (m_skip_next) {
+      m_skip_next = false;
+      ++m_state.index;
+      return true;
+    }
+
+    if (!m_parser->parse_token(argument, m_state, m_buffer)) {
+      m_buffer.discard();
+      m_failed = true;
+      return false;
+    }
+
+    // An entry waiting for its argument must outlive this argument
+    if (waiting_for_argument())
+      m_buffer.keep();
+    else
+      m_buffer.flush();
+    return true;
+  }
+
+  bool incremental_parser::step_finish() {
+    if (m_failed)
+      return false;
+
+    if (!m_parser->finish(m_state)) {
+      m_buffer.discard();
+      m_failed = true;
+      return false;
+    }
+
+    m_buffer.flush();
+    reset();
+    return true;
+  }
+
+  void incremental_parser::entry_buffer::add(const parsed_entry_ref& entry,
+                                             bool transient_text) {
+    // The previous entry is complete once another one starts
+    flush();
+    m_entry = entry;
+    m_has_entry = true;
+
+    // Transient text is overwritten by the next option in the group
+    if (transient_text)
+      keep();
+  }
+
+  void incremental_parser::entry_buffer::add_argument(string_ref argument) {
+    const auto name_size = m_entry.original_without_argument.size();
+    m_joined.assign(m_entry.original_text.data(), m_entry.original_text.size());
+    m_joined.push_back(' ');
+    m_joined.append(argument.data(), argument.size());
+
+    string_ref joined{m_joined};
+    m_entry.original_text = joined;
+    m_entry.original_without_argument = joined.substr(0, name_size);
+    m_entry.argument = joined.substr(joined.size() - argument.size());
+  }
+
+  string_ref incremental_parser::entry_buffer::keep(string_ref token) {
+    keep();
+    m_token.assign(token.data(), token.size());
+    return m_token;
+  }
+
+  void incremental_parser::entry_buffer::flush() {
+    if (!m_has_entry)
+      return;
+
+    m_has_entry = false;
+    if (m_handler)
+      m_handler(m_entry);
+  }
+
+  void incremental_parser::entry_buffer::keep() {
+    if (!m_has_entry)
+      return;
+
+    // Any argument is at the end of the text, and the names point
+    // into the option table
+    const auto name_size = m_entry.original_without_argument.size();
+    const auto arg_size = m_entry.argument.size();
+    m_text.assign(m_entry.original_text.data(), m_entry.original_text.size());
+    string_ref text{m_text};
+    m_entry.original_text = text;
+    m_entry.original_without_argument = text.substr(0, name_size);
+    if (arg_size != 0)
+      m_entry.argument = text.substr(text.size() - arg_size);
+  }
+
+} // End namespace
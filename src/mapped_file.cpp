@@ -0,0 +1,236 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `mapped_file` implementation.
+ */
+
+#include <optionpp/mapped_file.hpp>
+
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <iterator>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace optionpp {
+
+#if defined(_WIN32)
+
+  bool mapped_file::open(const std::string& path) {
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+
+    BY_HANDLE_FILE_INFORMATION info;
+    if (!GetFileInformationByHandle(file, &info)
+        || (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+      CloseHandle(file);
+      return false;
+    }
+    m_id.device = info.dwVolumeSerialNumber;
+    m_id.file = (static_cast<unsigned long long>(info.nFileIndexHigh) << 32)
+      | info.nFileIndexLow;
+    const unsigned long long size
+      = (static_cast<unsigned long long>(info.nFileSizeHigh) << 32)
+      | info.nFileSizeLow;
+
+    // Empty files cannot be mapped, but there is nothing to read
+    if (size == 0) {
+      CloseHandle(file);
+      m_open = true;
+      return true;
+    }
+
+    // The view stays valid after both handles are closed
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY,
+                                        0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+      : nullptr;
+    if (mapping)
+      CloseHandle(mapping);
+    CloseHandle(file);
+
+    if (!view)
+      return read(path);
+
+    m_data = static_cast<const char*>(view);
+    m_size = static_cast<size_type>(size);
+    m_mapped = true;
+    m_open = true;
+    return true;
+  }
+
+  void mapped_file::close() noexcept {
+    if (m_mapped)
+      UnmapViewOfFile(m_data);
+    m_data = nullptr;
+    m_size = 0;
+    m_id = id_type{};
+    m_open = false;
+    m_mapped = false;
+    m_buffer.clear();
+  }
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+  bool mapped_file::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+      ::close(fd);
+      return false;
+    }
+    m_id.device = static_cast<unsigned long long>(info.st_dev);
+    m_id.file = static_cast<unsigned long long>(info.st_ino);
+
+    // Pipes are read instead, from the same descriptor since a pipe's
+    // contents are gone once its last reader closes it; directories
+    // and devices are not response files
+    if (!S_ISREG(info.st_mode)) {
+      bool ok = S_ISFIFO(info.st_mode);
+      char chunk[4096];
+      while (ok) {
+        ssize_t count = ::read(fd, chunk, sizeof(chunk));
+        if (count > 0)
+          m_buffer.append(chunk, static_cast<std::size_t>(count));
+        else if (count == 0)
+          break;
+        else if (errno != EINTR)
+          ok = false;
+      }
+      ::close(fd);
+      if (!ok) {
+        close();
+        return false;
+      }
+
+      m_data = m_buffer.data();
+      m_size = m_buffer.size();
+      m_open = true;
+      return true;
+    }
+
+    // Empty files cannot be mapped, but there is nothing to read
+    if (info.st_size == 0) {
+      ::close(fd);
+      m_open = true;
+      return true;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    const auto size = static_cast<size_type>(info.st_size);
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+      return read(path);
+
+#ifdef POSIX_MADV_SEQUENTIAL
+    posix_madvise(view, size, POSIX_MADV_SEQUENTIAL);
+#endif
+
+    m_data = static_cast<const char*>(view);
+    m_size = size;
+    m_mapped = true;
+    m_open = true;
+    return true;
+  }
+
+  void mapped_file::close() noexcept {
+    if (m_mapped)
+      munmap(const_cast<char*>(m_data), m_size);
+    m_data = nullptr;
+    m_size = 0;
+    m_id = id_type{};
+    m_open = false;
+    m_mapped = false;
+    m_buffer.clear();
+  }
+
+#else
+
+  bool mapped_file::open(const std::string& path) {
+    close();
+
+    // Without a file system API, the path is the best identity we have
+    m_id.file = std::hash<std::string>{}(path);
+    return read(path);
+  }
+
+  void mapped_file::close() noexcept {
+    m_data = nullptr;
+    m_size = 0;
+    m_id = id_type{};
+    m_open = false;
+    m_buffer.clear();
+  }
+
+#endif
+
+  bool mapped_file::read(const std::string& path) {
+    std::ifstream file{path, std::ios::in | std::ios::binary};
+    if (!file)
+      return false;
+
+    // Some standard libraries throw when a read fails (for example,
+    // on a directory), even though the stream has no exception mask
+    try {
+      m_buffer.assign(std::istreambuf_iterator<char>{file},
+                      std::istreambuf_iterator<char>{});
+    } catch (const std::ios_base::failure&) {
+      m_buffer.clear();
+      return false;
+    }
+    if (file.bad()) {
+      m_buffer.clear();
+      return false;
+    }
+
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    m_open = true;
+    return true;
+  }
+
+} // End namespace
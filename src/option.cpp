@@ -28,65 +28,83 @@
 
 namespace optionpp {
 
-  option::option(const std::string& long_name, char short_name,
-                 const std::string& description,
-                 const std::string& arg_name, bool arg_required) :
-    m_long_name{long_name}, m_short_name{short_name},
-    m_desc{description}, m_arg_name{arg_name},
-    m_arg_required{arg_required} {}
-
-  option& option::argument(const std::string& name, bool required) {
-    m_arg_name = name;
+  option::option(string_ref long_name, char short_name,
+                 string_ref description,
+                 string_ref arg_name, bool arg_required) :
+    m_short_name{short_name}, m_arg_required{arg_required} {
+    set_text(m_long_name, long_name);
+    set_text(m_desc, description);
+    set_text(m_arg_name, arg_name);
+  }
+
+  option& option::argument(string_ref name, bool required) {
+    set_text(m_arg_name, name);
     m_arg_required = required;
+    m_tracker.notify();
 
     return *this;
   }
 
   option& option::bind_bool(bool* var) noexcept {
     m_is_option_set = var;
+    m_flag_target_type = nullptr;
     if (var)
       *var = false;
+    m_tracker.notify();
     return *this;
   }
 
-  option& option::bind_string(std::string* var) noexcept {
-    if (var && m_arg_name.empty()) {
-      m_arg_name = "STRING";
-      m_arg_required = true;
-    }
-    m_arg_type = string_arg;
-    m_bound_variable = var;
-    return *this;
+  option& option::bind_string(std::string* var) {
+    return bind(var);
   }
 
-  option& option::bind_int(int* var) noexcept {
-    if (var && m_arg_name.empty()) {
-      m_arg_name = "INTEGER";
-      m_arg_required = true;
-    }
-    m_arg_type = int_arg;
-    m_bound_variable = var;
-    return *this;
+  option& option::bind_int(int* var) {
+    return bind(var);
   }
 
-  option& option::bind_uint(unsigned int* var) noexcept {
-    if (var && m_arg_name.empty()) {
-      m_arg_name = "INTEGER";
-      m_arg_required = true;
-    }
-    m_arg_type = uint_arg;
-    m_bound_variable = var;
-    return *this;
+  option& option::bind_uint(unsigned int* var) {
+    return bind(var);
   }
 
-  option& option::bind_double(double* var) noexcept {
-    if (var && m_arg_name.empty()) {
-      m_arg_name = "NUMBER";
-      m_arg_required = true;
+  option& option::bind_double(double* var) {
+    return bind(var);
+  }
+
+  void option::set_text(text_pool::span& field, string_ref value) {
+    if (value.empty()) {
+      field = text_pool::span{0, 0};
+      return;
     }
-    m_arg_type = double_arg;
-    m_bound_variable = var;
-    return *this;
+
+    // Outside a parser, reuse our own pool unless it is shared or
+    // mostly holds strings we no longer refer to
+    std::shared_ptr<text_pool> pool;
+    if (change_tracker::change_log* log = m_tracker.log())
+      pool = log->pool();
+    else if (m_text && m_text.use_count() == 1) {
+      std::size_t live = m_long_name.size + m_desc.size + m_arg_name.size;
+      if (m_text->size() <= 4 * live + 256)
+        pool = m_text;
+    }
+    if (!pool)
+      pool = std::make_shared<text_pool>();
+
+    if (pool != m_text)
+      move_text(pool);
+    field = m_text->store(value);
+  }
+
+  void option::move_text(const std::shared_ptr<text_pool>& pool) {
+    if (pool == m_text)
+      return;
+    text_pool::span new_long_name = pool->store(long_name());
+    text_pool::span new_desc = pool->store(description());
+    text_pool::span new_arg_name = pool->store(argument_name());
+
+    m_text = pool;
+    m_long_name = new_long_name;
+    m_desc = new_desc;
+    m_arg_name = new_arg_name;
   }
 
   void option::write_bool(bool value) const noexcept {
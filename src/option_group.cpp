@@ -33,9 +33,27 @@ namespace optionpp {
                                    const std::string& description,
                                    const std::string& arg_name,
                                    bool arg_required) {
-    m_options.emplace_back(long_name, short_name, description,
-                           arg_name, arg_required);
-    return m_options.back();
+    const option* old_data = m_options.data();
+    m_options.emplace_back();
+
+    // Attach the option first, so that its strings go straight into
+    // the parser's pool
+    option& opt = m_options.back();
+    opt.m_tracker.attach(m_tracker.log());
+    try {
+      opt.set_text(opt.m_long_name, long_name);
+      opt.set_text(opt.m_desc, description);
+      opt.set_text(opt.m_arg_name, arg_name);
+    } catch (...) {
+      m_options.pop_back();
+      track_new_options(old_data, m_options.size());
+      throw;
+    }
+    opt.m_short_name = short_name;
+    opt.m_arg_required = arg_required;
+
+    track_new_options(old_data, m_options.size() - 1);
+    return opt;
   }
 
   option& option_group::operator[](const std::string long_name) {
@@ -81,4 +99,43 @@ namespace optionpp {
               });
   }
 
+  void option_group::attach(change_tracker::change_log* log) noexcept {
+    m_tracker.attach(log);
+    for (auto& opt : m_options)
+      opt.m_tracker.attach(log);
+  }
+
+  void option_group::track_new_options(const option* old_data,
+                                       size_type first) noexcept {
+    change_tracker::change_log* log = m_tracker.log();
+    if (!log)
+      return;
+
+    if (m_options.data() != old_data) {
+      for (auto& opt : m_options)
+        opt.m_tracker.attach(log);
+      m_tracker.notify_moved();
+    } else {
+      for (size_type i = first; i < m_options.size(); ++i) {
+        m_options[i].m_tracker.attach(log);
+        m_tracker.notify_renamed(m_options[i]);
+      }
+    }
+    adopt_text(first);
+  }
+
+  void option_group::adopt_text(size_type first) noexcept {
+    change_tracker::change_log* log = m_tracker.log();
+    if (!log)
+      return;
+
+    // An option left in its own pool still works, so running out of
+    // memory here is not an error
+    try {
+      const std::shared_ptr<text_pool>& pool = log->pool();
+      for (size_type i = first; i < m_options.size(); ++i)
+        m_options[i].move_text(pool);
+    } catch (...) {}
+  }
+
 } // End namespace
@@ -0,0 +1,268 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `option_index` class implementation.
+ */
+
+#include <optionpp/option_index.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <optionpp/string_pool.hpp>
+
+namespace optionpp {
+
+  const std::uint32_t option_index::npos;
+
+  void option_index::clear() noexcept {
+    m_options.clear();
+    m_hashes.clear();
+    m_table.clear();
+    m_slots.clear();
+    m_displacements.clear();
+    m_short_names.fill(nullptr);
+    m_short_count = 0;
+    m_sorted_ids.clear();
+    m_names.clear();
+  }
+
+  void option_index::reserve(size_type count) {
+    m_options.reserve(count);
+    m_hashes.reserve(count);
+    if (2 * count > m_table.size())
+      rehash(count);
+  }
+
+  void option_index::insert(const option& opt) {
+    char short_name = opt.short_name();
+    if (short_name != '\0') {
+      auto& entry = m_short_names[static_cast<unsigned char>(short_name)];
+      if (!entry) {
+        entry = &opt;
+        ++m_short_count;
+      }
+    }
+
+    string_ref long_name = opt.long_name();
+    if (long_name.empty())
+      return;
+
+    // A name seen before keeps pointing to the first option
+    std::uint32_t h = string_pool::hash(long_name.data(), long_name.size());
+    if (2 * (m_options.size() + 1) > m_table.size())
+      rehash(m_options.size() + 1);
+    size_type pos = probe(long_name, h);
+    if (m_table[pos].id != npos)
+      return;
+
+    m_options.push_back(&opt);
+    try {
+      m_hashes.push_back(h);
+    } catch (...) {
+      m_options.pop_back();
+      throw;
+    }
+    m_table[pos] = slot{h, static_cast<std::uint32_t>(m_options.size() - 1)};
+    m_slots.clear();
+    m_displacements.clear();
+  }
+
+  void option_index::sort_names() {
+    m_sorted_ids.resize(m_options.size());
+    for (size_type i = 0; i < m_sorted_ids.size(); ++i)
+      m_sorted_ids[i] = static_cast<std::uint32_t>(i);
+    std::sort(m_sorted_ids.begin(), m_sorted_ids.end(),
+              [this](std::uint32_t a, std::uint32_t b) {
+                return m_options[a]->long_name() < m_options[b]->long_name();
+              });
+
+    m_names.resize(m_sorted_ids.size());
+    for (size_type i = 0; i < m_names.size(); ++i)
+      m_names[i] = m_options[m_sorted_ids[i]];
+  }
+
+  auto option_index::find_prefix(const char* prefix, size_type length) const
+    -> std::pair<name_iterator, name_iterator> {
+    // Truncated to the length of the prefix, the sorted names are
+    // still in order, so the matches form one contiguous run
+    auto compare = [this, length](std::uint32_t id, const char* str) {
+      string_ref name = m_options[id]->long_name();
+      size_type n = std::min(name.size(), length);
+      int cmp = std::memcmp(name.data(), str, n);
+      return cmp < 0 || (cmp == 0 && n < length);
+    };
+    auto compare_reverse = [this, length](const char* str, std::uint32_t id) {
+      string_ref name = m_options[id]->long_name();
+      size_type n = std::min(name.size(), length);
+      return std::memcmp(str, name.data(), n) < 0;
+    };
+
+    auto first = std::lower_bound(m_sorted_ids.begin(), m_sorted_ids.end(),
+                                  prefix, compare);
+    auto last = std::upper_bound(first, m_sorted_ids.end(), prefix,
+                                 compare_reverse);
+    return {m_names.begin() + (first - m_sorted_ids.begin()),
+            m_names.begin() + (last - m_sorted_ids.begin())};
+  }
+
+  const option* option_index::find(const char* long_name,
+                                   size_type length) const noexcept {
+    if (m_options.empty())
+      return nullptr;
+
+    string_ref name{long_name, length};
+    std::uint32_t h = string_pool::hash(long_name, length);
+    if (is_optimized()) {
+      const slot& s = m_slots[displaced_slot(h, m_displacements[bucket(h)])];
+      if (s.id != npos && s.hash == h && m_options[s.id]->long_name() == name)
+        return m_options[s.id];
+      return nullptr;
+    }
+
+    std::uint32_t id = m_table[probe(name, h)].id;
+    return id != npos ? m_options[id] : nullptr;
+  }
+
+  bool option_index::has_renamed(const std::string& long_name) const noexcept {
+    if (m_options.empty())
+      return false;
+
+    std::uint32_t h = string_pool::hash(long_name.data(), long_name.size());
+    size_type mask = m_table.size() - 1;
+    for (size_type pos = h & mask; m_table[pos].id != npos; pos = (pos + 1) & mask) {
+      if (m_table[pos].hash == h)
+        return true;
+    }
+    return false;
+  }
+
+  bool option_index::optimize() {
+    if (m_options.empty() || is_optimized())
+      return is_optimized();
+
+    // Keep the load factor at or below one half
+    size_type slot_count = 16;
+    while (slot_count < 2 * m_options.size())
+      slot_count *= 2;
+
+    // Use about two names per bucket
+    size_type bucket_count = 1;
+    while (2 * bucket_count < m_options.size())
+      bucket_count *= 2;
+    m_displacements.assign(bucket_count, 0);
+
+    std::vector<std::vector<slot>> buckets(bucket_count);
+    for (size_type i = 0; i < m_options.size(); ++i) {
+      std::uint32_t h = m_hashes[i];
+      buckets[bucket(h)].push_back(slot{h, static_cast<std::uint32_t>(i)});
+    }
+
+    // Place the largest buckets first, while the table is emptiest
+    std::vector<size_type> order(bucket_count);
+    for (size_type i = 0; i < bucket_count; ++i)
+      order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_type a, size_type b) {
+                       return buckets[a].size() > buckets[b].size();
+                     });
+
+    const std::uint32_t max_displacement = 1u << 16;
+    m_slots.assign(slot_count, slot{0, npos});
+    std::vector<size_type> positions;
+    for (size_type b : order) {
+      const auto& entries = buckets[b];
+      if (entries.empty())
+        break;
+
+      bool placed = false;
+      for (std::uint32_t d = 0; !placed && d < max_displacement; ++d) {
+        positions.clear();
+        placed = true;
+        for (const auto& entry : entries) {
+          size_type pos = displaced_slot(entry.hash, d);
+          if (m_slots[pos].id != npos
+              || std::find(positions.begin(), positions.end(), pos)
+                 != positions.end()) {
+            placed = false;
+            break;
+          }
+          positions.push_back(pos);
+        }
+
+        if (placed) {
+          for (size_type i = 0; i < entries.size(); ++i)
+            m_slots[positions[i]] = entries[i];
+          m_displacements[b] = d;
+        }
+      }
+
+      if (!placed) { // Give up and keep the ordinary table
+        m_slots.clear();
+        m_displacements.clear();
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  auto option_index::probe(string_ref name, std::uint32_t h) const noexcept
+    -> size_type {
+    size_type mask = m_table.size() - 1;
+    for (size_type pos = h & mask; ; pos = (pos + 1) & mask) {
+      const slot& s = m_table[pos];
+      if (s.id == npos
+          || (s.hash == h && m_options[s.id]->long_name() == name))
+        return pos;
+    }
+  }
+
+  void option_index::rehash(size_type count) {
+    // Keep the load factor at or below one half
+    size_type slot_count = 16;
+    while (slot_count < 2 * count)
+      slot_count *= 2;
+
+    m_table.assign(slot_count, slot{0, npos});
+    size_type mask = slot_count - 1;
+    for (size_type i = 0; i < m_options.size(); ++i) {
+      size_type pos = m_hashes[i] & mask;
+      while (m_table[pos].id != npos)
+        pos = (pos + 1) & mask;
+      m_table[pos] = slot{m_hashes[i], static_cast<std::uint32_t>(i)};
+    }
+  }
+
+  std::size_t option_index::hash(const char* str, size_type length) noexcept {
+    return string_pool::hash(str, length);
+  }
+
+  auto option_index::displaced_slot(std::uint32_t h,
+                                    std::uint32_t displacement) const noexcept
+    -> size_type {
+    std::uint32_t x = h ^ (displacement * 0x9e3779b9u);
+    x ^= x >> 16;
+    x *= 0x85ebca6bu;
+    x ^= x >> 13;
+    return x & (m_slots.size() - 1);
+  }
+
+} // End namespace
@@ -0,0 +1,241 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+
+/**
+ * @file
+ * @brief Source file for `schema_parser` implementation.
+ */
+
+#include <optionpp/option_schema.hpp>
+
+#include <cstring>
+#include <ostream>
+#include <optionpp/string_pool.hpp>
+
+namespace optionpp {
+
+  namespace {
+
+    // The schema always uses the default prefixes
+    const option_syntax default_syntax{};
+
+  } // End namespace
+
+  constexpr std::uint32_t schema_parser::npos;
+
+  const option_spec* schema_parser::find(string_ref long_name) const noexcept {
+    if (long_name.empty())
+      return nullptr;
+
+    std::uint32_t h = string_pool::hash(long_name.data(), long_name.size());
+    std::uint32_t pos = m_slots[displaced_slot(h, m_displacements[bucket(h, m_bucket_count)],
+                                               m_slot_count)];
+    if (pos == npos)
+      return nullptr;
+
+    // The slot holds the only name that can match, if any
+    const char* name = m_specs[pos].long_name;
+    if (std::strncmp(name, long_name.data(), long_name.size()) != 0
+        || name[long_name.size()] != '\0')
+      return nullptr;
+    return m_specs + pos;
+  }
+
+  std::ostream& schema_parser::print_help(std::ostream& os) const {
+    return os.write(m_help, static_cast<std::streamsize>(m_help_size));
+  }
+
+  bool schema_parser::parse_token(string_ref token, visit_state& state) const {
+    // If we are expecting a standalone option argument...
+    if (state.pending) {
+      // ...then this token should be a non-option; but if the
+      // argument is required we'll interpret it that way regardless
+      const option_spec& spec = *state.pending;
+      if (default_syntax.is_non_option(token) || spec.arg_required) {
+        // As with compiled_parser::visit, the option is passed on
+        // before its separate argument is checked
+        state.pending = nullptr;
+        pass_option(spec, token, state);
+        if (!check(spec, token, 0, state.pending_name, string_ref{}, state))
+          return false;
+        ++state.index;
+        return true;
+      }
+
+      // Found an option, so the pending one gets no argument
+      state.pending = nullptr;
+      pass_option(spec, string_ref{}, state);
+      if (state.stopped)
+        return true;
+    }
+
+    if (state.end_of_options) // Ignore options
+      pass_non_option(token, state);
+    else if (!parse_argument(token, state))
+      return false;
+
+    ++state.index;
+    return true;
+  }
+
+  bool schema_parser::parse_argument(string_ref token, visit_state& state) const {
+    using token_kind = option_syntax::token_kind;
+    const auto parts = default_syntax.split(token);
+    const string_ref specifier = parts.specifier;
+
+    switch (parts.kind) {
+    case token_kind::end_of_options:
+      state.end_of_options = true;
+      return true;
+    case token_kind::bad_assignment:
+      return fail(state, parse_errc::invalid_option, 0, specifier,
+                  default_syntax.equals());
+    case token_kind::short_options:
+      return parse_short_option_group(token, specifier, parts.argument,
+                                      parts.has_argument, state);
+    case token_kind::non_option:
+      pass_non_option(token, state);
+      return true;
+    case token_kind::long_option:
+      break;
+    }
+
+    const option_spec* spec = find(specifier.substr(default_syntax.long_prefix().size()));
+    if (!spec)
+      return fail(state, parse_errc::invalid_option, 0, specifier);
+
+    if (!*spec->arg_name) { // Does not take an argument
+      if (parts.has_argument)
+        return fail(state, parse_errc::unexpected_argument, specifier.size(), specifier);
+      pass_option(*spec, string_ref{}, state);
+    } else if (!parts.has_argument) { // Caller should look for the argument
+      state.pending = spec;
+      state.pending_name.assign(specifier.data(), specifier.size());
+      state.pending_index = state.index;
+      state.pending_offset = 0;
+    } else {
+      return accept(*spec, parts.argument, parts.argument.data() - token.data(),
+                    specifier, string_ref{}, state);
+    }
+    return true;
+  }
+
+  bool schema_parser::parse_short_option_group(string_ref token,
+                                               string_ref specifier,
+                                               string_ref argument,
+                                               bool has_arg,
+                                               visit_state& state) const {
+    using sz_t = string_ref::size_type;
+
+    const string_ref prefix = default_syntax.short_prefix();
+    const string_ref short_names = specifier.substr(prefix.size());
+    for (sz_t pos = 0; pos != short_names.size() && !state.stopped; ++pos) {
+      const bool is_last = pos + 1 == short_names.size();
+      const string_ref name_text = short_names.substr(pos, 1);
+
+      // Look up option info
+      const option_spec* spec = find(short_names[pos]);
+      if (!spec)
+        return fail(state, parse_errc::invalid_option, prefix.size() + pos,
+                    prefix, name_text);
+
+      if (!*spec->arg_name) {
+        if (is_last && has_arg)
+          return fail(state, parse_errc::unexpected_argument, specifier.size(),
+                      prefix, name_text);
+        pass_option(*spec, string_ref{}, state);
+        continue;
+      }
+
+      // An option that takes an argument uses up the rest of the token
+      if (!is_last) {
+        // The rest of the string is the argument (if an assignment
+        // symbol was found, it is actually part of the argument)
+        string_ref opt_arg = token.substr(prefix.size() + pos + 1);
+        return accept(*spec, opt_arg, opt_arg.data() - token.data(), prefix,
+                      name_text, state);
+      } else if (has_arg) {
+        return accept(*spec, argument, argument.data() - token.data(), prefix,
+                      name_text, state);
+      }
+
+      // This is the last option and it needs an argument
+      state.pending = spec;
+      state.pending_name.assign(prefix.data(), prefix.size());
+      state.pending_name += short_names[pos];
+      state.pending_index = state.index;
+      state.pending_offset = prefix.size() + pos;
+    }
+    return true;
+  }
+
+  bool schema_parser::finish(visit_state& state) {
+    if (state.pending) {
+      // Make sure we don't still need a mandatory argument
+      if (state.pending->arg_required) {
+        state.status.set(parse_errc::missing_argument, state.pending_index,
+                         state.pending_offset, state.pending_name);
+        return false;
+      }
+      pass_option(*state.pending, string_ref{}, state);
+      state.pending = nullptr;
+    }
+    return true;
+  }
+
+  bool schema_parser::accept(const option_spec& spec, string_ref argument,
+                             size_type offset, string_ref prefix,
+                             string_ref name, visit_state& state) {
+    if (!check(spec, argument, offset, prefix, name, state))
+      return false;
+    pass_option(spec, argument, state);
+    return true;
+  }
+
+  bool schema_parser::check(const option_spec& spec, string_ref argument,
+                            size_type offset, string_ref prefix,
+                            string_ref name, visit_state& state) {
+    if (spec.checker) {
+      auto err = spec.checker(argument);
+      if (err != parse_errc::none)
+        return fail(state, err, offset, prefix, name);
+    }
+    return true;
+  }
+
+  void schema_parser::pass_option(const option_spec& spec, string_ref argument,
+                                  visit_state& state) {
+    if (!state.stopped && state.on_option && !state.on_option(spec, argument))
+      state.stopped = true;
+  }
+
+  void schema_parser::pass_non_option(string_ref argument, visit_state& state) {
+    if (!state.stopped && state.on_non_option && !state.on_non_option(argument))
+      state.stopped = true;
+  }
+
+  bool schema_parser::fail(visit_state& state, parse_errc error,
+                           size_type offset, string_ref prefix,
+                           string_ref name) {
+    state.status.set(error, state.index, offset, prefix, name);
+    return false;
+  }
+
+} // End namespace
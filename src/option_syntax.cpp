@@ -0,0 +1,57 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `option_syntax` class implementation.
+ */
+
+#include <optionpp/option_syntax.hpp>
+
+namespace optionpp {
+
+  auto option_syntax::split(string_ref token) const noexcept -> token_parts {
+    token_parts parts{token_kind::non_option, token, string_ref{}, false};
+    if (token == m_end_of_options) {
+      parts.kind = token_kind::end_of_options;
+      return parts;
+    }
+
+    // Split string into components
+    auto pos = m_equals.size() == 1 ? token.find(m_equals[0]) : token.find(m_equals);
+    if (pos != string_ref::npos) {
+      parts.has_argument = true;
+      parts.specifier = token.substr(0, pos);
+      parts.argument = token.substr(pos + m_equals.size());
+
+      // Check for bad syntax like -= and --=
+      if (parts.specifier == m_short_prefix || parts.specifier == m_long_prefix) {
+        parts.kind = token_kind::bad_assignment;
+        return parts;
+      }
+    }
+
+    if (has_prefix(parts.specifier, m_long_prefix))
+      parts.kind = token_kind::long_option;
+    else if (has_prefix(parts.specifier, m_short_prefix))
+      parts.kind = token_kind::short_options;
+    return parts;
+  }
+
+} // End namespace
@@ -0,0 +1,124 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `parse_status` class implementation.
+ */
+
+#include <optionpp/parse_status.hpp>
+
+#include <algorithm>
+
+namespace optionpp {
+
+  parse_error parse_status::to_error() const {
+    const char* fn_name;
+    switch (m_error) {
+    case parse_errc::missing_argument:
+      fn_name = "optionpp::parser::parse";
+      break;
+    case parse_errc::invalid_option:
+    case parse_errc::unexpected_argument:
+    case parse_errc::ambiguous_option:
+      fn_name = "optionpp::parser::parse_argument";
+      break;
+    case parse_errc::unreadable_file:
+    case parse_errc::recursive_file:
+      fn_name = "optionpp::compiled_parser::parse_response_file";
+      break;
+    case parse_errc::unknown_command:
+      fn_name = "optionpp::command_parser::parse";
+      break;
+    default:
+      fn_name = "optionpp::option::write_argument";
+      break;
+    }
+    return parse_error{message(), fn_name, m_option};
+  }
+
+  std::vector<std::string> parse_status::suggestions() const {
+    if (!m_suggestions || m_error != parse_errc::invalid_option)
+      return std::vector<std::string>{};
+
+    // Allow about one typo for every three characters
+    string_ref name{m_option.data() + m_prefix_size,
+                    m_option.size() - m_prefix_size};
+    size_type max_distance = std::max<size_type>(1, std::min<size_type>(3, name.size() / 3));
+    auto result = m_suggestions->find(name, max_distance, 3);
+    for (auto& suggestion : result)
+      suggestion.insert(0, m_option, 0, m_prefix_size);
+    return result;
+  }
+
+  std::string parse_status::message() const {
+    std::string msg = message(m_error, m_option);
+    if (!m_candidates.empty()) {
+      msg += "; possibilities:";
+      for (const auto& candidate : m_candidates)
+        msg += " '" + candidate + "'";
+    }
+
+    auto suggested = suggestions();
+    if (!suggested.empty()) {
+      msg += "; did you mean ";
+      for (std::size_t i = 0; i < suggested.size(); ++i) {
+        if (i != 0)
+          msg += i + 1 == suggested.size() ? " or " : ", ";
+        msg += "'" + suggested[i] + "'";
+      }
+      msg += "?";
+    }
+    return msg;
+  }
+
+  std::string parse_status::message(parse_errc error, string_ref option) {
+    const std::string name = option.str();
+    switch (error) {
+    case parse_errc::none:
+      return std::string{};
+    case parse_errc::invalid_option:
+      return "invalid option: '" + name + "'";
+    case parse_errc::missing_argument:
+      return "option '" + name + "' requires an argument";
+    case parse_errc::unexpected_argument:
+      return "option '" + name + "' does not accept arguments";
+    case parse_errc::not_an_integer:
+      return "argument for option '" + name + "' must be an integer";
+    case parse_errc::negative_argument:
+      return "argument for option '" + name + "' must not be negative";
+    case parse_errc::not_a_number:
+      return "argument for option '" + name + "' must be a number";
+    case parse_errc::unreadable_file:
+      return "cannot read response file '" + name + "'";
+    case parse_errc::recursive_file:
+      return "response file '" + name + "' includes itself";
+    case parse_errc::invalid_value:
+      return "argument for option '" + name + "' is not valid";
+    case parse_errc::ambiguous_option:
+      return "option '" + name + "' is ambiguous";
+    case parse_errc::unknown_command:
+      return "unknown command: '" + name + "'";
+    case parse_errc::out_of_range:
+    default:
+      return "argument for option '" + name + "' is out of range";
+    }
+  }
+
+} // End namespace
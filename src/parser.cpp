@@ -25,20 +25,96 @@
 #include <optionpp/parser.hpp>
 
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <iterator>
-#include <limits>
-#include <stdexcept>
+#include <type_traits>
+#include <optionpp/string_pool.hpp>
 
 namespace optionpp {
 
+  // Adding a group must not move the options of the other groups,
+  // which the name index points to
+  static_assert(std::is_nothrow_move_constructible<option_group>::value,
+                "option_group must be nothrow move constructible");
+
+  parser::parser(const parser& other)
+    : m_groups{other.m_groups},
+      m_delims{other.m_delims},
+      m_short_option_prefix{other.m_short_option_prefix},
+      m_long_option_prefix{other.m_long_option_prefix},
+      m_end_of_options{other.m_end_of_options},
+      m_equals{other.m_equals},
+      m_response_file_prefix{other.m_response_file_prefix},
+      m_allow_abbreviations{other.m_allow_abbreviations},
+      m_suggestions_enabled{other.m_suggestions_enabled} {
+    track_groups();
+  }
+
+  parser::parser(parser&& other) noexcept
+    : m_groups{std::move(other.m_groups)},
+      m_delims{std::move(other.m_delims)},
+      m_short_option_prefix{std::move(other.m_short_option_prefix)},
+      m_long_option_prefix{std::move(other.m_long_option_prefix)},
+      m_end_of_options{std::move(other.m_end_of_options)},
+      m_equals{std::move(other.m_equals)},
+      m_response_file_prefix{std::move(other.m_response_file_prefix)},
+      m_allow_abbreviations{other.m_allow_abbreviations},
+      m_suggestions_enabled{other.m_suggestions_enabled} {
+    m_log.text = std::move(other.m_log.text);
+    track_groups();
+    other.invalidate_index();
+  }
+
+  parser& parser::operator=(const parser& other) {
+    if (this != &other) {
+      m_groups = other.m_groups;
+      m_delims = other.m_delims;
+      m_short_option_prefix = other.m_short_option_prefix;
+      m_long_option_prefix = other.m_long_option_prefix;
+      m_end_of_options = other.m_end_of_options;
+      m_equals = other.m_equals;
+      m_response_file_prefix = other.m_response_file_prefix;
+      m_allow_abbreviations = other.m_allow_abbreviations;
+      m_suggestions_enabled = other.m_suggestions_enabled;
+      m_log.text.reset(); // Start a new pool without our old strings
+      track_groups();
+      invalidate_index();
+    }
+    return *this;
+  }
+
+  parser& parser::operator=(parser&& other) noexcept {
+    if (this != &other) {
+      m_groups = std::move(other.m_groups);
+      m_delims = std::move(other.m_delims);
+      m_short_option_prefix = std::move(other.m_short_option_prefix);
+      m_long_option_prefix = std::move(other.m_long_option_prefix);
+      m_end_of_options = std::move(other.m_end_of_options);
+      m_equals = std::move(other.m_equals);
+      m_response_file_prefix = std::move(other.m_response_file_prefix);
+      m_allow_abbreviations = other.m_allow_abbreviations;
+      m_suggestions_enabled = other.m_suggestions_enabled;
+      m_log.text = std::move(other.m_log.text);
+      track_groups();
+      invalidate_index();
+      other.invalidate_index();
+    }
+    return *this;
+  }
+
   option& parser::add_option(const option& opt) {
+    return add_option(option{opt});
+  }
+
+  option& parser::add_option(option&& opt) {
     auto it = find_group("");
     if (it == m_groups.end()) {
       m_groups.emplace_back("");
-      return m_groups.back().add_option(opt);
+      track_groups();
+      return m_groups.back().add_option(std::move(opt));
     } else {
-      return it->add_option(opt);
+      return it->add_option(std::move(opt));
     }
   }
 
@@ -61,6 +137,8 @@ namespace optionpp {
                            });
     if (it == m_groups.rend()) {
       m_groups.emplace_back(name);
+      track_groups();
+      m_groups.back().m_tracker.notify();
       return m_groups.back();
     } else {
       return *it;
@@ -72,6 +150,7 @@ namespace optionpp {
                                   const std::string& long_prefix,
                                   const std::string& end_indicator,
                                   const std::string& equals) {
+    invalidate_index();
     if (!delims.empty())
       m_delims = delims;
     if (!short_prefix.empty())
@@ -85,6 +164,7 @@ namespace optionpp {
   }
 
   void parser::sort_groups() {
+    invalidate_index();
     std::sort(m_groups.begin(), m_groups.end(),
               [](const option_group& a, const option_group& b) {
                 return a.name() < b.name();
@@ -92,6 +172,7 @@ namespace optionpp {
   }
 
   void parser::sort_options() {
+    invalidate_index();
     std::for_each(m_groups.begin(), m_groups.end(),
                   [](option_group& g) { g.sort(); });
   }
@@ -112,13 +193,58 @@ namespace optionpp {
       return add_option().short_name(short_name);
   }
 
+  constexpr std::size_t parser::max_help_layouts;
+
   std::ostream& parser::print_help(std::ostream& os,
                                    int max_line_length,
                                    int group_indent,
                                    int option_indent,
                                    int desc_first_line_indent,
                                    int desc_multiline_indent) const {
+    std::lock_guard<std::mutex> lock{m_cache_mutex};
+
+    // Drop help text formatted before the options last changed
+    unsigned long changes = m_log.changes.load(std::memory_order_acquire);
+    if (m_help_changes != changes) {
+      m_help_layouts.clear();
+      m_help_changes = changes;
+    }
+
+    auto it = std::find_if(m_help_layouts.begin(), m_help_layouts.end(),
+                           [&](const help_layout& layout) {
+                             return layout.max_line_length == max_line_length
+                               && layout.group_indent == group_indent
+                               && layout.option_indent == option_indent
+                               && layout.desc_first_line_indent
+                                  == desc_first_line_indent
+                               && layout.desc_multiline_indent
+                                  == desc_multiline_indent;
+                           });
+
+    if (it == m_help_layouts.end()) {
+      if (m_help_layouts.size() == max_help_layouts)
+        m_help_layouts.erase(m_help_layouts.begin());
+
+      help_layout layout{max_line_length, group_indent, option_indent,
+                         desc_first_line_indent, desc_multiline_indent, {}};
+      format_help(layout.text, max_line_length, group_indent, option_indent,
+                  desc_first_line_indent, desc_multiline_indent);
+      m_help_layouts.push_back(std::move(layout));
+      it = m_help_layouts.end() - 1;
+    }
+
+    return os.write(it->text.data(), it->text.size());
+  }
+
+  void parser::format_help(std::string& text,
+                           int max_line_length,
+                           int group_indent,
+                           int option_indent,
+                           int desc_first_line_indent,
+                           int desc_multiline_indent) const {
     bool first = true;
+    std::string usage;
+    auto out = std::back_inserter(text);
 
     for (const auto& group : m_groups) {
       if (group.empty())
@@ -128,12 +254,13 @@ namespace optionpp {
       if (first)
         first = false;
       else
-        os << "\n\n";
+        text += "\n\n";
 
       // Print group name
       if (!group.name().empty()) {
-        os << utility::wrap_text(group.name(), max_line_length, group_indent)
-           << "\n";
+        utility::wrap_text(group.name(), out, max_line_length,
+                           group_indent, group_indent);
+        text += "\n";
       }
 
       // Print options
@@ -143,9 +270,9 @@ namespace optionpp {
         if (first_opt)
           first_opt = false;
         else
-          os << "\n";
+          text += "\n";
 
-        std::string usage(option_indent, ' ');
+        usage.assign(option_indent, ' ');
 
         // Short name
         if (opt.short_name() != '\0') {
@@ -161,38 +288,39 @@ namespace optionpp {
         // Long name
         if (!opt.long_name().empty()) {
           usage += m_long_option_prefix;
-          usage += opt.long_name();
+          usage.append(opt.long_name().data(), opt.long_name().size());
         }
 
         // Argument
-        if (!opt.argument_name().empty()) {
-          if (opt.is_argument_required())
-            usage += m_equals + opt.argument_name();
-          else
-            usage += "[" + m_equals + opt.argument_name() + "]";
+        string_ref arg_name = opt.argument_name();
+        if (!arg_name.empty()) {
+          if (!opt.is_argument_required())
+            usage += '[';
+          usage += m_equals;
+          usage.append(arg_name.data(), arg_name.size());
+          if (!opt.is_argument_required())
+            usage += ']';
         }
 
         // Description
         int spacing = desc_first_line_indent - usage.size();
         if (spacing <= 1) {
-          os << utility::wrap_text(usage, max_line_length);
+          utility::wrap_text(usage, out, max_line_length, 0, 0);
           if (!opt.description().empty()) {
-            os << "\n" << utility::wrap_text(opt.description(),
-                                             max_line_length,
-                                             desc_multiline_indent,
-                                             desc_first_line_indent);
+            text += "\n";
+            utility::wrap_text(opt.description(), out, max_line_length,
+                               desc_multiline_indent, desc_first_line_indent);
           }
         } else {
           if (!opt.description().empty()) {
             usage += std::string(spacing, ' ');
-            usage += opt.description();
+            usage.append(opt.description().data(), opt.description().size());
           }
-          os << utility::wrap_text(usage, max_line_length,
-                                   desc_multiline_indent, 0);
+          utility::wrap_text(usage, out, max_line_length,
+                             desc_multiline_indent, 0);
         }
       }
     }
-    return os;
   }
 
   auto parser::find_group(const std::string& name) -> group_iterator {
@@ -209,272 +337,180 @@ namespace optionpp {
                         });
   }
 
-  option* parser::find_option(const std::string& long_name) {
-    for (auto& group : m_groups) {
-      auto it = group.find(long_name);
-      if (it != group.end())
-        return &(*it);
+  parser::name_checker::name_checker(const parser& owner, std::size_t count)
+    : m_short_names{} {
+    // Intern every long name; a new name that gets an existing id is
+    // already in use. Duplicates among the existing options were
+    // accepted when they were added and are skipped.
+    for (const auto& group : owner.m_groups)
+      count += group.size();
+
+    m_long_names.reserve(count);
+    for (const auto& group : owner.m_groups) {
+      for (const auto& opt : group) {
+        if (!opt.long_name().empty())
+          m_long_names.intern(opt.long_name());
+        m_short_names[static_cast<unsigned char>(opt.short_name())] = true;
+      }
     }
+  }
 
-    return nullptr;
+  void parser::name_checker::add(const option& opt) {
+    string_ref long_name = opt.long_name();
+    std::size_t before = m_long_names.size();
+    if (!long_name.empty() && m_long_names.intern(long_name) < before)
+      throw duplicate_option_error{"option name '" + long_name + "' is already in use",
+          "optionpp::parser::add_options", long_name.str()};
+
+    char short_name = opt.short_name();
+    auto& used = m_short_names[static_cast<unsigned char>(short_name)];
+    if (short_name != '\0' && used)
+      throw duplicate_option_error{"option name '" + std::string(1, short_name)
+          + "' is already in use", "optionpp::parser::add_options",
+          std::string(1, short_name)};
+    used = true;
   }
 
-  const option* parser::find_option(const std::string& long_name) const {
-    for (const auto& group : m_groups) {
-      auto it = group.find(long_name);
-      if (it != group.end())
-        return &(*it);
+  option* parser::find_option(const std::string& long_name) {
+    const option* opt = update_lookup().find(long_name);
+    if (!opt && m_lookup.has_renamed(long_name)) { // Renamed since indexed
+      rebuild_lookup();
+      opt = m_lookup.find(long_name);
     }
 
-    return nullptr;
+    // The index only hands out options held by this parser
+    return const_cast<option*>(opt);
   }
 
   option* parser::find_option(char short_name) {
-    for (auto& group : m_groups) {
-      auto it = group.find(short_name);
-      if (it != group.end())
-        return &(*it);
+    const option* opt = update_lookup().find(short_name);
+    if (opt && opt->short_name() != short_name) { // Renamed since indexed
+      rebuild_lookup();
+      opt = m_lookup.find(short_name);
     }
 
-    return nullptr;
+    return const_cast<option*>(opt);
+  }
+
+  const option_index& parser::update_lookup() {
+    if (m_log.moved) {
+      rebuild_lookup();
+      return m_lookup;
+    }
+
+    for (const option* opt : m_log.renamed) {
+      const option* by_long = opt->long_name().empty() ? nullptr
+        : m_lookup.find(opt->long_name().data(), opt->long_name().size());
+      const option* by_short = opt->short_name() == '\0' ? nullptr
+        : m_lookup.find(opt->short_name());
+      if ((by_long && by_long != opt) || (by_short && by_short != opt)) {
+        rebuild_lookup();
+        return m_lookup;
+      }
+      m_lookup.insert(*opt);
+    }
+    m_log.renamed.clear();
+    return m_lookup;
   }
 
-  const option* parser::find_option(char short_name) const {
+  void parser::rebuild_lookup() {
+    m_lookup.clear();
+    std::size_t count = 0;
+    for (const auto& group : m_groups)
+      count += group.size();
+    m_lookup.reserve(count);
     for (const auto& group : m_groups) {
-      auto it = group.find(short_name);
-      if (it != group.end())
-        return &(*it);
+      for (const auto& opt : group)
+        m_lookup.insert(opt);
     }
 
-    return nullptr;
+    // Listing more renames than there are options would cost more
+    // than rebuilding
+    m_log.renamed.clear();
+    m_log.rename_limit = std::max<std::size_t>(64, count);
+    m_log.moved = false;
+  }
+
+  const compiled_parser& parser::compiled() const {
+    // Double-checked so that parsing with an up-to-date view never
+    // takes the lock
+    unsigned long changes = m_log.changes.load(std::memory_order_acquire);
+    if (m_compiled_changes.load(std::memory_order_acquire) != changes) {
+      std::lock_guard<std::mutex> lock{m_cache_mutex};
+      changes = m_log.changes.load(std::memory_order_acquire);
+      if (m_compiled_changes.load(std::memory_order_relaxed) != changes) {
+        m_compiled = compiled_parser{*this, compiled_parser::borrow_tag{}};
+        m_compiled_changes.store(changes, std::memory_order_release);
+      }
+    }
+
+    return m_compiled;
   }
 
   parser_result parser::parse(int argc, char* argv[], bool ignore_first) const {
-    return parse(argv, argv + argc, ignore_first);
+    return compiled().parse(argc, argv, ignore_first);
   }
 
   parser_result parser::parse(const std::string& cmd_line, bool ignore_first) const {
-    std::vector<std::string> container;
-    utility::split(cmd_line, std::back_inserter(container),
-                   m_delims, "\"'", '\\');
-    return parse(container.begin(), container.end(), ignore_first);
-  }
-
-  void parser::write_option_argument(const parsed_entry& entry) const {
-    if (!entry.opt_info)
-      return;
-
-    const option& opt = *entry.opt_info;
-    if (!opt.has_bound_argument_variable())
-      return;
-
-    std::string::size_type pos = 0;
-    const std::string& arg = entry.argument;
-    const std::string& opt_name = entry.original_without_argument;
-    const std::string& fn_name = "optionpp::parser::write_option_argument";
-
-    try {
-      switch (opt.argument_type()) {
-      case option::uint_arg: {
-        long long value = std::stoll(entry.argument, &pos);
-        if (pos != arg.size())
-          throw std::invalid_argument{"invalid argument"};
-        if (value < 0)
-          throw parse_error{"argument for option '" + opt_name + "' must not be negative",
-              fn_name, opt_name};
-        else if (value > std::numeric_limits<unsigned>::max())
-          throw std::out_of_range{"out of range"};
-        opt.write_uint(static_cast<unsigned>(value));
-        break;
-      }
-      case option::int_arg: {
-        int value = std::stoi(entry.argument, &pos);
-        if (pos != arg.size())
-          throw std::invalid_argument{"invalid argument"};
-        opt.write_int(value);
-        break;
-      }
-      case option::double_arg: {
-        double value = std::stod(entry.argument, &pos);
-        if (pos != arg.size())
-          throw std::invalid_argument{"invalid argument"};
-        opt.write_double(value);
-        break;
-      }
-      default:
-      case option::string_arg:
-        opt.write_string(arg);
-        break;
-      }
-    } catch(const std::invalid_argument&) {
-      switch (opt.argument_type()) {
-      case option::uint_arg:
-      case option::int_arg:
-        throw parse_error{"argument for option '" + opt_name + "' must be an integer",
-            fn_name, opt_name};
-      case option::double_arg:
-        throw parse_error{"argument for option '" + opt_name + "' must be a number",
-            fn_name, opt_name};
-      default:
-        throw type_error{"type error in argument for option '" + opt_name + "'", fn_name};
-      }
-    } catch(const std::out_of_range&) {
-      throw parse_error{"argument for option '" + opt_name + "' is out of range",
-          fn_name, opt_name};
-    }
+    return compiled().parse(cmd_line, ignore_first);
   }
 
-  void parser::parse_argument(const std::string& argument,
-                              parser_result& result, cl_arg_type& type) const {
-    // Check for end-of-option marker
-    if (is_end_indicator(argument)) {
-      type = cl_arg_type::end_indicator;
-      return;
-    }
+  void parser::parse_into(parser_result& result, int argc, char* argv[],
+                          bool ignore_first) const {
+    compiled().parse_into(result, argc, argv, ignore_first);
+  }
 
-    // Split string into components
-    std::string option_specifier;
-    std::string option_argument;
-    bool assignment_found = false;
-    auto pos = argument.find(m_equals);
-    if (pos == std::string::npos)
-      option_specifier = argument;
-    else {
-      assignment_found = true;
-      option_specifier = argument.substr(0, pos);
-      pos += m_equals.size();
-      option_argument = argument.substr(pos);
-
-      // Check for bad syntax like -= and --=
-      if (option_specifier == m_short_option_prefix
-          || option_specifier == m_long_option_prefix) {
-        option_specifier += m_equals;
-        throw parse_error{"invalid option: '" + option_specifier + "'",
-            "optionpp::parser::parse_argument", option_specifier};
-      }
-    }
+  void parser::parse_into(parser_result& result, const std::string& cmd_line,
+                          bool ignore_first) const {
+    compiled().parse_into(result, cmd_line, ignore_first);
+  }
 
-    // Check option type
-    parsed_entry arg_info;
-    if (is_long_option(option_specifier)) {
-      // Extract option name
-      std::string option_name = option_specifier.substr(m_long_option_prefix.size());
-
-      // Look up option info
-      const option* opt = find_option(option_name);
-      if (!opt)
-        throw parse_error{"invalid option: '" + option_specifier + "'",
-            "optionpp::parser::parse_argument", option_specifier};
-      arg_info.opt_info = &(*opt);
-
-      // Does this option take an argument?
-      if (!opt->argument_name().empty()) {
-        if (!assignment_found) { // No arg was found, caller should look for it
-          if (opt->is_argument_required())
-            type = cl_arg_type::arg_required;
-          else
-            type = cl_arg_type::arg_optional;
-        } else { // Found an argument
-          type = cl_arg_type::no_arg; // Caller should not look for argument
-          arg_info.argument = option_argument;
-        }
-      } else { // Does not take an argument
-        if (assignment_found) // Found an argument where there should be none
-          throw parse_error{"option '" + option_specifier + "' does not accept arguments",
-              "optionpp::parser::parse_argument", option_specifier};
-        type = cl_arg_type::no_arg;
-      }
-      arg_info.original_text = argument;
-      arg_info.original_without_argument = option_specifier;
-      arg_info.is_option = true;
-      arg_info.long_name = option_name;
-      arg_info.short_name = opt->short_name();
-      if (assignment_found)
-        write_option_argument(arg_info);
-      opt->write_bool(true);
-      result.push_back(std::move(arg_info));
-    } else if (is_short_option_group(option_specifier)) { // Short options
-      parse_short_option_group(option_specifier.substr(m_short_option_prefix.size()),
-                               option_argument, assignment_found,
-                               result, type);
-    } else {
-      // If we get here, this argument is not an option
-      type = cl_arg_type::non_option;
-      arg_info.original_text = argument;
-      arg_info.is_option = false;
-      result.push_back(std::move(arg_info));
-    }
+  void parser::parse_into(parser_result& result, int argc, char* argv[],
+                          parse_status& status, bool ignore_first) const {
+    compiled().parse_into(result, argc, argv, status, ignore_first);
   }
 
-  void parser::parse_short_option_group(const std::string& short_names,
-                                        const std::string& argument, bool has_arg,
-                                        parser_result& result, cl_arg_type& type) const {
-    using sz_t = std::string::size_type;
-    for (sz_t pos = 0; pos != short_names.size(); ++pos) {
-      // Look up option info
-      const option* opt = find_option(short_names[pos]);
-      if (!opt) {
-        auto opt_name = m_short_option_prefix;
-        opt_name.push_back(short_names[pos]);
-        throw parse_error{"invalid option: '" + opt_name + "'",
-            "optionpp::parser::parse_short_option_group", opt_name};
-      }
+  void parser::parse_into(parser_result& result, const std::string& cmd_line,
+                          parse_status& status, bool ignore_first) const {
+    compiled().parse_into(result, cmd_line, status, ignore_first);
+  }
 
-      parsed_entry arg_info;
-      arg_info.original_text = m_short_option_prefix;
-      arg_info.original_text.push_back(short_names[pos]);
-      arg_info.original_without_argument = arg_info.original_text;
-      arg_info.is_option = true;
-      arg_info.long_name = opt->long_name();
-      arg_info.short_name = short_names[pos];
-      arg_info.opt_info = &(*opt);
-      opt->write_bool(true);
-
-      // Check if option takes an argument
-      if (!opt->argument_name().empty()) {
-        if (pos + 1 < short_names.size()) {
-          // This isn't the last option, so the rest of the string is an argument
-          arg_info.argument = short_names.substr(pos + 1);
-          if (has_arg) {
-            // The assignment symbol is actually part of the argument
-            arg_info.argument += m_equals;
-            arg_info.argument += argument;
-          }
-          arg_info.original_text += arg_info.argument;
-          write_option_argument(arg_info);
-          result.push_back(std::move(arg_info));
-          type = cl_arg_type::no_arg;
-          break;
-        } else {
-          // This is the last option and it needs an argument
-          if (has_arg) {
-            arg_info.original_text += m_equals;
-            arg_info.original_text += argument;
-            arg_info.argument = argument;
-            write_option_argument(arg_info);
-            type = cl_arg_type::no_arg;
-          } else if (opt->is_argument_required()) {
-            type = cl_arg_type::arg_required;
-          } else {
-            type = cl_arg_type::arg_optional;
-          }
-          result.push_back(std::move(arg_info));
-          break;
-        }
-      }
+  void parser::parse_into(parser_result& result, int argc, char* argv[],
+                          const parse_target& target, parse_status& status,
+                          bool ignore_first) const {
+    compiled().parse_into(result, argc, argv, target, status, ignore_first);
+  }
 
-      // If we make it here, then the current option does not take an argument
-      if (pos + 1 == short_names.size() && has_arg) {
-        auto opt_name = m_short_option_prefix;
-        opt_name.push_back(short_names[pos]);
-        throw parse_error{"option '" + opt_name + "' does not accept arguments",
-            "optionpp::parser::parse_short_option_group", opt_name};
-      }
+  void parser::parse_into(parser_result& result, const std::string& cmd_line,
+                          const parse_target& target, parse_status& status,
+                          bool ignore_first) const {
+    compiled().parse_into(result, cmd_line, target, status, ignore_first);
+  }
+
+  parser_result_ref parser::parse_ref(int argc, char* argv[],
+                                      bool ignore_first) const {
+    return compiled().parse_ref(argc, argv, ignore_first);
+  }
+
+  parser_result_ref parser::parse_ref(const std::string& cmd_line,
+                                      bool ignore_first) const {
+    return compiled().parse_ref(cmd_line, ignore_first);
+  }
+
+  bool parser::visit(int argc, char* argv[],
+                     const compiled_parser::option_handler& on_option,
+                     const compiled_parser::non_option_handler& on_non_option,
+                     parse_status& status, bool ignore_first) const {
+    return compiled().visit(argc, argv, on_option, on_non_option, status,
+                            ignore_first);
+  }
 
-      result.push_back(std::move(arg_info));
-      type = cl_arg_type::no_arg;
-      arg_info = parsed_entry{};
-    } // End for loop
+  bool parser::visit(const std::string& cmd_line,
+                     const compiled_parser::option_handler& on_option,
+                     const compiled_parser::non_option_handler& on_non_option,
+                     parse_status& status, bool ignore_first) const {
+    return compiled().visit(cmd_line, on_option, on_non_option, status,
+                            ignore_first);
   }
 
   std::ostream& operator<<(std::ostream& os, const parser& opt_parser) {
@@ -25,56 +25,258 @@
 #include <optionpp/parser_result.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <optionpp/error.hpp>
 
 namespace optionpp {
 
-  bool parser_result::is_option_set(const std::string& long_name) const noexcept {
-    if (long_name.empty())
-      return false;
-    else
-      return std::any_of(begin(), end(),
-                         [&](const parsed_entry& i) {
-                           return i.is_option && i.long_name == long_name;
-                         });
+  parser_result& parser_result::operator=(const parser_result& other) {
+    if (this != &other) {
+      clear();
+      for (const auto& entry : other)
+        push_back(entry);
+    }
+    return *this;
   }
 
-  bool parser_result::is_option_set(char short_name) const noexcept {
-    if (short_name == '\0')
-      return false;
-    else
-      return std::any_of(begin(), end(),
-                         [&](const parsed_entry& i) {
-                           return i.is_option && i.short_name == short_name;
-                         });
+  parser_result& parser_result::operator=(parser_result&& other) noexcept {
+    if (this != &other) {
+      m_entries = std::move(other.m_entries);
+      m_size = other.m_size;
+      m_index = std::move(other.m_index);
+      m_pending.store(other.m_pending.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+      other.m_entries.clear();
+      other.m_size = 0;
+      other.m_index.clear();
+      other.m_pending.store(false, std::memory_order_relaxed);
+    }
+    return *this;
+  }
+
+  const parser_result::size_type parser_result::npos;
+
+  void parser_result::clear() noexcept {
+    m_size = 0;
+    m_index.clear();
+    m_pending.store(false, std::memory_order_relaxed);
+  }
+
+  void parser_result::index_data::clear() noexcept {
+    records.clear();
+    std::fill(by_option.begin(), by_option.end(), npos);
+    if (name_count != 0) {
+      std::fill(by_name.begin(), by_name.end(), name_slot{0, npos, npos, '\0'});
+      name_count = 0;
+    }
+    named_records = 0;
+    stale = false;
+  }
+
+  auto parser_result::current_index() const -> const index_data& {
+    if (m_pending.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock{m_index_mutex};
+      if (m_pending.load(std::memory_order_relaxed)) {
+        if (m_index.stale)
+          rebuild_index();
+        name_records();
+        m_pending.store(false, std::memory_order_release);
+      }
+    }
+    return m_index;
+  }
+
+  void parser_result::name_records() const {
+    // Names are added in the order in which the options first
+    // occurred, as if they had been added with each entry
+    for (auto& r = m_index.named_records; r != m_index.records.size(); ++r) {
+      const auto& entry = m_entries[m_index.records[r].first];
+      if (!entry.long_name.empty())
+        insert_name(option_index::hash(entry.long_name.data(), entry.long_name.size()),
+                    m_index.records[r].first, '\0', r);
+      if (entry.short_name != '\0')
+        insert_name(option_index::hash(&entry.short_name, 1),
+                    m_index.records[r].first, entry.short_name, r);
+    }
+  }
+
+  void parser_result::rebuild_index() const {
+    m_index.clear();
+    for (size_type i = 0; i < m_size; ++i)
+      index_entry(i);
+  }
+
+  void parser_result::index_entry(size_type index) const {
+    auto& links = m_index.links;
+    if (links.size() <= index)
+      links.resize(index + 1);
+    links[index] = npos;
+
+    const auto& entry = m_entries[index];
+    if (!entry.is_option)
+      return;
+
+    // Entries of the same option share a record, and its names are
+    // taken from the first of them when they are first needed
+    size_type record = npos;
+    if (entry.opt_info) {
+      size_type pos = probe_option(entry.opt_info);
+      if (pos != npos)
+        record = m_index.by_option[pos];
+    } else {
+      // An entry made by hand has no option, so it joins the record
+      // of its long name or else its short name
+      name_records();
+      if (!entry.long_name.empty()) {
+        size_type pos = probe_name(option_index::hash(entry.long_name.data(),
+                                                      entry.long_name.size()),
+                                   &entry.long_name, '\0');
+        if (pos != npos)
+          record = m_index.by_name[pos].record;
+      }
+      if (record == npos && entry.short_name != '\0') {
+        size_type pos = probe_name(option_index::hash(&entry.short_name, 1),
+                                   nullptr, entry.short_name);
+        if (pos != npos)
+          record = m_index.by_name[pos].record;
+      }
+    }
+
+    if (record == npos) {
+      record = m_index.records.size();
+      m_index.records.push_back(option_record{entry.opt_info, index, index, 1});
+      if (entry.opt_info) {
+        insert_option(record);
+        m_pending.store(true, std::memory_order_relaxed);
+      }
+    } else {
+      option_record& r = m_index.records[record];
+      links[r.last] = index;
+      r.last = index;
+      ++r.count;
+    }
+
+    // Only an entry made by hand can add names to an existing record
+    if (entry.opt_info)
+      return;
+    m_index.named_records = m_index.records.size();
+    if (!entry.long_name.empty())
+      insert_name(option_index::hash(entry.long_name.data(), entry.long_name.size()),
+                  index, '\0', record);
+    if (entry.short_name != '\0')
+      insert_name(option_index::hash(&entry.short_name, 1),
+                  index, entry.short_name, record);
   }
 
-  std::string parser_result::get_argument(std::string long_name) const noexcept {
-    if (long_name == "")
-      return "";
+  auto parser_result::probe_name(std::size_t hash, const std::string* long_name,
+                                 char short_name) const noexcept -> size_type {
+    const auto& table = m_index.by_name;
+    if (table.empty())
+      return npos;
 
-    auto it = std::find_if(rbegin(), rend(),
-                           [&](const parsed_entry& i) {
-                             return i.is_option && i.long_name == long_name;
-                           });
-    if (it != rend())
-      return it->argument;
-    else
-      return "";
+    size_type mask = table.size() - 1;
+    for (size_type i = hash & mask; ; i = (i + 1) & mask) {
+      const name_slot& s = table[i];
+      if (s.record == npos)
+        return i;
+      if (s.hash == hash && s.short_name == short_name
+          && (short_name != '\0' || m_entries[s.entry].long_name == *long_name))
+        return i;
+    }
   }
 
-  std::string parser_result::get_argument(char short_name) const noexcept {
+  void parser_result::insert_name(std::size_t hash, size_type index,
+                                  char short_name, size_type record) const {
+    auto& table = m_index.by_name;
+
+    // Keep the load factor at or below one half
+    if (2 * (m_index.name_count + 1) > table.size()) {
+      std::vector<name_slot> old(table.empty() ? 16 : 2 * table.size(),
+                                 name_slot{0, npos, npos, '\0'});
+      old.swap(table);
+
+      size_type mask = table.size() - 1;
+      for (const auto& s : old) {
+        if (s.record == npos)
+          continue;
+        size_type i = s.hash & mask;
+        while (table[i].record != npos)
+          i = (i + 1) & mask;
+        table[i] = s;
+      }
+    }
+
+    // The first option to use a name keeps it
+    name_slot& s = table[probe_name(hash, &m_entries[index].long_name, short_name)];
+    if (s.record == npos) {
+      s = name_slot{hash, record, index, short_name};
+      ++m_index.name_count;
+    }
+  }
+
+  auto parser_result::probe_option(const option* opt) const noexcept -> size_type {
+    const auto& table = m_index.by_option;
+    if (table.empty())
+      return npos;
+
+    // Options are at least this far apart in memory, so the low bits
+    // of their addresses carry no information
+    auto key = reinterpret_cast<std::uintptr_t>(opt) / sizeof(option);
+    size_type mask = table.size() - 1;
+    for (size_type i = static_cast<size_type>(key * 0x9e3779b97f4a7c15ull) & mask;
+         ; i = (i + 1) & mask) {
+      if (table[i] == npos || m_index.records[table[i]].opt_info == opt)
+        return i;
+    }
+  }
+
+  void parser_result::insert_option(size_type record) const {
+    auto& table = m_index.by_option;
+
+    // Keep the load factor at or below one half
+    if (2 * m_index.records.size() > table.size()) {
+      table.assign(table.empty() ? 16 : 2 * table.size(), npos);
+      for (size_type r = 0; r != m_index.records.size(); ++r) {
+        if (m_index.records[r].opt_info)
+          table[probe_option(m_index.records[r].opt_info)] = r;
+      }
+    } else {
+      table[probe_option(m_index.records[record].opt_info)] = record;
+    }
+  }
+
+  auto parser_result::find_record(const std::string& long_name) const
+    -> const option_record* {
+    const index_data& index = current_index();
+    if (long_name.empty())
+      return nullptr;
+
+    size_type pos = probe_name(option_index::hash(long_name.data(), long_name.size()),
+                               &long_name, '\0');
+    return pos != npos && index.by_name[pos].record != npos
+      ? &index.records[index.by_name[pos].record] : nullptr;
+  }
+
+  auto parser_result::find_record(char short_name) const -> const option_record* {
+    const index_data& index = current_index();
     if (short_name == '\0')
-      return "";
-
-    auto it = std::find_if(rbegin(), rend(),
-                           [=](const parsed_entry& i) {
-                             return i.is_option && i.short_name == short_name;
-                           });
-    if (it != rend())
-      return it->argument;
-    else
-      return "";
+      return nullptr;
+
+    size_type pos = probe_name(option_index::hash(&short_name, 1), nullptr, short_name);
+    return pos != npos && index.by_name[pos].record != npos
+      ? &index.records[index.by_name[pos].record] : nullptr;
+  }
+
+  auto parser_result::find_record(const option& opt) const -> const option_record* {
+    const index_data& index = current_index();
+    size_type pos = probe_option(&opt);
+    return pos != npos && index.by_option[pos] != npos
+      ? &index.records[index.by_option[pos]] : nullptr;
+  }
+
+  const std::string& parser_result::last_argument(const option_record* r) const noexcept {
+    static const std::string empty;
+    return r ? m_entries[r->last].argument : empty;
   }
 
 } // End namespace
@@ -0,0 +1,94 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `parser_result_ref` class implementation.
+ */
+
+#include <optionpp/parser_result_ref.hpp>
+
+#include <algorithm>
+
+namespace optionpp {
+
+  parsed_entry parsed_entry_ref::to_entry() const {
+    parsed_entry entry{original_text.str(), is_option, long_name.str(),
+        short_name, argument.str()};
+    entry.original_without_argument = original_without_argument.str();
+    entry.opt_info = opt_info;
+    return entry;
+  }
+
+  bool parser_result_ref::is_option_set(string_ref long_name) const noexcept {
+    if (long_name.empty())
+      return false;
+    else
+      return std::any_of(begin(), end(),
+                         [&](const parsed_entry_ref& i) {
+                           return i.is_option && i.long_name == long_name;
+                         });
+  }
+
+  bool parser_result_ref::is_option_set(char short_name) const noexcept {
+    if (short_name == '\0')
+      return false;
+    else
+      return std::any_of(begin(), end(),
+                         [&](const parsed_entry_ref& i) {
+                           return i.is_option && i.short_name == short_name;
+                         });
+  }
+
+  string_ref parser_result_ref::get_argument(string_ref long_name) const noexcept {
+    if (long_name.empty())
+      return string_ref{};
+
+    auto it = std::find_if(m_entries.rbegin(), m_entries.rend(),
+                           [&](const parsed_entry_ref& i) {
+                             return i.is_option && i.long_name == long_name;
+                           });
+    if (it != m_entries.rend())
+      return it->argument;
+    else
+      return string_ref{};
+  }
+
+  string_ref parser_result_ref::get_argument(char short_name) const noexcept {
+    if (short_name == '\0')
+      return string_ref{};
+
+    auto it = std::find_if(m_entries.rbegin(), m_entries.rend(),
+                           [=](const parsed_entry_ref& i) {
+                             return i.is_option && i.short_name == short_name;
+                           });
+    if (it != m_entries.rend())
+      return it->argument;
+    else
+      return string_ref{};
+  }
+
+  parser_result parser_result_ref::to_result() const {
+    parser_result result;
+    for (const auto& entry : m_entries)
+      result.push_back(entry.to_entry());
+    return result;
+  }
+
+} // End namespace
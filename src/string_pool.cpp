@@ -0,0 +1,121 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `string_pool` class implementation.
+ */
+
+#include <optionpp/string_pool.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace optionpp {
+
+  constexpr string_pool::id_type string_pool::npos;
+
+  void string_pool::clear() noexcept {
+    m_text.clear();
+    m_records.clear();
+    std::fill(m_slots.begin(), m_slots.end(), slot{0, npos});
+  }
+
+  void string_pool::reserve(size_type count, size_type length) {
+    // Keep the load factor at or below one half
+    size_type slot_count = 16;
+    while (slot_count < 2 * count)
+      slot_count *= 2;
+
+    if (slot_count > m_slots.size())
+      rehash(slot_count);
+    m_records.reserve(count);
+    m_text.reserve(length);
+  }
+
+  auto string_pool::intern(string_ref str, std::uint32_t h) -> id_type {
+    id_type id = find(str, h);
+    if (id != npos)
+      return id;
+
+    const size_type limit = std::numeric_limits<std::uint32_t>::max();
+    if (m_records.size() >= limit - 1 || str.size() > limit - m_text.size())
+      throw std::length_error{"string_pool is full"};
+
+    if (2 * (m_records.size() + 1) > m_slots.size())
+      rehash(std::max<size_type>(16, 2 * m_slots.size()));
+
+    id = static_cast<id_type>(m_records.size());
+    m_records.push_back(record{static_cast<std::uint32_t>(m_text.size()),
+                               static_cast<std::uint32_t>(str.size())});
+    m_text.append(str.data(), str.size());
+    place(slot{h, id});
+    return id;
+  }
+
+  std::uint32_t string_pool::hash(const char* str, size_type length) noexcept {
+    // 32-bit FNV-1a
+    std::uint32_t h = 2166136261u;
+    for (size_type i = 0; i < length; ++i) {
+      h ^= static_cast<unsigned char>(str[i]);
+      h *= 16777619u;
+    }
+    return h;
+  }
+
+  auto string_pool::find(string_ref str, std::uint32_t h) const noexcept
+    -> id_type {
+    if (m_records.empty())
+      return npos;
+
+    size_type mask = m_slots.size() - 1;
+    for (size_type i = h & mask; m_slots[i].id != npos; i = (i + 1) & mask) {
+      const slot& s = m_slots[i];
+      if (s.hash == h) {
+        const record& r = m_records[s.id];
+        if (r.length == str.size()
+            && std::memcmp(m_text.data() + r.offset, str.data(), r.length) == 0)
+          return s.id;
+      }
+    }
+
+    return npos;
+  }
+
+  void string_pool::rehash(size_type slot_count) {
+    std::vector<slot> old(slot_count, slot{0, npos});
+    old.swap(m_slots);
+
+    for (const auto& s : old) {
+      if (s.id != npos)
+        place(s);
+    }
+  }
+
+  void string_pool::place(const slot& entry) noexcept {
+    size_type mask = m_slots.size() - 1;
+    size_type i = entry.hash & mask;
+    while (m_slots[i].id != npos)
+      i = (i + 1) & mask;
+    m_slots[i] = entry;
+  }
+
+} // End namespace
@@ -0,0 +1,70 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `string_ref` class implementation.
+ */
+
+#include <optionpp/string_ref.hpp>
+
+#include <algorithm>
+#include <ostream>
+
+namespace optionpp {
+
+  const string_ref::size_type string_ref::npos;
+
+  auto string_ref::find(char c, size_type pos) const noexcept -> size_type {
+    if (pos >= m_size)
+      return npos;
+
+    const void* found = std::memchr(m_data + pos, c, m_size - pos);
+    if (!found)
+      return npos;
+    return static_cast<const char*>(found) - m_data;
+  }
+
+  auto string_ref::find(string_ref str, size_type pos) const noexcept -> size_type {
+    if (str.m_size == 1)
+      return find(str.m_data[0], pos);
+    if (pos > m_size || str.m_size > m_size - pos)
+      return npos;
+
+    auto it = std::search(begin() + pos, end(), str.begin(), str.end());
+    if (it == end() && !str.empty())
+      return npos;
+    return it - begin();
+  }
+
+  int string_ref::compare(string_ref other) const noexcept {
+    size_type len = std::min(m_size, other.m_size);
+    int result = len ? std::memcmp(m_data, other.m_data, len) : 0;
+    if (result != 0)
+      return result;
+    if (m_size == other.m_size)
+      return 0;
+    return m_size < other.m_size ? -1 : 1;
+  }
+
+  std::ostream& operator<<(std::ostream& os, string_ref str) {
+    return os.write(str.data(), str.size());
+  }
+
+} // End namespace
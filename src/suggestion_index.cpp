@@ -0,0 +1,201 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `suggestion_index` class implementation.
+ */
+
+#include <optionpp/suggestion_index.hpp>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace optionpp {
+
+  constexpr std::uint32_t suggestion_index::none;
+
+  void suggestion_index::insert(string_ref name) {
+    if (name.empty() || m_names.find(name) != string_pool::npos)
+      return;
+
+    if (m_nodes.empty()) {
+      m_names.intern(name);
+      m_nodes.push_back(node{0, none, none});
+      return;
+    }
+
+    // Walk down the branches labeled with the distance to each name
+    size_type current = 0;
+    for (;;) {
+      auto d = static_cast<std::uint32_t>(
+        distance(name, m_names.get(static_cast<string_pool::id_type>(current)),
+                 none - 1));
+
+      std::uint32_t child = m_nodes[current].first_child;
+      while (child != none && m_nodes[child].distance != d)
+        child = m_nodes[child].next_sibling;
+
+      if (child == none) {
+        m_names.intern(name);
+        m_nodes.push_back(node{d, none, m_nodes[current].first_child});
+        m_nodes[current].first_child = static_cast<std::uint32_t>(m_nodes.size() - 1);
+        return;
+      }
+      current = child;
+    }
+  }
+
+  std::vector<std::string> suggestion_index::find(string_ref word,
+                                                  size_type max_distance,
+                                                  size_type max_results) const {
+    // Words of up to 64 characters are compared with the bit-parallel
+    // algorithm, using a match mask for each character of the word
+    const bool bit_parallel = !word.empty() && word.size() <= 64;
+    std::array<std::uint64_t, 256> masks{};
+    if (bit_parallel) {
+      for (size_type i = 0; i < word.size(); ++i)
+        masks[static_cast<unsigned char>(word[i])] |= std::uint64_t{1} << i;
+    }
+
+    std::vector<std::pair<size_type, size_type>> matches; // (distance, node)
+    std::vector<size_type> pending;
+    if (!m_nodes.empty())
+      pending.push_back(0);
+
+    while (!pending.empty()) {
+      size_type current = pending.back();
+      pending.pop_back();
+
+      // Names in a branch labeled k are at distance k from this name,
+      // so by the triangle inequality only branches within
+      // max_distance of d can hold matches
+      // The exact distance is only needed up to the largest branch
+      // label that could still be followed
+      size_type limit = 0;
+      for (size_type child = m_nodes[current].first_child; child != none;
+           child = m_nodes[child].next_sibling)
+        limit = std::max<size_type>(limit, m_nodes[child].distance);
+      limit += max_distance;
+
+      string_ref name = m_names.get(static_cast<string_pool::id_type>(current));
+      size_type d = bit_parallel ? distance(masks.data(), word.size(), name, limit)
+                                 : distance(word, name, limit);
+      if (d <= max_distance)
+        matches.emplace_back(d, current);
+      if (d > limit)
+        continue;
+
+      size_type low = d > max_distance ? d - max_distance : 0;
+      size_type high = d + max_distance;
+      for (size_type child = m_nodes[current].first_child; child != none;
+           child = m_nodes[child].next_sibling) {
+        if (m_nodes[child].distance >= low && m_nodes[child].distance <= high)
+          pending.push_back(child);
+      }
+    }
+
+    std::sort(matches.begin(), matches.end(),
+              [this](const std::pair<size_type, size_type>& a,
+                     const std::pair<size_type, size_type>& b) {
+                if (a.first != b.first)
+                  return a.first < b.first;
+                return m_names.get(static_cast<string_pool::id_type>(a.second))
+                  < m_names.get(static_cast<string_pool::id_type>(b.second));
+              });
+
+    std::vector<std::string> result;
+    for (size_type i = 0; i < matches.size() && i < max_results; ++i)
+      result.push_back(m_names.get(static_cast<string_pool::id_type>(matches[i].second)).str());
+    return result;
+  }
+
+  auto suggestion_index::distance(const std::uint64_t* masks, size_type length,
+                                  string_ref text, size_type limit) noexcept
+    -> size_type {
+    if (text.size() > length + limit || length > text.size() + limit)
+      return limit + 1;
+
+    // Myers' algorithm as formulated by Hyyrö: the vertical deltas of
+    // one column of the dynamic programming table are kept as bit
+    // vectors, so that each character of the text is processed in a
+    // few word operations
+    const std::uint64_t last = std::uint64_t{1} << (length - 1);
+    std::uint64_t plus = ~std::uint64_t{0};
+    std::uint64_t minus = 0;
+    size_type score = length;
+    for (size_type i = 0; i < text.size(); ++i) {
+      std::uint64_t eq = masks[static_cast<unsigned char>(text[i])];
+      std::uint64_t xv = eq | minus;
+      std::uint64_t xh = (((eq & plus) + plus) ^ plus) | eq;
+      std::uint64_t hplus = minus | ~(xh | plus);
+      std::uint64_t hminus = plus & xh;
+      if (hplus & last)
+        ++score;
+      else if (hminus & last)
+        --score;
+      hplus = (hplus << 1) | 1;
+      hminus <<= 1;
+      plus = hminus | ~(xv | hplus);
+      minus = hplus & xv;
+    }
+
+    return std::min(score, limit + 1);
+  }
+
+  auto suggestion_index::distance(string_ref a, string_ref b, size_type limit)
+    -> size_type {
+    if (a.size() < b.size())
+      std::swap(a, b);
+    if (a.size() - b.size() > limit)
+      return limit + 1;
+
+    // One row of the dynamic programming table, over the shorter
+    // string; option names nearly always fit in the local buffer
+    const size_type local_size = 64;
+    size_type local_row[local_size];
+    std::vector<size_type> heap_row;
+    size_type* row = local_row;
+    if (b.size() >= local_size) {
+      heap_row.resize(b.size() + 1);
+      row = heap_row.data();
+    }
+    for (size_type j = 0; j <= b.size(); ++j)
+      row[j] = j;
+
+    for (size_type i = 1; i <= a.size(); ++i) {
+      size_type diagonal = row[0];
+      row[0] = i;
+      size_type row_min = row[0];
+      for (size_type j = 1; j <= b.size(); ++j) {
+        size_type above = row[j];
+        size_type cost = a[i - 1] == b[j - 1] ? 0 : 1;
+        row[j] = std::min(std::min(above, row[j - 1]) + 1, diagonal + cost);
+        diagonal = above;
+        row_min = std::min(row_min, row[j]);
+      }
+      if (row_min > limit)
+        return limit + 1;
+    }
+
+    return std::min(row[b.size()], limit + 1);
+  }
+
+} // End namespace
@@ -0,0 +1,93 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `text_arena` class implementation.
+ */
+
+#include <optionpp/text_arena.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace optionpp {
+
+  text_arena::text_arena(text_arena&& other) noexcept
+    : m_blocks{std::move(other.m_blocks)},
+      m_block_size{other.m_block_size},
+      m_current{other.m_current},
+      m_used{other.m_used} {
+    other.release();
+  }
+
+  text_arena& text_arena::operator=(text_arena&& other) noexcept {
+    if (this != &other) {
+      m_blocks = std::move(other.m_blocks);
+      m_block_size = other.m_block_size;
+      m_current = other.m_current;
+      m_used = other.m_used;
+      other.release();
+    }
+    return *this;
+  }
+
+  string_ref text_arena::store(string_ref str) {
+    if (str.empty())
+      return string_ref{};
+
+    char* dest = allocate(str.size());
+    std::memcpy(dest, str.data(), str.size());
+    return string_ref{dest, str.size()};
+  }
+
+  string_ref text_arena::store(string_ref a, string_ref b, string_ref c) {
+    size_type length = a.size() + b.size() + c.size();
+    if (length == 0)
+      return string_ref{};
+
+    char* dest = allocate(length);
+    char* pos = dest;
+    for (string_ref part : { a, b, c }) {
+      if (!part.empty())
+        std::memcpy(pos, part.data(), part.size());
+      pos += part.size();
+    }
+    return string_ref{dest, length};
+  }
+
+  char* text_arena::allocate(size_type length) {
+    while (m_current < m_blocks.size()
+           && m_blocks[m_current].size - m_used < length) {
+      ++m_current;
+      m_used = 0;
+    }
+
+    if (m_current == m_blocks.size()) {
+      size_type size = std::max(m_block_size, length);
+      m_blocks.push_back(block{std::unique_ptr<char[]>{new char[size]}, size});
+    }
+
+    char* result = m_blocks[m_current].data.get() + m_used;
+    m_used += length;
+    return result;
+  }
+
+} // End namespace
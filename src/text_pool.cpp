@@ -0,0 +1,59 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+
+/**
+ * @file
+ * @brief Source file for `text_pool` class implementation.
+ */
+
+#include <optionpp/text_pool.hpp>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace optionpp {
+
+  const text_pool::size_type text_pool::first_block_size;
+  const text_pool::size_type text_pool::max_blocks;
+
+  auto text_pool::store(string_ref str) -> span {
+    if (str.empty())
+      return span{0, 0};
+
+    // A string that does not fit in the rest of the current block
+    // goes at the start of the first later block large enough for it
+    size_type b = block_of(static_cast<std::uint32_t>(m_end));
+    size_type offset = m_end;
+    while (b >= max_blocks || str.size() > block_start(b + 1) - offset) {
+      if (++b >= max_blocks)
+        throw std::length_error{"text_pool is full"};
+      offset = block_start(b);
+    }
+
+    if (!m_blocks[b])
+      m_blocks[b].reset(new char[block_start(b + 1) - block_start(b)]);
+    std::memcpy(m_blocks[b].get() + (offset - block_start(b)),
+                str.data(), str.size());
+    m_end = offset + str.size();
+    return span{static_cast<std::uint32_t>(offset),
+                static_cast<std::uint32_t>(str.size())};
+  }
+
+} // End namespace
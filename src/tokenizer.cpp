@@ -0,0 +1,209 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+/**
+ * @file
+ * @brief Source file for `tokenizer` class implementation.
+ */
+
+#include <optionpp/tokenizer.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace optionpp {
+
+  namespace {
+
+    /**
+     * @brief Return the position of the lowest set bit.
+     * @param mask Nonzero bit mask.
+     * @return Number of trailing zero bits.
+     */
+    inline unsigned lowest_bit(unsigned mask) noexcept {
+#if defined(_MSC_VER)
+      unsigned long index;
+      _BitScanForward(&index, mask);
+      return static_cast<unsigned>(index);
+#else
+      return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+    /**
+     * @brief Largest number of special characters that are compared
+     *        in parallel; larger sets fall back to the lookup table.
+     */
+    const std::string::size_type max_parallel_chars = 8;
+
+  } // End namespace
+
+  tokenizer::tokenizer(const std::string& delims, const std::string& quotes,
+                       char escape_char, bool allow_empty)
+    : m_allow_empty{allow_empty} {
+    m_classes.fill(plain);
+    for (char c : delims)
+      m_classes[static_cast<unsigned char>(c)] |= delim;
+    for (char c : quotes)
+      m_classes[static_cast<unsigned char>(c)] |= quote;
+    m_classes[static_cast<unsigned char>(escape_char)] |= escape;
+
+    for (unsigned c = 0; c != m_classes.size(); ++c) {
+      if (m_classes[c] != plain)
+        m_specials.push_back(static_cast<char>(c));
+    }
+  }
+
+  bool tokenizer::next(string_ref input, size_type& pos, string_ref& token,
+                       std::string& buffer) const {
+    const char* data = input.data();
+    const char* end = data + input.size();
+
+    // After the last token, pos is one past the end of the input
+    while (pos <= input.size()) {
+      const char* start = data + pos;
+      const char* found = find_special(start, end);
+
+      if (found == end) { // Last token
+        token = string_ref{start, static_cast<size_type>(end - start)};
+        pos = input.size() + 1;
+      } else if (m_classes[static_cast<unsigned char>(*found)] & delim) {
+        token = string_ref{start, static_cast<size_type>(found - start)};
+        pos = found - data + 1;
+      } else { // Quote or escape character, so the token must be rebuilt
+        buffer.assign(start, found);
+        pos = found - data;
+        if (!finish_token(input, pos, buffer))
+          pos = input.size() + 1;
+        token = string_ref{buffer};
+      }
+
+      if (!token.empty() || m_allow_empty)
+        return true;
+    }
+
+    return false;
+  }
+
+  bool tokenizer::finish_token(string_ref input, size_type& pos,
+                               std::string& buffer) const {
+    const char* data = input.data();
+    bool escape_next = false;
+    bool in_quotes = false;
+    char closing_quote = '\0';
+
+    while (pos < input.size()) {
+      char c = data[pos];
+      unsigned char cls = m_classes[static_cast<unsigned char>(c)];
+
+      if (in_quotes) {
+        // Look for closing quote, unless we are escaping
+        if (escape_next) {
+          buffer.push_back(c);
+          escape_next = false;
+        } else if (c == closing_quote) {
+          in_quotes = false;
+        } else if (cls & escape) {
+          escape_next = true;
+        } else {
+          buffer.push_back(c);
+        }
+      } else if (escape_next) {
+        buffer.push_back(c);
+        escape_next = false;
+      } else if (cls & delim) {
+        ++pos;
+        return true;
+      } else if (cls & escape) {
+        escape_next = true;
+      } else if (cls & quote) {
+        in_quotes = true;
+        closing_quote = c;
+      } else { // Copy a run of ordinary characters at once
+        const char* found = find_special(data + pos, data + input.size());
+        buffer.append(data + pos, found);
+        pos = found - data;
+        continue;
+      }
+
+      ++pos;
+    }
+
+    return false;
+  }
+
+  const char* tokenizer::find_special(const char* first,
+                                      const char* last) const noexcept {
+    const auto count = m_specials.size();
+    if (count == 0)
+      return last;
+
+    if (count <= max_parallel_chars) {
+#if defined(__AVX2__)
+      __m256i needles32[max_parallel_chars];
+      for (std::string::size_type i = 0; i != count; ++i)
+        needles32[i] = _mm256_set1_epi8(m_specials[i]);
+
+      while (last - first >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        __m256i match = _mm256_cmpeq_epi8(block, needles32[0]);
+        for (std::string::size_type i = 1; i != count; ++i)
+          match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, needles32[i]));
+
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(match));
+        if (mask != 0)
+          return first + lowest_bit(mask);
+        first += 32;
+      }
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+      __m128i needles16[max_parallel_chars];
+      for (std::string::size_type i = 0; i != count; ++i)
+        needles16[i] = _mm_set1_epi8(m_specials[i]);
+
+      while (last - first >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i match = _mm_cmpeq_epi8(block, needles16[0]);
+        for (std::string::size_type i = 1; i != count; ++i)
+          match = _mm_or_si128(match, _mm_cmpeq_epi8(block, needles16[i]));
+
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(match));
+        if (mask != 0)
+          return first + lowest_bit(mask);
+        first += 16;
+      }
+#endif
+    }
+
+    // Check the remaining characters one at a time
+    for (; first != last; ++first) {
+      if (m_classes[static_cast<unsigned char>(*first)] != plain)
+        return first;
+    }
+    return last;
+  }
+
+} // End namespace
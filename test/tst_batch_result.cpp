@@ -0,0 +1,181 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/parser.hpp>
+
+using namespace optionpp;
+
+namespace {
+
+  void check_same(const batch_result& batch,
+                  const std::vector<std::string>& lines,
+                  const parser& p) {
+    REQUIRE(batch.line_count() == lines.size());
+    batch_result::size_type errors = 0;
+    for (batch_result::size_type line = 0; line < lines.size(); ++line) {
+      parser_result expected;
+      std::string message;
+      try {
+        expected = p.parse(lines[line]);
+      } catch (const parse_error& e) {
+        message = e.what();
+      }
+
+      if (message.empty()) {
+        REQUIRE(batch.ok(line));
+        REQUIRE(batch.error_message(line).empty());
+      } else {
+        ++errors;
+        REQUIRE_FALSE(batch.ok(line));
+        REQUIRE(batch.error_message(line) == message);
+      }
+
+      REQUIRE(batch.entry_count(line) == expected.size());
+      auto first = batch.first_entry(line);
+      for (parser_result::size_type i = 0; i < expected.size(); ++i) {
+        REQUIRE(batch.original_text()[first + i] == expected[i].original_text);
+        REQUIRE(batch.original_without_argument()[first + i]
+                == expected[i].original_without_argument);
+        REQUIRE((batch.is_option()[first + i] != 0) == expected[i].is_option);
+        REQUIRE(batch.long_name()[first + i] == expected[i].long_name);
+        REQUIRE(batch.short_name()[first + i] == expected[i].short_name);
+        REQUIRE(batch.argument()[first + i] == expected[i].argument);
+        REQUIRE(batch.opt_info()[first + i] == expected[i].opt_info);
+      }
+    }
+    REQUIRE(batch.error_count() == errors);
+  }
+
+} // End namespace
+
+TEST_CASE("batch_result") {
+  int width = 0;
+  parser p;
+  p["help"].short_name('?');
+  p["verbose"].short_name('v');
+  p["all"].short_name('a');
+  p["width"].short_name('w').bind_int(&width);
+  p["output"].short_name('o').argument("FILE", false);
+
+  std::vector<std::string> lines{ "-v? file --width=3",
+                                  "--output out.txt -- --help",
+                                  "--quiet -v",
+                                  "",
+                                  "-vw 12 -o",
+                                  "-vw",
+                                  "-?o=file1 file2",
+                                  "-vw x",
+                                  "-avo file -vaw=8 -vaw9 -aov -w 2",
+                                  "\"quoted file\" -o 'some file'",
+                                  "--output --help -o -v" };
+
+  SECTION("same results as parse") {
+    auto batch = p.parse_batch(lines.begin(), lines.end());
+    width = 0;
+    check_same(batch, lines, p);
+    REQUIRE(batch.error_count() == 3);
+    REQUIRE(batch.error_option(2) == "--quiet");
+    REQUIRE(batch.error(2) == parse_errc::invalid_option);
+    REQUIRE(batch.error_token(5) == 0);
+    REQUIRE(batch.error_offset(5) == 2);
+    REQUIRE(batch.error(7) == parse_errc::not_an_integer);
+    REQUIRE(batch.error_token(7) == 1);
+    REQUIRE(batch.error(0) == parse_errc::none);
+    REQUIRE(batch.entry_count(3) == 0);
+    REQUIRE(batch.original_text()[batch.first_entry(9)] == "quoted file");
+    REQUIRE(batch.argument()[batch.first_entry(9) + 1] == "some file");
+  }
+
+  SECTION("bound variables are not written") {
+    auto batch = p.parse_batch(lines.begin(), lines.end());
+    REQUIRE(width == 0);
+    REQUIRE(batch.argument()[batch.first_entry(4) + 1] == "12");
+  }
+
+  SECTION("ignore first") {
+    std::vector<std::string> cmds{ "prog -v", "prog --width=1 file" };
+    auto batch = p.compile().parse_batch(cmds.begin(), cmds.end(), true);
+    REQUIRE(batch.line_count() == 2);
+    REQUIRE(batch.entry_count() == 3);
+    REQUIRE(batch.short_name()[0] == 'v');
+    REQUIRE(batch.original_text()[2] == "file");
+  }
+
+  SECTION("parallel") {
+    std::vector<std::string> many;
+    for (int i = 0; i < 50; ++i)
+      many.insert(many.end(), lines.begin(), lines.end());
+
+    std::vector<std::thread> threads;
+    auto executor = [&](std::function<void()> task) {
+      threads.emplace_back(std::move(task));
+    };
+    auto batch = p.parse_batch(many.begin(), many.end(), executor, 7);
+    for (auto& t : threads)
+      t.join();
+    REQUIRE(threads.size() == (many.size() + 6) / 7);
+    check_same(batch, many, p);
+
+    auto serial = p.parse_batch(many.begin(), many.end(), nullptr);
+    REQUIRE(serial.entry_count() == batch.entry_count());
+    REQUIRE(serial.error_count() == batch.error_count());
+    REQUIRE(serial.original_text() == batch.original_text());
+  }
+
+  SECTION("executor failure") {
+    int submitted = 0;
+    auto executor = [&](std::function<void()> task) {
+      if (submitted++ == 2)
+        throw std::runtime_error("pool is full");
+      task();
+    };
+    REQUIRE_THROWS_WITH(p.parse_batch(lines.begin(), lines.end(), executor, 2),
+                        "pool is full");
+  }
+
+  SECTION("access") {
+    auto batch = p.parse_batch(lines.begin(), lines.end());
+    auto result = batch.line_result(1);
+    REQUIRE(result.size() == 2);
+    REQUIRE(result[0].argument == "out.txt");
+    REQUIRE(result.is_option_set("output"));
+    REQUIRE_FALSE(result[1].is_option);
+
+    auto entry = batch.entry(batch.first_entry(1));
+    REQUIRE(entry.original_text == "--output out.txt");
+    REQUIRE(entry.original_without_argument == "--output");
+    REQUIRE_THROWS_AS(batch.entry(batch.entry_count()), out_of_range);
+    REQUIRE_THROWS_AS(batch.line_result(lines.size()), out_of_range);
+
+    batch_result moved{std::move(batch)};
+    REQUIRE(batch.line_count() == 0);
+    REQUIRE(moved.line_count() == lines.size());
+
+    moved.clear();
+    REQUIRE(moved.line_count() == 0);
+    REQUIRE(moved.entry_count() == 0);
+    REQUIRE(moved.error_count() == 0);
+  }
+}
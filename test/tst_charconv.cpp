@@ -0,0 +1,196 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+#include <catch2/catch.hpp>
+#include <optionpp/charconv.hpp>
+
+using namespace optionpp;
+
+namespace {
+
+  template <typename T>
+  from_chars_result convert(const std::string& str, T& value) {
+    return from_chars(str.data(), str.data() + str.size(), value);
+  }
+
+  std::uint64_t bits_of(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    return bits;
+  }
+
+  // Compare with strtod, which is correctly rounded in the C locale
+  void check_double(const std::string& str) {
+    INFO(str);
+    double value = 0;
+    auto result = convert(str, value);
+    REQUIRE(result.ptr == str.data() + str.size());
+    double expected = std::strtod(str.c_str(), nullptr);
+    if (result.ec == std::errc{})
+      REQUIRE(bits_of(value) == bits_of(expected));
+    else
+      REQUIRE((expected == 0.0 || std::isinf(expected)));
+  }
+
+} // End namespace
+
+TEST_CASE("from_chars") {
+  SECTION("integers") {
+    long long value = 7;
+    auto result = convert("12345", value);
+    REQUIRE(result.ec == std::errc{});
+    REQUIRE(value == 12345);
+
+    std::string str = "-42abc";
+    result = convert(str, value);
+    REQUIRE(result.ec == std::errc{});
+    REQUIRE(result.ptr == str.data() + 3);
+    REQUIRE(value == -42);
+
+    REQUIRE(convert("+8", value).ec == std::errc{});
+    REQUIRE(value == 8);
+
+    str = "x1";
+    result = convert(str, value);
+    REQUIRE(result.ec == std::errc::invalid_argument);
+    REQUIRE(result.ptr == str.data());
+    REQUIRE(convert("-", value).ec == std::errc::invalid_argument);
+    REQUIRE(convert("", value).ec == std::errc::invalid_argument);
+    REQUIRE(convert(" 1", value).ec == std::errc::invalid_argument);
+    REQUIRE(value == 8);
+
+    REQUIRE(convert("9223372036854775807", value).ec == std::errc{});
+    REQUIRE(value == std::numeric_limits<long long>::max());
+    REQUIRE(convert("-9223372036854775808", value).ec == std::errc{});
+    REQUIRE(value == std::numeric_limits<long long>::min());
+    str = "9223372036854775808";
+    result = convert(str, value);
+    REQUIRE(result.ec == std::errc::result_out_of_range);
+    REQUIRE(result.ptr == str.data() + str.size());
+    REQUIRE(value == std::numeric_limits<long long>::min());
+
+    unsigned long long uvalue = 0;
+    REQUIRE(convert("18446744073709551615", uvalue).ec == std::errc{});
+    REQUIRE(uvalue == std::numeric_limits<unsigned long long>::max());
+    REQUIRE(convert("18446744073709551616", uvalue).ec
+            == std::errc::result_out_of_range);
+    REQUIRE(convert("-1", uvalue).ec == std::errc::invalid_argument);
+
+    int ivalue = 0;
+    REQUIRE(convert("-2147483648", ivalue).ec == std::errc{});
+    REQUIRE(ivalue == std::numeric_limits<int>::min());
+    REQUIRE(convert("2147483648", ivalue).ec == std::errc::result_out_of_range);
+
+    unsigned uivalue = 0;
+    REQUIRE(convert("4294967295", uivalue).ec == std::errc{});
+    REQUIRE(uivalue == std::numeric_limits<unsigned>::max());
+    REQUIRE(convert("4294967296", uivalue).ec == std::errc::result_out_of_range);
+  }
+
+  SECTION("doubles") {
+    double value = 0;
+    REQUIRE(convert("-12.08e+4", value).ec == std::errc{});
+    REQUIRE(value == -12.08e4);
+    REQUIRE(convert(".5", value).ec == std::errc{});
+    REQUIRE(value == 0.5);
+    REQUIRE(convert("3.", value).ec == std::errc{});
+    REQUIRE(value == 3.0);
+    REQUIRE(convert("-0", value).ec == std::errc{});
+    REQUIRE(value == 0.0);
+    REQUIRE(std::signbit(value));
+
+    std::string str = "2e";
+    auto result = convert(str, value);
+    REQUIRE(result.ec == std::errc{});
+    REQUIRE(result.ptr == str.data() + 1);
+    REQUIRE(value == 2.0);
+
+    str = "1.5e+x";
+    result = convert(str, value);
+    REQUIRE(result.ptr == str.data() + 3);
+
+    REQUIRE(convert(".", value).ec == std::errc::invalid_argument);
+    REQUIRE(convert("e5", value).ec == std::errc::invalid_argument);
+    REQUIRE(convert("+", value).ec == std::errc::invalid_argument);
+    REQUIRE(value == 1.5);
+
+    REQUIRE(convert("inf", value).ec == std::errc{});
+    REQUIRE(std::isinf(value));
+    REQUIRE(convert("-Infinity", value).ec == std::errc{});
+    REQUIRE(std::isinf(value));
+    REQUIRE(value < 0);
+    REQUIRE(convert("NaN", value).ec == std::errc{});
+    REQUIRE(std::isnan(value));
+
+    value = 1.0;
+    REQUIRE(convert("1e400", value).ec == std::errc::result_out_of_range);
+    REQUIRE(convert("-1e400", value).ec == std::errc::result_out_of_range);
+    REQUIRE(convert("1e-400", value).ec == std::errc::result_out_of_range);
+    REQUIRE(value == 1.0);
+    REQUIRE(convert("0e999999999999", value).ec == std::errc{});
+    REQUIRE(value == 0.0);
+  }
+
+  SECTION("correct rounding") {
+    for (const char* str : { "0.1", "1e23", "8.41e21", "9007199254740993",
+          "9007199254740992.5", "2.2250738585072011e-308",
+          "2.2250738585072014e-308", "4.9e-324", "2.4703282292062328e-324",
+          "1.7976931348623157e308", "7.3177701707893310e+15",
+          "0.000000000000000000000000000000000000000001234567",
+          "123456789012345678901234567890", "3.14159265358979323846264338327950288",
+          "1.00000000000000011102230246251565404236316680908203125",
+          "1.00000000000000011102230246251565404236316680908203124",
+          "1.7976931348623158e308", "1e-320", "5e-324", "1e22", "1e-22" })
+      check_double(str);
+
+    std::mt19937_64 gen{1234};
+    std::uniform_int_distribution<std::uint64_t> mantissa_dist;
+    std::uniform_int_distribution<int> digits_dist{1, 19};
+    std::uniform_int_distribution<int> exp_dist{-340, 310};
+    for (int i = 0; i < 20000; ++i) {
+      std::string digits = std::to_string(mantissa_dist(gen));
+      digits.resize(std::min<std::size_t>(digits.size(), digits_dist(gen)));
+      std::string str = digits + "e" + std::to_string(exp_dist(gen));
+      check_double(str);
+      check_double(digits.substr(0, 1) + "." + digits.substr(1) + "e"
+                   + std::to_string(exp_dist(gen) / 10));
+    }
+
+    // Random doubles printed with enough digits to round-trip
+    std::uniform_int_distribution<std::uint64_t> bits_dist{0, 0x7fefffffffffffff};
+    char buffer[64];
+    for (int i = 0; i < 20000; ++i) {
+      std::uint64_t bits = bits_dist(gen);
+      double d;
+      std::memcpy(&d, &bits, sizeof d);
+      std::snprintf(buffer, sizeof buffer, "%.17g", d);
+      check_double(buffer);
+    }
+  }
+}
@@ -0,0 +1,181 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/command_parser.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("command_parser") {
+  int status_builds = 0;
+  int remote_builds = 0;
+
+  command_parser ctl;
+  ctl.options()["verbose"].short_name('v');
+  ctl.options()["config"].short_name('c').argument("FILE", true);
+  ctl.add_command("status", [&](command_parser& status) {
+      ++status_builds;
+      status.options()["short"].short_name('s');
+    });
+  ctl.add_command("remote", [&](command_parser& remote) {
+      ++remote_builds;
+      remote.options()["verbose"].short_name('v');
+      remote.add_command("add", [](command_parser& add) {
+          add.options()["fetch"].short_name('f');
+        });
+      remote.add_command("remove", nullptr);
+    });
+
+  command_result result;
+  parse_status status;
+
+  SECTION("lazy construction") {
+    CHECK(ctl.command_count() == 2);
+    CHECK(ctl.has_command("status"));
+    CHECK(!ctl.has_command("commit"));
+    CHECK(!ctl.is_command_built("status"));
+    CHECK(!ctl.is_command_built("remote"));
+
+    result = ctl.parse("-v status -s");
+    CHECK(status_builds == 1);
+    CHECK(remote_builds == 0);
+    CHECK(ctl.is_command_built("status"));
+    CHECK(!ctl.is_command_built("remote"));
+
+    ctl.parse("status");
+    CHECK(status_builds == 1);
+
+    ctl.command("remote");
+    CHECK(remote_builds == 1);
+    CHECK(ctl.command("remote").command_count() == 2);
+    CHECK_THROWS_AS(ctl.command("commit"), out_of_range);
+  }
+
+  SECTION("options before and after") {
+    result = ctl.parse("-v --config=file status -s extra");
+    REQUIRE(result.command_path() == std::vector<std::string>{"status"});
+    REQUIRE(result.size() == 2);
+    CHECK(result.has_command());
+
+    const auto& global = result.global_options();
+    REQUIRE(global.size() == 2);
+    CHECK(global[0].long_name == "verbose");
+    CHECK(global[1].long_name == "config");
+    CHECK(global[1].argument == "file");
+
+    const auto& local = result.command_options();
+    REQUIRE(local.size() == 2);
+    CHECK(local[0].long_name == "short");
+    CHECK(!local[1].is_option);
+    CHECK(local[1].original_text == "extra");
+    CHECK(&result[1] == &local);
+  }
+
+  SECTION("options are separate per level") {
+    ctl.parse_into(result, "-s status", status, false);
+    CHECK(status.error() == parse_errc::invalid_option);
+    CHECK(status.option() == "-s");
+
+    ctl.parse_into(result, "status -v", status, false);
+    CHECK(status.error() == parse_errc::invalid_option);
+    CHECK(status.token_index() == 1);
+  }
+
+  SECTION("nested commands") {
+    result = ctl.parse("prog -v remote -v add -f origin url", true);
+    REQUIRE(result.command_path()
+            == std::vector<std::string>{"remote", "add"});
+    REQUIRE(result.size() == 3);
+    CHECK(result[0].is_option_set("verbose"));
+    CHECK(result[1].is_option_set("verbose"));
+    REQUIRE(result[2].size() == 3);
+    CHECK(result[2].is_option_set("fetch"));
+    CHECK(result[2][1].original_text == "origin");
+    CHECK(result[2][2].original_text == "url");
+    CHECK_THROWS_AS(result.at(3), out_of_range);
+
+    result = ctl.parse("remote remove");
+    CHECK(result.command_path()
+          == std::vector<std::string>{"remote", "remove"});
+    CHECK(result.command_options().empty());
+  }
+
+  SECTION("no command") {
+    result = ctl.parse("-v");
+    CHECK(!result.has_command());
+    CHECK(result.size() == 1);
+    CHECK(&result.global_options() == &result.command_options());
+
+    result = ctl.parse("-v -- status");
+    CHECK(!result.has_command());
+    REQUIRE(result.global_options().size() == 2);
+    CHECK(result.global_options()[1].original_text == "status");
+  }
+
+  SECTION("unknown command") {
+    ctl.parse_into(result, "-v commit -a", status, false);
+    CHECK(status.error() == parse_errc::unknown_command);
+    CHECK(status.token_index() == 1);
+    CHECK(status.option() == "commit");
+    CHECK(status.message() == "unknown command: 'commit'");
+    CHECK(result.global_options().size() == 1);
+    CHECK(!result.has_command());
+
+    CHECK_THROWS_AS(ctl.parse("remote fetch"), parse_error);
+    CHECK(remote_builds == 1);
+  }
+
+  SECTION("argc, argv") {
+    char prog[] = "prog", cmd[] = "remote", add[] = "add", opt[] = "-f";
+    char* argv[] = {prog, cmd, add, opt};
+    ctl.parse_into(result, 4, argv, status);
+    REQUIRE(status);
+    CHECK(result.command_path()
+          == std::vector<std::string>{"remote", "add"});
+    CHECK(result.command_options().is_option_set('f'));
+  }
+
+  SECTION("factory uses parent") {
+    bool status_was_built = true;
+    ctl.add_command("log", [&](command_parser& log) {
+        status_was_built = ctl.is_command_built("status");
+        log.options()["short"] = ctl.command("status").options()["short"];
+      });
+
+    result = ctl.parse("log -s");
+    CHECK(!status_was_built);
+    CHECK(status_builds == 1);
+    CHECK(ctl.is_command_built("log"));
+    CHECK(result.command_options().is_option_set('s'));
+  }
+
+  SECTION("replaced command") {
+    ctl.parse("status");
+    ctl.add_command("status", [](command_parser& status) {
+        status.options()["long"];
+      });
+    CHECK(ctl.command_count() == 2);
+    CHECK(!ctl.is_command_built("status"));
+    result = ctl.parse("status --long");
+    CHECK(result.command_options().is_option_set("long"));
+    CHECK(status_builds == 1);
+  }
+}
@@ -0,0 +1,240 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/parser.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("compiled_parser") {
+  int width = 0;
+  parser p;
+  p["help"].short_name('?');
+  p["verbose"].short_name('v');
+  p.group("Output options")["width"].short_name('w').bind_int(&width);
+  p.group("Output options")["output"].short_name('o').argument("FILE", false);
+  p.set_custom_strings(" ,");
+
+  compiled_parser compiled = p.compile();
+
+  SECTION("default constructor") {
+    compiled_parser empty;
+    REQUIRE(empty.size() == 0);
+    REQUIRE(empty.parse("file").size() == 1);
+    REQUIRE_THROWS_AS(empty.parse("--help"), parse_error);
+  }
+
+  SECTION("same results as parser") {
+    REQUIRE(compiled.size() == 4);
+
+    for (const std::string cmd : { "-v?,file --width=3",
+                                   "--output out.txt -- --help",
+                                   "-vw 12 -o",
+                                   "-?o=file1 file2" }) {
+      auto expected = p.parse(cmd);
+      auto result = compiled.parse(cmd);
+      REQUIRE(result.size() == expected.size());
+      for (parser_result::size_type i = 0; i < result.size(); ++i) {
+        REQUIRE(result[i].original_text == expected[i].original_text);
+        REQUIRE(result[i].is_option == expected[i].is_option);
+        REQUIRE(result[i].long_name == expected[i].long_name);
+        REQUIRE(result[i].short_name == expected[i].short_name);
+        REQUIRE(result[i].argument == expected[i].argument);
+      }
+    }
+
+    std::vector<std::string> args{"prog", "--width", "7", "-v"};
+    auto result = compiled.parse(args.begin(), args.end());
+    REQUIRE(result.size() == 2);
+    REQUIRE(width == 7);
+
+    REQUIRE_THROWS_WITH(compiled.parse("--quiet"), "invalid option: '--quiet'");
+    REQUIRE_THROWS_WITH(compiled.parse("-w"), "option '-w' requires an argument");
+    REQUIRE_THROWS_WITH(compiled.parse("-w x"),
+                        "argument for option '-w' must be an integer");
+  }
+
+  SECTION("independent of parser") {
+    p["quiet"].short_name('q');
+    p.set_custom_strings(" ", "/", "//");
+    REQUIRE(p.parse("/q").size() == 1);
+    REQUIRE_THROWS_AS(compiled.parse("-q"), parse_error);
+    REQUIRE(compiled.parse("-v,--help").size() == 2);
+
+    auto result = compiled.parse("--verbose");
+    REQUIRE(result[0].opt_info != &p["verbose"]);
+    REQUIRE(result[0].opt_info->long_name() == "verbose");
+  }
+
+  SECTION("copy and move") {
+    compiled_parser copy{compiled};
+    compiled = compiled_parser{};
+    REQUIRE(copy.size() == 4);
+    REQUIRE(copy.parse("-v --output").size() == 2);
+    REQUIRE_THROWS_AS(compiled.parse("-v"), parse_error);
+
+    compiled_parser moved{std::move(copy)};
+    REQUIRE(moved.parse("--help").size() == 1);
+    compiled = moved;
+    REQUIRE(compiled.parse("--width=5").size() == 1);
+    REQUIRE(width == 5);
+  }
+
+  SECTION("large option table") {
+    parser big;
+    for (int i = 0; i < 4000; ++i)
+      big.group("group " + std::to_string(i % 60))["option-" + std::to_string(i)];
+    auto big_compiled = big.compile();
+    REQUIRE(big_compiled.size() == 4000);
+    auto result = big_compiled.parse("--option-0 --option-2999 --option-3999");
+    REQUIRE(result.size() == 3);
+    REQUIRE(result[1].long_name == "option-2999");
+    REQUIRE_THROWS_AS(big_compiled.parse("--option-4000"), parse_error);
+  }
+
+  SECTION("shared between threads") {
+    std::vector<std::thread> threads;
+    std::vector<std::size_t> sizes(4);
+    for (std::size_t t = 0; t < sizes.size(); ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = 0; i < 100; ++i)
+          sizes[t] = compiled.parse("-v? --output=x y z").size();
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    for (auto size : sizes)
+      REQUIRE(size == 5);
+  }
+}
+
+TEST_CASE("compiled_parser parallel parsing") {
+  int width = 0;
+  bool verbose = false;
+  parser p;
+  p["verbose"].short_name('v').bind_bool(&verbose);
+  p["width"].short_name('w').bind_int(&width);
+  p["output"].short_name('o').argument("FILE", false);
+  p["name"].short_name('n').argument("NAME", true);
+  compiled_parser compiled = p.compile();
+
+  auto inline_executor = [](std::function<void()> task) { task(); };
+
+  SECTION("same results as serial parsing") {
+    const std::vector<std::string> pool{"file", "file", "file", "-v", "-o",
+                                        "--output", "--output=x", "-w", "7",
+                                        "-w3", "--width", "--", "-vo", "-n",
+                                        "--name", "-vn", "x", "--bad"};
+    unsigned seed = 12345;
+    auto next = [&seed](unsigned bound) {
+      seed = seed * 1103515245 + 12345;
+      return (seed >> 16) % bound;
+    };
+
+    for (int round = 0; round < 400; ++round) {
+      std::vector<std::string> args{"prog"};
+      unsigned length = next(30);
+      for (unsigned i = 0; i < length; ++i)
+        args.push_back(pool[next(static_cast<unsigned>(pool.size()))]);
+      const compiled_parser::size_type per_task = 1 + next(5);
+
+      parser_result expected;
+      parse_status expected_status;
+      width = 0;
+      verbose = false;
+      compiled.parse_into(expected, args.begin(), args.end(), expected_status);
+      const int expected_width = width;
+      const bool expected_verbose = verbose;
+
+      parser_result result;
+      parse_status status;
+      width = 0;
+      verbose = false;
+      compiled.parse_parallel_into(result, args.begin(), args.end(),
+                                   inline_executor, status, per_task);
+      REQUIRE(status.error() == expected_status.error());
+      REQUIRE(status.token_index() == expected_status.token_index());
+      REQUIRE(status.option() == expected_status.option());
+      REQUIRE(width == expected_width);
+      REQUIRE(verbose == expected_verbose);
+      REQUIRE(result.size() == expected.size());
+      for (parser_result::size_type i = 0; i < result.size(); ++i) {
+        REQUIRE(result[i].original_text == expected[i].original_text);
+        REQUIRE(result[i].original_without_argument
+                == expected[i].original_without_argument);
+        REQUIRE(result[i].is_option == expected[i].is_option);
+        REQUIRE(result[i].long_name == expected[i].long_name);
+        REQUIRE(result[i].short_name == expected[i].short_name);
+        REQUIRE(result[i].argument == expected[i].argument);
+      }
+      if (status) {
+        REQUIRE(result.count("width") == expected.count("width"));
+        REQUIRE(result.get_argument('o') == expected.get_argument('o'));
+      }
+    }
+  }
+
+  SECTION("threads") {
+    std::vector<std::string> args{"prog"};
+    for (int i = 0; i < 1000; ++i) {
+      args.push_back("file" + std::to_string(i));
+      if (i % 97 == 0) {
+        args.push_back("-w");
+        args.push_back(std::to_string(i));
+      }
+      if (i % 89 == 0)
+        args.push_back("--output");
+    }
+
+    std::vector<std::thread> threads;
+    auto executor = [&](std::function<void()> task) {
+      threads.emplace_back(std::move(task));
+    };
+    auto result = p.parse_parallel(args.begin(), args.end(), executor, 64);
+    for (auto& t : threads)
+      t.join();
+    REQUIRE(threads.size() > 1);
+
+    auto expected = p.parse(args.begin(), args.end());
+    REQUIRE(result.size() == expected.size());
+    for (parser_result::size_type i = 0; i < result.size(); ++i) {
+      REQUIRE(result[i].original_text == expected[i].original_text);
+      REQUIRE(result[i].argument == expected[i].argument);
+    }
+    REQUIRE(width == 970);
+  }
+
+  SECTION("errors") {
+    std::vector<std::string> args{"prog", "a", "b", "--bad", "c", "-n"};
+    REQUIRE_THROWS_AS(compiled.parse_parallel(args.begin(), args.end(),
+                                              inline_executor, 2),
+                      parse_error);
+    args[3] = "d";
+    REQUIRE_THROWS_AS(compiled.parse_parallel(args.begin(), args.end(),
+                                              inline_executor, 2),
+                      parse_error);
+    args.push_back("name");
+    REQUIRE(compiled.parse_parallel(args.begin(), args.end(),
+                                    inline_executor, 2).size() == 5);
+  }
+}
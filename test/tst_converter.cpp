@@ -0,0 +1,184 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/converter.hpp>
+
+using namespace optionpp;
+
+namespace {
+
+  enum class color { red, green, blue };
+  enum class level : short { low = 1, high = 9 };
+
+} // End anonymous namespace
+
+namespace optionpp {
+
+  template <>
+  struct enum_names<color> {
+    using table = std::vector<std::pair<std::string, color>>;
+    static const table& names() {
+      static const table values{{"red", color::red},
+                                {"green", color::green},
+                                {"blue", color::blue}};
+      return values;
+    }
+  };
+
+} // End namespace
+
+namespace {
+
+  template <typename T>
+  parse_errc convert(string_ref argument, T& value) {
+    return converter<T>::convert(argument, value);
+  }
+
+} // End anonymous namespace
+
+TEST_CASE("converter") {
+  SECTION("strings") {
+    std::string value;
+    REQUIRE(convert("some text", value) == parse_errc::none);
+    REQUIRE(value == "some text");
+    REQUIRE(converter<std::string>::argument_name() == std::string{"STRING"});
+  }
+
+  SECTION("signed integers") {
+    std::int64_t wide = 0;
+    REQUIRE(convert("-9223372036854775808", wide) == parse_errc::none);
+    REQUIRE(wide == INT64_MIN);
+    REQUIRE(convert("9223372036854775808", wide) == parse_errc::out_of_range);
+
+    signed char small = 5;
+    REQUIRE(convert("-128", small) == parse_errc::none);
+    REQUIRE(small == -128);
+    REQUIRE(convert("128", small) == parse_errc::out_of_range);
+    REQUIRE(convert("1.5", small) == parse_errc::not_an_integer);
+    REQUIRE(convert("", small) == parse_errc::not_an_integer);
+    REQUIRE(small == -128);
+  }
+
+  SECTION("unsigned integers") {
+    std::size_t size = 0;
+    REQUIRE(convert("18446744073709551615", size) == parse_errc::none);
+    REQUIRE(size == 18446744073709551615ULL);
+    REQUIRE(convert("18446744073709551616", size) == parse_errc::out_of_range);
+    REQUIRE(convert("-1", size) == parse_errc::negative_argument);
+    REQUIRE(convert("-0", size) == parse_errc::none);
+    REQUIRE(size == 0);
+    REQUIRE(convert("-x", size) == parse_errc::not_an_integer);
+
+    unsigned short port = 0;
+    REQUIRE(convert("+8080", port) == parse_errc::none);
+    REQUIRE(port == 8080);
+    REQUIRE(convert("65536", port) == parse_errc::out_of_range);
+  }
+
+  SECTION("floating point") {
+    float f = 0;
+    REQUIRE(convert("0.25", f) == parse_errc::none);
+    REQUIRE(f == 0.25f);
+    REQUIRE(convert("1e39", f) == parse_errc::out_of_range);
+    REQUIRE(convert("inf", f) == parse_errc::none);
+    REQUIRE(convert("abc", f) == parse_errc::not_a_number);
+
+    double d = 0;
+    REQUIRE(convert("1e39", d) == parse_errc::none);
+    REQUIRE(d == 1e39);
+    REQUIRE(converter<double>::argument_name() == std::string{"NUMBER"});
+  }
+
+  SECTION("durations") {
+    std::chrono::milliseconds ms;
+    REQUIRE(convert("250", ms) == parse_errc::none);
+    REQUIRE(ms.count() == 250);
+    REQUIRE(convert("2s", ms) == parse_errc::none);
+    REQUIRE(ms.count() == 2000);
+    REQUIRE(convert("1.5min", ms) == parse_errc::none);
+    REQUIRE(ms.count() == 90000);
+    REQUIRE(convert("3m", ms) == parse_errc::none);
+    REQUIRE(ms.count() == 180000);
+    REQUIRE(convert("0.3s", ms) == parse_errc::none);
+    REQUIRE(ms.count() == 300);
+    REQUIRE(convert("-1h", ms) == parse_errc::none);
+    REQUIRE(ms.count() == -3600000);
+    REQUIRE(convert("1500us", ms) == parse_errc::none);
+    REQUIRE(ms.count() == 2);
+    REQUIRE(convert("5 s", ms) == parse_errc::invalid_value);
+    REQUIRE(convert("5parsecs", ms) == parse_errc::invalid_value);
+    REQUIRE(convert("s", ms) == parse_errc::not_a_number);
+
+    std::chrono::nanoseconds ns;
+    REQUIRE(convert("106751d", ns) == parse_errc::none);
+    REQUIRE(ns.count() == 106751LL * 86400 * 1000000000);
+    REQUIRE(convert("106752d", ns) == parse_errc::out_of_range);
+
+    std::chrono::duration<double> seconds;
+    REQUIRE(convert("1500ms", seconds) == parse_errc::none);
+    REQUIRE(seconds.count() == Approx(1.5));
+
+    std::chrono::hours hours;
+    REQUIRE(convert("90min", hours) == parse_errc::none);
+    REQUIRE(hours.count() == 2);
+  }
+
+  SECTION("byte sizes") {
+    byte_size size;
+    REQUIRE(convert("512", size) == parse_errc::none);
+    REQUIRE(size.bytes == 512);
+    REQUIRE(convert("64M", size) == parse_errc::none);
+    REQUIRE(size.bytes == 64ULL << 20);
+    REQUIRE(convert("2kb", size) == parse_errc::none);
+    REQUIRE(size.bytes == 2048);
+    REQUIRE(convert("1.5GiB", size) == parse_errc::none);
+    REQUIRE(size.bytes == 3ULL << 29);
+    REQUIRE(convert("10B", size) == parse_errc::none);
+    REQUIRE(size.bytes == 10);
+    REQUIRE(convert("15E", size) == parse_errc::none);
+    REQUIRE(size.bytes == 15ULL << 60);
+    REQUIRE(convert("16E", size) == parse_errc::out_of_range);
+    REQUIRE(convert("-1K", size) == parse_errc::negative_argument);
+    REQUIRE(convert("4X", size) == parse_errc::invalid_value);
+    REQUIRE(convert("4Kbytes", size) == parse_errc::invalid_value);
+    REQUIRE(convert("K", size) == parse_errc::not_a_number);
+    REQUIRE(size.bytes == 15ULL << 60);
+  }
+
+  SECTION("enumerations") {
+    color c = color::red;
+    REQUIRE(convert("blue", c) == parse_errc::none);
+    REQUIRE(c == color::blue);
+    REQUIRE(convert("purple", c) == parse_errc::invalid_value);
+    REQUIRE(convert("2", c) == parse_errc::invalid_value);
+    REQUIRE(c == color::blue);
+
+    level l = level::low;
+    REQUIRE(convert("9", l) == parse_errc::none);
+    REQUIRE(l == level::high);
+    REQUIRE(convert("high", l) == parse_errc::not_an_integer);
+    REQUIRE(converter<level>::argument_name() == std::string{"VALUE"});
+  }
+}
@@ -0,0 +1,179 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/incremental_parser.hpp>
+#include <optionpp/utility.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("incremental_parser") {
+  int width = 0;
+  parser p;
+  p["help"].short_name('?');
+  p["verbose"].short_name('v');
+  p["all"].short_name('a');
+  p["width"].short_name('w').bind_int(&width);
+  p["output"].short_name('o').argument("FILE", false);
+
+  std::vector<parsed_entry> entries;
+  auto collect = [&](const parsed_entry_ref& entry) {
+    entries.push_back(entry.to_entry());
+  };
+
+  SECTION("same results as parse") {
+    for (const std::string cmd : { "-v? file --width=3",
+                                   "--output out.txt -- --help",
+                                   "-vw 12 -o",
+                                   "-?o=file1 file2",
+                                   "-avo file -vaw=8 -vaw9 -aov -w 2",
+                                   "--output --help -o -v",
+                                   "-o -- -v",
+                                   "" }) {
+      INFO(cmd);
+      std::vector<std::string> args;
+      utility::split(cmd, std::back_inserter(args));
+      auto expected = p.parse(args.begin(), args.end(), false);
+
+      entries.clear();
+      incremental_parser session{p, collect};
+      for (const auto& arg : args) {
+        // Each argument only lives until feed returns
+        std::string copy = arg;
+        session.feed(copy);
+        copy.assign(copy.size(), '#');
+      }
+      session.finish();
+
+      REQUIRE(entries.size() == expected.size());
+      for (parser_result::size_type i = 0; i < expected.size(); ++i) {
+        REQUIRE(entries[i].original_text == expected[i].original_text);
+        REQUIRE(entries[i].original_without_argument
+                == expected[i].original_without_argument);
+        REQUIRE(entries[i].is_option == expected[i].is_option);
+        REQUIRE(entries[i].long_name == expected[i].long_name);
+        REQUIRE(entries[i].short_name == expected[i].short_name);
+        REQUIRE(entries[i].argument == expected[i].argument);
+        REQUIRE(entries[i].opt_info == expected[i].opt_info);
+      }
+    }
+  }
+
+  SECTION("entries are emitted when complete") {
+    auto compiled = p.compile();
+    incremental_parser session{compiled, collect, true};
+    session.feed("prog");
+    REQUIRE(session.argument_count() == 1);
+    REQUIRE(entries.empty());
+
+    session.feed("-v");
+    REQUIRE(entries.size() == 1);
+    REQUIRE(entries[0].short_name == 'v');
+
+    session.feed("-ao");
+    REQUIRE(entries.size() == 2);
+    REQUIRE(session.waiting_for_argument());
+
+    session.feed("out.txt");
+    REQUIRE(entries.size() == 3);
+    REQUIRE(entries[2].original_text == "-o out.txt");
+    REQUIRE(entries[2].argument == "out.txt");
+    REQUIRE_FALSE(session.waiting_for_argument());
+
+    session.feed("--width");
+    REQUIRE(entries.size() == 3);
+    session.feed("42");
+    REQUIRE(width == 42);
+    REQUIRE(entries.size() == 4);
+
+    session.feed("--output");
+    session.feed("--help");
+    REQUIRE(entries.size() == 6);
+    REQUIRE(entries[4].argument.empty());
+
+    session.feed("-o");
+    REQUIRE(entries.size() == 6);
+    session.finish();
+    REQUIRE(entries.size() == 7);
+    REQUIRE(entries[6].original_text == "-o");
+    REQUIRE(session.argument_count() == 0);
+  }
+
+  SECTION("errors") {
+    incremental_parser session{p, collect};
+    session.feed("-v");
+    REQUIRE_THROWS_WITH(session.feed("--bogus"), "invalid option: '--bogus'");
+    REQUIRE_THROWS_AS(session.feed("-v"), parse_error);
+    REQUIRE_THROWS_AS(session.finish(), parse_error);
+    REQUIRE(entries.size() == 1);
+
+    session.reset();
+    session.feed("-w");
+    REQUIRE_THROWS_WITH(session.finish(), "option '-w' requires an argument");
+
+    session.reset();
+    parse_status status;
+    REQUIRE(session.feed("-a", status));
+    REQUIRE(status.ok());
+    REQUIRE_FALSE(session.feed("-aw=x", status));
+    REQUIRE(status.error() == parse_errc::not_an_integer);
+    REQUIRE(status.token_index() == 1);
+    REQUIRE(status.offset() == 4);
+    REQUIRE_FALSE(session.finish(status));
+    REQUIRE(entries.size() == 2);
+
+    session.reset();
+    REQUIRE(session.feed("--width", status));
+    REQUIRE_FALSE(session.finish(status));
+    REQUIRE(status.error() == parse_errc::missing_argument);
+  }
+
+  SECTION("without a handler") {
+    incremental_parser session{p, nullptr};
+    session.feed("-w");
+    session.feed("7");
+    session.finish();
+    REQUIRE(width == 7);
+  }
+
+  SECTION("response files") {
+    const std::string path = "optionpp_test_incremental.rsp";
+    std::ofstream{path} << "-av file -vo";
+    p.set_response_file_prefix();
+
+    incremental_parser session{p, collect};
+    session.feed("@" + path);
+    session.feed("out.txt");
+    session.feed("@" + path);
+    session.finish();
+    std::remove(path.c_str());
+
+    REQUIRE(entries.size() == 10);
+    REQUIRE(entries[0].original_text == "-a");
+    REQUIRE(entries[1].original_text == "-v");
+    REQUIRE(entries[2].original_text == "file");
+    REQUIRE(entries[4].original_text == "-o out.txt");
+    REQUIRE(entries[4].argument == "out.txt");
+    REQUIRE(entries[9].original_text == "-o");
+  }
+}
@@ -0,0 +1,79 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <catch2/catch.hpp>
+#include <optionpp/mapped_file.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("mapped_file") {
+  const std::string path_a = "optionpp_test_mapped_a.txt";
+  const std::string path_b = "optionpp_test_mapped_b.txt";
+  const std::string path_empty = "optionpp_test_mapped_empty.txt";
+  std::ofstream{path_a} << "--verbose\n-o 'out file'\n";
+  std::ofstream{path_b} << "other";
+  std::ofstream{path_empty};
+
+  SECTION("contents") {
+    mapped_file file{path_a};
+    REQUIRE(file.is_open());
+    REQUIRE(file.contents() == "--verbose\n-o 'out file'\n");
+
+    file.close();
+    REQUIRE_FALSE(file.is_open());
+    REQUIRE(file.contents().empty());
+
+    REQUIRE(file.open(path_empty));
+    REQUIRE(file.is_open());
+    REQUIRE(file.contents().empty());
+  }
+
+  SECTION("missing file") {
+    mapped_file file{"optionpp_test_mapped_missing.txt"};
+    REQUIRE_FALSE(file.is_open());
+    REQUIRE_FALSE(mapped_file{}.is_open());
+  }
+
+  SECTION("directory") {
+    mapped_file file{"."};
+    REQUIRE_FALSE(file.is_open());
+    REQUIRE(file.contents().empty());
+
+    // A failed open leaves nothing behind
+    REQUIRE(file.open(path_a));
+    REQUIRE_FALSE(file.open("."));
+    REQUIRE_FALSE(file.is_open());
+    REQUIRE(file.contents().empty());
+  }
+
+  SECTION("identity") {
+    mapped_file a{path_a};
+    mapped_file again{"./" + path_a};
+    mapped_file b{path_b};
+    REQUIRE(a.id() == again.id());
+    REQUIRE(a.id() != b.id());
+  }
+
+  std::remove(path_a.c_str());
+  std::remove(path_b.c_str());
+  std::remove(path_empty.c_str());
+}
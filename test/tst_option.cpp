@@ -95,6 +95,23 @@ TEST_CASE("option") {
     REQUIRE(combo.is_argument_required());
   }
 
+  SECTION("copies") {
+    option copy{combo};
+    REQUIRE(copy.long_name().data() == combo.long_name().data()); // Shared
+    copy.long_name("everything").description("show everything");
+    REQUIRE(copy.long_name() == "everything");
+    REQUIRE(copy.description() == "show everything");
+    REQUIRE(combo.long_name() == "all");
+    REQUIRE(combo.description() == "show all");
+
+    for (int i = 0; i < 100; ++i)
+      combo.description("description number " + std::to_string(i));
+    REQUIRE(combo.long_name() == "all");
+    REQUIRE(combo.description() == "description number 99");
+    combo.description("");
+    REQUIRE(combo.description().empty());
+  }
+
   SECTION("variable binding") {
     bool is_set{};
     REQUIRE_FALSE(combo.has_bound_argument_variable());
@@ -140,4 +157,37 @@ TEST_CASE("option") {
     combo.write_double(1.234);
     REQUIRE(dvalue == Approx(1.234));
   }
+
+  SECTION("generic binding") {
+    option plain{"size"};
+    long long wide{};
+    plain.bind(&wide);
+    REQUIRE(plain.argument_type() == option::custom_arg);
+    REQUIRE(plain.argument_name() == "INTEGER");
+    REQUIRE(plain.is_argument_required());
+    REQUIRE(plain.write_argument("-9000000000") == parse_errc::none);
+    REQUIRE(wide == -9000000000LL);
+    REQUIRE(plain.write_argument("12x") == parse_errc::not_an_integer);
+    REQUIRE(plain.write_argument("7", false) == parse_errc::none);
+    REQUIRE(wide == -9000000000LL);
+
+    int ivalue{};
+    plain.bind(&ivalue);
+    REQUIRE(plain.argument_type() == option::int_arg);
+    plain.write_int(3);
+    REQUIRE(ivalue == 3);
+
+    byte_size limit;
+    option named{"limit"};
+    named.argument("BYTES", false).bind(&limit);
+    REQUIRE(named.argument_name() == "BYTES");
+    REQUIRE_FALSE(named.is_argument_required());
+    REQUIRE(named.write_argument("64M") == parse_errc::none);
+    REQUIRE(limit.bytes == 64ULL << 20);
+
+    option unbound{"x"};
+    unbound.bind<int>(nullptr);
+    REQUIRE_FALSE(unbound.has_bound_argument_variable());
+    REQUIRE(unbound.write_argument("anything") == parse_errc::none);
+  }
 }
@@ -0,0 +1,174 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/option_index.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("option_index") {
+  std::vector<option> options{
+    option{"help", '?'},
+    option{"verbose", 'v'},
+    option{"version"},
+    option{'x'},
+    option{"verbose", 'V'}
+  };
+
+  option_index index;
+
+  SECTION("empty index") {
+    REQUIRE(index.empty());
+    REQUIRE(index.size() == 0);
+    REQUIRE(index.find("help") == nullptr);
+    REQUIRE(index.find('?') == nullptr);
+    REQUIRE(index.find('\0') == nullptr);
+  }
+
+  SECTION("lookup") {
+    for (const auto& opt : options)
+      index.insert(opt);
+
+    REQUIRE_FALSE(index.empty());
+    REQUIRE(index.size() == 3);
+    REQUIRE(index.find("help") == &options[0]);
+    REQUIRE(index.find("version") == &options[2]);
+    REQUIRE(index.find("verb") == nullptr);
+    REQUIRE(index.find("") == nullptr);
+    REQUIRE(index.find('?') == &options[0]);
+    REQUIRE(index.find('x') == &options[3]);
+    REQUIRE(index.find('V') == &options[4]);
+    REQUIRE(index.find('y') == nullptr);
+    REQUIRE(index.find('\0') == nullptr);
+
+    std::string arg{"--version=2"};
+    REQUIRE(index.find(arg.data() + 2, 7) == &options[2]);
+    REQUIRE(index.find(arg.data() + 2, 4) == nullptr);
+  }
+
+  SECTION("duplicate names") {
+    for (const auto& opt : options)
+      index.insert(opt);
+
+    REQUIRE(index.find("verbose") == &options[1]);
+    REQUIRE(index.find('v') == &options[1]);
+  }
+
+  SECTION("renamed options") {
+    for (const auto& opt : options)
+      index.insert(opt);
+
+    options[1].long_name("loud");
+    REQUIRE(index.find("verbose") == nullptr);
+    REQUIRE(index.has_renamed("verbose")); // Hides options[4]
+    REQUIRE_FALSE(index.has_renamed("quiet"));
+  }
+
+  SECTION("many options") {
+    std::vector<option> many;
+    for (int i = 0; i < 5000; ++i)
+      many.emplace_back("option-" + std::to_string(i));
+    for (const auto& opt : many)
+      index.insert(opt);
+
+    REQUIRE(index.size() == 5000);
+    for (int i = 0; i < 5000; ++i)
+      REQUIRE(index.find("option-" + std::to_string(i)) == &many[i]);
+    REQUIRE(index.find("option-5000") == nullptr);
+  }
+
+  SECTION("optimize") {
+    REQUIRE_FALSE(index.optimize());
+
+    std::vector<option> many;
+    for (int i = 0; i < 3000; ++i)
+      many.emplace_back("option-" + std::to_string(i), '\0');
+    for (const auto& opt : many)
+      index.insert(opt);
+
+    REQUIRE(index.optimize());
+    REQUIRE(index.is_optimized());
+    REQUIRE(index.size() == 3000);
+    for (int i = 0; i < 3000; ++i)
+      REQUIRE(index.find("option-" + std::to_string(i)) == &many[i]);
+    REQUIRE(index.find("option-3000") == nullptr);
+    REQUIRE(index.find("") == nullptr);
+
+    index.insert(options[0]);
+    REQUIRE_FALSE(index.is_optimized());
+    REQUIRE(index.find("help") == &options[0]);
+    REQUIRE(index.find("option-1234") == &many[1234]);
+  }
+
+  SECTION("prefix lookup") {
+    for (const auto& opt : options)
+      index.insert(opt);
+    auto matches = index.find_prefix("ver", 3);
+    REQUIRE(matches.first == matches.second); // Not sorted yet
+
+    index.sort_names();
+    matches = index.find_prefix("ver", 3);
+    REQUIRE(matches.second - matches.first == 2);
+    REQUIRE(matches.first[0] == &options[1]);
+    REQUIRE(matches.first[1] == &options[2]);
+
+    matches = index.find_prefix("verb", 4);
+    REQUIRE(matches.second - matches.first == 1);
+    REQUIRE(*matches.first == &options[1]);
+
+    matches = index.find_prefix("version", 7);
+    REQUIRE(matches.second - matches.first == 1);
+    REQUIRE(*matches.first == &options[2]);
+
+    REQUIRE(index.find_prefix("versions", 8).first
+            == index.find_prefix("versions", 8).second);
+    REQUIRE(index.find_prefix("x", 1).first == index.find_prefix("x", 1).second);
+    REQUIRE(index.find_prefix("", 0).second - index.find_prefix("", 0).first == 3);
+
+    std::vector<option> many;
+    for (int i = 0; i < 1000; ++i)
+      many.emplace_back("option-" + std::to_string(i));
+    for (const auto& opt : many)
+      index.insert(opt);
+    index.sort_names();
+    REQUIRE(index.find_prefix("option-12", 9).second
+            - index.find_prefix("option-12", 9).first == 11);
+    matches = index.find_prefix("option-999", 10);
+    REQUIRE(matches.second - matches.first == 1);
+    REQUIRE(*matches.first == &many[999]);
+
+    index.clear();
+    REQUIRE(index.find_prefix("", 0).first == index.find_prefix("", 0).second);
+  }
+
+  SECTION("clear") {
+    for (const auto& opt : options)
+      index.insert(opt);
+    index.clear();
+
+    REQUIRE(index.empty());
+    REQUIRE(index.find("help") == nullptr);
+    REQUIRE(index.find('?') == nullptr);
+
+    index.insert(options[2]);
+    REQUIRE(index.find("version") == &options[2]);
+  }
+}
@@ -0,0 +1,357 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/option_schema.hpp>
+#include <optionpp/parser.hpp>
+
+#if OPTIONPP_CONSTEXPR_SCHEMA
+
+using namespace optionpp;
+
+namespace {
+
+  constexpr option_spec example_specs[] = {
+    {"help", '?', "Show this help message."},
+    {"verbose", 'v', "Show more output."},
+    {"all", 'a', "Show all entries, including those that begin with a "
+     "period and those that are otherwise hidden."},
+    {"output", 'o', "Write the output to FILE.", "FILE", true},
+    {"color", '\0', "Use color: WHEN may be always, never or auto.",
+     "WHEN", false},
+    {"width", 'w', "Set the width.", "N", true, option_spec::check<int>()},
+    {"", 's', "Sort the entries."},
+    {"a-rather-long-option-name", '\0', "Do something.", "ARGUMENT", false},
+    {"scale", '\0', "", "FACTOR", true, option_spec::check<double>()}
+  };
+
+  constexpr auto example_schema = make_schema<example_specs>();
+
+  // The same options, for comparison
+  parser make_parser(int& width, double& scale) {
+    parser result;
+    result.add_option("help", '?', "Show this help message.");
+    result.add_option("verbose", 'v', "Show more output.");
+    result.add_option("all", 'a', "Show all entries, including those that "
+                      "begin with a period and those that are otherwise "
+                      "hidden.");
+    result.add_option("output", 'o', "Write the output to FILE.")
+      .argument("FILE", true);
+    result.add_option("color", '\0', "Use color: WHEN may be always, "
+                      "never or auto.").argument("WHEN", false);
+    result.add_option("width", 'w', "Set the width.").bind<int>(&width)
+      .argument("N", true);
+    result.add_option("", 's', "Sort the entries.");
+    result.add_option("a-rather-long-option-name", '\0', "Do something.")
+      .argument("ARGUMENT", false);
+    result.add_option("scale").bind<double>(&scale).argument("FACTOR", true);
+    return result;
+  }
+
+} // End namespace
+
+TEST_CASE("option_schema") {
+  SECTION("compile-time lookup") {
+    static_assert(example_schema.size() == 9, "wrong size");
+    static_assert(example_schema.index_of("help") == 0, "help not found");
+    static_assert(example_schema.index_of("scale") == 8, "scale not found");
+    static_assert(example_schema.index_of('s') == 6, "-s not found");
+    static_assert(example_schema.index_of("sort")
+                  == decltype(example_schema)::npos, "sort found");
+    static_assert(example_schema.index_of("") == decltype(example_schema)::npos,
+                  "empty name found");
+    static_assert(example_schema.index_of('x') == decltype(example_schema)::npos,
+                  "-x found");
+
+    for (std::size_t i = 0; i != example_schema.size(); ++i) {
+      if (*example_specs[i].long_name)
+        REQUIRE(example_schema.index_of(example_specs[i].long_name) == i);
+      if (example_specs[i].short_name)
+        REQUIRE(example_schema.index_of(example_specs[i].short_name) == i);
+    }
+  }
+
+  SECTION("runtime lookup") {
+    auto schema = example_schema.parser();
+    REQUIRE(schema.size() == 9);
+    REQUIRE(schema.find("output") == &example_specs[3]);
+    REQUIRE(schema.find('o') == &example_specs[3]);
+    REQUIRE(schema.index(*schema.find("width")) == 5);
+    REQUIRE(schema.find("out") == nullptr);
+    REQUIRE(schema.find("outputs") == nullptr);
+    REQUIRE(schema.find("") == nullptr);
+    REQUIRE(schema.find('\0') == nullptr);
+    REQUIRE(schema.find('c') == nullptr);
+
+    std::string arg{"--color=auto"};
+    REQUIRE(schema.find(string_ref{arg.data() + 2, 5}) == &example_specs[4]);
+    REQUIRE(schema.find(string_ref{arg.data() + 2, 4}) == nullptr);
+  }
+
+  SECTION("many options") {
+    static constexpr option_spec specs[] = {
+      {"a0"}, {"a1"}, {"a2"}, {"a3"}, {"a4"}, {"a5"}, {"a6"}, {"a7"},
+      {"b0"}, {"b1"}, {"b2"}, {"b3"}, {"b4"}, {"b5"}, {"b6"}, {"b7"},
+      {"c0"}, {"c1"}, {"c2"}, {"c3"}, {"c4"}, {"c5"}, {"c6"}, {"c7"},
+      {"d0"}, {"d1"}, {"d2"}, {"d3"}, {"d4"}, {"d5"}, {"d6"}, {"d7"},
+      {"e0"}, {"e1"}, {"e2"}, {"e3"}, {"e4"}, {"e5"}, {"e6"}, {"e7"}
+    };
+    static constexpr auto schema = make_schema<specs>();
+    for (std::size_t i = 0; i != schema.size(); ++i) {
+      REQUIRE(schema.index_of(specs[i].long_name) == i);
+      REQUIRE(schema.parser().find(specs[i].long_name) == &specs[i]);
+    }
+    REQUIRE(schema.parser().find("f0") == nullptr);
+  }
+
+  SECTION("random help text") {
+    // Options with names, arguments and descriptions of every length,
+    // including words too long for a line and explicit line breaks
+    std::mt19937 random{2020};
+    auto pick = [&](std::size_t count) {
+      return std::uniform_int_distribution<std::size_t>{0, count - 1}(random);
+    };
+    auto make_word = [&](std::size_t length) {
+      std::string word;
+      for (std::size_t i = 0; i < length; ++i)
+        word += static_cast<char>('a' + pick(26));
+      return word;
+    };
+    const std::vector<std::string> separators{" ", " ", " ", "  ", "\n",
+                                              "\t", " \n "};
+
+    for (int round = 0; round < 300; ++round) {
+      std::size_t count = pick(8) + 1;
+      std::vector<std::string> strings;
+      strings.reserve(3 * count);
+      std::vector<option_spec> specs;
+      parser expected_parser;
+      for (std::size_t i = 0; i < count; ++i) {
+        strings.push_back(make_word(pick(4) == 0 ? pick(45) : pick(12)));
+        const char* long_name = strings.back().c_str();
+        char short_name = pick(3) == 0 ? '\0' : static_cast<char>('A' + pick(26));
+        strings.push_back(pick(2) == 0 ? "" : make_word(pick(14) + 1));
+        const char* arg_name = strings.back().c_str();
+        bool arg_required = pick(2) == 0;
+        std::string desc;
+        for (std::size_t n = pick(4) == 0 ? 0 : pick(30); n > 0; --n) {
+          desc += make_word(pick(10) == 0 ? pick(90) + 1 : pick(9) + 1);
+          if (n > 1)
+            desc += separators[pick(separators.size())];
+        }
+        strings.push_back(desc);
+        const char* description = strings.back().c_str();
+
+        specs.emplace_back(long_name, short_name, description, arg_name,
+                           arg_required);
+        expected_parser.add_option(long_name, short_name, description,
+                                   arg_name, arg_required);
+      }
+
+      std::ostringstream expected;
+      expected_parser.print_help(expected);
+      std::size_t size = schema_layout::format_help(specs.data(), count, nullptr);
+      std::string help(size, '\0');
+      schema_layout::format_help(specs.data(), count, &help[0]);
+      CAPTURE(round);
+      REQUIRE(help == expected.str());
+    }
+  }
+
+  SECTION("help text") {
+    int width = 0;
+    double scale = 0;
+    std::ostringstream expected;
+    make_parser(width, scale).print_help(expected);
+
+    REQUIRE(example_schema.parser().help() == expected.str());
+    std::ostringstream printed;
+    example_schema.parser().print_help(printed);
+    REQUIRE(printed.str() == expected.str());
+  }
+}
+
+TEST_CASE("schema_parser visit") {
+  auto schema = example_schema.parser();
+
+  std::vector<std::string> log;
+  auto on_option = [&](const option_spec& spec, string_ref argument) {
+    log.push_back(std::string{spec.long_name} + "=" + argument.str());
+    return true;
+  };
+  auto on_non_option = [&](string_ref argument) {
+    log.push_back(argument.str());
+    return true;
+  };
+  parse_status status;
+
+  SECTION("entries") {
+    std::vector<std::string> args{"prog", "-vo", "out", "file", "--color",
+                                  "--all", "--color", "auto", "-w3",
+                                  "--", "-v"};
+    REQUIRE(schema.visit(args.begin(), args.end(), on_option,
+                         on_non_option, status));
+    REQUIRE(status);
+    REQUIRE(log == std::vector<std::string>{"verbose=", "output=out", "file",
+                                            "color=", "all=", "color=auto",
+                                            "width=3", "-v"});
+  }
+
+  SECTION("argv") {
+    char prog[] = "prog", opt[] = "-sw=4", arg[] = "-";
+    char* argv[] = {prog, opt, arg, nullptr};
+    REQUIRE(schema.visit(3, argv, on_option, on_non_option, status));
+    REQUIRE(log == std::vector<std::string>{"=", "width=4", "-"});
+  }
+
+  SECTION("same entries and errors as parser") {
+    int width = 0;
+    double scale = 0;
+    parser example = make_parser(width, scale);
+
+    std::vector<std::string> expected;
+    auto log_option = [&](const option& opt, string_ref argument) {
+      expected.push_back(opt.long_name() + "/" + opt.short_name() + "="
+                         + argument.str());
+      return true;
+    };
+    auto log_non_option = [&](string_ref argument) {
+      expected.push_back(argument.str());
+      return true;
+    };
+    auto log_spec = [&](const option_spec& spec, string_ref argument) {
+      log.push_back(std::string{spec.long_name} + "/" + spec.short_name + "="
+                    + argument.str());
+      return true;
+    };
+
+    auto compare = [&](const std::vector<std::string>& args) {
+      CAPTURE(args);
+      log.clear();
+      expected.clear();
+      parse_status expected_status;
+      bool expected_ok = example.visit(args.begin(), args.end(), log_option,
+                                       log_non_option, expected_status);
+      REQUIRE(schema.visit(args.begin(), args.end(), log_spec,
+                           on_non_option, status) == expected_ok);
+      REQUIRE(log == expected);
+      REQUIRE(status.error() == expected_status.error());
+      REQUIRE(status.token_index() == expected_status.token_index());
+      REQUIRE(status.offset() == expected_status.offset());
+      REQUIRE(status.option() == expected_status.option());
+    };
+
+    const std::vector<std::vector<std::string>> command_lines{
+      {"-vaw", "12", "--output=a=b", "--color", "-", "x"},
+      {"-ow5", "--scale", "1e3", "--width=-7", "--", "--bad", "-q"},
+      {"--a-rather-long-option-name", "--help", "-?", "--color=", "--"},
+      {"-w", "-1", "-o", "-v", "--scale=.5"},
+      {"--bad"}, {"-vx"}, {"-="}, {"--=x"}, {"--help=yes"}, {"-va=1"},
+      {"--width=wide"}, {"-w1x"}, {"-v", "-w"}, {"--scale"},
+      {"--scale", "big"}, {"-o"}, {"file", "-s", "--out"}
+    };
+    for (const auto& line : command_lines) {
+      std::vector<std::string> args{"prog"};
+      args.insert(args.end(), line.begin(), line.end());
+      compare(args);
+    }
+
+    // Random command lines built from names, arguments and syntax
+    // that each parser may treat specially
+    const std::vector<std::string> long_names{
+      "help", "verbose", "all", "output", "color", "width", "scale",
+      "a-rather-long-option-name", "bad", "out", "", "-", "="};
+    const std::string short_names = "?vaowsxq-=1";
+    const std::vector<std::string> arguments{
+      "", "12", "-7", "1e3", "wide", ".5", "x=y", "-", "--", "file", "-v",
+      "--help", "4294967296", "0x10", " 3"};
+    std::mt19937 random{12345};
+    auto pick = [&](std::size_t count) {
+      return std::uniform_int_distribution<std::size_t>{0, count - 1}(random);
+    };
+    for (int line = 0; line < 5000; ++line) {
+      std::vector<std::string> args{"prog"};
+      std::size_t count = pick(6) + 1;
+      for (std::size_t i = 0; i < count; ++i) {
+        std::string token;
+        switch (pick(5)) {
+        case 0: // Long option
+          token = "--" + long_names[pick(long_names.size())];
+          if (pick(3) == 0)
+            token += "=" + arguments[pick(arguments.size())];
+          break;
+        case 1: // Group of short options
+          token = "-";
+          for (std::size_t n = pick(4) + 1; n > 0; --n)
+            token += short_names[pick(short_names.size())];
+          if (pick(4) == 0)
+            token += "=" + arguments[pick(arguments.size())];
+          break;
+        case 2: // Short option with an attached argument
+          token = std::string{"-"} + short_names[pick(short_names.size())]
+            + arguments[pick(arguments.size())];
+          break;
+        default: // Anything that may be an argument
+          token = arguments[pick(arguments.size())];
+          break;
+        }
+        args.push_back(token);
+      }
+      compare(args);
+    }
+  }
+
+  SECTION("early stop") {
+    auto stop_at_all = [&](const option_spec& spec, string_ref argument) {
+      log.push_back(std::string{spec.long_name} + "=" + argument.str());
+      return schema.index(spec) != example_schema.index_of("all");
+    };
+    std::vector<std::string> args{"prog", "-vaw4", "-w5", "file"};
+    REQUIRE_FALSE(schema.visit(args.begin(), args.end(), stop_at_all,
+                               on_non_option, status));
+    REQUIRE(status);
+    REQUIRE(log == std::vector<std::string>{"verbose=", "all="});
+
+    log.clear();
+    auto stop_at_file = [&](string_ref argument) {
+      log.push_back(argument.str());
+      return false;
+    };
+    args = {"prog", "-a", "file", "-w5", "-o"};
+    REQUIRE_FALSE(schema.visit(args.begin(), args.end(), on_option,
+                               stop_at_file, status));
+    REQUIRE(status);
+    REQUIRE(log == std::vector<std::string>{"all=", "file"});
+  }
+
+  SECTION("empty handlers") {
+    std::vector<std::string> args{"prog", "-w", "5", "file"};
+    REQUIRE(schema.visit(args.begin(), args.end(), nullptr, nullptr, status));
+    args = {"prog", "-w", "five"};
+    REQUIRE_FALSE(schema.visit(args.begin(), args.end(), nullptr, nullptr, status));
+    REQUIRE(status.error() == parse_errc::not_an_integer);
+    REQUIRE(status.token_index() == 2);
+  }
+}
+
+#endif
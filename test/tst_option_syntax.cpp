@@ -0,0 +1,88 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <catch2/catch.hpp>
+#include <optionpp/option_syntax.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("option_syntax") {
+  using token_kind = option_syntax::token_kind;
+
+  SECTION("default syntax") {
+    option_syntax syntax;
+    REQUIRE(syntax.short_prefix() == "-");
+    REQUIRE(syntax.long_prefix() == "--");
+    REQUIRE(syntax.end_of_options() == "--");
+    REQUIRE(syntax.equals() == "=");
+
+    REQUIRE(syntax.split("--").kind == token_kind::end_of_options);
+    REQUIRE(syntax.split("-").kind == token_kind::non_option);
+    REQUIRE(syntax.split("file").kind == token_kind::non_option);
+    REQUIRE(syntax.split("a=b").kind == token_kind::non_option);
+    REQUIRE(syntax.split("-=").kind == token_kind::bad_assignment);
+    REQUIRE(syntax.split("--=x").kind == token_kind::bad_assignment);
+
+    auto parts = syntax.split("--width=3=4");
+    REQUIRE(parts.kind == token_kind::long_option);
+    REQUIRE(parts.specifier == "--width");
+    REQUIRE(parts.argument == "3=4");
+    REQUIRE(parts.has_argument);
+
+    parts = syntax.split("-vw");
+    REQUIRE(parts.kind == token_kind::short_options);
+    REQUIRE(parts.specifier == "-vw");
+    REQUIRE(parts.argument.empty());
+    REQUIRE_FALSE(parts.has_argument);
+
+    parts = syntax.split("-w=");
+    REQUIRE(parts.kind == token_kind::short_options);
+    REQUIRE(parts.specifier == "-w");
+    REQUIRE(parts.argument.empty());
+    REQUIRE(parts.has_argument);
+
+    REQUIRE(syntax.is_non_option("file"));
+    REQUIRE(syntax.is_non_option("-"));
+    REQUIRE_FALSE(syntax.is_non_option("--"));
+    REQUIRE_FALSE(syntax.is_non_option("-v"));
+    REQUIRE_FALSE(syntax.is_non_option("--verbose"));
+  }
+
+  SECTION("custom syntax") {
+    option_syntax syntax{"/", "//", "end", ":="};
+    REQUIRE(syntax.split("end").kind == token_kind::end_of_options);
+    REQUIRE(syntax.split("--").kind == token_kind::non_option);
+    REQUIRE(syntax.split("/:=").kind == token_kind::bad_assignment);
+
+    auto parts = syntax.split("//out:=a=b");
+    REQUIRE(parts.kind == token_kind::long_option);
+    REQUIRE(parts.specifier == "//out");
+    REQUIRE(parts.argument == "a=b");
+
+    REQUIRE(syntax.split("/v").kind == token_kind::short_options);
+    REQUIRE(syntax.is_non_option("-v"));
+    REQUIRE_FALSE(syntax.is_non_option("/v"));
+  }
+
+  SECTION("prefixes") {
+    REQUIRE(option_syntax::has_prefix("--x", "--"));
+    REQUIRE_FALSE(option_syntax::has_prefix("--", "--"));
+    REQUIRE_FALSE(option_syntax::has_prefix("-x", "--"));
+  }
+}
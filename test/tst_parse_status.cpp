@@ -0,0 +1,146 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/parser.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("parse_status") {
+  int width = 0;
+  unsigned count = 0;
+  double ratio = 0;
+  parser p;
+  p["help"].short_name('?');
+  p["verbose"].short_name('v');
+  p["width"].short_name('w').bind_int(&width);
+  p["count"].short_name('c').bind_uint(&count);
+  p["ratio"].short_name('r').bind_double(&ratio);
+  p["output"].short_name('o').argument("FILE", false);
+
+  parser_result result;
+  parse_status status;
+
+  SECTION("success") {
+    p.parse_into(result, "-v --width=3 file", status);
+    REQUIRE(status.ok());
+    REQUIRE(status);
+    REQUIRE(status.error() == parse_errc::none);
+    REQUIRE(status.message().empty());
+    REQUIRE(result.size() == 3);
+    REQUIRE(width == 3);
+  }
+
+  SECTION("error kinds") {
+    struct error_case {
+      std::string cmd;
+      parse_errc error;
+      parse_status::size_type token;
+      parse_status::size_type offset;
+      std::string option;
+    };
+    std::vector<error_case> cases{
+      { "--quiet", parse_errc::invalid_option, 0, 0, "--quiet" },
+      { "file -vx", parse_errc::invalid_option, 1, 2, "-x" },
+      { "-v --=3", parse_errc::invalid_option, 1, 0, "--=" },
+      { "-v -w", parse_errc::missing_argument, 1, 1, "-w" },
+      { "-v -vw", parse_errc::missing_argument, 1, 2, "-w" },
+      { "--width", parse_errc::missing_argument, 0, 0, "--width" },
+      { "--help=yes", parse_errc::unexpected_argument, 0, 6, "--help" },
+      { "a b -?v=1", parse_errc::unexpected_argument, 2, 3, "-v" },
+      { "--width=x", parse_errc::not_an_integer, 0, 8, "--width" },
+      { "-vw12a", parse_errc::not_an_integer, 0, 3, "-w" },
+      { "-w 1.5", parse_errc::not_an_integer, 1, 0, "-w" },
+      { "-c -1", parse_errc::negative_argument, 1, 0, "-c" },
+      { "-r=abc", parse_errc::not_a_number, 0, 3, "-r" },
+      { "--width 99999999999", parse_errc::out_of_range, 1, 0, "--width" },
+      { "--count=99999999999", parse_errc::out_of_range, 0, 8, "--count" },
+      { "-r 1e999", parse_errc::out_of_range, 1, 0, "-r" },
+    };
+
+    for (const auto& c : cases) {
+      INFO(c.cmd);
+      p.parse_into(result, c.cmd, status);
+      REQUIRE_FALSE(status.ok());
+      REQUIRE_FALSE(status);
+      REQUIRE(status.error() == c.error);
+      REQUIRE(status.token_index() == c.token);
+      REQUIRE(status.offset() == c.offset);
+      REQUIRE(status.option() == c.option);
+
+      // Same message as the throwing parse
+      std::string message;
+      try {
+        p.parse(c.cmd);
+      } catch (const parse_error& e) {
+        message = e.what();
+        REQUIRE(e.option() == c.option);
+      }
+      REQUIRE(status.message() == message);
+
+      auto err = status.to_error();
+      REQUIRE(std::string{err.what()} == message);
+      REQUIRE(err.option() == c.option);
+    }
+  }
+
+  SECTION("partial result") {
+    p.parse_into(result, "file -v --bad -?", status);
+    REQUIRE(status.error() == parse_errc::invalid_option);
+    REQUIRE(result.size() == 2);
+    REQUIRE(result[1].short_name == 'v');
+
+    p.parse_into(result, "-?", status);
+    REQUIRE(status.ok());
+    REQUIRE(status.option().empty());
+    REQUIRE(result.size() == 1);
+  }
+
+  SECTION("sequence input") {
+    std::vector<std::string> args{"prog", "-v", "--width", "x"};
+    p.parse_into(result, args.begin(), args.end(), status);
+    REQUIRE(status.error() == parse_errc::not_an_integer);
+    REQUIRE(status.token_index() == 3);
+    REQUIRE(status.offset() == 0);
+    REQUIRE(status.option() == "--width");
+
+    p.compile().parse_into(result, args.begin(), args.end() - 1, status);
+    REQUIRE(status.error() == parse_errc::missing_argument);
+    REQUIRE(status.token_index() == 2);
+
+    char prog[] = "prog";
+    char opt[] = "-vx";
+    char* argv[] = { prog, opt };
+    p.parse_into(result, 2, argv, status);
+    REQUIRE(status.error() == parse_errc::invalid_option);
+    REQUIRE(status.token_index() == 1);
+    REQUIRE(status.offset() == 2);
+  }
+
+  SECTION("clear") {
+    p.parse_into(result, "--quiet", status);
+    status.clear();
+    REQUIRE(status.ok());
+    REQUIRE(status.token_index() == 0);
+    REQUIRE(status.option().empty());
+    REQUIRE(parse_status::message(parse_errc::none, "x").empty());
+  }
+}
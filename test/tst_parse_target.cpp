@@ -0,0 +1,180 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/parser.hpp>
+
+using namespace optionpp;
+
+namespace {
+
+  struct settings {
+    bool verbose{false};
+    int width{0};
+    std::string output;
+  };
+
+  struct other_settings {
+    int width{0};
+  };
+
+} // End namespace
+
+TEST_CASE("parse_target") {
+  settings s;
+  other_settings o;
+
+  SECTION("object") {
+    parse_target none;
+    parse_target target{s};
+    CHECK(none.object(parse_target::type_id<settings>()) == nullptr);
+    CHECK(target.object(parse_target::type_id<settings>()) == &s);
+    CHECK(target.object(parse_target::type_id<other_settings>()) == nullptr);
+    CHECK(parse_target::type_id<settings>()
+          != parse_target::type_id<other_settings>());
+  }
+
+  parser p;
+  p["verbose"].short_name('v').bind_bool(&settings::verbose);
+  p["width"].short_name('w').bind(&settings::width);
+  p["output"].short_name('o').bind(&settings::output);
+
+  parser_result result;
+  parse_status status;
+
+  SECTION("member bindings") {
+    p.parse_into(result, "-vw 80 --output=file", parse_target{s}, status);
+    REQUIRE(status);
+    CHECK(s.verbose);
+    CHECK(s.width == 80);
+    CHECK(s.output == "file");
+    CHECK(result.size() == 3);
+    CHECK(p["width"].has_bound_argument_variable());
+    CHECK(p["width"].argument_name() == "INTEGER");
+  }
+
+  SECTION("argument errors") {
+    p.parse_into(result, "--width=x", parse_target{s}, status);
+    CHECK(status.error() == parse_errc::not_an_integer);
+    CHECK(s.width == 0);
+  }
+
+  SECTION("no target") {
+    p.parse_into(result, "-v --width=80", status);
+    REQUIRE(status);
+    CHECK(!s.verbose);
+    CHECK(s.width == 0);
+
+    p.parse_into(result, "--width=x", status);
+    CHECK(status.error() == parse_errc::not_an_integer);
+  }
+
+  SECTION("target of another class") {
+    p.parse_into(result, "-v --width=80", parse_target{o}, status);
+    REQUIRE(status);
+    CHECK(o.width == 0);
+  }
+
+  SECTION("variable bindings are not written") {
+    int width = 0;
+    bool verbose = false;
+    p["width"].bind_int(&width);
+    p["verbose"].bind_bool(&verbose);
+    p.parse_into(result, "-v --width=80", parse_target{s}, status);
+    REQUIRE(status);
+    CHECK(width == 0);
+    CHECK(!verbose);
+    CHECK(s.width == 0);
+    CHECK(!s.verbose);
+
+    p.parse_into(result, "-v --width=80", status);
+    CHECK(width == 80);
+    CHECK(verbose);
+  }
+
+  SECTION("sequence input") {
+    std::vector<std::string> args{"prog", "-o", "out", "-w", "12"};
+    p.parse_into(result, args.begin(), args.end(), parse_target{s}, status);
+    REQUIRE(status);
+    CHECK(s.output == "out");
+    CHECK(s.width == 12);
+  }
+
+  SECTION("argv input") {
+    char prog[] = "prog";
+    char arg[] = "-vw3";
+    char* argv[] = {prog, arg};
+    p.parse_into(result, 2, argv, parse_target{s}, status);
+    REQUIRE(status);
+    CHECK(s.verbose);
+    CHECK(s.width == 3);
+  }
+}
+
+TEST_CASE("parser shared between threads") {
+  parser p;
+  p["verbose"].short_name('v').bind_bool(&settings::verbose);
+  p["width"].short_name('w').bind(&settings::width);
+  p["output"].short_name('o').bind(&settings::output);
+
+  std::ostringstream expected_help;
+  p.sort_options();
+  p.print_help(expected_help);
+  p.sort_options(); // Clear the caches so that the threads fill them
+
+  const parser& shared = p;
+  const int thread_count = 8;
+  const int parse_count = 200;
+  std::vector<int> failures(thread_count, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t != thread_count; ++t) {
+    threads.emplace_back([&, t]() {
+        for (int i = 0; i != parse_count; ++i) {
+          settings s;
+          parser_result result;
+          parse_status status;
+          std::string cmd = "-w " + std::to_string(t * parse_count + i)
+            + " --output=file" + std::to_string(t);
+          if (i % 2)
+            cmd += " -v";
+          shared.parse_into(result, cmd, parse_target{s}, status);
+          if (!status || s.width != t * parse_count + i
+              || s.output != "file" + std::to_string(t)
+              || s.verbose != (i % 2 == 1))
+            ++failures[t];
+
+          if (i % 50 == 0) {
+            std::ostringstream help;
+            shared.print_help(help);
+            if (help.str() != expected_help.str())
+              ++failures[t];
+          }
+        }
+      });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (int t = 0; t != thread_count; ++t)
+    CHECK(failures[t] == 0);
+}
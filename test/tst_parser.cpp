@@ -17,8 +17,13 @@
  */
 /* Written by Greg Kikola <gkikola@gmail.com>. */
 
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
 #include <exception>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -485,6 +490,65 @@ TEST_CASE("parser") {
     REQUIRE(data.line_nos);
   }
 
+  SECTION("option changes between parses") {
+    REQUIRE_THROWS_AS(example.parse("--quiet"), parse_error);
+    example["quiet"].short_name('q');
+    auto result = example.parse("-q --quiet");
+    REQUIRE(result.size() == 2);
+    REQUIRE(result[0].long_name == "quiet");
+    REQUIRE(result[1].short_name == 'q');
+
+    example.group("Output options")["width"].argument("N");
+    result = example.parse("--width=4");
+    REQUIRE(result.get_argument("width") == "4");
+
+    example.sort_groups();
+    example.sort_options();
+    result = example.parse("-q --width 5 -a");
+    REQUIRE(result.size() == 3);
+    REQUIRE(result[1].argument == "5");
+    REQUIRE(result[2].long_name == "all");
+
+    parser copy{example};
+    copy["extra"];
+    result = copy.parse("--extra -v");
+    REQUIRE(result.size() == 2);
+    REQUIRE(result[0].opt_info == &copy["extra"]);
+    REQUIRE_THROWS_AS(example.parse("--extra"), parse_error);
+
+    parser moved{std::move(copy)};
+    REQUIRE(moved.parse("--extra").size() == 1);
+  }
+
+  SECTION("parse_into") {
+    parser_result result;
+    example.parse_into(result, "--verbose -o out.txt file");
+    auto expected = example.parse("--verbose -o out.txt file");
+    REQUIRE(result.size() == 3);
+    for (parser_result::size_type i = 0; i < result.size(); ++i) {
+      REQUIRE(result[i].original_text == expected[i].original_text);
+      REQUIRE(result[i].argument == expected[i].argument);
+      REQUIRE(result[i].opt_info == expected[i].opt_info);
+    }
+
+    const char* buffer = result[1].original_text.data();
+    std::vector<std::string> args{"prog", "-v", "-o", "x.txt"};
+    example.parse_into(result, args.begin(), args.end());
+    REQUIRE(result.size() == 2);
+    REQUIRE(result[1].original_text == "-o x.txt");
+    REQUIRE(result[1].original_text.data() == buffer);
+
+    char prog[] = "prog";
+    char file[] = "file";
+    char* argv[] = { prog, file };
+    example.parse_into(result, 2, argv);
+    REQUIRE(result.size() == 1);
+    REQUIRE(result[0].original_text == "file");
+    REQUIRE_FALSE(result[0].is_option);
+
+    REQUIRE_THROWS_AS(example.parse_into(result, "--bogus"), parse_error);
+  }
+
   SECTION("type errors") {
     struct settings_ex {
       double temperature;
@@ -521,6 +585,25 @@ TEST_CASE("parser") {
                         "argument for option '-t' must be a number");
   }
 
+  SECTION("generic bound variables") {
+    std::size_t jobs = 0;
+    std::chrono::seconds timeout{};
+    byte_size cache;
+    example.add_option("jobs", 'j').bind(&jobs);
+    example.add_option("timeout").bind(&timeout);
+    example.add_option("cache").argument("SIZE").bind(&cache);
+
+    example.parse("-j 16 --timeout=2min --cache 64M");
+    REQUIRE(jobs == 16);
+    REQUIRE(timeout.count() == 120);
+    REQUIRE(cache.bytes == 64ULL << 20);
+
+    REQUIRE_THROWS_WITH(example.parse("--timeout=5y"),
+                        "argument for option '--timeout' is not valid");
+    REQUIRE_THROWS_WITH(example.parse("-j=-2"),
+                        "argument for option '-j' must not be negative");
+  }
+
   SECTION("help message") {
     std::ostringstream oss;
     oss << empty;
@@ -608,4 +691,702 @@ Output options
     example.print_help(oss, 80, 0, 2, 60, 58);
     REQUIRE(oss.str() == desired);
   }
+
+  SECTION("cached help message") {
+    std::ostringstream first, second;
+    example.print_help(first, 40, 4, 8, 20, 22);
+    first << example;
+    example.print_help(second, 40, 4, 8, 20, 22);
+    second << example;
+    REQUIRE(first.str() == second.str());
+
+    // Changing the options clears the cache
+    std::ostringstream before, changed;
+    before << example;
+    example["zebra"].description("Stripes");
+    changed << example;
+    REQUIRE(changed.str().size() > before.str().size());
+    REQUIRE(changed.str().find("--zebra") != std::string::npos);
+
+    example.set_custom_strings(" ", "+");
+    changed.str("");
+    changed << example;
+    REQUIRE(changed.str().find("+v, --verbose") != std::string::npos);
+
+    // More parameter sets than the cache holds
+    for (int width = 40; width != 50; ++width) {
+      std::ostringstream expected, actual;
+      example.print_help(expected, width);
+      example.print_help(actual, width);
+      REQUIRE(actual.str() == expected.str());
+    }
+    std::ostringstream copied;
+    copied << parser{example};
+    REQUIRE(copied.str() == changed.str());
+  }
+}
+
+TEST_CASE("parser abbreviations") {
+  parser example;
+  example.add_option("verbose", 'v');
+  example.add_option("version");
+  example.add_option("output", 'o').argument("FILE");
+  example.add_option("out");
+  example.group("Other").add_option("width").argument("N");
+
+  SECTION("disabled by default") {
+    REQUIRE_FALSE(example.allow_abbreviations());
+    REQUIRE_THROWS_AS(example.parse("--verb"), parse_error);
+  }
+
+  SECTION("unique prefixes") {
+    example.set_allow_abbreviations();
+    REQUIRE(example.allow_abbreviations());
+
+    auto result = example.parse("--verb --outp=file --wid 3 --out --version");
+    REQUIRE(result.size() == 5);
+    REQUIRE(result[0].long_name == "verbose");
+    REQUIRE(result[0].original_text == "--verb");
+    REQUIRE(result[1].long_name == "output");
+    REQUIRE(result[1].argument == "file");
+    REQUIRE(result[2].long_name == "width");
+    REQUIRE(result[2].argument == "3");
+    REQUIRE(result[3].long_name == "out");
+    REQUIRE(result[4].long_name == "version");
+
+    // Snapshots abbreviate too
+    auto compiled = example.compile();
+    REQUIRE(compiled.parse("--w=4")[0].long_name == "width");
+
+    example.set_allow_abbreviations(false);
+    REQUIRE_THROWS_AS(example.parse("--verb"), parse_error);
+  }
+
+  SECTION("ambiguous prefixes") {
+    example.set_allow_abbreviations();
+    parser_result result;
+    parse_status status;
+
+    example.parse_into(result, "--verb --ver", status);
+    REQUIRE(status.error() == parse_errc::ambiguous_option);
+    REQUIRE(status.token_index() == 1);
+    REQUIRE(status.option() == "--ver");
+    REQUIRE(status.candidates()
+            == std::vector<std::string>{"--verbose", "--version"});
+    REQUIRE(status.message() == "option '--ver' is ambiguous; "
+            "possibilities: '--verbose' '--version'");
+    REQUIRE(result.size() == 1);
+
+    try {
+      example.parse("--o");
+      FAIL("No exception thrown");
+    } catch (const parse_error& e) {
+      REQUIRE(std::string{e.what()} == "option '--o' is ambiguous; "
+              "possibilities: '--out' '--output'");
+      REQUIRE(e.option() == "--o");
+    }
+
+    example.parse_into(result, "--x", status);
+    REQUIRE(status.error() == parse_errc::invalid_option);
+    REQUIRE(status.candidates().empty());
+  }
+}
+
+TEST_CASE("parser suggestions") {
+  parser example;
+  example.add_option("verbose", 'v');
+  example.add_option("version");
+  example.group("Other").add_option("output", 'o').argument("FILE");
+
+  parser_result result;
+  parse_status status;
+
+  SECTION("disabled by default") {
+    REQUIRE_FALSE(example.suggestions_enabled());
+    example.parse_into(result, "--verbos", status);
+    REQUIRE(status.error() == parse_errc::invalid_option);
+    REQUIRE(status.suggestions().empty());
+    REQUIRE(status.message() == "invalid option: '--verbos'");
+  }
+
+  SECTION("enabled") {
+    example.set_suggestions();
+    REQUIRE(example.suggestions_enabled());
+
+    example.parse_into(result, "-v --verbos", status);
+    REQUIRE(status.error() == parse_errc::invalid_option);
+    REQUIRE(status.option() == "--verbos");
+    REQUIRE(status.suggestions() == std::vector<std::string>{"--verbose"});
+    REQUIRE(status.message()
+            == "invalid option: '--verbos'; did you mean '--verbose'?");
+
+    example.parse_into(result, "--versone", status);
+    REQUIRE(status.message() == "invalid option: '--versone'; "
+            "did you mean '--verbose' or '--version'?");
+
+    example.parse_into(result, "--ouptut=x", status);
+    REQUIRE(status.suggestions() == std::vector<std::string>{"--output"});
+
+    // No suggestions for short options or distant names
+    example.parse_into(result, "-x", status);
+    REQUIRE(status.suggestions().empty());
+    example.parse_into(result, "--completely-different", status);
+    REQUIRE(status.suggestions().empty());
+    REQUIRE(status.message()
+            == "invalid option: '--completely-different'");
+
+    try {
+      example.parse("--verbos");
+      FAIL("No exception thrown");
+    } catch (const parse_error& e) {
+      REQUIRE(std::string{e.what()}
+              == "invalid option: '--verbos'; did you mean '--verbose'?");
+    }
+
+    // The suggestions outlive changes to the parser
+    example.parse_into(result, "--verbos", status);
+    example.add_option("verbosity");
+    example.set_suggestions(false);
+    REQUIRE(status.suggestions() == std::vector<std::string>{"--verbose"});
+
+    status.clear();
+    REQUIRE(status.suggestions().empty());
+  }
+
+  SECTION("snapshots") {
+    example.set_suggestions();
+    auto compiled = example.compile();
+    compiled.parse_into(result, "--vesion", status);
+    REQUIRE(status.suggestions() == std::vector<std::string>{"--version"});
+
+    auto copy = compiled;
+    copy.parse_into(result, "--vesion", status);
+    REQUIRE(status.suggestions() == std::vector<std::string>{"--version"});
+  }
+}
+
+TEST_CASE("parser response files") {
+  parser example;
+  example.add_option("verbose", 'v');
+  example.add_option("output", 'o').argument("FILE");
+  example.add_option("width", 'w').argument("N");
+
+  const std::string outer = "optionpp_test_outer.rsp";
+  const std::string inner = "optionpp_test_inner.rsp";
+  const std::string self = "optionpp_test_self.rsp";
+  const std::string loop = "optionpp_test_loop.rsp";
+  std::ofstream{outer} << "-v\n-o \"out file\"\n@optionpp_test_inner.rsp last";
+  std::ofstream{inner} << "--width=3 'quoted \\' arg' -o";
+  std::ofstream{self} << "-v @optionpp_test_loop.rsp\n";
+  std::ofstream{loop} << "@optionpp_test_self.rsp";
+
+  SECTION("disabled by default") {
+    auto result = example.parse("@" + outer);
+    REQUIRE(result.size() == 1);
+    REQUIRE(result[0].original_text == "@" + outer);
+    REQUIRE_FALSE(result[0].is_option);
+  }
+
+  SECTION("expansion") {
+    example.set_response_file_prefix();
+    REQUIRE(example.response_file_prefix() == "@");
+
+    std::vector<std::string> args{"prog", "first", "@" + outer, "x"};
+    auto result = example.parse(args.begin(), args.end());
+    REQUIRE(result.size() == 7);
+    REQUIRE(result[0].original_text == "first");
+    REQUIRE(result[1].long_name == "verbose");
+    REQUIRE(result[2].long_name == "output");
+    REQUIRE(result[2].argument == "out file");
+    REQUIRE(result[3].original_text == "--width=3");
+    REQUIRE(result[4].original_text == "quoted ' arg");
+    REQUIRE(result[5].original_text == "-o last");
+    REQUIRE(result[5].argument == "last");
+    REQUIRE(result[6].original_text == "x");
+
+    // References into the file are kept by the result
+    auto ref = example.parse_ref("first @" + outer + " x");
+    REQUIRE(ref.size() == 7);
+    REQUIRE(ref[2].argument == "out file");
+    REQUIRE(ref[5].original_text == "-o last");
+
+    // A custom prefix
+    example.set_response_file_prefix("+");
+    result = example.parse("@" + outer + " +" + inner + " y");
+    REQUIRE(result.size() == 4);
+    REQUIRE(result[0].original_text == "@" + outer);
+    REQUIRE(result[3].original_text == "-o y");
+
+    example.set_response_file_prefix("");
+    REQUIRE(example.parse("+" + inner).size() == 1);
+  }
+
+  SECTION("errors") {
+    example.set_response_file_prefix();
+    parser_result result;
+    parse_status status;
+
+    example.parse_into(result, "-v @optionpp_test_missing.rsp", status);
+    REQUIRE(status.error() == parse_errc::unreadable_file);
+    REQUIRE(status.token_index() == 1);
+    REQUIRE(status.option() == "optionpp_test_missing.rsp");
+    REQUIRE(status.message()
+            == "cannot read response file 'optionpp_test_missing.rsp'");
+
+    // A directory is reported, not thrown, by the non-throwing overload
+    REQUIRE_NOTHROW(example.parse_into(result, "-v @.", status));
+    REQUIRE(status.error() == parse_errc::unreadable_file);
+    REQUIRE(status.token_index() == 1);
+    REQUIRE(status.option() == ".");
+    REQUIRE_THROWS_AS(example.parse("@."), parse_error);
+
+    example.parse_into(result, "@" + self, status);
+    REQUIRE(status.error() == parse_errc::recursive_file);
+    REQUIRE(status.option() == self);
+    REQUIRE(status.message() == "response file '" + self + "' includes itself");
+    REQUIRE_THROWS_AS(example.parse("@" + self), parse_error);
+
+    // Errors inside a file are reported too
+    std::vector<std::string> args{"prog", "@" + inner};
+    example.parse_into(result, args.begin(), args.end(), status);
+    REQUIRE(status.error() == parse_errc::missing_argument);
+    REQUIRE(status.token_index() == 3);
+  }
+
+  std::remove(outer.c_str());
+  std::remove(inner.c_str());
+  std::remove(self.c_str());
+  std::remove(loop.c_str());
+}
+
+TEST_CASE("parser visit") {
+  int width = 0;
+  parser example;
+  example.add_option("verbose", 'v');
+  example.add_option("all", 'a');
+  example.add_option("output", 'o').argument("FILE", true);
+  example.add_option("color").argument("WHEN", false);
+  example["width"].short_name('w').bind_int(&width);
+
+  std::vector<std::string> log;
+  auto on_option = [&](const option& opt, string_ref argument) {
+    log.push_back(opt.long_name() + "=" + argument.str());
+    return true;
+  };
+  auto on_non_option = [&](string_ref argument) {
+    log.push_back(argument.str());
+    return true;
+  };
+  parse_status status;
+
+  SECTION("entries") {
+    std::vector<std::string> args{"prog", "-vo", "out", "file", "--color",
+                                  "--all", "--color", "auto", "-w3",
+                                  "--", "-v"};
+    REQUIRE(example.visit(args.begin(), args.end(), on_option,
+                          on_non_option, status));
+    REQUIRE(status);
+    REQUIRE(log == std::vector<std::string>{"verbose=", "output=out", "file",
+                                            "color=", "all=", "color=auto",
+                                            "width=3", "-v"});
+    REQUIRE(width == 3);
+
+    // Same entries as parse
+    auto result = example.parse(args.begin(), args.end());
+    REQUIRE(result.size() == log.size());
+    for (std::size_t i = 0; i != result.size(); ++i) {
+      if (result[i].is_option)
+        REQUIRE(log[i] == result[i].long_name + "=" + result[i].argument);
+      else
+        REQUIRE(log[i] == result[i].original_text);
+    }
+  }
+
+  SECTION("pending option at end") {
+    REQUIRE(example.visit("-a --color", on_option, on_non_option, status));
+    REQUIRE(log == std::vector<std::string>{"all=", "color="});
+  }
+
+  SECTION("empty handlers") {
+    REQUIRE(example.visit("-w 5 file", nullptr, nullptr, status));
+    REQUIRE(width == 5);
+  }
+
+  SECTION("early stop") {
+    auto stop_at_all = [&](const option& opt, string_ref argument) {
+      log.push_back(opt.long_name() + "=" + argument.str());
+      return opt.long_name() != "all";
+    };
+    REQUIRE_FALSE(example.visit("-vaw4 -w5 file", stop_at_all, on_non_option,
+                                status));
+    REQUIRE(status);
+    REQUIRE(log == std::vector<std::string>{"verbose=", "all="});
+    REQUIRE(width == 0);
+
+    log.clear();
+    auto stop_at_file = [&](string_ref argument) {
+      log.push_back(argument.str());
+      return false;
+    };
+    REQUIRE_FALSE(example.visit("-a file -w5 -o", on_option,
+                                stop_at_file, status));
+    REQUIRE(status);
+    REQUIRE(log == std::vector<std::string>{"all=", "file"});
+    REQUIRE(width == 0);
+
+    // Stopping on an option that takes a separate argument
+    log.clear();
+    auto stop_at_output = [&](const option& opt, string_ref argument) {
+      log.push_back(opt.long_name() + "=" + argument.str());
+      return opt.long_name() != "output";
+    };
+    REQUIRE_FALSE(example.visit("-o out -w5", stop_at_output, on_non_option,
+                                status));
+    REQUIRE(log == std::vector<std::string>{"output=out"});
+    REQUIRE(width == 0);
+  }
+
+  SECTION("errors") {
+    REQUIRE_FALSE(example.visit("-v --bad -a", on_option, on_non_option,
+                                status));
+    REQUIRE(status.error() == parse_errc::invalid_option);
+    REQUIRE(status.token_index() == 1);
+    REQUIRE(log == std::vector<std::string>{"verbose="});
+
+    log.clear();
+    REQUIRE_FALSE(example.visit("-v -o", on_option, on_non_option, status));
+    REQUIRE(status.error() == parse_errc::missing_argument);
+    REQUIRE(log == std::vector<std::string>{"verbose="});
+  }
+}
+
+TEST_CASE("parser leading options") {
+  parser example;
+  example.add_option("mem", 'm').argument("SIZE", true);
+  example.add_option("cpus", 'c').argument("N", true);
+  example.add_option("verbose", 'v');
+  example.add_option("color").argument("WHEN", false);
+
+  parser_result result;
+  parse_status status;
+
+  SECTION("end indicator") {
+    char prog[] = "runwrap", mem[] = "--mem", size[] = "4G", cpus[] = "-c8",
+      end[] = "--", app[] = "/usr/bin/app", opt[] = "-v";
+    char* argv[] = {prog, mem, size, cpus, end, app, opt, nullptr};
+    char** tail = example.parse_leading_options(result, argv, argv + 7);
+    REQUIRE(tail == argv + 5);
+    REQUIRE(result.size() == 2);
+    REQUIRE(result[0].long_name == "mem");
+    REQUIRE(result[0].argument == "4G");
+    REQUIRE(result[1].argument == "8");
+  }
+
+  SECTION("first non-option") {
+    std::vector<std::string> args{"prog", "-v", "app", "--mem", "--", "x"};
+    auto tail = example.parse_leading_options(result, args.begin(), args.end());
+    REQUIRE(tail == args.begin() + 2);
+    REQUIRE(result.size() == 1);
+    REQUIRE(result[0].long_name == "verbose");
+
+    // An optional argument is still taken
+    args = {"--color", "always", "app"};
+    tail = example.parse_leading_options(result, args.begin(), args.end(),
+                                         false);
+    REQUIRE(tail == args.begin() + 2);
+    REQUIRE(result[0].argument == "always");
+  }
+
+  SECTION("no tail") {
+    std::vector<std::string> args{"prog", "-v", "--"};
+    REQUIRE(example.parse_leading_options(result, args.begin(), args.end())
+            == args.end());
+    REQUIRE(result.size() == 1);
+
+    args = {"prog"};
+    REQUIRE(example.parse_leading_options(result, args.begin(), args.end())
+            == args.end());
+    REQUIRE(result.empty());
+  }
+
+  SECTION("errors") {
+    std::vector<std::string> args{"prog", "-v", "--bad", "app"};
+    auto tail = example.parse_leading_options(result, args.begin(), args.end(),
+                                              status);
+    REQUIRE(status.error() == parse_errc::invalid_option);
+    REQUIRE(tail == args.begin() + 2);
+    REQUIRE_THROWS_AS(example.parse_leading_options(result, args.begin(),
+                                                    args.end()),
+                      parse_error);
+
+    args = {"prog", "-v", "--mem"};
+    tail = example.parse_leading_options(result, args.begin(), args.end(),
+                                         status);
+    REQUIRE(status.error() == parse_errc::missing_argument);
+    REQUIRE(tail == args.end());
+  }
+}
+
+namespace {
+  // Iterator that makes each option when dereferenced
+  class generated_option_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = option;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const option*;
+    using reference = option;
+
+    explicit generated_option_iterator(int index) : m_index{index} {}
+
+    option operator*() const {
+      return option{"generated-" + std::to_string(m_index),
+          static_cast<char>('a' + m_index)};
+    }
+    generated_option_iterator& operator++() { ++m_index; return *this; }
+    generated_option_iterator operator++(int) {
+      auto old = *this;
+      ++m_index;
+      return old;
+    }
+    bool operator==(const generated_option_iterator& other) const {
+      return m_index == other.m_index;
+    }
+    bool operator!=(const generated_option_iterator& other) const {
+      return !(*this == other);
+    }
+
+  private:
+    int m_index;
+  };
+}
+
+TEST_CASE("parser bulk registration") {
+  parser p;
+  p.add_option("help", '?');
+  p.add_option("verbose", 'v');
+
+  std::vector<option> opts;
+  for (int i = 0; i < 1000; ++i)
+    opts.emplace_back("option-" + std::to_string(i), '\0',
+                      "Description of option number " + std::to_string(i));
+  opts[1].argument("VALUE", true);
+  opts[2].short_name('x');
+
+  SECTION("moving options") {
+    p.add_options(std::make_move_iterator(opts.begin()),
+                  std::make_move_iterator(opts.end()), "Generated");
+
+    REQUIRE(p.group("Generated").size() == 1000);
+    REQUIRE(p.group("Generated").begin()->long_name() == "option-0");
+    REQUIRE(p["option-999"].description() == "Description of option number 999");
+
+    auto result = p.parse("--option-1=a -x --option-999 -v file", false);
+    REQUIRE(result.size() == 5);
+    REQUIRE(result.get_argument("option-1") == "a");
+    REQUIRE(result.is_option_set("option-2"));
+    REQUIRE(result.is_option_set("option-999"));
+    REQUIRE(result.is_option_set('v'));
+    REQUIRE_FALSE(result.is_option_set("option-3"));
+  }
+
+  SECTION("copying options") {
+    p.add_options(opts.begin(), opts.begin() + 3);
+    REQUIRE(opts[0].long_name() == "option-0");
+    REQUIRE(p.parse("--option-2", false).is_option_set('x'));
+
+    p.add_options(opts.begin() + 3, opts.end());
+    REQUIRE(p.parse("--option-500", false).is_option_set("option-500"));
+  }
+
+  SECTION("duplicate names") {
+    opts[500].long_name("option-20");
+    REQUIRE_THROWS_AS(p.add_options(opts.begin(), opts.end()),
+                      duplicate_option_error);
+    opts[500].long_name("help");
+    REQUIRE_THROWS_WITH(p.add_options(opts.begin(), opts.end()),
+                        "option name 'help' is already in use");
+    opts[500].long_name("option-500");
+
+    opts[700].short_name('v');
+    try {
+      p.add_options(opts.begin(), opts.end());
+      FAIL("Expected duplicate_option_error");
+    } catch (const duplicate_option_error& e) {
+      REQUIRE(e.option() == "v");
+    }
+    opts[700].short_name('x');
+    REQUIRE_THROWS_AS(p.add_options(opts.begin(), opts.end()),
+                      duplicate_option_error);
+
+    // Nothing was added by the failed calls
+    REQUIRE_THROWS_AS(p.parse("--option-0", false), parse_error);
+
+    opts[700].short_name('\0');
+    p.add_options(opts.begin(), opts.end());
+    REQUIRE(p.parse("--option-0", false).is_option_set("option-0"));
+    REQUIRE_THROWS_AS(p.add_options(opts.begin(), opts.begin() + 1),
+                      duplicate_option_error);
+  }
+
+  SECTION("options returned by value") {
+    p.add_options(generated_option_iterator{0}, generated_option_iterator{20});
+    REQUIRE(p.parse("--generated-19 -c", false).is_option_set("generated-2"));
+
+    REQUIRE_THROWS_WITH(p.add_options(generated_option_iterator{21},
+                                      generated_option_iterator{22}),
+                        "option name 'v' is already in use");
+    REQUIRE_THROWS_AS(p.add_options(generated_option_iterator{19},
+                                    generated_option_iterator{20}),
+                      duplicate_option_error);
+  }
+
+  SECTION("unnamed and existing duplicates") {
+    p.add_option("help");
+    std::vector<option> unnamed(3);
+    unnamed[0].description("first");
+    unnamed[1].short_name('u');
+    p.add_options(unnamed.begin(), unnamed.end());
+    REQUIRE(p.parse("-u", false).is_option_set('u'));
+  }
+}
+
+TEST_CASE("parser options held by reference") {
+  unsigned int precision = 16;
+  parser p;
+  p["help"].short_name('?');
+
+  // As in the tutorial: keep a group and add to it between parses
+  auto& math = p.group("Math options");
+  math["precision"].short_name('p').bind_uint(&precision).argument("DIGITS");
+  REQUIRE(p.parse("-p 8", false).is_option_set("precision"));
+  REQUIRE(precision == 8);
+
+  SECTION("adding options through a held group") {
+    for (int i = 0; i < 100; ++i)
+      math.add_option("option-" + std::to_string(i));
+    math.add_option("method", 'm').argument("TYPE");
+
+    auto result = p.parse("-p 4 --option-99 -m secant --option-0", false);
+    REQUIRE(result.size() == 4);
+    REQUIRE(precision == 4);
+    REQUIRE(result.get_argument('m') == "secant");
+    REQUIRE(result.is_option_set("option-0"));
+
+    math.reserve(1000);
+    REQUIRE(p.parse("--option-50 -?", false).is_option_set('?'));
+  }
+
+  SECTION("changing options through held references") {
+    option& precision_opt = math["precision"];
+    precision_opt.long_name("digits").short_name('d');
+    REQUIRE(p.parse("--digits=3", false).is_option_set('d'));
+    REQUIRE(precision == 3);
+    REQUIRE_THROWS_AS(p.parse("--precision=2", false), parse_error);
+    REQUIRE_THROWS_AS(p.parse("-p 2", false), parse_error);
+
+    precision_opt.argument("DIGITS", false);
+    REQUIRE(p.parse("-d -?", false).is_option_set('?'));
+
+    // Assigning a new value counts as a change too
+    *math.begin() = option{"scale", 's'};
+    REQUIRE(p.parse("-s", false).is_option_set("scale"));
+    REQUIRE_THROWS_AS(p.parse("-d", false), parse_error);
+  }
+
+  SECTION("help text") {
+    std::ostringstream before;
+    p.print_help(before);
+    math["precision"].description("Output precision");
+    std::ostringstream after;
+    p.print_help(after);
+    REQUIRE(before.str().find("Output precision") == std::string::npos);
+    REQUIRE(after.str().find("Output precision") != std::string::npos);
+  }
+
+  SECTION("option strings") {
+    // Options added to a parser keep their strings in its pool
+    option& method = math.add_option("method", 'm', "Root-finding method");
+    REQUIRE(method.long_name() == "method");
+    REQUIRE(method.description() == "Root-finding method");
+    option& scale = p.add_option(option{"scale", 's'}.description("Scale"));
+    REQUIRE(scale.long_name() == "scale");
+    REQUIRE(scale.description() == "Scale");
+
+    // Copies taken out of the parser can be changed on their own
+    option detached{math["precision"]};
+    detached.long_name("digits").description("Digits");
+    REQUIRE(detached.long_name() == "digits");
+    REQUIRE(math["precision"].description().empty());
+    REQUIRE(p.parse("--precision=2 --method", false).size() == 2);
+
+    parser copy{p};
+    REQUIRE(copy["method"].long_name().data() != method.long_name().data());
+    copy["method"].description("Changed");
+    REQUIRE(method.description() == "Root-finding method");
+  }
+
+  SECTION("copied and moved parsers") {
+    parser copy{p};
+    math["precision"].long_name("digits");
+    REQUIRE(copy.parse("--precision=5", false).is_option_set("precision"));
+    REQUIRE_THROWS_AS(p.parse("--precision=5", false), parse_error);
+
+    // Moving keeps the groups, so the reference stays usable
+    parser moved{std::move(p)};
+    REQUIRE(moved.parse("--digits=5", false).is_option_set('p'));
+    math.add_option("method", 'm');
+    REQUIRE(moved.parse("-m", false).is_option_set("method"));
+
+    auto& copy_math = copy.group("Math options");
+    copy_math.add_option("method", 'm');
+    REQUIRE(copy.parse("-m --precision=1", false).is_option_set('m'));
+    REQUIRE(precision == 1);
+  }
+}
+
+TEST_CASE("parser subscript lookups") {
+  parser p;
+  p.group("").reserve(16);
+
+  SECTION("renamed options") {
+    option& alpha = p["alpha"];
+    alpha.short_name('a');
+    REQUIRE(&p['a'] == &alpha);
+
+    alpha.long_name("first");
+    REQUIRE(&p["first"] == &alpha);
+    option& added = p["alpha"];
+    REQUIRE(&added != &alpha);
+    REQUIRE(added.long_name() == "alpha");
+
+    alpha.short_name('f');
+    REQUIRE(&p['f'] == &alpha);
+    REQUIRE(&p['a'] != &alpha);
+    REQUIRE(p.group("").size() == 3);
+  }
+
+  SECTION("duplicate names follow group order") {
+    option& later = p.group("Later")["dup"].short_name('d');
+    option& first = p.add_option("dup");
+    REQUIRE(&p["dup"] == &first);
+    REQUIRE(&p['d'] == &later);
+
+    first.long_name("other");
+    REQUIRE(&p["dup"] == &later);
+    first.short_name('d');
+    REQUIRE(&p['d'] == &first);
+    REQUIRE(p.parse("--dup -d", false)[1].opt_info == &first);
+  }
+
+  SECTION("many options") {
+    for (int i = 0; i < 2000; ++i)
+      p["option-" + std::to_string(i)].short_name(static_cast<char>(i));
+    for (int i = 0; i < 2000; ++i)
+      REQUIRE(p["option-" + std::to_string(i)].long_name()
+              == "option-" + std::to_string(i));
+    // Later options with the same short name are not found
+    REQUIRE(p['\x7f'].long_name() == "option-127");
+    REQUIRE(p.group("").size() == 2000);
+  }
 }
@@ -17,6 +17,9 @@
  */
 /* Written by Greg Kikola <gkikola@gmail.com>. */
 
+#include <iterator>
+#include <string>
+#include <thread>
 #include <vector>
 #include <catch2/catch.hpp>
 #include <optionpp/parser_result.hpp>
@@ -137,6 +140,36 @@ TEST_CASE("parser_result") {
     result.push_back(help);
     REQUIRE(result.size() == 1);
     REQUIRE_FALSE(result.empty());
+    REQUIRE(result.back().original_text == "-?");
+    REQUIRE(result.rbegin()->original_text == "-?");
+    REQUIRE(std::next(result.begin()) == result.end());
+  }
+
+  SECTION("storage reuse") {
+    result = parser_result{file, non_option};
+    const char* buffer = result[0].argument.data();
+
+    result.clear();
+    result.push_back(file_lonly);
+    REQUIRE(result.size() == 1);
+    REQUIRE(result[0].argument == "myfile.txt");
+    REQUIRE(result[0].argument.data() == buffer);
+
+    parser_result copy{result};
+    REQUIRE(copy.size() == 1);
+    copy = parser_result{help, version};
+    REQUIRE(copy.size() == 2);
+    copy = result;
+    REQUIRE(copy.size() == 1);
+    REQUIRE(copy[0].original_text == "--file=myfile.txt");
+
+    parser_result moved{std::move(copy)};
+    REQUIRE(moved.size() == 1);
+    REQUIRE(copy.empty());
+
+    result.shrink_to_fit();
+    REQUIRE(result.size() == 1);
+    REQUIRE(result[0].long_name == "file");
   }
 
   SECTION("operator[], at, and back") {
@@ -203,4 +236,125 @@ TEST_CASE("parser_result") {
     REQUIRE(result.get_argument("") == "");
     REQUIRE(result.get_argument('\0') == "");
   }
+
+  SECTION("count and occurrences") {
+    parsed_entry file2 { "--file=other.txt", true, "file", 'f', "other.txt" };
+    result = parser_result{file, version, non_option, file_sonly, file2};
+
+    REQUIRE(result.count("file") == 3);
+    REQUIRE(result.count('f') == 3);
+    REQUIRE(result.count("version") == 1);
+    REQUIRE(result.count("command") == 0);
+    REQUIRE(result.count("") == 0);
+    REQUIRE(result.count('\0') == 0);
+    REQUIRE(result.get_argument("file") == "other.txt");
+
+    auto list = result.occurrences('f');
+    REQUIRE(list.size() == 3);
+    std::vector<std::string> args;
+    for (const auto& entry : list)
+      args.push_back(entry.argument);
+    REQUIRE(args == std::vector<std::string>{"myfile.txt", "myfile.txt", "other.txt"});
+
+    auto it = result.occurrences("file").begin();
+    REQUIRE(it->original_text == "-f myfile.txt");
+    REQUIRE((it++)->long_name == "file");
+    REQUIRE((it++)->long_name == "");
+    REQUIRE(it->argument == "other.txt");
+    REQUIRE(++it == result.occurrences("file").end());
+
+    REQUIRE(result.occurrences("help").empty());
+    REQUIRE(result.occurrences("help").begin() == result.occurrences("help").end());
+  }
+
+  SECTION("many options") {
+    for (int i = 0; i < 200; ++i) {
+      std::string name = "opt" + std::to_string(i % 50);
+      result.push_back(parsed_entry{"--" + name, true, name, '\0', std::to_string(i)});
+    }
+    REQUIRE(result.count("opt0") == 4);
+    REQUIRE(result.get_argument("opt7") == "157");
+    REQUIRE_FALSE(result.is_option_set("opt50"));
+
+    result.clear();
+    REQUIRE_FALSE(result.is_option_set("opt0"));
+    result.push_back(version);
+    REQUIRE(result.is_option_set("version"));
+    REQUIRE(result.count("version") == 1);
+  }
+
+  SECTION("changed entries") {
+    result = parser_result{version, help};
+    REQUIRE(result.is_option_set("help"));
+    result[1].long_name = "assist";
+    REQUIRE(result.is_option_set("assist"));
+    REQUIRE_FALSE(result.is_option_set("help"));
+    REQUIRE(result.is_option_set('?'));
+
+    parser_result copy{result};
+    REQUIRE(copy.is_option_set("assist"));
+    parser_result moved{std::move(copy)};
+    REQUIRE(moved.is_option_set("version"));
+    copy = std::move(moved);
+    REQUIRE(copy.count("assist") == 1);
+
+    for (auto& entry : copy)
+      entry.is_option = false;
+    REQUIRE_FALSE(copy.is_option_set("version"));
+    copy.back().is_option = true;
+    copy.push_back(help);
+    REQUIRE(copy.count('?') == 2);
+    REQUIRE(copy.get_argument("assist") == "");
+    REQUIRE(copy.count("help") == 2);
+
+    // A stale index is rebuilt once, whichever thread queries first
+    copy[1].long_name = "release";
+    std::vector<std::thread> threads;
+    std::vector<int> found(4, 0);
+    for (int i = 0; i != 4; ++i) {
+      threads.emplace_back([&copy, &found, i] {
+          const parser_result& c = copy;
+          found[i] = c.is_option_set("release") && c.count('?') == 2;
+        });
+    }
+    for (auto& t : threads)
+      t.join();
+    REQUIRE(found == std::vector<int>(4, 1));
+  }
+
+  SECTION("options") {
+    option verbose{"verbose", 'v'};
+    option quiet{"quiet", 'q'};
+    option other_verbose{"verbose", 'v'};
+
+    parsed_entry v{"-v", true, "verbose", 'v', ""};
+    v.opt_info = &verbose;
+    parsed_entry q{"--quiet", true, "quiet", 'q', ""};
+    q.opt_info = &quiet;
+
+    result = parser_result{v, q, non_option, v};
+    REQUIRE(result.is_option_set(verbose));
+    REQUIRE(result.count(verbose) == 2);
+    REQUIRE(result.count(quiet) == 1);
+    REQUIRE_FALSE(result.is_option_set(other_verbose));
+    REQUIRE(result.count("verbose") == 2);
+    REQUIRE(result.count('q') == 1);
+
+    // Entries without an option join the option with their name
+    result.push_back(parsed_entry{"--verbose=x", true, "verbose", '\0', "x"});
+    REQUIRE(result.count(verbose) == 3);
+    REQUIRE(result.get_argument(verbose) == "x");
+    REQUIRE(result.get_argument('v') == "x");
+
+    auto list = result.occurrences(verbose);
+    REQUIRE(std::distance(list.begin(), list.end()) == 3);
+    REQUIRE(result.occurrences(other_verbose).empty());
+
+    result.clear();
+    REQUIRE_FALSE(result.is_option_set(verbose));
+    for (int i = 0; i < 100; ++i)
+      result.push_back(i % 2 ? v : q);
+    REQUIRE(result.count(verbose) == 50);
+    REQUIRE(result.count("quiet") == 50);
+  }
 }
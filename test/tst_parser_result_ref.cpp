@@ -0,0 +1,131 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/parser.hpp>
+
+using namespace optionpp;
+
+namespace {
+
+  void check_same(const parser_result_ref& result,
+                  const parser_result& expected) {
+    REQUIRE(result.size() == expected.size());
+    for (parser_result::size_type i = 0; i < result.size(); ++i) {
+      REQUIRE(result[i].original_text == expected[i].original_text);
+      REQUIRE(result[i].original_without_argument
+              == expected[i].original_without_argument);
+      REQUIRE(result[i].is_option == expected[i].is_option);
+      REQUIRE(result[i].long_name == expected[i].long_name);
+      REQUIRE(result[i].short_name == expected[i].short_name);
+      REQUIRE(result[i].argument == expected[i].argument);
+      REQUIRE(result[i].opt_info == expected[i].opt_info);
+    }
+  }
+
+} // End namespace
+
+TEST_CASE("parser_result_ref") {
+  int width = 0;
+  parser p;
+  p["help"].short_name('?');
+  p["verbose"].short_name('v');
+  p["all"].short_name('a');
+  p["width"].short_name('w').bind_int(&width);
+  p["output"].short_name('o').argument("FILE", false);
+
+  SECTION("same results as parse") {
+    for (const std::string cmd : { "-v? file --width=3",
+                                   "--output out.txt -- --help",
+                                   "-vw 12 -o",
+                                   "-?o=file1 file2",
+                                   "-avo file -vaw=8 -vaw9 -aov -w 2",
+                                   "--output --help -o -v" }) {
+      auto expected = p.parse(cmd);
+      auto result = p.parse_ref(cmd);
+      check_same(result, expected);
+    }
+
+    REQUIRE_THROWS_WITH(p.parse_ref("--quiet"), "invalid option: '--quiet'");
+    REQUIRE_THROWS_WITH(p.parse_ref("-vw"), "option '-w' requires an argument");
+    REQUIRE_THROWS_WITH(p.parse_ref("-va=1"), "option '-a' does not accept arguments");
+    REQUIRE_THROWS_WITH(p.parse_ref("-vw x"),
+                        "argument for option '-w' must be an integer");
+  }
+
+  SECTION("arguments are not copied") {
+    std::vector<std::string> args{"prog", "--output=out.txt", "file",
+                                  "-w", "5", "-vo", "x"};
+    auto result = p.parse_ref(args.begin(), args.end());
+    REQUIRE(width == 5);
+    REQUIRE(result.size() == 5);
+
+    REQUIRE(result[0].original_text.data() == args[1].data());
+    REQUIRE(result[0].argument.data() == args[1].data() + 9);
+    REQUIRE(result[0].long_name.data() == p["output"].long_name().data());
+    REQUIRE(result[1].original_text.data() == args[2].data());
+    REQUIRE(result[2].argument.data() == args[4].data());
+    REQUIRE(result[2].original_text == "-w 5");
+    REQUIRE(result[4].original_text == "-o x");
+    REQUIRE(result[4].original_without_argument == "-o");
+    REQUIRE(result[4].argument.data() == args[6].data());
+
+    REQUIRE(result.is_option_set("verbose"));
+    REQUIRE(result.is_option_set('o'));
+    REQUIRE_FALSE(result.is_option_set("help"));
+    REQUIRE(result.get_argument("output") == "x");
+    REQUIRE(result.get_argument('w') == "5");
+    REQUIRE(result.get_argument('?').empty());
+  }
+
+  SECTION("argc and argv") {
+    char prog[] = "prog";
+    char opt[] = "-?";
+    char file[] = "file";
+    char* argv[] = { prog, opt, file };
+    auto result = p.parse_ref(3, argv);
+    REQUIRE(result.size() == 2);
+    REQUIRE(result[0].short_name == '?');
+    REQUIRE(result[1].original_text.data() == file);
+
+    result = p.compile().parse_ref(3, argv, false);
+    REQUIRE(result.size() == 3);
+  }
+
+  SECTION("conversion and access") {
+    auto result = p.parse_ref("-vo out.txt file");
+    auto copy = result.to_result();
+    check_same(result, copy);
+    REQUIRE(copy[1].argument == "out.txt");
+
+    auto entry = result.at(2).to_entry();
+    REQUIRE(entry.original_text == "file");
+    REQUIRE_FALSE(entry.is_option);
+    REQUIRE_THROWS_AS(result.at(3), out_of_range);
+
+    result.back().argument = "changed";
+    REQUIRE(result[2].argument == "changed");
+
+    result.clear();
+    REQUIRE(result.empty());
+    REQUIRE_THROWS_AS(result.back(), out_of_range);
+  }
+}
@@ -0,0 +1,104 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/string_pool.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("string_pool") {
+  string_pool pool;
+
+  SECTION("empty pool") {
+    REQUIRE(pool.empty());
+    REQUIRE(pool.size() == 0);
+    REQUIRE(pool.text_size() == 0);
+    REQUIRE(pool.find("help") == string_pool::npos);
+    REQUIRE(pool.find("") == string_pool::npos);
+  }
+
+  SECTION("interning") {
+    REQUIRE(pool.intern("help") == 0);
+    REQUIRE(pool.intern("verbose") == 1);
+    REQUIRE(pool.intern("") == 2);
+    REQUIRE(pool.intern(std::string{"help"}) == 0);
+    REQUIRE(pool.intern("verbose") == 1);
+    REQUIRE(pool.intern("") == 2);
+
+    REQUIRE_FALSE(pool.empty());
+    REQUIRE(pool.size() == 3);
+    REQUIRE(pool.text_size() == 11);
+    REQUIRE(pool.get(0) == "help");
+    REQUIRE(pool.get(1) == "verbose");
+    REQUIRE(pool.get(2).empty());
+
+    REQUIRE(pool.find("verbose") == 1);
+    REQUIRE(pool.find("") == 2);
+    REQUIRE(pool.find("verb") == string_pool::npos);
+    REQUIRE(pool.find("helpx") == string_pool::npos);
+
+    std::string arg{"--verbose=2"};
+    REQUIRE(pool.find(string_ref{arg.data() + 2, 7}) == 1);
+    REQUIRE(pool.find(string_ref{arg.data() + 2, 4}) == string_pool::npos);
+  }
+
+  SECTION("many strings") {
+    pool.reserve(100, 1000);
+    for (int i = 0; i < 5000; ++i)
+      REQUIRE(pool.intern("option-" + std::to_string(i)) == static_cast<string_pool::id_type>(i));
+    for (int i = 0; i < 5000; ++i)
+      REQUIRE(pool.intern("option-" + std::to_string(i)) == static_cast<string_pool::id_type>(i));
+
+    REQUIRE(pool.size() == 5000);
+    for (int i = 0; i < 5000; ++i) {
+      std::string name = "option-" + std::to_string(i);
+      REQUIRE(pool.find(name) == static_cast<string_pool::id_type>(i));
+      REQUIRE(pool.get(static_cast<string_pool::id_type>(i)) == name);
+    }
+    REQUIRE(pool.find("option-5000") == string_pool::npos);
+  }
+
+  SECTION("copying") {
+    pool.intern("help");
+    pool.intern("version");
+    string_pool copy{pool};
+    pool.intern("extra");
+
+    REQUIRE(copy.size() == 2);
+    REQUIRE(copy.find("version") == 1);
+    REQUIRE(copy.find("extra") == string_pool::npos);
+    REQUIRE(copy.get(0) == "help");
+  }
+
+  SECTION("clear") {
+    pool.intern("help");
+    pool.intern("version");
+    pool.clear();
+
+    REQUIRE(pool.empty());
+    REQUIRE(pool.text_size() == 0);
+    REQUIRE(pool.find("help") == string_pool::npos);
+
+    REQUIRE(pool.intern("version") == 0);
+    REQUIRE(pool.get(0) == "version");
+    REQUIRE(pool.find("help") == string_pool::npos);
+  }
+}
@@ -0,0 +1,75 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <sstream>
+#include <string>
+#include <catch2/catch.hpp>
+#include <optionpp/string_ref.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("string_ref") {
+  std::string str{"--output=file.txt"};
+  string_ref ref{str};
+
+  SECTION("constructors") {
+    REQUIRE(string_ref{}.empty());
+    REQUIRE(string_ref{}.size() == 0);
+    REQUIRE(ref.size() == str.size());
+    REQUIRE(ref.data() == str.data());
+    REQUIRE(string_ref{"abc"}.size() == 3);
+    REQUIRE(string_ref{"abc", 2} == "ab");
+  }
+
+  SECTION("substr and find") {
+    REQUIRE(ref.find('=') == 8);
+    REQUIRE(ref.find('x') == 15);
+    REQUIRE(ref.find('q') == string_ref::npos);
+    REQUIRE(ref.find("file") == 9);
+    REQUIRE(ref.find("--", 1) == string_ref::npos);
+    REQUIRE(ref.find("") == 0);
+    REQUIRE(ref.substr(2, 6) == "output");
+    REQUIRE(ref.substr(9) == "file.txt");
+    REQUIRE(ref.substr(9).data() == str.data() + 9);
+    REQUIRE(ref.substr(100).empty());
+    REQUIRE(ref.substr(15, 100) == "xt");
+  }
+
+  SECTION("comparison") {
+    REQUIRE(ref == str);
+    REQUIRE(ref.starts_with("--"));
+    REQUIRE_FALSE(ref.starts_with("---"));
+    REQUIRE(string_ref{"abc"} < string_ref{"abd"});
+    REQUIRE(string_ref{"ab"} < string_ref{"abc"});
+    REQUIRE(string_ref{"abc"} != string_ref{"ab"});
+    REQUIRE(string_ref{"b"}.compare("a") > 0);
+    REQUIRE(string_ref{"a"}.compare("a") == 0);
+  }
+
+  SECTION("conversion") {
+    REQUIRE(ref.str() == str);
+    REQUIRE(static_cast<std::string>(ref.substr(0, 2)) == "--");
+    REQUIRE(std::string{"x"} + ref.substr(0, 2) == "x--");
+    REQUIRE(ref.substr(0, 2) + std::string{"x"} == "--x");
+
+    std::ostringstream ss;
+    ss << ref.substr(2, 6);
+    REQUIRE(ss.str() == "output");
+  }
+}
@@ -0,0 +1,93 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/suggestion_index.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("suggestion_index") {
+  SECTION("distance") {
+    REQUIRE(suggestion_index::distance("", "", 5) == 0);
+    REQUIRE(suggestion_index::distance("abc", "", 5) == 3);
+    REQUIRE(suggestion_index::distance("", "abc", 5) == 3);
+    REQUIRE(suggestion_index::distance("verbose", "verbose", 5) == 0);
+    REQUIRE(suggestion_index::distance("verbos", "verbose", 5) == 1);
+    REQUIRE(suggestion_index::distance("vrebose", "verbose", 5) == 2);
+    REQUIRE(suggestion_index::distance("kitten", "sitting", 5) == 3);
+    REQUIRE(suggestion_index::distance("kitten", "sitting", 2) == 3);
+    REQUIRE(suggestion_index::distance("a", "abcdefgh", 3) == 4);
+  }
+
+  suggestion_index index;
+
+  SECTION("empty index") {
+    REQUIRE(index.empty());
+    REQUIRE(index.find("help", 2, 3).empty());
+  }
+
+  SECTION("find") {
+    for (const char* name : {"help", "verbose", "version", "output", "",
+                             "verbose", "width"})
+      index.insert(name);
+    REQUIRE(index.size() == 5);
+
+    REQUIRE(index.find("verbos", 2, 3) == std::vector<std::string>{"verbose"});
+    REQUIRE(index.find("versio", 2, 3) == std::vector<std::string>{"version"});
+    REQUIRE(index.find("versone", 2, 3)
+            == (std::vector<std::string>{"verbose", "version"}));
+    REQUIRE(index.find("versone", 2, 1) == std::vector<std::string>{"verbose"});
+    REQUIRE(index.find("hepl", 2, 3) == std::vector<std::string>{"help"});
+    REQUIRE(index.find("xyz", 2, 3).empty());
+    REQUIRE(index.find("width", 0, 3) == std::vector<std::string>{"width"});
+  }
+
+  SECTION("agrees with brute force") {
+    std::vector<std::string> names;
+    for (int i = 0; i < 4000; ++i) {
+      std::string name = "opt";
+      for (int n = i; n; n /= 7)
+        name.push_back(static_cast<char>('a' + n % 7));
+      names.push_back(name);
+      index.insert(name);
+    }
+    REQUIRE(index.size() == names.size());
+
+    const std::string long_word(70, 'a');
+    for (std::string word : {"optabc", "opbaca", "oqtggg", "optfedcb", "x",
+                             "", "abcdefgopt", long_word.c_str()}) {
+      std::vector<std::pair<std::size_t, std::string>> expected;
+      for (const auto& name : names) {
+        auto d = suggestion_index::distance(word, name, 100);
+        if (d <= 2)
+          expected.emplace_back(d, name);
+      }
+      std::sort(expected.begin(), expected.end());
+
+      auto found = index.find(word, 2, names.size());
+      REQUIRE(found.size() == expected.size());
+      for (std::size_t i = 0; i < found.size(); ++i)
+        REQUIRE(found[i] == expected[i].second);
+    }
+  }
+}
@@ -0,0 +1,54 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <catch2/catch.hpp>
+#include <optionpp/text_arena.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("text_arena") {
+  text_arena arena{8};
+
+  SECTION("store") {
+    auto a = arena.store("-a");
+    auto b = arena.store("a longer string than one block");
+    auto c = arena.store("-b", "=", "value");
+    REQUIRE(a == "-a");
+    REQUIRE(b == "a longer string than one block");
+    REQUIRE(c == "-b=value");
+    REQUIRE(arena.store("").empty());
+  }
+
+  SECTION("clear and release") {
+    auto a = arena.store("abc");
+    arena.clear();
+    auto b = arena.store("xyz");
+    REQUIRE(b == "xyz");
+    REQUIRE(a.data() == b.data()); // Memory is reused
+    arena.release();
+    REQUIRE(arena.store("def") == "def");
+  }
+
+  SECTION("move") {
+    auto a = arena.store("abc");
+    text_arena other{std::move(arena)};
+    REQUIRE(a == "abc");
+    REQUIRE(other.store("def") == "def");
+  }
+}
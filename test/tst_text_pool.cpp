@@ -0,0 +1,68 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/text_pool.hpp>
+
+using namespace optionpp;
+
+TEST_CASE("text_pool") {
+  text_pool pool;
+
+  SECTION("store") {
+    auto a = pool.store("alpha");
+    auto b = pool.store("beta");
+    REQUIRE(pool.get(a) == "alpha");
+    REQUIRE(pool.get(b) == "beta");
+    REQUIRE(a.size == 5);
+    REQUIRE(b.offset == 5);
+    REQUIRE(pool.size() == 9);
+
+    auto empty = pool.store("");
+    REQUIRE(empty.size == 0);
+    REQUIRE(pool.get(empty).empty());
+    REQUIRE(pool.size() == 9);
+  }
+
+  SECTION("strings do not move") {
+    std::vector<text_pool::span> spans;
+    std::vector<string_ref> refs;
+    for (int i = 0; i < 500; ++i) {
+      spans.push_back(pool.store(std::string(i % 70 + 1, 'a' + i % 26)));
+      refs.push_back(pool.get(spans.back()));
+    }
+    for (int i = 0; i < 500; ++i) {
+      std::string expected(i % 70 + 1, 'a' + i % 26);
+      REQUIRE(pool.get(spans[i]) == expected);
+      REQUIRE(refs[i].data() == pool.get(spans[i]).data());
+    }
+  }
+
+  SECTION("strings do not cross blocks") {
+    pool.store(std::string(60, 'x'));
+    auto s = pool.store("0123456789"); // Does not fit in the first block
+    REQUIRE(s.offset == 64);
+    REQUIRE(pool.get(s) == "0123456789");
+
+    auto big = pool.store(std::string(1000, 'y'));
+    REQUIRE(pool.get(big) == std::string(1000, 'y'));
+  }
+}
@@ -0,0 +1,178 @@
+/* Option++ -- read command-line program options
+ * Copyright (C) 2017-2020 Greg Kikola.
+ *
+ * This file is part of Option++.
+ *
+ * Option++ is free software: you can redistribute it and/or modify
+ * it under the terms of the Boost Software License version 1.0.
+ *
+ * Option++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Boost Software License for more details.
+ *
+ * You should have received a copy of the Boost Software License
+ * along with Option++.  If not, see
+ * <https://www.boost.org/LICENSE_1_0.txt>.
+ */
+/* Written by Greg Kikola <gkikola@gmail.com>. */
+
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <optionpp/tokenizer.hpp>
+
+using namespace optionpp;
+
+namespace {
+
+  // Straightforward byte-at-a-time splitter to compare against
+  std::vector<std::string> reference_split(const std::string& str,
+                                           const std::string& delims,
+                                           const std::string& quotes,
+                                           char escape_char,
+                                           bool allow_empty) {
+    std::vector<std::string> result;
+    bool escape_next = false;
+    bool in_quotes = false;
+    std::string::size_type quote_index = 0;
+    std::string cur_token;
+    for (char c : str) {
+      if (in_quotes) {
+        if (escape_next || c != quotes[quote_index]) {
+          if (!escape_next && c == escape_char)
+            escape_next = true;
+          else {
+            cur_token.push_back(c);
+            escape_next = false;
+          }
+        } else {
+          in_quotes = false;
+        }
+      } else if (escape_next || delims.find(c) == std::string::npos) {
+        if (!escape_next && c == escape_char)
+          escape_next = true;
+        else if (escape_next) {
+          cur_token.push_back(c);
+          escape_next = false;
+        } else {
+          quote_index = quotes.find(c);
+          if (quote_index != std::string::npos)
+            in_quotes = true;
+          else
+            cur_token.push_back(c);
+        }
+      } else {
+        if (!cur_token.empty() || allow_empty)
+          result.push_back(cur_token);
+        cur_token.clear();
+      }
+    }
+    if (!cur_token.empty() || allow_empty)
+      result.push_back(cur_token);
+    return result;
+  }
+
+  std::vector<std::string> split(const tokenizer& tok, const std::string& str) {
+    std::vector<std::string> result;
+    std::string buffer;
+    string_ref token;
+    tokenizer::size_type pos = 0;
+    while (tok.next(str, pos, token, buffer))
+      result.push_back(token.str());
+    return result;
+  }
+
+} // End namespace
+
+TEST_CASE("tokenizer") {
+  SECTION("simple tokens") {
+    tokenizer tok;
+    REQUIRE(split(tok, "").empty());
+    REQUIRE(split(tok, "   \t ").empty());
+    REQUIRE(split(tok, "--all -v  file")
+            == std::vector<std::string>{"--all", "-v", "file"});
+    REQUIRE(split(tok, "say \"hello there\" 'it''s' a\\ b")
+            == std::vector<std::string>{"say", "hello there", "its", "a b"});
+    REQUIRE(split(tok, "\"unterminated quote")
+            == std::vector<std::string>{"unterminated quote"});
+    REQUIRE(split(tok, "trailing\\") == std::vector<std::string>{"trailing"});
+    REQUIRE(split(tok, "\"\" x") == std::vector<std::string>{"x"});
+  }
+
+  SECTION("tokens refer to input") {
+    tokenizer tok;
+    std::string input = "first-argument-that-is-long \"quoted arg\" last";
+    std::string buffer;
+    string_ref token;
+    tokenizer::size_type pos = 0;
+
+    REQUIRE(tok.next(input, pos, token, buffer));
+    REQUIRE(token == "first-argument-that-is-long");
+    REQUIRE(token.data() == input.data());
+    REQUIRE(tok.next(input, pos, token, buffer));
+    REQUIRE(token == "quoted arg");
+    REQUIRE(token.data() == buffer.data());
+    REQUIRE(tok.next(input, pos, token, buffer));
+    REQUIRE(token == "last");
+    REQUIRE(token.data() == input.data() + input.size() - 4);
+    REQUIRE_FALSE(tok.next(input, pos, token, buffer));
+    REQUIRE_FALSE(tok.next(input, pos, token, buffer));
+  }
+
+  SECTION("split with storage") {
+    tokenizer tok{","};
+    text_arena storage;
+    std::string input = "a,\"b,c\",,d";
+    std::vector<string_ref> tokens;
+    tok.split(input, std::back_inserter(tokens), storage);
+    REQUIRE(tokens.size() == 3);
+    REQUIRE(tokens[0].data() == input.data());
+    REQUIRE(tokens[1] == "b,c");
+    REQUIRE(tokens[2] == "d");
+
+    tokens.clear();
+    tokenizer{",", "\"", '\\', true}.split(input, std::back_inserter(tokens), storage);
+    REQUIRE(tokens.size() == 4);
+    REQUIRE(tokens[2].empty());
+  }
+
+  SECTION("same as byte-at-a-time splitting") {
+    struct rules {
+      std::string delims;
+      std::string quotes;
+      char escape_char;
+    };
+    const std::vector<rules> all_rules = {
+      { " \t\n\r", "\"'", '\\' },
+      { ",", "", '\0' },
+      { "", "\"", '\\' },
+      { "abcdefghij", "xy", 'z' }, // Too many characters for SIMD
+      { " \\", "\"", '\\' }, // Escape character is also a delimiter
+      { " ", "\\", '\\' } // Escape character is also a quote
+    };
+    const std::string alphabet = "  \t\"'\\,abcxyz-=";
+
+    std::mt19937 gen{12345};
+    std::uniform_int_distribution<std::string::size_type> pick{0, alphabet.size() - 1};
+    std::uniform_int_distribution<int> length{0, 100};
+    for (int i = 0; i < 2000; ++i) {
+      std::string input;
+      for (int len = length(gen); len > 0; --len)
+        input.push_back(alphabet[pick(gen)]);
+      if (i % 10 == 0) // Long runs of ordinary characters
+        input.insert(input.size() / 2, std::string(70, 'q'));
+
+      for (const auto& r : all_rules) {
+        for (bool allow_empty : { false, true }) {
+          tokenizer tok{r.delims, r.quotes, r.escape_char, allow_empty};
+          REQUIRE(split(tok, input)
+                  == reference_split(input, r.delims, r.quotes,
+                                     r.escape_char, allow_empty));
+        }
+      }
+    }
+  }
+}
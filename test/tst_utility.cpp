@@ -18,6 +18,7 @@
 /* Written by Greg Kikola <gkikola@gmail.com>. */
 
 #include <iterator>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <catch2/catch.hpp>
@@ -386,6 +387,28 @@ Dickin
 son)"};
     REQUIRE(multiline_short == wrap_text(multiline, 6));
   }
+
+  SECTION("output iterator") {
+    for (int line_len : {-1, 0, 1, 6, 33, 80}) {
+      for (int indent : {0, 2, 7}) {
+        std::string result{">"};
+        auto it = wrap_text(multiline, std::back_inserter(result),
+                            line_len, indent, 4);
+        *it++ = '<';
+        REQUIRE(result == ">" + wrap_text(multiline, line_len, indent, 4) + "<");
+      }
+    }
+
+    std::ostringstream os;
+    wrap_text(text, std::ostreambuf_iterator<char>{os}, 33, 0, 0);
+    REQUIRE(os.str() == wrap_text(text, 33));
+
+    std::string empty;
+    wrap_text("", std::back_inserter(empty), 10, 2, 2);
+    REQUIRE(empty.empty());
+    wrap_text("\n\nabc\n", std::back_inserter(empty), 10, 1, 1);
+    REQUIRE(empty == wrap_text("\n\nabc\n", 10, 1));
+  }
 }
 
 TEST_CASE("utility::is_substr_at_pos") {